@@ -0,0 +1,93 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/*
+ * Benchmarks for catalog FITS I/O, using in-memory FITS files so the numbers
+ * measure (de)serialization rather than the disk.
+ */
+#include <benchmark/benchmark.h>
+
+#include "lsst/afw/fits.h"
+#include "lsst/afw/table/Source.h"
+
+namespace afwFits = lsst::afw::fits;
+namespace afwTable = lsst::afw::table;
+
+namespace {
+
+int const NUM_RECORDS = 100000;
+
+afwTable::SourceCatalog makeCatalog() {
+    afwTable::Schema schema = afwTable::SourceTable::makeMinimalSchema();
+    auto const fluxKey = schema.addField<double>("test_flux", "flux for benchmarking", "count");
+    auto const fluxErrKey = schema.addField<double>("test_fluxErr", "flux uncertainty", "count");
+    auto const flagKey = schema.addField<afwTable::Flag>("test_flag", "flag for benchmarking");
+    afwTable::SourceCatalog catalog(schema);
+    catalog.reserve(NUM_RECORDS);
+    for (int i = 0; i < NUM_RECORDS; ++i) {
+        auto record = catalog.addNew();
+        record->set(fluxKey, 1000.0 + i);
+        record->set(fluxErrKey, 10.0 + 0.001 * i);
+        record->set(flagKey, i % 7 == 0);
+    }
+    return catalog;
+}
+
+void benchCatalogWrite(benchmark::State &state) {
+    afwTable::SourceCatalog const catalog = makeCatalog();
+    for (auto _ : state) {
+        afwFits::MemFileManager manager;
+        catalog.writeFits(manager);
+        benchmark::DoNotOptimize(manager.getLength());
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_RECORDS);
+}
+BENCHMARK(benchCatalogWrite)->Unit(benchmark::kMillisecond);
+
+void benchCatalogRead(benchmark::State &state) {
+    afwTable::SourceCatalog const catalog = makeCatalog();
+    afwFits::MemFileManager manager;
+    catalog.writeFits(manager);
+    for (auto _ : state) {
+        auto const result = afwTable::SourceCatalog::readFits(manager);
+        benchmark::DoNotOptimize(result.size());
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_RECORDS);
+}
+BENCHMARK(benchCatalogRead)->Unit(benchmark::kMillisecond);
+
+void benchCatalogDeepCopy(benchmark::State &state) {
+    afwTable::SourceCatalog const catalog = makeCatalog();
+    for (auto _ : state) {
+        afwTable::SourceCatalog copy(catalog.getTable()->clone());
+        copy.insert(copy.end(), catalog.begin(), catalog.end(), true);
+        benchmark::DoNotOptimize(copy.size());
+    }
+    state.SetItemsProcessed(state.iterations() * NUM_RECORDS);
+}
+BENCHMARK(benchCatalogDeepCopy)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
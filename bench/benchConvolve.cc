@@ -0,0 +1,100 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/*
+ * Benchmarks for kernel convolution.
+ *
+ * The image contents are synthetic and seeded, so runs are reproducible and
+ * comparable across machines with `benchmark`'s usual JSON output.
+ */
+#include <benchmark/benchmark.h>
+
+#include "lsst/geom.h"
+#include "lsst/afw/image/Image.h"
+#include "lsst/afw/math/ConvolveImage.h"
+#include "lsst/afw/math/FunctionLibrary.h"
+#include "lsst/afw/math/Kernel.h"
+#include "lsst/afw/math/Random.h"
+
+namespace afwImage = lsst::afw::image;
+namespace afwMath = lsst::afw::math;
+
+namespace {
+
+int const IMAGE_SIZE = 1024;
+double const SIGMA = 3.0;
+
+afwImage::Image<float> makeImage() {
+    afwImage::Image<float> image(lsst::geom::Extent2I(IMAGE_SIZE, IMAGE_SIZE));
+    afwMath::Random rand(afwMath::Random::MT19937, 1);
+    afwMath::randomGaussianImage(&image, rand);
+    return image;
+}
+
+void benchConvolveSeparable(benchmark::State &state) {
+    int const kSize = state.range(0);
+    afwImage::Image<float> const image = makeImage();
+    afwImage::Image<float> result(image.getDimensions());
+    afwMath::GaussianFunction1<double> gaussFunc(SIGMA);
+    afwMath::SeparableKernel kernel(kSize, kSize, gaussFunc, gaussFunc);
+    for (auto _ : state) {
+        afwMath::convolve(result, image, kernel, afwMath::ConvolutionControl());
+        benchmark::DoNotOptimize(result.getArray().getData());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(IMAGE_SIZE) * IMAGE_SIZE);
+}
+BENCHMARK(benchConvolveSeparable)->Arg(5)->Arg(11)->Arg(21)->Unit(benchmark::kMillisecond);
+
+void benchConvolveAnalytic(benchmark::State &state) {
+    int const kSize = state.range(0);
+    afwImage::Image<float> const image = makeImage();
+    afwImage::Image<float> result(image.getDimensions());
+    afwMath::GaussianFunction2<double> gaussFunc(SIGMA, SIGMA, 0.0);
+    afwMath::AnalyticKernel kernel(kSize, kSize, gaussFunc);
+    for (auto _ : state) {
+        afwMath::convolve(result, image, kernel, afwMath::ConvolutionControl());
+        benchmark::DoNotOptimize(result.getArray().getData());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(IMAGE_SIZE) * IMAGE_SIZE);
+}
+BENCHMARK(benchConvolveAnalytic)->Arg(5)->Arg(11)->Unit(benchmark::kMillisecond);
+
+void benchConvolveThreaded(benchmark::State &state) {
+    afwImage::Image<float> const image = makeImage();
+    afwImage::Image<float> result(image.getDimensions());
+    afwMath::GaussianFunction1<double> gaussFunc(SIGMA);
+    afwMath::SeparableKernel kernel(11, 11, gaussFunc, gaussFunc);
+    afwMath::ConvolutionControl control;
+    control.setNumThreads(state.range(0));
+    for (auto _ : state) {
+        afwMath::convolve(result, image, kernel, control);
+        benchmark::DoNotOptimize(result.getArray().getData());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(IMAGE_SIZE) * IMAGE_SIZE);
+}
+BENCHMARK(benchConvolveThreaded)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,87 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/*
+ * Benchmarks for FootprintSet detection: thresholding a noise image seeded
+ * with a grid of bright sources, then growing the detections.
+ */
+#include <benchmark/benchmark.h>
+
+#include "lsst/geom.h"
+#include "lsst/afw/detection/FootprintSet.h"
+#include "lsst/afw/detection/Threshold.h"
+#include "lsst/afw/image/Image.h"
+#include "lsst/afw/math/Random.h"
+
+namespace afwDetect = lsst::afw::detection;
+namespace afwImage = lsst::afw::image;
+namespace afwMath = lsst::afw::math;
+
+namespace {
+
+int const IMAGE_SIZE = 2048;
+int const SOURCE_SPACING = 64;
+
+afwImage::Image<float> makeImage() {
+    afwImage::Image<float> image(lsst::geom::Extent2I(IMAGE_SIZE, IMAGE_SIZE));
+    afwMath::Random rand(afwMath::Random::MT19937, 1);
+    afwMath::randomGaussianImage(&image, rand);
+    // plant a grid of 3x3-pixel sources well above the detection threshold
+    for (int y = SOURCE_SPACING / 2; y < IMAGE_SIZE - 1; y += SOURCE_SPACING) {
+        for (int x = SOURCE_SPACING / 2; x < IMAGE_SIZE - 1; x += SOURCE_SPACING) {
+            for (int dy = -1; dy <= 1; ++dy) {
+                for (int dx = -1; dx <= 1; ++dx) {
+                    image(x + dx, y + dy) += 20.0f;
+                }
+            }
+        }
+    }
+    return image;
+}
+
+void benchFootprintSetDetect(benchmark::State &state) {
+    afwImage::Image<float> const image = makeImage();
+    afwDetect::Threshold const threshold(5.0);
+    for (auto _ : state) {
+        afwDetect::FootprintSet footprints(image, threshold);
+        benchmark::DoNotOptimize(footprints.getFootprints()->size());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(IMAGE_SIZE) * IMAGE_SIZE);
+}
+BENCHMARK(benchFootprintSetDetect)->Unit(benchmark::kMillisecond);
+
+void benchFootprintSetGrow(benchmark::State &state) {
+    int const rGrow = state.range(0);
+    afwImage::Image<float> const image = makeImage();
+    afwDetect::FootprintSet const detected(image, afwDetect::Threshold(5.0));
+    for (auto _ : state) {
+        afwDetect::FootprintSet grown(detected, rGrow, true);
+        benchmark::DoNotOptimize(grown.getFootprints()->size());
+    }
+}
+BENCHMARK(benchFootprintSetGrow)->Arg(3)->Arg(10)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -0,0 +1,93 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/*
+ * Benchmarks for SpanSet set operations, morphology and mask stamping.
+ */
+#include <benchmark/benchmark.h>
+
+#include "lsst/geom.h"
+#include "lsst/afw/geom/SpanSet.h"
+#include "lsst/afw/image/Mask.h"
+
+namespace afwGeom = lsst::afw::geom;
+namespace afwImage = lsst::afw::image;
+
+namespace {
+
+int const RADIUS = 100;
+
+void benchSpanSetFromShape(benchmark::State &state) {
+    for (auto _ : state) {
+        auto const spans = afwGeom::SpanSet::fromShape(RADIUS);
+        benchmark::DoNotOptimize(spans->getArea());
+    }
+}
+BENCHMARK(benchSpanSetFromShape);
+
+void benchSpanSetIntersect(benchmark::State &state) {
+    auto const a = afwGeom::SpanSet::fromShape(RADIUS);
+    auto const b = a->shiftedBy(RADIUS / 2, RADIUS / 3);
+    for (auto _ : state) {
+        auto const result = a->intersect(*b);
+        benchmark::DoNotOptimize(result->getArea());
+    }
+}
+BENCHMARK(benchSpanSetIntersect);
+
+void benchSpanSetUnion(benchmark::State &state) {
+    auto const a = afwGeom::SpanSet::fromShape(RADIUS);
+    auto const b = a->shiftedBy(RADIUS / 2, RADIUS / 3);
+    for (auto _ : state) {
+        auto const result = a->union_(*b);
+        benchmark::DoNotOptimize(result->getArea());
+    }
+}
+BENCHMARK(benchSpanSetUnion);
+
+void benchSpanSetDilate(benchmark::State &state) {
+    int const r = state.range(0);
+    auto const spans = afwGeom::SpanSet::fromShape(RADIUS);
+    for (auto _ : state) {
+        auto const result = spans->dilated(r);
+        benchmark::DoNotOptimize(result->getArea());
+    }
+}
+BENCHMARK(benchSpanSetDilate)->Arg(3)->Arg(10);
+
+void benchSpanSetSetMask(benchmark::State &state) {
+    auto const spans = afwGeom::SpanSet::fromShape(RADIUS, afwGeom::Stencil::CIRCLE,
+                                                   lsst::geom::Point2I(RADIUS + 1, RADIUS + 1));
+    afwImage::Mask<afwImage::MaskPixel> mask(lsst::geom::Extent2I(2 * RADIUS + 3, 2 * RADIUS + 3));
+    for (auto _ : state) {
+        spans->setMask(mask, static_cast<afwImage::MaskPixel>(0x1));
+        benchmark::DoNotOptimize(mask.getArray().getData());
+    }
+    state.SetItemsProcessed(state.iterations() * spans->getArea());
+}
+BENCHMARK(benchSpanSetSetMask);
+
+}  // namespace
+
+BENCHMARK_MAIN();
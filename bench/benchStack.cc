@@ -0,0 +1,95 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/*
+ * Benchmarks for statisticsStack: coadding a stack of synthetic images.
+ */
+#include <memory>
+#include <vector>
+
+#include <benchmark/benchmark.h>
+
+#include "lsst/geom.h"
+#include "lsst/afw/image/Image.h"
+#include "lsst/afw/math/Random.h"
+#include "lsst/afw/math/Stack.h"
+
+namespace afwImage = lsst::afw::image;
+namespace afwMath = lsst::afw::math;
+
+namespace {
+
+int const IMAGE_SIZE = 512;
+int const NUM_IMAGES = 20;
+
+std::vector<std::shared_ptr<afwImage::Image<float>>> makeImages() {
+    std::vector<std::shared_ptr<afwImage::Image<float>>> images;
+    images.reserve(NUM_IMAGES);
+    afwMath::Random rand(afwMath::Random::MT19937, 1);
+    for (int i = 0; i < NUM_IMAGES; ++i) {
+        auto image = std::make_shared<afwImage::Image<float>>(lsst::geom::Extent2I(IMAGE_SIZE, IMAGE_SIZE));
+        afwMath::randomGaussianImage(image.get(), rand);
+        images.push_back(image);
+    }
+    return images;
+}
+
+void benchStackMean(benchmark::State &state) {
+    auto images = makeImages();
+    for (auto _ : state) {
+        auto const stack = afwMath::statisticsStack(images, afwMath::MEAN);
+        benchmark::DoNotOptimize(stack->getArray().getData());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(NUM_IMAGES) * IMAGE_SIZE *
+                            IMAGE_SIZE);
+}
+BENCHMARK(benchStackMean)->Unit(benchmark::kMillisecond);
+
+void benchStackMedian(benchmark::State &state) {
+    auto images = makeImages();
+    for (auto _ : state) {
+        auto const stack = afwMath::statisticsStack(images, afwMath::MEDIAN);
+        benchmark::DoNotOptimize(stack->getArray().getData());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(NUM_IMAGES) * IMAGE_SIZE *
+                            IMAGE_SIZE);
+}
+BENCHMARK(benchStackMedian)->Unit(benchmark::kMillisecond);
+
+void benchStackMeanClipThreaded(benchmark::State &state) {
+    auto images = makeImages();
+    afwMath::StatisticsControl sctrl;
+    sctrl.setNumThreads(state.range(0));
+    for (auto _ : state) {
+        auto const stack = afwMath::statisticsStack(images, afwMath::MEANCLIP, sctrl);
+        benchmark::DoNotOptimize(stack->getArray().getData());
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(NUM_IMAGES) * IMAGE_SIZE *
+                            IMAGE_SIZE);
+}
+BENCHMARK(benchStackMeanClipThreaded)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
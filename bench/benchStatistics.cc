@@ -0,0 +1,96 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/*
+ * Benchmarks for makeStatistics over images and masked images.
+ */
+#include <benchmark/benchmark.h>
+
+#include "lsst/geom.h"
+#include "lsst/afw/image/MaskedImage.h"
+#include "lsst/afw/math/Random.h"
+#include "lsst/afw/math/Statistics.h"
+
+namespace afwImage = lsst::afw::image;
+namespace afwMath = lsst::afw::math;
+
+namespace {
+
+int const IMAGE_SIZE = 2048;
+
+afwImage::MaskedImage<float> makeMaskedImage() {
+    afwImage::MaskedImage<float> mimage(lsst::geom::Extent2I(IMAGE_SIZE, IMAGE_SIZE));
+    afwMath::Random rand(afwMath::Random::MT19937, 1);
+    afwMath::randomGaussianImage(mimage.getImage().get(), rand);
+    *mimage.getVariance() = 1.0f;
+    return mimage;
+}
+
+void benchStatisticsMean(benchmark::State &state) {
+    afwImage::MaskedImage<float> const mimage = makeMaskedImage();
+    for (auto _ : state) {
+        auto const stats =
+                afwMath::makeStatistics(mimage, afwMath::NPOINT | afwMath::MEAN | afwMath::STDEV);
+        benchmark::DoNotOptimize(stats.getValue(afwMath::MEAN));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(IMAGE_SIZE) * IMAGE_SIZE);
+}
+BENCHMARK(benchStatisticsMean)->Unit(benchmark::kMillisecond);
+
+void benchStatisticsMeanClip(benchmark::State &state) {
+    afwImage::MaskedImage<float> const mimage = makeMaskedImage();
+    for (auto _ : state) {
+        auto const stats = afwMath::makeStatistics(mimage, afwMath::MEANCLIP | afwMath::STDEVCLIP);
+        benchmark::DoNotOptimize(stats.getValue(afwMath::MEANCLIP));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(IMAGE_SIZE) * IMAGE_SIZE);
+}
+BENCHMARK(benchStatisticsMeanClip)->Unit(benchmark::kMillisecond);
+
+void benchStatisticsMedian(benchmark::State &state) {
+    afwImage::MaskedImage<float> const mimage = makeMaskedImage();
+    for (auto _ : state) {
+        auto const stats = afwMath::makeStatistics(mimage, afwMath::MEDIAN);
+        benchmark::DoNotOptimize(stats.getValue(afwMath::MEDIAN));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(IMAGE_SIZE) * IMAGE_SIZE);
+}
+BENCHMARK(benchStatisticsMedian)->Unit(benchmark::kMillisecond);
+
+void benchStatisticsThreaded(benchmark::State &state) {
+    afwImage::MaskedImage<float> const mimage = makeMaskedImage();
+    afwMath::StatisticsControl sctrl;
+    sctrl.setNumThreads(state.range(0));
+    for (auto _ : state) {
+        auto const stats = afwMath::makeStatistics(
+                mimage, afwMath::NPOINT | afwMath::MEAN | afwMath::STDEV, sctrl);
+        benchmark::DoNotOptimize(stats.getValue(afwMath::MEAN));
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(IMAGE_SIZE) * IMAGE_SIZE);
+}
+BENCHMARK(benchStatisticsThreaded)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
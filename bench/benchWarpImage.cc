@@ -0,0 +1,94 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/*
+ * Benchmarks for warpImage: a slightly rotated, offset Lanczos warp of a
+ * synthetic image, with and without interpolation of the pixel transform.
+ */
+#include <benchmark/benchmark.h>
+
+#include "lsst/geom.h"
+#include "lsst/afw/geom/SkyWcs.h"
+#include "lsst/afw/image/Image.h"
+#include "lsst/afw/math/Random.h"
+#include "lsst/afw/math/warpExposure.h"
+
+namespace afwGeom = lsst::afw::geom;
+namespace afwImage = lsst::afw::image;
+namespace afwMath = lsst::afw::math;
+
+namespace {
+
+int const IMAGE_SIZE = 1024;
+
+afwImage::Image<float> makeImage() {
+    afwImage::Image<float> image(lsst::geom::Extent2I(IMAGE_SIZE, IMAGE_SIZE));
+    afwMath::Random rand(afwMath::Random::MT19937, 1);
+    afwMath::randomGaussianImage(&image, rand);
+    return image;
+}
+
+std::shared_ptr<afwGeom::SkyWcs> makeWcs(lsst::geom::Angle rotation) {
+    lsst::geom::Point2D const crpix(IMAGE_SIZE / 2, IMAGE_SIZE / 2);
+    lsst::geom::SpherePoint const crval(30.0 * lsst::geom::degrees, 10.0 * lsst::geom::degrees);
+    auto const cdMatrix = afwGeom::makeCdMatrix(0.2 * lsst::geom::arcseconds, rotation);
+    return afwGeom::makeSkyWcs(crpix, crval, cdMatrix);
+}
+
+void benchWarpImage(benchmark::State &state) {
+    int const interpLength = state.range(0);
+    afwImage::Image<float> const srcImage = makeImage();
+    afwImage::Image<float> destImage(srcImage.getDimensions());
+    auto const srcWcs = makeWcs(0.0 * lsst::geom::degrees);
+    auto const destWcs = makeWcs(3.0 * lsst::geom::degrees);
+    afwMath::WarpingControl control("lanczos3");
+    control.setInterpLength(interpLength);
+    for (auto _ : state) {
+        int const numGoodPixels = afwMath::warpImage(destImage, *destWcs, srcImage, *srcWcs, control);
+        benchmark::DoNotOptimize(numGoodPixels);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(IMAGE_SIZE) * IMAGE_SIZE);
+}
+// interpLength 0 evaluates the WCS at every pixel; 10 is the usual production setting
+BENCHMARK(benchWarpImage)->Arg(0)->Arg(10)->Unit(benchmark::kMillisecond);
+
+void benchWarpImageThreaded(benchmark::State &state) {
+    afwImage::Image<float> const srcImage = makeImage();
+    afwImage::Image<float> destImage(srcImage.getDimensions());
+    auto const srcWcs = makeWcs(0.0 * lsst::geom::degrees);
+    auto const destWcs = makeWcs(3.0 * lsst::geom::degrees);
+    afwMath::WarpingControl control("lanczos3");
+    control.setInterpLength(10);
+    control.setNumThreads(state.range(0));
+    for (auto _ : state) {
+        int const numGoodPixels = afwMath::warpImage(destImage, *destWcs, srcImage, *srcWcs, control);
+        benchmark::DoNotOptimize(numGoodPixels);
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<std::int64_t>(IMAGE_SIZE) * IMAGE_SIZE);
+}
+BENCHMARK(benchWarpImageThreaded)->Arg(1)->Arg(2)->Arg(4)->Unit(benchmark::kMillisecond);
+
+}  // namespace
+
+BENCHMARK_MAIN();
@@ -22,7 +22,9 @@
 #ifndef LSST_AFW_CAMERAGEOM_AMPLIFIER_H_INCLUDED
 #define LSST_AFW_CAMERAGEOM_AMPLIFIER_H_INCLUDED
 
+#include <memory>
 #include <string>
+#include <vector>
 
 #include "lsst/afw/table/fwd.h"
 #include "lsst/geom/Box.h"
@@ -30,6 +32,12 @@
 
 namespace lsst {
 namespace afw {
+
+namespace image {
+template <typename PixelT>
+class Image;
+}  // namespace image
+
 namespace cameraGeom {
 
 /**
@@ -409,7 +417,36 @@ private:
     Fields _fields;
 };
 
-
+/**
+ * Fill a variance plane from an image and per-amplifier gain and read noise.
+ *
+ * For each amplifier, the pixels of `variance` inside the amplifier bounding
+ * box (@ref Amplifier::getBBox "getBBox()", i.e. the trimmed, assembled
+ * image) are set to
+ *
+ *     variance = image/gain + (readNoise/gain)^2
+ *
+ * the Poisson variance of the signal plus the read-noise floor, both in
+ * ADU^2.  The per-amplifier constants are resolved before any pixel is
+ * touched, so each amplifier's region is written by a pure multiply-add row
+ * loop, and the amplifiers are processed concurrently on the process-wide
+ * thread pool rather than one subimage at a time.
+ *
+ * @param[in]  image       Image the variance is derived from, in ADU.
+ * @param[out] variance    Variance plane to fill.  Must have the same
+ *                         bounding box (dimensions and xy0) as `image`.
+ * @param[in]  amplifiers  Amplifiers whose (disjoint) bounding boxes cover
+ *                         the region to fill, e.g. from
+ *                         Detector::getAmplifiers().
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if the bounding boxes
+ *      of `image` and `variance` differ, if an amplifier's bounding box
+ *      extends outside the image, or if an amplifier's gain is not positive.
+ */
+template <typename ImagePixelT, typename VariancePixelT>
+void makeVariancePlane(image::Image<ImagePixelT> const & image,
+                       image::Image<VariancePixelT> & variance,
+                       std::vector<std::shared_ptr<Amplifier const>> const & amplifiers);
 
 }  // namespace cameraGeom
 }  // namespace afw
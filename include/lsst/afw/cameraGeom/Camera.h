@@ -142,6 +142,48 @@ public:
                                                CameraSys const &fromSys,
                                                CameraSys const &toSys) const;
 
+    /**
+     * Transform points in many detectors' coordinate systems to a common
+     * camera coordinate system, grouped by detector
+     *
+     * @param[in] pointsByDetector  a map from detector ID to the points in
+     *    that detector's `fromSys` system
+     * @param[in] fromSys  per-detector camera coordinate system prefix
+     *    (e.g. PIXELS) the input points are in
+     * @param[in] toSys  camera coordinate system to transform to
+     * @returns a map from detector ID to the transformed points, in the
+     *    same order as the input points for that detector
+     *
+     * @throws lsst::pex::exceptions::NotFoundError if a detector ID is not
+     *    in the camera.
+     *
+     * Each detector's points are transformed with a single vectorized call,
+     * so the per-transform setup cost is paid once per detector rather than
+     * once per point.
+     */
+    std::map<int, std::vector<lsst::geom::Point2D>> transform(
+            std::map<int, std::vector<lsst::geom::Point2D>> const &pointsByDetector,
+            CameraSysPrefix const &fromSys, CameraSys const &toSys) const;
+
+    /**
+     * Transform points in a common camera coordinate system to many
+     * detectors' coordinate systems, grouped by detector
+     *
+     * @param[in] pointsByDetector  a map from detector ID to the points
+     *    destined for that detector, in the `fromSys` system
+     * @param[in] fromSys  camera coordinate system the input points are in
+     * @param[in] toSys  per-detector camera coordinate system prefix
+     *    (e.g. PIXELS) to transform to
+     * @returns a map from detector ID to the transformed points, in the
+     *    same order as the input points for that detector
+     *
+     * @throws lsst::pex::exceptions::NotFoundError if a detector ID is not
+     *    in the camera.
+     */
+    std::map<int, std::vector<lsst::geom::Point2D>> transform(
+            std::map<int, std::vector<lsst::geom::Point2D>> const &pointsByDetector,
+            CameraSys const &fromSys, CameraSysPrefix const &toSys) const;
+
     /**
      * Cameras are always persistable.
      */
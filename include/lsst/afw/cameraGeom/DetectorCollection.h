@@ -25,6 +25,7 @@
 #include <map>
 #include <string>
 #include <memory>
+#include <vector>
 
 #include "lsst/geom/Box.h"
 #include "lsst/afw/table/io/Persistable.h"
@@ -158,6 +159,33 @@ public:
     /// Return a focal plane bounding box that encompasses all detectors
     lsst::geom::Box2D const & getFpBBox() const noexcept { return _fpBBox; }
 
+    /**
+     * Find the detectors whose pixel-coordinate bounding boxes contain a
+     * point.
+     *
+     * @param[in] fpPosition  position in FOCAL_PLANE coordinates
+     * @returns a list of zero or more detectors containing the point
+     *
+     * Candidate detectors are looked up in a uniform grid over the detectors'
+     * FOCAL_PLANE bounding boxes that is built at construction, so a query
+     * transforms the point into the pixel systems of only a handful of
+     * detectors rather than all of them.
+     */
+    List findDetectors(lsst::geom::Point2D const & fpPosition) const;
+
+    /**
+     * Find the detectors containing each of a vector of points in a single
+     * pass.
+     *
+     * @param[in] fpPositionList  vector of positions in FOCAL_PLANE coordinates
+     * @returns a vector with one list of detectors per input point
+     *
+     * The confirming FOCAL_PLANE to PIXELS transforms are applied to all of a
+     * detector's candidate points at once, so this is much faster than
+     * calling the scalar findDetectors in a loop.
+     */
+    std::vector<List> findDetectorsList(std::vector<lsst::geom::Point2D> const & fpPositionList) const;
+
     // DetectorCollection is immutable, so it cannot be moveable.  It is also
     // always held by shared_ptr, so there is no good reason to copy it.
     DetectorCollection(DetectorCollection const &) = delete;
@@ -186,7 +214,18 @@ private:
 
     class Factory;
 
+    // Build the uniform grid over the detectors' FOCAL_PLANE bounding boxes
+    // used by findDetectors to look up candidate detectors.
+    void _buildIndex(List const & detectorList);
+
+    // Return the candidate detectors for the cell containing the given
+    // FOCAL_PLANE position (an empty list if it is outside the grid).
+    List const & _findCandidates(lsst::geom::Point2D const & fpPosition) const;
+
     lsst::geom::Box2D _fpBBox;        //< bounding box of collection
+    lsst::geom::Box2D _indexBBox;     //< bounding box of the candidate grid
+    lsst::geom::Extent2I _indexShape; //< number of candidate grid cells in x and y
+    std::vector<List> _indexCells;    //< row-major per-cell candidate detectors
 };
 
 } // namespace cameraGeom
@@ -22,6 +22,8 @@
 #if !defined(LSST_AFW_CAMERAGEOM_TRANSFORMMAP_H)
 #define LSST_AFW_CAMERAGEOM_TRANSFORMMAP_H
 
+#include <cstdint>
+#include <mutex>
 #include <vector>
 #include <unordered_map>
 #include <memory>
@@ -236,6 +238,10 @@ private:
      * @param fromSys, toSys  Coordinate systems between which to transform
      * @return an invertible Mapping that converts from `fromSys` to `toSys`
      *
+     * The composed, simplified mapping for each requested pair of systems is
+     * cached on first use, so repeated transforms between the same pair skip
+     * the graph traversal and composition entirely.
+     *
      * @throws lsst::pex::exceptions::InvalidParameterError Thrown if either
      *         `fromSys` or `toSys` is not supported.
      */
@@ -263,6 +269,15 @@ private:
      */
     CameraSysFrameIdMap _frameIds;
 
+    /*
+     * Lazily-populated cache of composed, simplified end-to-end mappings for
+     * pairs of systems that have been requested, keyed by the packed (from,
+     * to) frame IDs.  Guarded by _cacheMutex so that the const transform
+     * methods stay safe to call concurrently.
+     */
+    mutable std::unordered_map<std::uint64_t, std::shared_ptr<ast::Mapping const>> _mappingCache;
+    mutable std::mutex _cacheMutex;
+
 };
 
 
@@ -402,6 +402,29 @@ std::shared_ptr<Footprint> mergeFootprints(Footprint const &footprint1, Footprin
  * @param footprint Footprint to turn into bounding box list
  */
 std::vector<lsst::geom::Box2I> footprintToBBoxList(Footprint const &footprint);
+
+/**
+ * @brief Transform a collection of Footprints from one WCS to another in bulk
+ *
+ * This is equivalent to calling Footprint::transform on each element, but sets
+ * up the source-to-target transform only once and batches the coordinate
+ * transformations of many footprints into a few large array calls, which
+ * amortizes the substantial per-call overhead of the underlying transform
+ * machinery when propagating, e.g., a visit's worth of footprints to a coadd
+ * frame.
+ *
+ * @param footprints Footprints to transform; null elements are not allowed.
+ * @param source Wcs that defines the coordinate system of the input footprints.
+ * @param target Wcs that defines the desired coordinate system of the returned footprints.
+ * @param region Used to set the "region" box of the returned footprints; note that this is
+ *               NOT the same as the footprints' bounding boxes.
+ * @param doClip If true, clip the new footprints to the region bbox before returning them.
+ *
+ * @returns Transformed footprints, in the same order as the input.
+ */
+std::vector<std::shared_ptr<Footprint>> transformFootprints(
+        std::vector<std::shared_ptr<Footprint>> const &footprints, std::shared_ptr<geom::SkyWcs> source,
+        std::shared_ptr<geom::SkyWcs> target, lsst::geom::Box2I const &region, bool doClip = true);
 }  // namespace detection
 }  // namespace afw
 }  // namespace lsst
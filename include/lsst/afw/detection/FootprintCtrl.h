@@ -104,7 +104,7 @@ public:
     };
 
     explicit HeavyFootprintCtrl(ModifySource modifySource = NONE)
-            : _modifySource(modifySource), _imageVal(0.0), _maskVal(0), _varianceVal(0.0) {}
+            : _modifySource(modifySource), _imageVal(0.0), _maskVal(0), _varianceVal(0.0), _lazy(false) {}
 
     ~HeavyFootprintCtrl() = default;
     HeavyFootprintCtrl(HeavyFootprintCtrl const &) = default;
@@ -122,11 +122,20 @@ public:
     double getVarianceVal() const { return _varianceVal; }
     void setVarianceVal(double varianceVal) { _varianceVal = varianceVal; }
 
+    /// Should the HeavyFootprint reference the parent image rather than copying its pixels?
+    ///
+    /// A lazy HeavyFootprint defers flattening the parent MaskedImage's pixels until
+    /// they are first needed; it is only honoured when the modifySource is NONE, as
+    /// SET must write to the source immediately.
+    bool getLazy() const { return _lazy; }
+    void setLazy(bool lazy) { _lazy = lazy; }
+
 private:
     ModifySource _modifySource;
     double _imageVal;
     long _maskVal;
     double _varianceVal;
+    bool _lazy;
 };
 }  // namespace detection
 }  // namespace afw
@@ -37,6 +37,9 @@
 
 namespace lsst {
 namespace afw {
+namespace math {
+class Kernel;
+}  // namespace math
 namespace detection {
 
 /** Pixel type for FootprintSet::insertIntoImage()
@@ -47,6 +50,12 @@ namespace detection {
  */
 typedef std::uint64_t FootprintIdPixel;
 
+namespace detail {
+
+class FootprintSetIndex;  // grid over footprint bounding boxes for overlap queries; defined in FootprintSet.cc
+
+}  // namespace detail
+
 /**
  * A set of Footprints, associated with a MaskedImage
  */
@@ -62,10 +71,61 @@ public:
      * @param threshold threshold to find objects
      * @param npixMin minimum number of pixels in an object
      * @param setPeaks should I set the Peaks list?
+     * @param numThreads number of threads to scan the image with; the image is
+     *        scanned in row strips which are stitched back together across the
+     *        strip seams, so the detected Footprints are the same as for a
+     *        serial scan although their order within the set may differ
      */
     template <typename ImagePixelT>
     FootprintSet(image::Image<ImagePixelT> const& img, Threshold const& threshold, int const npixMin = 1,
-                 bool const setPeaks = true);
+                 bool const setPeaks = true, int numThreads = 1);
+
+    /**
+     * Find a FootprintSet in an Image, thresholding each pixel against its own variance
+     *
+     * This is equivalent to dividing `img` by the square root of `variance` and detecting on
+     * the result with a VALUE threshold, but the per-pixel threshold is evaluated on the fly
+     * from the variance plane inside the scan loop, so no full-frame significance image is
+     * ever allocated.
+     *
+     * @param img Image to search for objects
+     * @param variance per-pixel variance of img; must have the same dimensions
+     * @param threshold threshold to find objects; must be of type PIXEL_STDEV
+     * @param npixMin minimum number of pixels in an object
+     * @param setPeaks should I set the Peaks list?
+     * @param numThreads number of threads to scan the image with
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if the threshold is not
+     *         PIXEL_STDEV or the dimensions do not match
+     */
+    template <typename ImagePixelT>
+    FootprintSet(image::Image<ImagePixelT> const& img, image::Image<float> const& variance,
+                 Threshold const& threshold, int const npixMin = 1, bool const setPeaks = true,
+                 int numThreads = 1);
+
+    /**
+     * Find FootprintSets at several thresholds with a single scan of an Image
+     *
+     * Rereading the image dominates the cost of running detection repeatedly
+     * at different levels, so this reads each pixel once and feeds it to one
+     * run of the detection state machine per threshold.  The returned sets are
+     * identical to constructing a FootprintSet at each threshold in turn, with
+     * the higher-threshold Footprints nested inside the lower-threshold ones
+     * in the usual way.
+     *
+     * All thresholds must have the same polarity and must reduce to a single
+     * level for the image (so PIXEL_STDEV and BITMASK are not supported).
+     *
+     * @param img Image to search for objects
+     * @param thresholds thresholds to find objects at
+     * @param npixMin minimum number of pixels in an object
+     * @param setPeaks should I set the Peaks lists?
+     * @returns one FootprintSet per threshold, in the same order
+     */
+    template <typename ImagePixelT>
+    static std::vector<std::shared_ptr<FootprintSet>> makeMultiThreshold(
+            image::Image<ImagePixelT> const& img, std::vector<Threshold> const& thresholds,
+            int const npixMin = 1, bool const setPeaks = true);
 
     /**
      * Find a FootprintSet given a Mask and a threshold
@@ -94,10 +154,15 @@ public:
      * @param planeName mask plane to set (if != "")
      * @param npixMin minimum number of pixels in an object
      * @param setPeaks should I set the Peaks list?
+     * @param numThreads number of threads to scan the image with; the image is
+     *        scanned in row strips which are stitched back together across the
+     *        strip seams, so the detected Footprints are the same as for a
+     *        serial scan although their order within the set may differ
      */
     template <typename ImagePixelT, typename MaskPixelT>
     FootprintSet(image::MaskedImage<ImagePixelT, MaskPixelT> const& img, Threshold const& threshold,
-                 std::string const& planeName = "", int const npixMin = 1, bool const setPeaks = true);
+                 std::string const& planeName = "", int const npixMin = 1, bool const setPeaks = true,
+                 int numThreads = 1);
 
     /**
      * Construct an empty FootprintSet given a region that its footprints would have lived in
@@ -143,11 +208,14 @@ public:
         lsst::geom::Box2I rhsRegion = rhs.getRegion();
         rhs.setRegion(getRegion());
         setRegion(rhsRegion);
+        _index.reset();
+        rhs._index.reset();
     }
 
     void swapFootprintList(FootprintList& rhs) noexcept {
         using std::swap;
         swap(*_footprints, rhs);
+        _index.reset();
     }
 
     /**:
@@ -158,13 +226,41 @@ public:
     /**:
      * Set the Footprint%s of detected objects
      */
-    void setFootprints(std::shared_ptr<FootprintList> footprints) { _footprints = footprints; }
+    void setFootprints(std::shared_ptr<FootprintList> footprints) {
+        _footprints = footprints;
+        _index.reset();
+    }
 
     /**
      * Retun the Footprint%s of detected objects
      */
     std::shared_ptr<FootprintList const> const getFootprints() const { return _footprints; }
 
+    //@{
+    /**
+     * Return the Footprint%s whose pixels may overlap the given region
+     *
+     * The box overload returns every Footprint whose bounding box overlaps
+     * the given box; the SpanSet overload additionally requires the
+     * Footprint's spans to actually intersect the given spans.  The bulk
+     * overload answers one query per input box.  Results are in the same
+     * order as in getFootprints().
+     *
+     * The first query builds a spatial index over the footprint bounding
+     * boxes, which subsequent queries reuse; the index is discarded whenever
+     * the set is modified through FootprintSet's own interface.  Call
+     * invalidateIndex() after modifying footprints through the pointers
+     * returned by getFootprints().
+     */
+    std::vector<std::shared_ptr<Footprint>> findOverlapping(lsst::geom::Box2I const& box) const;
+    std::vector<std::shared_ptr<Footprint>> findOverlapping(geom::SpanSet const& spans) const;
+    std::vector<std::vector<std::shared_ptr<Footprint>>> findOverlapping(
+            std::vector<lsst::geom::Box2I> const& boxes) const;
+    //@}
+
+    /// Discard the spatial index used by findOverlapping, forcing it to be rebuilt.
+    void invalidateIndex() noexcept { _index.reset(); }
+
     /**
      *  Add a new record corresponding to each footprint to a SourceCatalog.
      *
@@ -196,20 +292,23 @@ public:
      */
     std::shared_ptr<image::Image<FootprintIdPixel>> insertIntoImage() const;
 
+    /**
+     * Set bits in a mask for all the Footprint%s in the FootprintSet
+     *
+     * @param mask Mask to set bits in
+     * @param planeName Here's the name of the mask plane to fit
+     * @param numThreads number of threads to stamp the mask with; the mask
+     *                   rows are partitioned between the threads, so no two
+     *                   threads ever write to the same pixel
+     */
     template <typename MaskPixelT>
-    void setMask(image::Mask<MaskPixelT>* mask,  ///< Set bits in the mask
-                 std::string const& planeName    ///< Here's the name of the mask plane to fit
-    ) {
-        for (auto const& foot : *_footprints) {
-            foot->getSpans()->setMask(*mask, image::Mask<MaskPixelT>::getPlaneBitMask(planeName));
-        }
-    }
+    void setMask(image::Mask<MaskPixelT>* mask, std::string const& planeName, int numThreads = 1);
 
+    /// @copydoc setMask(image::Mask<MaskPixelT>*, std::string const&, int)
     template <typename MaskPixelT>
-    void setMask(std::shared_ptr<image::Mask<MaskPixelT>> mask,  ///< Set bits in the mask
-                 std::string const& planeName                    ///< Here's the name of the mask plane to fit
-    ) {
-        setMask(mask.get(), planeName);
+    void setMask(std::shared_ptr<image::Mask<MaskPixelT>> mask, std::string const& planeName,
+                 int numThreads = 1) {
+        setMask(mask.get(), planeName, numThreads);
     }
 
     /**
@@ -219,8 +318,14 @@ public:
      * @param tGrow No. of pixels to grow this Footprints
      * @param rGrow No. of pixels to grow rhs Footprints
      * @param isotropic Use (expensive) isotropic grow
+     * @param numThreads number of threads to relabel the merged Footprints
+     *                   and gather their Peaks with; the merged Footprints
+     *                   are returned in a canonical order (by their first
+     *                   span), so the result is identical for any thread
+     *                   count
      */
-    void merge(FootprintSet const& rhs, int tGrow = 0, int rGrow = 0, bool isotropic = true);
+    void merge(FootprintSet const& rhs, int tGrow = 0, int rGrow = 0, bool isotropic = true,
+               int numThreads = 1);
 
     /**
      * Convert all the Footprints in the FootprintSet to be HeavyFootprint%s
@@ -233,9 +338,37 @@ public:
                    HeavyFootprintCtrl const* ctrl = NULL);
 
 private:
+    // Build the spatial index over the footprint bounding boxes if it does not exist yet.
+    void _ensureIndex() const;
+
     std::shared_ptr<FootprintList> _footprints;  ///< the Footprints of detected objects
     lsst::geom::Box2I _region;  ///< The corners of the MaskedImage that the detections live in
+    mutable std::shared_ptr<detail::FootprintSetIndex> _index;  ///< lazily-built index for findOverlapping
 };
+
+/**
+ * Detect Footprints on the convolution of an image without materializing the smoothed frame.
+ *
+ * Equivalent to convolving img with math::convolve and passing the result to the
+ * FootprintSet constructor, but the convolved rows are computed in a small reusable
+ * band buffer and fed straight to the thresholding scanner, so the full-frame
+ * smoothed image is never allocated, written, or re-read.  Peaks are measured on
+ * convolved postage stamps recomputed over each detected Footprint.
+ *
+ * @param img image to convolve and search for objects
+ * @param kernel kernel to convolve with
+ * @param threshold threshold on the convolved image; must be an absolute
+ *        (Threshold::VALUE) threshold, as the statistics of the smoothed frame are
+ *        never available as a whole
+ * @param npixMin minimum number of pixels in an object
+ * @param setPeaks should I set the Peaks list?
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if threshold is not of type
+ *         Threshold::VALUE.
+ */
+template <typename ImagePixelT>
+FootprintSet detectOnConvolvedImage(image::Image<ImagePixelT> const& img, math::Kernel const& kernel,
+                                    Threshold const& threshold, int npixMin = 1, bool setPeaks = true);
 }  // namespace detection
 }  // namespace afw
 }  // namespace lsst
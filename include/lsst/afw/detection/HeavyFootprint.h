@@ -31,6 +31,7 @@
 #include <list>
 #include <cmath>
 #include <memory>
+#include <vector>
 #include "lsst/afw/detection/Footprint.h"
 
 namespace lsst {
@@ -56,6 +57,13 @@ public:
      * @param mimage The pixel values
      * @param ctrl Control how we manipulate HeavyFootprints
      *
+     * If ctrl requests a lazy HeavyFootprint the pixels are not copied;
+     * instead the HeavyFootprint holds a (shallow) reference to mimage and
+     * flattens its pixels only when they are first needed, e.g. by the
+     * array accessors or persistence.  insert() reads through the reference
+     * directly.  The caller must not modify the referenced pixels until the
+     * HeavyFootprint has been materialized or discarded.
+     *
      * @note the HeavyFootprintCtrl is passed by const* not const& so
      * that we needn't provide a definition in the header.
      */
@@ -104,16 +112,39 @@ public:
      */
     void insert(lsst::afw::image::Image<ImagePixelT>& image) const;
 
-    ndarray::Array<ImagePixelT, 1, 1> getImageArray() { return _image; }
-    ndarray::Array<MaskPixelT, 1, 1> getMaskArray() { return _mask; }
-    ndarray::Array<VariancePixelT, 1, 1> getVarianceArray() { return _variance; }
+    ndarray::Array<ImagePixelT, 1, 1> getImageArray() {
+        _ensureMaterialized();
+        return _image;
+    }
+    ndarray::Array<MaskPixelT, 1, 1> getMaskArray() {
+        _ensureMaterialized();
+        return _mask;
+    }
+    ndarray::Array<VariancePixelT, 1, 1> getVarianceArray() {
+        _ensureMaterialized();
+        return _variance;
+    }
+
+    ndarray::Array<ImagePixelT const, 1, 1> getImageArray() const {
+        _ensureMaterialized();
+        return _image;
+    }
+    ndarray::Array<MaskPixelT const, 1, 1> getMaskArray() const {
+        _ensureMaterialized();
+        return _mask;
+    }
+    ndarray::Array<VariancePixelT const, 1, 1> getVarianceArray() const {
+        _ensureMaterialized();
+        return _variance;
+    }
 
-    ndarray::Array<ImagePixelT const, 1, 1> getImageArray() const { return _image; }
-    ndarray::Array<MaskPixelT const, 1, 1> getMaskArray() const { return _mask; }
-    ndarray::Array<VariancePixelT const, 1, 1> getVarianceArray() const { return _variance; }
+    /// Does this HeavyFootprint own its pixel arrays (as opposed to still
+    /// referencing the parent image it was lazily constructed from)?
+    bool isMaterialized() const { return !_parent; }
 
     /* Returns the OR of all the mask pixels held in this HeavyFootprint. */
     MaskPixelT getMaskBitsSet() const {
+        _ensureMaterialized();
         MaskPixelT maskbits = 0;
         for (typename ndarray::Array<MaskPixelT, 1, 1>::Iterator i = _mask.begin(); i != _mask.end(); ++i) {
             maskbits |= *i;
@@ -135,9 +166,20 @@ protected:
     void write(OutputArchiveHandle& handle) const override;
 
 private:
-    ndarray::Array<ImagePixelT, 1, 1> _image;
-    ndarray::Array<MaskPixelT, 1, 1> _mask;
-    ndarray::Array<VariancePixelT, 1, 1> _variance;
+    /* Flatten the parent image's pixels into the owned arrays, if this
+     * HeavyFootprint was lazily constructed and has not yet been materialized
+     */
+    void _ensureMaterialized() const;
+
+    // The arrays are logically part of the object's value even when they are
+    // filled in lazily, so materialization is allowed from const methods
+    mutable ndarray::Array<ImagePixelT, 1, 1> _image;
+    mutable ndarray::Array<MaskPixelT, 1, 1> _mask;
+    mutable ndarray::Array<VariancePixelT, 1, 1> _variance;
+
+    // Parent image referenced while in the lazy (view) state; empty once materialized
+    mutable std::shared_ptr<lsst::afw::image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const>
+            _parent;
 };
 
 /**
@@ -161,6 +203,58 @@ template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 std::shared_ptr<HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT> > mergeHeavyFootprints(
         HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT> const& h1,
         HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT> const& h2);
+
+/**
+ * Insert the pixels of many HeavyFootprints into an image in one pass.
+ *
+ * The heavies are grouped by image region: each is assigned to one of `numThreads` disjoint
+ * row bands of the image based on its bounding box, and the bands are scattered in parallel,
+ * so no two threads ever write to the same rows.  Heavies whose bounding boxes straddle a
+ * band boundary are inserted serially once the bands have been joined; where heavies overlap
+ * the result may therefore differ from a serial loop, which overwrites strictly in order.
+ *
+ * @param heavies    HeavyFootprints to insert; null entries are skipped
+ * @param image      Image the pixels are inserted into
+ * @param numThreads number of threads to scatter the row bands with
+ */
+template <typename ImagePixelT, typename MaskPixelT = lsst::afw::image::MaskPixel,
+          typename VariancePixelT = lsst::afw::image::VariancePixel>
+void insertHeavyFootprints(
+        std::vector<std::shared_ptr<HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT> const> > const&
+                heavies,
+        lsst::afw::image::Image<ImagePixelT>& image, int numThreads = 1);
+
+/**
+ * Insert the pixels of many HeavyFootprints into a MaskedImage in one pass.
+ *
+ * @see insertHeavyFootprints(heavies, image, numThreads) for how the work is divided
+ * among the threads.
+ */
+template <typename ImagePixelT, typename MaskPixelT = lsst::afw::image::MaskPixel,
+          typename VariancePixelT = lsst::afw::image::VariancePixel>
+void insertHeavyFootprints(
+        std::vector<std::shared_ptr<HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT> const> > const&
+                heavies,
+        lsst::afw::image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& mimage, int numThreads = 1);
+
+/**
+ * Create HeavyFootprints for many Footprints against the same MaskedImage in one pass.
+ *
+ * Flattening only reads the image, so the footprints are simply divided among the threads;
+ * the result is element-for-element identical to calling makeHeavyFootprint on each
+ * footprint in turn.  Null entries produce null outputs.
+ *
+ * @param footprints Footprints defining the pixels to extract; null entries are skipped
+ * @param mimage     the pixel values
+ * @param ctrl       control how we manipulate HeavyFootprints
+ * @param numThreads number of threads to extract the footprints with
+ */
+template <typename ImagePixelT, typename MaskPixelT = lsst::afw::image::MaskPixel,
+          typename VariancePixelT = lsst::afw::image::VariancePixel>
+std::vector<std::shared_ptr<HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT> > > makeHeavyFootprints(
+        std::vector<std::shared_ptr<Footprint const> > const& footprints,
+        lsst::afw::image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const& mimage,
+        HeavyFootprintCtrl const* ctrl = NULL, int numThreads = 1);
 }  // namespace detection
 }  // namespace afw
 }  // namespace lsst
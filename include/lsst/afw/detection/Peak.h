@@ -106,6 +106,20 @@ public:
     typedef afw::table::CatalogT<Record> Catalog;
     typedef afw::table::CatalogT<Record const> ConstCatalog;
 
+    /**
+     *  Number of record objects allocated per arena slab.
+     *
+     *  Unlike the field data (which BaseTable already allocates in blocks),
+     *  each record object and its shared_ptr control block would normally be
+     *  a separate heap allocation; PeakTable pools them in slabs of this
+     *  many records (see table::detail::RecordArena) so that crowded-field
+     *  detection, which creates millions of peaks, does not contend on the
+     *  global allocator.  Slabs are returned to the system in bulk once all
+     *  of their records are gone.  Changes affect arenas created after the
+     *  change.
+     */
+    static int nRecordsPerArenaBlock;
+
     ~PeakTable() override;
     PeakTable& operator=(PeakTable const&) = delete;
     PeakTable& operator=(PeakTable&&) = delete;
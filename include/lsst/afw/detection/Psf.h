@@ -25,10 +25,12 @@
 
 #include <string>
 #include <limits>
+#include <vector>
 
 #include <memory>
 
-#include "lsst/utils/CacheFwd.h"
+#include "ndarray.h"
+
 #include "lsst/afw/geom/ellipses/Quadrupole.h"
 #include "lsst/afw/math/Kernel.h"
 #include "lsst/afw/image/Color.h"
@@ -43,6 +45,9 @@ namespace detail {
 /// Key for caching PSFs with lsst::utils::Cache
 struct PsfCacheKey;
 
+/// Thread-sharded realization cache (defined in Psf.cc)
+class ShardedPsfCache;
+
 }  // namespace detail
 
 /**
@@ -175,6 +180,23 @@ public:
                                               image::Color color = image::Color(),
                                               ImageOwnerEnum owner = COPY) const;
 
+    /**
+     *  Return Images of the PSF at a batch of positions, as computeImage would.
+     *
+     *  The positions are evaluated in an order sorted by their (quantized)
+     *  location, so that near-duplicate evaluations are adjacent and hit the
+     *  internal caches before being evicted; the returned images are in the
+     *  same order as @a positions.  This is the preferred entry point when
+     *  evaluating the PSF at every source position in a catalog, e.g. for
+     *  forced photometry.
+     *
+     *  @param[in]  positions    Positions to evaluate the PSF at.
+     *  @param[in]  color        Color of the sources for which to evaluate the PSF; defaults to
+     *                           getAverageColor().
+     */
+    std::vector<std::shared_ptr<Image>> computeImageBatch(
+            std::vector<lsst::geom::Point2D> const& positions, image::Color color = image::Color()) const;
+
     /**
      *   Return the peak value of the PSF image.
      *
@@ -203,6 +225,26 @@ public:
     double computeApertureFlux(double radius, lsst::geom::Point2D position = makeNullPoint(),
                                image::Color color = image::Color()) const;
 
+    /**
+     *  Compute aperture fluxes for a batch of positions and radii.
+     *
+     *  Returns a (positions x radii) matrix of curve-of-growth values, each element computed
+     *  as computeApertureFlux would.  The positions are visited sorted by their (quantized)
+     *  location so that the kernel-image realizations behind the per-element computation are
+     *  fetched from the internal caches rather than recomputed, and all radii for a position
+     *  are measured against the same realization before moving to the next one.  This is the
+     *  preferred entry point for evaluating a curve-of-growth grid, e.g. for aperture
+     *  corrections.
+     *
+     *  @param[in]  radii        Radii of the apertures to measure, in pixels.
+     *  @param[in]  positions    Positions to evaluate the PSF at.
+     *  @param[in]  color        Color of the sources for which to evaluate the PSF; defaults to
+     *                           getAverageColor().
+     */
+    ndarray::Array<double, 2, 2> computeApertureFluxBatch(
+            ndarray::Array<double const, 1> const& radii, std::vector<lsst::geom::Point2D> const& positions,
+            image::Color color = image::Color()) const;
+
     /**
      *  Compute the ellipse corresponding to the second moments of the Psf.
      *
@@ -277,9 +319,27 @@ public:
     /** Set the capacity of the caches
      *
      * Both the image and kernel image caches will be set to this capacity.
+     * The caches are sharded by thread, and the capacity applies to each
+     * shard individually.
      */
     void setCacheCapacity(std::size_t capacity);
 
+    /** Return the position tolerance used when caching kernel images
+     */
+    double getCachePositionTolerance() const { return _cachePositionTolerance; }
+
+    /** Set the position tolerance used when caching kernel images
+     *
+     * When the tolerance is positive, positions passed to computeKernelImage
+     * are snapped to a grid with this spacing (in pixels) before the model is
+     * evaluated or cached, so calls at nearby positions share a single
+     * realization.  This is appropriate for PSF models that vary slowly with
+     * position.  The sub-pixel recentering done by computeImage always uses
+     * the exact requested position and is unaffected.  The default tolerance
+     * of zero caches on exact positions only.
+     */
+    void setCachePositionTolerance(double tolerance) { _cachePositionTolerance = tolerance; }
+
 protected:
     /**
      *  Main constructor for subclasses.
@@ -317,10 +377,21 @@ private:
                                             image::Color const& color) const = 0;
     //@}
 
+    /* Snap a position to the cache tolerance grid; a no-op when the tolerance is zero
+     */
+    lsst::geom::Point2D _quantizePosition(lsst::geom::Point2D const& position) const;
+
+    /* Return the indices of positions sorted by quantized location, so batch loops visit
+     * near-duplicate positions consecutively and hit the caches before they are evicted
+     */
+    std::vector<std::size_t> _sortPositionsForBatch(std::vector<lsst::geom::Point2D> const& positions) const;
+
     bool const _isFixed;
-    using PsfCache = utils::Cache<detail::PsfCacheKey, std::shared_ptr<Image>>;
-    std::unique_ptr<PsfCache> _imageCache;
-    std::unique_ptr<PsfCache> _kernelImageCache;
+    double _cachePositionTolerance;
+    // Realization caches, sharded by thread so that one shared Psf can serve many
+    // measurement threads without contending on a single lock (see Psf.cc).
+    std::unique_ptr<detail::ShardedPsfCache> _imageCache;
+    std::unique_ptr<detail::ShardedPsfCache> _kernelImageCache;
 };
 }  // namespace detection
 }  // namespace afw
@@ -14,14 +14,18 @@
  */
 
 #include <climits>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <set>
+#include <vector>
 
 #include <boost/format.hpp>
 
 #include "lsst/base.h"
 #include "lsst/pex/exceptions.h"
 #include "lsst/daf/base.h"
+#include "lsst/geom/Box.h"
 #include "ndarray.h"
 #include "lsst/afw/fitsCompression.h"
 #include "lsst/afw/fitsDefaults.h"
@@ -126,7 +130,7 @@ public:
      *  The manager will still free the memory when it goes out of scope, but all allocation
      *  and reallocation will be performed by cfitsio as needed.
      */
-    MemFileManager() : _ptr(0), _len(0), _managed(true) {}
+    MemFileManager() : _ptr(0), _len(0), _managed(true), _mmap(false) {}
 
     /**
      *  Construct a MemFileManager with (len) bytes of initial memory.
@@ -134,7 +138,7 @@ public:
      *  The manager will free the memory when it goes out of scope, and cfitsio will be allowed
      *  to reallocate the internal memory as needed.
      */
-    explicit MemFileManager(std::size_t len) : _ptr(0), _len(0), _managed(true) { reset(len); }
+    explicit MemFileManager(std::size_t len) : _ptr(0), _len(0), _managed(true), _mmap(false) { reset(len); }
 
     /**
      *  Construct a MemFileManager that references and does not manage external memory.
@@ -143,7 +147,7 @@ public:
      *  either.  The user must provide enough initial memory and is responsible for freeing
      *  it manually after the FITS file has been closed.
      */
-    MemFileManager(void* ptr, std::size_t len) : _ptr(ptr), _len(len), _managed(false) {}
+    MemFileManager(void* ptr, std::size_t len) : _ptr(ptr), _len(len), _managed(false), _mmap(false) {}
 
     /**
      *  Return the manager to the same state it would be if default-constructed.
@@ -162,6 +166,40 @@ public:
      */
     void reset(std::size_t len);
 
+    /**
+     *  Set the internal memory buffer to a growable, mmap-backed allocation of (len) bytes.
+     *
+     *  `reserve` bytes of virtual address space are reserved up front (the default is
+     *  4 GiB; address space is essentially free on 64-bit systems) and physical pages
+     *  are committed by the kernel on first write, so growing the in-memory FITS file
+     *  within the reservation never copies it.  This is much faster than the
+     *  realloc-based growth used by reset(std::size_t) when serializing large objects
+     *  to memory.  Growth beyond the reservation is still handled, by remapping.
+     *
+     *  This must not be called while a FITS file that uses this memory is open.
+     *
+     *  Memory allocated with resetMmap can be grown by cfitsio and will be unmapped
+     *  when the manager goes out of scope or is reset.
+     *
+     *  @throws lsst::pex::exceptions::MemoryError Thrown if the reservation fails.
+     */
+    void resetMmap(std::size_t len, std::size_t reserve = std::size_t(1) << 32);
+
+    /**
+     *  Transfer ownership of the buffer out of the manager without copying it.
+     *
+     *  The returned pointer owns the buffer via a deleter that performs whatever
+     *  deallocation is appropriate to how the buffer was allocated, and `len` is set
+     *  to the buffer length.  The manager itself is returned to the state it would be
+     *  in if default-constructed.
+     *
+     *  This must not be called while a FITS file that uses this memory is open.
+     *
+     *  @throws lsst::pex::exceptions::LogicError Thrown if the manager references
+     *          external memory it does not own.
+     */
+    std::shared_ptr<void> release(std::size_t& len);
+
     /**
      *  Set the internal memory buffer to an manually-managed external block.
      *
@@ -199,6 +237,7 @@ private:
     void* _ptr;
     std::size_t _len;
     bool _managed;
+    bool _mmap;  // true if the managed buffer was allocated by resetMmap
 };
 
 /// Construct a contiguous ndarray
@@ -219,6 +258,7 @@ ndarray::Array<T const, N, N> const makeContiguousArray(ndarray::Array<T, N, C>
 struct ImageWriteOptions {
     ImageCompressionOptions compression;  ///< Options controlling compression
     ImageScalingOptions scaling;          ///< Options controlling scaling
+    int threads = 1;  ///< Number of threads for scaling/quantizing pixels before compression
 
     /// Construct with default options for images
     template <typename T>
@@ -254,6 +294,7 @@ struct ImageWriteOptions {
     /// * scaling.quantizePad: number of stdev to allow on the low side (for STDEV_POSITIVE/NEGATIVE)
     /// * scaling.bscale: manually specified BSCALE (for MANUAL scaling)
     /// * scaling.bzero: manually specified BSCALE (for MANUAL scaling)
+    /// * threads (int): number of threads for scaling/quantizing pixels before compression
     ///
     /// Use the 'validate' method to set default values for the above.
     ///
@@ -301,6 +342,7 @@ class Fits {
     template <typename T>
     void readImageImpl(int nAxis, T* data, long* begin, long* end, long* increment);
     void getImageShapeImpl(int maxDim, long* nAxes);
+    std::shared_ptr<void> mapImageImpl(int nAxis, long* nAxes, int bitpix);
 
 public:
     enum BehaviorFlags {
@@ -547,6 +589,33 @@ public:
         readImageImpl(N, array.getData(), begin.elems, end.elems, increment.elems);
     }
 
+    /**
+     *  Map the data unit of the current (image) HDU into memory, without copying.
+     *
+     *  @returns the pixels as an array backed by a private, copy-on-write mapping
+     *  of the file, or an empty array if the HDU cannot be mapped.
+     *
+     *  Mapping is only possible when the HDU lives in an uncompressed, seekable
+     *  disk file, the pixel type T matches the on-disk BITPIX exactly, and no
+     *  BSCALE/BZERO rescaling applies; callers must fall back to readImage when
+     *  an empty array is returned.  FITS data are big-endian, so on little-endian
+     *  hosts the pixels are byte-swapped in place after mapping (dirtying the
+     *  affected pages).  The mapping is private: modifications to the array are
+     *  never written back to the file.
+     */
+    template <typename T, int N>
+    ndarray::Array<T, N, N> readImageMapped() {
+        ndarray::Vector<long, N> nAxes(1);
+        std::shared_ptr<void> pixels = mapImageImpl(N, nAxes.elems, getBitPix<T>());
+        if (!pixels) {
+            return ndarray::Array<T, N, N>();
+        }
+        ndarray::Vector<ndarray::Size, N> shape;
+        for (int i = 0; i < N; ++i) shape[i] = nAxes[N - i - 1];
+        std::shared_ptr<T> typed = std::static_pointer_cast<T>(pixels);
+        return ndarray::external(typed.get(), shape, ndarray::ROW_MAJOR, typed);
+    }
+
     /// Create a new binary table extension.
     void createTable();
 
@@ -599,6 +668,14 @@ public:
     /// Read a string from a binary table.
     void readTableScalar(std::size_t row, int col, std::string& value, bool isVariableLength);
 
+    /**
+     *  Read strings from consecutive rows of a fixed-width string column in a binary table.
+     *
+     *  Variable-length string fields cannot be read this way, as their values live in the
+     *  heap rather than the main table.
+     */
+    void readTableStringArray(std::size_t row, int col, int nRows, std::string* value);
+
     /// Return the size of an array column.
     long getTableArraySize(int col);
 
@@ -625,6 +702,9 @@ public:
     /// Return the current image compression settings
     ImageCompressionOptions getImageCompression();
 
+    /// Return true if the current HDU is a tile-compressed image
+    bool isCompressedImage();
+
     /// Go to the first image header in the FITS file
     ///
     /// If a single image is written compressed, it appears as an extension,
@@ -651,6 +731,80 @@ public:
     int behavior;  // bitwise OR of BehaviorFlags
 };
 
+/**
+ *  A pool of read-mode Fits handles for a single file.
+ *
+ *  Each handle in the pool is a full, independently-buffered and
+ *  independently-positioned open of the same file, so handles acquired from
+ *  the pool may be used from different threads at the same time (cfitsio
+ *  handles that share internal state are not safe for concurrent use).  The
+ *  pool amortizes the open cost across users: a handle returned to the pool
+ *  is recycled by the next acquire instead of reopening the file, which is
+ *  what makes reading several HDUs of the same file in parallel affordable.
+ *
+ *  Acquire and release are thread-safe; leases must not outlive the pool.
+ */
+class FitsHandlePool final {
+public:
+    /**
+     *  An RAII lease on a Fits handle; the handle is returned to the pool
+     *  when the lease is destroyed.
+     */
+    class Lease final {
+    public:
+        Lease(Lease&& other) noexcept : _pool(other._pool), _fits(std::move(other._fits)) {
+            other._pool = nullptr;
+        }
+        Lease& operator=(Lease&&) = delete;
+        Lease(Lease const&) = delete;
+        Lease& operator=(Lease const&) = delete;
+
+        ~Lease();
+
+        /// Return the leased handle.
+        Fits& operator*() const { return *_fits; }
+        Fits* operator->() const { return _fits.get(); }
+
+    private:
+        friend class FitsHandlePool;
+
+        Lease(FitsHandlePool& pool, std::unique_ptr<Fits> fits) : _pool(&pool), _fits(std::move(fits)) {}
+
+        FitsHandlePool* _pool;
+        std::unique_ptr<Fits> _fits;
+    };
+
+    /// Construct a pool for the given file; no handle is opened until the first acquire.
+    explicit FitsHandlePool(std::string const& fileName) : _fileName(fileName) {}
+
+    // Leases hold pointers back to the pool, so it cannot move or be copied.
+    FitsHandlePool(FitsHandlePool const&) = delete;
+    FitsHandlePool(FitsHandlePool&&) = delete;
+    FitsHandlePool& operator=(FitsHandlePool const&) = delete;
+    FitsHandlePool& operator=(FitsHandlePool&&) = delete;
+
+    /**
+     *  Acquire a handle, recycling an idle one if possible.
+     *
+     *  The handle is opened with AUTO_CLOSE | AUTO_CHECK and may be
+     *  positioned at any HDU; callers should call setHdu before reading.
+     *
+     *  @throws FitsError Thrown if the file cannot be opened.
+     */
+    Lease acquire();
+
+    /// Return the name of the file the pool reads.
+    std::string getFileName() const { return _fileName; }
+
+private:
+    // Return a handle to the pool; handles in an error state are discarded.
+    void _release(std::unique_ptr<Fits> fits);
+
+    std::string _fileName;
+    std::mutex _mutex;
+    std::vector<std::unique_ptr<Fits>> _idle;
+};
+
 /**
  * Combine two sets of metadata in a FITS-appropriate fashion
  *
@@ -707,9 +861,84 @@ std::shared_ptr<daf::base::PropertyList> readMetadata(fits::MemFileManager& mana
  */
 std::shared_ptr<daf::base::PropertyList> readMetadata(fits::Fits& fitsfile, bool strip = false);
 
+/** Ask the kernel to start reading a FITS file into the page cache.
+ *
+ * The readahead is asynchronous: this returns immediately, and subsequent
+ * reads of the file (all HDUs) overlap with computation instead of waiting
+ * on storage. Call it for the files a visit is about to load, or rely on
+ * MaskedImageFitsReader, which prefetches the files it opens so the mask
+ * and variance HDUs stream in while the image HDU is being parsed.
+ *
+ * Nonexistent files and filesystems without readahead support are ignored:
+ * prefetching is only ever a hint.
+ *
+ * @param fileName the file to warm.
+ */
+void prefetchFitsFile(std::string const& fileName);
+
 void setAllowImageCompression(bool allow);
 bool getAllowImageCompression();
 
+/**
+ *  Incremental writer that streams an image into a FITS file as row strips.
+ *
+ *  The HDU is created up front from the full bounding box and the header is
+ *  written immediately, so each strip can be appended with writeStrip as it
+ *  is produced (e.g. by a strip-based stacker) and discarded; producing a
+ *  plane never requires more than one strip in memory.
+ *
+ *  Pixels are written with their native type, optionally tile-compressed
+ *  (row-based tiles line up naturally with strips).  Scaling to a different
+ *  BITPIX requires statistics of the full image and is therefore not
+ *  supported: the scaling algorithm in the options must be NONE.
+ */
+template <typename T>
+class ImageStripWriter final {
+public:
+    /**
+     *  Create the file, the image HDU, and its header.
+     *
+     *  @param[in] fileName  Name of the file to write.
+     *  @param[in] bbox      Bounding box of the full image being written; the
+     *                       XY0 offset is recorded in the header as usual.
+     *  @param[in] options   Options controlling the write; the scaling
+     *                       algorithm must be NONE.
+     *  @param[in] header    FITS header to write.
+     */
+    ImageStripWriter(std::string const& fileName, lsst::geom::Box2I const& bbox,
+                     ImageWriteOptions const& options = ImageWriteOptions(),
+                     std::shared_ptr<daf::base::PropertySet const> header = nullptr);
+
+    ImageStripWriter(ImageStripWriter const&) = delete;
+    ImageStripWriter(ImageStripWriter&&) = delete;
+    ImageStripWriter& operator=(ImageStripWriter const&) = delete;
+    ImageStripWriter& operator=(ImageStripWriter&&) = delete;
+
+    /// Close the file without validation if close() has not been called.
+    ~ImageStripWriter() noexcept;
+
+    /**
+     *  Append the next rows of the image.
+     *
+     *  Strips must arrive in order, bottom row first; the strip width must
+     *  equal the image width.
+     */
+    void writeStrip(ndarray::Array<T const, 2, 2> const& strip);
+
+    /**
+     *  Finish writing: verify that all declared rows have arrived and close
+     *  the file.
+     */
+    void close();
+
+private:
+    Fits _fits;
+    long _width;
+    long _height;
+    long _nextRow;
+    bool _closed;
+};
+
 
 
 /**
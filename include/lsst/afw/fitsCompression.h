@@ -184,6 +184,10 @@ struct ImageCompressionOptions {
     ///
     /// We deliberately don't support HCOMPRESS: it doesn't appear to be useful to us (e.g., lossy)
     /// and it requires extra configuration.
+    ///
+    /// We cannot support ZSTD (despite its attractive speed/ratio trade-off): the FITS
+    /// tiled-image convention and cfitsio define no ZSTD codec, so any such files would
+    /// be unreadable by other FITS software. Revisit if the convention gains one.
     enum CompressionAlgorithm {
         NONE,          ///< No compression
         GZIP,          ///< Standard GZIP compression
@@ -288,11 +292,14 @@ struct ImageScale {
     /// @param[in] fuzz  Add random values before quantising?
     /// @param[in] tiles  Tile dimensions
     /// @param[in] seed  Seed for random number generator
+    /// @param[in] numThreads  Number of threads over which to divide the scaling;
+    ///     the result is identical regardless of the thread count.
     /// @return Array of pixel values, appropriately scaled.
     template <typename T>
     std::shared_ptr<detail::PixelArrayBase> toFits(
             ndarray::Array<T const, 2, 2> const& image, bool forceNonfiniteRemoval, bool fuzz = true,
-            ndarray::Array<long, 1> const& tiles = ndarray::Array<long, 1, 1>(), int seed = 1) const;
+            ndarray::Array<long, 1> const& tiles = ndarray::Array<long, 1, 1>(), int seed = 1,
+            int numThreads = 1) const;
 
     /// Convert to an array
     ///
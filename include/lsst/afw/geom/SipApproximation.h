@@ -337,6 +337,29 @@ public:
      */
     void fit(int order, double svdThreshold=-1);
 
+    /**
+     *  Replace the transform being approximated and refit the solution,
+     *  reusing the existing grid and fit machinery as a warm start.
+     *
+     *  The grid sample positions and the design matrix of the forward fit
+     *  depend only on the bounding box, grid shape, and fit parameters, not
+     *  on the transform itself, so when only the transform changes (e.g.
+     *  per-iteration updates from an iterative astrometric solver) the new
+     *  transform just needs to be evaluated once on the existing grid and
+     *  new right-hand sides solved with the cached matrix decomposition,
+     *  instead of repeating the full fit from scratch.
+     *
+     *  The polynomial order and singular value threshold of the previous
+     *  fit are retained.
+     *
+     *  @param[in]  pixelToIwc   The new Transform to approximate.  Should go
+     *                           from pixels to Intermediate World Coordinates
+     *                           when applyForward is called.
+     *
+     *  @exceptsafe strong
+     */
+    void updateTransform(std::shared_ptr<TransformPoint2ToPoint2> pixelToIwc);
+
     /**
      *  Return the maximum deviation of the solution from the exact transform
      *  on the current grid.
@@ -355,12 +378,17 @@ private:
 
     struct Grid;
     struct Solution;
+    class Fitter;
 
     bool _useInverse;
     std::shared_ptr<TransformPoint2ToPoint2> _pixelToIwc;
     lsst::geom::Box2D _bbox;
     lsst::geom::Extent2D _crpix;
     lsst::geom::LinearTransform _cdInv;
+    // Lazily-constructed cache of the forward-fit least-squares machinery;
+    // valid as long as the grid sample positions and fit parameters do not
+    // change (see updateTransform).
+    mutable std::unique_ptr<Fitter const> _fitter;
     std::unique_ptr<Grid const> _grid;
     std::unique_ptr<Solution const> _solution;
 };
@@ -171,6 +171,17 @@ public:
      */
     std::shared_ptr<SkyWcs> copyAtShiftedPixelOrigin(lsst::geom::Extent2D const &shift) const;
 
+    /**
+     * Return a deep copy of this SkyWcs that shares no AST objects with this one.
+     *
+     * Copy construction (and hence cloneStorable) is shallow: the copies share the underlying
+     * ast::FrameDict, so concurrent transforms through them serialize on AST's per-object lock.
+     * This method copies the frame dict itself, so batched pixelToSky/skyToPixel calls through
+     * the result do not contend with calls through this object.  To run chunked full-catalog
+     * coordinate conversions in parallel, give each worker thread its own deep copy.
+     */
+    std::shared_ptr<SkyWcs> deepCopy() const;
+
     /**
      * Return the WCS as FITS WCS metadata
      *
@@ -332,12 +343,23 @@ public:
      */
     //@{
     lsst::geom::SpherePoint pixelToSky(lsst::geom::Point2D const &pixel) const {
+        if (_hasTanFastPath) {
+            return _tanPixelToSky(pixel);
+        }
         return _transform->applyForward(pixel);
     }
     lsst::geom::SpherePoint pixelToSky(double x, double y) const {
         return pixelToSky(lsst::geom::Point2D(x, y));
     }
     std::vector<lsst::geom::SpherePoint> pixelToSky(std::vector<lsst::geom::Point2D> const &pixels) const {
+        if (_hasTanFastPath) {
+            std::vector<lsst::geom::SpherePoint> result;
+            result.reserve(pixels.size());
+            for (auto const &pixel : pixels) {
+                result.push_back(_tanPixelToSky(pixel));
+            }
+            return result;
+        }
         return _transform->applyForward(pixels);
     }
     //@}
@@ -347,9 +369,20 @@ public:
      */
     //@{
     lsst::geom::Point2D skyToPixel(lsst::geom::SpherePoint const &sky) const {
+        if (_hasTanFastPath) {
+            return _tanSkyToPixel(sky);
+        }
         return _transform->applyInverse(sky);
     }
     std::vector<lsst::geom::Point2D> skyToPixel(std::vector<lsst::geom::SpherePoint> const &sky) const {
+        if (_hasTanFastPath) {
+            std::vector<lsst::geom::Point2D> result;
+            result.reserve(sky.size());
+            for (auto const &coord : sky) {
+                result.push_back(_tanSkyToPixel(coord));
+            }
+            return result;
+        }
         return _transform->applyInverse(sky);
     }
     //@}
@@ -453,6 +486,17 @@ private:
     lsst::geom::Point2D _pixelOrigin;       // cached pixel origin
     lsst::geom::Angle _pixelScaleAtOrigin;  // cached pixel scale at pixel origin
 
+    // Closed-form gnomonic fast path for the common case of a pure TAN WCS (no SIP terms
+    // or other distortion). Detected at construction by _setupTanFastPath; all members
+    // below are derived caches and do not participate in equality or persistence.
+    bool _hasTanFastPath = false;
+    double _tanAlpha0 = 0;                  // CRVAL longitude (radians)
+    double _tanSinDelta0 = 0;               // sine of CRVAL latitude
+    double _tanCosDelta0 = 0;               // cosine of CRVAL latitude
+    lsst::geom::Point2D _tanCrpix;          // pixel origin (CRPIX, LSST convention)
+    Eigen::Matrix2d _tanCd;                 // CD matrix in radians/pixel
+    Eigen::Matrix2d _tanCdInv;              // inverse of _tanCd
+
     /*
      * Implementation for the overloaded public linearizePixelToSky methods, requiring both a pixel coordinate
      * and the corresponding sky coordinate.
@@ -469,11 +513,31 @@ private:
                                                      lsst::geom::SpherePoint const &coord,
                                                      lsst::geom::AngleUnit const &skyUnit) const;
 
+    /*
+     * Detect whether this WCS is a pure TAN projection with a linear CD matrix and,
+     * if so, cache the quantities needed for closed-form evaluation.
+     *
+     * Detection is empirical: the closed-form gnomonic transform built from the pixel
+     * origin, sky origin and CD matrix is compared against the generic transform at a
+     * grid of sample points, and the fast path is enabled only if they agree to well
+     * below the accuracy of either. Never throws; on any failure the fast path is
+     * simply left disabled.
+     */
+    void _setupTanFastPath() noexcept;
+
+    /// Closed-form gnomonic pixelToSky; only valid if _hasTanFastPath
+    lsst::geom::SpherePoint _tanPixelToSky(lsst::geom::Point2D const &pixel) const;
+
+    /// Closed-form gnomonic skyToPixel; only valid if _hasTanFastPath
+    lsst::geom::Point2D _tanSkyToPixel(lsst::geom::SpherePoint const &sky) const;
+
     /// Compute _pixelOrigin and _pixelScaleAtOrigin
     void _computeCache() {
+        _hasTanFastPath = false;
         _transform = std::make_shared<TransformPoint2ToSpherePoint>(*_frameDict->getMapping(), true);
         _pixelOrigin = skyToPixel(getSkyOrigin());
         _pixelScaleAtOrigin = getPixelScale(_pixelOrigin);
+        _setupTanFastPath();
     }
 };
 
@@ -517,6 +581,26 @@ std::shared_ptr<SkyWcs> makeFlippedWcs(SkyWcs const &wcs, bool flipLR, bool flip
 std::shared_ptr<SkyWcs> makeModifiedWcs(TransformPoint2ToPoint2 const &pixelTransform, SkyWcs const &wcs,
                                         bool modifyActualPixels);
 
+/**
+ * Create modified WCSes for a batch of input WCSes, inserting the same pixel transform into each
+ *
+ * Equivalent to calling @ref makeModifiedWcs(TransformPoint2ToPoint2 const &, SkyWcs const &, bool)
+ * "makeModifiedWcs" for each input in turn, but the inputs are processed concurrently on the
+ * process-wide thread pool.  This is intended for per-visit WCS updates that apply one distortion
+ * model to every detector of a camera: the mapping compositions and simplifications, which dominate
+ * the cost, run in parallel instead of serially.
+ *
+ * @param[in] pixelTransform  Transform to insert
+ * @param[in] wcsList  Input WCSes; all entries must be non-null
+ * @param[in] modifyActualPixels  Location at which to insert the transform; see the scalar overload
+ * @return the new WCSes, in the same order as `wcsList`
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if any entry of `wcsList` is null.
+ */
+std::vector<std::shared_ptr<SkyWcs>> makeModifiedWcs(
+        TransformPoint2ToPoint2 const &pixelTransform,
+        std::vector<std::shared_ptr<SkyWcs const>> const &wcsList, bool modifyActualPixels);
+
 /**
  * Construct a SkyWcs from FITS keywords
  *
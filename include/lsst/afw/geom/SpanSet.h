@@ -29,6 +29,7 @@
 #include <algorithm>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <utility>
 #include "lsst/pex/exceptions.h"
 #include "lsst/afw/geom/Span.h"
@@ -242,10 +243,16 @@ public:
     bool contains(lsst::geom::Point2I const &point) const;
 
     /** Compute the point about which the SpanSet's first moment is zero
+     *
+     * As a SpanSet is immutable the result is computed once and cached, so
+     * repeat calls are cheap
      */
     lsst::geom::Point2D computeCentroid() const;
 
     /** Compute the shape parameters for the distribution of points in the SpanSet
+     *
+     * As a SpanSet is immutable the result is computed once and cached, so
+     * repeat calls are cheap
      */
     ellipses::Quadrupole computeShape() const;
 
@@ -336,11 +343,10 @@ public:
     void flatten(ndarray::Array<PixelOut, inA - 1, outC> const &output,
                  ndarray::Array<PixelIn, inA, inC> const &input,
                  lsst::geom::Point2I const &xy0 = lsst::geom::Point2I()) const {
-        auto ndAssigner = [](lsst::geom::Point2I const &point,
-                             typename details::FlatNdGetter<PixelOut, inA - 1, outC>::Reference out,
-                             typename details::ImageNdGetter<PixelIn, inA, inC>::Reference in) { out = in; };
-        // Populate array output with values from input at positions given by SpanSet
-        applyFunctor(ndAssigner, ndarray::ndFlat(output), ndarray::ndImage(input, xy0));
+        // Copy scalar pixels a span at a time when possible, otherwise fall back
+        // on the per-pixel functor machinery
+        _flattenImpl(output, input, xy0,
+                     std::integral_constant<bool, inA == 2 && _isPlainCopy<PixelIn, PixelOut>::value>());
     }
 
     /** Expand an array by one spatial dimension at points given by SpanSet
@@ -398,11 +404,10 @@ public:
                    ndarray::Array<PixelIn, inA, inC> const &input,
                    lsst::geom::Point2I const &xy0 = lsst::geom::Point2I()) const {
         // Populate 2D ndarray output with values from input, at locations defined by SpanSet, optionally
-        // offset by xy0
-        auto ndAssigner = [](lsst::geom::Point2I const &point,
-                             typename details::ImageNdGetter<PixelOut, inA + 1, outC>::Reference out,
-                             typename details::FlatNdGetter<PixelIn, inA, inC>::Reference in) { out = in; };
-        applyFunctor(ndAssigner, ndarray::ndImage(output, xy0), ndarray::ndFlat(input));
+        // offset by xy0.  Copy scalar pixels a span at a time when possible, otherwise fall
+        // back on the per-pixel functor machinery
+        _unflattenImpl(output, input, xy0,
+                       std::integral_constant<bool, inA == 1 && _isPlainCopy<PixelIn, PixelOut>::value>());
     }
 
     /** Copy contents of source Image into destination image at the positions defined in the SpanSet
@@ -414,10 +419,11 @@ public:
      */
     template <typename ImageT>
     void copyImage(image::Image<ImageT> const &src, image::Image<ImageT> &dest) {
-        auto copyFunc = [](lsst::geom::Point2I const &point, ImageT const &srcPix, ImageT &destPix) {
-            destPix = srcPix;
-        };
-        applyFunctor(copyFunc, src, dest);
+        // The pixels of each span are contiguous in both images, so check the
+        // bounds once and copy whole spans instead of calling a functor per pixel
+        details::makeGetter(src).checkExtents(_bbox, _area);
+        details::makeGetter(dest).checkExtents(_bbox, _area);
+        _copySpans(src.getArray(), src.getXY0(), dest.getArray(), dest.getXY0());
     }
 
     /** Copy contents of source MaskedImage into destination image at the positions defined in the SpanSet
@@ -432,14 +438,13 @@ public:
     template <typename ImageT, typename MaskT, typename VarT>
     void copyMaskedImage(image::MaskedImage<ImageT, MaskT, VarT> const &src,
                          image::MaskedImage<ImageT, MaskT, VarT> &dest) {
-        auto copyFunc = [](lsst::geom::Point2I const &point, ImageT const &srcPix, MaskT const &srcMask,
-                           VarT const &srcVar, ImageT &destPix, MaskT &destMask, VarT &destVar) {
-            destPix = srcPix;
-            destMask = srcMask;
-            destVar = srcVar;
-        };
-        applyFunctor(copyFunc, *(src.getImage()), *(src.getMask()), *(src.getVariance()), *(dest.getImage()),
-                     *(dest.getMask()), *(dest.getVariance()));
+        // Copy each of the planes span by span, as copyImage does
+        details::makeGetter(*(src.getImage())).checkExtents(_bbox, _area);
+        details::makeGetter(*(dest.getImage())).checkExtents(_bbox, _area);
+        _copySpans(src.getImage()->getArray(), src.getXY0(), dest.getImage()->getArray(), dest.getXY0());
+        _copySpans(src.getMask()->getArray(), src.getXY0(), dest.getMask()->getArray(), dest.getXY0());
+        _copySpans(src.getVariance()->getArray(), src.getXY0(), dest.getVariance()->getArray(),
+                   dest.getXY0());
     }
 
     /** Set the values of an Image at points defined by the SpanSet
@@ -748,6 +753,83 @@ private:
 
     std::shared_ptr<SpanSet> makeShift(int x, int y) const;
 
+    /* Trait identifying flatten/unflatten calls which are plain element-wise copies,
+     * and can therefore be done a span at a time instead of a pixel at a time
+     */
+    template <typename PixelIn, typename PixelOut>
+    struct _isPlainCopy
+            : std::is_same<typename std::remove_const<PixelIn>::type,
+                           typename std::remove_const<PixelOut>::type> {};
+
+    /* Copy the pixels of each span between two 2D arrays, each with its own origin.
+     * The caller is responsible for bounds checking
+     */
+    template <typename PixelIn, typename PixelOut, int inC, int outC>
+    void _copySpans(ndarray::Array<PixelIn, 2, inC> const &input, lsst::geom::Point2I const &inXY0,
+                    ndarray::Array<PixelOut, 2, outC> const &output,
+                    lsst::geom::Point2I const &outXY0) const {
+        for (auto const &spn : _spanVector) {
+            auto const inRow = input[spn.getY() - inXY0.getY()];
+            auto const outRow = output[spn.getY() - outXY0.getY()];
+            std::copy(inRow.begin() + (spn.getMinX() - inXY0.getX()),
+                      inRow.begin() + (spn.getMaxX() + 1 - inXY0.getX()),
+                      outRow.begin() + (spn.getMinX() - outXY0.getX()));
+        }
+    }
+
+    // Span-at-a-time flatten for plain copies of scalar pixels
+    template <typename PixelIn, typename PixelOut, int inA, int outC, int inC>
+    void _flattenImpl(ndarray::Array<PixelOut, inA - 1, outC> const &output,
+                      ndarray::Array<PixelIn, inA, inC> const &input, lsst::geom::Point2I const &xy0,
+                      std::true_type) const {
+        ndarray::ndFlat(output).checkExtents(_bbox, _area);
+        ndarray::ndImage(input, xy0).checkExtents(_bbox, _area);
+        auto outIter = output.begin();
+        for (auto const &spn : _spanVector) {
+            auto const inRow = input[spn.getY() - xy0.getY()];
+            outIter = std::copy(inRow.begin() + (spn.getMinX() - xy0.getX()),
+                                inRow.begin() + (spn.getMaxX() + 1 - xy0.getX()), outIter);
+        }
+    }
+
+    // Per-pixel flatten for everything else
+    template <typename PixelIn, typename PixelOut, int inA, int outC, int inC>
+    void _flattenImpl(ndarray::Array<PixelOut, inA - 1, outC> const &output,
+                      ndarray::Array<PixelIn, inA, inC> const &input, lsst::geom::Point2I const &xy0,
+                      std::false_type) const {
+        auto ndAssigner = [](lsst::geom::Point2I const &point,
+                             typename details::FlatNdGetter<PixelOut, inA - 1, outC>::Reference out,
+                             typename details::ImageNdGetter<PixelIn, inA, inC>::Reference in) { out = in; };
+        // Populate array output with values from input at positions given by SpanSet
+        applyFunctor(ndAssigner, ndarray::ndFlat(output), ndarray::ndImage(input, xy0));
+    }
+
+    // Span-at-a-time unflatten for plain copies of scalar pixels
+    template <typename PixelIn, typename PixelOut, int inA, int outC, int inC>
+    void _unflattenImpl(ndarray::Array<PixelOut, inA + 1, outC> const &output,
+                        ndarray::Array<PixelIn, inA, inC> const &input, lsst::geom::Point2I const &xy0,
+                        std::true_type) const {
+        ndarray::ndImage(output, xy0).checkExtents(_bbox, _area);
+        ndarray::ndFlat(input).checkExtents(_bbox, _area);
+        auto inIter = input.begin();
+        for (auto const &spn : _spanVector) {
+            auto const outRow = output[spn.getY() - xy0.getY()];
+            std::copy(inIter, inIter + spn.getWidth(), outRow.begin() + (spn.getMinX() - xy0.getX()));
+            inIter += spn.getWidth();
+        }
+    }
+
+    // Per-pixel unflatten for everything else
+    template <typename PixelIn, typename PixelOut, int inA, int outC, int inC>
+    void _unflattenImpl(ndarray::Array<PixelOut, inA + 1, outC> const &output,
+                        ndarray::Array<PixelIn, inA, inC> const &input, lsst::geom::Point2I const &xy0,
+                        std::false_type) const {
+        auto ndAssigner = [](lsst::geom::Point2I const &point,
+                             typename details::ImageNdGetter<PixelOut, inA + 1, outC>::Reference out,
+                             typename details::FlatNdGetter<PixelIn, inA, inC>::Reference in) { out = in; };
+        applyFunctor(ndAssigner, ndarray::ndImage(output, xy0), ndarray::ndFlat(input));
+    }
+
     template <typename F, typename... T>
     void applyFunctorImpl(F &&f, T... args) const {
         /* Implementation for applying functors, loop over each of the spans, and then
@@ -775,6 +857,14 @@ private:
 
     // Number of pixels in the SpanSet
     std::size_t _area;
+
+    // Lazily computed moments; the SpanSet is immutable so once computed these never change.
+    // SpanSets are shared across threads via shared_ptr (e.g. Footprints), so the one-time
+    // computation is synchronized with call_once rather than a plain bool flag.
+    mutable std::once_flag _centroidOnce;
+    mutable std::once_flag _shapeOnce;
+    mutable double _xc = 0, _yc = 0;
+    mutable double _ixx = 0, _iyy = 0, _ixy = 0;
 };
 }  // namespace geom
 }  // namespace afw
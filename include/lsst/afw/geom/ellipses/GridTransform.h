@@ -31,7 +31,10 @@
  *  Note: do not include directly; use the main ellipse header file.
  */
 
+#include <utility>
+
 #include "Eigen/Eigenvalues"
+#include "ndarray.h"
 
 #include "lsst/afw/geom/ellipses/Ellipse.h"
 #include "lsst/geom/AffineTransform.h"
@@ -107,6 +110,52 @@ private:
     BaseCore::GridTransform _coreGt;
 };
 
+/**
+ *  @brief A precomputed grid transform that can be applied repeatedly and to
+ *         coordinate arrays.
+ *
+ *  BaseCore::GridTransform and Ellipse::GridTransform are temporary-only
+ *  expression objects: every conversion to a transform repeats the
+ *  eigendecomposition of the quadrupole matrix.  CompiledGridTransform does
+ *  that work once at construction, so callers that evaluate the same core's
+ *  grid transform many times (e.g. per pixel in galaxy-model fitting) can
+ *  hoist it out of their inner loops.
+ */
+class CompiledGridTransform final {
+public:
+    /// Construct from an ellipse core; the transform has no translation.
+    explicit CompiledGridTransform(BaseCore const& core);
+
+    /// Construct from an ellipse; includes the translation of the center to the origin.
+    explicit CompiledGridTransform(Ellipse const& ellipse);
+
+    /// Return the transform as an lsst::geom::AffineTransform.
+    lsst::geom::AffineTransform const& getTransform() const noexcept { return _transform; }
+
+    /// Return the determinant of the linear part of the transform.
+    double getDeterminant() const noexcept { return _determinant; }
+
+    /// Apply the transform to a single point.
+    lsst::geom::Point2D operator()(lsst::geom::Point2D const& point) const { return _transform(point); }
+
+    /**
+     *  Apply the transform to coordinate arrays.
+     *
+     *  @param[in] x  x coordinates of the points to transform
+     *  @param[in] y  y coordinates of the points to transform; must have the same length as `x`
+     *  @returns a pair of newly allocated arrays of the transformed x and y coordinates
+     *
+     *  @throws lsst::pex::exceptions::LengthError Thrown if `x` and `y` have
+     *          different lengths.
+     */
+    std::pair<ndarray::Array<double, 1, 1>, ndarray::Array<double, 1, 1>> operator()(
+            ndarray::Array<double const, 1> const& x, ndarray::Array<double const, 1> const& y) const;
+
+private:
+    lsst::geom::AffineTransform _transform;
+    double _determinant;
+};
+
 inline BaseCore::GridTransform const BaseCore::getGridTransform() const {
     return BaseCore::GridTransform(*this);
 }
@@ -24,6 +24,7 @@
 #ifndef LSST_AFW_GEOM_ELLIPSES_PixelRegion_h_INCLUDED
 #define LSST_AFW_GEOM_ELLIPSES_PixelRegion_h_INCLUDED
 
+#include <memory>
 #include <vector>
 
 #include "lsst/geom/Box.h"
@@ -33,6 +34,9 @@
 namespace lsst {
 namespace afw {
 namespace geom {
+
+class SpanSet;
+
 namespace ellipses {
 
 /**
@@ -79,6 +83,20 @@ public:
      */
     lsst::geom::Box2I const& getBBox() const { return _bbox; }
 
+    //@{
+    /**
+     *  Return a SpanSet containing the same spans as this region.
+     *
+     *  The spans are already sorted and disjoint, so this skips SpanSet's
+     *  normalization step; the rvalue overload additionally hands the span
+     *  vector to the SpanSet without copying it, so
+     *  `PixelRegion(ellipse).getSpans()` allocates no per-span storage
+     *  beyond the SpanSet itself.
+     */
+    std::shared_ptr<SpanSet> getSpans() const&;
+    std::shared_ptr<SpanSet> getSpans() &&;
+    //@}
+
     /**
      * Return the span at the given y coordinate value.
      *
@@ -30,6 +30,8 @@
 
 #include <memory>
 
+#include "ndarray.h"
+
 #include "lsst/base.h"
 #include "lsst/pex/exceptions.h"
 #include "lsst/geom/Box.h"
@@ -143,6 +145,24 @@ public:
     /// Returns whether the polygon contains the point
     bool contains(Point const& point) const;
 
+    /**
+     * Returns whether the polygon contains each of a set of points
+     *
+     * The polygon edge table is built once and shared by all the points, which
+     * is much faster than calling `contains(Point)` in a loop.  Points exactly
+     * on the boundary may be classified either way.
+     *
+     * @param[in] x  x coordinates of the points to test
+     * @param[in] y  y coordinates of the points to test; must have the same length as `x`
+     * @returns an array of the same length, true where (x[i], y[i]) is inside the polygon
+     *
+     * @throws lsst::pex::exceptions::LengthError Thrown if `x` and `y` have
+     *         different lengths.
+     */
+    template <typename T>
+    ndarray::Array<bool, 1, 1> contains(ndarray::Array<T const, 1> const& x,
+                                        ndarray::Array<T const, 1> const& y) const;
+
     //@{
     /// Returns whether the polygons overlap each other
     ///
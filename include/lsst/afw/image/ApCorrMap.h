@@ -81,6 +81,24 @@ public:
     ApCorrMap& operator*=(double const scale);
     ApCorrMap& operator/=(double const scale) { return *this *= 1.0 / scale; }
 
+    /**
+     *  Evaluate every field in the map at the same vector of positions.
+     *
+     *  @param[in]  x  array of x coordinates, same shape as y
+     *  @param[in]  y  array of y coordinates, same shape as x
+     *
+     *  @returns a matrix of corrections with one row per position and one column per field,
+     *           with columns in iteration order (i.e. sorted by field name, matching
+     *           begin()...end()).
+     *
+     *  Fields that share a single BoundedField (e.g. a flux and its error, or aliased
+     *  measurements) are evaluated only once, using the batched BoundedField::evaluate
+     *  overload, so applying the whole map to a catalog costs one pass per distinct
+     *  surface rather than one evaluation per source per field.
+     */
+    ndarray::Array<double, 2, 2> evaluateAll(ndarray::Array<double const, 1> const& x,
+                                             ndarray::Array<double const, 1> const& y) const;
+
     /// Create a new ApCorrMap that is a copy of this one.
     std::shared_ptr<typehandling::Storable> cloneStorable() const override;
 
@@ -25,6 +25,7 @@
 #ifndef LSST_AFW_IMAGE_EXPOSURE_H
 #define LSST_AFW_IMAGE_EXPOSURE_H
 
+#include <future>
 #include <memory>
 
 #include "lsst/base.h"
@@ -406,6 +407,39 @@ public:
                    fits::ImageWriteOptions const& maskOptions,
                    fits::ImageWriteOptions const& varianceOptions) const;
 
+    /**
+     *  Write an Exposure to a regular multi-extension FITS file on a background thread.
+     *
+     *  @param[in] fileName      Name of the file to write.
+     *
+     *  @returns a future that becomes ready when the file has been written and closed;
+     *           any exception raised during serialization or I/O is rethrown from
+     *           its `get()`.
+     *
+     *  The exposure's planes and components are snapshotted when this method is
+     *  called: subsequently replacing planes or components on this object does not
+     *  affect the write, but the pixels themselves are shared rather than
+     *  deep-copied, so they must not be modified until the future is ready.
+     *
+     *  @see writeFits
+     */
+    std::future<void> writeFitsAsync(std::string const& fileName) const;
+
+    /**
+     *  Write an Exposure to a regular multi-extension FITS file on a background thread.
+     *
+     *  @param[in] fileName        Name of the file to write.
+     *  @param[in] imageOptions    Options controlling writing of image as FITS.
+     *  @param[in] maskOptions     Options controlling writing of mask as FITS.
+     *  @param[in] varianceOptions Options controlling writing of variance as FITS.
+     *
+     *  @see writeFitsAsync
+     */
+    std::future<void> writeFitsAsync(std::string const& fileName,
+                                     fits::ImageWriteOptions const& imageOptions,
+                                     fits::ImageWriteOptions const& maskOptions,
+                                     fits::ImageWriteOptions const& varianceOptions) const;
+
     /**
      *  Read an Exposure from a regular FITS file.
      *
@@ -424,6 +458,41 @@ public:
         return Exposure<ImageT, MaskT, VarianceT>(manager);
     }
 
+    /**
+     *  Write the Exposure to a binary snapshot file for checkpoint/restore.
+     *
+     *  A snapshot is not a FITS file: the three pixel planes are stored as
+     *  raw native-endian arrays at page-aligned offsets, followed by the
+     *  ExposureInfo serialized with the usual archive machinery, so writing
+     *  skips the per-plane header and conversion work of writeFits.
+     *  Snapshots are intended for intra-pipeline checkpointing on a single
+     *  architecture; they make no attempt at portability, so use writeFits
+     *  for anything that needs to be interchanged or archived.
+     *
+     *  @param[in] fileName      Name of the file to write.
+     *
+     *  @throws lsst::pex::exceptions::IoError Thrown if the file cannot be written.
+     *
+     *  @see readSnapshot
+     */
+    void writeSnapshot(std::string const& fileName) const;
+
+    /**
+     *  Read an Exposure written by writeSnapshot.
+     *
+     *  The pixel planes are memory-mapped copy-on-write rather than read
+     *  into freshly-allocated memory, so restoring is cheap and modifying
+     *  the returned Exposure never touches the snapshot file.
+     *
+     *  @param[in] fileName    Name of the file to read.
+     *
+     *  @throws lsst::pex::exceptions::IoError Thrown if the file cannot be
+     *          read or is not an Exposure snapshot.
+     *  @throws lsst::pex::exceptions::InvalidParameterError Thrown if the
+     *          snapshot was written with different pixel types.
+     */
+    static Exposure readSnapshot(std::string const& fileName);
+
     /**
      * Return an Exposure that is a small cutout of the original.
      *
@@ -153,8 +153,17 @@ public:
     /// Read the Exposure's non-standard components
     std::map<std::string, std::shared_ptr<table::io::Persistable>> readExtraComponents();
 
-    /// Read the ExposureInfo containing all non-image components.
-    std::shared_ptr<ExposureInfo> readExposureInfo();
+    /**
+     * Read the ExposureInfo containing all non-image components.
+     *
+     * @param  lazy  If True, defer deserializing archive-backed components
+     *               (PSF, WCS, ApCorrMap, TransmissionCurve, ...) until they
+     *               are first accessed on the returned ExposureInfo.  The
+     *               archive tables are read into memory before this method
+     *               returns, so the returned object does not depend on the
+     *               FITS file (or this reader) staying alive.
+     */
+    std::shared_ptr<ExposureInfo> readExposureInfo(bool lazy = false);
 
     ///@{
     /**
@@ -248,6 +257,8 @@ public:
      *                       this file.
      * @param  allowUnsafe   Permit reading into the requested pixel type even
      *                       when on-disk values may overflow or truncate.
+     * @param  lazyVariance  If True, defer reading the variance plane until
+     *                       first access; see MaskedImageFitsReader::read.
      *
      * In Python, this templated method is wrapped with an additional `dtype`
      * argument to provide the type to read (for the image plane).  This
@@ -256,7 +267,7 @@ public:
     template <typename ImagePixelT, typename MaskPixelT = MaskPixel, typename VariancePixelT = VariancePixel>
     MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> readMaskedImage(
             lsst::geom::Box2I const &bbox = lsst::geom::Box2I(), ImageOrigin origin = PARENT,
-            bool conformMasks = false, bool allowUnsafe = false);
+            bool conformMasks = false, bool allowUnsafe = false, bool lazyVariance = false);
 
     /**
      * Read the full Exposure.
@@ -268,6 +279,11 @@ public:
      *                       this file.
      * @param  allowUnsafe   Permit reading into the requested pixel type even
      *                       when on-disk values may overflow or truncate.
+     * @param  lazyComponents  If True, defer deserializing archive-backed
+     *                       ExposureInfo components until first access; see
+     *                       readExposureInfo.
+     * @param  lazyVariance  If True, defer reading the variance plane until
+     *                       first access; see MaskedImageFitsReader::read.
      *
      * In Python, this templated method is wrapped with an additional `dtype`
      * argument to provide the type to read (for the image plane).  This
@@ -276,7 +292,8 @@ public:
     template <typename ImagePixelT, typename MaskPixelT = MaskPixel, typename VariancePixelT = VariancePixel>
     Exposure<ImagePixelT, MaskPixelT, VariancePixelT> read(
             lsst::geom::Box2I const &bbox = lsst::geom::Box2I(), ImageOrigin origin = PARENT,
-            bool conformMasks = false, bool allowUnsafe = false);
+            bool conformMasks = false, bool allowUnsafe = false, bool lazyComponents = false,
+            bool lazyVariance = false);
 
     /**
      * Return the name of the file this reader targets.
@@ -286,14 +303,16 @@ public:
 private:
     class MetadataReader;
     class ArchiveReader;
+    class LazyComponentLoader;
 
     void _ensureReaders();
 
     fits::Fits *_getFitsFile() { return _maskedImageReader._getFitsFile(); }
 
     MaskedImageFitsReader _maskedImageReader;
-    std::unique_ptr<MetadataReader> _metadataReader;
-    std::unique_ptr<ArchiveReader> _archiveReader;
+    // shared rather than unique so a LazyComponentLoader can outlive the reader
+    std::shared_ptr<MetadataReader> _metadataReader;
+    std::shared_ptr<ArchiveReader> _archiveReader;
 };
 
 }  // namespace image
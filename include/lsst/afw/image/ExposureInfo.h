@@ -25,6 +25,11 @@
 #ifndef LSST_AFW_IMAGE_ExposureInfo_h_INCLUDED
 #define LSST_AFW_IMAGE_ExposureInfo_h_INCLUDED
 
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
 #include "lsst/base.h"
 #include "lsst/daf/base.h"
 #include "lsst/geom/Point.h"
@@ -106,6 +111,40 @@ public:
     /// Standard key for looking up filter information.
     static typehandling::Key<std::string, std::shared_ptr<FilterLabel const>> const KEY_FILTER;
 
+    /**
+     * Interface for providing components on first access.
+     *
+     * A loader attached with setComponentLoader makes components available
+     * without materializing them: `hasComponent` (and hence `hasPsf` etc.)
+     * reports them as present, and the component is loaded and cached the
+     * first time it is retrieved.  ExposureFitsReader uses this to defer
+     * archive deserialization for components the caller never touches.
+     */
+    class ComponentLoader {
+    public:
+        virtual ~ComponentLoader() noexcept = default;
+
+        /// Return the names of the components this loader can provide.
+        virtual std::vector<std::string> getComponentNames() const = 0;
+
+        /**
+         * Load the named component.
+         *
+         * Called at most once per name per ExposureInfo; may return null if
+         * the component turns out not to be readable after all.
+         */
+        virtual std::shared_ptr<typehandling::Storable> loadComponent(std::string const& name) = 0;
+    };
+
+    /**
+     * Attach a loader that provides components on first access.
+     *
+     * Components already present in this object take precedence over the
+     * loader, as do components set afterwards.  Pass null to detach (pending
+     * components that were never accessed are forgotten).
+     */
+    void setComponentLoader(std::shared_ptr<ComponentLoader> loader);
+
     /// Does this exposure have a Wcs?
     bool hasWcs() const;
 
@@ -272,7 +311,7 @@ public:
      */
     template <class T>
     bool hasComponent(typehandling::Key<std::string, T> const& key) const {
-        return _components->contains(key);
+        return _components->contains(key) || _unloadedComponents.count(key.getId()) > 0;
     }
 
     /**
@@ -289,7 +328,7 @@ public:
         try {
             return _components->at(key);
         } catch (pex::exceptions::OutOfRangeError const& e) {
-            return nullptr;
+            return _loadComponent(key);
         }
     }
 
@@ -304,7 +343,12 @@ public:
      */
     template <class T>
     bool removeComponent(typehandling::Key<std::string, T> const& key) {
-        return _components->erase(key);
+        bool const wasPending = _unloadedComponents.erase(key.getId()) > 0;
+        if (!_components->contains(key)) {
+            return wasPending;
+        }
+        _ensureUnique();
+        return _components->erase(key) || wasPending;
     }
 
     /// Get the version of FITS serialization that this ExposureInfo understands.
@@ -432,6 +476,8 @@ private:
     template <class T>
     void _setComponent(typehandling::Key<std::string, std::shared_ptr<T>> const& key,
                        std::shared_ptr<T> const& object) {
+        _unloadedComponents.erase(key.getId());  // an explicit value overrides a pending lazy one
+        _ensureUnique();
         if (_components->contains(key)) {
             _components->erase(key);
         } else if (_components->contains(key.getId())) {
@@ -452,11 +498,52 @@ private:
         }
     }
 
+    /*
+     * Load a component from _componentLoader on first access, caching it in
+     * _components; returns null if no loader is attached or it cannot provide
+     * the component.  Const because it is called from the const accessors;
+     * caching is not observable through the public interface.
+     */
+    template <class T>
+    std::shared_ptr<T> _loadComponent(typehandling::Key<std::string, std::shared_ptr<T>> const& key) const {
+        if (_unloadedComponents.erase(key.getId()) == 0) {
+            return nullptr;
+        }
+        std::shared_ptr<T> object = std::dynamic_pointer_cast<T>(_componentLoader->loadComponent(key.getId()));
+        if (object != nullptr) {
+            _ensureUnique();
+            _components->insert(key, object);
+        }
+        return object;
+    }
+
+    /*
+     * Detach _components from any ExposureInfo it is shared with, so it can be
+     * mutated safely.  Copies share the map itself and only clone it here, on
+     * first mutation; const because the lazy-loading cache writes to the map
+     * from the const accessors.
+     */
+    void _ensureUnique() const {
+        if (_components.use_count() > 1) {
+            _components = std::make_shared<detail::StorableMap>(*_components);
+        }
+    }
+
+    // Load every component the loader can still provide (e.g. before persisting).
+    void _loadAllComponents() const;
+
     std::shared_ptr<daf::base::PropertySet> _metadata;
     std::shared_ptr<image::VisitInfo const> _visitInfo;
 
-    // Class invariant: all pointers in _components are not null
-    std::unique_ptr<detail::StorableMap> _components;
+    // Class invariant: all pointers in _components are not null.
+    // Shared copy-on-write between copies of an ExposureInfo; mutable so that
+    // _ensureUnique can detach it from the const accessors.
+    mutable std::shared_ptr<detail::StorableMap> _components;
+
+    std::shared_ptr<ComponentLoader> _componentLoader;
+    // Names _componentLoader can still provide; mutable so that the const
+    // accessors can load (and cache) components on first access.
+    mutable std::set<std::string> _unloadedComponents;
 };
 }  // namespace image
 }  // namespace afw
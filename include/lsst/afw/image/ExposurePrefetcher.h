@@ -0,0 +1,144 @@
+/*
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_AFW_IMAGE_EXPOSUREPREFETCHER_H
+#define LSST_AFW_IMAGE_EXPOSUREPREFETCHER_H
+
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "lsst/afw/image/Exposure.h"
+
+namespace lsst {
+namespace afw {
+namespace image {
+
+/**
+ * Background read-ahead for an ordered sequence of Exposure FITS files.
+ *
+ * Jobs that alternate between loading one Exposure and processing the
+ * previous one leave the disk idle while computing and the CPU idle while
+ * reading.  An ExposurePrefetcher is given the full list of file paths up
+ * front and reads (and decompresses) ahead on its own threads while the
+ * caller processes, so the next file is typically ready the moment next()
+ * is called:
+ *
+ *     ExposurePrefetcher<float> prefetcher(fileNames);
+ *     while (prefetcher.hasNext()) {
+ *         auto exposure = prefetcher.next();  // usually already in memory
+ *         process(exposure);
+ *     }
+ *
+ * Exposures are delivered strictly in the order the paths were given, and
+ * at most `readAhead` files are held beyond the caller's position, bounding
+ * memory no matter how far the reader outpaces the consumer.  A failure to
+ * read a file is reported by next() for that file, in sequence, without
+ * disturbing the files around it.
+ *
+ * The reader threads belong to the prefetcher (they block on I/O, so they
+ * are kept off the shared compute pool) and never touch Python, so next()
+ * may be called with the GIL released.
+ */
+template <typename ImagePixelT, typename MaskPixelT = MaskPixel, typename VariancePixelT = VariancePixel>
+class ExposurePrefetcher final {
+public:
+    using ExposureT = Exposure<ImagePixelT, MaskPixelT, VariancePixelT>;
+
+    /**
+     * Construct a prefetcher and start reading.
+     *
+     * @param fileNames  paths of the Exposure FITS files, in the order next()
+     *                   is to deliver them
+     * @param readAhead  maximum number of files held in memory (ready or
+     *                   being read) beyond the caller's position; must be
+     *                   at least 1
+     * @param numThreads number of reader threads; one overlaps I/O with
+     *                   compute, more may help when decompression dominates.
+     *                   Must be at least 1.
+     * @param allowUnsafe  permit reading into the requested pixel type even
+     *                   when on-disk values may overflow or truncate
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if readAhead or
+     *         numThreads is less than 1.
+     */
+    explicit ExposurePrefetcher(std::vector<std::string> fileNames, std::size_t readAhead = 2,
+                                int numThreads = 1, bool allowUnsafe = false);
+
+    ExposurePrefetcher(ExposurePrefetcher const &) = delete;
+    ExposurePrefetcher(ExposurePrefetcher &&) = delete;
+    ExposurePrefetcher &operator=(ExposurePrefetcher const &) = delete;
+    ExposurePrefetcher &operator=(ExposurePrefetcher &&) = delete;
+
+    /// Stop reading ahead and join the reader threads; a read already in
+    /// flight is allowed to finish (and is discarded).
+    ~ExposurePrefetcher() noexcept;
+
+    /// Return the total number of files in the sequence.
+    std::size_t size() const noexcept { return _fileNames.size(); }
+
+    /// Return true if next() has not yet delivered the whole sequence.
+    bool hasNext() const;
+
+    /**
+     * Return the next Exposure in the sequence, blocking until it is ready.
+     *
+     * @throws lsst::pex::exceptions::OutOfRangeError if the sequence is
+     *         exhausted.
+     * @throws any exception raised reading the file, e.g.
+     *         lsst::afw::fits::FitsError; the prefetcher remains usable and
+     *         subsequent files are still delivered.
+     */
+    ExposureT next();
+
+private:
+    struct Slot {
+        std::unique_ptr<ExposureT> exposure;
+        std::exception_ptr error;
+        bool ready = false;
+    };
+
+    void _workerMain();
+
+    std::vector<std::string> const _fileNames;
+    std::size_t const _readAhead;
+    bool const _allowUnsafe;
+
+    mutable std::mutex _mutex;
+    std::condition_variable _stateChanged;
+    std::vector<Slot> _slots;
+    std::size_t _nextToRead;     ///< first index not yet claimed by a reader thread
+    std::size_t _nextToDeliver;  ///< first index not yet returned by next()
+    bool _stop;
+
+    std::vector<std::thread> _threads;
+};
+
+}  // namespace image
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !LSST_AFW_IMAGE_EXPOSUREPREFETCHER_H
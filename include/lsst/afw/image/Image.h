@@ -192,6 +192,29 @@ public:
                    lsst::geom::Point2I const& xy0 = lsst::geom::Point2I())
             : image::ImageBase<PixelT>(array, deep, xy0) {}
 
+    /**
+     * Wrap an externally allocated pixel buffer in an Image without copying.
+     *
+     * Intended for adopting buffers whose lifetime afw does not manage (e.g. DMA or
+     * shared-memory acquisition buffers): the Image, and every shallow copy or
+     * subimage of it, keeps the buffer alive, and `deleter` is invoked once the last
+     * such view is destroyed.
+     *
+     * @param data pointer to the first pixel of row 0
+     * @param dimensions width and height of the image
+     * @param rowStride distance between the starts of consecutive rows, in pixels;
+     *     must be at least the width
+     * @param deleter called with `data` when the last Image referencing the buffer
+     *     goes away; pass a no-op lambda to adopt storage owned elsewhere
+     * @param xy0 origin of the new Image
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if data is null, either
+     *     dimension is negative, or rowStride is smaller than the width
+     */
+    static Image adoptBuffer(PixelT* data, lsst::geom::Extent2I const& dimensions, int rowStride,
+                             std::function<void(PixelT*)> deleter,
+                             lsst::geom::Point2I const& xy0 = lsst::geom::Point2I());
+
     ~Image() override = default;
     //
     // Assignment operators are not inherited
@@ -449,6 +472,36 @@ public:
                             lsst::geom::Box2I const& bbox = lsst::geom::Box2I(),
                             ImageOrigin const origin = PARENT, bool allowUnsafe = false);
 
+    /**
+     * Read a DecoratedImage from a FITS file, overlapping the header parse with the pixel read
+     *
+     * Equivalent to the FITS file constructor, but the header is parsed on a separate thread
+     * with its own cfitsio handle while the data unit streams, so neither pass waits on the
+     * other.  The thread blocks on I/O and is therefore kept off the shared compute pool.
+     *
+     * @param fileName File to read
+     * @param hdu The HDU to read
+     * @param bbox Only read these pixels
+     * @param origin Coordinate system of the bbox
+     * @param allowUnsafe Permit reading into the requested pixel type even
+     *                    when on-disk values may overflow or truncate.
+     */
+    static DecoratedImage readFitsOverlapped(std::string const& fileName, const int hdu = fits::DEFAULT_HDU,
+                                             lsst::geom::Box2I const& bbox = lsst::geom::Box2I(),
+                                             ImageOrigin const origin = PARENT, bool allowUnsafe = false);
+
+    /**
+     * Read only the metadata of a DecoratedImage FITS file, without touching the data unit
+     *
+     * Returns the same (stripped) header the FITS file constructor would attach, so
+     * header-scraping tools need not pay for a full image read.
+     *
+     * @param fileName File to read
+     * @param hdu The HDU to read
+     */
+    static std::shared_ptr<lsst::daf::base::PropertySet> readMetadata(std::string const& fileName,
+                                                                      const int hdu = fits::DEFAULT_HDU);
+
     /**
      * Assignment operator
      *
@@ -537,6 +590,25 @@ lsst::geom::Box2I bboxFromMetadata(daf::base::PropertySet& metadata);
 template <typename T1, typename T2>
 bool imagesOverlap(ImageBase<T1> const& image1, ImageBase<T2> const& image2);
 
+/**
+ * Extract deep-copied cutouts for a batch of boxes in one pass over the parent.
+ *
+ * The cutouts are filled sorted by their row range so the parent's pixels are
+ * read in (nearly) sequential order, rather than in the callers' random order;
+ * the results are returned in the callers' order.  All cutouts are backed by a
+ * single pooled allocation, which stays alive as long as any of them does.
+ *
+ * @param  parent  Image to extract from.
+ * @param  boxes   Bounding boxes of the cutouts, in PARENT coordinates.
+ * @return         One deep-copied cutout per box, in the order given.
+ *
+ * @throws lsst::pex::exceptions::LengthError if a box is empty or does not fit
+ *         in the parent.
+ */
+template <typename PixelT>
+std::vector<std::shared_ptr<Image<PixelT>>> extractCutouts(Image<PixelT> const& parent,
+                                                           std::vector<lsst::geom::Box2I> const& boxes);
+
 }  // namespace image
 }  // namespace afw
 }  // namespace lsst
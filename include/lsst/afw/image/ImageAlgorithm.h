@@ -213,6 +213,116 @@ void for_each_pixel(Image<LhsT>& lhs,                   ///< Image to set
         }
     }
 }
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+class MaskedImage;
+
+/**
+ * Set each pixel in an Image<LhsT> to func(lhs), with func inlined into the traversal
+ *
+ * Unlike for_each_pixel, the functor is an arbitrary callable taken as a template parameter
+ * rather than a virtual pixelOp, so the compiler can inline it into the loop and vectorize
+ * the result. Use it to fuse chains of whole-image operators into one pass, e.g.
+ *
+ *     transformEachPixel(img, [gain, sky](float pix) { return (pix - sky) * gain; });
+ *
+ * walks the buffer once where `img -= sky; img *= gain` walks it twice.
+ */
+template <typename LhsT, typename FuncT>
+void transformEachPixel(Image<LhsT>& lhs,  ///< Image to set
+                        FuncT const& func  ///< callable mapping pixel value to pixel value
+) {
+    for (int y = 0; y != lhs.getHeight(); ++y) {
+        for (typename Image<LhsT>::x_iterator lhsPtr = lhs.row_begin(y), lhsEnd = lhs.row_end(y);
+             lhsPtr != lhsEnd; ++lhsPtr) {
+            *lhsPtr = func(*lhsPtr);
+        }
+    }
+}
+
+/**
+ * Set each pixel in an Image<LhsT> to func(lhs, rhs), with func inlined into the traversal
+ *
+ * The fused analog of the pixelOp2 for_each_pixel; see the one-image transformEachPixel
+ * for the rationale.
+ */
+template <typename LhsT, typename RhsT, typename FuncT>
+void transformEachPixel(Image<LhsT>& lhs,        ///< Image to set
+                        Image<RhsT> const& rhs,  ///< other Image to pass to `func`
+                        FuncT const& func        ///< callable mapping (lhs, rhs) to pixel value
+) {
+    if (lhs.getDimensions() != rhs.getDimensions()) {
+        throw LSST_EXCEPT(lsst::pex::exceptions::LengthError,
+                          (boost::format("Images are of different size, %dx%d v %dx%d") % lhs.getWidth() %
+                           lhs.getHeight() % rhs.getWidth() % rhs.getHeight())
+                                  .str());
+    }
+
+    for (int y = 0; y != lhs.getHeight(); ++y) {
+        typename Image<RhsT>::const_x_iterator rhsPtr = rhs.row_begin(y);
+
+        for (typename Image<LhsT>::x_iterator lhsPtr = lhs.row_begin(y), lhsEnd = lhs.row_end(y);
+             lhsPtr != lhsEnd; ++rhsPtr, ++lhsPtr) {
+            *lhsPtr = func(*lhsPtr, *rhsPtr);
+        }
+    }
+}
+
+/**
+ * Set each pixel in a MaskedImage to func(lhs), with func inlined into the traversal
+ *
+ * The functor receives and returns a full (image, mask, variance) pixel; arithmetic on it
+ * uses the single-pixel expression templates of afw::image::pixel, which propagate mask
+ * bits and variance exactly as MaskedImage's whole-image operators do. For example
+ *
+ *     transformEachPixel(mimg, [gain, sky](auto pix) { return (pix - sky) * gain; });
+ *
+ * fuses the subtraction and the gain scaling (including their variance updates) into a
+ * single pass.
+ */
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT, typename FuncT>
+void transformEachPixel(MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& lhs,  ///< MaskedImage to set
+                        FuncT const& func  ///< callable mapping pixel to pixel
+) {
+    typedef MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> LhsT;
+    for (int y = 0; y != lhs.getHeight(); ++y) {
+        for (typename LhsT::x_iterator lhsPtr = lhs.row_begin(y), lhsEnd = lhs.row_end(y);
+             lhsPtr != lhsEnd; ++lhsPtr) {
+            *lhsPtr = func(*lhsPtr);
+        }
+    }
+}
+
+/**
+ * Set each pixel in a MaskedImage to func(lhs, rhs), with func inlined into the traversal
+ *
+ * The two-image analog of the one-image MaskedImage transformEachPixel; both pixels carry
+ * (image, mask, variance), so e.g. `return lhs + rhs * scale;` ORs the masks and
+ * propagates the variances in the same pass.
+ */
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT, typename FuncT>
+void transformEachPixel(MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& lhs,  ///< MaskedImage to set
+                        MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const&
+                                rhs,       ///< other MaskedImage to pass to `func`
+                        FuncT const& func  ///< callable mapping (lhs, rhs) to pixel
+) {
+    typedef MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> LhsT;
+    if (lhs.getDimensions() != rhs.getDimensions()) {
+        throw LSST_EXCEPT(lsst::pex::exceptions::LengthError,
+                          (boost::format("Images are of different size, %dx%d v %dx%d") % lhs.getWidth() %
+                           lhs.getHeight() % rhs.getWidth() % rhs.getHeight())
+                                  .str());
+    }
+
+    for (int y = 0; y != lhs.getHeight(); ++y) {
+        typename LhsT::const_x_iterator rhsPtr = rhs.row_begin(y);
+
+        for (typename LhsT::x_iterator lhsPtr = lhs.row_begin(y), lhsEnd = lhs.row_end(y);
+             lhsPtr != lhsEnd; ++rhsPtr, ++lhsPtr) {
+            *lhsPtr = func(*lhsPtr, *rhsPtr);
+        }
+    }
+}
 }  // namespace image
 }  // namespace afw
 }  // namespace lsst
@@ -0,0 +1,206 @@
+/*
+ * LSST Data Management System
+ * Copyright 2008-2020 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#ifndef LSST_AFW_IMAGE_IMAGEALLOCATOR_H
+#define LSST_AFW_IMAGE_IMAGEALLOCATOR_H
+
+/*
+ * Pluggable allocation of pixel storage for ImageBase and its subclasses
+ */
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "ndarray.h"
+
+namespace lsst {
+namespace afw {
+namespace image {
+
+/**
+ * Interface for supplying pixel storage to Image, Mask and MaskedImage construction.
+ *
+ * By default pixel buffers come from the global heap; code that creates and frees many
+ * small images (e.g. per-source stamps) can install an allocator on the current thread
+ * with ScopedImageAllocator to provide the storage itself.
+ */
+class ImageAllocator {
+public:
+    ImageAllocator() = default;
+    ImageAllocator(ImageAllocator const&) = delete;
+    ImageAllocator(ImageAllocator&&) = delete;
+    ImageAllocator& operator=(ImageAllocator const&) = delete;
+    ImageAllocator& operator=(ImageAllocator&&) = delete;
+    virtual ~ImageAllocator() noexcept = default;
+
+    /**
+     * Allocate pixel storage.
+     *
+     * The storage must be suitably aligned for any pixel type and must remain valid for
+     * the lifetime of the returned manager, which the image holds for as long as it (or
+     * any shallow copy or subimage of it) references the buffer. The contents need not
+     * be initialized; image constructors that take an initial value fill the buffer.
+     *
+     * @param bytes number of bytes of storage required; may be 0
+     * @returns a (manager, storage) pair; the manager owns the storage
+     */
+    virtual std::pair<ndarray::Manager::Ptr, void*> allocate(std::size_t bytes) = 0;
+};
+
+/**
+ * RAII guard that installs an ImageAllocator for the current thread.
+ *
+ * All pixel storage allocated by image constructors on this thread comes from the
+ * installed allocator until the guard is destroyed, at which point the previously
+ * installed allocator (if any) is restored; guards therefore nest. The allocator is
+ * per-thread, so images may be constructed concurrently on other threads without
+ * synchronizing with it.
+ */
+class ScopedImageAllocator final {
+public:
+    /// Install `allocator` (which must not be null) on the current thread
+    explicit ScopedImageAllocator(std::shared_ptr<ImageAllocator> allocator);
+
+    ScopedImageAllocator(ScopedImageAllocator const&) = delete;
+    ScopedImageAllocator(ScopedImageAllocator&&) = delete;
+    ScopedImageAllocator& operator=(ScopedImageAllocator const&) = delete;
+    ScopedImageAllocator& operator=(ScopedImageAllocator&&) = delete;
+
+    /// Restore the allocator that was installed when this guard was constructed
+    ~ScopedImageAllocator() noexcept;
+
+private:
+    std::shared_ptr<ImageAllocator> _previous;
+};
+
+/// Return the allocator installed on the current thread, or null if pixel storage
+/// comes from the global heap
+std::shared_ptr<ImageAllocator> getCurrentImageAllocator();
+
+/**
+ * RAII guard that makes image rows allocated on the current thread start on an
+ * alignment boundary.
+ *
+ * While the guard is alive, pixel buffers allocated by image constructors on this
+ * thread have their row pitch (and base address) rounded up to `alignment` bytes, so
+ * vectorized code may use aligned loads on every row. The padding pixels are not part
+ * of the image: a padded image reports `isContiguous() == false`, exactly like a
+ * subimage, and all iterator, `getArray()` and FITS I/O paths already honor the row
+ * stride. The previous alignment (none by default) is restored when the guard is
+ * destroyed, so guards nest; like ScopedImageAllocator the setting is per-thread.
+ */
+class ScopedImageRowAlignment final {
+public:
+    /**
+     * Request `alignment`-byte aligned rows on the current thread
+     *
+     * @param alignment row alignment in bytes; must be a power of two
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if alignment is zero or
+     *     not a power of two
+     */
+    explicit ScopedImageRowAlignment(std::size_t alignment);
+
+    ScopedImageRowAlignment(ScopedImageRowAlignment const&) = delete;
+    ScopedImageRowAlignment(ScopedImageRowAlignment&&) = delete;
+    ScopedImageRowAlignment& operator=(ScopedImageRowAlignment const&) = delete;
+    ScopedImageRowAlignment& operator=(ScopedImageRowAlignment&&) = delete;
+
+    /// Restore the row alignment that was in effect when this guard was constructed
+    ~ScopedImageRowAlignment() noexcept;
+
+private:
+    std::size_t _previous;
+};
+
+/// Return the row alignment (in bytes) in effect on the current thread, or 0 if rows
+/// are packed with no padding
+std::size_t getCurrentImageRowAlignment();
+
+/**
+ * Set the size in bytes at or above which pixel buffers are allocated as a dedicated
+ * anonymous mapping rather than from the global heap.
+ *
+ * A large plane gets its own mapping with (on Linux) a transparent-hugepage hint,
+ * which cuts TLB misses in full-frame kernels.  The fresh pages are not touched at
+ * allocation time, so under the kernel's first-touch policy each page lands on the
+ * NUMA node of the thread that first writes it: planes filled in row bands by worker
+ * threads end up distributed across the nodes that process them, instead of all on
+ * the constructing thread's node.
+ *
+ * The threshold is process-wide; pass 0 to disable the dedicated-mapping path
+ * entirely.  The default is 4 MiB.  An allocator installed with
+ * ScopedImageAllocator always takes precedence over this path.
+ */
+void setLargeImageAllocationThreshold(std::size_t bytes);
+
+/// Return the size in bytes at or above which pixel buffers get a dedicated mapping,
+/// or 0 if that path is disabled
+std::size_t getLargeImageAllocationThreshold();
+
+namespace detail {
+
+/**
+ * @internal Allocate pixel storage for a large image as a dedicated anonymous mapping.
+ *
+ * Returns (null, nullptr) when `bytes` is below the threshold, the path is disabled
+ * with setLargeImageAllocationThreshold(0), or the platform does not support it; the
+ * caller is then expected to fall back to the heap.  On success the returned pages
+ * read as zero until written and have not been faulted in.
+ */
+std::pair<ndarray::Manager::Ptr, void*> allocateLargeImageStorage(std::size_t bytes);
+
+}  // namespace detail
+
+/**
+ * An ImageAllocator that carves pixel buffers out of large blocks by pointer bumping.
+ *
+ * Intended for stamp churn: allocation is a bump of an offset into the current block,
+ * with a new block allocated from the heap only when the current one is exhausted.
+ * Nothing is recycled while the arena lives; each buffer's manager keeps its block
+ * alive, so a block is returned to the heap once the arena has moved past it and every
+ * image allocated from it has been destroyed.
+ */
+class ArenaImageAllocator final : public ImageAllocator {
+public:
+    /**
+     * Construct an arena.
+     *
+     * @param blockBytes size of each block; requests larger than this get a dedicated
+     *     block of their own
+     */
+    explicit ArenaImageAllocator(std::size_t blockBytes = 1 << 20);
+
+    std::pair<ndarray::Manager::Ptr, void*> allocate(std::size_t bytes) override;
+
+private:
+    std::size_t _blockBytes;                    ///< size of each block
+    std::shared_ptr<std::vector<char>> _block;  ///< current block; null until first use
+    std::size_t _used;                          ///< bytes of the current block handed out
+};
+
+}  // namespace image
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // LSST_AFW_IMAGE_IMAGEALLOCATOR_H
@@ -150,11 +150,36 @@ private:
 
     friend class MaskedImageFitsReader;
 
+    // Type-erased holder for a decompressed, tile-aligned region kept from a
+    // previous subregion read of a tile-compressed HDU; the pixel type is
+    // recovered by readArray via dynamic_cast.
+    struct TileCacheBase {
+        virtual ~TileCacheBase() noexcept = default;
+    };
+
+    template <typename T>
+    struct TileCache : TileCacheBase {
+        lsst::geom::Box2I box;  // region held, in LOCAL (zero-origin) coordinates
+        ndarray::Array<T, 2, 2> array;
+    };
+
+    /**
+     * Read a subregion of a tile-compressed HDU, decompressing only the
+     * intersecting tiles and caching them for subsequent overlapping reads.
+     *
+     * Must be called with the FITS file already positioned at the reader's
+     * HDU and with `subBBox` a non-empty subset of `fullBBox` (both PARENT).
+     */
+    template <typename T>
+    ndarray::Array<T, 2, 2> _readTileCompressedSubregion(lsst::geom::Box2I const & subBBox,
+                                                         lsst::geom::Box2I const & fullBBox);
+
     bool _ownsFitsFile;
     int _hdu;
     fits::Fits * _fitsFile;
     lsst::geom::Box2I _bbox;
     std::shared_ptr<daf::base::PropertyList> _metadata;
+    std::unique_ptr<TileCacheBase> _tileCache;
 };
 
 }}} // namespace lsst::afw::image
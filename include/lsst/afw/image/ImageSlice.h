@@ -95,20 +95,28 @@ void operate(Image<PixelT> &img, ImageSlice<PixelT> const &slc,
              typename ImageSlice<PixelT>::ImageSliceType sliceType) {
     OperatorT op;
 
+    int const width = img.getWidth();
     if (sliceType == ImageSlice<PixelT>::ROW) {
+        // The same slice row is broadcast across every image row.  Both rows
+        // are contiguous, so a plain index loop lets the compiler vectorize
+        // the lane-wise op instead of stepping a pair of iterators.
+        typename ImageSlice<PixelT>::x_iterator const pSlc = slc.row_begin(0);
         for (int y = 0; y < img.getHeight(); ++y) {
-            typename ImageSlice<PixelT>::x_iterator pSlc = slc.row_begin(0);
-            for (typename Image<PixelT>::x_iterator pImg = img.row_begin(y), end = img.row_end(y);
-                 pImg != end; ++pImg, ++pSlc) {
-                *pImg = op(*pImg, *pSlc);
+            typename Image<PixelT>::x_iterator const pImg = img.row_begin(y);
+            for (int x = 0; x < width; ++x) {
+                pImg[x] = op(pImg[x], pSlc[x]);
             }
         }
     } else if (sliceType == ImageSlice<PixelT>::COLUMN) {
+        // Each image row sees a single slice value: hoist it into a local so
+        // the inner loop is a scalar splat the compiler can vectorize, rather
+        // than a re-read through the column iterator every pixel.
         typename ImageSlice<PixelT>::y_iterator pSlc = slc.col_begin(0);
         for (int y = 0; y < img.getHeight(); ++y, ++pSlc) {
-            for (typename Image<PixelT>::x_iterator pImg = img.row_begin(y), end = img.row_end(y);
-                 pImg != end; ++pImg) {
-                *pImg = op(*pImg, *pSlc);
+            PixelT const slcVal = *pSlc;
+            typename Image<PixelT>::x_iterator const pImg = img.row_begin(y);
+            for (int x = 0; x < width; ++x) {
+                pImg[x] = op(pImg[x], slcVal);
             }
         }
     }
@@ -29,6 +29,7 @@
 #ifndef LSST_AFW_IMAGE_MASK_H
 #define LSST_AFW_IMAGE_MASK_H
 
+#include <cstddef>
 #include <list>
 #include <map>
 #include <string>
@@ -294,6 +295,29 @@ public:
     /// XOR a bitmask into a Mask
     Mask& operator^=(MaskPixelT const rhs);
 
+    /**
+     * Count the number of set bits in the Mask, optionally restricted to a set of planes
+     *
+     * Each pixel contributes the population count of `pixel & planeMask`, so a pixel with
+     * two of the requested planes set is counted twice.  With a single-plane bitmask this
+     * is the number of pixels with that plane set.
+     *
+     * @param planeMask only count bits within this bitmask; defaults to all bits
+     */
+    std::size_t countMaskBits(MaskPixelT planeMask = ~MaskPixelT(0)) const;
+
+    /**
+     * Count the number of set bits in a sub-region of the Mask
+     *
+     * @param planeMask only count bits within this bitmask
+     * @param bbox region of the Mask to count over
+     * @param origin origin bbox is relative to; PARENT accounts for xy0, LOCAL does not
+     *
+     * @throws lsst::pex::exceptions::LengthError if bbox extends beyond the Mask
+     */
+    std::size_t countMaskBits(MaskPixelT planeMask, lsst::geom::Box2I const& bbox,
+                              ImageOrigin origin = PARENT) const;
+
     /**
      * get a reference to the specified pixel
      *
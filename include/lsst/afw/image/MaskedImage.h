@@ -29,6 +29,8 @@
 #ifndef LSST_IMAGE_MASKEDIMAGE_H
 #define LSST_IMAGE_MASKEDIMAGE_H
 
+#include <cstddef>
+#include <functional>
 #include <list>
 #include <map>
 #include <memory>
@@ -614,6 +616,19 @@ public:
      * @param variance Variance %Mask
      */
     explicit MaskedImage(ImagePtr image, MaskPtr mask = MaskPtr(), VariancePtr variance = VariancePtr());
+    /**
+     * Construct from a supplied Image and Mask, deferring the variance to a generator.
+     *
+     * No variance storage is allocated; the generator runs on first access to the
+     * plane.  See setVarianceGenerator for the full contract.
+     *
+     * @param image %Image
+     * @param mask %Mask; set to zero if omitted
+     * @param varianceGenerator callable returning the variance plane; must not be null
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if varianceGenerator is null.
+     */
+    explicit MaskedImage(ImagePtr image, MaskPtr mask, std::function<VariancePtr()> varianceGenerator);
     /**
      * Create an MaskedImage of the specified size
      *
@@ -866,6 +881,7 @@ public:
     MaskedImage& operator*=(ImagePixelT const rhs);
     MaskedImage& operator*=(MaskedImage const& rhs);
     MaskedImage& operator*=(lsst::afw::image::Image<ImagePixelT> const& rhs) {
+        _materializeVariance();
         *_image *= rhs;
         *_variance *= rhs;  // yes, multiply twice
         *_variance *= rhs;
@@ -876,6 +892,7 @@ public:
     MaskedImage& operator/=(ImagePixelT const rhs);
     MaskedImage& operator/=(MaskedImage const& rhs);
     MaskedImage& operator/=(lsst::afw::image::Image<ImagePixelT> const& rhs) {
+        _materializeVariance();
         *_image /= rhs;
         *_variance /= rhs;  // yes, divide twice
         *_variance /= rhs;
@@ -883,6 +900,44 @@ public:
     }
     void scaledDivides(double const c, MaskedImage const& rhs);
 
+    /** Set the %image pixels whose mask intersects `planeMask` to a constant
+     *
+     * The common conditional edit (e.g. "set pixels to NaN where SAT|BAD") written once
+     * as a single fused pass over image+mask row pairs, with the selection expressed as
+     * a branch-free blend so the compiler can vectorize the mask-compare and select.
+     *
+     * @param planeMask bitwise OR of the mask planes that select pixels
+     * @param value     value to write into the selected %image pixels
+     * @returns the number of pixels set
+     */
+    std::size_t setWhere(MaskPixelT const planeMask, ImagePixelT const value);
+
+    /** Apply a functor to the %image pixels whose mask intersects `planeMask`
+     *
+     * Calls `op(pixel)` with a reference to each selected %image pixel, in one fused
+     * pass over image+mask row pairs; use setWhere() for the constant-value case, which
+     * is branch-free.
+     *
+     * @param planeMask bitwise OR of the mask planes that select pixels
+     * @param op        functor called as `op(ImagePixelT&)` for each selected pixel
+     * @returns the number of pixels visited
+     */
+    template <typename FunctorT>
+    std::size_t applyWhere(MaskPixelT const planeMask, FunctorT op) {
+        std::size_t n = 0;
+        for (int y = 0; y != getHeight(); ++y) {
+            typename Mask::x_iterator mskPtr = _mask->row_begin(y);
+            for (typename Image::x_iterator imgPtr = _image->row_begin(y), end = _image->row_end(y);
+                 imgPtr != end; ++imgPtr, ++mskPtr) {
+                if (*mskPtr & planeMask) {
+                    op(*imgPtr);
+                    ++n;
+                }
+            }
+        }
+        return n;
+    }
+
     /**
      *  Write a MaskedImage to a regular FITS file.
      *
@@ -1073,10 +1128,43 @@ public:
      *
      *  @throws pex::exceptions::LengthError if dimensions do not match.
      */
-    void setVariance(Variance const& other) { _variance->assign(other); }
+    void setVariance(Variance const& other) { getVariance()->assign(other); }
+
+    /// Return a (shared_ptr to) the MaskedImage's variance, materializing it first
+    /// if it is deferred to a generator (see setVarianceGenerator)
+    VariancePtr getVariance() const {
+        if (_deferredVariance) {
+            _materializeVariance();
+        }
+        return _variance;
+    }
+
+    /**
+     * Defer the variance plane to a generator.
+     *
+     * The current variance plane (if any) is dropped and no storage is held for it;
+     * the generator is invoked the first time any code touches the variance — via
+     * getVariance(), the MaskedImage iterators, arithmetic, writeFits and so on —
+     * and must return a plane with the same dimensions as the image.  Read-only
+     * consumers that never look at the variance (display cutouts, centroid-only
+     * passes) therefore never pay its memory or the I/O or compute behind the
+     * generator.
+     *
+     * Shallow copies share the deferred state: whichever of them materializes
+     * first, all of them see the same plane, just as they would share an eagerly
+     * allocated one.  A deep copy or a cross-type copy materializes the source.
+     * The generator may be called from any thread (it is serialized internally)
+     * and must not assume it holds locks the consumer holds.
+     *
+     * @param generator  callable returning the variance plane; must not be null
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if generator is null.
+     */
+    void setVarianceGenerator(std::function<VariancePtr()> generator);
 
-    /// Return a (shared_ptr to) the MaskedImage's variance
-    VariancePtr getVariance() const { return _variance; }
+    /// Return true if the variance plane is deferred to a generator that has not
+    /// yet run for this MaskedImage (see setVarianceGenerator)
+    bool isVarianceDeferred() const noexcept { return static_cast<bool>(_deferredVariance); }
 
     /// Return the number of columns in the %image
     int getWidth() const { return _image->getWidth(); }
@@ -1136,6 +1224,7 @@ public:
             _mask->setXY0(origin);
         }
 
+        _materializeVariance();
         if (_variance) {
             _variance->setXY0(origin);
         }
@@ -1206,6 +1295,7 @@ public:
 
     /// Return an `x_iterator` at the point `(x, y)`
     x_iterator x_at(int x, int y) const {
+        _materializeVariance();
 #if 0
         typename Image::x_iterator imageEnd = getImage()->x_at(x, y);
         typename Mask::x_iterator maskEnd = getMask()->x_at(x, y);
@@ -1226,6 +1316,7 @@ public:
 
     /// Return an `y_iterator` at the point `(x, y)`
     y_iterator y_at(int x, int y) const {
+        _materializeVariance();
 #if 0
         typename Image::y_iterator imageEnd = getImage()->y_at(x, y);
         typename Mask::y_iterator maskEnd = getMask()->y_at(x, y);
@@ -1240,6 +1331,7 @@ public:
 
     /// Return an `xy_locator` at the point `(x, y)`
     xy_locator xy_at(int x, int y) const {
+        _materializeVariance();
 #if 0
         typename Image::xy_locator imageEnd = getImage()->xy_at(x, y);
         typename Mask::xy_locator maskEnd = getMask()->xy_at(x, y);
@@ -1254,11 +1346,20 @@ public:
     }
 
 private:
+    // Shared state for a variance plane deferred to a generator; shallow copies
+    // share it so all of them see the same plane once one materializes.
+    struct DeferredVariance;
+
     void conformSizes();
 
+    // If the variance is deferred, run the generator (exactly once across all
+    // sharers) and adopt the plane; no-op otherwise.
+    void _materializeVariance() const;
+
     ImagePtr _image;
     MaskPtr _mask;
-    VariancePtr _variance;
+    mutable VariancePtr _variance;
+    mutable std::shared_ptr<DeferredVariance> _deferredVariance;
 };
 
 /**
@@ -213,6 +213,12 @@ public:
      *                       is always required).
      * @param  allowUnsafe   Permit reading into the requested pixel type even
      *                       when on-disk values may overflow or truncate.
+     * @param  lazyVariance  If True and the reader targets a named file, do
+     *                       not read the variance plane now; instead defer it
+     *                       to a generator that re-reads it from the file on
+     *                       first access (see
+     *                       MaskedImage::setVarianceGenerator).  Ignored for
+     *                       in-memory files and when needAllHdus is True.
      *
      * In Python, this templated method is wrapped with an additional `dtype`
      * argument to provide the type to read (for the image plane).  This
@@ -221,7 +227,8 @@ public:
     template <typename ImagePixelT, typename MaskPixelT=MaskPixel, typename VariancePixelT=VariancePixel>
     MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> read(
         lsst::geom::Box2I const & bbox=lsst::geom::Box2I(), ImageOrigin origin=PARENT,
-        bool conformMasks=false, bool needAllHdus=false, bool allowUnsafe=false
+        bool conformMasks=false, bool needAllHdus=false, bool allowUnsafe=false,
+        bool lazyVariance=false
     );
 
     /**
@@ -137,6 +137,35 @@ public:
     std::shared_ptr<TransmissionCurve const> transformedBy(
             std::shared_ptr<geom::TransformPoint2ToPoint2> transform) const;
 
+    /**
+     *  Return a new TransmissionCurve that tabulates this one on regular grids.
+     *
+     *  @param[in]  wavelengths  Wavelengths (in Angstroms) at which to tabulate
+     *                           the curve (will be copied).  Must be
+     *                           monotonically increasing and contain at least
+     *                           two elements.
+     *  @param[in]  bbox         Spatial region over which to tabulate.
+     *  @param[in]  gridShape    Number of spatial grid points in x and y; the
+     *                           grid spans `bbox` with its outermost points on
+     *                           the boundary.  Must be positive in both
+     *                           dimensions.
+     *
+     *  The returned TransmissionCurve evaluates this one up front at every
+     *  (grid position, wavelength) pair and answers `sampleAt` calls with
+     *  bilinear interpolation into that table, replacing the interpolator
+     *  machinery of the original with simple table lookups.  This is a
+     *  worthwhile trade when the same curve is sampled at many positions,
+     *  as in chromatic corrections.
+     *
+     *  Within the tabulated wavelength range the result is an approximation
+     *  to this curve that is exact on the given grids.  Positions outside
+     *  `bbox` are clamped to its boundary, and wavelengths outside the given
+     *  array yield this curve's `getThroughputAtBounds()` values.
+     */
+    std::shared_ptr<TransmissionCurve const> compiledAt(
+            ndarray::Array<double const, 1, 1> const &wavelengths, lsst::geom::Box2D const &bbox,
+            lsst::geom::Extent2I const &gridShape) const;
+
     // TransmissionCurve is not copyable.
     TransmissionCurve(TransmissionCurve const &) = delete;
 
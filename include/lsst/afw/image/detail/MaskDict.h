@@ -51,6 +51,15 @@ namespace lsst { namespace afw { namespace image { namespace detail {
  * and hence MaskDict's constructors are private, and static or instance
  * methods that return shared_ptr are provided to replace them.
  *
+ * Each MaskDict's plane definitions are held as an immutable snapshot that
+ * mutators replace wholesale (copy-and-publish via atomic shared_ptr
+ * operations), and the default MaskDict is published the same way.  Plane
+ * lookups and Mask construction are therefore lock-free and never observe a
+ * partially-updated dictionary; only mutation (adding or removing planes)
+ * synchronizes on the global mutex.  Concurrent mutations of the same
+ * MaskDict are last-writer-wins, and references or iterators obtained from a
+ * MaskDict refer to the snapshot current at the time of the call.
+ *
  * MaskDict is an implementation detail (albeit and important one) and hence
  * its "documentation" is intentionally in the form of regular comments
  * rather than Doxygen-parsed blocks.  It is also not available from Python.
@@ -64,8 +73,15 @@ public:
     typedef MaskPlaneDict::value_type value_type;
     typedef MaskPlaneDict::const_iterator const_iterator;
 
-    // Return a new MaskDict with the same plane definitions as the given
+    // Return a MaskDict with the same plane definitions as the given
     // MaskPlaneDict, or return the default mask dict if it is empty.
+    //
+    // Instances are hash-consed on content: if an active MaskDict already
+    // holds these definitions it is shared rather than copied, so callers
+    // must clone() before mutating the result (as Mask already does).
+    // The default MaskDict is never returned for a non-empty dict, even on
+    // a content match, because Mask treats pointer identity with the
+    // default as ownership of it.
     static std::shared_ptr<MaskDict> copyOrGetDefault(MaskPlaneDict const& dict);
 
     // Return the default MaskDict to be used for new Mask instances.
@@ -128,20 +144,24 @@ public:
     bool operator!=(MaskDict const& rhs) const { return !(*this == rhs); }
 
     // Iterators over MaskDict items (yields std::pair<std::string, int>).
-    const_iterator begin() const noexcept { return _dict.begin(); }
-    const_iterator end() const noexcept { return _dict.end(); }
+    // Note that begin() and end() each refer to the snapshot current when
+    // they are called; iterating while another thread mutates this MaskDict
+    // remains the caller's responsibility to avoid.
+    const_iterator begin() const noexcept { return _load()->dict.begin(); }
+    const_iterator end() const noexcept { return _load()->dict.end(); }
 
     // Return an iterator to the item with the given name, or end().
-    const_iterator find(std::string const & name) const { return _dict.find(name); }
+    const_iterator find(std::string const & name) const { return _load()->dict.find(name); }
 
     // Return the number of planes in this MaskDict.
-    std::size_t size() const noexcept { return _dict.size(); }
+    std::size_t size() const noexcept { return _load()->dict.size(); }
 
     // Return true if the MaskDict contains no mask planes.
-    bool empty() const noexcept { return _dict.empty(); }
+    bool empty() const noexcept { return _load()->dict.empty(); }
 
-    // Return the internal MaskPlaneDict.
-    MaskPlaneDict const & getMaskPlaneDict() const noexcept { return _dict; }
+    // Return the internal MaskPlaneDict (the current snapshot; the reference
+    // is valid until the next mutation of this MaskDict).
+    MaskPlaneDict const & getMaskPlaneDict() const noexcept { return _load()->dict; }
 
     // Add a mask plane to just this MaskDict.
     // If a plane with the given name already exists, it is overridden.
@@ -160,6 +180,26 @@ private:
 
     class GlobalState;
 
+    // Immutable snapshot of the plane definitions, bundled with their hash
+    // so that readers always see the two in a consistent state.
+    struct Snapshot {
+        Snapshot();
+        explicit Snapshot(MaskPlaneDict const & dict_);
+
+        MaskPlaneDict dict;
+        std::size_t hash;
+    };
+
+    // Return the current snapshot (lock-free).
+    std::shared_ptr<Snapshot const> _load() const noexcept {
+        return std::atomic_load_explicit(&_data, std::memory_order_acquire);
+    }
+
+    // Publish a new snapshot; concurrent writers are last-writer-wins.
+    void _store(std::shared_ptr<Snapshot const> snapshot) noexcept {
+        std::atomic_store_explicit(&_data, std::move(snapshot), std::memory_order_release);
+    }
+
     // Add mask planes that should be present on all Masks that don't
     // explicitly remove them.  Called exactly once, when initalizing
     // GlobalState.
@@ -173,11 +213,10 @@ private:
 
     explicit MaskDict(MaskPlaneDict const & dict);
 
-    MaskDict(MaskDict const &) = default;
+    MaskDict(MaskDict const & other);
     MaskDict(MaskDict &&) = default;
 
-    MaskPlaneDict _dict;
-    std::size_t _hash;
+    std::shared_ptr<Snapshot const> _data;
 };
 
 }}}} // namespace lsst::afw::image::detail
@@ -0,0 +1,118 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#if !defined(LSST_AFW_INSTRUMENTATION_H)
+#define LSST_AFW_INSTRUMENTATION_H
+/*
+ * Lightweight always-on counters and timers for the afw hot paths
+ */
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <map>
+#include <string>
+
+namespace lsst {
+namespace afw {
+namespace instrumentation {
+
+/**
+ * The fixed set of metrics afw maintains.
+ *
+ * Counters are cumulative over the life of the process (they are never
+ * reset); consumers are expected to scrape snapshot() periodically and
+ * compute rates from the deltas.  The `*_NANOS` entries accumulate wall-clock
+ * nanoseconds spent inside the corresponding entry points and pair with the
+ * `*_CALLS` entries maintained by the same Timer.
+ */
+enum class Metric : std::size_t {
+    CONVOLVE_CALLS,
+    CONVOLVE_NANOS,
+    WARP_CALLS,
+    WARP_NANOS,
+    STATISTICS_CALLS,
+    STATISTICS_NANOS,
+    STACK_CALLS,
+    STACK_NANOS,
+    FITS_BYTES_READ,
+    FITS_BYTES_WRITTEN,
+    FITS_HEADER_CACHE_HITS,
+    FITS_HEADER_CACHE_MISSES,
+    PSF_CACHE_HITS,
+    PSF_CACHE_MISSES,
+    TABLE_BLOCK_ALLOCATIONS,
+    TABLE_BLOCK_BYTES,
+    NUM_METRICS  // must be last; not itself a metric
+};
+
+/**
+ * Add to a metric.
+ *
+ * Each thread accumulates into its own slot, so this is a single relaxed
+ * atomic add with no cross-thread contention and is cheap enough for
+ * per-call (though not per-pixel) use.
+ */
+void add(Metric metric, std::uint64_t amount = 1) noexcept;
+
+/**
+ * RAII timer for an instrumented entry point.
+ *
+ * On destruction adds 1 to `calls` and the elapsed wall-clock nanoseconds
+ * to `nanos`.  Nested or concurrent timers simply accumulate, so the nanos
+ * of a threaded region can exceed elapsed time.
+ */
+class Timer final {
+public:
+    Timer(Metric calls, Metric nanos) noexcept
+            : _calls(calls), _nanos(nanos), _start(std::chrono::steady_clock::now()) {}
+
+    Timer(Timer const &) = delete;
+    Timer(Timer &&) = delete;
+    Timer &operator=(Timer const &) = delete;
+    Timer &operator=(Timer &&) = delete;
+
+    ~Timer() {
+        auto const elapsed = std::chrono::steady_clock::now() - _start;
+        add(_calls);
+        add(_nanos, std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+
+private:
+    Metric _calls;
+    Metric _nanos;
+    std::chrono::steady_clock::time_point _start;
+};
+
+/**
+ * Return the current value of every metric, summed over all threads
+ * (including threads that have since exited), keyed by a stable
+ * dotted name such as "convolve.calls" or "fits.bytesRead".
+ */
+std::map<std::string, std::uint64_t> snapshot();
+
+}  // namespace instrumentation
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // LSST_AFW_INSTRUMENTATION_H
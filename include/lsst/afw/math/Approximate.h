@@ -60,8 +60,10 @@ public:
      * @param orderX Order of approximation to use in x-direction
      * @param orderY Order of approximation to use in y-direction
      * @param weighting Use inverse variance weighting?
+     * @param numThreads Number of threads over which to divide the fit; the fit is
+     *                   single threaded unless this is greater than 1
      */
-    ApproximateControl(Style style, int orderX, int orderY = -1, bool weighting = true);
+    ApproximateControl(Style style, int orderX, int orderY = -1, bool weighting = true, int numThreads = 1);
     /// Return the Style
     Style getStyle() const { return _style; }
     /// Set the Style
@@ -78,12 +80,17 @@ public:
     bool getWeighting() const { return _weighting; }
     /// Set whether inverse variance weighting will be used in calculation
     void setWeighting(bool const weighting) { _weighting = weighting; }
+    /// Return the number of threads over which to divide the fit
+    int getNumThreads() const { return _numThreads; }
+    /// Set the number of threads over which to divide the fit
+    void setNumThreads(int const numThreads) { _numThreads = numThreads; }
 
 private:
     Style _style;
     int _orderX;
     int _orderY;
     bool _weighting;
+    int _numThreads;
 };
 
 /**
@@ -356,6 +356,20 @@ public:
      */
     lsst::geom::Box2I getImageBBox() const { return _imgBBox; }
 
+    /**
+     * Return the bounding box of one statistics cell, in the image's LOCAL coordinates
+     *
+     * @throws lsst::pex::exceptions::OutOfRangeError if the cell indices are out of range
+     */
+    lsst::geom::Box2I getCellBox(int const iX, int const iY) const {
+        if (iX < 0 || iX >= static_cast<int>(_xorig.size()) || iY < 0 ||
+            iY >= static_cast<int>(_yorig.size())) {
+            throw LSST_EXCEPT(lsst::pex::exceptions::OutOfRangeError, "Cell index out of range");
+        }
+        return lsst::geom::Box2I(lsst::geom::Point2I(_xorig[iX], _yorig[iY]),
+                                 lsst::geom::Extent2I(_xsize[iX], _ysize[iY]));
+    }
+
     std::shared_ptr<BackgroundControl> getBackgroundControl() { return _bctrl; }
     std::shared_ptr<BackgroundControl const> getBackgroundControl() const { return _bctrl; }
 
@@ -489,13 +503,41 @@ public:
      */
     lsst::afw::image::MaskedImage<InternalPixelT> getStatsImage() const { return _statsImage; }
 
+    /**
+     * Re-estimate only the grid cells that intersect a region of the image
+     *
+     * After patching a small part of the image (e.g. interpolating over fresh defects or a
+     * satellite trail) the background need not be rebuilt from scratch: only the cells whose
+     * footprints intersect `region` have their statistics re-measured, so the cost scales with
+     * the dirty area rather than the frame.  The interpolation is rebuilt lazily by the next
+     * getImage() call, which therefore sees exactly what a full reconstruction would produce.
+     *
+     * @param img The image the background was estimated from, with the dirty region already
+     *            patched; it must have the same (PARENT) bounding box as the original.
+     * @param region The dirty region, in the image's PARENT coordinates.
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if `img`'s bounding box does not
+     *         match the original image's.
+     *
+     * @note The statistics are those configured in the BackgroundControl this object was built
+     * with; a BackgroundMI reconstructed from a bare statsImage only has the default control.
+     */
+    template <typename ImageT>
+    void updateRegion(ImageT const& img, lsst::geom::Box2I const& region);
+
 private:
     lsst::afw::image::MaskedImage<InternalPixelT>
             _statsImage;  // statistical properties for the grid of subimages
     mutable std::vector<std::vector<double>> _gridColumns;  // interpolated columns for the bicubic spline
+    // Cache of the per-column y-splines, keyed by their knot values, so repeated getImage()
+    // calls (e.g. one per forced-photometry cutout) build each column's spline only once;
+    // keying by value means editing the stats image just produces fresh entries.
+    mutable InterpolateCache _interpCache;
 
+    // Interpolate stats-image column iX in y, filling rows [yBegin, yEnd) of _gridColumns[iX];
+    // rows outside that range are left unset, so getImage(bbox) pays only for the rows it needs
     void _setGridColumns(Interpolate::Style const interpStyle, UndersampleStyle const undersampleStyle,
-                         int const iX, std::vector<int> const& ypix) const;
+                         int const iX, int const yBegin, int const yEnd) const;
 
 #if defined(LSST_makeBackground_getImage)
     BOOST_PP_SEQ_FOR_EACH(LSST_makeBackground_getImage, override, LSST_makeBackground_getImage_types);
@@ -526,6 +568,69 @@ template <typename ImageT>
 std::shared_ptr<Background> makeBackground(ImageT const& img, BackgroundControl const& bgCtrl) {
     return std::shared_ptr<Background>(new BackgroundMI(img, bgCtrl));
 }
+
+/**
+ * Iteratively estimate and subtract the background of a MaskedImage in place
+ *
+ * Sky subtraction usually iterates: estimate the background, subtract it, detect sources,
+ * mask them, re-estimate.  Rebuilding the full BackgroundMI and a full-frame background
+ * image every round costs as much as the first round even though only the freshly masked
+ * cells can change.  This engine keeps the per-cell statistics between rounds: the first
+ * subtract() measures every cell, while later calls re-measure only the cells whose mask
+ * pixels changed since the previous round and subtract the resulting correction directly
+ * from the image, so a round that masks a handful of sources costs a handful of cells.
+ *
+ * The cumulative model (the sum of everything subtracted so far) is available from
+ * getBackground(), e.g. for restoring the image or for persistence.
+ */
+template <typename PixelT>
+class IterativeBackgroundSubtractor final {
+public:
+    /**
+     * @param bgCtrl Controls the cell grid, statistics, and interpolation, exactly as for
+     *               BackgroundMI
+     */
+    explicit IterativeBackgroundSubtractor(BackgroundControl const& bgCtrl);
+
+    IterativeBackgroundSubtractor(IterativeBackgroundSubtractor const&) = delete;
+    IterativeBackgroundSubtractor(IterativeBackgroundSubtractor&&) = delete;
+    IterativeBackgroundSubtractor& operator=(IterativeBackgroundSubtractor const&) = delete;
+    IterativeBackgroundSubtractor& operator=(IterativeBackgroundSubtractor&&) = delete;
+    ~IterativeBackgroundSubtractor() = default;
+
+    /**
+     * Estimate the background of `image` and subtract it in place
+     *
+     * The first call measures every cell; subsequent calls must be passed an image with the
+     * same bounding box and re-measure only the cells whose mask changed.  A re-measured
+     * cell whose statistic comes out NaN (e.g. one that is now entirely masked) keeps its
+     * previous estimate, just as interpolation would bridge it in a full reconstruction.
+     *
+     * @param image the image to subtract; between calls the caller typically updates its
+     *              mask (e.g. with freshly detected sources)
+     * @returns the number of cells (re)measured in this round
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if `image`'s bounding box does
+     *         not match the first round's
+     */
+    int subtract(image::MaskedImage<PixelT>& image);
+
+    /// Return the cumulative background model subtracted so far, or null before the first round
+    std::shared_ptr<BackgroundMI> getBackground() const { return _background; }
+
+private:
+    // Fold a cell's mask pixels into a value that changes when the mask does; we only need
+    // equality between rounds, not a strong hash
+    std::size_t _hashCellMask(image::Mask<image::MaskPixel> const& mask,
+                              lsst::geom::Box2I const& cellBox) const;
+    // Evaluate `model` band by band and subtract it from `image`, so the scratch image
+    // stays band-sized instead of a second full-frame allocation
+    void _subtractModel(image::MaskedImage<PixelT>& image, Background const& model) const;
+
+    std::shared_ptr<BackgroundControl> _bctrl;
+    std::shared_ptr<BackgroundMI> _background;  // cumulative model; statistics are vs. the original image
+    std::vector<std::size_t> _maskHashes;       // per-cell mask hashes from the previous round, row-major
+};
 }  // namespace math
 }  // namespace afw
 }  // namespace lsst
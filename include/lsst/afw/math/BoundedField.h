@@ -87,6 +87,26 @@ public:
     virtual ndarray::Array<double, 1, 1> evaluate(ndarray::Array<double const, 1> const& x,
                                                   ndarray::Array<double const, 1> const& y) const;
 
+    /**
+     *  Evaluate the field at multiple arbitrary points, writing into a caller-provided array
+     *
+     *  @param[in]   x         array of x coordinates, same shape as y
+     *  @param[in]   y         array of y coordinates, same shape as x
+     *  @param[out]  out       array to fill with the output values, same shape as x and y
+     *
+     *  Letting the caller own the output buffer allows it to be reused across many
+     *  evaluations (e.g. for each row of an image, or for each factor of a product of
+     *  fields) without allocating each time.  The default implementation simply copies
+     *  the result of the allocating evaluate() overload; subclasses that can write their
+     *  results directly should override it.
+     *
+     *  There is no bounds-checking on the given positions; this is the responsibility
+     *  of the user, who can almost always do it more efficiently.
+     */
+    virtual void evaluate(ndarray::Array<double const, 1> const& x,
+                          ndarray::Array<double const, 1> const& y,
+                          ndarray::Array<double, 1, 1> const& out) const;
+
     /**
      * Compute the integral of this function over its bounding-box.
      *
@@ -121,12 +141,17 @@ public:
      *                              between grid points will be linearly interpolated.
      *  @param[in]    yStep         Distance between grid points in Y to evaluate; values
      *                              between grid points will be linearly interpolated.
+     *  @param[in]    numThreads    Number of threads to distribute rows of the image over
+     *                              when xStep and yStep are both 1.  Requires the field's
+     *                              batched evaluate() to be safe to call concurrently,
+     *                              which is true for all of the fields in this package.
      *
      *  @throws pex::exceptions::RuntimeError if the bounding boxes do not overlap
      *         and overlapOnly=false.
      */
     template <typename T>
-    void fillImage(image::Image<T>& image, bool overlapOnly = false, int xStep = 1, int yStep = 1) const;
+    void fillImage(image::Image<T>& image, bool overlapOnly = false, int xStep = 1, int yStep = 1,
+                   int numThreads = 1) const;
 
     /**
      *  Add the field or a constant multiple of it to an image in-place
@@ -139,13 +164,15 @@ public:
      *                              between grid points will be linearly interpolated.
      *  @param[in]    yStep         Distance between grid points in Y to evaluate; values
      *                              between grid points will be linearly interpolated.
+     *  @param[in]    numThreads    Number of threads to distribute rows of the image over
+     *                              when xStep and yStep are both 1 (see fillImage).
      *
      *  @throws pex::exceptions::RuntimeError if the bounding boxes do not overlap
      *         and overlapOnly=false.
      */
     template <typename T>
     void addToImage(image::Image<T>& image, double scaleBy = 1.0, bool overlapOnly = false, int xStep = 1,
-                    int yStep = 1) const;
+                    int yStep = 1, int numThreads = 1) const;
 
     /**
      *  Multiply an image by the field in-place.
@@ -157,12 +184,15 @@ public:
      *                              between grid points will be linearly interpolated.
      *  @param[in]    yStep         Distance between grid points in Y to evaluate; values
      *                              between grid points will be linearly interpolated.
+     *  @param[in]    numThreads    Number of threads to distribute rows of the image over
+     *                              when xStep and yStep are both 1 (see fillImage).
      *
      *  @throws pex::exceptions::RuntimeError if the bounding boxes do not overlap
      *         and overlapOnly=false.
      */
     template <typename T>
-    void multiplyImage(image::Image<T>& image, bool overlapOnly = false, int xStep = 1, int yStep = 1) const;
+    void multiplyImage(image::Image<T>& image, bool overlapOnly = false, int xStep = 1, int yStep = 1,
+                       int numThreads = 1) const;
 
     /**
      *  Divide an image by the field in-place.
@@ -174,12 +204,15 @@ public:
      *                              between grid points will be linearly interpolated.
      *  @param[in]    yStep         Distance between grid points in Y to evaluate; values
      *                              between grid points will be linearly interpolated.
+     *  @param[in]    numThreads    Number of threads to distribute rows of the image over
+     *                              when xStep and yStep are both 1 (see fillImage).
      *
      *  @throws pex::exceptions::RuntimeError if the bounding boxes do not overlap
      *         and overlapOnly=false.
      */
     template <typename T>
-    void divideImage(image::Image<T>& image, bool overlapOnly = false, int xStep = 1, int yStep = 1) const;
+    void divideImage(image::Image<T>& image, bool overlapOnly = false, int xStep = 1, int yStep = 1,
+                     int numThreads = 1) const;
 
     /**
      *  Return a scaled BoundedField
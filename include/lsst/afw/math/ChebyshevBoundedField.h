@@ -25,6 +25,7 @@
 #define LSST_AFW_MATH_ChebyshevBoundedField_h_INCLUDED
 
 #include "ndarray.h"
+#include "ndarray/eigen.h"
 
 #include "lsst/pex/config.h"
 #include "lsst/geom/AffineTransform.h"
@@ -193,6 +194,37 @@ public:
     /// @copydoc BoundedField::evaluate
     double evaluate(lsst::geom::Point2D const& position) const override;
 
+    /**
+     *  Evaluate the field at multiple arbitrary points
+     *
+     *  @param[in]  x         array of x coordinates, same shape as y
+     *  @param[in]  y         array of y coordinates, same shape as x
+     *  @returns an array of output values, same shape as x and y
+     *
+     *  Points that share the same y coordinate are evaluated together: the
+     *  y-direction Chebyshev basis is computed once per run of constant y and
+     *  the x-direction recurrence is applied to the whole run at once, which
+     *  makes evaluation on image rows (as done by fillImage and friends) much
+     *  faster than point-at-a-time evaluation.  Results agree with the
+     *  single-point evaluate() to floating-point rounding precision, but are
+     *  not guaranteed to be bitwise identical.
+     *
+     *  There is no bounds-checking on the given positions; this is the
+     *  responsibility of the user, who can almost always do it more
+     *  efficiently.
+     */
+    ndarray::Array<double, 1, 1> evaluate(ndarray::Array<double const, 1> const& x,
+                                          ndarray::Array<double const, 1> const& y) const override;
+
+    /**
+     *  @copydoc BoundedField::evaluate(ndarray::Array<double const, 1> const& x, ndarray::Array<double const, 1> const& y, ndarray::Array<double, 1, 1> const& out) const
+     *
+     *  Results are written directly into the given array, using the same batched
+     *  recurrence as the allocating overload.
+     */
+    void evaluate(ndarray::Array<double const, 1> const& x, ndarray::Array<double const, 1> const& y,
+                  ndarray::Array<double, 1, 1> const& out) const override;
+
     using BoundedField::evaluate;
 
     /// @copydoc BoundedField::integrate
@@ -227,6 +259,81 @@ private:
 
     std::string toString() const override;
 };
+
+/**
+ *  A reusable least-squares fitter for ChebyshevBoundedField.
+ *
+ *  ChebyshevBoundedField::fit rebuilds the design matrix and refactors the normal
+ *  equations from scratch on every call.  When the same (x, y) positions are fit
+ *  repeatedly with new data values (as in iterative calibration loops), most of that
+ *  work is identical from one fit to the next.  This class precomputes the design
+ *  matrix and the Eigensystem factorization of the normal equations once, at
+ *  construction, so each subsequent fit() costs only a pair of matrix-vector
+ *  products.
+ *
+ *  The solution matches the NORMAL_EIGENSYSTEM solution computed by
+ *  ChebyshevBoundedField::fit to rounding precision, including the minimum-norm
+ *  handling of coefficient sets the data cannot constrain.
+ */
+class ChebyshevBoundedFieldFitter final {
+public:
+    typedef ChebyshevBoundedFieldControl Control;
+
+    /**
+     *  Construct a fitter for non-gridded data with equal weights.
+     *
+     *  @param[in]  bbox     Integer bounding box of the fitted approximations.  All
+     *                       given points must lie within lsst::geom::Box2D(bbox).
+     *  @param[in]  x        Array of x coordinate values.
+     *  @param[in]  y        Array of y coordinate values.
+     *  @param[in]  ctrl     Specifies the orders and triangularity of the coefficient matrix.
+     *
+     *  @throws lsst::pex::exceptions::LengthError if x and y have different sizes.
+     */
+    ChebyshevBoundedFieldFitter(lsst::geom::Box2I const& bbox, ndarray::Array<double const, 1> const& x,
+                                ndarray::Array<double const, 1> const& y, Control const& ctrl);
+
+    /**
+     *  Construct a fitter for non-gridded data with unequal weights.
+     *
+     *  @param[in]  bbox     Integer bounding box of the fitted approximations.  All
+     *                       given points must lie within lsst::geom::Box2D(bbox).
+     *  @param[in]  x        Array of x coordinate values.
+     *  @param[in]  y        Array of y coordinate values.
+     *  @param[in]  w        Array of weights for each point in the fit.  For points with
+     *                       Gaussian noise, w = 1/sigma.
+     *  @param[in]  ctrl     Specifies the orders and triangularity of the coefficient matrix.
+     *
+     *  @throws lsst::pex::exceptions::LengthError if x, y and w have different sizes.
+     */
+    ChebyshevBoundedFieldFitter(lsst::geom::Box2I const& bbox, ndarray::Array<double const, 1> const& x,
+                                ndarray::Array<double const, 1> const& y,
+                                ndarray::Array<double const, 1> const& w, Control const& ctrl);
+
+    /// Return the number of data points the fitter was constructed with.
+    int getNumPoints() const { return _design.rows(); }
+
+    /**
+     *  Fit new data values at the fitter's points.
+     *
+     *  @param[in]  z        Array of field values to be fit at each (x,y) point the
+     *                       fitter was constructed with.
+     *
+     *  @throws lsst::pex::exceptions::LengthError if z does not have getNumPoints() elements.
+     */
+    std::shared_ptr<ChebyshevBoundedField> fit(ndarray::Array<double const, 1> const& z) const;
+
+private:
+    // Compute and cache the Eigensystem factorization of the normal equations.
+    void _factor();
+
+    lsst::geom::Box2I _bbox;
+    Control _ctrl;
+    Eigen::MatrixXd _design;          // design matrix, with weights already applied
+    Eigen::VectorXd _weights;         // empty if all points have equal weight
+    Eigen::MatrixXd _eigenvectors;    // eigenvectors of the Fisher matrix
+    Eigen::VectorXd _invEigenvalues;  // inverse eigenvalues of the Fisher matrix, zeroed below threshold
+};
 }  // namespace math
 }  // namespace afw
 }  // namespace lsst
@@ -31,7 +31,10 @@
  *   This would only be used for unit testing and trace messages suffice (barely), so not a high priority.
  */
 #include <limits>
+#include <memory>
 #include <sstream>
+#include <typeindex>
+#include <vector>
 
 #include "lsst/pex/exceptions.h"
 #include "lsst/afw/image/Image.h"
@@ -42,6 +45,77 @@ namespace lsst {
 namespace afw {
 namespace math {
 
+/**
+ * The algorithm used to evaluate a convolution
+ */
+enum ConvolutionAlgorithm {
+    CONVOLUTION_DIRECT = 0,  ///< evaluate in image space
+    CONVOLUTION_FFT = 1,     ///< multiply in Fourier space; only available for plain floating-point
+                             ///< images and spatially invariant kernels, otherwise the direct
+                             ///< algorithm is used
+    CONVOLUTION_AUTO = 2,    ///< use the FFT when the kernel is large enough for it to win
+};
+
+/**
+ * Reusable scratch space for convolve()
+ *
+ * Convolution allocates per-call scratch: the realized kernel image, the separable kernel
+ * x/y vectors and the separable ring buffer. When the same geometry is convolved over and
+ * over (e.g. tens of thousands of postage stamps per visit) these allocations dominate the
+ * fixed cost; attach a workspace to ConvolutionControl to reuse them across calls. Buffers
+ * are reallocated only when the requested geometry (or image type) changes.
+ *
+ * @warning A workspace must not be shared between threads; it is ignored (each band works
+ * privately) when ConvolutionControl requests multithreaded execution.
+ *
+ * @ingroup afw
+ */
+class ConvolutionWorkspace {
+public:
+    ConvolutionWorkspace() : _bufferType(typeid(void)) {}
+
+    /// Return kernel-image scratch of the given dimensions, reusing the previous allocation if possible
+    std::shared_ptr<image::Image<double>> getKernelImage(lsst::geom::Extent2I const& dimensions) {
+        if (!_kernelImage || _kernelImage->getDimensions() != dimensions) {
+            _kernelImage = std::make_shared<image::Image<double>>(dimensions);
+        }
+        return _kernelImage;
+    }
+
+    /// Return the separable kernel x vector scratch, resized to the given length
+    std::vector<double>& getKernelXVector(std::size_t size) {
+        _kernelXVector.resize(size);
+        return _kernelXVector;
+    }
+
+    /// Return the separable kernel y vector scratch, resized to the given length
+    std::vector<double>& getKernelYVector(std::size_t size) {
+        _kernelYVector.resize(size);
+        return _kernelYVector;
+    }
+
+    /// Return image scratch of the given type and dimensions, reusing the previous allocation if possible
+    template <typename ImageT>
+    std::shared_ptr<ImageT> getBuffer(lsst::geom::Extent2I const& dimensions) {
+        if (!_buffer || _bufferType != std::type_index(typeid(ImageT)) || _bufferDimensions != dimensions) {
+            auto buffer = std::make_shared<ImageT>(dimensions);
+            _buffer = buffer;
+            _bufferType = std::type_index(typeid(ImageT));
+            _bufferDimensions = dimensions;
+            return buffer;
+        }
+        return std::static_pointer_cast<ImageT>(_buffer);
+    }
+
+private:
+    std::shared_ptr<image::Image<double>> _kernelImage;  ///< realized kernel image scratch
+    std::vector<double> _kernelXVector;                  ///< separable kernel x vector scratch
+    std::vector<double> _kernelYVector;                  ///< separable kernel y vector scratch
+    std::shared_ptr<void> _buffer;                       ///< type-erased image scratch (ring buffer)
+    std::type_index _bufferType;                         ///< image type held by _buffer
+    lsst::geom::Extent2I _bufferDimensions;              ///< dimensions of _buffer
+};
+
 /**
  * Parameters to control convolution
  *
@@ -52,22 +126,34 @@ public:
     ConvolutionControl(bool doNormalize = true,  ///< normalize the kernel to sum=1?
                        bool doCopyEdge = false,  ///< copy edge pixels from source image
                        ///< instead of setting them to the standard edge pixel?
-                       int maxInterpolationDistance = 10  ///< maximum width or height of a region
+                       int maxInterpolationDistance = 10,  ///< maximum width or height of a region
                        ///< over which to use linear interpolation interpolate
+                       int numThreads = 1  ///< number of threads over which to divide the output image;
+                       ///< 1 means serial execution
                        )
             : _doNormalize(doNormalize),
               _doCopyEdge(doCopyEdge),
-              _maxInterpolationDistance(maxInterpolationDistance) {}
+              _maxInterpolationDistance(maxInterpolationDistance),
+              _numThreads(numThreads),
+              _algorithm(CONVOLUTION_DIRECT) {}
 
     bool getDoNormalize() const { return _doNormalize; }
     bool getDoCopyEdge() const { return _doCopyEdge; }
     int getMaxInterpolationDistance() const { return _maxInterpolationDistance; };
+    int getNumThreads() const { return _numThreads; }
+    ConvolutionAlgorithm getAlgorithm() const { return _algorithm; }
+    std::shared_ptr<ConvolutionWorkspace> getWorkspace() const { return _workspace; }
 
     void setDoNormalize(bool doNormalize) { _doNormalize = doNormalize; }
     void setDoCopyEdge(bool doCopyEdge) { _doCopyEdge = doCopyEdge; }
     void setMaxInterpolationDistance(int maxInterpolationDistance) {
         _maxInterpolationDistance = maxInterpolationDistance;
     }
+    void setNumThreads(int numThreads) { _numThreads = numThreads; }
+    void setAlgorithm(ConvolutionAlgorithm algorithm) { _algorithm = algorithm; }
+    void setWorkspace(std::shared_ptr<ConvolutionWorkspace> workspace) {
+        _workspace = std::move(workspace);
+    }
 
 private:
     bool _doNormalize;              ///< normalize the kernel to sum=1?
@@ -75,6 +161,10 @@ private:
                                     ///< instead of setting them to the standard edge pixel?
     int _maxInterpolationDistance;  ///< maximum width or height of a region
                                     ///< over which to attempt interpolation
+    int _numThreads;                ///< number of threads over which to divide the output image;
+                                    ///< each thread convolves a horizontal band of the output
+    ConvolutionAlgorithm _algorithm;  ///< how to evaluate the convolution
+    std::shared_ptr<ConvolutionWorkspace> _workspace;  ///< caller-owned scratch reused across calls
 };
 
 /**
@@ -131,9 +221,10 @@ inline typename OutImageT::SinglePixel convolveAtAPoint(
  * to the lower left corner of the sub-image, but it will almost certainly change to be
  * the lower left corner of the parent image.
  *
- * All convolution is performed in real space. This allows convolution to handle masked pixels
- * and spatially varying kernels. Although convolution of an Image with a spatially invariant kernel could,
- * in fact, be performed in Fourier space, the code does not do this.
+ * By default all convolution is performed in real space. This allows convolution to handle masked
+ * pixels and spatially varying kernels. Convolution of a plain floating-point Image with a spatially
+ * invariant kernel may instead be performed in Fourier space by setting the algorithm on
+ * ConvolutionControl to CONVOLUTION_FFT (or to CONVOLUTION_AUTO, which switches over for large kernels).
  *
  * Note that mask bits are smeared by convolution; all nonzero pixels in the kernel smear the mask, even
  * pixels that have very small values. Larger kernels smear the mask more and are also slower to convolve.
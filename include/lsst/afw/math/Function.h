@@ -28,8 +28,11 @@
  * Define the basic Function classes.
  */
 #include <cmath>
+#include <cstddef>
+#include <initializer_list>
 #include <stdexcept>
 #include <sstream>
+#include <typeinfo>
 #include <vector>
 
 #include "boost/format.hpp"
@@ -312,6 +315,99 @@ protected:
     explicit Function2() : Function<ReturnT>() {}
 };
 
+namespace detail {
+
+/**
+ * @internal Evaluate a Function1 over an array with direct calls if its dynamic type is exactly
+ * ConcreteFunctionT; return false (having done nothing) otherwise.
+ *
+ * The qualified call suppresses virtual dispatch, so the concrete operator() can be inlined
+ * into the loop.
+ */
+template <typename ConcreteFunctionT, typename ReturnT>
+bool tryEvaluateFunction1Array(Function1<ReturnT> const& function, double const* xList,
+                               ReturnT* valueList, std::size_t num) {
+    if (typeid(function) != typeid(ConcreteFunctionT)) {
+        return false;
+    }
+    ConcreteFunctionT const& concrete = static_cast<ConcreteFunctionT const&>(function);
+    for (std::size_t i = 0; i != num; ++i) {
+        valueList[i] = concrete.ConcreteFunctionT::operator()(xList[i]);
+    }
+    return true;
+}
+
+/// @internal Row-oriented Function2 analog of tryEvaluateFunction1Array
+template <typename ConcreteFunctionT, typename ReturnT>
+bool tryEvaluateFunction2Row(Function2<ReturnT> const& function, double const* xList, double y,
+                             ReturnT* valueList, std::size_t num) {
+    if (typeid(function) != typeid(ConcreteFunctionT)) {
+        return false;
+    }
+    ConcreteFunctionT const& concrete = static_cast<ConcreteFunctionT const&>(function);
+    for (std::size_t i = 0; i != num; ++i) {
+        valueList[i] = concrete.ConcreteFunctionT::operator()(xList[i], y);
+    }
+    return true;
+}
+
+}  // namespace detail
+
+/**
+ * Evaluate a Function1 at each point of an array.
+ *
+ * The function is evaluated through its virtual operator() unless its dynamic type is exactly
+ * one of the CandidateFunctionTs, in which case the whole array is evaluated with direct,
+ * inlinable calls to that type's operator(): one type test per array instead of one virtual
+ * dispatch per point. Intended for hot loops (kernel rasterization, warping) whose likely
+ * concrete function types are known at the call site; the polymorphic interface remains the
+ * configuration API. A subclass of a candidate type never matches the exact type test, so a
+ * redefined operator() is always honored via the virtual fallback.
+ *
+ * @param[in] function function to evaluate
+ * @param[in] xList array of `num` points at which to evaluate the function
+ * @param[out] valueList array of `num` function values
+ * @param[in] num number of points
+ */
+template <typename... CandidateFunctionTs, typename ReturnT>
+void evaluateFunction1Array(Function1<ReturnT> const& function, double const* xList, ReturnT* valueList,
+                            std::size_t num) {
+    bool done = false;
+    (void)std::initializer_list<bool>{
+            (done = done || detail::tryEvaluateFunction1Array<CandidateFunctionTs>(function, xList,
+                                                                                   valueList, num))...};
+    if (!done) {
+        for (std::size_t i = 0; i != num; ++i) {
+            valueList[i] = function(xList[i]);
+        }
+    }
+}
+
+/**
+ * Evaluate a Function2 along a row of points sharing one y value.
+ *
+ * The Function2 analog of evaluateFunction1Array; see there for the dispatch rules.
+ *
+ * @param[in] function function to evaluate
+ * @param[in] xList array of `num` x coordinates at which to evaluate the function
+ * @param[in] y y coordinate shared by the whole row
+ * @param[out] valueList array of `num` function values
+ * @param[in] num number of points
+ */
+template <typename... CandidateFunctionTs, typename ReturnT>
+void evaluateFunction2Row(Function2<ReturnT> const& function, double const* xList, double y,
+                          ReturnT* valueList, std::size_t num) {
+    bool done = false;
+    (void)std::initializer_list<bool>{
+            (done = done || detail::tryEvaluateFunction2Row<CandidateFunctionTs>(function, xList, y,
+                                                                                 valueList, num))...};
+    if (!done) {
+        for (std::size_t i = 0; i != num; ++i) {
+            valueList[i] = function(xList[i], y);
+        }
+    }
+}
+
 /**
  * Base class for 2-dimensional polynomials of the form:
  *
@@ -621,6 +621,41 @@ public:
     void interpolate(ndarray::Array<T, 1, 1> mu, ndarray::Array<T, 1, 1> variance,
                      ndarray::Array<T, 1, 1> const &vin, int numberOfNeighbors) const;
 
+    /**
+     * Interpolate the function at many points at once, sharing work between nearby queries
+     *
+     * @param [out] mu a 1-dimensional ndarray where the interpolated function values will be
+     * stored (one element per query point)
+     *
+     * @param [out] variance a 1-dimensional ndarray where the corresponding variances in the
+     * function value will be stored
+     *
+     * @param [in] queries a 2-dimensional ndarray containing the points to be interpolated.
+     * queries[i][j] is the jth component of the ith point
+     *
+     * @param [in] numberOfNeighbors the number of nearest neighbors to be used in each
+     * interpolation
+     *
+     * @param [in] numThreads the number of threads over which to distribute the per-query
+     * linear algebra.  The nearest neighbor searches are always performed serially, because
+     * KdTree keeps mutable search state.
+     *
+     * Unlike batchInterpolate, which uses all of the data points for every query, this
+     * method uses numberOfNeighbors nearest neighbors per query, exactly like the
+     * single-point interpolate.  Consecutive queries that select the same neighbor set
+     * (common when the queries are ordered by position) reuse the factorization of the
+     * neighbor covariance matrix instead of rebuilding it.
+     *
+     * Note: neighbors are processed in index order rather than distance order so that
+     * identical neighbor sets can be recognized, which means results can differ from the
+     * single-point interpolate at the level of floating-point round-off.
+     *
+     * @throws pex::exceptions::RuntimeError if you are interpolating more than one function
+     */
+    void interpolate(ndarray::Array<T, 1, 1> mu, ndarray::Array<T, 1, 1> variance,
+                     ndarray::Array<T, 2, 2> const &queries, int numberOfNeighbors,
+                     int numThreads = 1) const;
+
     /**
      * @brief This method will interpolate the function on a data point
      * for purposes of optimizing hyper parameters
@@ -671,7 +706,8 @@ public:
      * queries[i][j] is the jth component of the ith point
      *
      * This method will attempt to construct a _npts X _npts covariance matrix C and solve the problem Cx=b.
-     * Be wary of using it in the case where _npts is very large.
+     * Be wary of using it in the case where _npts is very large; consider calling
+     * setMaxInducingPoints to enable the subset-of-regressors approximation in that case.
      *
      * This version of the method will also return variances for all of the query points.
      * That is a very time consuming calculation relative to just returning estimates for
@@ -786,6 +822,32 @@ public:
      */
     void setLambda(T lambda);
 
+    /**
+     * Set the maximum number of inducing points used by batchInterpolate
+     *
+     * @param [in] maxInducingPoints the number of inducing points (zero disables the approximation)
+     *
+     * @throws pex::exceptions::RuntimeError if maxInducingPoints is negative
+     *
+     * By default, batchInterpolate builds and factorizes the full _npts X _npts covariance
+     * matrix, which becomes unusable beyond a few thousand data points.  Setting this to a
+     * positive value m < _npts switches batchInterpolate to a subset-of-regressors
+     * approximation: m data points spread evenly through the data are used as inducing
+     * points, and the m X m system
+     *
+     * (K_mn K_nm + lambda K_mm) w = K_mn (f - fbar)
+     *
+     * is solved in place of the full system, reducing the setup cost from O(_npts^3) to
+     * O(_npts m^2) and the memory footprint from O(_npts^2) to O(_npts m).  The returned
+     * variances are the subset-of-regressors variances, which fall to the noise floor far
+     * from the inducing points rather than rising to the prior variance.
+     *
+     * If maxInducingPoints is zero or is greater than or equal to _npts, batchInterpolate
+     * performs the exact calculation.  interpolate() and selfInterpolate() are unaffected,
+     * since they only ever factorize the covariance matrix of the nearest neighbors.
+     */
+    void setMaxInducingPoints(int maxInducingPoints);
+
     /**
      * @brief Give the user acces to _timer, an object keeping track of the time spent on
      * various processes within interpolate
@@ -804,6 +866,7 @@ public:
 
 private:
     int _npts, _useMaxMin, _dimensions, _room, _roomStep, _nFunctions;
+    int _maxInducingPoints;
 
     T _krigingParameter, _lambda;
 
@@ -814,6 +877,24 @@ private:
 
     std::shared_ptr<Covariogram<T> > _covariogram;
     mutable GaussianProcessTimer _timer;
+
+    /**
+     * Do the work of batchInterpolate when the subset-of-regressors approximation is
+     * active (see setMaxInducingPoints)
+     *
+     * @param [out] muOut an nQueries X _nFunctions matrix of interpolated function values
+     *
+     * @param [out] varianceOut an nQueries X 1 matrix of variances; pass nullptr
+     * if variances are not needed
+     *
+     * @param [in] queries a 2-dimensional ndarray containing the points to be interpolated
+     *
+     * muOut and varianceOut are resized by this method; queries must already have been
+     * validated by the caller.
+     */
+    void _batchInterpolateInducing(Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> &muOut,
+                                   Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> *varianceOut,
+                                   ndarray::Array<T, 2, 2> const &queries) const;
 };
 }  // namespace math
 }  // namespace afw
@@ -332,7 +332,8 @@ inline T rescale_error(T err, T const &resabs, T const &resasc) {
 template <class UF>
 inline bool intGKPNA(UF const &func, IntRegion<typename UF::result_type> &reg,
                      typename UF::result_type const epsabs, typename UF::result_type const epsrel,
-                     std::map<typename UF::result_type, typename UF::result_type> *fxmap = 0) {
+                     std::map<typename UF::result_type, typename UF::result_type> *fxmap = 0,
+                     int *gkpLevel = 0) {
     typedef typename UF::result_type UfResult;
     UfResult const a = reg.Left();
     UfResult const b = reg.Right();
@@ -430,6 +431,9 @@ inline bool intGKPNA(UF const &func, IntRegion<typename UF::result_type> &reg,
         //   test for convergence.
         if (err < epsabs || err < epsrel * fabs(area2)) {
             reg.SetArea(area2, err);
+            if (gkpLevel) {
+                *gkpLevel = level;
+            }
             return true;
         }
         area1 = area2;
@@ -437,6 +441,9 @@ inline bool intGKPNA(UF const &func, IntRegion<typename UF::result_type> &reg,
 
     // failed to converge
     reg.SetArea(area1, err);
+    if (gkpLevel) {
+        *gkpLevel = NGKPLEVELS - 1;
+    }
 
     integ_dbg2 << "Failed to reach tolerance with highest-order GKP rule";
 
@@ -944,6 +951,160 @@ typename BinaryFunctionT::result_type integrate2d(BinaryFunctionT func,
     FunctionWrapper<BinaryFunctionT> fwrap(func, x1, x2, eps);
     return integrate(fwrap, y1, y2, eps);
 }
+
+// =============================================================
+/**
+ * A reusable quadrature plan for a family of similar integrands
+ *
+ * Building a plan runs the usual adaptive Gauss-Kronrod-Patterson subdivision
+ * for a prototype integrand and records the adapted subintervals together with
+ * the quadrature rule each one converged with.  Applying the plan to another
+ * member of the same integrand family (e.g. the same filter curve times a
+ * slightly shifted SED) skips the adaptation entirely: only the function
+ * values at the recorded nodes are recomputed, either point by point via
+ * operator() or all at once via integrateValues() when the caller can
+ * evaluate the integrand at getNodes() in a vectorized fashion.
+ *
+ * The accuracy of a planned integral is that of the prototype: if a new
+ * integrand needs finer subdivision than the prototype did, the plan will not
+ * notice.  Only finite bounds are supported; a 2d integral can reuse a plan
+ * for its inner dimension by planning the inner integrand at a representative
+ * outer coordinate.
+ */
+template <typename T>
+class IntegrationPlan final {
+public:
+    /**
+     * Adapt a plan to the prototype integrand `func` over [a, b]
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if a bound is infinite
+     */
+    template <typename UnaryFunctionT>
+    IntegrationPlan(UnaryFunctionT func, T const a, T const b, T const abserr = DEFABSERR,
+                    T const relerr = DEFRELERR)
+            : _area(0), _err(0) {
+        using namespace details;
+        if (a <= -MOCK_INF || b >= MOCK_INF) {
+            throw LSST_EXCEPT(lsst::pex::exceptions::InvalidParameterError,
+                              "IntegrationPlan requires finite integration bounds");
+        }
+        std::vector<IntRegion<T> > pending;
+        pending.push_back(IntRegion<T>(a, b));
+        while (!pending.empty()) {
+            IntRegion<T> reg = pending.back();
+            pending.pop_back();
+            T const width = reg.Right() - reg.Left();
+            // Share the absolute error budget among subintervals by width
+            T const localAbserr = abserr * fabs(width) / fabs(b - a);
+            int level = NGKPLEVELS - 1;
+            if (intGKPNA(func, reg, localAbserr, relerr, 0, &level) ||
+                fabs(width / (b - a)) < Epsilon<double>()) {
+                // A subinterval too narrow to subdivide further is kept with
+                // its error estimate rather than looping on a singularity,
+                // just as intGKP gives up on it
+                _recordRegion(reg, level);
+            } else {
+                std::vector<IntRegion<T> > children;
+                reg.SubDivide(&children);
+                for (size_t i = 0; i < children.size(); i++) {
+                    pending.push_back(children[i]);
+                }
+            }
+        }
+    }
+
+    /// Number of quadrature nodes in the plan
+    std::size_t size() const { return _nodes.size(); }
+    /// Abscissas at which a planned integration evaluates the integrand
+    std::vector<T> const &getNodes() const { return _nodes; }
+    /// Quadrature weight applied to the integrand value at each node
+    std::vector<T> const &getWeights() const { return _weights; }
+    /// Integral of the prototype integrand the plan was adapted to
+    T const &getArea() const { return _area; }
+    /// Error estimate for the prototype integral
+    T const &getErr() const { return _err; }
+
+    /// Integrate another member of the integrand family over the planned nodes
+    template <typename UnaryFunctionT>
+    T operator()(UnaryFunctionT func) const {
+        T sum = T();
+        for (std::size_t i = 0; i < _nodes.size(); ++i) {
+            sum += _weights[i] * func(_nodes[i]);
+        }
+        return sum;
+    }
+
+    /**
+     * Integrate from integrand values precomputed at getNodes()
+     *
+     * This is the batched interface: evaluate the integrand at every node in
+     * one (vectorizable) pass and hand the values over in node order.
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if the number of
+     *         values does not match size()
+     */
+    T integrateValues(std::vector<T> const &values) const {
+        if (values.size() != _nodes.size()) {
+            std::ostringstream s;
+            s << "Expected " << _nodes.size() << " integrand values, got " << values.size();
+            throw LSST_EXCEPT(lsst::pex::exceptions::InvalidParameterError, s.str());
+        }
+        T sum = T();
+        for (std::size_t i = 0; i < values.size(); ++i) {
+            sum += _weights[i] * values[i];
+        }
+        return sum;
+    }
+
+private:
+    // Append the fixed rule the subinterval converged with: the center node
+    // plus the +-abscissa pairs of every level up to the converged one, all
+    // weighted by the converged level's weights (see intGKPNA)
+    void _recordRegion(IntRegion<T> const &reg, int const level) {
+        using namespace details;
+        T const halfLength = 0.5 * (reg.Right() - reg.Left());
+        T const center = 0.5 * (reg.Right() + reg.Left());
+        _nodes.push_back(center);
+        _weights.push_back(gkp_wb<T>(level).back() * halfLength);
+        std::size_t k = 0;
+        for (int lev = 0; lev < level; ++lev) {
+            for (std::size_t j = 0; j < gkp_x<T>(lev).size(); ++j, ++k) {
+                T const abscissa = halfLength * gkp_x<T>(lev)[j];
+                T const weight = gkp_wa<T>(level)[k] * halfLength;
+                _nodes.push_back(center - abscissa);
+                _weights.push_back(weight);
+                _nodes.push_back(center + abscissa);
+                _weights.push_back(weight);
+            }
+        }
+        for (std::size_t j = 0; j < gkp_x<T>(level).size(); ++j) {
+            T const abscissa = halfLength * gkp_x<T>(level)[j];
+            T const weight = gkp_wb<T>(level)[j] * halfLength;
+            _nodes.push_back(center - abscissa);
+            _weights.push_back(weight);
+            _nodes.push_back(center + abscissa);
+            _weights.push_back(weight);
+        }
+        _area += reg.Area();
+        _err += reg.Err();
+    }
+
+    std::vector<T> _nodes;
+    std::vector<T> _weights;
+    T _area;
+    T _err;
+};
+
+/**
+ * Build an IntegrationPlan with the same conventions as integrate()
+ */
+template <typename UnaryFunctionT>
+IntegrationPlan<typename UnaryFunctionT::result_type> makeIntegrationPlan(
+        UnaryFunctionT func, typename UnaryFunctionT::argument_type const a,
+        typename UnaryFunctionT::argument_type const b, double eps = 1.0e-6) {
+    typedef typename UnaryFunctionT::result_type Result;
+    return IntegrationPlan<Result>(func, a, b, static_cast<Result>(DEFABSERR), static_cast<Result>(eps));
+}
 }  // namespace math
 }  // namespace afw
 }  // namespace lsst
@@ -23,11 +23,24 @@
  * the GNU General Public License along with this program.  If not,
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
+#include <list>
+#include <memory>
+#include <vector>
+
 #include "lsst/base.h"
 #include "ndarray_fwd.h"
 
 namespace lsst {
 namespace afw {
+
+namespace image {
+template <typename PixelT>
+class Image;
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+class MaskedImage;
+class DefectBase;
+}  // namespace image
+
 namespace math {
 
 /*
@@ -57,8 +70,16 @@ public:
     Interpolate &operator=(Interpolate &&) = delete;
     virtual ~Interpolate() = default;
     virtual double interpolate(double const x) const = 0;
-    std::vector<double> interpolate(std::vector<double> const &x) const;
-    ndarray::Array<double, 1> interpolate(ndarray::Array<double const, 1> const &x) const;
+    /**
+     * Interpolate a whole array of points at once
+     *
+     * The base-class implementations loop over the scalar interpolate(); concrete interpolators
+     * may override them to amortize per-point overheads (the GSL-backed one evaluates its
+     * already-initialized spline directly, avoiding a virtual call per point and keeping the
+     * accelerator cache warm for ordered abscissae).
+     */
+    virtual std::vector<double> interpolate(std::vector<double> const &x) const;
+    virtual ndarray::Array<double, 1> interpolate(ndarray::Array<double const, 1> const &x) const;
 
 protected:
     /**
@@ -97,6 +118,47 @@ std::shared_ptr<Interpolate> makeInterpolate(std::vector<double> const &x, std::
 std::shared_ptr<Interpolate> makeInterpolate(ndarray::Array<double const, 1> const &x,
                                              ndarray::Array<double const, 1> const &y,
                                              Interpolate::Style const style = Interpolate::AKIMA_SPLINE);
+/**
+ * A small least-recently-used cache of Interpolate objects
+ *
+ * Building a GSL interpolator costs an allocation and a coefficient solve, which dominates
+ * when the same knot set is interpolated over and over — the pattern when rendering background
+ * images for every CCD with the same grid.  The cache hands back the previously-built object
+ * whenever x, y and style all match a recent request, so the spline is constructed once and
+ * only evaluated thereafter; a request with different values simply builds (and caches) a new
+ * one, so callers need never invalidate by hand.
+ *
+ * The cache is not thread-safe; give each thread its own.
+ */
+class InterpolateCache final {
+public:
+    /**
+     * @param capacity maximum number of interpolators to retain
+     */
+    explicit InterpolateCache(std::size_t const capacity = 64);
+
+    /// Return an interpolator for (x, y, style), reusing a cached one when the points match
+    std::shared_ptr<Interpolate> makeInterpolate(std::vector<double> const &x,
+                                                 std::vector<double> const &y,
+                                                 Interpolate::Style const style = Interpolate::AKIMA_SPLINE);
+
+    /// Number of interpolators currently held
+    std::size_t size() const noexcept { return _entries.size(); }
+    /// Drop all cached interpolators
+    void clear() noexcept { _entries.clear(); }
+
+private:
+    struct Entry {
+        std::vector<double> x;
+        std::vector<double> y;
+        Interpolate::Style style;
+        std::shared_ptr<Interpolate> interp;
+    };
+
+    std::size_t _capacity;      // maximum number of entries to retain
+    std::list<Entry> _entries;  // most recently used first
+};
+
 /**
  * Conversion function to switch a string to an Interpolate::Style.
  *
@@ -115,6 +177,45 @@ Interpolate::Style lookupMaxInterpStyle(int const n);
  * @param style The style in question
  */
 int lookupMinInterpPoints(Interpolate::Style const style);
+
+/**
+ * Interpolate over a set of defects in a single row-ordered sweep
+ *
+ * All defect bounding boxes are decomposed into per-row horizontal spans (clipped to the
+ * image), the spans of each row are merged, and each affected row is healed in one
+ * left-to-right pass: the good pixels flanking every bad run are collected as anchors, a
+ * single interpolator is built per row from all of its anchors, and the bad pixels are
+ * evaluated against it.  This replaces the per-defect spline setup that dominates when a
+ * bad column crosses thousands of rows.
+ *
+ * If a row has too few anchors for the requested style the style is downgraded (via
+ * lookupMaxInterpStyle); a row with no good pixels at all is filled with `fallbackValue`.
+ *
+ * @param image  image to heal in place; defect boxes are interpreted in its parent coordinates
+ * @param defects  the defects to interpolate over; boxes extending outside the image are clipped
+ * @param style  interpolation style to use where enough anchor pixels are available
+ * @param nGoodPixels  maximum number of good pixels to use as anchors on each side of a bad run
+ * @param fallbackValue  value used for rows with no good pixels
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if nGoodPixels is not positive
+ */
+template <typename PixelT>
+void interpolateOverDefects(image::Image<PixelT> &image,
+                            std::vector<std::shared_ptr<image::DefectBase>> const &defects,
+                            Interpolate::Style const style = Interpolate::LINEAR, int const nGoodPixels = 4,
+                            double const fallbackValue = 0.0);
+
+/**
+ * Interpolate over a set of defects in a MaskedImage
+ *
+ * The image plane is healed as in the Image overload; every healed pixel additionally has
+ * the INTRP bit set in the mask plane.  The variance plane is left untouched.
+ */
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void interpolateOverDefects(image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> &image,
+                            std::vector<std::shared_ptr<image::DefectBase>> const &defects,
+                            Interpolate::Style const style = Interpolate::LINEAR, int const nGoodPixels = 4,
+                            double const fallbackValue = 0.0);
 }  // namespace math
 }  // namespace afw
 }  // namespace lsst
@@ -27,7 +27,10 @@
 /*
  * Declare the Kernel class and subclasses.
  */
+#include <list>
+#include <map>
 #include <memory>
+#include <tuple>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -207,6 +210,52 @@ public:
     double computeImage(lsst::afw::image::Image<Pixel> &image, bool doNormalize, double x = 0.0,
                         double y = 0.0) const;
 
+    /**
+     * The result of computeImageDeferred: an unnormalized kernel image together with its sum,
+     * plus a normalized view that is computed lazily on first request.
+     */
+    class DeferredImage final {
+    public:
+        DeferredImage(std::shared_ptr<lsst::afw::image::Image<Pixel>> image, double sum)
+                : _image(std::move(image)), _sum(sum), _normalized() {}
+
+        /// Return the unnormalized kernel image
+        std::shared_ptr<lsst::afw::image::Image<Pixel>> getImage() const { return _image; }
+
+        /// Return the sum of the unnormalized kernel image
+        double getSum() const { return _sum; }
+
+        /**
+         * Return the kernel image normalized so its sum is 1
+         *
+         * The division pass runs on the first call and the result is cached, so callers that
+         * fold the kernel sum into their own normalization never pay for it.
+         *
+         * @throws lsst::pex::exceptions::OverflowError if the kernel sum is exactly 0
+         */
+        std::shared_ptr<lsst::afw::image::Image<Pixel> const> getNormalizedImage() const;
+
+    private:
+        std::shared_ptr<lsst::afw::image::Image<Pixel>> _image;
+        double _sum;
+        mutable std::shared_ptr<lsst::afw::image::Image<Pixel>> _normalized;
+    };
+
+    /**
+     * Compute an unnormalized kernel image, deferring normalization until it is requested
+     *
+     * Equivalent to calling computeImage with doNormalize=false into a freshly allocated image,
+     * but the normalize-lazily contract is explicit: inner loops that realize a kernel per
+     * region (e.g. refreshing a LinearCombinationKernel during convolution) skip the division
+     * pass entirely unless the normalized view is actually used.
+     *
+     * @param x x (column position) at which to compute spatial function
+     * @param y y (row position) at which to compute spatial function
+     *
+     * @returns the unnormalized image and kernel sum, with a lazily-computed normalized view
+     */
+    DeferredImage computeImageDeferred(double x = 0.0, double y = 0.0) const;
+
     /**
      * Return the Kernel's dimensions (width, height)
      */
@@ -215,9 +264,16 @@ public:
     void setDimensions(lsst::geom::Extent2I dims) {
         _width = dims.getX();
         _height = dims.getY();
+        _invalidateImageCache();
+    }
+    inline void setWidth(int width) {
+        _width = width;
+        _invalidateImageCache();
+    }
+    inline void setHeight(int height) {
+        _height = height;
+        _invalidateImageCache();
     }
-    inline void setWidth(int width) { _width = width; }
-    inline void setHeight(int height) { _height = height; }
 
     /**
      * Return the Kernel's width
@@ -313,6 +369,7 @@ public:
     inline void setCtr(lsst::geom::Point2I ctr) {
         _ctrX = ctr.getX();
         _ctrY = ctr.getY();
+        _invalidateImageCache();
         _setKernelXY();
     }
 
@@ -353,6 +410,7 @@ public:
         for (unsigned int ii = 0; ii < nParams; ++ii) {
             this->setKernelParameter(ii, params[ii]);
         }
+        _invalidateImageCache();
     }
 
     /**
@@ -364,6 +422,7 @@ public:
     inline void setKernelParameters(std::pair<double, double> const &params) {
         this->setKernelParameter(0, params.first);
         this->setKernelParameter(1, params.second);
+        _invalidateImageCache();
     }
 
     /**
@@ -403,6 +462,42 @@ public:
      */
     virtual int getCacheSize() const { return 0; };
 
+    /**
+     * Set the size of the kernel image cache used by computeImage
+     *
+     * When enabled, computeImage keeps the most recently realized kernel images in an LRU cache
+     * keyed by the quantized spatial position and the normalization flag, so callers that request
+     * near-identical kernel images many times (e.g. difference imaging) pay for each realization once.
+     * Positions are quantized on a grid whose spacing is set by setImageCachePositionQuantum, and a
+     * cached image is evaluated at the center of its grid cell, so cached results do not depend on
+     * the order of the requests.
+     *
+     * The cache is discarded whenever the kernel's parameters, spatial parameters, center or
+     * dimensions change.
+     *
+     * @param cacheSize maximum number of cached kernel images (0, the default, disables the cache)
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if cacheSize is negative
+     *
+     * @note AnalyticKernel::computeImage accepts oversized images and bypasses this cache.
+     */
+    void setImageCacheSize(int cacheSize);
+
+    /// Return the maximum number of entries in the kernel image cache (0 if caching is disabled)
+    int getImageCacheSize() const { return _imageCacheSize; }
+
+    /**
+     * Set the spacing of the grid on which the kernel image cache quantizes spatial positions
+     *
+     * @param quantum grid spacing in pixels; positions closer than this share a cache entry
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if quantum is not positive
+     */
+    void setImageCachePositionQuantum(double quantum);
+
+    /// Return the position quantum of the kernel image cache, in pixels
+    double getImageCachePositionQuantum() const { return _imageCachePositionQuantum; }
+
 #if 0  // fails to compile with icc; is it actually used?
         virtual void toFile(std::string fileName) const;
 #endif
@@ -456,6 +551,29 @@ private:
     int _ctrY;
     unsigned int _nKernelParams;
 
+    //
+    // Cache of realized kernel images, keyed by quantized spatial position and the normalization
+    // flag (see setImageCacheSize).  Mutable because computeImage is const.
+    //
+    typedef std::tuple<long, long, bool> ImageCacheKey;
+    struct ImageCacheEntry {
+        ImageCacheKey key;
+        std::shared_ptr<lsst::afw::image::Image<Pixel>> image;
+        double sum;
+    };
+    mutable std::list<ImageCacheEntry> _imageCacheLru;  // most recently used entry at the front
+    mutable std::map<ImageCacheKey, std::list<ImageCacheEntry>::iterator> _imageCacheMap;
+    int _imageCacheSize;
+    double _imageCachePositionQuantum;
+
+    /// Discard all cached kernel images
+    void _invalidateImageCache() const {
+        if (!_imageCacheMap.empty()) {
+            _imageCacheMap.clear();
+            _imageCacheLru.clear();
+        }
+    }
+
     // Set the Kernel's ideas about the x- and y- coordinates
     virtual void _setKernelXY() {}
 };
@@ -840,6 +958,9 @@ private:
     KernelList _kernelList;  ///< basis kernels
     /// image of each basis kernel (a cache)
     std::vector<std::shared_ptr<lsst::afw::image::Image<Pixel>>> _kernelImagePtrList;
+    /// basis kernel images packed pixel-major across bases, i.e. element [pixel*nBases + basis];
+    /// this transposed layout makes the per-pixel blend in doComputeImage a contiguous dot product
+    std::vector<double> _packedBasisImages;
     std::vector<double> _kernelSumList;  ///< sum of each basis kernel (a cache)
     mutable std::vector<double> _kernelParams;
     bool _isDeltaFunctionBasis;
@@ -999,10 +1120,13 @@ private:
     mutable std::vector<double> _kernelX;  // used by SeparableKernel::basicComputeVectors
     mutable std::vector<double> _kernelY;
     //
-    // Cached values of the row- and column- kernels
+    // Cached values of the row- and column- kernels, with the sum of each cached vector
+    // precomputed so that basicComputeVectors need not re-accumulate it on every call
     //
     mutable std::vector<std::vector<double>> _kernelRowCache;
     mutable std::vector<std::vector<double>> _kernelColCache;
+    mutable std::vector<double> _kernelRowCacheSums;
+    mutable std::vector<double> _kernelColCacheSums;
 
     virtual void _setKernelXY() override {
         lsst::geom::Extent2I const dim = getDimensions();
@@ -68,6 +68,8 @@ class LeastSquares final {
 public:
     class Impl;  ///< Private implementation; forward-declared publicly so we can inherit from it in .cc
 
+    class Accumulator;  ///< Incremental builder for the terms of the normal equations; defined below.
+
     enum Factorization {
         NORMAL_EIGENSYSTEM, /**<
                              *   Use the normal equations with a symmetric Eigensystem decomposition.
@@ -193,6 +195,50 @@ public:
         _factor(true);
     }
 
+    /**
+     *  Reset only the right-hand side of the normal equations, reusing the current factorization.
+     *
+     *  The factorization depends only on the design (or Fisher) matrix, so solving the same
+     *  matrix against many right-hand sides only requires back-substitution.  Unlike the
+     *  set* methods above, this method does not refactor: after calling it, getSolution()
+     *  costs only the back-substitution.  The cached covariance, Fisher matrix, rank, and
+     *  diagnostics are all unaffected.
+     *
+     *  @throws pex::exceptions::LogicError  Thrown if the factorization is DIRECT_SVD (which
+     *      solves directly from the data vector rather than the RHS of the normal equations),
+     *      or if no matrix has been set and factored yet.
+     *  @throws pex::exceptions::InvalidParameterError  Thrown if the size of the given vector
+     *      does not match the dimension of the solver.
+     */
+    template <typename T1, int C1>
+    void setRhsVector(ndarray::Array<T1, 1, C1> const& rhs) {
+        _getRhsVector() = ndarray::asEigenMatrix(rhs).template cast<double>();
+        _setRhs();
+    }
+
+    /// Reset only the right-hand side of the normal equations, given as an Eigen object.
+    template <typename D1>
+    void setRhsVector(Eigen::MatrixBase<D1> const& rhs) {
+        _getRhsVector() = rhs.template cast<double>();
+        _setRhs();
+    }
+
+    /**
+     *  Solve the normal equations for many right-hand sides at once, reusing the factorization.
+     *
+     *  Each row of `rhs` is one right-hand side vector of the normal equations (i.e. one
+     *  @f$A^T b@f$), and each row of the returned array is the corresponding solution; the
+     *  factorization computed by the last set* call is reused for all of them, so each
+     *  solution costs only a back-substitution.  The RHS vector and cached solution of the
+     *  solver itself are not modified.
+     *
+     *  @throws pex::exceptions::LogicError  Thrown if the factorization is DIRECT_SVD, or if
+     *      no matrix has been set and factored yet.
+     *  @throws pex::exceptions::InvalidParameterError  Thrown if the number of columns of
+     *      `rhs` does not match the dimension of the solver.
+     */
+    ndarray::Array<double, 2, 2> solve(ndarray::Array<double const, 2, 2> const& rhs);
+
     /**
      *  Set the threshold used to determine when to truncate Eigenvalues.
      *
@@ -335,8 +381,123 @@ private:
     // will not be computed until they are first requested.
     void _factor(bool haveNormalEquations);
 
+    // Validate the RHS vector just assigned by setRhsVector and mark the cached solution
+    // stale without touching the factorization.
+    void _setRhs();
+
     std::shared_ptr<Impl> _impl;
 };
+
+/**
+ *  Incremental builder for the terms of the normal equations.
+ *
+ *  The Fisher matrix @f$A^T A@f$ and RHS vector @f$A^T b@f$ are sums over
+ *  observations, so streaming fits can accumulate them one (weighted) row at
+ *  a time and never materialize the design matrix.  Single observations are
+ *  applied as symmetric rank-1 updates; addObservations applies a whole block
+ *  as one rank-k update, which is the cache- and SIMD-friendly way to feed
+ *  large problems.
+ *
+ *  Only the lower triangle of the Fisher matrix is accumulated; it is
+ *  symmetrized when the solver (or getFisherMatrix) is asked for it.  The
+ *  accumulator can be reused across fits via reset(), and can refresh an
+ *  existing solver in place via updateSolver(), reusing its workspace instead
+ *  of allocating a new one per fit.
+ */
+class LeastSquares::Accumulator final {
+public:
+    /**
+     *  Create an empty accumulator for the given number of parameters.
+     *
+     *  @throws pex::exceptions::InvalidParameterError  Thrown if `dimension`
+     *      is not positive.
+     */
+    explicit Accumulator(int dimension);
+
+    /// Return the number of parameters.
+    int getDimension() const noexcept { return static_cast<int>(_rhs.size()); }
+
+    /// Return the number of observations accumulated since construction or the last reset().
+    std::size_t getCount() const noexcept { return _count; }
+
+    /**
+     *  Add a single observation: one row of the (implicit) design matrix and
+     *  its data value.
+     *
+     *  @param[in] row     Design matrix row; size must equal getDimension().
+     *  @param[in] value   Data value for this observation.
+     *  @param[in] weight  Inverse-variance weight; must be non-negative.
+     *
+     *  @throws pex::exceptions::InvalidParameterError  Thrown if the row size
+     *      does not match the dimension or the weight is negative.
+     */
+    void addObservation(ndarray::Array<double const, 1> const& row, double value, double weight = 1.0);
+
+    /**
+     *  Add a block of observations as a single rank-k update.
+     *
+     *  @param[in] rows    One design matrix row per row; the second dimension
+     *                     must equal getDimension().
+     *  @param[in] values  Data values, one per row.
+     *
+     *  @throws pex::exceptions::InvalidParameterError  Thrown on any
+     *      dimension mismatch.
+     */
+    void addObservations(ndarray::Array<double const, 2> const& rows,
+                         ndarray::Array<double const, 1> const& values);
+
+    /**
+     *  Add a block of weighted observations as a single rank-k update.
+     *
+     *  @param[in] rows    One design matrix row per row; the second dimension
+     *                     must equal getDimension().
+     *  @param[in] values  Data values, one per row.
+     *  @param[in] weights Inverse-variance weights, one per row; all must be
+     *                     non-negative.
+     *
+     *  @throws pex::exceptions::InvalidParameterError  Thrown on any
+     *      dimension mismatch or a negative weight.
+     */
+    void addObservations(ndarray::Array<double const, 2> const& rows,
+                         ndarray::Array<double const, 1> const& values,
+                         ndarray::Array<double const, 1> const& weights);
+
+    /// Discard the accumulated terms, keeping the dimension (and allocations).
+    void reset();
+
+    /// Return a newly-allocated (symmetrized) copy of the accumulated Fisher matrix.
+    ndarray::Array<double, 2, 2> getFisherMatrix() const;
+
+    /// Return a newly-allocated copy of the accumulated RHS vector.
+    ndarray::Array<double, 1, 1> getRhsVector() const;
+
+    /**
+     *  Construct a solver from the accumulated normal equations.
+     *
+     *  @throws pex::exceptions::LogicError  Thrown if no observations have
+     *      been accumulated.
+     */
+    LeastSquares makeSolver(Factorization factorization = NORMAL_EIGENSYSTEM) const;
+
+    /**
+     *  Load the accumulated normal equations into an existing solver,
+     *  refactoring in its workspace.
+     *
+     *  @throws pex::exceptions::InvalidParameterError  Thrown if the solver's
+     *      dimension does not match.
+     *  @throws pex::exceptions::LogicError  Thrown if no observations have
+     *      been accumulated.
+     */
+    void updateSolver(LeastSquares& solver) const;
+
+private:
+    void _checkNotEmpty() const;
+
+    Eigen::MatrixXd _fisher;  // only the lower triangle is accumulated
+    Eigen::VectorXd _rhs;
+    std::size_t _count;
+};
+
 }  // namespace math
 }  // namespace afw
 }  // namespace lsst
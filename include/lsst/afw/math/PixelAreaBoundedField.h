@@ -55,6 +55,12 @@ public:
      *  @param[in] unit      Angular unit that is used (squared) for the fields
      *                       values.
      *  @param[in] scaling   Factor all field values should be scaled by.
+     *  @param[in] gridSpacing  If positive, sample the pixel area once on a
+     *                       lattice with this spacing (in pixels) and evaluate
+     *                       by bicubic interpolation in that grid, instead of
+     *                       going through the WCS for every point.  Zero (the
+     *                       default) evaluates exactly.  See makeGridded for
+     *                       choosing a spacing that satisfies an error bound.
      *
      *  @throw pex::exception::InvalidParameterError  Thrown if `skyWcs` is
      *      null.
@@ -63,7 +69,40 @@ public:
         lsst::geom::Box2I const &bbox,
         std::shared_ptr<geom::SkyWcs const> skyWcs,
         lsst::geom::AngleUnit const & unit = lsst::geom::radians,
-        double scaling = 1.0
+        double scaling = 1.0,
+        int gridSpacing = 0
+    );
+
+    /**
+     *  Create a gridded PixelAreaBoundedField whose interpolation error is
+     *  within a given tolerance.
+     *
+     *  The pixel area is sampled on successively finer lattices, starting
+     *  from `maxGridSpacing`, until bicubic interpolation at the cell centres
+     *  (the worst case) reproduces the exact values to `maxRelativeError`, or
+     *  the spacing drops below 16 pixels, in which case an exact-evaluation
+     *  field is returned.  The grid is built once per WCS, up front; after
+     *  that every evaluation is a table lookup.
+     *
+     *  @param[in] bbox      Pixel bounding box over which the WCS is valid.
+     *  @param[in] skyWcs    WCS that maps pixels to and from sky coordinates.
+     *  @param[in] maxRelativeError  Maximum allowed relative error of
+     *                       interpolated values with respect to exact ones.
+     *  @param[in] unit      Angular unit that is used (squared) for the fields
+     *                       values.
+     *  @param[in] scaling   Factor all field values should be scaled by.
+     *  @param[in] maxGridSpacing  Coarsest lattice spacing to try, in pixels.
+     *
+     *  @throw pex::exception::InvalidParameterError  Thrown if `skyWcs` is
+     *      null or `maxRelativeError` is not positive.
+     */
+    static std::shared_ptr<PixelAreaBoundedField> makeGridded(
+        lsst::geom::Box2I const &bbox,
+        std::shared_ptr<geom::SkyWcs const> skyWcs,
+        double maxRelativeError = 1e-8,
+        lsst::geom::AngleUnit const & unit = lsst::geom::radians,
+        double scaling = 1.0,
+        int maxGridSpacing = 1024
     );
 
     ~PixelAreaBoundedField() override = default;
@@ -80,6 +119,16 @@ public:
     ndarray::Array<double, 1, 1> evaluate(ndarray::Array<double const, 1> const & x,
                                           ndarray::Array<double const, 1> const & y) const override;
 
+    /// @copydoc BoundedField::evaluate(ndarray::Array<double const, 1> const &x, ndarray::Array<double const, 1> const &y, ndarray::Array<double, 1, 1> const &out) const
+    void evaluate(ndarray::Array<double const, 1> const & x, ndarray::Array<double const, 1> const & y,
+                  ndarray::Array<double, 1, 1> const & out) const override;
+
+    using BoundedField::evaluate;
+
+    /// Return the lattice spacing of the interpolation grid, or 0 if this
+    /// field evaluates exactly.
+    int getGridSpacing() const noexcept { return _gridSpacing; }
+
     /// PixelAreaBoundedField is persistable if and only if the nested SkyWcs
     /// is.
     bool isPersistable() const noexcept override;
@@ -100,8 +149,23 @@ private:
 
     std::string toString() const override;
 
+    // Exact evaluation through the WCS, used directly when _gridSpacing is
+    // zero and to sample the grid when it is not.
+    void _evaluateExact(ndarray::Array<double const, 1> const & x,
+                        ndarray::Array<double const, 1> const & y,
+                        ndarray::Array<double, 1, 1> const & out) const;
+
+    // Bicubic interpolation of the precomputed grid at a single point.
+    double _evaluateGrid(lsst::geom::Point2D const & position) const;
+
+    // Sample the pixel area on the lattice implied by _gridSpacing.
+    void _buildGrid();
+
     std::shared_ptr<geom::SkyWcs const> _skyWcs;
     double _scaling;
+    int _gridSpacing;
+    lsst::geom::Point2I _gridOrigin;       // pixel position of grid node (0, 0)
+    ndarray::Array<double, 2, 2> _grid;    // sampled areas, [grid y][grid x]
 };
 
 }  // namespace math
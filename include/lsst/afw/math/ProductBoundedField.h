@@ -62,6 +62,15 @@ public:
     ndarray::Array<double, 1, 1> evaluate(ndarray::Array<double const, 1> const& x,
                                           ndarray::Array<double const, 1> const& y) const override;
 
+    /**
+     *  @copydoc BoundedField::evaluate(ndarray::Array<double const, 1> const& x, ndarray::Array<double const, 1> const& y, ndarray::Array<double, 1, 1> const& out) const
+     *
+     *  All factors are evaluated into at most one reused scratch buffer and multiplied
+     *  into the output in a single pass, so no per-factor allocations are made.
+     */
+    void evaluate(ndarray::Array<double const, 1> const& x, ndarray::Array<double const, 1> const& y,
+                  ndarray::Array<double, 1, 1> const& out) const override;
+
     using BoundedField::evaluate;
 
     /**
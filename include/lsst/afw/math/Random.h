@@ -88,6 +88,11 @@ public:
         TAUS2,
         /** A fifth-order multiple recursive generator by L'Ecuyer, Blouin, and Coutre. */
         GFSR4,
+        /** A counter-based generator using the Philox 4x32 algorithm with 10 rounds
+           (Salmon et al. 2011). Unlike the other algorithms, its output is a pure function
+           of a counter and a key, so independent streams can be derived deterministically;
+           see split(). */
+        PHILOX,
         /** Number of supported algorithms */
         NUM_ALGORITHMS
     };
@@ -140,6 +145,29 @@ public:
      */
     Random deepCopy() const;
 
+    /**
+     * Creates a random number generator on an independent stream of this generator.
+     *
+     * Only the counter-based Random::PHILOX algorithm supports stream splitting.  The
+     * returned generator uses the same key (i.e. the same seed) as this one, but draws
+     * from the stream identified by `streamIndex`; generators split from the same seed
+     * with different stream indices produce statistically independent sequences, and the
+     * sequence produced by a given (seed, streamIndex) pair does not depend on how many
+     * variates have been drawn from this generator or from any other stream.  This makes
+     * it possible to hand one stream to each block of a parallel calculation and obtain
+     * results that do not depend on the number of threads.
+     *
+     * @param[in] streamIndex   identifier of the stream to draw from
+     * @returns  a generator positioned at the beginning of the given stream
+     *
+     * @note A freshly constructed PHILOX generator draws from stream 0, so `split(0)`
+     *       replays the parent's sequence from the beginning.
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError
+     *      Thrown if this generator does not use the Random::PHILOX algorithm.
+     */
+    Random split(unsigned long streamIndex) const;
+
     //@{
     /**
      *  Accessors for the opaque state of the random number generator.
@@ -327,10 +355,37 @@ void randomFlatImage(ImageT *image, Random &rand, double const a, double const b
  *
  * @param[out] image The image to set
  * @param[in, out] rand definition of random number algorithm, seed, etc.
+ *
+ * @note The deviates are generated a block at a time with the Box-Muller transform,
+ *       which consumes exactly two uniform draws per pair of pixels; the values are
+ *       therefore not the same ones that per-pixel calls to Random::gaussian()
+ *       (which uses the ziggurat algorithm) would produce.
  */
 template <typename ImageT>
 void randomGaussianImage(ImageT *image, Random &rand);
 
+/**
+ * Set image to random numbers with a gaussian N(0, 1) distribution, using one
+ * split stream per row so that the result can be computed in parallel
+ *
+ * Each row of the image is filled from its own stream of `rand` (see Random::split),
+ * with the block of streams used by a call selected by a single draw from `rand`
+ * itself.  The resulting image is therefore a deterministic function of the seed and
+ * of the sequence of calls made on `rand`, and is identical for every value of
+ * `numThreads`; it is not, however, the same image that the serial overload above
+ * would produce.
+ *
+ * @param[out] image The image to set
+ * @param[in, out] rand definition of random number algorithm, seed, etc.;
+ *                 must use the Random::PHILOX algorithm
+ * @param[in] numThreads number of threads to fill the image with
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError
+ *      Thrown if `rand` does not use the Random::PHILOX algorithm.
+ */
+template <typename ImageT>
+void randomGaussianImage(ImageT *image, Random &rand, int numThreads);
+
 /**
  * Set image to random numbers with a chi^2_{nu} distribution
  *
@@ -421,9 +421,24 @@ public:
 
     /**
      * Insert a candidate into the correct cell
+     *
+     * The cell is found by direct arithmetic on the cell grid, so insertion costs
+     * O(log nCandidatesPerCell) rather than a linear scan over the cells.
      */
     void insertCandidate(std::shared_ptr<SpatialCellCandidate> candidate);
 
+    /**
+     * Return all the Candidates whose centres lie in a bounding box
+     *
+     * Only the cells that overlap bbox are examined, so the query cost scales with the
+     * area of bbox rather than with the total number of cells or candidates.
+     *
+     * @param bbox Region of the image to search
+     * @param ignoreBad Omit BAD candidates?
+     */
+    SpatialCell::CandidateList findCandidatesIn(lsst::geom::Box2I const& bbox,
+                                                bool ignoreBad = true) const;
+
     /// Rearrange the Candidates in all SpatialCells to reflect their current ratings
     void sortCandidates();
 
@@ -485,8 +500,15 @@ public:
     void setIgnoreBad(bool ignoreBad);
 
 private:
+    /// Return the cell containing point, or a null pointer if point lies outside the region
+    std::shared_ptr<SpatialCell> _lookupCell(lsst::geom::Point2I const& point) const;
+
     lsst::geom::Box2I _region;  // Bounding box of overall image
-    CellList _cellList;         // List of SpatialCells
+    CellList _cellList;         // List of SpatialCells; cell (ix, iy) is element iy*_nx + ix
+    int _xSize;                 // size of cells in the column direction
+    int _ySize;                 // size of cells in the row direction
+    int _nx;                    // number of cells in the column direction
+    int _ny;                    // number of cells in the row direction
 };
 }  // namespace math
 }  // namespace afw
@@ -27,6 +27,7 @@
 /*
  * Functions to stack images
  */
+#include <functional>
 #include <vector>
 #include "lsst/afw/image/Image.h"
 #include "lsst/afw/image/Mask.h"
@@ -154,6 +155,44 @@ void statisticsStack(lsst::afw::image::MaskedImage<PixelT>& out,  ///< Output im
                      image::MaskPixel excuse = 0    ///< bitmask to excuse from marking as clipped
 );
 
+/**
+ * Type of the callback used by the streaming overload of statisticsStack
+ *
+ * The callback is handed the index of an input (`0 <= imageIndex < numImages`) and a strip
+ * bounding box in the output's parent coordinates, and must return a MaskedImage with exactly
+ * the strip's dimensions holding that input's pixels for the strip (a deep read or a subimage
+ * view are both fine).
+ */
+template <typename PixelT>
+using StackStripReader = std::function<std::shared_ptr<lsst::afw::image::MaskedImage<PixelT>>(
+        int imageIndex, lsst::geom::Box2I const& stripBox)>;
+
+/**
+ * Compute a statistical stack of MaskedImages supplied in row strips by a reader callback
+ *
+ * Use this when the full stack of inputs does not fit in memory: the output is processed in
+ * horizontal strips of `stripHeight` rows and the reader is asked for the matching strip of
+ * every input, so only one strip per input need be resident at a time (FITS readers can supply
+ * such strips without reading whole HDUs).  Each pixel stack is measured exactly as in the
+ * all-in-memory overloads, so the results (including MEANCLIP and MEDIAN) are identical.
+ *
+ * @param[out] out          Output MaskedImage.
+ * @param[in] reader        Callback supplying strip `stripBox` of input `imageIndex`.
+ * @param[in] numImages     Number of inputs to stack.
+ * @param[in] flags         Statistics requested.
+ * @param[in] sctrl         Control structure.
+ * @param[in] wvector       Vector of weights, one per input (or empty).
+ * @param[in] clipped       Bitmask to set if any input was clipped or masked.
+ * @param[in] excuse        Bitmask to excuse from marking as clipped.
+ * @param[in] stripHeight   Number of output rows per strip.
+ */
+template <typename PixelT>
+void statisticsStack(lsst::afw::image::MaskedImage<PixelT>& out, StackStripReader<PixelT> const& reader,
+                     int numImages, Property flags, StatisticsControl const& sctrl = StatisticsControl(),
+                     std::vector<lsst::afw::image::VariancePixel> const& wvector =
+                             std::vector<lsst::afw::image::VariancePixel>(0),
+                     image::MaskPixel clipped = 0, image::MaskPixel excuse = 0, int stripHeight = 64);
+
 /**
  * A function to compute some statistics of a stack of std::vectors
  */
@@ -51,6 +51,9 @@ class Image;
 template <typename, typename, typename>
 class MaskedImage;
 }  // namespace image
+namespace geom {
+class SpanSet;
+}  // namespace geom
 namespace math {
 template <typename>
 class MaskedVector;  // forward declaration
@@ -109,6 +112,8 @@ public:
               _isNanSafe(isNanSafe),
               _useWeights(useWeights),
               _calcErrorFromInputVariance(false),
+              _numThreads(1),
+              _quantileTolerance(0.0),
               _maskPropagationThresholds() {
         try {
             _noGoodPixelsMask = lsst::afw::image::Mask<>::getPlaneBitMask("NO_DATA");
@@ -138,6 +143,10 @@ public:
     bool getWeighted() const noexcept { return _useWeights == WEIGHTS_TRUE ? true : false; }
     bool getWeightedIsSet() const noexcept { return _useWeights != WEIGHTS_NONE ? true : false; }
     bool getCalcErrorFromInputVariance() const noexcept { return _calcErrorFromInputVariance; }
+    /// Return the number of threads used to accumulate pixel statistics
+    int getNumThreads() const noexcept { return _numThreads; }
+    /// Return the absolute tolerance for histogram-based quantile estimates (0 = exact)
+    double getQuantileTolerance() const noexcept { return _quantileTolerance; }
 
     void setNumSigmaClip(double numSigmaClip) {
         assert(numSigmaClip > 0);
@@ -154,6 +163,33 @@ public:
     void setCalcErrorFromInputVariance(bool calcErrorFromInputVariance) noexcept {
         _calcErrorFromInputVariance = calcErrorFromInputVariance;
     }
+    /**
+     * Set the number of threads used to accumulate pixel statistics
+     *
+     * Each thread accumulates one horizontal band of rows and the per-band partial sums are
+     * then merged in band order (this includes the accumulation performed by each
+     * sigma-clipping iteration).  Because the merge changes the order of floating-point
+     * summation, results obtained with more than one thread can differ from the serial
+     * results at the level of rounding error.  The default is 1 (serial).
+     */
+    void setNumThreads(int numThreads) {
+        assert(numThreads > 0);
+        _numThreads = numThreads;
+    }
+    /**
+     * Set the absolute tolerance (in pixel units) for median and quantile estimates
+     *
+     * When the tolerance is positive, MEDIAN, IQRANGE and the quartiles that seed the first
+     * sigma-clipping iteration are estimated from a fixed-bin histogram which is refined in
+     * streaming passes until the bin width is at most the tolerance, instead of copying every
+     * unmasked pixel into a vector and partially sorting it.  The estimate differs from the
+     * exact interpolated quantile by at most the tolerance.  The default, 0, keeps the exact
+     * sorting path.
+     */
+    void setQuantileTolerance(double quantileTolerance) {
+        assert(quantileTolerance >= 0);
+        _quantileTolerance = quantileTolerance;
+    }
 
 private:
     friend class Statistics;
@@ -165,6 +201,8 @@ private:
     bool _isNanSafe;                   // Check for NaNs & Infs before running (slower)
     WeightsBoolean _useWeights;        // Calculate weighted statistics (enum because of 3-valued logic)
     bool _calcErrorFromInputVariance;  // Calculate errors from the input variances, if available
+    int _numThreads;                   // Number of row bands to accumulate concurrently
+    double _quantileTolerance;         // Tolerance for histogram-based quantiles (0 = exact)
     std::vector<double> _maskPropagationThresholds;  // Thresholds for when to propagate mask bits,
                                                      // treated like a dict (unset bits are set to 1.0)
 };
@@ -315,6 +353,71 @@ private:
                       int const flags, StatisticsControl const &sctrl);
 };
 
+/**
+ * An incremental accumulator for the basic (unclipped, unweighted) image statistics
+ *
+ * Accumulates NPOINT, SUM, MEAN, VARIANCE, MIN, MAX and the or-mask of the pixels it has
+ * seen, one region at a time, so rolling statistics over sequences of subregions need not
+ * rebuild a Statistics object from scratch for every region:
+ *
+ *     lsst::afw::math::StatisticsAccumulator accum(sctrl);
+ *     accum += subImage;                  // an Image, MaskedImage or std::vector<double>
+ *     accum.merge(otherAccum);            // e.g. a partial computed on another node
+ *     double const mean = accum.getMean();
+ *
+ * Only the andMask and nanSafe fields of the control are used.  Weighted statistics and the
+ * order statistics (MEDIAN, IQRANGE and the clipped quantities) cannot be updated
+ * incrementally and remain the province of Statistics itself.
+ *
+ * The sums are kept relative to the first accumulated value — the same crude-mean trick
+ * Statistics uses for numerical stability — and merge() re-centers the incoming partial
+ * sums, so merging accumulators built from disjoint regions matches accumulating the union.
+ */
+class StatisticsAccumulator final {
+public:
+    explicit StatisticsAccumulator(StatisticsControl const &sctrl = StatisticsControl());
+
+    /// Accumulate every pixel of an image; only non-finite pixels are rejected (if nanSafe)
+    template <typename Pixel>
+    StatisticsAccumulator &operator+=(lsst::afw::image::Image<Pixel> const &img);
+    /// Accumulate a masked image, rejecting pixels that match the control's andMask
+    template <typename Pixel>
+    StatisticsAccumulator &operator+=(lsst::afw::image::MaskedImage<Pixel> const &mimg);
+    /// Accumulate a span of scalar values
+    StatisticsAccumulator &operator+=(std::vector<double> const &values);
+
+    /// Fold another accumulator into this one, as if its pixels had been accumulated here
+    void merge(StatisticsAccumulator const &other);
+
+    /// Return the number of pixels accumulated
+    int getN() const noexcept { return _n; }
+    /// Return the sum of the accumulated pixels
+    double getSum() const noexcept;
+    /// Return the mean of the accumulated pixels (NaN if none have been accumulated)
+    double getMean() const noexcept;
+    /// Return the debiased sample variance (NaN for fewer than two pixels)
+    double getVariance() const noexcept;
+    /// Return the sample standard deviation (NaN for fewer than two pixels)
+    double getStdev() const noexcept;
+    /// Return the minimum accumulated pixel (NaN if none have been accumulated)
+    double getMin() const noexcept;
+    /// Return the maximum accumulated pixel (NaN if none have been accumulated)
+    double getMax() const noexcept;
+    /// Return the bitwise OR of the masks of the accumulated pixels
+    lsst::afw::image::MaskPixel getOrMask() const noexcept { return _allPixelOrMask; }
+
+private:
+    StatisticsControl _sctrl;                     // only andMask and nanSafe are used
+    bool _hasOffset;                              // has _offset been anchored to a pixel value?
+    double _offset;                               // all sums are relative to this value
+    int _n;                                       // number of pixels accumulated
+    double _sumx;                                 // sum(value - _offset)
+    double _sumx2;                                // sum((value - _offset)^2)
+    double _min;                                  // minimum accumulated value
+    double _max;                                  // maximum accumulated value
+    lsst::afw::image::MaskPixel _allPixelOrMask;  // the 'or' of the accumulated pixels' masks
+};
+
 /* ************************************  The factory functions ********************************* */
 /**
  * @brief This iterator will never increment.  It is returned by row_begin() in the MaskImposter class
@@ -428,6 +531,42 @@ Statistics makeStatistics(
     return Statistics(img, msk, var, flags, sctrl);
 }
 
+/**
+ * The makeStatistics() overload to handle the pixels of an Image that lie in a SpanSet
+ *
+ * The spans are iterated in place -- each span is one contiguous run of pixels -- so no
+ * flattened copy of the footprint is made.  The SpanSet must lie wholly inside the image.
+ *
+ * @param img Image whose properties we want
+ * @param spans SpanSet (e.g. a Footprint's) selecting the pixels to include
+ * @param flags Describe what we want to calculate
+ * @param sctrl Control how things are calculated
+ *
+ * @relatesalso Statistics
+ */
+template <typename Pixel>
+Statistics makeStatistics(lsst::afw::image::Image<Pixel> const &img, lsst::afw::geom::SpanSet const &spans,
+                          int const flags, StatisticsControl const &sctrl = StatisticsControl());
+
+/**
+ * The makeStatistics() overload to handle the pixels of a MaskedImage that lie in a SpanSet
+ *
+ * As for the Image overload, but the MaskedImage's mask plane rejects pixels (via
+ * StatisticsControl::setAndMask) and its variance plane is used if weighted statistics or
+ * errors from the input variance are requested.
+ *
+ * @param mimg MaskedImage whose properties we want
+ * @param spans SpanSet (e.g. a Footprint's) selecting the pixels to include
+ * @param flags Describe what we want to calculate
+ * @param sctrl Control how things are calculated
+ *
+ * @relatesalso Statistics
+ */
+template <typename Pixel>
+Statistics makeStatistics(lsst::afw::image::MaskedImage<Pixel> const &mimg,
+                          lsst::afw::geom::SpanSet const &spans, int const flags,
+                          StatisticsControl const &sctrl = StatisticsControl());
+
 /**
  * @brief A vector wrapper to provide a vector with the necessary methods and typedefs to
  *        be processed by Statistics as though it were an Image.
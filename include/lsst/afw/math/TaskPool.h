@@ -0,0 +1,195 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#if !defined(LSST_AFW_MATH_TASKPOOL_H)
+#define LSST_AFW_MATH_TASKPOOL_H
+/*
+ * A process-wide work-stealing thread pool shared by the multithreaded
+ * code paths in afw::math
+ */
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace lsst {
+namespace afw {
+namespace math {
+
+struct TaskGroupState;  // implementation detail, defined in TaskPool.cc
+
+/**
+ * A process-wide pool of worker threads with work stealing.
+ *
+ * Every multithreaded code path in afw::math (convolution bands, warping,
+ * stacking, statistics) submits its work here instead of spawning its own
+ * threads, so concurrent callers share one set of workers and cannot
+ * oversubscribe the machine.  The per-call `numThreads` controls still choose
+ * how finely each operation is subdivided; this pool bounds how much of it
+ * actually runs at once.
+ *
+ * Each worker owns a double-ended task queue: it pops its own newest task
+ * first (for cache locality) and steals the oldest task from another worker
+ * when its own queue is empty.  Tasks are grouped with TaskGroup, which
+ * provides fork/join semantics and exception propagation.
+ *
+ * The pool is lazy: no threads exist until the first task is submitted, and
+ * the size and thread affinity may be configured (once per process) any time
+ * before that.
+ */
+class TaskPool final {
+public:
+    /**
+     * A set of tasks that are submitted together and waited on together.
+     *
+     * The group does not own threads; it tracks completion of the tasks run
+     * through it on the (shared) pool.  If any task throws, the first
+     * exception is rethrown from wait().  The destructor waits for any
+     * remaining tasks, discarding their exceptions, so a group can never
+     * outlive the references its tasks capture.
+     */
+    class TaskGroup final {
+    public:
+        /// Create a group that submits to the process-wide pool.
+        TaskGroup();
+        /// Create a group that submits to the given pool.
+        explicit TaskGroup(TaskPool &pool);
+
+        TaskGroup(TaskGroup const &) = delete;
+        TaskGroup(TaskGroup &&) = delete;
+        TaskGroup &operator=(TaskGroup const &) = delete;
+        TaskGroup &operator=(TaskGroup &&) = delete;
+
+        ~TaskGroup();
+
+        /**
+         * Submit a task for asynchronous execution.
+         *
+         * The task may run on any worker thread, or on the thread that calls
+         * wait() while it is helping to drain the queues.
+         */
+        void run(std::function<void()> task);
+
+        /**
+         * Wait for every task submitted to this group to finish.
+         *
+         * While tasks remain queued the calling thread executes them itself
+         * rather than blocking, so a task that creates and waits on its own
+         * group cannot deadlock the pool.  The first exception thrown by any
+         * task of this group is rethrown here.
+         */
+        void wait();
+
+    private:
+        TaskPool &_pool;
+        std::shared_ptr<TaskGroupState> _state;
+    };
+
+    /// Return the single process-wide pool.
+    static TaskPool &getInstance();
+
+    TaskPool(TaskPool const &) = delete;
+    TaskPool(TaskPool &&) = delete;
+    TaskPool &operator=(TaskPool const &) = delete;
+    TaskPool &operator=(TaskPool &&) = delete;
+
+    /// Return the number of worker threads the pool has, or will start with.
+    int getNumThreads() const;
+
+    /**
+     * Set the number of worker threads.
+     *
+     * The default is the hardware concurrency.  May only be called before
+     * the first task is submitted.
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if numThreads < 1
+     * @throws lsst::pex::exceptions::LogicError if the workers have started
+     */
+    void setNumThreads(int numThreads);
+
+    /// Return whether worker threads will be pinned to CPUs.
+    bool getAffinity() const;
+
+    /**
+     * Set whether to pin each worker thread to a CPU (round-robin).
+     *
+     * Pinning helps NUMA locality for long-running pipelines at the cost of
+     * flexibility when the process shares the machine.  Only honored on
+     * platforms with thread affinity support (a no-op elsewhere), and may
+     * only be called before the first task is submitted.
+     *
+     * @throws lsst::pex::exceptions::LogicError if the workers have started
+     */
+    void setAffinity(bool pin);
+
+private:
+    struct Task {
+        std::function<void()> func;
+        std::shared_ptr<TaskGroupState> group;
+    };
+
+    struct Worker {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    TaskPool();
+    ~TaskPool();
+
+    /// Start the worker threads; caller must hold _configMutex.
+    void _start();
+    /// Queue a task, starting the workers on first use.
+    void _submit(Task task);
+    /// Pop a task (own queue first, then steal); `self` >= worker count for non-workers.
+    bool _popTask(std::size_t self, Task &task);
+    /// Execute one queued task on the calling thread, if any is available.
+    bool _tryRunOneTask();
+    /// Run a task, routing exceptions and completion to its group.
+    static void _runTask(Task task);
+    void _workerMain(std::size_t index);
+
+    mutable std::mutex _configMutex;  // guards configuration and startup
+    int _numThreads;
+    bool _pinThreads;
+    bool _started;
+
+    std::vector<std::unique_ptr<Worker>> _workers;
+    std::vector<std::thread> _threads;
+    std::atomic<std::size_t> _submitIndex;
+    std::atomic<std::size_t> _numQueued;
+    std::mutex _sleepMutex;  // guards _stop and worker sleep/wake
+    std::condition_variable _workAvailable;
+    bool _stop;
+};
+
+}  // namespace math
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // LSST_AFW_MATH_TASKPOOL_H
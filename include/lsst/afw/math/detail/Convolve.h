@@ -148,6 +148,28 @@ void convolveWithBruteForce(OutImageT& convolvedImage, InImageT const& inImage,
                             lsst::afw::math::Kernel const& kernel,
                             lsst::afw::math::ConvolutionControl const& convolutionControl);
 
+/**
+ * Convolve in Fourier space if the control parameters ask for it and the inputs allow it.
+ *
+ * The FFT algorithm is used when the control's algorithm is CONVOLUTION_FFT, or is
+ * CONVOLUTION_AUTO and the kernel area is above the direct/FFT crossover; it requires a
+ * spatially invariant kernel and plain floating-point images. Forward and inverse FFTW
+ * plans are cached per padded image size, so repeated convolutions of same-size images
+ * pay the planning cost once.
+ *
+ * @param[out] convolvedImage convolved %image; only the fully-convolved region is written
+ * @param[in] inImage %image to convolve
+ * @param[in] kernel convolution kernel
+ * @param[in] convolutionControl convolution control parameters
+ * @returns true if the convolution was performed, false if the caller must use a direct algorithm
+ *
+ * @warning Low-level convolution function that does not set edge pixels.
+ */
+template <typename OutImageT, typename InImageT>
+bool tryConvolveWithFFT(OutImageT& convolvedImage, InImageT const& inImage,
+                        lsst::afw::math::Kernel const& kernel,
+                        lsst::afw::math::ConvolutionControl const& convolutionControl);
+
 // I would prefer this to be nested in KernelImagesForRegion but SWIG doesn't support that
 class RowOfKernelImagesForRegion;
 
@@ -271,6 +293,27 @@ public:
      * row.
      */
     bool computeNextRow(RowOfKernelImagesForRegion& regionRow) const;
+    /**
+     * Divide the region into nx by ny subregions, computing all corner kernel images in parallel
+     *
+     * The decomposition matches computeNextRow, but every subregion is returned at once with its
+     * four corner kernel images already computed; adjacent subregions share their common corner
+     * images. The images are evaluated across numThreads threads, each using its own clone of the
+     * kernel (computing the image of a spatially varying kernel sets the kernel's current
+     * parameters, so one kernel cannot be shared between threads). The returned subregions are
+     * never modified by this object afterwards, unlike the ones recycled by computeNextRow.
+     *
+     * @param nx number of columns of subregions
+     * @param ny number of rows of subregions
+     * @param numThreads number of threads across which to divide the kernel image computation
+     * @returns a list of subregions in row-major order (bottom row first)
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if numThreads < 1
+     * @throws lsst::pex::exceptions::InvalidParameterError if nx > region width or ny > region
+     * height
+     */
+    std::vector<std::shared_ptr<KernelImagesForRegion>> precomputeSubregions(int nx, int ny,
+                                                                             int numThreads) const;
 
     /**
      * Get the minInterpolationSize class constant
@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "lsst/afw/math/Kernel.h"
+#include "lsst/afw/math/warpExposure.h"
 #include "lsst/afw/image/Image.h"
 #include "lsst/afw/image/MaskedImage.h"
 #include "lsst/geom/Point.h"
@@ -45,6 +46,15 @@ public:
               _kernelPtr(control.getWarpingKernel()),
               _maskKernelPtr(control.getMaskWarpingKernel()),
               _hasMaskKernel(control.getMaskWarpingKernel()),
+              _fastLanczosKernelPtr(
+                      _kernelPtr->getCacheSize() == 0
+                              ? std::dynamic_pointer_cast<lsst::afw::math::LanczosWarpingKernel>(_kernelPtr)
+                              : std::shared_ptr<lsst::afw::math::LanczosWarpingKernel>()),
+              _fastLanczosMaskKernelPtr(
+                      _maskKernelPtr && _maskKernelPtr->getCacheSize() == 0
+                              ? std::dynamic_pointer_cast<lsst::afw::math::LanczosWarpingKernel>(
+                                        _maskKernelPtr)
+                              : std::shared_ptr<lsst::afw::math::LanczosWarpingKernel>()),
               _kernelCtr(_kernelPtr->getCtr()),
               _maskKernelCtr(_maskKernelPtr ? _maskKernelPtr->getCtr() : lsst::geom::Point2I(0, 0)),
               _growFullMask(control.getGrowFullMask()),
@@ -175,15 +185,28 @@ private:
     /**
      * Set parameters of kernel (and mask kernel, if present) and update X and Y values
      *
+     * Uncached Lanczos kernels are evaluated through the closed-form
+     * LanczosWarpingKernel::computeLanczosVectors, which avoids the per-tap sine
+     * calls of the generic Function1 path.
+     *
      * @returns sum of kernel
      */
     double _setFracIndex(double xFrac, double yFrac) {
         std::pair<double, double> srcFracInd(xFrac, yFrac);
-        _kernelPtr->setKernelParameters(srcFracInd);
-        double kSum = _kernelPtr->computeVectors(_xList, _yList, false);
+        double kSum;
+        if (_fastLanczosKernelPtr) {
+            kSum = _fastLanczosKernelPtr->computeLanczosVectors(_xList, _yList, xFrac, yFrac);
+        } else {
+            _kernelPtr->setKernelParameters(srcFracInd);
+            kSum = _kernelPtr->computeVectors(_xList, _yList, false);
+        }
         if (_maskKernelPtr) {
-            _maskKernelPtr->setKernelParameters(srcFracInd);
-            _maskKernelPtr->computeVectors(_maskXList, _maskYList, false);
+            if (_fastLanczosMaskKernelPtr) {
+                _fastLanczosMaskKernelPtr->computeLanczosVectors(_maskXList, _maskYList, xFrac, yFrac);
+            } else {
+                _maskKernelPtr->setKernelParameters(srcFracInd);
+                _maskKernelPtr->computeVectors(_maskXList, _maskYList, false);
+            }
         }
         return kSum;
     }
@@ -192,6 +215,8 @@ private:
     std::shared_ptr<lsst::afw::math::SeparableKernel> _kernelPtr;
     std::shared_ptr<lsst::afw::math::SeparableKernel> _maskKernelPtr;
     bool _hasMaskKernel;
+    std::shared_ptr<lsst::afw::math::LanczosWarpingKernel> _fastLanczosKernelPtr;
+    std::shared_ptr<lsst::afw::math::LanczosWarpingKernel> _fastLanczosMaskKernelPtr;
     lsst::geom::Point2I _kernelCtr;
     lsst::geom::Point2I _maskKernelCtr;
     lsst::afw::image::MaskPixel _growFullMask;
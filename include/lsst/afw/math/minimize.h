@@ -60,10 +60,14 @@ public:
  * @param varianceList variance for each measurement
  * @param xPositionList x position of each measurement
  * @param errorDef what is this?
+ * @param numThreads maximum number of chunks the chi squared sum is evaluated in;
+ *                   chunks run concurrently on the shared afw::math thread pool
  * @returns true if minimum is valid, false otherwise
  *
  * Uses the Minuit fitting package with a standard definition of chiSq
- * (see MinimizerFunctionBase1).
+ * (see MinimizerFunctionBase1).  The objective caches its value, so the
+ * repeated evaluations Minuit makes at an unchanged parameter vector cost
+ * nothing.
  *
  * @throws lsst::pex::exceptions::InvalidParameterError if any input vector is the wrong length
  *
@@ -76,7 +80,7 @@ template <typename ReturnT>
 FitResults minimize(lsst::afw::math::Function1<ReturnT> const &function,
                     std::vector<double> const &initialParameterList, std::vector<double> const &stepSizeList,
                     std::vector<double> const &measurementList, std::vector<double> const &varianceList,
-                    std::vector<double> const &xPositionList, double errorDef);
+                    std::vector<double> const &xPositionList, double errorDef, int numThreads = 1);
 
 /**
  * Find the minimum of a function(x, y)
@@ -92,6 +96,8 @@ FitResults minimize(lsst::afw::math::Function1<ReturnT> const &function,
  * @param xPositionList x position of each measurement
  * @param yPositionList y position of each measurement
  * @param errorDef what is this?
+ * @param numThreads maximum number of chunks the chi squared sum is evaluated in;
+ *                   chunks run concurrently on the shared afw::math thread pool
  * @returns true if minimum is valid, false otherwise
  *
  * @throws lsst::pex::exceptions::InvalidParameterError if any input vector is the wrong length
@@ -106,7 +112,7 @@ FitResults minimize(lsst::afw::math::Function2<ReturnT> const &function,
                     std::vector<double> const &initialParameterList, std::vector<double> const &stepSizeList,
                     std::vector<double> const &measurementList, std::vector<double> const &varianceList,
                     std::vector<double> const &xPositionList, std::vector<double> const &yPositionList,
-                    double errorDef);
+                    double errorDef, int numThreads = 1);
 }  // namespace math
 }  // namespace afw
 }  // namespace lsst
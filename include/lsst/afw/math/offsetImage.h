@@ -23,6 +23,9 @@
 #if !defined(LSST_AFW_MATH_OFFSETIMAGE_H)
 #define LSST_AFW_MATH_OFFSETIMAGE_H 1
 
+#include <string>
+#include <vector>
+
 #include "lsst/afw/image/MaskedImage.h"
 #include "lsst/afw/math/Statistics.h"
 
@@ -51,6 +54,60 @@ namespace math {
 template <typename ImageT>
 std::shared_ptr<ImageT> offsetImage(ImageT const& image, float dx, float dy,
                                     std::string const& algorithmName = "lanczos5", unsigned int buffer = 0);
+/**
+ * A reusable engine for shifting images by a fixed sub-pixel offset.
+ *
+ * offsetImage() builds a warping kernel and a full convolution setup on every
+ * call, which dominates the cost when many small stamps are shifted.
+ * SubpixelOffset instead computes the separable 1-d shift kernels once, at
+ * construction, and apply() runs the two convolution passes through an
+ * internal row ring buffer, so repeated calls on same-sized images perform no
+ * per-call heap allocation and may write their output over the input.
+ *
+ * apply() reproduces offsetImage() for offsets in (-1, 1): interior pixels are
+ * the separable convolution with the shift kernel and edge pixels, where the
+ * kernel overhangs the image, are copied from the input (the doCopyEdge
+ * behaviour of the convolution in offsetImage).  As in offsetImage, the image
+ * origin (XY0) is not changed for such offsets.
+ */
+template <typename PixelT>
+class SubpixelOffset final {
+public:
+    /**
+     * Construct an engine to shift images by (dx, dy)
+     *
+     * @param dx move images this far in the column direction
+     * @param dy move images this far in the row direction
+     * @param algorithmName Type of resampling kernel to use, as for offsetImage
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if dx or dy is outside (-1, 1)
+     *         or the algorithm is invalid
+     */
+    SubpixelOffset(double dx, double dy, std::string const& algorithmName = "lanczos5");
+
+    /**
+     * Shift inImage into outImage
+     *
+     * @param[out] outImage image to fill; must have the same dimensions as inImage,
+     *             and may be the very same image (in-place shift)
+     * @param[in] inImage image to shift
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if the dimensions differ
+     * @throws lsst::pex::exceptions::LengthError if the image is smaller than the kernel
+     *
+     * @note The ring buffer is per-instance scratch space, so a single SubpixelOffset
+     * must not be applied concurrently from several threads.
+     */
+    void apply(image::Image<PixelT>& outImage, image::Image<PixelT> const& inImage);
+
+private:
+    std::vector<double> _kernelX;            ///< 1-d shift kernel along columns
+    std::vector<double> _kernelY;            ///< 1-d shift kernel along rows
+    lsst::geom::Point2I _ctr;                ///< kernel centre, in kernel pixels
+    std::vector<std::vector<double>> _ring;  ///< ring buffer of x-convolved rows
+    std::vector<double const*> _rows;        ///< per-call view of the ring in kernel order
+};
+
 /**
  * Rotate an image by an integral number of quarter turns
  *
@@ -69,6 +126,22 @@ std::shared_ptr<ImageT> rotateImageBy90(ImageT const& image, int nQuarter);
  */
 template <typename ImageT>
 std::shared_ptr<ImageT> flipImage(ImageT const& inImage, bool flipLR, bool flipTB);
+
+/**
+ * Transpose an image, so that its columns become the rows of the result
+ *
+ * Column-wise algorithms (overscan corrections, pattern-noise fits) stride a
+ * full row pitch per pixel when run in place, which thrashes the cache on
+ * wide images.  The transpose is blocked into cache-resident tiles, so
+ * transposing, running the algorithm row-major, and transposing back is much
+ * faster than walking the columns directly.
+ *
+ * As with rotateImageBy90, xy0 is not propagated to the (transposed) output.
+ *
+ * @param inImage The %image to transpose
+ */
+template <typename ImageT>
+std::shared_ptr<ImageT> transposeImage(ImageT const& inImage);
 /**
  * @param inImage The %image to bin
  * @param binX Output pixels are binX*binY input pixels
@@ -78,6 +151,27 @@ std::shared_ptr<ImageT> flipImage(ImageT const& inImage, bool flipLR, bool flipT
 template <typename ImageT>
 std::shared_ptr<ImageT> binImage(ImageT const& inImage, int const binX, int const binY,
                                  lsst::afw::math::Property const flags = lsst::afw::math::MEAN);
+/**
+ * Bin an image, reducing each bin with a statistic.
+ *
+ * @param inImage The %image to bin
+ * @param binX Output pixels are binX*binY input pixels
+ * @param binY Output pixels are binX*binY input pixels
+ * @param flags how to reduce each bin; one of MEAN, MEDIAN, or MEANCLIP
+ * @param sctrl control how the statistic is calculated; in particular, for
+ *              MaskedImages pixels whose mask intersects `sctrl.getAndMask()`
+ *              are excluded from the reduction
+ * @param numThreads number of threads to reduce bins with
+ *
+ * For MaskedImages the output mask is the bitwise OR of the masks of the
+ * unmasked pixels in each bin, and the variance plane is propagated assuming
+ * an unweighted mean of those pixels.  Bins with no unmasked pixels are set
+ * to NaN with the OR of all of their pixels' masks.
+ */
+template <typename ImageT>
+std::shared_ptr<ImageT> binImage(ImageT const& inImage, int const binX, int const binY,
+                                 lsst::afw::math::Property const flags, StatisticsControl const& sctrl,
+                                 int numThreads = 1);
 /**
  * @param inImage The %image to bin
  * @param binsize Output pixels are binsize*binsize input pixels
@@ -29,8 +29,10 @@
 #ifndef LSST_AFW_MATH_WARPEXPOSURE_H
 #define LSST_AFW_MATH_WARPEXPOSURE_H
 
+#include <limits>
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "lsst/base.h"
 #include "lsst/pex/exceptions.h"
@@ -83,8 +85,40 @@ public:
      */
     int getOrder() const;
 
+    /**
+     * Compute the column and row vectors for a fractional pixel offset, without normalization
+     *
+     * Equivalent to setting the kernel parameters to (xFrac, yFrac) and calling computeVectors
+     * with doNormalize false, but evaluates the Lanczos function in closed form: the kernel taps
+     * of one axis lie at integer offsets from the fractional position, so sin(pi (k - frac)) is
+     * +/-sin(pi frac) for every tap and sin(pi (k - frac) / n) follows from one sin/cos pair via
+     * the angle-sum identity. One sine and one sin/cos pair per axis replace the two sine
+     * evaluations per tap made through the Function1 interface, and the loop over taps
+     * vectorizes. This is the hot path of warpImage; see detail::WarpAtOnePoint.
+     *
+     * @returns the sum of the kernel (the product of the column and row sums)
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if colList or rowList is the wrong size
+     */
+    double computeLanczosVectors(std::vector<double> &colList, std::vector<double> &rowList, double xFrac,
+                                 double yFrac) const;
+
 protected:
     void setKernelParameter(unsigned int ind, double value) const override;
+
+private:
+    /// @internal Per-tap sin/cos of pi k / n, where k = tap index - kernel center;
+    /// rebuilt by computeLanczosVectors if the center moves.
+    struct TapTable {
+        int ctr = std::numeric_limits<int>::min();
+        std::vector<double> sinPiKInvN;
+        std::vector<double> cosPiKInvN;
+    };
+
+    void _setTapTable(TapTable &table, int size, int ctr) const;
+
+    mutable TapTable _colTapTable;
+    mutable TapTable _rowTapTable;
 };
 
 /**
@@ -247,6 +281,65 @@ std::shared_ptr<SeparableKernel> makeWarpingKernel(std::string name);
  *
  * @ingroup afw
  */
+/**
+ * Precomputed destination-to-source pixel mapping that can be replayed across warps.
+ *
+ * When several images sharing one visit geometry are warped onto the same destination grid
+ * (e.g. the g/r/i/z/y exposures of a visit onto one coadd patch), the source position and
+ * relative pixel area of every destination pixel are identical from warp to warp, yet
+ * warpImage recomputes them each time. Attach a WarpMappingCache to a WarpingControl to
+ * record the mapping on the first warp and replay it on subsequent warps, which then skip
+ * the transform evaluation entirely and reduce to pure resampling.
+ *
+ * The cache is keyed on the destination image's parent bounding box; warping a destination
+ * image with a different bounding box re-records the mapping. The source-to-destination
+ * transform itself cannot be cheaply compared, so it is the caller's responsibility to reuse
+ * the cache only with the same transform. The recorded positions reflect the interpLength
+ * in effect when they were recorded.
+ */
+class WarpMappingCache final {
+public:
+    WarpMappingCache() = default;
+
+    WarpMappingCache(WarpMappingCache const &) = delete;
+    WarpMappingCache &operator=(WarpMappingCache const &) = delete;
+
+    /// Return true if the cache holds a complete mapping for the given destination bounding box.
+    bool matches(lsst::geom::Box2I const &bbox) const { return _isValid && bbox == _bbox; }
+
+    /// Discard any recorded mapping and prepare to record one for the given destination bounding box.
+    void reset(lsst::geom::Box2I const &bbox) {
+        _bbox = bbox;
+        _isValid = false;
+        std::size_t const numPixels = static_cast<std::size_t>(bbox.getArea());
+        _srcPositions.clear();
+        _srcPositions.reserve(numPixels);
+        _relativeAreas.clear();
+        _relativeAreas.reserve(numPixels);
+    }
+
+    /// Record the mapping for the next destination pixel, in row-major order.
+    void append(lsst::geom::Point2D const &srcPos, double relativeArea) {
+        _srcPositions.push_back(srcPos);
+        _relativeAreas.push_back(relativeArea);
+    }
+
+    /// Declare the recorded mapping complete, enabling replay.
+    void markValid() { _isValid = true; }
+
+    /// Get the recorded source position of each destination pixel, in row-major order.
+    std::vector<lsst::geom::Point2D> const &getSrcPositions() const { return _srcPositions; }
+
+    /// Get the recorded relative pixel area of each destination pixel, in row-major order.
+    std::vector<double> const &getRelativeAreas() const { return _relativeAreas; }
+
+private:
+    lsst::geom::Box2I _bbox;
+    bool _isValid = false;
+    std::vector<lsst::geom::Point2D> _srcPositions;
+    std::vector<double> _relativeAreas;
+};
+
 class WarpingControl {
 public:
     /**
@@ -266,14 +359,16 @@ public:
             int cacheSize = 0,  ///< cache size for warping kernel; no cache if 0
             ///< (used as the argument to the warping kernels' computeCache method)
             int interpLength = 0,  ///< distance over which the WCS can be linearly interpolated
-            lsst::afw::image::MaskPixel growFullMask = 0
+            lsst::afw::image::MaskPixel growFullMask = 0,
             ///< mask bits to grow to full width of image/variance kernel
+            int numThreads = 1  ///< number of threads used to warp; see setNumThreads
             )
             : _warpingKernelPtr(makeWarpingKernel(warpingKernelName)),
               _maskWarpingKernelPtr(),
               _cacheSize(cacheSize),
               _interpLength(interpLength),
-              _growFullMask(growFullMask) {
+              _growFullMask(growFullMask),
+              _numThreads(numThreads) {
         setMaskWarpingKernelName(maskWarpingKernelName);
     }
 
@@ -373,6 +468,41 @@ public:
         _growFullMask = growFullMask;
     }
 
+    /**
+     * get the number of threads used to warp
+     */
+    int getNumThreads() const { return _numThreads; }
+
+    /**
+     * set the number of threads used to warp
+     *
+     * If greater than 1 the destination image is divided into that many horizontal bands,
+     * which are warped concurrently. Each thread uses a private clone of the warping kernel(s),
+     * because evaluating a kernel sets its parameters in place. A value of 1 (the default)
+     * warps serially on the calling thread.
+     */
+    void setNumThreads(int numThreads  ///< number of threads
+    ) {
+        _numThreads = numThreads;
+    }
+
+    /**
+     * get the warp mapping cache; may be null
+     */
+    std::shared_ptr<WarpMappingCache> getWarpMappingCache() const { return _warpMappingCachePtr; }
+
+    /**
+     * set or clear (with null) the warp mapping cache
+     *
+     * See WarpMappingCache for the sharing rules; in particular the cache may only be reused
+     * for warps with the same source-to-destination transform and destination bounding box.
+     * The cache is not used when warping with more than one thread.
+     */
+    void setWarpMappingCache(std::shared_ptr<WarpMappingCache> warpMappingCache  ///< warp mapping cache
+    ) {
+        _warpMappingCachePtr = std::move(warpMappingCache);
+    }
+
 private:
     /**
      * Throw an exception if the two kernels are not compatible in shape
@@ -389,6 +519,8 @@ private:
     int _cacheSize;
     int _interpLength;
     lsst::afw::image::MaskPixel _growFullMask;
+    int _numThreads;
+    std::shared_ptr<WarpMappingCache> _warpMappingCachePtr;
 };
 
 /**
@@ -410,6 +542,46 @@ int warpExposure(
         ///< use this value for undefined (edge) pixels
 );
 
+/**
+ * One destination stamp for warpExposureBatch: a parent bounding box and the WCS of the stamp.
+ */
+struct StampWarpRequest final {
+    StampWarpRequest(lsst::geom::Box2I const &bbox_, std::shared_ptr<geom::SkyWcs const> wcs_)
+            : bbox(bbox_), wcs(std::move(wcs_)) {}
+
+    lsst::geom::Box2I bbox;                   ///< parent bounding box of the destination stamp
+    std::shared_ptr<geom::SkyWcs const> wcs;  ///< WCS of the destination stamp
+};
+
+/**
+ * Warp one source exposure onto many postage stamps.
+ *
+ * Equivalent to constructing an exposure for each request and calling warpExposure on it,
+ * but the per-call setup is paid once for the whole batch: the source pixels, WCS and
+ * calibration metadata are captured up front and shared by every stamp, and the stamps are
+ * processed by a pool of WarpingControl::getNumThreads() worker threads pulling from a
+ * shared queue, each owning private clones of the warping kernels. This is intended for
+ * workloads that warp many small cutouts against one exposure, e.g. forced photometry.
+ *
+ * Each stamp's PhotoCalib, Filter and VisitInfo are copied from srcExposure, as for
+ * warpExposure.
+ *
+ * @returns the warped stamps, in request order
+ *
+ * @throws lsst::pex::exceptions::InvalidParameterError if srcExposure or any request has no Wcs
+ */
+template <typename DestExposureT, typename SrcExposureT>
+std::vector<std::shared_ptr<DestExposureT>> warpExposureBatch(
+        SrcExposureT const &srcExposure,             ///< Source exposure
+        std::vector<StampWarpRequest> const &requests,  ///< destination stamps to warp
+        WarpingControl const &control,               ///< control parameters
+        typename DestExposureT::MaskedImageT::SinglePixel padValue =
+                lsst::afw::math::edgePixel<typename DestExposureT::MaskedImageT>(
+                        typename lsst::afw::image::detail::image_traits<
+                                typename DestExposureT::MaskedImageT>::image_category())
+        ///< use this value for undefined (edge) pixels
+);
+
 /**
  * @brief Warp an Image or MaskedImage to a new Wcs. See also convenience function
  * warpExposure() to warp an Exposure.
@@ -504,6 +676,76 @@ int warpCenteredImage(
         ///< use this value for undefined (edge) pixels
 );
 
+/**
+ * Running weighted accumulation of warped images, for building coadds in O(one patch) memory.
+ *
+ * The usual coadd build warps every input into its own patch-sized MaskedImage and stacks
+ * them afterwards with statisticsStack, holding all of the warps in memory at once.
+ * A CoaddAccumulator instead folds each input into running per-pixel totals as soon as it
+ * is warped: the weighted sum of values, the sum of weights, the weighted sum of variances
+ * and the OR of the mask planes. One patch-sized scratch image is allocated at construction
+ * and reused as the warp destination for every input, so memory stays independent of the
+ * number of inputs.
+ *
+ * Warped pixels whose mask intersects badPixelMask, and edge pixels (which warpImage pads
+ * with non-finite values), are excluded from the totals. getCoadd() returns the weighted
+ * mean; pixels that accumulated no data are set to NaN with the NO_DATA mask bit.
+ */
+template <typename PixelT>
+class CoaddAccumulator final {
+public:
+    typedef lsst::afw::image::MaskedImage<PixelT, lsst::afw::image::MaskPixel,
+                                          lsst::afw::image::VariancePixel>
+            MaskedImageT;
+
+    /**
+     * Construct an empty accumulator for a destination patch
+     *
+     * @param bbox parent bounding box of the coadd patch
+     * @param badPixelMask mask bits that exclude a warped pixel from the accumulation
+     */
+    explicit CoaddAccumulator(lsst::geom::Box2I const &bbox, lsst::afw::image::MaskPixel badPixelMask = 0);
+
+    /**
+     * Warp one source image onto the patch and fold it into the running totals
+     *
+     * @param srcImage source image
+     * @param srcToDest transformation from source to destination pixels, in parent coordinates;
+     *     makeWcsPairTransform(srcWcs, destWcs) is one way to compute this transform
+     * @param control warping parameters
+     * @param weight weight of this input in the coadd; must be positive
+     * @returns the number of pixels accumulated
+     *
+     * @throws lsst::pex::exceptions::InvalidParameterError if weight is not positive
+     */
+    int accumulate(MaskedImageT const &srcImage, geom::TransformPoint2ToPoint2 const &srcToDest,
+                   WarpingControl const &control, double weight = 1.0);
+
+    /**
+     * Return the weighted mean of the accumulated inputs
+     *
+     * The variance plane is the sum of weight^2 * variance divided by the squared sum of weights;
+     * the mask plane is the OR of the masks of all accumulated pixels. Pixels with no
+     * accumulated data have value NaN, infinite variance and the NO_DATA mask bit set.
+     */
+    MaskedImageT getCoadd() const;
+
+    /// Get the parent bounding box of the coadd patch
+    lsst::geom::Box2I getBBox() const { return _bbox; }
+
+    /// Get the mask bits that exclude a warped pixel from the accumulation
+    lsst::afw::image::MaskPixel getBadPixelMask() const { return _badPixelMask; }
+
+private:
+    lsst::geom::Box2I _bbox;
+    lsst::afw::image::MaskPixel _badPixelMask;
+    lsst::afw::image::Image<double> _sumValue;     // sum of weight * value
+    lsst::afw::image::Image<double> _sumVariance;  // sum of weight^2 * variance
+    lsst::afw::image::Image<double> _sumWeight;    // sum of weights
+    lsst::afw::image::Mask<lsst::afw::image::MaskPixel> _orMask;  // OR of accumulated masks
+    MaskedImageT _scratch;  // reusable warp destination
+};
+
 }  // namespace math
 }  // namespace afw
 }  // namespace lsst
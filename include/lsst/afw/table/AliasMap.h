@@ -3,7 +3,9 @@
 #define AFW_TABLE_AliasMap_h_INCLUDED
 
 #include <map>
+#include <mutex>
 #include <string>
+#include <unordered_map>
 
 namespace lsst {
 namespace afw {
@@ -49,8 +51,9 @@ public:
     // Delegate to copy-constructor for backwards compatibility
     AliasMap(AliasMap&& other) : AliasMap(other) {}
 
-    AliasMap& operator=(AliasMap const&) = default;
-    AliasMap& operator=(AliasMap&&) = default;
+    AliasMap& operator=(AliasMap const& other);
+    // Delegate to copy-assignment for backwards compatibility
+    AliasMap& operator=(AliasMap&& other) { return *this = other; }
     ~AliasMap() = default;
 
     /// An iterator over alias->target pairs.
@@ -128,6 +131,14 @@ private:
 
     Internal _internal;
 
+    // Cache of names already resolved by apply(), cleared whenever an alias is set or
+    // erased.  Schema looks up every name through apply(), so repeated name-based access
+    // (e.g. in per-record loops) would otherwise redo the replacement walk every time.
+    // Guarded by _cacheMutex, since apply() is const and Schemas (and hence their
+    // AliasMaps) are routinely shared across threads.
+    mutable std::unordered_map<std::string, std::string> _cache;
+    mutable std::mutex _cacheMutex;
+
     // Table to notify of any changes.  We can't use a shared_ptr here because the Table needs to set
     // this in its own constructor, but the Table does guarantee that this pointer is either valid or
     // null.
@@ -126,6 +126,30 @@ public:
      */
     BitsColumn getAllBits() const;
 
+    /**
+     *  Return the values of a Flag field packed into bits, 64 records per word.
+     *
+     *  Record i corresponds to bit (i % 64) of word (i / 64); bits past the last record
+     *  are zero.  This is the transposed counterpart of getBits (one flag across all
+     *  records rather than all flags of one record): packed words can be combined with
+     *  bitwise operators 64 records at a time, and the result fed to selectRecords.
+     */
+    ndarray::Array<std::uint64_t, 1, 1> packBits(Key<Flag> const& key) const;
+
+    /**
+     *  Return the indices of records for which every Flag in `mustBeSet` is set and
+     *  every Flag in `mustBeClear` is clear.
+     *
+     *  Either vector may be empty; if both are, all indices are returned.  The flag
+     *  columns are combined as packed bitmasks (see packBits), so rejecting flagged
+     *  sources from a large catalog costs a few bitwise operations per 64 records
+     *  plus output proportional to the number of survivors, instead of a per-record
+     *  predicate evaluation.  The result can be used directly as a fancy index on
+     *  the arrays returned by operator[].
+     */
+    ndarray::Array<std::size_t, 1, 1> selectRecords(std::vector<Key<Flag> > const& mustBeSet,
+                                                    std::vector<Key<Flag> > const& mustBeClear) const;
+
     /**
      *  Construct a BaseColumnView from an iterator range.
      *
@@ -9,6 +9,7 @@
 #include "lsst/afw/table/Schema.h"
 #include "lsst/afw/table/BaseTable.h"
 #include "lsst/afw/table/FunctorKey.h"
+#include "lsst/afw/table/detail/RecordArena.h"
 
 namespace lsst {
 namespace afw {
@@ -225,6 +226,11 @@ private:
 
 template <typename RecordT, typename ...Args>
 std::shared_ptr<RecordT> BaseTable::constructRecord(Args && ...args) {
+    if (_recordArena) {
+        return std::allocate_shared<RecordT>(detail::RecordArenaAllocator<RecordT>(_recordArena),
+                                             BaseRecord::ConstructionToken(0), _makeNewRecordData(),
+                                             std::forward<Args>(args)...);
+    }
     return std::make_shared<RecordT>(BaseRecord::ConstructionToken(0), _makeNewRecordData(),
                                      std::forward<Args>(args)...);
 }
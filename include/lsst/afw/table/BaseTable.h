@@ -2,6 +2,7 @@
 #ifndef AFW_TABLE_BaseTable_h_INCLUDED
 #define AFW_TABLE_BaseTable_h_INCLUDED
 #include <memory>
+#include <vector>
 
 #include "lsst/base.h"
 #include "ndarray/Manager.h"
@@ -35,6 +36,8 @@ struct RecordData {
     ndarray::Manager::Ptr manager;
 };
 
+class RecordArena;
+
 } // namespace detail
 
 /**
@@ -107,6 +110,38 @@ public:
      */
     std::shared_ptr<BaseRecord> makeRecord() { return _makeRecord(); }
 
+    /**
+     *  Default-construct a batch of associated records with contiguous field data.
+     *
+     *  This is equivalent to calling preallocate(n) followed by n calls to makeRecord,
+     *  but in one pass: the returned records are guaranteed to have their field data
+     *  laid out contiguously in allocation order, so a catalog built from them (in
+     *  order, with no interleaved makeRecord calls on this or any table sharing its
+     *  memory blocks) supports column views without a deep copy.
+     *
+     *  The first call also sets a record arena (see setRecordArena) if the table does
+     *  not already have one, so the record objects themselves are slab-allocated and
+     *  the slabs are recycled as successive batches of records are created and
+     *  destroyed.
+     */
+    std::vector<std::shared_ptr<BaseRecord>> makeRecords(std::size_t n);
+
+    /// Return the arena used to allocate record objects themselves.  May be null.
+    std::shared_ptr<detail::RecordArena> getRecordArena() const { return _recordArena; }
+
+    /**
+     *  Set the arena used to allocate record objects themselves.  May be null.
+     *
+     *  When an arena is set, each new record object and its shared_ptr control block
+     *  are carved out of the arena's recycled slabs instead of being a separate
+     *  make_shared allocation; field data is unaffected, as it is always allocated in
+     *  blocks managed by the table itself.  Only records created after the call are
+     *  affected, and existing records keep their allocator (and hence the old arena)
+     *  alive for as long as they live.  Tables that share an arena pool their
+     *  allocations together.
+     */
+    void setRecordArena(std::shared_ptr<detail::RecordArena> arena) { _recordArena = std::move(arena); }
+
     /**
      *  Deep-copy a record, requiring that it have the same schema as this table.
      *
@@ -243,6 +278,7 @@ private:
     Schema _schema;                                      // schema that defines the table's fields
     ndarray::Manager::Ptr _manager;                      // current memory block to use for new records
     std::shared_ptr<daf::base::PropertyList> _metadata;  // flexible metadata; may be null
+    std::shared_ptr<detail::RecordArena> _recordArena;   // pool for record objects; may be null
 };
 
 }  // namespace table
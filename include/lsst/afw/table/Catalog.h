@@ -2,7 +2,10 @@
 #ifndef AFW_TABLE_Catalog_h_INCLUDED
 #define AFW_TABLE_Catalog_h_INCLUDED
 
+#include <algorithm>
 #include <type_traits>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include "boost/iterator/iterator_adaptor.hpp"
@@ -166,6 +169,7 @@ public:
         if (&other != this) {
             _table = other._table;
             _internal = other._internal;
+            _idIndex.reset();  // ID indexes are not shared or copied; see defineIdIndex()
         }
         return *this;
     }
@@ -369,6 +373,44 @@ public:
         return io::FitsReader::apply<CatalogT>(fitsfile, flags);
     }
 
+    /**
+     *  Read a contiguous range of rows of a FITS binary table from a regular file.
+     *
+     *  Only the records in [first, last) are materialized; last is clamped to the number of rows
+     *  in the table.  This allows a large catalog to be paged through chunk by chunk (e.g. for
+     *  metadata queries that touch a handful of rows) without reading it all.
+     *
+     *  @param[in] filename    Name of the file to read.
+     *  @param[in] first       Index of the first row to read.
+     *  @param[in] last        One past the index of the last row to read.
+     *  @param[in] hdu         Number of the "header-data unit" to read (where 0 is the Primary HDU).
+     *                         The default value of afw::fits::DEFAULT_HDU is interpreted as
+     *                         "the first HDU with NAXIS != 0".
+     *  @param[in] flags       Table-subclass-dependent bitflags that control the details of how to read
+     *                         the catalog.  See e.g. SourceFitsFlags.
+     */
+    static CatalogT readFitsRows(std::string const& filename, std::size_t first, std::size_t last,
+                                 int hdu = fits::DEFAULT_HDU, int flags = 0) {
+        return io::FitsReader::applyRows<CatalogT>(filename, hdu, flags, first, last);
+    }
+
+    /**
+     *  Read a contiguous range of rows of a FITS binary table from a RAM file.
+     *
+     *  @param[in] manager     Object that manages the memory to be read.
+     *  @param[in] first       Index of the first row to read.
+     *  @param[in] last        One past the index of the last row to read.
+     *  @param[in] hdu         Number of the "header-data unit" to read (where 0 is the Primary HDU).
+     *                         The default value of afw::fits::DEFAULT_HDU is interpreted as
+     *                         "the first HDU with NAXIS != 0".
+     *  @param[in] flags       Table-subclass-dependent bitflags that control the details of how to read
+     *                         the catalog.  See e.g. SourceFitsFlags.
+     */
+    static CatalogT readFitsRows(fits::MemFileManager& manager, std::size_t first, std::size_t last,
+                                 int hdu = fits::DEFAULT_HDU, int flags = 0) {
+        return io::FitsReader::applyRows<CatalogT>(manager, hdu, flags, first, last);
+    }
+
     /**
      *  Return a ColumnView of this catalog's records.
      *
@@ -387,6 +429,81 @@ public:
     /// Return true if all records are contiguous.
     bool isContiguous() const { return ColumnView::isRangeContiguous(_table, begin(), end()); }
 
+    //@{
+    /**
+     *  Copy the values of a field into a newly allocated, contiguous column array.
+     *
+     *  Unlike getColumnView, this works regardless of whether the records are
+     *  contiguous in memory, and the result has unit stride (a column view's
+     *  stride is the record size).  The result does not share memory with the
+     *  catalog; use setColumn to write modified values back.
+     *
+     *  The array-field overload requires a fixed-size array field.
+     */
+    template <typename T>
+    ndarray::Array<typename Field<T>::Value, 1, 1> copyColumn(Key<T> const& key) const {
+        ndarray::Array<typename Field<T>::Value, 1, 1> result = ndarray::allocate(size());
+        auto out = result.begin();
+        for (const_iterator iter = begin(); iter != end(); ++iter, ++out) {
+            *out = iter->get(key);
+        }
+        return result;
+    }
+
+    template <typename T>
+    ndarray::Array<T, 2, 2> copyColumn(Key<Array<T>> const& key) const {
+        if (key.isVariableLength()) {
+            throw LSST_EXCEPT(pex::exceptions::LogicError,
+                              "Cannot copy a variable-length array field as a column.");
+        }
+        ndarray::Array<T, 2, 2> result = ndarray::allocate(size(), key.getSize());
+        auto out = result.begin();
+        for (const_iterator iter = begin(); iter != end(); ++iter, ++out) {
+            *out = iter->get(key);
+        }
+        return result;
+    }
+    //@}
+
+    //@{
+    /**
+     *  Set the values of a field from a column array, one element per record.
+     *
+     *  This is the write-back counterpart of copyColumn, and like it does not
+     *  require the records to be contiguous.
+     *
+     *  @throws pex::exceptions::LengthError if the array's first dimension
+     *          does not match the catalog's size.
+     */
+    template <typename T>
+    void setColumn(Key<T> const& key, ndarray::Array<typename Field<T>::Value const, 1> const& values) {
+        _checkColumnLength(values.template getSize<0>());
+        auto in = values.begin();
+        for (iterator iter = begin(); iter != end(); ++iter, ++in) {
+            iter->set(key, *in);
+        }
+    }
+
+    template <typename T>
+    void setColumn(Key<Array<T>> const& key, ndarray::Array<T const, 2> const& values) {
+        if (key.isVariableLength()) {
+            throw LSST_EXCEPT(pex::exceptions::LogicError,
+                              "Cannot set a variable-length array field from a column.");
+        }
+        _checkColumnLength(values.template getSize<0>());
+        if (values.template getSize<1>() != key.getSize()) {
+            throw LSST_EXCEPT(pex::exceptions::LengthError,
+                              (boost::format("Array field has %d elements, while array has %d columns.") %
+                               key.getSize() % values.template getSize<1>())
+                                      .str());
+        }
+        auto in = values.begin();
+        for (iterator iter = begin(); iter != end(); ++iter, ++in) {
+            (*iter)[key] = *in;
+        }
+    }
+    //@}
+
     //@{
     /**
      *  Iterator access.
@@ -433,6 +550,7 @@ public:
 
     /// Change the size of the catalog, removing or adding empty records as needed.
     void resize(size_type n) {
+        _idIndex.reset();
         size_type old = size();
         _internal.resize(n);
         if (old < n) {
@@ -459,7 +577,10 @@ public:
     std::shared_ptr<RecordT> const get(size_type i) const { return _internal[i]; }
 
     /// Set the record at index i to a pointer.
-    void set(size_type i, std::shared_ptr<RecordT> const& p) { _internal[i] = p; }
+    void set(size_type i, std::shared_ptr<RecordT> const& p) {
+        _idIndex.reset();
+        _internal[i] = p;
+    }
 
     /**
      *  Replace the contents of the table with an iterator range.
@@ -476,20 +597,51 @@ public:
     void push_back(Record const& r) {
         std::shared_ptr<RecordT> p = _table->copyRecord(r);
         _internal.push_back(p);
+        _indexRecord(p);
     }
 
     /// Add the given record to the end of the catalog without copying.
-    void push_back(std::shared_ptr<RecordT> const& p) { _internal.push_back(p); }
+    void push_back(std::shared_ptr<RecordT> const& p) {
+        _internal.push_back(p);
+        _indexRecord(p);
+    }
 
     /// Create a new record, add it to the end of the catalog, and return a pointer to it.
     std::shared_ptr<RecordT> addNew() {
         std::shared_ptr<RecordT> r = _table->makeRecord();
         _internal.push_back(r);
+        _indexRecord(r);
         return r;
     }
 
+    /**
+     *  Create n new records in one pass and append them to the catalog.
+     *
+     *  Equivalent to calling addNew() n times, but the records' field data is carved out of a
+     *  single preallocated slab (see BaseTable::makeRecords) and the internal vector is
+     *  reserved once up front, so bulk construction does a constant number of allocations
+     *  instead of a pair per record.  A catalog that was contiguous before the call remains
+     *  contiguous afterwards.
+     *
+     *  @returns a shallow view of the appended records, sharing its table and records
+     *           with this catalog.
+     */
+    CatalogT appendRecords(size_type n) {
+        std::vector<std::shared_ptr<BaseRecord>> records = _table->makeRecords(n);
+        _internal.reserve(_internal.size() + records.size());
+        for (std::shared_ptr<BaseRecord>& record : records) {
+            std::shared_ptr<RecordT> p = std::static_pointer_cast<RecordT>(std::move(record));
+            _internal.push_back(p);
+            _indexRecord(p);
+        }
+        return CatalogT(_table, end() - n, end(), false);
+    }
+
     /// Remove the last record in the catalog
-    void pop_back() { _internal.pop_back(); }
+    void pop_back() {
+        _idIndex.reset();
+        _internal.pop_back();
+    }
 
     /// Deep-copy the catalog using a cloned table.
     CatalogT copy() const { return CatalogT(getTable()->clone(), begin(), end(), true); }
@@ -548,19 +700,27 @@ public:
     /// Insert a copy of the given record at the given position.
     iterator insert(iterator pos, Record const& r) {
         std::shared_ptr<RecordT> p = _table->copyRecord(r);
-        return iterator(_internal.insert(pos.base(), p));
+        iterator result(_internal.insert(pos.base(), p));
+        _indexRecord(p);
+        return result;
     }
 
     /// Insert the given record at the given position without copying.
     iterator insert(iterator pos, std::shared_ptr<RecordT> const& p) {
-        return iterator(_internal.insert(pos.base(), p));
+        iterator result(_internal.insert(pos.base(), p));
+        _indexRecord(p);
+        return result;
     }
 
     /// Erase the record pointed to by pos, and return an iterator the next record.
-    iterator erase(iterator pos) { return iterator(_internal.erase(pos.base())); }
+    iterator erase(iterator pos) {
+        _idIndex.reset();
+        return iterator(_internal.erase(pos.base()));
+    }
 
     /// Erase the records in the range [first, last).
     iterator erase(iterator first, iterator last) {
+        _idIndex.reset();
         return iterator(_internal.erase(first.base(), last.base()));
     }
 
@@ -568,10 +728,14 @@ public:
     void swap(CatalogT& other) noexcept {
         _table.swap(other._table);
         _internal.swap(other._internal);
+        _idIndex.swap(other._idIndex);
     }
 
     /// Remove all records from the catalog.
-    void clear() { _internal.clear(); }
+    void clear() {
+        _idIndex.reset();
+        _internal.clear();
+    }
 
     /// Return true if the catalog is in ascending order according to the given key.
     template <typename T>
@@ -597,6 +761,42 @@ public:
     template <typename Compare>
     void sort(Compare cmp);
 
+    /**
+     *  Return a shallow copy of the catalog, sorted by the field with the given key.
+     *
+     *  The returned catalog shares its records with this one, so this provides a sorted
+     *  view without moving or copying any records; only the new catalog's pointers are
+     *  permuted.
+     */
+    template <typename T>
+    CatalogT<RecordT> sorted(Key<T> const& key) const;
+
+    /**
+     *  Return a shallow copy of the catalog, sorted by the given predicate.
+     *
+     *  cmp(a, b) should return true if record a is less than record b, and false otherwise.
+     */
+    template <typename Compare>
+    CatalogT<RecordT> sorted(Compare cmp) const;
+
+    /**
+     *  Merge pre-sorted catalogs into a single sorted catalog in one streaming pass.
+     *
+     *  Each input must already be sorted in ascending order by key.  The result is what
+     *  concatenating the inputs and stable-sorting by key would produce (ties broken in favor
+     *  of the earlier input), but it is built with a k-way merge — O(total log k) time with
+     *  O(k) merge state — instead of a full re-sort of records that are already in order.
+     *
+     *  If deep is true, the merged records are copied into a cloned (and preallocated, hence
+     *  contiguous) table; otherwise the result shares its records with the inputs, like the
+     *  shallow copy constructor, and uses the first catalog's table.
+     *
+     *  @throws pex::exceptions::InvalidParameterError if catalogs is empty, if the schemas do
+     *          not all match the first catalog's, or if an input is not sorted by key.
+     */
+    template <typename T>
+    static CatalogT merged(std::vector<CatalogT> const& catalogs, Key<T> const& key, bool deep = false);
+
     //@{
     /**
      *  Return an iterator to the record with the given value.
@@ -653,6 +853,55 @@ public:
                                                           Key<T> const& key) const;
     //@}
 
+    /**
+     *  Build a hash index on the given 64-bit integer field, enabling O(1) findById()
+     *  lookups regardless of sort order.
+     *
+     *  The index covers the current contents of the catalog and is maintained
+     *  incrementally as records are added (push_back, addNew, insert), but it is
+     *  discarded by operations that remove or replace records (erase, clear, pop_back,
+     *  set, resize, assignment); call defineIdIndex() again after such operations to
+     *  re-enable findById().  The index is not transferred by the (shallow) copy
+     *  constructor or assignment.
+     *
+     *  IDs are assumed to be unique, and changing an indexed record's ID field leaves
+     *  the index stale; it is the caller's responsibility to rebuild it in that case.
+     */
+    void defineIdIndex(Key<RecordId> const& key) {
+        _idIndex = std::make_shared<IdIndex>();
+        _idIndex->key = key;
+        for (auto const& p : _internal) {
+            _idIndex->map[p->get(key)] = p;
+        }
+    }
+
+    /// Discard any hash index created by defineIdIndex().
+    void clearIdIndex() { _idIndex.reset(); }
+
+    /// Return true if a hash index is currently available for findById().
+    bool hasIdIndex() const { return static_cast<bool>(_idIndex); }
+
+    /**
+     *  Return the record with the given ID using the hash index, or null if no record
+     *  with that ID is present.
+     *
+     *  Unlike find(), this does not require the catalog to be sorted (or make any other
+     *  use of record order), but defineIdIndex() must have been called first.
+     *
+     *  @throws pex::exceptions::LogicError if no ID index is available.
+     */
+    std::shared_ptr<RecordT> findById(RecordId id) const {
+        if (!_idIndex) {
+            throw LSST_EXCEPT(pex::exceptions::LogicError,
+                              "No ID index; call defineIdIndex() before findById().");
+        }
+        auto iter = _idIndex->map.find(id);
+        if (iter == _idIndex->map.end()) {
+            return std::shared_ptr<RecordT>();
+        }
+        return iter->second;
+    }
+
     //@{
     /**
      *  Return a reference to the internal vector-of-shared_ptr
@@ -671,6 +920,15 @@ public:
     //@}
 
 private:
+    // Throw LengthError unless a column array's first dimension matches the catalog's size.
+    void _checkColumnLength(std::size_t n) const {
+        if (n != size()) {
+            throw LSST_EXCEPT(pex::exceptions::LengthError,
+                              (boost::format("Catalog has %d rows, while array has %d elements.") % size() %
+                               n).str());
+        }
+    }
+
     template <typename InputIterator>
     void _maybeReserve(iterator& pos, InputIterator first, InputIterator last, bool deep,
                        std::random_access_iterator_tag*) {
@@ -681,8 +939,22 @@ private:
     void _maybeReserve(iterator pos, InputIterator first, InputIterator last, bool deep,
                        std::input_iterator_tag*) {}
 
+    // Optional hash index for findById(); see defineIdIndex().
+    struct IdIndex {
+        Key<RecordId> key;
+        std::unordered_map<RecordId, std::shared_ptr<RecordT>> map;
+    };
+
+    // Add a newly inserted record to the ID index, if one is defined.
+    void _indexRecord(std::shared_ptr<RecordT> const& p) {
+        if (_idIndex) {
+            _idIndex->map[p->get(_idIndex->key)] = p;
+        }
+    }
+
     std::shared_ptr<Table> _table;
     Internal _internal;
+    std::shared_ptr<IdIndex> _idIndex;  // not copied by the (explicit) copy ctor/assignment
 };
 
 namespace detail {
@@ -747,8 +1019,104 @@ bool CatalogT<RecordT>::isSorted(Key<T> const& key) const {
 template <typename RecordT>
 template <typename T>
 void CatalogT<RecordT>::sort(Key<T> const& key) {
-    detail::KeyComparisonFunctor<RecordT, T> f = {key};
-    return sort(f);
+    // Extract the key column into a contiguous buffer and argsort that instead of
+    // sorting the record pointers directly, so the O(N log N) comparisons read from
+    // the buffer rather than chasing a pointer into each record.  Tagging each value
+    // with its original position (and breaking ties on it) makes the result identical
+    // to a stable sort without requiring equality comparisons on the values.
+    typedef std::pair<typename Field<T>::Value, std::size_t> IndexedValue;
+    std::vector<IndexedValue> values;
+    values.reserve(_internal.size());
+    for (std::size_t i = 0; i != _internal.size(); ++i) {
+        values.push_back(IndexedValue(_internal[i]->get(key), i));
+    }
+    std::sort(values.begin(), values.end(), [](IndexedValue const& a, IndexedValue const& b) {
+        return a.first < b.first || (!(b.first < a.first) && a.second < b.second);
+    });
+    Internal sorted;
+    sorted.reserve(_internal.size());
+    for (IndexedValue const& v : values) {
+        sorted.push_back(std::move(_internal[v.second]));
+    }
+    _internal.swap(sorted);
+}
+
+template <typename RecordT>
+template <typename T>
+CatalogT<RecordT> CatalogT<RecordT>::sorted(Key<T> const& key) const {
+    CatalogT<RecordT> result(*this);  // shallow copy; records are shared
+    result.sort(key);
+    return result;
+}
+
+template <typename RecordT>
+template <typename T>
+CatalogT<RecordT> CatalogT<RecordT>::merged(std::vector<CatalogT> const& catalogs, Key<T> const& key,
+                                            bool deep) {
+    if (catalogs.empty()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "At least one catalog is required to merge");
+    }
+    std::size_t total = 0;
+    for (std::size_t k = 0; k != catalogs.size(); ++k) {
+        if (catalogs[k].getSchema() != catalogs.front().getSchema()) {
+            throw LSST_EXCEPT(
+                    pex::exceptions::InvalidParameterError,
+                    (boost::format("Schema of catalog %d does not match the first catalog's") % k).str());
+        }
+        if (!catalogs[k].isSorted(key)) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                              (boost::format("Catalog %d is not sorted by the given key") % k).str());
+        }
+        total += catalogs[k].size();
+    }
+    std::shared_ptr<Table> table = catalogs.front().getTable();
+    if (deep) {
+        table = table->clone();
+        table->preallocate(total);  // make the copied records contiguous
+    }
+    CatalogT result(table);
+    result._internal.reserve(total);
+    // k-way merge: a min-heap of (next key value, catalog index) with one entry per
+    // non-exhausted input, breaking ties toward the earlier catalog for stability.
+    typedef std::pair<typename Field<T>::Value, std::size_t> HeapEntry;
+    auto const cmp = [](HeapEntry const& a, HeapEntry const& b) {
+        // std::*_heap build a max-heap, so invert the comparison
+        return b.first < a.first || (!(a.first < b.first) && b.second < a.second);
+    };
+    std::vector<std::size_t> positions(catalogs.size(), 0);
+    std::vector<HeapEntry> heap;
+    heap.reserve(catalogs.size());
+    for (std::size_t k = 0; k != catalogs.size(); ++k) {
+        if (!catalogs[k].empty()) {
+            heap.push_back(HeapEntry(catalogs[k].getInternal().front()->get(key), k));
+        }
+    }
+    std::make_heap(heap.begin(), heap.end(), cmp);
+    while (!heap.empty()) {
+        std::pop_heap(heap.begin(), heap.end(), cmp);
+        std::size_t const k = heap.back().second;
+        heap.pop_back();
+        std::shared_ptr<RecordT> const& p = catalogs[k].getInternal()[positions[k]];
+        if (deep) {
+            result.push_back(*p);
+        } else {
+            result.push_back(p);
+        }
+        if (++positions[k] != catalogs[k].size()) {
+            heap.push_back(HeapEntry(catalogs[k].getInternal()[positions[k]]->get(key), k));
+            std::push_heap(heap.begin(), heap.end(), cmp);
+        }
+    }
+    return result;
+}
+
+template <typename RecordT>
+template <typename Compare>
+CatalogT<RecordT> CatalogT<RecordT>::sorted(Compare cmp) const {
+    CatalogT<RecordT> result(*this);  // shallow copy; records are shared
+    result.sort(cmp);
+    return result;
 }
 
 template <typename RecordT>
@@ -73,6 +73,31 @@ class InputArchive;
 
 }  // namespace io
 
+/**
+ *  Bitflags to be passed to ExposureCatalog::readFits
+ *
+ *  Each flag skips reading one component, leaving it unset (null) on every record while the
+ *  rest of the catalog is read normally; pass the union of everything you do not need.  Skipped
+ *  components are never deserialized from the archive, and when every component is skipped
+ *  (EXPOSURE_IO_NO_COMPONENTS) the archive HDUs are not read at all, which makes extracting a
+ *  single component (e.g. the WCSs of a tract) much cheaper than a full read.
+ */
+enum ExposureFitsFlags {
+    EXPOSURE_IO_NO_PSF = 0x1,                  ///< Do not read the Psf component
+    EXPOSURE_IO_NO_WCS = 0x2,                  ///< Do not read the SkyWcs component
+    EXPOSURE_IO_NO_PHOTOCALIB = 0x4,           ///< Do not read the PhotoCalib component
+    EXPOSURE_IO_NO_APCORRMAP = 0x8,            ///< Do not read the ApCorrMap component
+    EXPOSURE_IO_NO_VALID_POLYGON = 0x10,       ///< Do not read the Polygon component
+    EXPOSURE_IO_NO_VISIT_INFO = 0x20,          ///< Do not read the VisitInfo component
+    EXPOSURE_IO_NO_TRANSMISSION_CURVE = 0x40,  ///< Do not read the TransmissionCurve component
+    EXPOSURE_IO_NO_DETECTOR = 0x80,            ///< Do not read the Detector component
+    /// Do not read any components (the archive HDUs are then not read at all)
+    EXPOSURE_IO_NO_COMPONENTS = EXPOSURE_IO_NO_PSF | EXPOSURE_IO_NO_WCS | EXPOSURE_IO_NO_PHOTOCALIB |
+                                EXPOSURE_IO_NO_APCORRMAP | EXPOSURE_IO_NO_VALID_POLYGON |
+                                EXPOSURE_IO_NO_VISIT_INFO | EXPOSURE_IO_NO_TRANSMISSION_CURVE |
+                                EXPOSURE_IO_NO_DETECTOR
+};
+
 /**
  *  Record class used to store exposure metadata.
  */
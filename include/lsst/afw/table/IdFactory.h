@@ -3,6 +3,7 @@
 #define AFW_TABLE_IdFactory_h_INCLUDED
 
 #include <memory>
+#include <vector>
 
 #include "lsst/base.h"
 #include "lsst/afw/table/misc.h"
@@ -48,6 +49,40 @@ public:
      */
     static std::shared_ptr<IdFactory> makeSource(RecordId expId, int reserved);
 
+    /**
+     *  Return a thread-safe version of the IdFactory produced by makeSource.
+     *
+     *  The returned factory generates exactly the same IDs as makeSource(expId, reserved), but
+     *  uses an atomic counter so that operator() may be called concurrently from multiple
+     *  threads.  Note that the tables that hold an IdFactory are not themselves thread-safe,
+     *  so this is only useful when a single factory is shared between tables that are each
+     *  confined to one thread.
+     */
+    static std::shared_ptr<IdFactory> makeSourceThreadSafe(RecordId expId, int reserved);
+
+    /**
+     *  Return a set of IdFactories that partition the ID space of makeSource(expId, reserved).
+     *
+     *  The reserved space is divided into contiguous blocks by carving the minimal number of
+     *  bits needed to represent nShards off the top of the reserved bits, immediately below
+     *  the packed exposure ID; shard i generates IDs of the form
+     *
+     *      (expId << reserved) | (i << (reserved - shardBits)) | sequence
+     *
+     *  The shards therefore never collide with each other, and each one is an ordinary
+     *  unsynchronized factory: give one shard to each worker thread (and its thread-local
+     *  table) to construct catalogs fully in parallel.
+     *
+     *  @param[in] expId     ID to include in the upper bits via a bitwise OR.
+     *  @param[in] reserved  How many bits to reserve for the part of the ID that is unique.
+     *  @param[in] nShards   Number of factories to return.
+     *
+     *  @throws lsst::pex::exceptions::InvalidParameterError if nShards is not positive or
+     *          requires so many bits that no sequence bits would remain.
+     */
+    static std::vector<std::shared_ptr<IdFactory>> makeSourceShards(RecordId expId, int reserved,
+                                                                    int nShards);
+
     /**
      * Return the number to pass as the 'reserved' argument to makeSource for
      * an exposure ID with the given maximum number of bits.
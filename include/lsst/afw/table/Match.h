@@ -27,6 +27,8 @@
 
 #include <vector>
 
+#include "ndarray.h"
+
 #include "lsst/pex/config.h"
 #include "lsst/afw/table/fwd.h"
 #include "lsst/afw/table/BaseRecord.h"
@@ -44,7 +46,7 @@ namespace table {
  */
 class MatchControl {
 public:
-    MatchControl() : findOnlyClosest(true), symmetricMatch(true), includeMismatches(false) {}
+    MatchControl() : findOnlyClosest(true), symmetricMatch(true), includeMismatches(false), numThreads(1) {}
     LSST_CONTROL_FIELD(findOnlyClosest, bool,
                        "Return only the closest match if more than one is found "
                        "(default: true)");
@@ -54,6 +56,11 @@ public:
     LSST_CONTROL_FIELD(includeMismatches, bool,
                        "Include failed matches (i.e. one 'match' is NULL) "
                        "(default: false)");
+    LSST_CONTROL_FIELD(numThreads, int,
+                       "Number of threads to match with; the sorted first-catalog "
+                       "positions are sharded into contiguous bands processed in "
+                       "parallel, with results identical to the serial scan "
+                       "(default: 1)");
 };
 
 /**
@@ -144,6 +151,66 @@ std::vector<Match<typename Cat::Record, typename Cat::Record> > matchRaDec(
                 MatchControl()  ///< how to do the matching (obeys MatchControl::symmetricMatch)
 );
 
+/**
+ *  Persistent spatial index over one catalog for repeated matchRaDec-style queries.
+ *
+ *  matchRaDec rebuilds its declination-sorted search structure for both catalogs on
+ *  every call; when the same large reference catalog is matched against many
+ *  successive query catalogs (e.g. alert association), building a MatchIndex from the
+ *  reference once skips that work on every subsequent call.  match() reproduces
+ *  `matchRaDec(query, indexed, radius, mc)` exactly, with the indexed catalog on the
+ *  `second` side of each Match.
+ *
+ *  The index holds shared_ptrs to the catalog's records, so it remains usable if the
+ *  catalog itself goes away, but it does not see records added or modified after
+ *  construction.
+ *
+ *  This is instantiated for Simple and Source catalogs, with query catalog types
+ *  matching the matchRaDec combinations (Simple-Simple, Simple-Source, Source-Source).
+ */
+template <typename Cat>
+class MatchIndex final {
+public:
+    typedef typename Cat::Record Record;
+
+    /// Build the index: extract unit-sphere positions (skipping records with NaN
+    /// coordinates) and sort them by declination.
+    explicit MatchIndex(Cat const &catalog);
+
+    /// Return the number of indexed records (those with valid coordinates).
+    std::size_t size() const { return _positions.size(); }
+
+    /**
+     *  Match a query catalog against the indexed catalog.
+     *
+     *  Equivalent to `matchRaDec(query, indexed, radius, mc)` (obeying
+     *  MatchControl::findOnlyClosest and MatchControl::includeMismatches) without
+     *  rebuilding the indexed side.  If numThreads > 1, the declination-sorted query
+     *  positions are sharded into contiguous bands matched in parallel; the result is
+     *  identical to the serial one because each query record's matches depend only on
+     *  that record.
+     */
+    template <typename QueryCat>
+    std::vector<Match<typename QueryCat::Record, Record>> match(QueryCat const &query,
+                                                                lsst::geom::Angle radius,
+                                                                MatchControl const &mc = MatchControl(),
+                                                                int numThreads = 1) const;
+
+private:
+    struct Position {
+        double dec;
+        double x;
+        double y;
+        double z;
+        std::shared_ptr<Record> src;
+    };
+
+    std::vector<Position> _positions;  // sorted by declination
+};
+
+typedef MatchIndex<SimpleCatalog> SimpleMatchIndex;
+typedef MatchIndex<SourceCatalog> SourceMatchIndex;
+
 /**
  *  Return a table representation of a MatchVector that can be used to persist it.
  *
@@ -178,6 +245,45 @@ template <typename Cat1, typename Cat2>
 std::vector<Match<typename Cat1::Record, typename Cat2::Record> > unpackMatches(BaseCatalog const &matches,
                                                                                 Cat1 const &cat1,
                                                                                 Cat2 const &cat2);
+
+/**
+ *  Compute the great-circle separation of every match in a single pass.
+ *
+ *  The separations are recomputed from the records' current coords (Match::distance is whatever
+ *  the matcher measured, which may since have been invalidated by e.g. a WCS update), in one
+ *  tight loop over extracted coordinate arrays rather than a scalar SpherePoint call per match.
+ *
+ *  @param[in]  matches  A std::vector of Match objects.
+ *  @returns an array of separations in radians, one per match; NaN where either record is null.
+ *
+ *  This is instantiated for the Simple-Simple, Simple-Source, and Source-Source match types.
+ */
+template <typename Record1, typename Record2>
+ndarray::Array<double, 1, 1> matchSeparations(std::vector<Match<Record1, Record2> > const &matches);
+
+/**
+ *  Compute the position angle of every match in a single pass.
+ *
+ *  @param[in]  matches  A std::vector of Match objects.
+ *  @returns an array of position angles of second relative to first, measured from north
+ *           through east, in radians in [-pi, pi]; NaN where either record is null.
+ *
+ *  This is instantiated for the Simple-Simple, Simple-Source, and Source-Source match types.
+ */
+template <typename Record1, typename Record2>
+ndarray::Array<double, 1, 1> matchPositionAngles(std::vector<Match<Record1, Record2> > const &matches);
+
+/**
+ *  Compute spherical coordinate offsets of every match in a single pass.
+ *
+ *  @param[in]  matches  A std::vector of Match objects.
+ *  @returns an (N, 2) array whose columns are (ra2 - ra1)*cos(dec1), wrapped to [-pi, pi), and
+ *           dec2 - dec1, in radians; NaN where either record is null.
+ *
+ *  This is instantiated for the Simple-Simple, Simple-Source, and Source-Source match types.
+ */
+template <typename Record1, typename Record2>
+ndarray::Array<double, 2, 2> matchOffsets(std::vector<Match<Record1, Record2> > const &matches);
 }  // namespace table
 }  // namespace afw
 }  // namespace lsst
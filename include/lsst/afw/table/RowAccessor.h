@@ -0,0 +1,157 @@
+// -*- lsst-c++ -*-
+/*
+ * LSST Data Management System
+ * Copyright 2008-2014 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+#ifndef AFW_TABLE_RowAccessor_h_INCLUDED
+#define AFW_TABLE_RowAccessor_h_INCLUDED
+
+#include <array>
+#include <cstddef>
+#include <tuple>
+#include <type_traits>
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/table/BaseRecord.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+
+/**
+ *  A typed accessor that resolves a fixed set of Keys once, for hot per-record loops.
+ *
+ *  BaseRecord::get and operator[] re-check key validity and add the key's offset on every
+ *  access, which shows up when a measurement loop makes several keyed accesses per record
+ *  over a large catalog.  A RowAccessor performs the validity checks and offset lookups at
+ *  construction; binding it to a record (one cheap check) then yields a struct-of-references
+ *  proxy whose get<I>() compiles down to raw pointer arithmetic:
+ *
+ *      auto accessor = makeRowAccessor(xKey, yKey, fluxKey);
+ *      for (auto const& record : catalog) {
+ *          auto row = accessor(record);
+ *          total += row.get<2>() * weight(row.get<0>(), row.get<1>());
+ *      }
+ *
+ *  Flag keys are not supported (their values are packed bits, not addressable elements);
+ *  for array and string keys the reference is to the first element.  No checking is done
+ *  to ensure the keys belong to the records' schema, just as with BaseRecord::get.
+ */
+template <typename... T>
+class RowAccessor final {
+    static_assert(sizeof...(T) > 0, "RowAccessor requires at least one key");
+
+    typedef std::tuple<T...> Types;
+
+    template <std::size_t I>
+    using Element = typename Field<typename std::tuple_element<I, Types>::type>::Element;
+
+    typedef std::array<std::ptrdiff_t, sizeof...(T)> OffsetArray;
+
+public:
+    /// Lightweight mutable view of one record's bound fields.
+    class Row final {
+    public:
+        /// Return a reference to the I'th bound field of the record.
+        template <std::size_t I>
+        Element<I>& get() const {
+            return *reinterpret_cast<Element<I>*>(_data + (*_offsets)[I]);
+        }
+
+    private:
+        friend class RowAccessor;
+        Row(char* data, OffsetArray const& offsets) : _data(data), _offsets(&offsets) {}
+        char* _data;
+        OffsetArray const* _offsets;
+    };
+
+    /// Lightweight read-only view of one record's bound fields.
+    class ConstRow final {
+    public:
+        /// Return a const reference to the I'th bound field of the record.
+        template <std::size_t I>
+        Element<I> const& get() const {
+            return *reinterpret_cast<Element<I> const*>(_data + (*_offsets)[I]);
+        }
+
+    private:
+        friend class RowAccessor;
+        ConstRow(char const* data, OffsetArray const& offsets) : _data(data), _offsets(&offsets) {}
+        char const* _data;
+        OffsetArray const* _offsets;
+    };
+
+    /**
+     *  Construct from the keys to bind, in the order get<I>() will address them.
+     *
+     *  @throws lsst::pex::exceptions::LogicError if any key is invalid.
+     */
+    explicit RowAccessor(Key<T> const&... keys)
+            : _firstKey(_getFirst(keys...)), _offsets{{_checkAndGetOffset(keys)...}} {}
+
+    /**
+     *  Bind to a record, returning a proxy whose lifetime must not exceed the record's.
+     *
+     *  The returned proxy also refers to this accessor's offset table, so the accessor must
+     *  outlive it as well (in a loop, bind inside and keep the accessor outside).
+     */
+    Row operator()(BaseRecord& record) const {
+        char* data = reinterpret_cast<char*>(record.getElement(_firstKey)) - _offsets[0];
+        return Row(data, _offsets);
+    }
+
+    ConstRow operator()(BaseRecord const& record) const {
+        char const* data = reinterpret_cast<char const*>(record.getElement(_firstKey)) - _offsets[0];
+        return ConstRow(data, _offsets);
+    }
+
+private:
+    typedef Key<typename std::tuple_element<0, Types>::type> FirstKey;
+
+    template <typename U, typename... Rest>
+    static Key<U> _getFirst(Key<U> const& first, Key<Rest> const&...) {
+        return first;
+    }
+
+    template <typename U>
+    static std::ptrdiff_t _checkAndGetOffset(Key<U> const& key) {
+        static_assert(!std::is_same<U, Flag>::value,
+                      "RowAccessor cannot bind Flag keys; their values are packed bits");
+        if (!key.isValid()) {
+            throw LSST_EXCEPT(pex::exceptions::LogicError, "Key is not valid");
+        }
+        return key.getOffset();
+    }
+
+    FirstKey _firstKey;
+    OffsetArray _offsets;
+};
+
+/// Construct a RowAccessor from keys, deducing the field types.
+template <typename... T>
+RowAccessor<T...> makeRowAccessor(Key<T> const&... keys) {
+    return RowAccessor<T...>(keys...);
+}
+
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !AFW_TABLE_RowAccessor_h_INCLUDED
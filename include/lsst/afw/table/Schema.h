@@ -147,6 +147,22 @@ public:
     /// Return the raw size of a record in bytes.
     int getRecordSize() const { return _impl->getRecordSize(); }
 
+    /**
+     *  Return a hash of the schema's key layout, maintained eagerly as fields are added.
+     *
+     *  Two schemas that are equal in the operator== sense (same key types and offsets) always
+     *  have the same fingerprint, so a fingerprint mismatch proves two schemas differ without
+     *  a key-by-key comparison.  The converse does not hold: unequal schemas may (very rarely)
+     *  collide, so a fingerprint match must not be used where a false positive is unsafe.
+     */
+    std::size_t getFingerprint() const { return _impl->getFingerprint(); }
+
+    /**
+     *  Return true if records with this schema hold only plain data (no variable-length
+     *  fields), and hence may be copied with a single memcpy of getRecordSize() bytes.
+     */
+    bool isRawCopyable() const { return _impl->isRawCopyable(); }
+
     /// The total number of fields.
     int getFieldCount() const { return _impl->getFieldCount(); }
 
@@ -214,6 +214,16 @@ public:
             std::vector<std::string> const& prefixes = std::vector<std::string>());
 
 private:
+    friend class BaseRecord;
+
+    /**
+     *  Return the plan for copying mapped fields between records, building it on first use.
+     *
+     *  The plan is invalidated whenever a mapping is added or the mapper is inverted, and
+     *  is shared (it is immutable once built) when the mapper is copied.
+     */
+    detail::CopyPlan const& getCopyPlan() const;
+
     template <typename Predicate>
     struct AddMappingsWhere {
         template <typename T>
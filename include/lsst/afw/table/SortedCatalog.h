@@ -78,6 +78,16 @@ public:
     const_iterator find(RecordId id) const { return this->find(id, Table::getIdKey()); }
     //@}
 
+    using Base::defineIdIndex;
+
+    /**
+     *  Build a hash index on the ID field, enabling O(1) findById() lookups that do
+     *  not require the catalog to be sorted.
+     *
+     *  @see CatalogT::defineIdIndex for the maintenance and invalidation rules.
+     */
+    void defineIdIndex() { Base::defineIdIndex(Table::getIdKey()); }
+
     /**
      *  Construct a vector from a table (or nothing).
      *
@@ -23,6 +23,10 @@
 #ifndef AFW_TABLE_aggregates_h_INCLUDED
 #define AFW_TABLE_aggregates_h_INCLUDED
 
+#include <utility>
+
+#include "ndarray.h"
+
 #include "lsst/utils/hashCombine.h"
 
 #include "lsst/afw/table/FunctorKey.h"
@@ -42,6 +46,8 @@ class Quadrupole;
 
 namespace table {
 
+class BaseColumnView;
+
 /**
  *  A FunctorKey used to get or set a lsst::geom::Point from an (x,y) pair of int or double Keys.
  */
@@ -88,6 +94,25 @@ public:
     /// Set a Point in the given record
     void set(BaseRecord& record, lsst::geom::Point<T, 2> const& value) const override;
 
+    /**
+     *  Return the x and y columns of a catalog as a pair of arrays.
+     *
+     *  The returned arrays are shallow views into the catalog's own memory, so they may be used
+     *  to read or modify both columns in bulk without going through the records.  The column
+     *  view is typically obtained via CatalogT::getColumnView(), which requires the catalog to
+     *  be contiguous.
+     */
+    std::pair<ndarray::Array<T, 1>, ndarray::Array<T, 1>> getArrays(BaseColumnView const& columns) const;
+
+    /**
+     *  Set the x and y columns of a catalog from a pair of arrays.
+     *
+     *  @throws lsst::pex::exceptions::LengthError if either array's size does not match the
+     *          number of records in the column view.
+     */
+    void setArrays(BaseColumnView const& columns, ndarray::Array<T const, 1> const& x,
+                   ndarray::Array<T const, 1> const& y) const;
+
     //@{
     /// Compare the FunctorKey for equality with another, using the underlying x and y Keys
     bool operator==(PointKey<T> const& other) const noexcept { return _x == other._x && _y == other._y; }
@@ -248,6 +273,37 @@ public:
     /// Set an lsst::geom::SpherePoint in the given record
     void set(BaseRecord& record, lsst::geom::SpherePoint const& value) const override;
 
+    /**
+     *  Return the ra and dec columns of a catalog as a pair of arrays.
+     *
+     *  As with PointKey::getArrays, the returned arrays are shallow views into the catalog's
+     *  own memory, and hence may be used to read or modify the columns in bulk.
+     */
+    std::pair<ndarray::Array<lsst::geom::Angle, 1>, ndarray::Array<lsst::geom::Angle, 1>> getArrays(
+            BaseColumnView const& columns) const;
+
+    /**
+     *  Return the coordinates of a catalog as an (N, 3) array of unit vectors.
+     *
+     *  Each row holds the Cartesian unit vector corresponding to that record's (ra, dec),
+     *  in the same convention as lsst::geom::SpherePoint::getVector.  Unlike getArrays, the
+     *  result is a newly-allocated array, not a view into the catalog's memory.
+     */
+    ndarray::Array<double, 2, 2> getUnitVectors(BaseColumnView const& columns) const;
+
+    /**
+     *  Set the ra and dec columns of a catalog from an (N, 3) array of vectors.
+     *
+     *  The vectors need not be normalized, but none may be the zero vector.  Longitudes are
+     *  wrapped to [0, 2pi), matching construction of an lsst::geom::SpherePoint from a vector.
+     *
+     *  @throws lsst::pex::exceptions::LengthError if the array's shape is not (N, 3) with N
+     *          the number of records in the column view.
+     *  @throws lsst::pex::exceptions::InvalidParameterError if any vector has zero norm.
+     */
+    void setUnitVectors(BaseColumnView const& columns,
+                        ndarray::Array<double const, 2> const& vectors) const;
+
     //@{
     /// Compare CoordKeys for equality using the constituent `ra` and `dec` Keys
     bool operator==(CoordKey const& other) const noexcept { return _ra == other._ra && _dec == other._dec; }
@@ -523,6 +579,28 @@ public:
     /// Set the element in row i and column j
     void setElement(BaseRecord& record, int i, int j, T value) const;
 
+    /**
+     *  Return the element in row i and column j for every record as a newly allocated array.
+     *
+     *  Unlike PointKey::getArrays, the result is a copy rather than a view: diagonal elements
+     *  are computed by squaring the stored standard deviations, and elements with no associated
+     *  field are filled with zero, exactly as getElement does record-by-record.
+     */
+    ndarray::Array<T, 1> getElementArray(BaseColumnView const& columns, int i, int j) const;
+
+    /**
+     *  Set the element in row i and column j for every record from an array of values.
+     *
+     *  Diagonal elements are stored as standard deviations (the square roots of the given
+     *  variances), exactly as setElement does record-by-record.
+     *
+     *  @throws lsst::pex::exceptions::LogicError if there is no field for element (i, j), and
+     *          lsst::pex::exceptions::LengthError if the array's size does not match the number
+     *          of records in the column view.
+     */
+    void setElementArray(BaseColumnView const& columns, int i, int j,
+                         ndarray::Array<T const, 1> const& values) const;
+
     /**
      *  Return True if all the constituent error Keys are valid
      *
@@ -88,6 +88,7 @@ public:
     static void padSchema(Schema &schema, int bytes) {
         schema._edit();
         schema._impl->_recordSize += bytes;
+        schema._impl->_updateCache();  // the record size is part of the fingerprint
     }
 };
 }  // namespace detail
@@ -0,0 +1,134 @@
+// -*- lsst-c++ -*-
+#ifndef AFW_TABLE_DETAIL_RecordArena_h_INCLUDED
+#define AFW_TABLE_DETAIL_RecordArena_h_INCLUDED
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+
+namespace lsst {
+namespace afw {
+namespace table {
+namespace detail {
+
+/**
+ *  Memory pool for record objects and their shared_ptr control blocks.
+ *
+ *  Tables allocate record *field data* in blocks (see BaseTable::preallocate), but each
+ *  record object plus its shared_ptr control block is normally a separate make_shared
+ *  heap allocation.  When a table is given a RecordArena (see
+ *  BaseTable::setRecordArena), records are created with allocate_shared instead,
+ *  carving both out of slabs of `recordsPerSlab` records.  Each allocation is prefixed
+ *  with a pointer back to its slab, so deallocation is just a counter decrement; a slab
+ *  is returned to the system in bulk once all of its records are gone, and the most
+ *  recent slab is reused in place when it drains, so steady-state record churn stops
+ *  touching the global allocator entirely.
+ *
+ *  Allocation happens only from a table's (single-threaded) record-creation path, but
+ *  records may be destroyed from any thread, so both paths take a mutex; it is
+ *  per-arena and almost never contended.
+ */
+class RecordArena {
+public:
+    explicit RecordArena(std::size_t recordsPerSlab) : _recordsPerSlab(recordsPerSlab) {}
+
+    RecordArena(RecordArena const&) = delete;
+    RecordArena(RecordArena&&) = delete;
+    RecordArena& operator=(RecordArena const&) = delete;
+    RecordArena& operator=(RecordArena&&) = delete;
+
+    void* allocate(std::size_t nBytes) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        // Pad each chunk so every pointer we hand out has fundamental alignment; the one-word
+        // header occupies a full alignment unit for the same reason.
+        std::size_t const chunkSize = HEADER_SIZE + _alignUp(nBytes);
+        if (_slabs.empty() || _slabs.back().capacity - _slabs.back().used < chunkSize) {
+            _slabs.emplace_back(chunkSize * _recordsPerSlab);
+        }
+        Slab& slab = _slabs.back();
+        char* chunk = slab.memory.get() + slab.used;
+        slab.used += chunkSize;
+        ++slab.outstanding;
+        *reinterpret_cast<Slab**>(chunk) = &slab;
+        return chunk + HEADER_SIZE;
+    }
+
+    void deallocate(void* ptr) {
+        std::lock_guard<std::mutex> lock(_mutex);
+        Slab* slab = *reinterpret_cast<Slab**>(static_cast<char*>(ptr) - HEADER_SIZE);
+        if (--slab->outstanding == 0) {
+            if (slab == &_slabs.back()) {
+                slab->used = 0;  // reuse the current slab rather than freeing it
+            } else {
+                for (auto iter = _slabs.begin(); iter != _slabs.end(); ++iter) {
+                    if (&*iter == slab) {
+                        _slabs.erase(iter);
+                        break;
+                    }
+                }
+            }
+        }
+    }
+
+private:
+    static std::size_t const HEADER_SIZE = alignof(std::max_align_t);
+
+    static std::size_t _alignUp(std::size_t n) { return (n + HEADER_SIZE - 1) & ~(HEADER_SIZE - 1); }
+
+    struct Slab {
+        explicit Slab(std::size_t capacity_) : memory(new char[capacity_]), capacity(capacity_) {}
+
+        std::unique_ptr<char[]> memory;
+        std::size_t capacity;
+        std::size_t used = 0;         // bytes handed out
+        std::size_t outstanding = 0;  // live allocations
+    };
+
+    std::size_t const _recordsPerSlab;
+    std::list<Slab> _slabs;  // list, so Slab addresses stay valid for the headers
+    std::mutex _mutex;
+};
+
+/**
+ *  STL-style allocator adapter for RecordArena, for use with allocate_shared.
+ *
+ *  Holds the arena by shared_ptr because a copy of the allocator lives in each
+ *  control block, which can outlive the table that created the record.
+ */
+template <typename T>
+class RecordArenaAllocator {
+public:
+    typedef T value_type;
+
+    explicit RecordArenaAllocator(std::shared_ptr<RecordArena> arena) : _arena(std::move(arena)) {}
+
+    template <typename U>
+    RecordArenaAllocator(RecordArenaAllocator<U> const& other) : _arena(other.getArena()) {}
+
+    T* allocate(std::size_t n) { return static_cast<T*>(_arena->allocate(n * sizeof(T))); }
+
+    void deallocate(T* ptr, std::size_t) { _arena->deallocate(ptr); }
+
+    std::shared_ptr<RecordArena> getArena() const { return _arena; }
+
+private:
+    std::shared_ptr<RecordArena> _arena;
+};
+
+template <typename T, typename U>
+bool operator==(RecordArenaAllocator<T> const& lhs, RecordArenaAllocator<U> const& rhs) {
+    return lhs.getArena() == rhs.getArena();
+}
+
+template <typename T, typename U>
+bool operator!=(RecordArenaAllocator<T> const& lhs, RecordArenaAllocator<U> const& rhs) {
+    return !(lhs == rhs);
+}
+
+}  // namespace detail
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // !AFW_TABLE_DETAIL_RecordArena_h_INCLUDED
@@ -6,6 +6,7 @@
 #include <algorithm>
 #include <map>
 #include <set>
+#include <unordered_map>
 
 #include "boost/variant.hpp"
 #include "boost/mpl/transform.hpp"
@@ -66,6 +67,8 @@ public:
     typedef std::vector<ItemVariant> ItemContainer;
     /// A map from field names to position in the vector, so we can do name lookups.
     typedef std::map<std::string, int> NameMap;
+    /// A hash map mirroring NameMap, so exact-name lookups are O(1) on average.
+    typedef std::unordered_map<std::string, int> HashNameMap;
     /// A map from standard field offsets to position in the vector, so we can do field lookups.
     typedef std::map<int, int> OffsetMap;
     /// A map from Flag field offset/bit pairs to position in the vector, so we can do Flag field lookups.
@@ -83,6 +86,22 @@ public:
     /// The number of non-Flag fields.
     int getNonFlagFieldCount() const { return _offsets.size(); }
 
+    /**
+     *  Return a hash of the schema's key layout, recomputed eagerly whenever the layout changes.
+     *
+     *  Two schemas that are equal in the Schema::operator== sense (same key types and offsets)
+     *  always have the same fingerprint, so fingerprint comparison is a constant-time stand-in
+     *  for key-by-key schema comparison.  Note that unequal schemas may (very rarely) share a
+     *  fingerprint, so a fingerprint match must not be used where a false positive is unsafe.
+     */
+    std::size_t getFingerprint() const { return _fingerprint; }
+
+    /**
+     *  Return true if records with this schema hold only plain data (no variable-length
+     *  fields), and hence one record may be copied to another with a single memcpy.
+     */
+    bool isRawCopyable() const { return _rawCopyable; }
+
     /// Find an item by name (used to implement Schema::find).
     template <typename T>
     SchemaItem<T> find(std::string const& name) const;
@@ -97,8 +116,8 @@ public:
     /// Find an item by name and run the given functor on it.
     template <typename F>
     void findAndApply(std::string const& name, F&& func) const {
-        auto iter = _names.find(name);
-        if (iter == _names.end()) {
+        auto iter = _hashNames.find(name);
+        if (iter == _hashNames.end()) {
             throw LSST_EXCEPT(pex::exceptions::NotFoundError,
                               (boost::format("Field with name '%s' not found") % name).str());
         }
@@ -143,7 +162,15 @@ public:
     ItemContainer const& getItems() const { return _items; }
 
     /// Default constructor.
-    explicit SchemaImpl() : _recordSize(0), _lastFlagField(-1), _lastFlagBit(-1), _items() {}
+    explicit SchemaImpl()
+            : _recordSize(0),
+              _lastFlagField(-1),
+              _lastFlagBit(-1),
+              _fingerprint(0),
+              _rawCopyable(true),
+              _items() {
+        _updateCache();
+    }
 
     /**
      *  A functor-wrapper used in the implementation of Schema::forEach.
@@ -187,13 +214,21 @@ private:
     template <typename T>
     Key<T> addFieldImpl(int elementSize, int elementCount, Field<T> const& field, bool doReplace);
 
+    // Recompute _fingerprint and _rawCopyable from the current items.  Called from every
+    // code path that changes the key layout, so const readers never write; that keeps
+    // getFingerprint() and isRawCopyable() safe on Schemas shared across threads.
+    void _updateCache();
+
     int _recordSize;       // Size of a record in bytes.
     int _lastFlagField;    // Offset of the last flag field in bytes.
     int _lastFlagBit;      // Bit of the last flag field.
-    ItemContainer _items;  // Vector of variants of SchemaItem<T>.
-    NameMap _names;        // Field name to vector-index map.
-    OffsetMap _offsets;    // Offset to vector-index map for regular fields.
-    FlagMap _flags;        // Offset to vector-index map for flags.
+    std::size_t _fingerprint;  // Hash of the key layout (see getFingerprint).
+    bool _rawCopyable;         // Result of isRawCopyable.
+    ItemContainer _items;     // Vector of variants of SchemaItem<T>.
+    NameMap _names;           // Field name to vector-index map.
+    HashNameMap _hashNames;   // Hashed mirror of _names for exact-match lookups.
+    OffsetMap _offsets;       // Offset to vector-index map for regular fields.
+    FlagMap _flags;           // Offset to vector-index map for flags.
 };
 }  // namespace detail
 }  // namespace table
@@ -3,6 +3,7 @@
 #define AFW_TABLE_DETAIL_SchemaMapperImpl_h_INCLUDED
 
 #include <map>
+#include <memory>
 #include <algorithm>
 
 #include "boost/variant.hpp"
@@ -18,6 +19,8 @@ class SchemaMapper;
 
 namespace detail {
 
+struct CopyPlan;
+
 /**
  * A private implementation class to hide the messy details of SchemaMapper.
  *
@@ -84,6 +87,27 @@ private:
     Schema _input;
     Schema _output;
     KeyPairMap _map;
+    mutable std::shared_ptr<CopyPlan const> _copyPlan;  // lazily built; reset whenever _map changes
+};
+
+/**
+ * A precompiled plan for copying mapped fields between records.
+ *
+ * Fixed-size fields whose input and output offsets are adjacent are coalesced into raw
+ * byte ranges that can be copied with a single memcpy each; Flag and variable-length
+ * fields, which cannot be copied bytewise, are kept aside for individual dispatch.
+ * Built lazily by SchemaMapper and consumed by BaseRecord::assign.
+ */
+struct CopyPlan {
+    /// A contiguous byte range to copy between record data buffers.
+    struct Chunk {
+        int inputOffset;
+        int outputOffset;
+        int size;  // bytes
+    };
+
+    std::vector<Chunk> chunks;                       ///< Coalesced memcpy ranges.
+    SchemaMapperImpl::KeyPairMap exceptional;        ///< Key pairs copied one at a time.
 };
 }  // namespace detail
 }  // namespace table
@@ -2,6 +2,7 @@
 #ifndef AFW_TABLE_IO_FitsReader_h_INCLUDED
 #define AFW_TABLE_IO_FitsReader_h_INCLUDED
 
+#include <limits>
 #include <type_traits>
 
 #include "lsst/afw/fits.h"
@@ -70,6 +71,28 @@ public:
     template <typename ContainerT>
     static ContainerT apply(afw::fits::Fits& fits, int ioFlags,
                             std::shared_ptr<InputArchive> archive = std::shared_ptr<InputArchive>()) {
+        return applyRows<ContainerT>(fits, ioFlags, 0, std::numeric_limits<std::size_t>::max(), archive);
+    }
+
+    /**
+     *  Create a new Catalog by reading a contiguous range of rows of a FITS binary table.
+     *
+     *  Identical to apply(), but only the records in [first, last) are read; last is clamped
+     *  to the number of rows in the table (so e.g. passing the maximum std::size_t reads
+     *  everything from first onwards).  Paging through a large catalog chunk by chunk avoids
+     *  materializing tens of thousands of records when only a few are wanted.
+     *
+     *  @param[in]  fits     An afw::fits::Fits helper that points to a FITS binary table HDU.
+     *  @param[in]  ioFlags  A set of subclass-dependent bitflags that control optional aspects of FITS
+     *                       persistence (see apply()).
+     *  @param[in]  first    Index of the first row to read.
+     *  @param[in]  last     One past the index of the last row to read.
+     *  @param[in]  archive  An archive of Persistables containing objects that may be associated
+     *                       with table records (see apply()).
+     */
+    template <typename ContainerT>
+    static ContainerT applyRows(afw::fits::Fits& fits, int ioFlags, std::size_t first, std::size_t last,
+                                std::shared_ptr<InputArchive> archive = std::shared_ptr<InputArchive>()) {
         std::shared_ptr<daf::base::PropertyList> metadata = std::make_shared<daf::base::PropertyList>();
         fits.readMetadata(*metadata, true);
         FitsReader const* reader = _lookupFitsReader(*metadata);
@@ -81,8 +104,14 @@ public:
             throw LSST_EXCEPT(pex::exceptions::RuntimeError, "Invalid table class for catalog.");
         }
         std::size_t nRows = fits.countRows();
-        container.reserve(nRows);
-        for (std::size_t row = 0; row < nRows; ++row) {
+        if (last > nRows) {
+            last = nRows;
+        }
+        if (first > last) {
+            first = last;
+        }
+        container.reserve(last - first);
+        for (std::size_t row = first; row < last; ++row) {
             mapper.readRecord(
                     // We need to be able to support reading Catalog<T const>, since it shares the same
                     // template
@@ -108,6 +137,20 @@ public:
         return apply<ContainerT>(fits, ioFlags, archive);
     }
 
+    /**
+     *  Create a new Catalog by reading a contiguous range of rows of a FITS file.
+     *
+     *  This is a simply a convenience function that creates an afw::fits::Fits object from either
+     *  a string filename or a afw::fits::MemFileManager, then calls the other applyRows() overload.
+     */
+    template <typename ContainerT, typename SourceT>
+    static ContainerT applyRows(SourceT& source, int hdu, int ioFlags, std::size_t first, std::size_t last,
+                                std::shared_ptr<InputArchive> archive = std::shared_ptr<InputArchive>()) {
+        afw::fits::Fits fits(source, "r", afw::fits::Fits::AUTO_CLOSE | afw::fits::Fits::AUTO_CHECK);
+        fits.setHdu(hdu);
+        return applyRows<ContainerT>(fits, ioFlags, first, last, archive);
+    }
+
     /**
      *  Callback to create a Table object from a FITS binary table schema.
      *
@@ -72,9 +72,17 @@ public:
         for (typename ContainerT::const_iterator i = container.begin(); i != container.end(); ++i) {
             _writeRecord(*i);
         }
+        _flushRecords();
         _finish();
     }
 
+    /**
+     *  Number of bytes of record data to stage in memory before flushing to the FITS file
+     *  with one cfitsio call per column (analogous to FitsSchemaInputMapper::PREPPED_ROWS_FACTOR
+     *  on the read side).
+     */
+    static std::size_t BUFFERED_ROWS_FACTOR;
+
     /// Construct from a wrapped cfitsio pointer.
     explicit FitsWriter(Fits* fits, int flags) : _fits(fits), _flags(flags) {}
 
@@ -101,6 +109,9 @@ protected:
 private:
     struct ProcessRecords;
 
+    /// Write any records still staged in memory to the FITS file.
+    void _flushRecords();
+
     std::shared_ptr<ProcessRecords> _processor;  // a private Schema::forEach functor that write records
 };
 }  // namespace io
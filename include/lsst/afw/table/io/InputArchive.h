@@ -73,6 +73,43 @@ public:
      */
     static InputArchive readFits(fits::Fits& fitsfile);
 
+    /**
+     *  Read an object from an already open FITS object, sharing archives with identical content.
+     *
+     *  This is equivalent to readFits, except that if an archive with the
+     *  same content has already been read by this method and is still in use
+     *  somewhere in the process, that archive is returned instead of a new
+     *  one.  Because archives cache the objects they load, this also shares
+     *  the deserialized Persistables themselves, avoiding duplicated factory
+     *  work and heap when many files carry near-identical archives (e.g. all
+     *  CCDs of a visit sharing camera transforms or transmission curves).
+     *
+     *  Callers must be prepared for objects loaded through a shared archive
+     *  to be shared with other holders of the same content, and hence should
+     *  treat them as immutable (as is already the case for objects loaded
+     *  twice from a single archive).
+     *
+     *  @param[in]  fitsfile     FITS object to read from, already positioned at the desired HDU.
+     */
+    static InputArchive readFitsShared(fits::Fits& fitsfile);
+
+    /**
+     *  Read an object from an already open FITS object, deferring the data catalogs.
+     *
+     *  Only the index catalog is read up front; each data catalog HDU is read (by
+     *  reopening the file by name) the first time get() needs a row range from it, so
+     *  callers that never fetch an object never pay for the archive catalogs at all,
+     *  and callers that fetch a few small objects only read the catalogs those objects
+     *  live in.  Errors in unread data HDUs are correspondingly deferred from read
+     *  time to the first get() that touches them.
+     *
+     *  Falls back to an eager readFits when the FITS object has no file name to
+     *  reopen (e.g. it wraps an in-memory file).
+     *
+     *  @param[in]  fitsfile     FITS object to read from, already positioned at the desired HDU.
+     */
+    static InputArchive readFitsLazy(fits::Fits& fitsfile);
+
 private:
     class Impl;
 
@@ -82,6 +82,26 @@ public:
     int put(Persistable const & obj, bool permissive = false) { return put(&obj, permissive); }
     ///@}
 
+    /**
+     *  Enable or disable content-based deduplication of saved objects (disabled by default).
+     *
+     *  put() always reuses the ID of an object that was already saved via the same
+     *  `shared_ptr`, but logically identical objects held by different pointers (e.g.
+     *  the same warping kernel attached to every input of a coadd) are normally
+     *  serialized once each.  With content deduplication enabled, an object whose
+     *  serialized form (index entries and catalog rows, ignoring position in the
+     *  archive) is identical to that of a previously saved object is given that
+     *  object's ID instead and its rows are dropped from the archive.
+     *
+     *  Only objects saved while deduplication is enabled are candidates for reuse,
+     *  and IDs are never reused, so deduplicated archives may have gaps in their ID
+     *  sequence (which readers already permit).
+     */
+    void setContentDeduplication(bool deduplicate);
+
+    /// Return whether content-based deduplication is enabled (see setContentDeduplication).
+    bool getContentDeduplication() const;
+
     /**
      *  @brief Return the index catalog that specifies where objects are stored in the
      *         data catalogs.
@@ -0,0 +1,61 @@
+// -*- lsst-c++ -*-
+
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#ifndef LSST_AFW_TABLE_MASKUTILS_H
+#define LSST_AFW_TABLE_MASKUTILS_H
+
+#include "ndarray.h"
+
+#include "lsst/afw/image/Mask.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+
+/**
+ * Compute the bitwise OR of the mask pixels under each source's footprint
+ *
+ * Rather than walking each footprint's SpanSet separately (which revisits mask rows once per
+ * overlapping source), all footprint spans are gathered, sorted by row, and evaluated in a
+ * single row-major sweep over the mask.
+ *
+ * @tparam SourceCollection  Type of sequence of sources, e.g. lsst::afw::table::SourceCatalog or
+ *          std::vector<std::shared_ptr<lsst::afw::table::SourceRecord>>
+ * @param[in] mask  Mask to read.
+ * @param[in] sources  Collection of sources.  Footprint spans outside the mask's bounding box
+ *          are ignored; sources with no footprint (or no spans on the mask) get 0.
+ *
+ * @returns an array with one element per source, in the order of the collection, containing
+ *          the OR of all mask pixels under that source's footprint.
+ */
+template <typename SourceCollection>
+ndarray::Array<image::MaskPixel, 1, 1> getFootprintMaskBits(image::Mask<image::MaskPixel> const& mask,
+                                                            SourceCollection const& sources);
+
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
+
+#endif  // #ifndef LSST_AFW_TABLE_MASKUTILS_H
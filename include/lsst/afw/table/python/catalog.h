@@ -24,6 +24,7 @@
 #define AFW_TABLE_PYTHON_CATALOG_H_INCLUDED
 
 #include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
 
 #include "lsst/utils/python.h"
 #include "lsst/afw/table/BaseColumnView.h"
@@ -68,6 +69,34 @@ ndarray::Array<double const, 1, 1> _getArrayFromCatalog(
     return out;
 }
 
+/// Set a column of a potentially non-contiguous Catalog from an array
+template <typename T, typename Record>
+void _setColumnFromArray(CatalogT<Record> &catalog,  ///< Catalog
+                         Key<T> const &key,          ///< Key to column to set
+                         ndarray::Array<typename Field<T>::Value const, 1> const &array  ///< Values to set
+) {
+    catalog.setColumn(key, array);
+}
+
+// Specialization of the above for lsst::geom::Angle: accept a double array (in
+// radians), since NumPy arrays can't hold lsst::geom::Angles.
+template <typename Record>
+void _setColumnFromArray(CatalogT<Record> &catalog,           ///< Catalog
+                         Key<lsst::geom::Angle> const &key,   ///< Key to column to set
+                         ndarray::Array<double const, 1> const &array  ///< Values to set, in radians
+) {
+    if (array.size() != catalog.size()) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Catalog has %d rows, while array has %d elements.") %
+                           catalog.size() % array.size())
+                                  .str());
+    }
+    auto arrayIter = array.begin();
+    for (auto catIter = catalog.begin(); catIter != catalog.end(); ++catIter, ++arrayIter) {
+        catIter->set(key, *arrayIter * lsst::geom::radians);
+    }
+}
+
 template <typename Record>
 void _setFlagColumnToArray(
     CatalogT<Record> & catalog,
@@ -117,6 +146,10 @@ void declareCatalogOverloads(PyCatalog<Record> &cls) {
 
     cls.def("isSorted", (bool (Catalog::*)(Key<T> const &) const) & Catalog::isSorted);
     cls.def("sort", (void (Catalog::*)(Key<T> const &)) & Catalog::sort);
+    cls.def("sorted", (Catalog(Catalog::*)(Key<T> const &) const) & Catalog::sorted);
+    cls.def_static("merged",
+                   (Catalog(*)(std::vector<Catalog> const &, Key<T> const &, bool)) & Catalog::merged,
+                   "catalogs"_a, "key"_a, "deep"_a = false);
     cls.def("find", [](Catalog &self, Value const &value, Key<T> const &key) -> std::shared_ptr<Record> {
         auto iter = self.find(value, key);
         if (iter == self.end()) {
@@ -142,6 +175,14 @@ void declareCatalogOverloads(PyCatalog<Record> &cls) {
 
     cls.def("_getitem_",
             [](Catalog const &self, Key<T> const &key) { return _getArrayFromCatalog(self, key); });
+    // NumPy arrays can't hold lsst::geom::Angle, so columns of Angle fields are set from double
+    // arrays holding radians (see _setColumnFromArray).
+    typedef typename std::conditional<std::is_same<T, lsst::geom::Angle>::value, double, Value>::type
+            ColumnValue;
+    cls.def("_set_column", [](Catalog &self, Key<T> const &key,
+                              ndarray::Array<ColumnValue const, 1> const &values) {
+        _setColumnFromArray(self, key, values);
+    });
     cls.def(
         "_set_flag",
         [](Catalog &self, Key<Flag> const & key, ndarray::Array<bool const, 1> const & array) {
@@ -200,6 +241,16 @@ PyCatalog<Record> declareCatalog(utils::python::WrapperCollection &wrappers, std
                                "filename"_a, "hdu"_a = fits::DEFAULT_HDU, "flags"_a = 0);
                 cls.def_static("readFits", (Catalog(*)(fits::MemFileManager &, int, int)) & Catalog::readFits,
                                "manager"_a, "hdu"_a = fits::DEFAULT_HDU, "flags"_a = 0);
+                cls.def_static("readFitsRows",
+                               (Catalog(*)(std::string const &, std::size_t, std::size_t, int, int)) &
+                                       Catalog::readFitsRows,
+                               "filename"_a, "first"_a, "last"_a, "hdu"_a = fits::DEFAULT_HDU,
+                               "flags"_a = 0);
+                cls.def_static("readFitsRows",
+                               (Catalog(*)(fits::MemFileManager &, std::size_t, std::size_t, int, int)) &
+                                       Catalog::readFitsRows,
+                               "manager"_a, "first"_a, "last"_a, "hdu"_a = fits::DEFAULT_HDU,
+                               "flags"_a = 0);
                 // readFits taking Fits objects not wrapped, because Fits objects are not wrapped.
 
                 /* Methods */
@@ -215,6 +266,7 @@ PyCatalog<Record> declareCatalog(utils::python::WrapperCollection &wrappers, std
                 // can manage the _column cache
                 cls.def("_getColumnView", &Catalog::getColumnView);
                 cls.def("_addNew", &Catalog::addNew);
+                cls.def("_appendRecords", &Catalog::appendRecords, "n"_a);
                 cls.def("_extend", [](Catalog &self, Catalog const &other, bool deep) {
                     self.insert(self.end(), other.begin(), other.end(), deep);
                 });
@@ -258,6 +310,11 @@ PyCatalog<Record> declareCatalog(utils::python::WrapperCollection &wrappers, std
                         (Catalog(Catalog::*)(std::ptrdiff_t, std::ptrdiff_t, std::ptrdiff_t) const) &
                                 Catalog::subset);
 
+                cls.def("defineIdIndex", &Catalog::defineIdIndex, "key"_a);
+                cls.def("clearIdIndex", &Catalog::clearIdIndex);
+                cls.def("hasIdIndex", &Catalog::hasIdIndex);
+                cls.def("findById", &Catalog::findById, "id"_a);
+
                 declareCatalogOverloads<std::int32_t>(cls);
                 declareCatalogOverloads<std::int64_t>(cls);
                 declareCatalogOverloads<float>(cls);
@@ -124,6 +124,14 @@ PySortedCatalog<Record> declareSortedCatalog(utils::python::WrapperCollection &w
                             return clsBase.attr("find")(self, value, key);
                         },
                         "value"_a, "key"_a = py::none());
+                cls.def("defineIdIndex",
+                        [clsBase](py::object const &self, py::object key) -> py::object {
+                            if (key.is(py::none())) {
+                                key = self.attr("table").attr("getIdKey")();
+                            }
+                            return clsBase.attr("defineIdIndex")(self, key);
+                        },
+                        "key"_a = py::none());
 
             });
 }
@@ -25,10 +25,11 @@
 #ifndef LSST_AFW_TYPEHANDLING_SIMPLEGENERICMAP_H
 #define LSST_AFW_TYPEHANDLING_SIMPLEGENERICMAP_H
 
+#include <algorithm>
 #include <exception>
 #include <sstream>
-#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "boost/variant.hpp"
 
@@ -77,8 +78,8 @@ public:
     SimpleGenericMap& operator=(SimpleGenericMap&&) noexcept = default;
     SimpleGenericMap& operator=(GenericMap<K> const& other) {
         std::vector<K> newKeys = other.keys();
-        // strong exception safety: unordered_map is nothrow move-assignable and
-        // vector is nothrow swappable, so no exceptions can occur after _convertStorage returns
+        // strong exception safety: vector is nothrow move-assignable and
+        // nothrow swappable, so no exceptions can occur after _convertStorage returns
         _storage = _convertStorage(other);
         using std::swap;
         swap(_keyView, newKeys);
@@ -93,7 +94,7 @@ public:
         return std::min(_storage.max_size(), _keyView.max_size());
     }
 
-    bool contains(K const& key) const override { return _storage.count(key) > 0; }
+    bool contains(K const& key) const override { return _find(key) != _storage.cend(); }
 
     std::vector<K> const& keys() const noexcept override { return _keyView; }
 
@@ -104,65 +105,76 @@ public:
 
 protected:
     ConstValueReference unsafeLookup(K key) const override {
-        try {
-            return _storage.at(key);
-        } catch (std::out_of_range& e) {
+        auto const pos = _find(key);
+        if (pos == _storage.cend()) {
             std::stringstream message;
             message << "Key not found: " << key;
-            std::throw_with_nested(LSST_EXCEPT(pex::exceptions::OutOfRangeError, message.str()));
+            throw LSST_EXCEPT(pex::exceptions::OutOfRangeError, message.str());
         }
+        return pos->second;
     }
 
     bool unsafeInsert(K key, StorableType&& value) override {
+        if (contains(key)) {
+            return false;
+        }
         std::vector<K> newKeys = _keyView;
         newKeys.emplace_back(key);
-        bool inserted = _storage.emplace(key, std::move(value)).second;
+        _storage.emplace_back(std::move(key), std::move(value));
         // strong exception safety because no exceptions can occur past this point
-        if (inserted) {
-            // _storage did not previously include key, so the key appended to newKeys is unique
-            using std::swap;
-            swap(_keyView, newKeys);
-        }
-        return inserted;
+        // _storage did not previously include key, so the key appended to newKeys is unique
+        using std::swap;
+        swap(_keyView, newKeys);
+        return true;
     }
 
     bool unsafeErase(K key) override {
-        std::vector<K> newKeys = _keyView;
-        for (auto it = newKeys.cbegin(); it != newKeys.cend();) {
-            if (*it == key) {
-                it = newKeys.erase(it);
-            } else {
-                ++it;
-            }
-        }
-        // strong exception safety because no exceptions can occur past this point
-        bool erased = _storage.erase(key) > 0;
-        if (erased) {
-            using std::swap;
-            swap(_keyView, newKeys);
+        auto const pos = std::find_if(_storage.begin(), _storage.end(),
+                                      [&key](value_type const& pair) { return pair.first == key; });
+        if (pos == _storage.end()) {
+            return false;
         }
-        return erased;
+        std::vector<K> newKeys = _keyView;
+        newKeys.erase(std::remove(newKeys.begin(), newKeys.end(), key), newKeys.end());
+        _storage.erase(pos);
+        using std::swap;
+        swap(_keyView, newKeys);
+        return true;
     }
 
 private:
     // StorableType is a value, so we might as well use it in the implementation
-    std::unordered_map<K, StorableType> _storage;
+    using value_type = std::pair<K, StorableType>;
+
+    // Flat key-value storage in insertion order: these maps typically hold
+    // only a handful of entries, so a linear scan through contiguous memory
+    // beats hashing into node-based storage and avoids a per-node allocation
+    // on insert.
+    std::vector<value_type> _storage;
     std::vector<K> _keyView;
     // Class invariant: the elements of _keyView are unique
-    // Class invariant: the elements of _keyView and the keys of _storage are the same
+    // Class invariant: the elements of _keyView and the keys of _storage are the same,
+    //                  in the same order
     // Class invariant: the elements of _keyView are arranged in insertion order, oldest to newest
 
+    /// Return an iterator to the entry for `key`, or a past-the-end iterator.
+    typename std::vector<value_type>::const_iterator _find(K const& key) const {
+        return std::find_if(_storage.cbegin(), _storage.cend(),
+                            [&key](value_type const& pair) { return pair.first == key; });
+    }
+
     /**
-     * Create a new back-end map that contains the same mappings as a GenericMap.
+     * Create a new back-end store that contains the same mappings as a GenericMap.
      *
      * @param map The map whose contents should be copied.
-     * @return a new map with the same mappings as `map`.
+     * @return a new store with the same mappings as `map`, in `map.keys()` order.
      *
      * @exceptsafe Provides strong exception-safety.
      */
-    static std::unordered_map<K, StorableType> _convertStorage(GenericMap<K> const& map) {
-        std::unordered_map<K, StorableType> newStorage;
-        map.apply([&newStorage](K const& key, auto const& value) { newStorage.emplace(key, value); });
+    static std::vector<value_type> _convertStorage(GenericMap<K> const& map) {
+        std::vector<value_type> newStorage;
+        newStorage.reserve(map.size());
+        map.apply([&newStorage](K const& key, auto const& value) { newStorage.emplace_back(key, value); });
         return newStorage;
     }
 };
@@ -26,6 +26,7 @@
 #include "ndarray/pybind11.h"
 
 #include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/image/Image.h"
 #include "lsst/afw/cameraGeom/Amplifier.h"
 
 namespace py = pybind11;
@@ -119,9 +120,22 @@ void declarePyAmplifierBuilder(PyAmplifier & parent) {
     cls.def("setRawHorizontalPrescanBBox", &Amplifier::Builder::setRawHorizontalPrescanBBox, "bbox"_a);
 }
 
+void declareMakeVariancePlane(py::module & mod) {
+    mod.def("makeVariancePlane", &makeVariancePlane<int, float>,
+            "image"_a, "variance"_a, "amplifiers"_a);
+    mod.def("makeVariancePlane", &makeVariancePlane<float, float>,
+            "image"_a, "variance"_a, "amplifiers"_a);
+    mod.def("makeVariancePlane", &makeVariancePlane<double, float>,
+            "image"_a, "variance"_a, "amplifiers"_a);
+    mod.def("makeVariancePlane", &makeVariancePlane<double, double>,
+            "image"_a, "variance"_a, "amplifiers"_a);
+}
+
 PYBIND11_MODULE(amplifier, mod) {
+    py::module::import("lsst.afw.image");
     auto cls = declarePyAmplifier(mod);
     declarePyAmplifierBuilder(cls);
+    declareMakeVariancePlane(mod);
 }
 
 }  // namespace
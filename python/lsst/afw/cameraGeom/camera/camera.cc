@@ -99,6 +99,18 @@ void declareCamera(py::module & mod) {
         },
         "points"_a, "fromSys"_a, "toSys"_a
     );
+    cls.def(
+        "transform",
+        py::overload_cast<std::map<int, std::vector<lsst::geom::Point2D>> const &,
+                          CameraSysPrefix const &, CameraSys const &>(&Camera::transform, py::const_),
+        "pointsByDetector"_a, "fromSys"_a, "toSys"_a
+    );
+    cls.def(
+        "transform",
+        py::overload_cast<std::map<int, std::vector<lsst::geom::Point2D>> const &,
+                          CameraSys const &, CameraSysPrefix const &>(&Camera::transform, py::const_),
+        "pointsByDetector"_a, "fromSys"_a, "toSys"_a
+    );
     table::io::python::addPersistableMethods(cls);
 }
 
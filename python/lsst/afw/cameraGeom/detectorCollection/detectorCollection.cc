@@ -80,6 +80,8 @@ void declareDetectorCollection(py::module & mod) {
     PyDetectorCollection cls(mod, "DetectorCollection");
     cls.def(py::init<DetectorCollection::List>());
     cls.def("getFpBBox", &DetectorCollection::getFpBBox);
+    cls.def("findDetectors", &DetectorCollection::findDetectors, "fpPosition"_a);
+    cls.def("findDetectorsList", &DetectorCollection::findDetectorsList, "fpPositionList"_a);
     table::io::python::addPersistableMethods(cls);
 }
 
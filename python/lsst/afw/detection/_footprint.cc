@@ -167,6 +167,8 @@ void wrapFootprint(WrapperCollection &wrappers) {
     wrappers.wrap([](auto &mod) {
         mod.def("mergeFootprints", &mergeFootprints);
         mod.def("footprintToBBoxList", &footprintToBBoxList);
+        mod.def("transformFootprints", &transformFootprints, "footprints"_a, "source"_a, "target"_a,
+                "region"_a, "doClip"_a = true);
     });
 }
 
@@ -71,6 +71,8 @@ void wrapFootprintCtrl(utils::python::WrapperCollection& wrappers) {
                 cls.def("setMaskVal", &HeavyFootprintCtrl::setMaskVal);
                 cls.def("getVarianceVal", &HeavyFootprintCtrl::getVarianceVal);
                 cls.def("setVarianceVal", &HeavyFootprintCtrl::setVarianceVal);
+                cls.def("getLazy", &HeavyFootprintCtrl::getLazy);
+                cls.def("setLazy", &HeavyFootprintCtrl::setLazy);
             });
 
     wrappers.wrapType(py::enum_<HeavyFootprintCtrl::ModifySource>(clsHeavyFootprintCtrl, "ModifySource"),
@@ -27,6 +27,7 @@
 #include "lsst/utils/python.h"
 
 #include "lsst/afw/detection/FootprintSet.h"
+#include "lsst/afw/math/Kernel.h"
 
 namespace py = pybind11;
 using namespace py::literals;
@@ -57,19 +58,26 @@ void declareMakeHeavy(PyClass &cls) {
 template <typename PixelT, typename PyClass>
 void declareSetMask(PyClass &cls) {
     cls.def("setMask",
-            (void (FootprintSet::*)(image::Mask<PixelT> *, std::string const &)) &
+            (void (FootprintSet::*)(image::Mask<PixelT> *, std::string const &, int)) &
                     FootprintSet::setMask<PixelT>,
-            "mask"_a, "planeName"_a);
+            "mask"_a, "planeName"_a, "numThreads"_a = 1);
 }
 
 template <typename PixelT, typename PyClass>
 void declareTemplatedMembers(PyClass &cls) {
     /* Constructors */
-    cls.def(py::init<image::Image<PixelT> const &, Threshold const &, int const, bool const>(), "img"_a,
-            "threshold"_a, "npixMin"_a = 1, "setPeaks"_a = true);
+    cls.def(py::init<image::Image<PixelT> const &, Threshold const &, int const, bool const, int>(), "img"_a,
+            "threshold"_a, "npixMin"_a = 1, "setPeaks"_a = true, "numThreads"_a = 1);
+    cls.def(py::init<image::Image<PixelT> const &, image::Image<float> const &, Threshold const &, int const,
+                     bool const, int>(),
+            "img"_a, "variance"_a, "threshold"_a, "npixMin"_a = 1, "setPeaks"_a = true, "numThreads"_a = 1);
     cls.def(py::init<image::MaskedImage<PixelT, image::MaskPixel> const &, Threshold const &,
-                     std::string const &, int const, bool const>(),
-            "img"_a, "threshold"_a, "planeName"_a = "", "npixMin"_a = 1, "setPeaks"_a = true);
+                     std::string const &, int const, bool const, int>(),
+            "img"_a, "threshold"_a, "planeName"_a = "", "npixMin"_a = 1, "setPeaks"_a = true,
+            "numThreads"_a = 1);
+
+    cls.def_static("makeMultiThreshold", &FootprintSet::makeMultiThreshold<PixelT>, "img"_a, "thresholds"_a,
+                   "npixMin"_a = 1, "setPeaks"_a = true);
 
     /* Members */
     declareMakeHeavy<int>(cls);
@@ -79,10 +87,17 @@ void declareTemplatedMembers(PyClass &cls) {
     //    declareMakeHeavy<std::uint64_t>(cls);
     declareSetMask<image::MaskPixel>(cls);
 }
+
+template <typename PixelT>
+void declareDetectOnConvolvedImage(py::module &mod) {
+    mod.def("detectOnConvolvedImage", &detectOnConvolvedImage<PixelT>, "img"_a, "kernel"_a, "threshold"_a,
+            "npixMin"_a = 1, "setPeaks"_a = true);
+}
 }  // namespace
 
 void wrapFootprintSet(utils::python::WrapperCollection &wrappers) {
     wrappers.addSignatureDependency("lsst.afw.image");
+    wrappers.addSignatureDependency("lsst.afw.math");
     wrappers.addSignatureDependency("lsst.afw.table");
 
     wrappers.wrapType(
@@ -93,6 +108,11 @@ void wrapFootprintSet(utils::python::WrapperCollection &wrappers) {
                 declareTemplatedMembers<float>(cls);
                 declareTemplatedMembers<double>(cls);
 
+                declareDetectOnConvolvedImage<std::uint16_t>(mod);
+                declareDetectOnConvolvedImage<int>(mod);
+                declareDetectOnConvolvedImage<float>(mod);
+                declareDetectOnConvolvedImage<double>(mod);
+
                 cls.def(py::init<image::Mask<image::MaskPixel> const &, Threshold const &, int const>(),
                         "img"_a, "threshold"_a, "npixMin"_a = 1);
 
@@ -115,15 +135,33 @@ void wrapFootprintSet(utils::python::WrapperCollection &wrappers) {
                 cls.def("setRegion", &FootprintSet::setRegion);
                 cls.def("getRegion", &FootprintSet::getRegion);
                 cls.def("insertIntoImage", &FootprintSet::insertIntoImage);
+                cls.def("findOverlapping",
+                        (std::vector<std::shared_ptr<Footprint>>(FootprintSet::*)(lsst::geom::Box2I const &)
+                                 const) &
+                                FootprintSet::findOverlapping,
+                        "box"_a);
+                cls.def("findOverlapping",
+                        (std::vector<std::shared_ptr<Footprint>>(FootprintSet::*)(geom::SpanSet const &)
+                                 const) &
+                                FootprintSet::findOverlapping,
+                        "spans"_a);
+                cls.def("findOverlapping",
+                        (std::vector<std::vector<std::shared_ptr<Footprint>>>(FootprintSet::*)(
+                                std::vector<lsst::geom::Box2I> const &) const) &
+                                FootprintSet::findOverlapping,
+                        "boxes"_a);
+                cls.def("invalidateIndex", &FootprintSet::invalidateIndex);
                 cls.def("setMask", (void (FootprintSet::*)(image::Mask<lsst::afw::image::MaskPixel> *,
-                                                           std::string const &)) &
-                                           FootprintSet::setMask<lsst::afw::image::MaskPixel>);
+                                                           std::string const &, int)) &
+                                           FootprintSet::setMask<lsst::afw::image::MaskPixel>,
+                        "mask"_a, "planeName"_a, "numThreads"_a = 1);
                 cls.def("setMask",
                         (void (FootprintSet::*)(std::shared_ptr<image::Mask<lsst::afw::image::MaskPixel>>,
-                                                std::string const &)) &
-                                FootprintSet::setMask<lsst::afw::image::MaskPixel>);
+                                                std::string const &, int)) &
+                                FootprintSet::setMask<lsst::afw::image::MaskPixel>,
+                        "mask"_a, "planeName"_a, "numThreads"_a = 1);
                 cls.def("merge", &FootprintSet::merge, "rhs"_a, "tGrow"_a = 0, "rGrow"_a = 0,
-                        "isotropic"_a = true);
+                        "isotropic"_a = true, "numThreads"_a = 1);
             });
 }
 
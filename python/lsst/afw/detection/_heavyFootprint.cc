@@ -69,6 +69,7 @@ void declareHeavyFootprint(WrapperCollection &wrappers, std::string const &suffi
                 cls.def("getVarianceArray",
                         (ndarray::Array<VariancePixelT, 1, 1>(Class::*)()) & Class::getVarianceArray);
                 cls.def("getMaskBitsSet", &Class::getMaskBitsSet);
+                cls.def("isMaterialized", &Class::isMaterialized);
                 cls.def("dot", &Class::dot);
             });
 
@@ -81,6 +82,19 @@ void declareHeavyFootprint(WrapperCollection &wrappers, std::string const &suffi
                 "foot"_a, "img"_a, "ctrl"_a = nullptr);
 
         mod.def("mergeHeavyFootprints", mergeHeavyFootprints<ImagePixelT, MaskPixelT, VariancePixelT>);
+
+        mod.def("insertHeavyFootprints",
+                (void (*)(std::vector<std::shared_ptr<Class const>> const &,
+                          lsst::afw::image::Image<ImagePixelT> &, int))
+                        insertHeavyFootprints<ImagePixelT, MaskPixelT, VariancePixelT>,
+                "heavies"_a, "image"_a, "numThreads"_a = 1);
+        mod.def("insertHeavyFootprints",
+                (void (*)(std::vector<std::shared_ptr<Class const>> const &,
+                          lsst::afw::image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> &, int))
+                        insertHeavyFootprints<ImagePixelT, MaskPixelT, VariancePixelT>,
+                "heavies"_a, "mimage"_a, "numThreads"_a = 1);
+        mod.def("makeHeavyFootprints", makeHeavyFootprints<ImagePixelT, MaskPixelT, VariancePixelT>,
+                "footprints"_a, "mimage"_a, "ctrl"_a = nullptr, "numThreads"_a = 1);
     });
 }
 }  // namespace
@@ -76,6 +76,7 @@ void declarePeakRecord(PyPeakRecord &cls) {
 @internal Declare constructors and member and static functions for a pybind11 PeakTable
 */
 void declarePeakTable(PyPeakTable &cls) {
+    cls.def_readwrite_static("nRecordsPerArenaBlock", &PeakTable::nRecordsPerArenaBlock);
     cls.def_static("make", &PeakTable::make, "schema"_a, "forceNew"_a = false);
     cls.def_static("makeMinimalSchema", &PeakTable::makeMinimalSchema);
     cls.def_static("checkSchema", &PeakTable::checkSchema, "schema"_a);
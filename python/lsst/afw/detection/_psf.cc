@@ -25,6 +25,8 @@
 
 #include <pybind11/pybind11.h>
 
+#include "ndarray/pybind11.h"
+
 #include "lsst/utils/python.h"
 #include "lsst/utils/python/PySharedPtr.h"
 
@@ -67,10 +69,14 @@ void wrapPsf(utils::python::WrapperCollection& wrappers) {
                         "color"_a = image::Color(), "owner"_a = Psf::ImageOwnerEnum::COPY);
                 cls.def("computeKernelImage", &Psf::computeKernelImage, "position"_a = NullPoint,
                         "color"_a = image::Color(), "owner"_a = Psf::ImageOwnerEnum::COPY);
+                cls.def("computeImageBatch", &Psf::computeImageBatch, "positions"_a,
+                        "color"_a = image::Color());
                 cls.def("computePeak", &Psf::computePeak, "position"_a = NullPoint,
                         "color"_a = image::Color());
                 cls.def("computeApertureFlux", &Psf::computeApertureFlux, "radius"_a,
                         "position"_a = NullPoint, "color"_a = image::Color());
+                cls.def("computeApertureFluxBatch", &Psf::computeApertureFluxBatch, "radii"_a,
+                        "positions"_a, "color"_a = image::Color());
                 cls.def("computeShape", &Psf::computeShape, "position"_a = NullPoint,
                         "color"_a = image::Color());
                 cls.def("computeBBox", &Psf::computeBBox, "position"_a = NullPoint,
@@ -83,6 +89,8 @@ void wrapPsf(utils::python::WrapperCollection& wrappers) {
                                "warpAlgorithm"_a = "lanczos5", "warpBuffer"_a = 5);
                 cls.def("getCacheCapacity", &Psf::getCacheCapacity);
                 cls.def("setCacheCapacity", &Psf::setCacheCapacity);
+                cls.def("getCachePositionTolerance", &Psf::getCachePositionTolerance);
+                cls.def("setCachePositionTolerance", &Psf::setCachePositionTolerance);
             });
 
     wrappers.wrapType(py::enum_<Psf::ImageOwnerEnum>(clsPsf, "ImageOwnerEnum"), [](auto& mod, auto& enm) {
@@ -150,10 +150,23 @@ void declareImageWriteOptions(py::module & mod) {
 
     cls.def_readonly("compression", &ImageWriteOptions::compression);
     cls.def_readonly("scaling", &ImageWriteOptions::scaling);
+    cls.def_readwrite("threads", &ImageWriteOptions::threads);
 
     cls.def_static("validate", &ImageWriteOptions::validate);
 }
 
+template <typename T>
+void declareImageStripWriter(py::module & mod, std::string const& suffix) {
+    py::class_<ImageStripWriter<T>> cls(mod, ("ImageStripWriter" + suffix).c_str());
+
+    cls.def(py::init<std::string const&, lsst::geom::Box2I const&, ImageWriteOptions const&,
+                     std::shared_ptr<lsst::daf::base::PropertySet const>>(),
+            "fileName"_a, "bbox"_a, "options"_a=ImageWriteOptions(), "header"_a=nullptr);
+
+    cls.def("writeStrip", &ImageStripWriter<T>::writeStrip, "strip"_a);
+    cls.def("close", &ImageStripWriter<T>::close);
+}
+
 // Wrapping for lsst::afw::fits::Fits
 //
 // Not every feature is wrapped, only those that we guess might be useful.
@@ -198,6 +211,7 @@ void declareFits(py::module & mod) {
 PYBIND11_MODULE(fits, mod) {
     py::class_<MemFileManager> clsMemFileManager(mod, "MemFileManager");
 
+    py::module::import("lsst.geom");
     py::module::import("lsst.pex.exceptions");
 
     lsst::pex::exceptions::python::declareException<FitsError, lsst::pex::exceptions::IoError>(
@@ -211,6 +225,8 @@ PYBIND11_MODULE(fits, mod) {
     /* TODO: We should really revisit persistence and pickling as this is quite ugly.
      * But it is what Swig did (sort of, it used the cdata.i extension), so I reckon this
      * is cleaner because it does not expose casting to the Python side. */
+    clsMemFileManager.def("resetMmap", &MemFileManager::resetMmap, "len"_a,
+                          "reserve"_a = std::size_t(1) << 32);
     clsMemFileManager.def("getLength", &MemFileManager::getLength);
     clsMemFileManager.def("getData", [](MemFileManager &m) {
         return py::bytes(static_cast<char *>(m.getData()), m.getLength());
@@ -223,10 +239,26 @@ PYBIND11_MODULE(fits, mod) {
                               return readMetadata(self, hdu, strip);
                           }, "hdu"_a=DEFAULT_HDU, "strip"_a=false);
 
+    py::class_<FitsHandlePool::Lease> clsFitsHandleLease(mod, "FitsHandleLease");
+    clsFitsHandleLease.def(
+            "get", [](FitsHandlePool::Lease &self) -> Fits & { return *self; },
+            py::return_value_policy::reference_internal);
+
+    py::class_<FitsHandlePool> clsFitsHandlePool(mod, "FitsHandlePool");
+    clsFitsHandlePool.def(py::init<std::string const &>(), "fileName"_a);
+    // keep the pool alive as long as any lease it hands out
+    clsFitsHandlePool.def("acquire", &FitsHandlePool::acquire, py::keep_alive<0, 1>());
+    clsFitsHandlePool.def("getFileName", &FitsHandlePool::getFileName);
+
     declareImageCompression(mod);
     declareImageScalingOptions(mod);
     declareImageScale(mod);
     declareImageWriteOptions(mod);
+    declareImageStripWriter<std::uint16_t>(mod, "U");
+    declareImageStripWriter<int>(mod, "I");
+    declareImageStripWriter<float>(mod, "F");
+    declareImageStripWriter<double>(mod, "D");
+    declareImageStripWriter<std::uint64_t>(mod, "L");
     declareFits(mod);
 
     mod.attr("DEFAULT_HDU") = DEFAULT_HDU;
@@ -237,6 +269,7 @@ PYBIND11_MODULE(fits, mod) {
             [](std::string const& filename, int hdu=DEFAULT_HDU, bool strip=false) {
                 return readMetadata(filename, hdu, strip);
             }, "fileName"_a, "hdu"_a=DEFAULT_HDU, "strip"_a=false);
+    mod.def("prefetchFitsFile", &prefetchFitsFile, "fileName"_a);
     mod.def("setAllowImageCompression", &setAllowImageCompression, "allow"_a);
     mod.def("getAllowImageCompression", &getAllowImageCompression);
 
@@ -17,7 +17,8 @@ class Fits:  # noqa: F811
 @continueClass  # noqa: F811 (FIXME: remove for py 3.8+)
 class ImageWriteOptions:  # noqa: F811
     def __repr__(self):
-        return f"{self.__class__.__name__}(compression={self.compression!r}, scaling={self.scaling!r})"
+        return (f"{self.__class__.__name__}(compression={self.compression!r}, "
+                f"scaling={self.scaling!r}, threads={self.threads})")
 
 
 @continueClass  # noqa: F811 (FIXME: remove for py 3.8+)
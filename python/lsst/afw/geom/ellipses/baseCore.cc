@@ -28,6 +28,7 @@
 
 #include "lsst/afw/geom/ellipses/BaseCore.h"
 #include "lsst/afw/geom/ellipses/Convolution.h"
+#include "lsst/afw/geom/ellipses/GridTransform.h"
 #include "lsst/afw/geom/ellipses/Transformer.h"
 
 namespace py = pybind11;
@@ -78,4 +79,21 @@ PYBIND11_MODULE(baseCore, mod) {
     //    {
     //       self.transform(t).inPlace();
     //    });
+
+    py::class_<CompiledGridTransform> clsCompiledGridTransform(mod, "CompiledGridTransform");
+
+    clsCompiledGridTransform.def(py::init<BaseCore const &>());
+    clsCompiledGridTransform.def(py::init<Ellipse const &>());
+
+    clsCompiledGridTransform.def("getTransform", &CompiledGridTransform::getTransform);
+    clsCompiledGridTransform.def("getDeterminant", &CompiledGridTransform::getDeterminant);
+    clsCompiledGridTransform.def(
+            "__call__", (lsst::geom::Point2D(CompiledGridTransform::*)(lsst::geom::Point2D const &) const) &
+                                CompiledGridTransform::operator());
+    clsCompiledGridTransform.def(
+            "__call__",
+            (std::pair<ndarray::Array<double, 1, 1>, ndarray::Array<double, 1, 1>>(
+                    CompiledGridTransform::*)(ndarray::Array<double const, 1> const &,
+                                              ndarray::Array<double const, 1> const &) const) &
+                    CompiledGridTransform::operator());
 }
\ No newline at end of file
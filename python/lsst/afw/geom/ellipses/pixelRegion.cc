@@ -22,6 +22,7 @@
 
 #include "pybind11/pybind11.h"
 
+#include "lsst/afw/geom/SpanSet.h"
 #include "lsst/afw/geom/ellipses/PixelRegion.h"
 
 namespace py = pybind11;
@@ -36,6 +37,8 @@ PYBIND11_MODULE(pixelRegion, mod) {
 
     /* Members */
     clsPixelRegion.def("getBBox", &PixelRegion::getBBox, py::return_value_policy::copy);
+    clsPixelRegion.def("getSpans",
+                       [](PixelRegion const &self) { return self.getSpans(); });
     clsPixelRegion.def("getSpanAt", &PixelRegion::getSpanAt);
     clsPixelRegion.def("__iter__",
                        [](const PixelRegion &self) { return py::make_iterator(self.begin(), self.end()); },
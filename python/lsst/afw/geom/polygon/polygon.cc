@@ -25,6 +25,8 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include "ndarray/pybind11.h"
+
 #include "lsst/pex/exceptions/Runtime.h"
 #include "lsst/pex/exceptions/python/Exception.h"
 #include "lsst/geom/Box.h"
@@ -80,7 +82,12 @@ PYBIND11_MODULE(polygon, mod) {
     clsPolygon.def("calculatePerimeter", &Polygon::calculatePerimeter);
     clsPolygon.def("getVertices", &Polygon::getVertices);
     clsPolygon.def("getEdges", &Polygon::getEdges);
-    clsPolygon.def("contains", &Polygon::contains);
+    clsPolygon.def("contains", (bool (Polygon::*)(Polygon::Point const &) const) & Polygon::contains);
+    clsPolygon.def("contains",
+                   (ndarray::Array<bool, 1, 1>(Polygon::*)(ndarray::Array<double const, 1> const &,
+                                                           ndarray::Array<double const, 1> const &) const) &
+                           Polygon::contains,
+                   "x"_a, "y"_a);
     clsPolygon.def("overlaps", (bool (Polygon::*)(Polygon const &) const) & Polygon::overlaps);
     clsPolygon.def("overlaps", (bool (Polygon::*)(Polygon::Box const &) const) & Polygon::overlaps);
     clsPolygon.def("intersectionSingle", (std::shared_ptr<Polygon>(Polygon::*)(Polygon const &) const) &
@@ -97,6 +97,7 @@ PYBIND11_MODULE(sipApproximation, mod) {
     cls.def("updateGrid", &SipApproximation::updateGrid, "shape"_a);
     cls.def("refineGrid", &SipApproximation::refineGrid, "factor"_a=2);
     cls.def("fit", &SipApproximation::fit, "order"_a, "svdThreshold"_a=-1);
+    cls.def("updateTransform", &SipApproximation::updateTransform, "pixelToIwc"_a);
     cls.def("computeMaxDeviation", &SipApproximation::computeMaxDeviation);
 }
 
@@ -55,7 +55,15 @@ PYBIND11_MODULE(skyWcs, mod) {
     mod.def("makeCdMatrix", makeCdMatrix, "scale"_a, "orientation"_a = 0 * lsst::geom::degrees,
             "flipX"_a = false);
     mod.def("makeFlippedWcs", makeFlippedWcs, "wcs"_a, "flipLR"_a, "flipTB"_a, "center"_a);
-    mod.def("makeModifiedWcs", makeModifiedWcs, "pixelTransform"_a, "wcs"_a, "modifyActualPixels"_a);
+    mod.def("makeModifiedWcs",
+            (std::shared_ptr<SkyWcs>(*)(TransformPoint2ToPoint2 const &, SkyWcs const &, bool))
+                    makeModifiedWcs,
+            "pixelTransform"_a, "wcs"_a, "modifyActualPixels"_a);
+    mod.def("makeModifiedWcs",
+            (std::vector<std::shared_ptr<SkyWcs>>(*)(TransformPoint2ToPoint2 const &,
+                                                     std::vector<std::shared_ptr<SkyWcs const>> const &,
+                                                     bool))makeModifiedWcs,
+            "pixelTransform"_a, "wcsList"_a, "modifyActualPixels"_a);
     mod.def("makeSkyWcs",
             (std::shared_ptr<SkyWcs>(*)(lsst::geom::Point2D const &, lsst::geom::SpherePoint const &,
                                         Eigen::Matrix2d const &, std::string const &))makeSkyWcs,
@@ -93,6 +101,7 @@ PYBIND11_MODULE(skyWcs, mod) {
     table::io::python::addPersistableMethods<SkyWcs>(cls);
 
     cls.def("copyAtShiftedPixelOrigin", &SkyWcs::copyAtShiftedPixelOrigin, "shift"_a);
+    cls.def("deepCopy", &SkyWcs::deepCopy);
     cls.def("getFitsMetadata", &SkyWcs::getFitsMetadata, "precise"_a = false);
     cls.def("getPixelScale",
             (lsst::geom::Angle(SkyWcs::*)(lsst::geom::Point2D const &) const) & SkyWcs::getPixelScale,
@@ -138,7 +147,7 @@ PYBIND11_MODULE(skyWcs, mod) {
             (std::vector<lsst::geom::SpherePoint>(SkyWcs::*)(std::vector<lsst::geom::Point2D> const &)
                      const) &
                     SkyWcs::pixelToSky,
-            "pixel"_a);
+            "pixel"_a, py::call_guard<py::gil_scoped_release>());
     cls.def("skyToPixel",
             (lsst::geom::Point2D(SkyWcs::*)(lsst::geom::SpherePoint const &) const) & SkyWcs::skyToPixel,
             "sky"_a);
@@ -146,7 +155,7 @@ PYBIND11_MODULE(skyWcs, mod) {
             (std::vector<lsst::geom::Point2D>(SkyWcs::*)(std::vector<lsst::geom::SpherePoint> const &)
                      const) &
                     SkyWcs::skyToPixel,
-            "sky"_a);
+            "sky"_a, py::call_guard<py::gil_scoped_release>());
     // Do not wrap getShortClassName because it returns the name of the class;
     // use `<class>.__name__` or `type(<instance>).__name__` instead.
     // Do not wrap readStream or writeStream because C++ streams are not easy to wrap.
@@ -54,6 +54,23 @@ PYBIND11_MODULE(transformFactory, mod) {
                     makeRadialTransform,
             "forwardCoeffs"_a, "inverseCoeffs"_a);
     mod.def("makeIdentityTransform", &makeIdentityTransform);
+
+    py::class_<TiledAffineApproximation> clsTiled(mod, "TiledAffineApproximation");
+    clsTiled.def("getBBox", &TiledAffineApproximation::getBBox);
+    clsTiled.def("getTolerance", &TiledAffineApproximation::getTolerance);
+    clsTiled.def("getShape", &TiledAffineApproximation::getShape);
+    clsTiled.def("applyForward",
+                 (lsst::geom::Point2D(TiledAffineApproximation::*)(lsst::geom::Point2D const &) const) &
+                         TiledAffineApproximation::applyForward,
+                 "point"_a);
+    clsTiled.def("applyForward",
+                 (std::vector<lsst::geom::Point2D>(TiledAffineApproximation::*)(
+                         std::vector<lsst::geom::Point2D> const &) const) &
+                         TiledAffineApproximation::applyForward,
+                 "points"_a);
+
+    mod.def("makeTiledAffineApproximation", &makeTiledAffineApproximation, "original"_a, "bbox"_a,
+            "tolerance"_a);
 }
 
 }  // namespace
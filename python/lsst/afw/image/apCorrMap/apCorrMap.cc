@@ -23,6 +23,8 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include "ndarray/pybind11.h"
+
 #include <string>
 #include <vector>
 
@@ -62,6 +64,7 @@ PYBIND11_MODULE(apCorrMap, mod) {
     cls.def("set", &ApCorrMap::set);
     cls.def("items", [](ApCorrMap const& self) { return py::make_iterator(self.begin(), self.end()); },
             py::keep_alive<0, 1>());
+    cls.def("evaluateAll", &ApCorrMap::evaluateAll, "x"_a, "y"_a);
     // values, keys, and __iter__ defined in apCorrMap.py
 
     cls.def("__len__", &ApCorrMap::size);
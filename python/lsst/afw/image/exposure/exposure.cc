@@ -144,6 +144,9 @@ PyExposure<PixelT> declareExposure(py::module &mod, const std::string &suffix) {
     cls.def_static("readFits", (ExposureT(*)(std::string const &))ExposureT::readFits);
     cls.def_static("readFits", (ExposureT(*)(fits::MemFileManager &))ExposureT::readFits);
 
+    cls.def("writeSnapshot", &ExposureT::writeSnapshot, "fileName"_a);
+    cls.def_static("readSnapshot", &ExposureT::readSnapshot, "fileName"_a);
+
     cls.def("getCutout", &ExposureT::getCutout, "center"_a, "size"_a);
 
     return cls;
@@ -215,6 +215,13 @@ static void declareMask(py::module &mod, std::string const &suffix) {
     cls.def_static("interpret", Mask<MaskPixelT>::interpret);
     cls.def("subset", &Mask<MaskPixelT>::subset, "bbox"_a, "origin"_a = PARENT);
     cls.def("getAsString", &Mask<MaskPixelT>::getAsString);
+    cls.def("countMaskBits",
+            (std::size_t (Mask<MaskPixelT>::*)(MaskPixelT) const) & Mask<MaskPixelT>::countMaskBits,
+            "planeMask"_a = ~MaskPixelT(0));
+    cls.def("countMaskBits",
+            (std::size_t (Mask<MaskPixelT>::*)(MaskPixelT, lsst::geom::Box2I const &, ImageOrigin) const) &
+                    Mask<MaskPixelT>::countMaskBits,
+            "planeMask"_a, "bbox"_a, "origin"_a = PARENT);
     cls.def("clearAllMaskPlanes", &Mask<MaskPixelT>::clearAllMaskPlanes);
     cls.def("clearMaskPlane", &Mask<MaskPixelT>::clearMaskPlane);
     cls.def("setMaskPlaneValues", &Mask<MaskPixelT>::setMaskPlaneValues);
@@ -343,6 +350,11 @@ static void declareDecoratedImage(py::module &mod, std::string const &suffix) {
     cls.def(py::init<std::string const &, const int, lsst::geom::Box2I const &, ImageOrigin const, bool>(),
             "fileName"_a, "hdu"_a = fits::DEFAULT_HDU, "bbox"_a = lsst::geom::Box2I(), "origin"_a = PARENT,
             "allowUnsafe"_a = false);
+    cls.def_static("readFitsOverlapped", &DecoratedImage<PixelT>::readFitsOverlapped, "fileName"_a,
+                   "hdu"_a = fits::DEFAULT_HDU, "bbox"_a = lsst::geom::Box2I(), "origin"_a = PARENT,
+                   "allowUnsafe"_a = false, py::call_guard<py::gil_scoped_release>());
+    cls.def_static("readMetadata", &DecoratedImage<PixelT>::readMetadata, "fileName"_a,
+                   "hdu"_a = fits::DEFAULT_HDU);
 
     cls.def("getMetadata", &DecoratedImage<PixelT>::getMetadata);
     cls.def("setMetadata", &DecoratedImage<PixelT>::setMetadata);
@@ -479,6 +491,12 @@ PYBIND11_MODULE(image, mod) {
     // as wrapping the Image version here results in it being invisible in lsst.afw.image
 
     mod.def("bboxFromMetadata", &bboxFromMetadata);
+
+    mod.def("extractCutouts", &extractCutouts<int>, "parent"_a, "boxes"_a);
+    mod.def("extractCutouts", &extractCutouts<float>, "parent"_a, "boxes"_a);
+    mod.def("extractCutouts", &extractCutouts<double>, "parent"_a, "boxes"_a);
+    mod.def("extractCutouts", &extractCutouts<std::uint16_t>, "parent"_a, "boxes"_a);
+    mod.def("extractCutouts", &extractCutouts<std::uint64_t>, "parent"_a, "boxes"_a);
 }
 }  // namespace
 }  // namespace image
@@ -118,6 +118,7 @@ PyMaskedImage<ImagePixelT> declareMaskedImage(py::module &mod, const std::string
     cls.def("__itruediv__", (MI & (MI::*)(MI const &)) & MI::operator/=);
     cls.def("__itruediv__", (MI & (MI::*)(Image<ImagePixelT> const &)) & MI::operator/=);
     cls.def("scaledDivides", &MI::scaledDivides);
+    cls.def("setWhere", &MI::setWhere, "planeMask"_a, "value"_a);
 
     /* Members */
     cls.def("writeFits",
@@ -187,6 +188,21 @@ PyMaskedImage<ImagePixelT> declareMaskedImage(py::module &mod, const std::string
     cls.def("getVariance", &MI::getVariance);
     cls.def("setVariance", &MI::setVariance);
     cls.def_property("variance", &MI::getVariance, &MI::setVariance);
+    cls.def("setVarianceGenerator",
+            [](MI &self, py::object generator) {
+                if (generator.is_none()) {
+                    throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                                      "Variance generator must not be None");
+                }
+                // The generator may run from C++ threads, so reacquire the GIL
+                // before calling back into Python.
+                self.setVarianceGenerator([generator]() -> typename MI::VariancePtr {
+                    py::gil_scoped_acquire gil;
+                    return generator().template cast<typename MI::VariancePtr>();
+                });
+            },
+            "generator"_a);
+    cls.def("isVarianceDeferred", &MI::isVarianceDeferred);
     cls.def("getWidth", &MI::getWidth);
     cls.def("getHeight", &MI::getHeight);
     cls.def("getDimensions", &MI::getDimensions);
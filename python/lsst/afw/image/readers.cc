@@ -20,6 +20,7 @@
  */
 
 #include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
 
 #include "ndarray/pybind11.h"
 
@@ -29,6 +30,7 @@
 #include "lsst/afw/image/MaskFitsReader.h"
 #include "lsst/afw/image/MaskedImageFitsReader.h"
 #include "lsst/afw/image/ExposureFitsReader.h"
+#include "lsst/afw/image/ExposurePrefetcher.h"
 #include "lsst/afw/geom/SkyWcs.h"
 #include "lsst/afw/geom/polygon/Polygon.h"
 #include "lsst/afw/detection/Psf.h"
@@ -263,20 +265,21 @@ void declareMaskedImageFitsReader(py::module & mod) {
     cls.def(
         "read",
         [](MaskedImageFitsReader & self, lsst::geom::Box2I const & bbox, ImageOrigin origin,
-           bool conformMasks, bool needAllHdus, bool allowUnsafe, py::object dtype) {
+           bool conformMasks, bool needAllHdus, bool allowUnsafe, bool lazyVariance, py::object dtype) {
             if (dtype.is(py::none())) {
                 dtype = py::dtype(self.readImageDType());
             }
             return utils::python::TemplateInvoker().apply(
                 [&](auto t) {
-                    return self.read<decltype(t)>(bbox, origin, conformMasks, allowUnsafe);
+                    return self.read<decltype(t)>(bbox, origin, conformMasks, needAllHdus, allowUnsafe,
+                                                  lazyVariance);
                 },
                 py::dtype(dtype),
                 utils::python::TemplateInvoker::Tag<std::uint16_t, int, float, double, std::uint64_t>()
             );
         },
         "bbox"_a=lsst::geom::Box2I(), "origin"_a=PARENT, "conformMasks"_a=false, "needAllHdus"_a=false,
-        "allowUnsafe"_a=false, "dtype"_a=py::none()
+        "allowUnsafe"_a=false, "lazyVariance"_a=false, "dtype"_a=py::none()
     );
 }
 
@@ -299,46 +302,70 @@ void declareExposureFitsReader(py::module & mod) {
     cls.def("readTransmissionCurve", &ExposureFitsReader::readTransmissionCurve);
     cls.def("readComponent", &ExposureFitsReader::readComponent);
     cls.def("readDetector", &ExposureFitsReader::readDetector);
-    cls.def("readExposureInfo", &ExposureFitsReader::readExposureInfo);
+    cls.def("readExposureInfo", &ExposureFitsReader::readExposureInfo, "lazy"_a=false);
     cls.def(
         "readMaskedImage",
         [](ExposureFitsReader & self, lsst::geom::Box2I const & bbox, ImageOrigin origin,
-           bool conformMasks, bool allowUnsafe, py::object dtype) {
+           bool conformMasks, bool allowUnsafe, bool lazyVariance, py::object dtype) {
             if (dtype.is(py::none())) {
                 dtype = py::dtype(self.readImageDType());
             }
             return utils::python::TemplateInvoker().apply(
                 [&](auto t) {
-                    return self.readMaskedImage<decltype(t)>(bbox, origin, conformMasks, allowUnsafe);
+                    return self.readMaskedImage<decltype(t)>(bbox, origin, conformMasks, allowUnsafe,
+                                                             lazyVariance);
                 },
                 py::dtype(dtype),
                 utils::python::TemplateInvoker::Tag<std::uint16_t, int, float, double, std::uint64_t>()
             );
         },
         "bbox"_a=lsst::geom::Box2I(), "origin"_a=PARENT, "conformMasks"_a=false, "allowUnsafe"_a=false,
-        "dtype"_a=py::none()
+        "lazyVariance"_a=false, "dtype"_a=py::none()
     );
     cls.def(
         "read",
         [](ExposureFitsReader & self, lsst::geom::Box2I const & bbox, ImageOrigin origin,
-           bool conformMasks, bool allowUnsafe, py::object dtype) {
+           bool conformMasks, bool allowUnsafe, bool lazyComponents, bool lazyVariance, py::object dtype) {
             if (dtype.is(py::none())) {
                 dtype = py::dtype(self.readImageDType());
             }
             return utils::python::TemplateInvoker().apply(
                 [&](auto t) {
-                    return self.read<decltype(t)>(bbox, origin, conformMasks, allowUnsafe);
+                    return self.read<decltype(t)>(bbox, origin, conformMasks, allowUnsafe,
+                                                  lazyComponents, lazyVariance);
                 },
                 py::dtype(dtype),
                 utils::python::TemplateInvoker::Tag<std::uint16_t, int, float, double, std::uint64_t>()
             );
         },
         "bbox"_a=lsst::geom::Box2I(), "origin"_a=PARENT, "conformMasks"_a=false, "allowUnsafe"_a=false,
-        "dtype"_a=py::none()
+        "lazyComponents"_a=false, "lazyVariance"_a=false, "dtype"_a=py::none()
     );
 }
 
 
+template <typename ImagePixelT>
+void declareExposurePrefetcher(py::module & mod, std::string const & suffix) {
+    using Class = ExposurePrefetcher<ImagePixelT>;
+    py::class_<Class, std::shared_ptr<Class>> cls(mod, ("ExposurePrefetcher" + suffix).c_str());
+    cls.def(py::init<std::vector<std::string>, std::size_t, int, bool>(),
+            "fileNames"_a, "readAhead"_a=2, "numThreads"_a=1, "allowUnsafe"_a=false);
+    cls.def("size", &Class::size);
+    cls.def("__len__", &Class::size);
+    cls.def("hasNext", &Class::hasNext);
+    // next() blocks until the file is read, so release the GIL; the reader
+    // threads never touch Python
+    cls.def("next", &Class::next, py::call_guard<py::gil_scoped_release>());
+    cls.def("__iter__", [](py::object self) { return self; });
+    cls.def("__next__", [](Class & self) {
+        if (!self.hasNext()) {
+            throw py::stop_iteration();
+        }
+        py::gil_scoped_release release;
+        return self.next();
+    });
+}
+
 PYBIND11_MODULE(readers, mod) {
     py::module::import("lsst.daf.base");
     py::module::import("lsst.geom");
@@ -349,6 +376,11 @@ PYBIND11_MODULE(readers, mod) {
     declareMaskFitsReader(mod);
     declareMaskedImageFitsReader(mod);
     declareExposureFitsReader(mod);
+    declareExposurePrefetcher<std::uint16_t>(mod, "U");
+    declareExposurePrefetcher<int>(mod, "I");
+    declareExposurePrefetcher<float>(mod, "F");
+    declareExposurePrefetcher<double>(mod, "D");
+    declareExposurePrefetcher<std::uint64_t>(mod, "L");
 }
 
 }}}}  // namespace lsst::afw::image::<anonymous>
@@ -59,6 +59,7 @@ void define(PyTransmissionCurve & cls) {
     cls.def("__mul__", &TransmissionCurve::multipliedBy, py::is_operator());
     cls.def("multipliedBy", &TransmissionCurve::multipliedBy);
     cls.def("transformedBy", &TransmissionCurve::transformedBy, "transform"_a);
+    cls.def("compiledAt", &TransmissionCurve::compiledAt, "wavelengths"_a, "bbox"_a, "gridShape"_a);
     cls.def("getWavelengthBounds", &TransmissionCurve::getWavelengthBounds);
     cls.def("getThroughputAtBounds", &TransmissionCurve::getThroughputAtBounds);
     cls.def(
@@ -0,0 +1,33 @@
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#include <pybind11/pybind11.h>
+#include <pybind11/stl.h>
+
+#include "lsst/afw/instrumentation.h"
+
+namespace py = pybind11;
+
+PYBIND11_MODULE(instrumentation, mod) {
+    mod.def("snapshot", &lsst::afw::instrumentation::snapshot,
+            "Return a dict mapping metric name to its cumulative value, summed over all threads.");
+}
@@ -63,8 +63,8 @@ PYBIND11_MODULE(approximate, mod) {
             .value("NUM_STYLES", ApproximateControl::Style::NUM_STYLES)
             .export_values();
 
-    clsApproximateControl.def(py::init<ApproximateControl::Style, int, int, bool>(), "style"_a, "orderX"_a,
-                              "orderY"_a = -1, "weighting"_a = true);
+    clsApproximateControl.def(py::init<ApproximateControl::Style, int, int, bool, int>(), "style"_a,
+                              "orderX"_a, "orderY"_a = -1, "weighting"_a = true, "numThreads"_a = 1);
 
     clsApproximateControl.def("getStyle", &ApproximateControl::getStyle);
     clsApproximateControl.def("setStyle", &ApproximateControl::setStyle);
@@ -74,6 +74,8 @@ PYBIND11_MODULE(approximate, mod) {
     clsApproximateControl.def("setOrderY", &ApproximateControl::setOrderY);
     clsApproximateControl.def("getWeighting", &ApproximateControl::getWeighting);
     clsApproximateControl.def("setWeighting", &ApproximateControl::setWeighting);
+    clsApproximateControl.def("getNumThreads", &ApproximateControl::getNumThreads);
+    clsApproximateControl.def("setNumThreads", &ApproximateControl::setNumThreads);
 
     // Yes, really only float
     declareApproximate<float>(mod, "F");
@@ -159,6 +159,25 @@ PYBIND11_MODULE(background, mod) {
     /* Members */
     clsBackgroundMI.def("getStatsImage", &BackgroundMI::getStatsImage);
     clsBackgroundMI.def("getImageBBox", &BackgroundMI::getImageBBox);
+    clsBackgroundMI.def("updateRegion",
+                        (void (BackgroundMI::*)(image::Image<float> const &, lsst::geom::Box2I const &)) &
+                                BackgroundMI::updateRegion,
+                        "img"_a, "region"_a);
+    clsBackgroundMI.def(
+            "updateRegion",
+            (void (BackgroundMI::*)(image::MaskedImage<float> const &, lsst::geom::Box2I const &)) &
+                    BackgroundMI::updateRegion,
+            "img"_a, "region"_a);
+
+    clsBackground.def("getCellBox", &Background::getCellBox, "iX"_a, "iY"_a);
+
+    py::class_<IterativeBackgroundSubtractor<float>, std::shared_ptr<IterativeBackgroundSubtractor<float>>>
+            clsIterativeBackgroundSubtractor(mod, "IterativeBackgroundSubtractorF");
+    clsIterativeBackgroundSubtractor.def(py::init<BackgroundControl const &>(), "bgCtrl"_a);
+    clsIterativeBackgroundSubtractor.def("subtract", &IterativeBackgroundSubtractor<float>::subtract,
+                                         "image"_a);
+    clsIterativeBackgroundSubtractor.def("getBackground",
+                                         &IterativeBackgroundSubtractor<float>::getBackground);
 
     // Yes, really only float
     declareMakeBackground<image::Image<float>>(mod);
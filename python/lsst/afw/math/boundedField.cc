@@ -49,13 +49,13 @@ using PyClass = py::class_<BoundedField, std::shared_ptr<BoundedField>>;
 template <typename PixelT>
 void declareTemplates(PyClass &cls) {
     cls.def("fillImage", &BoundedField::fillImage<PixelT>,
-            "image"_a, "overlapOnly"_a = false, "xStep"_a = 1, "yStep"_a = 1);
+            "image"_a, "overlapOnly"_a = false, "xStep"_a = 1, "yStep"_a = 1, "numThreads"_a = 1);
     cls.def("addToImage", &BoundedField::addToImage<PixelT>, "image"_a, "scaleBy"_a = 1.0,
-            "overlapOnly"_a = false, "xStep"_a = 1, "yStep"_a = 1);
+            "overlapOnly"_a = false, "xStep"_a = 1, "yStep"_a = 1, "numThreads"_a = 1);
     cls.def("multiplyImage", &BoundedField::multiplyImage<PixelT>,
-            "image"_a, "overlapOnly"_a = false, "xStep"_a = 1, "yStep"_a = 1);
+            "image"_a, "overlapOnly"_a = false, "xStep"_a = 1, "yStep"_a = 1, "numThreads"_a = 1);
     cls.def("divideImage", &BoundedField::divideImage<PixelT>,
-            "image"_a, "overlapOnly"_a = false, "xStep"_a = 1, "yStep"_a = 1);
+            "image"_a, "overlapOnly"_a = false, "xStep"_a = 1, "yStep"_a = 1, "numThreads"_a = 1);
 }
 
 PYBIND11_MODULE(boundedField, mod) {
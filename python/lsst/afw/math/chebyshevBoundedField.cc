@@ -52,6 +52,8 @@ PYBIND11_MODULE(chebyshevBoundedField, mod) {
     py::class_<ChebyshevBoundedFieldControl> clsChebyshevBoundedFieldControl(mod,
                                                                              "ChebyshevBoundedFieldControl");
     ClsField clsChebyshevBoundedField(mod, "ChebyshevBoundedField");
+    py::class_<ChebyshevBoundedFieldFitter> clsChebyshevBoundedFieldFitter(mod,
+                                                                           "ChebyshevBoundedFieldFitter");
 
     /* Member types and enums */
     using Control = ChebyshevBoundedFieldControl;
@@ -87,6 +89,16 @@ PYBIND11_MODULE(chebyshevBoundedField, mod) {
 
     clsChebyshevBoundedField.def("truncate", &ChebyshevBoundedField::truncate);
 
+    clsChebyshevBoundedFieldFitter.def(
+            py::init<lsst::geom::Box2I const &, ndarray::Array<double const, 1> const &,
+                     ndarray::Array<double const, 1> const &, Control const &>());
+    clsChebyshevBoundedFieldFitter.def(
+            py::init<lsst::geom::Box2I const &, ndarray::Array<double const, 1> const &,
+                     ndarray::Array<double const, 1> const &, ndarray::Array<double const, 1> const &,
+                     Control const &>());
+    clsChebyshevBoundedFieldFitter.def("fit", &ChebyshevBoundedFieldFitter::fit);
+    clsChebyshevBoundedFieldFitter.def("getNumPoints", &ChebyshevBoundedFieldFitter::getNumPoints);
+
     // Pybind11 resolves overloads by picking the first one that might work
     declareTemplates<double>(clsChebyshevBoundedField);
     declareTemplates<float>(clsChebyshevBoundedField);
@@ -72,20 +72,37 @@ void declareAll(py::module &mod) {
 }
 
 PYBIND11_MODULE(convolveImage, mod) {
+    py::enum_<ConvolutionAlgorithm>(mod, "ConvolutionAlgorithm")
+            .value("CONVOLUTION_DIRECT", ConvolutionAlgorithm::CONVOLUTION_DIRECT)
+            .value("CONVOLUTION_FFT", ConvolutionAlgorithm::CONVOLUTION_FFT)
+            .value("CONVOLUTION_AUTO", ConvolutionAlgorithm::CONVOLUTION_AUTO)
+            .export_values();
+
+    py::class_<ConvolutionWorkspace, std::shared_ptr<ConvolutionWorkspace>> clsConvolutionWorkspace(
+            mod, "ConvolutionWorkspace");
+    clsConvolutionWorkspace.def(py::init<>());
+
     py::class_<ConvolutionControl, std::shared_ptr<ConvolutionControl>> clsConvolutionControl(
             mod, "ConvolutionControl");
 
-    clsConvolutionControl.def(py::init<bool, bool, int>(), "doNormalize"_a = true, "doCopyEdge"_a = false,
-                              "maxInterpolationDistance"_a = 10);
+    clsConvolutionControl.def(py::init<bool, bool, int, int>(), "doNormalize"_a = true,
+                              "doCopyEdge"_a = false, "maxInterpolationDistance"_a = 10,
+                              "numThreads"_a = 1);
 
     clsConvolutionControl.def("getDoNormalize", &ConvolutionControl::getDoNormalize);
     clsConvolutionControl.def("getDoCopyEdge", &ConvolutionControl::getDoCopyEdge);
     clsConvolutionControl.def("getMaxInterpolationDistance",
                               &ConvolutionControl::getMaxInterpolationDistance);
+    clsConvolutionControl.def("getNumThreads", &ConvolutionControl::getNumThreads);
+    clsConvolutionControl.def("getAlgorithm", &ConvolutionControl::getAlgorithm);
+    clsConvolutionControl.def("getWorkspace", &ConvolutionControl::getWorkspace);
     clsConvolutionControl.def("setDoNormalize", &ConvolutionControl::setDoNormalize);
     clsConvolutionControl.def("setDoCopyEdge", &ConvolutionControl::setDoCopyEdge);
     clsConvolutionControl.def("setMaxInterpolationDistance",
                               &ConvolutionControl::setMaxInterpolationDistance);
+    clsConvolutionControl.def("setNumThreads", &ConvolutionControl::setNumThreads);
+    clsConvolutionControl.def("setAlgorithm", &ConvolutionControl::setAlgorithm);
+    clsConvolutionControl.def("setWorkspace", &ConvolutionControl::setWorkspace);
 
     declareAll<double, double>(mod);
     declareAll<double, float>(mod);
@@ -92,6 +92,12 @@ void declareGaussianProcess(py::module &mod, const std::string &suffix) {
                            (void (GaussianProcess<T>::*)(ndarray::Array<T, 1, 1>, ndarray::Array<T, 1, 1>,
                                                          ndarray::Array<T, 1, 1> const &, int) const) &
                                    GaussianProcess<T>::interpolate);
+    clsGaussianProcess.def("interpolate",
+                           (void (GaussianProcess<T>::*)(ndarray::Array<T, 1, 1>, ndarray::Array<T, 1, 1>,
+                                                         ndarray::Array<T, 2, 2> const &, int, int) const) &
+                                   GaussianProcess<T>::interpolate,
+                           py::arg("mu"), py::arg("variance"), py::arg("queries"),
+                           py::arg("numberOfNeighbors"), py::arg("numThreads") = 1);
     clsGaussianProcess.def("selfInterpolate",
                            (T (GaussianProcess<T>::*)(ndarray::Array<T, 1, 1>, int, int) const) &
                                    GaussianProcess<T>::selfInterpolate);
@@ -123,6 +129,7 @@ void declareGaussianProcess(py::module &mod, const std::string &suffix) {
             (void (GaussianProcess<T>::*)(ndarray::Array<T, 2, 2>, ndarray::Array<T, 2, 2> const &) const) &
                     GaussianProcess<T>::batchInterpolate);
     clsGaussianProcess.def("setKrigingParameter", &GaussianProcess<T>::setKrigingParameter);
+    clsGaussianProcess.def("setMaxInducingPoints", &GaussianProcess<T>::setMaxInducingPoints);
     clsGaussianProcess.def("removePoint", &GaussianProcess<T>::removePoint);
     clsGaussianProcess.def("getNPoints", &GaussianProcess<T>::getNPoints);
     clsGaussianProcess.def("getData",
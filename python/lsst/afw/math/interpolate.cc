@@ -26,6 +26,9 @@
 
 #include "ndarray/pybind11.h"
 
+#include "lsst/afw/image/Defect.h"
+#include "lsst/afw/image/Image.h"
+#include "lsst/afw/image/MaskedImage.h"
 #include "lsst/afw/math/Interpolate.h"
 
 namespace py = pybind11;
@@ -33,7 +36,30 @@ using namespace pybind11::literals;
 
 using namespace lsst::afw::math;
 
+namespace {
+
+template <typename PixelT>
+void declareInterpolateOverDefects(py::module &mod) {
+    namespace afwImage = lsst::afw::image;
+    mod.def("interpolateOverDefects",
+            (void (*)(afwImage::Image<PixelT> &,
+                      std::vector<std::shared_ptr<afwImage::DefectBase>> const &, Interpolate::Style const,
+                      int const, double const))interpolateOverDefects,
+            "image"_a, "defects"_a, "style"_a = Interpolate::LINEAR, "nGoodPixels"_a = 4,
+            "fallbackValue"_a = 0.0);
+    mod.def("interpolateOverDefects",
+            (void (*)(afwImage::MaskedImage<PixelT, afwImage::MaskPixel, afwImage::VariancePixel> &,
+                      std::vector<std::shared_ptr<afwImage::DefectBase>> const &, Interpolate::Style const,
+                      int const, double const))interpolateOverDefects,
+            "image"_a, "defects"_a, "style"_a = Interpolate::LINEAR, "nGoodPixels"_a = 4,
+            "fallbackValue"_a = 0.0);
+}
+
+}  // namespace
+
 PYBIND11_MODULE(interpolate, mod) {
+    py::module::import("lsst.afw.image.image");
+    py::module::import("lsst.afw.image.defect");
     py::class_<Interpolate, std::shared_ptr<Interpolate>> clsInterpolate(mod, "Interpolate");
     py::enum_<Interpolate::Style>(clsInterpolate, "Style")
             .value("UNKNOWN", Interpolate::Style::UNKNOWN)
@@ -63,6 +89,13 @@ PYBIND11_MODULE(interpolate, mod) {
             (ndarray::Array<double, 1> (Interpolate::*)(ndarray::Array<double const, 1> const &) const) &
                     Interpolate::interpolate);
 
+    py::class_<InterpolateCache> clsInterpolateCache(mod, "InterpolateCache");
+    clsInterpolateCache.def(py::init<std::size_t const>(), "capacity"_a = 64);
+    clsInterpolateCache.def("makeInterpolate", &InterpolateCache::makeInterpolate, "x"_a, "y"_a,
+                            "style"_a = Interpolate::AKIMA_SPLINE);
+    clsInterpolateCache.def("size", &InterpolateCache::size);
+    clsInterpolateCache.def("clear", &InterpolateCache::clear);
+
     mod.def("makeInterpolate",
             (std::shared_ptr<Interpolate>(*)(std::vector<double> const &, std::vector<double> const &,
                                              Interpolate::Style const))makeInterpolate,
@@ -75,4 +108,7 @@ PYBIND11_MODULE(interpolate, mod) {
     mod.def("stringToInterpStyle", stringToInterpStyle, "style"_a);
     mod.def("lookupMaxInterpStyle", lookupMaxInterpStyle, "n"_a);
     mod.def("lookupMinInterpPoints", lookupMinInterpPoints, "style"_a);
+
+    declareInterpolateOverDefects<float>(mod);
+    declareInterpolateOverDefects<double>(mod);
 }
\ No newline at end of file
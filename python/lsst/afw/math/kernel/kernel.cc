@@ -42,6 +42,12 @@ PYBIND11_MODULE(kernel, mod) {
     clsKernel.def("resized", &Kernel::resized, "width"_a, "height"_a);
     clsKernel.def("computeImage", &Kernel::computeImage, "image"_a, "doNormalize"_a, "x"_a = 0.0,
                   "y"_a = 0.0);
+    clsKernel.def("computeImageDeferred", &Kernel::computeImageDeferred, "x"_a = 0.0, "y"_a = 0.0);
+
+    py::class_<Kernel::DeferredImage> clsDeferredImage(clsKernel, "DeferredImage");
+    clsDeferredImage.def("getImage", &Kernel::DeferredImage::getImage);
+    clsDeferredImage.def("getSum", &Kernel::DeferredImage::getSum);
+    clsDeferredImage.def("getNormalizedImage", &Kernel::DeferredImage::getNormalizedImage);
     clsKernel.def("getDimensions", &Kernel::getDimensions);
     clsKernel.def("setDimensions", &Kernel::setDimensions);
     clsKernel.def("setWidth", &Kernel::setWidth);
@@ -71,6 +77,10 @@ PYBIND11_MODULE(kernel, mod) {
     clsKernel.def("toString", &Kernel::toString, "prefix"_a = "");
     clsKernel.def("computeCache", &Kernel::computeCache);
     clsKernel.def("getCacheSize", &Kernel::getCacheSize);
+    clsKernel.def("setImageCacheSize", &Kernel::setImageCacheSize);
+    clsKernel.def("getImageCacheSize", &Kernel::getImageCacheSize);
+    clsKernel.def("setImageCachePositionQuantum", &Kernel::setImageCachePositionQuantum);
+    clsKernel.def("getImageCachePositionQuantum", &Kernel::getImageCachePositionQuantum);
 
     py::class_<FixedKernel, std::shared_ptr<FixedKernel>, Kernel> clsFixedKernel(mod, "FixedKernel");
 
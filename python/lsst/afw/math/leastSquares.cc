@@ -60,6 +60,9 @@ void declareLeastSquares(py::module &mod) {
     cls.def("setNormalEquations",
             (void (LeastSquares::*)(ndarray::Array<T1, 2, C1> const &, ndarray::Array<T2, 1, C2> const &)) &
                     LeastSquares::setNormalEquations<T1, T2, C1, C2>);
+    cls.def("setRhsVector", (void (LeastSquares::*)(ndarray::Array<T2, 1, C2> const &)) &
+                                    LeastSquares::setRhsVector<T2, C2>);
+    cls.def("solve", &LeastSquares::solve, "rhs"_a);
     cls.def("getSolution", &LeastSquares::getSolution);
     cls.def("getFisherMatrix", &LeastSquares::getFisherMatrix);
     cls.def("getCovariance", &LeastSquares::getCovariance);
@@ -67,6 +70,30 @@ void declareLeastSquares(py::module &mod) {
     cls.def("getDiagnostic", &LeastSquares::getDiagnostic);
     cls.def("getThreshold", &LeastSquares::getThreshold);
     cls.def("setThreshold", &LeastSquares::setThreshold);
+
+    py::class_<LeastSquares::Accumulator> clsAccumulator(cls, "Accumulator");
+    clsAccumulator.def(py::init<int>(), "dimension"_a);
+    clsAccumulator.def("getDimension", &LeastSquares::Accumulator::getDimension);
+    clsAccumulator.def("getCount", &LeastSquares::Accumulator::getCount);
+    clsAccumulator.def("addObservation", &LeastSquares::Accumulator::addObservation, "row"_a, "value"_a,
+                       "weight"_a = 1.0);
+    clsAccumulator.def("addObservations",
+                       (void (LeastSquares::Accumulator::*)(ndarray::Array<double const, 2> const &,
+                                                            ndarray::Array<double const, 1> const &)) &
+                               LeastSquares::Accumulator::addObservations,
+                       "rows"_a, "values"_a);
+    clsAccumulator.def("addObservations",
+                       (void (LeastSquares::Accumulator::*)(ndarray::Array<double const, 2> const &,
+                                                            ndarray::Array<double const, 1> const &,
+                                                            ndarray::Array<double const, 1> const &)) &
+                               LeastSquares::Accumulator::addObservations,
+                       "rows"_a, "values"_a, "weights"_a);
+    clsAccumulator.def("reset", &LeastSquares::Accumulator::reset);
+    clsAccumulator.def("getFisherMatrix", &LeastSquares::Accumulator::getFisherMatrix);
+    clsAccumulator.def("getRhsVector", &LeastSquares::Accumulator::getRhsVector);
+    clsAccumulator.def("makeSolver", &LeastSquares::Accumulator::makeSolver,
+                       "factorization"_a = LeastSquares::NORMAL_EIGENSYSTEM);
+    clsAccumulator.def("updateSolver", &LeastSquares::Accumulator::updateSolver, "solver"_a);
 };
 
 PYBIND11_MODULE(leastSquares, mod) {
@@ -39,6 +39,7 @@ from .pixelAreaBoundedField import *
 from .productBoundedField import *
 from .leastSquares import *
 from .random import *
+from .taskPool import *
 from .convolveImage import *
 from .statistics import *
 from .offsetImage import *
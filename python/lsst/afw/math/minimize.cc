@@ -32,15 +32,22 @@ using namespace lsst::afw::math;
 
 template <typename ReturnT>
 void declareMinimize(py::module &mod) {
-    mod.def("minimize", (FitResults(*)(lsst::afw::math::Function1<ReturnT> const &,
-                                       std::vector<double> const &, std::vector<double> const &,
-                                       std::vector<double> const &, std::vector<double> const &,
-                                       std::vector<double> const &, double))minimize<ReturnT>);
+    mod.def("minimize",
+            (FitResults(*)(lsst::afw::math::Function1<ReturnT> const &, std::vector<double> const &,
+                           std::vector<double> const &, std::vector<double> const &,
+                           std::vector<double> const &, std::vector<double> const &, double,
+                           int))minimize<ReturnT>,
+            py::arg("function"), py::arg("initialParameterList"), py::arg("stepSizeList"),
+            py::arg("measurementList"), py::arg("varianceList"), py::arg("xPositionList"),
+            py::arg("errorDef"), py::arg("numThreads") = 1);
     mod.def("minimize",
             (FitResults(*)(lsst::afw::math::Function2<ReturnT> const &, std::vector<double> const &,
                            std::vector<double> const &, std::vector<double> const &,
                            std::vector<double> const &, std::vector<double> const &,
-                           std::vector<double> const &, double))minimize<ReturnT>);
+                           std::vector<double> const &, double, int))minimize<ReturnT>,
+            py::arg("function"), py::arg("initialParameterList"), py::arg("stepSizeList"),
+            py::arg("measurementList"), py::arg("varianceList"), py::arg("xPositionList"),
+            py::arg("yPositionList"), py::arg("errorDef"), py::arg("numThreads") = 1);
 };
 
 PYBIND11_MODULE(minimize, mod) {
@@ -42,6 +42,15 @@ static void declareOffsetImage(py::module& mod) {
             "buffer"_a = 0);
 }
 
+template <typename PixelT>
+static void declareSubpixelOffset(py::module& mod, std::string const& suffix) {
+    using Class = SubpixelOffset<PixelT>;
+    py::class_<Class> cls(mod, ("SubpixelOffset" + suffix).c_str());
+    cls.def(py::init<double, double, std::string const&>(), "dx"_a, "dy"_a,
+            "algorithmName"_a = "lanczos5");
+    cls.def("apply", &Class::apply, "outImage"_a, "inImage"_a);
+}
+
 template <typename ImageT>
 static void declareRotateImageBy90(py::module& mod) {
     mod.def("rotateImageBy90", rotateImageBy90<ImageT>, "image"_a, "nQuarter"_a);
@@ -52,6 +61,11 @@ static void declareFlipImage(py::module& mod) {
     mod.def("flipImage", flipImage<ImageT>, "inImage"_a, "flipLR"_a, "flipTB"_a);
 }
 
+template <typename ImageT>
+static void declareTransposeImage(py::module& mod) {
+    mod.def("transposeImage", transposeImage<ImageT>, "inImage"_a);
+}
+
 template <typename ImageT>
 static void declareBinImage(py::module& mod) {
     mod.def("binImage", (std::shared_ptr<ImageT>(*)(ImageT const&, int const, int const,
@@ -60,6 +74,10 @@ static void declareBinImage(py::module& mod) {
     mod.def("binImage", (std::shared_ptr<ImageT>(*)(ImageT const&, int const,
                                                     lsst::afw::math::Property const))binImage<ImageT>,
             "inImage"_a, "binsize"_a, "flags"_a = lsst::afw::math::MEAN);
+    mod.def("binImage",
+            (std::shared_ptr<ImageT>(*)(ImageT const&, int const, int const, lsst::afw::math::Property const,
+                                        StatisticsControl const&, int))binImage<ImageT>,
+            "inImage"_a, "binX"_a, "binY"_a, "flags"_a, "sctrl"_a, "numThreads"_a = 1);
 }
 }  // namespace
 
@@ -74,6 +92,10 @@ PYBIND11_MODULE(offsetImage, mod) {
     declareOffsetImage<lsst::afw::image::MaskedImage<float>>(mod);
     declareOffsetImage<lsst::afw::image::MaskedImage<double>>(mod);
 
+    declareSubpixelOffset<int>(mod, "I");
+    declareSubpixelOffset<float>(mod, "F");
+    declareSubpixelOffset<double>(mod, "D");
+
     declareRotateImageBy90<lsst::afw::image::Image<std::uint16_t>>(mod);
     declareRotateImageBy90<lsst::afw::image::Image<int>>(mod);
     declareRotateImageBy90<lsst::afw::image::Image<float>>(mod);
@@ -94,6 +116,16 @@ PYBIND11_MODULE(offsetImage, mod) {
     declareFlipImage<lsst::afw::image::MaskedImage<double>>(mod);
     declareFlipImage<lsst::afw::image::Mask<MaskPixel>>(mod);
 
+    declareTransposeImage<lsst::afw::image::Image<std::uint16_t>>(mod);
+    declareTransposeImage<lsst::afw::image::Image<int>>(mod);
+    declareTransposeImage<lsst::afw::image::Image<float>>(mod);
+    declareTransposeImage<lsst::afw::image::Image<double>>(mod);
+    declareTransposeImage<lsst::afw::image::MaskedImage<std::uint16_t>>(mod);
+    declareTransposeImage<lsst::afw::image::MaskedImage<int>>(mod);
+    declareTransposeImage<lsst::afw::image::MaskedImage<float>>(mod);
+    declareTransposeImage<lsst::afw::image::MaskedImage<double>>(mod);
+    declareTransposeImage<lsst::afw::image::Mask<MaskPixel>>(mod);
+
     declareBinImage<lsst::afw::image::Image<std::uint16_t>>(mod);
     declareBinImage<lsst::afw::image::Image<int>>(mod);
     declareBinImage<lsst::afw::image::Image<float>>(mod);
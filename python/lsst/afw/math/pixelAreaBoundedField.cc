@@ -39,9 +39,15 @@ PYBIND11_MODULE(pixelAreaBoundedField, mod) {
     PyClass cls(mod, "PixelAreaBoundedField");
     cls.def(
         py::init<lsst::geom::Box2I const &, std::shared_ptr<afw::geom::SkyWcs const>,
-                 lsst::geom::AngleUnit const &, double>(),
-        "bbox"_a, "skyWcs"_a, "unit"_a=lsst::geom::radians, "scaling"_a=1.0
+                 lsst::geom::AngleUnit const &, double, int>(),
+        "bbox"_a, "skyWcs"_a, "unit"_a=lsst::geom::radians, "scaling"_a=1.0, "gridSpacing"_a=0
     );
+    cls.def_static(
+        "makeGridded", &PixelAreaBoundedField::makeGridded,
+        "bbox"_a, "skyWcs"_a, "maxRelativeError"_a=1e-8, "unit"_a=lsst::geom::radians,
+        "scaling"_a=1.0, "maxGridSpacing"_a=1024
+    );
+    cls.def("getGridSpacing", &PixelAreaBoundedField::getGridSpacing);
     // All other operations are wrapped by the BoundedField base class.
 }
 
@@ -41,6 +41,8 @@ void declareRandomImage(py::module &mod) {
     mod.def("randomFlatImage",
             (void (*)(ImageT *, Random &, double const, double const))randomFlatImage<ImageT>);
     mod.def("randomGaussianImage", (void (*)(ImageT *, Random &))randomGaussianImage<ImageT>);
+    mod.def("randomGaussianImage", (void (*)(ImageT *, Random &, int))randomGaussianImage<ImageT>,
+            "image"_a, "rand"_a, "numThreads"_a);
     mod.def("randomChisqImage", (void (*)(ImageT *, Random &, double const))randomChisqImage<ImageT>);
     mod.def("randomPoissonImage", (void (*)(ImageT *, Random &, double const))randomPoissonImage<ImageT>);
 }
@@ -63,6 +65,7 @@ PYBIND11_MODULE(random, mod) {
             .value("TAUS", Random::Algorithm::TAUS)
             .value("TAUS2", Random::Algorithm::TAUS2)
             .value("GFSR4", Random::Algorithm::GFSR4)
+            .value("PHILOX", Random::Algorithm::PHILOX)
             .value("NUM_ALGORITHMS", Random::Algorithm::NUM_ALGORITHMS)
             .export_values();
 
@@ -73,6 +76,7 @@ PYBIND11_MODULE(random, mod) {
 
     /* Members */
     clsRandom.def("deepCopy", &Random::deepCopy);
+    clsRandom.def("split", &Random::split);
     clsRandom.def("getAlgorithm", &Random::getAlgorithm);
     clsRandom.def("getAlgorithmName", &Random::getAlgorithmName);
     clsRandom.def_static("getAlgorithmNames", &Random::getAlgorithmNames);
@@ -115,6 +115,7 @@ void wrapSpatialCellSet(py::module &mod) {
     cls.def("getCellList", &SpatialCellSet::getCellList);
     cls.def("getBBox", &SpatialCellSet::getBBox);
     cls.def("insertCandidate", &SpatialCellSet::insertCandidate);
+    cls.def("findCandidatesIn", &SpatialCellSet::findCandidatesIn, "bbox"_a, "ignoreBad"_a = true);
     cls.def("sortCandidates", &SpatialCellSet::sortCandidates);
     cls.def("visitCandidates", (void (SpatialCellSet::*)(CandidateVisitor *, int const, bool const)) &
                                        SpatialCellSet::visitCandidates,
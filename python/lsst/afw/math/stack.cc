@@ -25,6 +25,7 @@
 
 #include <pybind11/pybind11.h>
 //#include <pybind11/operators.h>
+#include <pybind11/functional.h>
 #include <pybind11/stl.h>
 
 #include "lsst/afw/math/Stack.h"
@@ -72,6 +73,14 @@ void declareStatisticsStack(py::module &mod) {
                       std::vector<std::pair<lsst::afw::image::MaskPixel, lsst::afw::image::MaskPixel>> const &
                 ))statisticsStack<PixelT>,
             "out"_a, "images"_a, "flags"_a, "sctrl"_a, "wvector"_a, "clipped"_a, "maskMap"_a);
+    mod.def("statisticsStack",
+            (void (*)(lsst::afw::image::MaskedImage<PixelT> &, StackStripReader<PixelT> const &, int,
+                      Property, StatisticsControl const &,
+                      std::vector<lsst::afw::image::VariancePixel> const &,
+                      lsst::afw::image::MaskPixel, lsst::afw::image::MaskPixel, int))statisticsStack<PixelT>,
+            "out"_a, "reader"_a, "numImages"_a, "flags"_a, "sctrl"_a = StatisticsControl(),
+            "wvector"_a = std::vector<lsst::afw::image::VariancePixel>(0),
+            "clipped"_a=0, "excuse"_a=0, "stripHeight"_a=64);
     mod.def("statisticsStack",
             (std::shared_ptr<lsst::afw::image::Image<PixelT>>(*)(
                     std::vector<std::shared_ptr<lsst::afw::image::Image<PixelT>>> &, Property,
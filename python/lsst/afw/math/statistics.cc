@@ -23,6 +23,7 @@
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
 
+#include "lsst/afw/geom/SpanSet.h"
 #include "lsst/afw/math/Statistics.h"
 
 namespace py = pybind11;
@@ -53,6 +54,14 @@ void declareStatistics(py::module &mod) {
     mod.def("makeStatistics", (Statistics(*)(image::Image<Pixel> const &, int const,
                                              StatisticsControl const &))makeStatistics<Pixel>,
             "img"_a, "flags"_a, "sctrl"_a = StatisticsControl());
+    mod.def("makeStatistics",
+            (Statistics(*)(image::Image<Pixel> const &, geom::SpanSet const &, int const,
+                           StatisticsControl const &))makeStatistics<Pixel>,
+            "img"_a, "spans"_a, "flags"_a, "sctrl"_a = StatisticsControl());
+    mod.def("makeStatistics",
+            (Statistics(*)(image::MaskedImage<Pixel> const &, geom::SpanSet const &, int const,
+                           StatisticsControl const &))makeStatistics<Pixel>,
+            "mimg"_a, "spans"_a, "flags"_a, "sctrl"_a = StatisticsControl());
 }
 
 template <typename Pixel>
@@ -66,6 +75,8 @@ void declareStatisticsVectorOverloads(py::module &mod) {
 }
 
 PYBIND11_MODULE(statistics, mod) {
+    py::module::import("lsst.afw.geom.spanSet");
+
     /* Module level */
     py::enum_<Property>(mod, "Property", py::arithmetic())
             .value("NOTHING", Property::NOTHING)
@@ -115,6 +126,8 @@ PYBIND11_MODULE(statistics, mod) {
     clsStatisticsControl.def("getWeightedIsSet", &StatisticsControl::getWeightedIsSet);
     clsStatisticsControl.def("getCalcErrorFromInputVariance",
                              &StatisticsControl::getCalcErrorFromInputVariance);
+    clsStatisticsControl.def("getNumThreads", &StatisticsControl::getNumThreads);
+    clsStatisticsControl.def("getQuantileTolerance", &StatisticsControl::getQuantileTolerance);
     clsStatisticsControl.def("setNumSigmaClip", &StatisticsControl::setNumSigmaClip);
     clsStatisticsControl.def("setNumIter", &StatisticsControl::setNumIter);
     clsStatisticsControl.def("setAndMask", &StatisticsControl::setAndMask);
@@ -123,6 +136,8 @@ PYBIND11_MODULE(statistics, mod) {
     clsStatisticsControl.def("setWeighted", &StatisticsControl::setWeighted);
     clsStatisticsControl.def("setCalcErrorFromInputVariance",
                              &StatisticsControl::setCalcErrorFromInputVariance);
+    clsStatisticsControl.def("setNumThreads", &StatisticsControl::setNumThreads);
+    clsStatisticsControl.def("setQuantileTolerance", &StatisticsControl::setQuantileTolerance);
 
     py::class_<Statistics> clsStatistics(mod, "Statistics");
 
@@ -131,6 +146,34 @@ PYBIND11_MODULE(statistics, mod) {
     clsStatistics.def("getValue", &Statistics::getValue, "prop"_a = Property::NOTHING);
     clsStatistics.def("getOrMask", &Statistics::getOrMask);
 
+    py::class_<StatisticsAccumulator> clsStatisticsAccumulator(mod, "StatisticsAccumulator");
+
+    clsStatisticsAccumulator.def(py::init<StatisticsControl const &>(), "sctrl"_a = StatisticsControl());
+    clsStatisticsAccumulator.def("__iadd__",
+                                 (StatisticsAccumulator & (StatisticsAccumulator::*)(image::Image<float> const &)) &
+                                         StatisticsAccumulator::operator+=);
+    clsStatisticsAccumulator.def(
+            "__iadd__", (StatisticsAccumulator & (StatisticsAccumulator::*)(image::Image<double> const &)) &
+                                StatisticsAccumulator::operator+=);
+    clsStatisticsAccumulator.def(
+            "__iadd__", (StatisticsAccumulator & (StatisticsAccumulator::*)(image::MaskedImage<float> const &)) &
+                                StatisticsAccumulator::operator+=);
+    clsStatisticsAccumulator.def(
+            "__iadd__", (StatisticsAccumulator & (StatisticsAccumulator::*)(image::MaskedImage<double> const &)) &
+                                StatisticsAccumulator::operator+=);
+    clsStatisticsAccumulator.def(
+            "__iadd__", (StatisticsAccumulator & (StatisticsAccumulator::*)(std::vector<double> const &)) &
+                                StatisticsAccumulator::operator+=);
+    clsStatisticsAccumulator.def("merge", &StatisticsAccumulator::merge, "other"_a);
+    clsStatisticsAccumulator.def("getN", &StatisticsAccumulator::getN);
+    clsStatisticsAccumulator.def("getSum", &StatisticsAccumulator::getSum);
+    clsStatisticsAccumulator.def("getMean", &StatisticsAccumulator::getMean);
+    clsStatisticsAccumulator.def("getVariance", &StatisticsAccumulator::getVariance);
+    clsStatisticsAccumulator.def("getStdev", &StatisticsAccumulator::getStdev);
+    clsStatisticsAccumulator.def("getMin", &StatisticsAccumulator::getMin);
+    clsStatisticsAccumulator.def("getMax", &StatisticsAccumulator::getMax);
+    clsStatisticsAccumulator.def("getOrMask", &StatisticsAccumulator::getOrMask);
+
     declareStatistics<unsigned short>(mod);
     declareStatistics<double>(mod);
     declareStatistics<float>(mod);
@@ -0,0 +1,41 @@
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021  AURA/LSST.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <https://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#include <pybind11/pybind11.h>
+
+#include "lsst/afw/math/TaskPool.h"
+
+namespace py = pybind11;
+
+using namespace lsst::afw::math;
+using namespace pybind11::literals;
+
+PYBIND11_MODULE(taskPool, mod) {
+    // the pool is a process-wide singleton; it is neither constructible nor deletable from Python
+    py::class_<TaskPool, std::unique_ptr<TaskPool, py::nodelete>> clsTaskPool(mod, "TaskPool");
+
+    clsTaskPool.def_static("getInstance", &TaskPool::getInstance, py::return_value_policy::reference);
+    clsTaskPool.def("getNumThreads", &TaskPool::getNumThreads);
+    clsTaskPool.def("setNumThreads", &TaskPool::setNumThreads, "numThreads"_a);
+    clsTaskPool.def("getAffinity", &TaskPool::getAffinity);
+    clsTaskPool.def("setAffinity", &TaskPool::setAffinity, "pin"_a);
+}
@@ -25,7 +25,7 @@
 #include <string>
 
 #include <pybind11/pybind11.h>
-//#include <pybind11/stl.h>
+#include <pybind11/stl.h>
 
 #include "lsst/afw/geom/SkyWcs.h"
 #include "lsst/afw/image/Exposure.h"
@@ -125,9 +125,32 @@ void declareWarpingFunctions(py::module &mod) {
             "control"_a, "padValue"_a = edgePixel<DestMaskedImageT>(
                                  typename image::detail::image_traits<DestMaskedImageT>::image_category()));
 
+    mod.def("warpExposureBatch", &warpExposureBatch<DestExposureT, SrcExposureT>, "srcExposure"_a,
+            "requests"_a, "control"_a,
+            "padValue"_a = edgePixel<DestMaskedImageT>(
+                    typename image::detail::image_traits<DestMaskedImageT>::image_category()));
+
     declareImageWarpingFunctions<DestImageT, SrcImageT>(mod);
     declareImageWarpingFunctions<DestMaskedImageT, SrcMaskedImageT>(mod);
 }
+
+/**
+@internal Declare a CoaddAccumulator for a particular pixel type
+
+@tparam PixelT  Pixel type of the accumulated images, e.g. `float`
+@param[in,out] mod  pybind11 module for which to declare the class
+@param[in] suffix  Class name suffix associated with PixelT, e.g. "F" for `float`
+*/
+template <typename PixelT>
+void declareCoaddAccumulator(py::module &mod, std::string const &suffix) {
+    using Class = CoaddAccumulator<PixelT>;
+    py::class_<Class, std::shared_ptr<Class>> cls(mod, ("CoaddAccumulator" + suffix).c_str());
+    cls.def(py::init<lsst::geom::Box2I const &, image::MaskPixel>(), "bbox"_a, "badPixelMask"_a = 0);
+    cls.def("accumulate", &Class::accumulate, "srcImage"_a, "srcToDest"_a, "control"_a, "weight"_a = 1.0);
+    cls.def("getCoadd", &Class::getCoadd);
+    cls.def("getBBox", &Class::getBBox);
+    cls.def("getBadPixelMask", &Class::getBadPixelMask);
+}
 }
 
 PYBIND11_MODULE(warpExposure, mod) {
@@ -136,6 +159,17 @@ PYBIND11_MODULE(warpExposure, mod) {
     declareSimpleWarpingKernel<BilinearWarpingKernel>(mod, "BilinearWarpingKernel");
     declareSimpleWarpingKernel<NearestWarpingKernel>(mod, "NearestWarpingKernel");
 
+    py::class_<WarpMappingCache, std::shared_ptr<WarpMappingCache>> clsWarpMappingCache(mod,
+                                                                                        "WarpMappingCache");
+    clsWarpMappingCache.def(py::init<>());
+
+    py::class_<StampWarpRequest, std::shared_ptr<StampWarpRequest>> clsStampWarpRequest(mod,
+                                                                                        "StampWarpRequest");
+    clsStampWarpRequest.def(py::init<lsst::geom::Box2I const &, std::shared_ptr<geom::SkyWcs const>>(),
+                            "bbox"_a, "wcs"_a);
+    clsStampWarpRequest.def_readwrite("bbox", &StampWarpRequest::bbox);
+    clsStampWarpRequest.def_readwrite("wcs", &StampWarpRequest::wcs);
+
     py::class_<WarpingControl, std::shared_ptr<WarpingControl>> clsWarpingControl(mod, "WarpingControl");
 
     declareWarpingFunctions<double, double>(mod);
@@ -148,14 +182,17 @@ PYBIND11_MODULE(warpExposure, mod) {
     declareWarpingFunctions<int, int>(mod);
     declareWarpingFunctions<std::uint16_t, std::uint16_t>(mod);
 
+    declareCoaddAccumulator<float>(mod, "F");
+    declareCoaddAccumulator<double>(mod, "D");
+
     /* Member types and enums */
 
     /* Constructors */
     clsLanczosWarpingKernel.def(py::init<int>(), "order"_a);
 
-    clsWarpingControl.def(py::init<std::string, std::string, int, int, image::MaskPixel>(),
+    clsWarpingControl.def(py::init<std::string, std::string, int, int, image::MaskPixel, int>(),
                           "warpingKernelName"_a, "maskWarpingKernelName"_a = "", "cacheSize"_a = 0,
-                          "interpLength"_a = 0, "growFullMask"_a = 0);
+                          "interpLength"_a = 0, "growFullMask"_a = 0, "numThreads"_a = 1);
 
     /* Operators */
     clsLanczosWarpingKernel.def("getOrder", &LanczosWarpingKernel::getOrder);
@@ -178,6 +215,11 @@ PYBIND11_MODULE(warpExposure, mod) {
                           "maskWarpingKernel"_a);
     clsWarpingControl.def("getGrowFullMask", &WarpingControl::getGrowFullMask);
     clsWarpingControl.def("setGrowFullMask", &WarpingControl::setGrowFullMask, "growFullMask"_a);
+    clsWarpingControl.def("getNumThreads", &WarpingControl::getNumThreads);
+    clsWarpingControl.def("setNumThreads", &WarpingControl::setNumThreads, "numThreads"_a);
+    clsWarpingControl.def("getWarpMappingCache", &WarpingControl::getWarpMappingCache);
+    clsWarpingControl.def("setWarpMappingCache", &WarpingControl::setWarpMappingCache,
+                          "warpMappingCache"_a);
 
     /* Members */
 }
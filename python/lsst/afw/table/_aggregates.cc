@@ -36,6 +36,7 @@
 #include "lsst/afw/table/Key.h"
 #include "lsst/afw/table/Schema.h"
 #include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/BaseColumnView.h"
 #include "lsst/afw/table/FunctorKey.h"
 #include "lsst/afw/table/aggregates.h"
 
@@ -85,6 +86,8 @@ static void declarePointKey(WrapperCollection &wrappers, std::string const &suff
                 cls.def("set", [](PointKey<T> &self, BaseRecord &record,
                                   lsst::geom::Point<T, 2> const &value) { return self.set(record, value); });
                 cls.def("get", &PointKey<T>::get);
+                cls.def("getArrays", &PointKey<T>::getArrays, "columns"_a);
+                cls.def("setArrays", &PointKey<T>::setArrays, "columns"_a, "x"_a, "y"_a);
             });
 };
 
@@ -121,6 +124,21 @@ static void declareCoordKey(WrapperCollection &wrappers) {
         cls.def("isValid", &CoordKey::isValid);
         cls.def("get", [](CoordKey &self, BaseRecord const &record) { return self.get(record); });
         cls.def("set", &CoordKey::set);
+        // As with BaseColumnView, ndarray does not recognize lsst::geom::Angle
+        // natively, so we return double views (radians).
+        cls.def("getArrays", [](CoordKey &self, BaseColumnView const &columns) {
+            using AngleArray = ndarray::Array<lsst::geom::Angle, 1>;
+            using DoubleArray = ndarray::Array<double, 1>;
+            auto makeView = [](AngleArray const &a) -> DoubleArray {
+                return ndarray::detail::ArrayAccess<DoubleArray>::construct(
+                        reinterpret_cast<double *>(a.getData()),
+                        ndarray::detail::ArrayAccess<AngleArray>::getCore(a));
+            };
+            auto arrays = self.getArrays(columns);
+            return std::make_pair(makeView(arrays.first), makeView(arrays.second));
+        }, "columns"_a);
+        cls.def("getUnitVectors", &CoordKey::getUnitVectors, "columns"_a);
+        cls.def("setUnitVectors", &CoordKey::setUnitVectors, "columns"_a, "vectors"_a);
     });
 }
 
@@ -193,6 +211,10 @@ static void declareCovarianceMatrixKey(WrapperCollection &wrappers, const ::std:
                 cls.def("isValid", &CovarianceMatrixKey<T, N>::isValid);
                 cls.def("setElement", &CovarianceMatrixKey<T, N>::setElement);
                 cls.def("getElement", &CovarianceMatrixKey<T, N>::getElement);
+                cls.def("getElementArray", &CovarianceMatrixKey<T, N>::getElementArray, "columns"_a, "i"_a,
+                        "j"_a);
+                cls.def("setElementArray", &CovarianceMatrixKey<T, N>::setElementArray, "columns"_a, "i"_a,
+                        "j"_a, "values"_a);
             });
 }
 
@@ -30,6 +30,7 @@ and makes wrapping Base catalogs more similar to all other types of catalog.
 */
 
 #include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
 
 #include "ndarray/pybind11.h"
 
@@ -156,6 +157,7 @@ PyBaseTable declareBaseTable(WrapperCollection &wrappers) {
         cls.def("setMetadata", &BaseTable::setMetadata, "metadata"_a);
         cls.def("popMetadata", &BaseTable::popMetadata);
         cls.def("makeRecord", &BaseTable::makeRecord);
+        cls.def("makeRecords", &BaseTable::makeRecords, "n"_a);
         cls.def("copyRecord",
                 (std::shared_ptr<BaseRecord>(BaseTable::*)(BaseRecord const &)) & BaseTable::copyRecord);
         cls.def("copyRecord",
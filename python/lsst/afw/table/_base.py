@@ -143,6 +143,11 @@ class Catalog(metaclass=TemplateMeta):
         if isinstance(key, Key):
             if isinstance(key, Key["Flag"]):
                 self._set_flag(key, value)
+            elif not self.isContiguous():
+                # Scatter the values record-by-record; a column view (which
+                # would assign in one vectorized statement) requires the
+                # records to be contiguous.
+                self._set_column(key, value)
             else:
                 self.columns[key] = value
         else:
@@ -171,6 +176,28 @@ class Catalog(metaclass=TemplateMeta):
         self._columns = None
         return self._addNew()
 
+    def appendRecords(self, n):
+        """Append ``n`` new records created in one pass.
+
+        Equivalent to calling `addNew` ``n`` times, but the records' field
+        data is allocated in a single slab and the internal vector is
+        reserved once, so bulk construction does a constant number of
+        allocations.
+
+        Parameters
+        ----------
+        n : `int`
+            Number of records to append.
+
+        Returns
+        -------
+        view : same type as ``self``
+            Shallow view of the appended records, sharing its table and
+            records with this catalog.
+        """
+        self._columns = None
+        return self._appendRecords(n)
+
     def cast(self, type_, deep=False):
         """Return a copy of the catalog with the given type.
 
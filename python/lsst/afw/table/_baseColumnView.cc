@@ -80,6 +80,9 @@ static void declareBaseColumnView(WrapperCollection &wrappers) {
         // _getBits supports a Python version of getBits that accepts None and field names as keys
         cls.def("_getBits", &BaseColumnView::getBits);
         cls.def("getAllBits", &BaseColumnView::getAllBits);
+        cls.def("packBits", &BaseColumnView::packBits, "key"_a);
+        // _selectRecords supports a Python version of selectRecords that accepts field names as keys
+        cls.def("_selectRecords", &BaseColumnView::selectRecords);
         declareBaseColumnViewOverloads<std::uint8_t>(cls);
         declareBaseColumnViewOverloads<std::uint16_t>(cls);
         declareBaseColumnViewOverloads<std::int32_t>(cls);
@@ -59,6 +59,30 @@ class _BaseColumnViewBase:  # noqa: F811
                 arg.append(k)
         return self._getBits(arg)
 
+    def selectRecords(self, mustBeSet=(), mustBeClear=()):
+        """Return the indices of records matching a combination of flags.
+
+        Parameters
+        ----------
+        mustBeSet : iterable of `str` or `lsst.afw.table.KeyFlag`
+            Flag fields that must be set.  Unlike the C++ version, each may
+            be a field name or a key.
+        mustBeClear : iterable of `str` or `lsst.afw.table.KeyFlag`
+            Flag fields that must be clear.
+
+        Returns
+        -------
+        indices : `numpy.ndarray`
+            Indices of the records for which all of ``mustBeSet`` are set
+            and all of ``mustBeClear`` are clear, suitable for use as a
+            fancy index on column arrays.  The flags are evaluated as
+            packed bitmasks, 64 records at a time, so this is much faster
+            than composing boolean arrays for large catalogs.
+        """
+        def asKeys(keys):
+            return [self.schema.find(k).key if isinstance(k, str) else k for k in keys]
+        return self._selectRecords(asKeys(mustBeSet), asKeys(mustBeClear))
+
     def __getitem__(self, key):
         """Get a column view; key may be a key object or the name of a field.
         """
@@ -178,6 +178,20 @@ void wrapExposure(WrapperCollection &wrappers) {
     // circular dependencies until at least afw.image uses WrapperCollection
     // in DM-20703
 
+    // ExposureFitsFlags enum values are used as integer masks, so wrap as attributes instead of an enum
+    auto &mod = wrappers.module;
+    mod.attr("EXPOSURE_IO_NO_PSF") = static_cast<int>(ExposureFitsFlags::EXPOSURE_IO_NO_PSF);
+    mod.attr("EXPOSURE_IO_NO_WCS") = static_cast<int>(ExposureFitsFlags::EXPOSURE_IO_NO_WCS);
+    mod.attr("EXPOSURE_IO_NO_PHOTOCALIB") = static_cast<int>(ExposureFitsFlags::EXPOSURE_IO_NO_PHOTOCALIB);
+    mod.attr("EXPOSURE_IO_NO_APCORRMAP") = static_cast<int>(ExposureFitsFlags::EXPOSURE_IO_NO_APCORRMAP);
+    mod.attr("EXPOSURE_IO_NO_VALID_POLYGON") =
+            static_cast<int>(ExposureFitsFlags::EXPOSURE_IO_NO_VALID_POLYGON);
+    mod.attr("EXPOSURE_IO_NO_VISIT_INFO") = static_cast<int>(ExposureFitsFlags::EXPOSURE_IO_NO_VISIT_INFO);
+    mod.attr("EXPOSURE_IO_NO_TRANSMISSION_CURVE") =
+            static_cast<int>(ExposureFitsFlags::EXPOSURE_IO_NO_TRANSMISSION_CURVE);
+    mod.attr("EXPOSURE_IO_NO_DETECTOR") = static_cast<int>(ExposureFitsFlags::EXPOSURE_IO_NO_DETECTOR);
+    mod.attr("EXPOSURE_IO_NO_COMPONENTS") = static_cast<int>(ExposureFitsFlags::EXPOSURE_IO_NO_COMPONENTS);
+
     auto clsExposureRecord = declareExposureRecord(wrappers);
     auto clsExposureTable = declareExposureTable(wrappers);
     auto clsExposureColumnView = table::python::declareColumnView<ExposureRecord>(wrappers, "Exposure");
@@ -22,6 +22,7 @@
  */
 
 #include "pybind11/pybind11.h"
+#include "pybind11/stl.h"
 
 #include "lsst/utils/python.h"
 #include "lsst/afw/table/IdFactory.h"
@@ -42,6 +43,9 @@ void wrapIdFactory(utils::python::WrapperCollection& wrappers) {
         cls.def("clone", &IdFactory::clone);
         cls.def_static("makeSimple", IdFactory::makeSimple);
         cls.def_static("makeSource", IdFactory::makeSource, "expId"_a, "reserved"_a);
+        cls.def_static("makeSourceThreadSafe", IdFactory::makeSourceThreadSafe, "expId"_a, "reserved"_a);
+        cls.def_static("makeSourceShards", IdFactory::makeSourceShards, "expId"_a, "reserved"_a,
+                       "nShards"_a);
         cls.def_static("computeReservedFromMaxBits", IdFactory::computeReservedFromMaxBits, "maxBits"_a);
     });
 }
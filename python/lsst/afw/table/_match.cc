@@ -24,6 +24,8 @@
 #include "pybind11/pybind11.h"
 #include "pybind11/stl.h"
 
+#include "ndarray/pybind11.h"
+
 #include "lsst/utils/python.h"
 
 #include "lsst/pex/config/python.h"  // for LSST_DECLARE_CONTROL_FIELD
@@ -66,6 +68,10 @@ void declareMatch2(WrapperCollection &wrappers, std::string const &prefix) {
     wrappers.wrap([](auto &mod) {
         mod.def("unpackMatches", &unpackMatches<Catalog1, Catalog2>, "matches"_a, "cat1"_a, "cat2"_a);
 
+        mod.def("matchSeparations", &matchSeparations<Record1, Record2>, "matches"_a);
+        mod.def("matchPositionAngles", &matchPositionAngles<Record1, Record2>, "matches"_a);
+        mod.def("matchOffsets", &matchOffsets<Record1, Record2>, "matches"_a);
+
         mod.def("matchRaDec",
                 (MatchList(*)(Catalog1 const &, Catalog2 const &, lsst::geom::Angle,
                               MatchControl const &))matchRaDec<Catalog1, Catalog2>,
@@ -84,6 +90,16 @@ void declareMatch1(WrapperCollection &wrappers) {
     });
 }
 
+template <typename Cat>
+using PyMatchIndex = py::class_<MatchIndex<Cat>, std::shared_ptr<MatchIndex<Cat>>>;
+
+/// @internal Declare a match overload of MatchIndex for one query catalog type
+template <typename QueryCat, typename Cat>
+void declareMatchIndexQuery(PyMatchIndex<Cat> &cls) {
+    cls.def("match", &MatchIndex<Cat>::template match<QueryCat>, "query"_a, "radius"_a,
+            "mc"_a = MatchControl(), "numThreads"_a = 1);
+}
+
 }  // namespace
 
 void wrapMatch(WrapperCollection &wrappers) {
@@ -92,6 +108,7 @@ void wrapMatch(WrapperCollection &wrappers) {
         LSST_DECLARE_CONTROL_FIELD(cls, MatchControl, findOnlyClosest);
         LSST_DECLARE_CONTROL_FIELD(cls, MatchControl, symmetricMatch);
         LSST_DECLARE_CONTROL_FIELD(cls, MatchControl, includeMismatches);
+        LSST_DECLARE_CONTROL_FIELD(cls, MatchControl, numThreads);
     });
 
     declareMatch2<SimpleCatalog, SimpleCatalog>(wrappers, "Simple");
@@ -100,6 +117,22 @@ void wrapMatch(WrapperCollection &wrappers) {
     declareMatch1<SimpleCatalog>(wrappers);
     declareMatch1<SourceCatalog>(wrappers);
 
+    wrappers.wrapType(PyMatchIndex<SimpleCatalog>(wrappers.module, "SimpleMatchIndex"),
+                      [](auto &mod, auto &cls) {
+                          cls.def(py::init<SimpleCatalog const &>(), "catalog"_a);
+                          cls.def("size", &MatchIndex<SimpleCatalog>::size);
+                          cls.def("__len__", &MatchIndex<SimpleCatalog>::size);
+                          declareMatchIndexQuery<SimpleCatalog>(cls);
+                      });
+    wrappers.wrapType(PyMatchIndex<SourceCatalog>(wrappers.module, "SourceMatchIndex"),
+                      [](auto &mod, auto &cls) {
+                          cls.def(py::init<SourceCatalog const &>(), "catalog"_a);
+                          cls.def("size", &MatchIndex<SourceCatalog>::size);
+                          cls.def("__len__", &MatchIndex<SourceCatalog>::size);
+                          declareMatchIndexQuery<SimpleCatalog>(cls);
+                          declareMatchIndexQuery<SourceCatalog>(cls);
+                      });
+
     wrappers.wrap([](auto &mod) {
         mod.def("matchXy",
                 (SourceMatchVector(*)(SourceCatalog const &, SourceCatalog const &, double,
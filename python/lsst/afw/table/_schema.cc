@@ -451,6 +451,7 @@ void declareSchema(WrapperCollection &wrappers) {
         cls.def("__ne__", [](Schema const &self, Schema const &other) { return self != other; },
                 py::is_operator());
         cls.def("getRecordSize", &Schema::getRecordSize);
+        cls.def("getFingerprint", &Schema::getFingerprint);
         cls.def("getFieldCount", &Schema::getFieldCount);
         cls.def("getFlagFieldCount", &Schema::getFlagFieldCount);
         cls.def("getNonFlagFieldCount", &Schema::getNonFlagFieldCount);
@@ -41,6 +41,7 @@ void wrapBase(WrapperCollection&);
 void wrapBaseColumnView(WrapperCollection&);
 void wrapExposure(WrapperCollection&);
 void wrapIdFactory(WrapperCollection&);
+void wrapMaskUtils(WrapperCollection&);
 void wrapMatch(WrapperCollection&);
 void wrapSchema(WrapperCollection&);
 void wrapSchemaMapper(WrapperCollection&);
@@ -65,6 +66,7 @@ PYBIND11_MODULE(_table, mod) {
     wrapExposure(wrappers);
     wrapMatch(wrappers);
     wrapWcsUtils(wrappers);
+    wrapMaskUtils(wrappers);
     wrappers.finish();
 }
 
@@ -19,7 +19,12 @@
  * You should have received a copy of the GNU General Public License
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions.h"
 #include "lsst/afw/cameraGeom/Amplifier.h"
+#include "lsst/afw/image/Image.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/afw/table/BaseRecord.h"
 #include "lsst/afw/table/aggregates.h"
 
@@ -351,6 +356,79 @@ void Amplifier::toRecord(table::BaseRecord & record) const {
     setIfValid(fields.linearityUnits, helper.linearityUnits);
 }
 
-}  // namespace table
+template <typename ImagePixelT, typename VariancePixelT>
+void makeVariancePlane(image::Image<ImagePixelT> const & image,
+                       image::Image<VariancePixelT> & variance,
+                       std::vector<std::shared_ptr<Amplifier const>> const & amplifiers) {
+    if (variance.getBBox() != image.getBBox()) {
+        throw LSST_EXCEPT(
+            pex::exceptions::InvalidParameterError,
+            (boost::format("Variance bbox %s does not match image bbox %s") %
+             variance.getBBox() % image.getBBox()).str()
+        );
+    }
+    // Resolve the per-amplifier constants before any pixel is touched, so
+    // the row loops below are pure multiply-adds (and so we fail before
+    // writing anything if an amplifier is bad).
+    struct AmpConstants {
+        lsst::geom::Box2I bbox;
+        double inverseGain;    // 1/gain, in ADU/e-
+        double readVariance;   // (readNoise/gain)^2, in ADU^2
+    };
+    std::vector<AmpConstants> constants;
+    constants.reserve(amplifiers.size());
+    for (auto const & amp : amplifiers) {
+        if (!image.getBBox().contains(amp->getBBox())) {
+            throw LSST_EXCEPT(
+                pex::exceptions::InvalidParameterError,
+                (boost::format("Amplifier %s bbox %s extends outside the image bbox %s") %
+                 amp->getName() % amp->getBBox() % image.getBBox()).str()
+            );
+        }
+        if (!(amp->getGain() > 0)) {
+            throw LSST_EXCEPT(
+                pex::exceptions::InvalidParameterError,
+                (boost::format("Amplifier %s has non-positive gain %g") %
+                 amp->getName() % amp->getGain()).str()
+            );
+        }
+        double const inverseGain = 1.0 / amp->getGain();
+        double const readNoiseAdu = amp->getReadNoise() * inverseGain;
+        constants.push_back(AmpConstants{amp->getBBox(), inverseGain, readNoiseAdu * readNoiseAdu});
+    }
+    // Amplifier regions are disjoint, so each one can be written by its own
+    // task; the pool bounds how many actually run at once.
+    math::TaskPool::TaskGroup group;
+    for (auto const & amp : constants) {
+        group.run([&image, &variance, amp] {
+            int const x0 = amp.bbox.getMinX() - image.getX0();
+            int const y0 = amp.bbox.getMinY() - image.getY0();
+            for (int y = 0; y != amp.bbox.getHeight(); ++y) {
+                auto imgPtr = image.x_at(x0, y0 + y);
+                auto varPtr = variance.x_at(x0, y0 + y);
+                for (int x = 0; x != amp.bbox.getWidth(); ++x, ++imgPtr, ++varPtr) {
+                    *varPtr = *imgPtr * amp.inverseGain + amp.readVariance;
+                }
+            }
+        });
+    }
+    group.wait();
+}
+
+#define INSTANTIATE(IMAGEPIXEL)                                           \
+    template void makeVariancePlane(image::Image<IMAGEPIXEL> const &,     \
+                                    image::Image<float> &,                \
+                                    std::vector<std::shared_ptr<Amplifier const>> const &); \
+    template void makeVariancePlane(image::Image<IMAGEPIXEL> const &,     \
+                                    image::Image<double> &,               \
+                                    std::vector<std::shared_ptr<Amplifier const>> const &);
+
+INSTANTIATE(int)
+INSTANTIATE(float)
+INSTANTIATE(double)
+
+#undef INSTANTIATE
+
+}  // namespace cameraGeom
 }  // namespace afw
 }  // namespace lsst
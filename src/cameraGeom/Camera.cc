@@ -44,35 +44,14 @@ Camera::Builder Camera::rebuild() const {
 
 Camera::DetectorList Camera::findDetectors(lsst::geom::Point2D const &point,
                                            CameraSys const &cameraSys) const {
-    auto nativePoint = transform(point, cameraSys, getNativeCameraSys());
-
-    DetectorList detectorList;
-    for (auto const &item : getIdMap()) {
-        auto detector = item.second;
-        auto pointPixels = detector->transform(nativePoint, getNativeCameraSys(), PIXELS);
-        if (lsst::geom::Box2D(detector->getBBox()).contains(pointPixels)) {
-            detectorList.push_back(std::move(detector));
-        }
-    }
-    return detectorList;
+    // DetectorCollection's spatial index does the actual search, after we
+    // transform the point to its native (FOCAL_PLANE) system.
+    return DetectorCollection::findDetectors(transform(point, cameraSys, getNativeCameraSys()));
 }
 
 std::vector<Camera::DetectorList> Camera::findDetectorsList(std::vector<lsst::geom::Point2D> const &pointList,
                                                             CameraSys const &cameraSys) const {
-    std::vector<DetectorList> detectorListList(pointList.size());
-    auto nativePointList = transform(pointList, cameraSys, getNativeCameraSys());
-
-    for (auto const &item: getIdMap()) {
-        auto const &detector = item.second;
-        auto pointPixelsList = detector->transform(nativePointList, getNativeCameraSys(), PIXELS);
-        for (std::size_t i = 0; i < pointPixelsList.size(); ++i) {
-            auto const &pointPixels = pointPixelsList[i];
-            if (lsst::geom::Box2D(detector->getBBox()).contains(pointPixels)) {
-                detectorListList[i].push_back(detector);
-            }
-        }
-    }
-    return detectorListList;
+    return DetectorCollection::findDetectorsList(transform(pointList, cameraSys, getNativeCameraSys()));
 }
 
 std::shared_ptr<afw::geom::TransformPoint2ToPoint2> Camera::getTransform(CameraSys const &fromSys,
@@ -93,6 +72,28 @@ std::vector<lsst::geom::Point2D> Camera::transform(std::vector<lsst::geom::Point
     return transform->applyForward(points);
 }
 
+std::map<int, std::vector<lsst::geom::Point2D>> Camera::transform(
+        std::map<int, std::vector<lsst::geom::Point2D>> const &pointsByDetector,
+        CameraSysPrefix const &fromSys, CameraSys const &toSys) const {
+    std::map<int, std::vector<lsst::geom::Point2D>> result;
+    for (auto const &pair : pointsByDetector) {
+        auto const detector = (*this)[pair.first];
+        result.emplace(pair.first, transform(pair.second, detector->makeCameraSys(fromSys), toSys));
+    }
+    return result;
+}
+
+std::map<int, std::vector<lsst::geom::Point2D>> Camera::transform(
+        std::map<int, std::vector<lsst::geom::Point2D>> const &pointsByDetector,
+        CameraSys const &fromSys, CameraSysPrefix const &toSys) const {
+    std::map<int, std::vector<lsst::geom::Point2D>> result;
+    for (auto const &pair : pointsByDetector) {
+        auto const detector = (*this)[pair.first];
+        result.emplace(pair.first, transform(pair.second, fromSys, detector->makeCameraSys(toSys)));
+    }
+    return result;
+}
+
 std::shared_ptr<Detector::InCameraBuilder> Camera::makeDetectorBuilder(std::string const & name, int id) {
     return std::shared_ptr<Detector::InCameraBuilder>(new Detector::InCameraBuilder(name, id));
 }
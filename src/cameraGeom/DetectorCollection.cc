@@ -19,6 +19,9 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
+
 #include "lsst/afw/table/io/Persistable.cc"
 #include "lsst/afw/table/io/CatalogVector.h"
 #include "lsst/afw/table/io/InputArchive.h"
@@ -212,6 +215,118 @@ DetectorCollection::DetectorCollection(List const & detectorList) :
             _fpBBox.include(corner);
         }
     }
+    _buildIndex(detectorList);
+}
+
+void DetectorCollection::_buildIndex(List const & detectorList) {
+    if (detectorList.empty()) {
+        return;
+    }
+    // Aim for roughly one detector per cell; queries then test only the few
+    // detectors whose boxes overlap the cell containing the point.
+    int const shape = std::max(
+        1, static_cast<int>(std::ceil(std::sqrt(static_cast<double>(detectorList.size())))));
+    _indexShape = lsst::geom::Extent2I(shape, shape);
+    // Compute each detector's FOCAL_PLANE bounding box, grown slightly in
+    // case optical distortion bows a detector edge outside the bounding box
+    // of its transformed corners; candidates are confirmed exactly in
+    // findDetectors, so a too-generous box costs only a little extra work.
+    std::vector<lsst::geom::Box2D> boxes;
+    boxes.reserve(detectorList.size());
+    for (auto const & detector : detectorList) {
+        lsst::geom::Box2D box;
+        for (auto const & corner : detector->getCorners(FOCAL_PLANE)) {
+            box.include(corner);
+        }
+        box.grow(lsst::geom::Extent2D(0.01*box.getWidth(), 0.01*box.getHeight()));
+        _indexBBox.include(box);
+        boxes.push_back(box);
+    }
+    _indexCells.resize(shape*shape);
+    double const cellWidth = _indexBBox.getWidth()/shape;
+    double const cellHeight = _indexBBox.getHeight()/shape;
+    auto toCell = [shape](double offset, double cellSize) {
+        return std::min(std::max(static_cast<int>(std::floor(offset/cellSize)), 0), shape - 1);
+    };
+    for (std::size_t n = 0; n < detectorList.size(); ++n) {
+        int const ixMin = toCell(boxes[n].getMinX() - _indexBBox.getMinX(), cellWidth);
+        int const ixMax = toCell(boxes[n].getMaxX() - _indexBBox.getMinX(), cellWidth);
+        int const iyMin = toCell(boxes[n].getMinY() - _indexBBox.getMinY(), cellHeight);
+        int const iyMax = toCell(boxes[n].getMaxY() - _indexBBox.getMinY(), cellHeight);
+        for (int iy = iyMin; iy <= iyMax; ++iy) {
+            for (int ix = ixMin; ix <= ixMax; ++ix) {
+                _indexCells[iy*shape + ix].push_back(detectorList[n]);
+            }
+        }
+    }
+    // Order each cell by ID so query results do not depend on the order of
+    // the input detector list.
+    for (auto & cell : _indexCells) {
+        std::sort(cell.begin(), cell.end(),
+                  [](std::shared_ptr<Detector const> const & a,
+                     std::shared_ptr<Detector const> const & b) { return a->getId() < b->getId(); });
+    }
+}
+
+DetectorCollection::List const & DetectorCollection::_findCandidates(
+    lsst::geom::Point2D const & fpPosition
+) const {
+    static List const empty;
+    if (_indexCells.empty() || !_indexBBox.contains(fpPosition)) {
+        return empty;
+    }
+    int const shape = _indexShape.getX();
+    int const ix = std::min(
+        static_cast<int>(std::floor((fpPosition.getX() - _indexBBox.getMinX())
+                                    * shape/_indexBBox.getWidth())),
+        shape - 1);
+    int const iy = std::min(
+        static_cast<int>(std::floor((fpPosition.getY() - _indexBBox.getMinY())
+                                    * shape/_indexBBox.getHeight())),
+        shape - 1);
+    return _indexCells[iy*shape + ix];
+}
+
+DetectorCollection::List DetectorCollection::findDetectors(lsst::geom::Point2D const & fpPosition) const {
+    List result;
+    for (auto const & detector : _findCandidates(fpPosition)) {
+        auto pointPixels = detector->transform(fpPosition, FOCAL_PLANE, PIXELS);
+        if (lsst::geom::Box2D(detector->getBBox()).contains(pointPixels)) {
+            result.push_back(detector);
+        }
+    }
+    return result;
+}
+
+std::vector<DetectorCollection::List> DetectorCollection::findDetectorsList(
+    std::vector<lsst::geom::Point2D> const & fpPositionList
+) const {
+    std::vector<List> result(fpPositionList.size());
+    // Group the points by candidate detector so the exact confirmation below
+    // can use one vectorized transform call per detector instead of one
+    // scalar call per (point, candidate) pair.
+    std::map<int, std::vector<std::size_t>> candidates;
+    for (std::size_t i = 0; i < fpPositionList.size(); ++i) {
+        for (auto const & detector : _findCandidates(fpPositionList[i])) {
+            candidates[detector->getId()].push_back(i);
+        }
+    }
+    for (auto const & pair : candidates) {
+        auto const detector = get(pair.first);
+        std::vector<lsst::geom::Point2D> fpPoints;
+        fpPoints.reserve(pair.second.size());
+        for (auto i : pair.second) {
+            fpPoints.push_back(fpPositionList[i]);
+        }
+        auto pixelPoints = detector->transform(fpPoints, FOCAL_PLANE, PIXELS);
+        lsst::geom::Box2D const bbox(detector->getBBox());
+        for (std::size_t j = 0; j < pixelPoints.size(); ++j) {
+            if (bbox.contains(pixelPoints[j])) {
+                result[pair.second[j]].push_back(detector);
+            }
+        }
+    }
+    return result;
 }
 
 class DetectorCollection::Factory : public table::io::PersistableFactory {
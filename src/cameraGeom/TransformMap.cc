@@ -232,7 +232,18 @@ int TransformMap::_getFrame(CameraSys const &system) const {
 
 std::shared_ptr<ast::Mapping const> TransformMap::_getMapping(CameraSys const &fromSys,
                                                               CameraSys const &toSys) const {
-    return _frameSet->getMapping(_getFrame(fromSys), _getFrame(toSys));
+    auto const fromId = _getFrame(fromSys);
+    auto const toId = _getFrame(toSys);
+    auto const key = (static_cast<std::uint64_t>(fromId) << 32) | static_cast<std::uint32_t>(toId);
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    auto iter = _mappingCache.find(key);
+    if (iter == _mappingCache.end()) {
+        // Compose the path between the frames once and store the simplified
+        // mapping; steady-state transforms between this pair of systems then
+        // reuse it without traversing the frame set again.
+        iter = _mappingCache.emplace(key, _frameSet->getMapping(fromId, toId)->simplified()).first;
+    }
+    return iter->second;
 }
 
 size_t TransformMap::size() const noexcept { return _frameIds.size(); }
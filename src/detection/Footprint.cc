@@ -412,6 +412,111 @@ std::vector<lsst::geom::Box2I> footprintToBBoxList(Footprint const& footprint) {
     return bboxes;
 }
 
+std::vector<std::shared_ptr<Footprint>> transformFootprints(
+        std::vector<std::shared_ptr<Footprint>> const& footprints, std::shared_ptr<geom::SkyWcs> source,
+        std::shared_ptr<geom::SkyWcs> target, lsst::geom::Box2I const& region, bool doClip) {
+    // Set up the source-to-target mapping once for the whole collection
+    auto transform = geom::makeWcsPairTransform(*source, *target);
+
+    std::size_t const num = footprints.size();
+
+    // Forward-transform all bounding box corners and peak positions in a single call
+    std::vector<lsst::geom::Point2D> forwardPoints;
+    std::vector<std::size_t> offsets(num);  // index of each footprint's first point in forwardPoints
+    for (std::size_t i = 0; i < num; ++i) {
+        offsets[i] = forwardPoints.size();
+        for (auto const& corner : footprints[i]->getBBox().getCorners()) {
+            forwardPoints.emplace_back(lsst::geom::Point2D(corner));
+        }
+        for (auto const& peak : footprints[i]->getPeaks()) {
+            forwardPoints.emplace_back(peak.getF());
+        }
+    }
+    auto transformedPoints = transform->applyForward(forwardPoints);
+
+    // Compute the target-frame bounding boxes, exactly as SpanSet::transformedBy does
+    std::vector<lsst::geom::Box2I> newBBoxes(num);
+    for (std::size_t i = 0; i < num; ++i) {
+        lsst::geom::Box2D newBBoxD;
+        for (std::size_t corner = 0; corner < 4; ++corner) {
+            newBBoxD.include(transformedPoints[offsets[i] + corner]);
+        }
+        newBBoxes[i] = lsst::geom::Box2I(newBBoxD);
+    }
+
+    // Rasterize by inverse-transforming the target-frame pixel grids, batching rows from many
+    // footprints into each call; the budget bounds the memory used by the coordinate arrays
+    std::size_t const pointBudget = 1 << 20;
+    struct RowJob {
+        std::size_t footprint;
+        int y;
+    };
+    std::vector<std::vector<geom::Span>> spanVectors(num);
+    std::vector<RowJob> jobs;
+    std::vector<lsst::geom::Point2D> gridPoints;
+    auto flushJobs = [&jobs, &gridPoints, &spanVectors, &footprints, &newBBoxes, &transform]() {
+        if (jobs.empty()) {
+            return;
+        }
+        auto sourcePoints = transform->applyInverse(gridPoints);
+        auto sourcePointIter = sourcePoints.cbegin();
+        for (auto const& job : jobs) {
+            lsst::geom::Box2I const& bbox = newBBoxes[job.footprint];
+            geom::SpanSet const& spans = *footprints[job.footprint]->getSpans();
+            bool inSpan = false;  // Are we in a span?
+            int start = -1;       // Start of span
+            for (int x = bbox.getBeginX(); x < bbox.getEndX(); ++x, ++sourcePointIter) {
+                int const xSource = std::floor(0.5 + sourcePointIter->getX());
+                int const ySource = std::floor(0.5 + sourcePointIter->getY());
+                if (spans.contains(lsst::geom::Point2I(xSource, ySource))) {
+                    if (!inSpan) {
+                        inSpan = true;
+                        start = x;
+                    }
+                } else if (inSpan) {
+                    inSpan = false;
+                    spanVectors[job.footprint].push_back(geom::Span(job.y, start, x - 1));
+                }
+            }
+            if (inSpan) {
+                spanVectors[job.footprint].push_back(geom::Span(job.y, start, bbox.getMaxX()));
+            }
+        }
+        jobs.clear();
+        gridPoints.clear();
+    };
+    for (std::size_t i = 0; i < num; ++i) {
+        for (int y = newBBoxes[i].getBeginY(); y < newBBoxes[i].getEndY(); ++y) {
+            for (int x = newBBoxes[i].getBeginX(); x < newBBoxes[i].getEndX(); ++x) {
+                gridPoints.emplace_back(lsst::geom::Point2D(x, y));
+            }
+            jobs.push_back(RowJob{i, y});
+            if (gridPoints.size() >= pointBudget) {
+                flushJobs();
+            }
+        }
+    }
+    flushJobs();
+
+    // Assemble the new footprints, carrying over the already-transformed peaks
+    std::vector<std::shared_ptr<Footprint>> results(num);
+    for (std::size_t i = 0; i < num; ++i) {
+        auto newSpans = std::make_shared<geom::SpanSet>(std::move(spanVectors[i]));
+        auto newFootprint =
+                std::make_shared<Footprint>(newSpans, footprints[i]->getPeaks().getSchema(), region);
+        auto newPeakPos = transformedPoints.cbegin() + offsets[i] + 4;
+        for (auto const& peak : footprints[i]->getPeaks()) {
+            newFootprint->addPeak(newPeakPos->getX(), newPeakPos->getY(), peak.getPeakValue());
+            ++newPeakPos;
+        }
+        if (doClip) {
+            newFootprint->clipTo(region);
+        }
+        results[i] = newFootprint;
+    }
+    return results;
+}
+
 void Footprint::setPeakSchema(afw::table::Schema const& peakSchema) {
     setPeakCatalog(PeakCatalog(peakSchema));
 }
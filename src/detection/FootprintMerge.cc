@@ -19,7 +19,11 @@
  * the GNU General Public License along with this program.  If not,
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
+#include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
 
 #include "boost/bind.hpp"
 
@@ -203,6 +207,110 @@ private:
     std::shared_ptr<afw::table::SourceRecord> _source;
 };
 
+namespace {
+
+/*
+ * Uniform-grid spatial index over the bounding boxes of the FootprintMerges
+ * under construction.  addCatalog queries it for overlap candidates instead of
+ * scanning the whole merge list for every input footprint, which is quadratic
+ * in crowded fields.  Stale cell entries left behind by removals and box
+ * growth are filtered out at query time.
+ */
+class MergeGridIndex {
+public:
+    explicit MergeGridIndex(int cellSize) : _cellSize(cellSize), _nextOrdinal(0) {}
+
+    // Add a new merge to the index
+    void insert(std::shared_ptr<FootprintMerge> const &merge) {
+        Entry &entry = _entries[merge.get()];
+        entry.ordinal = _nextOrdinal++;
+        entry.covered = lsst::geom::Box2I();
+        _cover(merge);
+    }
+
+    // Record that merge's bounding box may have grown; newly covered cells are added
+    void update(std::shared_ptr<FootprintMerge> const &merge) { _cover(merge); }
+
+    void remove(FootprintMerge *merge) { _entries.erase(merge); }
+
+    bool contains(FootprintMerge *merge) const { return _entries.count(merge) != 0; }
+
+    // Return the live merges whose cells overlap box, in insertion order
+    std::vector<std::shared_ptr<FootprintMerge>> query(lsst::geom::Box2I const &box) const {
+        std::vector<std::pair<std::size_t, std::shared_ptr<FootprintMerge>>> found;
+        int const cx0 = _cellCoord(box.getMinX()), cx1 = _cellCoord(box.getMaxX());
+        int const cy0 = _cellCoord(box.getMinY()), cy1 = _cellCoord(box.getMaxY());
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                auto cell = _cells.find(_cellKey(cx, cy));
+                if (cell == _cells.end()) {
+                    continue;
+                }
+                for (auto const &merge : cell->second) {
+                    auto entry = _entries.find(merge.get());
+                    if (entry == _entries.end()) {
+                        continue;  // removed; its cell entries are stale
+                    }
+                    found.emplace_back(entry->second.ordinal, merge);
+                }
+            }
+        }
+        std::sort(found.begin(), found.end(),
+                  [](auto const &a, auto const &b) { return a.first < b.first; });
+        std::vector<std::shared_ptr<FootprintMerge>> result;
+        result.reserve(found.size());
+        for (auto const &item : found) {
+            if (result.empty() || result.back() != item.second) {
+                result.push_back(item.second);
+            }
+        }
+        return result;
+    }
+
+private:
+    struct Entry {
+        std::size_t ordinal;
+        lsst::geom::Box2I covered;  // cells within this box are already recorded
+    };
+
+    int _cellCoord(int v) const {
+        // Round towards negative infinity so the grid is uniform across the origin
+        return v >= 0 ? v / _cellSize : -((-v - 1) / _cellSize) - 1;
+    }
+
+    static std::uint64_t _cellKey(int cx, int cy) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) |
+               static_cast<std::uint32_t>(cy);
+    }
+
+    // Add merge to every cell its bounding box covers that is not covered already
+    void _cover(std::shared_ptr<FootprintMerge> const &merge) {
+        Entry &entry = _entries[merge.get()];
+        lsst::geom::Box2I const box = merge->getBBox();
+        if (box.isEmpty()) {
+            return;
+        }
+        int const cx0 = _cellCoord(box.getMinX()), cx1 = _cellCoord(box.getMaxX());
+        int const cy0 = _cellCoord(box.getMinY()), cy1 = _cellCoord(box.getMaxY());
+        for (int cy = cy0; cy <= cy1; ++cy) {
+            for (int cx = cx0; cx <= cx1; ++cx) {
+                if (entry.covered.contains(lsst::geom::Point2I(cx, cy))) {
+                    continue;
+                }
+                _cells[_cellKey(cx, cy)].push_back(merge);
+            }
+        }
+        entry.covered = lsst::geom::Box2I(lsst::geom::Point2I(cx0, cy0), lsst::geom::Point2I(cx1, cy1));
+    }
+
+    int _cellSize;
+    std::size_t _nextOrdinal;
+    std::unordered_map<FootprintMerge *, Entry> _entries;
+    std::unordered_map<std::uint64_t, std::vector<std::shared_ptr<FootprintMerge>>> _cells;
+};
+
+}  // namespace
+
 FootprintMergeList::FootprintMergeList(afw::table::Schema &sourceSchema,
                                        std::vector<std::string> const &filterList,
                                        afw::table::Schema const &initialPeakSchema)
@@ -250,6 +358,18 @@ void FootprintMergeList::addCatalog(std::shared_ptr<afw::table::SourceTable> sou
     // If list is empty or merging not requested, don't check for any matches, just add all the objects
     bool checkForMatches = !_mergeList.empty() && doMerge;
 
+    // Index the current merge list spatially so each input footprint only
+    // inspects nearby merges rather than the whole list.  64-pixel cells are a
+    // reasonable compromise between index size and candidate-list length for
+    // typical footprints.
+    MergeGridIndex index(64);
+    if (checkForMatches) {
+        for (auto const &merge : _mergeList) {
+            index.insert(merge);
+        }
+    }
+    bool anyRemoved = false;
+
     for (afw::table::SourceCatalog::const_iterator srcIter = inputCat.begin(); srcIter != inputCat.end();
          ++srcIter) {
         // Only consider unblended objects
@@ -262,40 +382,59 @@ void FootprintMergeList::addCatalog(std::shared_ptr<afw::table::SourceTable> sou
         std::shared_ptr<FootprintMerge> first = std::shared_ptr<FootprintMerge>();
 
         if (checkForMatches) {
-            FootprintMergeVec::iterator iter = _mergeList.begin();
-            while (iter != _mergeList.end()) {
-                // Grow by one pixel to allow for touching
-                lsst::geom::Box2I box((**iter).getBBox());
+            // Grow by one pixel to allow for touching
+            lsst::geom::Box2I searchBox(foot->getBBox());
+            if (!searchBox.isEmpty()) {
+                searchBox.grow(lsst::geom::Extent2I(1, 1));
+            }
+            for (auto const &candidate : index.query(searchBox)) {
+                lsst::geom::Box2I box(candidate->getBBox());
                 box.grow(lsst::geom::Extent2I(1, 1));
-                if (box.overlaps(foot->getBBox()) && (**iter).overlaps(*foot)) {
+                if (box.overlaps(foot->getBBox()) && candidate->overlaps(*foot)) {
                     if (!first) {
-                        first = *iter;
+                        first = candidate;
                         // Spatially extend existing FootprintMerge in order to connect subsequent,
                         // now-overlapping FootprintMerges. If a subsequent FootprintMerge overlaps with
                         // the new footprint, it's now guaranteed to overlap with this first FootprintMerge.
                         // Hold off adding foot's lower-priority footprints and peaks until the
                         // higher-priority existing peaks are merged into this first FootprintMerge.
                         first->addSpans(foot);
+                        index.update(first);
                     } else {
-                        // Add existing merged Footprint to first
-                        first->add(**iter, _filterMap, minNewPeakDist, maxSamePeakDist);
-                        iter = _mergeList.erase(iter);
-                        continue;
+                        // Add existing merged Footprint to first and drop it from the index;
+                        // the merge list itself is purged of dead entries after the loop
+                        first->add(*candidate, _filterMap, minNewPeakDist, maxSamePeakDist);
+                        index.update(first);
+                        index.remove(candidate.get());
+                        anyRemoved = true;
                     }
                 }
-                ++iter;
-            } // while mergeList
+            }
         } //     if checkForMatches
 
         if (first) {
             // Now merge footprint including peaks into the newly-connected, higher-priority FootprintMerge
             first->add(foot, _peakSchemaMapper, keyIter->second, minNewPeakDist, maxSamePeakDist);
+            if (checkForMatches) {
+                index.update(first);
+            }
         } else {
            // Footprint did not overlap with any existing FootprintMerges. Add to MergeList
             _mergeList.push_back(std::make_shared<FootprintMerge>(foot, sourceTable, _peakTable,
                                                                   _peakSchemaMapper, keyIter->second));
+            if (checkForMatches) {
+                index.insert(_mergeList.back());
+            }
         }
     }
+
+    if (anyRemoved) {
+        _mergeList.erase(std::remove_if(_mergeList.begin(), _mergeList.end(),
+                                        [&index](std::shared_ptr<FootprintMerge> const &merge) {
+                                            return !index.contains(merge.get());
+                                        }),
+                         _mergeList.end());
+    }
 }
 
 void FootprintMergeList::getFinalSources(afw::table::SourceCatalog &outputCat) {
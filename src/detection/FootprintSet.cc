@@ -42,14 +42,21 @@
 #include <cstdint>
 #include <memory>
 #include <algorithm>
+#include <numeric>
 #include <cassert>
+#include <exception>
 #include <set>
 #include <string>
+#include <thread>
 #include <typeinfo>
+#include <unordered_map>
+#include <vector>
 #include "boost/format.hpp"
 #include "lsst/pex/exceptions.h"
 #include "lsst/afw/image/MaskedImage.h"
+#include "lsst/afw/math/ConvolveImage.h"
 #include "lsst/afw/math/Statistics.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/afw/detection/Peak.h"
 #include "lsst/afw/detection/FootprintSet.h"
 #include "lsst/afw/detection/FootprintCtrl.h"
@@ -208,11 +215,12 @@ struct SortPeaks {
 /*
  * Worker routine for merging two FootprintSets, possibly growing them as we proceed
  */
-FootprintSet mergeFootprintSets(FootprintSet const &lhs,      // the FootprintSet to be merged to
-                                int rLhs,                     // Grow lhs Footprints by this many pixels
-                                FootprintSet const &rhs,      // the FootprintSet to be merged into lhs
-                                int rRhs,                     // Grow rhs Footprints by this many pixels
-                                FootprintControl const &ctrl  // Control how the grow is done
+FootprintSet mergeFootprintSets(FootprintSet const &lhs,       // the FootprintSet to be merged to
+                                int rLhs,                      // Grow lhs Footprints by this many pixels
+                                FootprintSet const &rhs,       // the FootprintSet to be merged into lhs
+                                int rRhs,                      // Grow rhs Footprints by this many pixels
+                                FootprintControl const &ctrl,  // Control how the grow is done
+                                int numThreads = 1             // number of threads to merge with
 ) {
     typedef FootprintSet::FootprintList FootprintList;
     // The isXXX routines return <isset, value>
@@ -329,25 +337,36 @@ FootprintSet mergeFootprintSets(FootprintSet const &lhs,      // the FootprintSe
         }
     }
 
-    FootprintSet fs(*idImage, Threshold(1), 1, false);  // detect all pixels in rhs + lhs
-                                                        /*
-                                                         * Now go through the new Footprints looking up and remembering their progenitor's IDs; we'll use
-                                                         * these IDs to merge the peaks in a moment
-                                                         *
-                                                         * We can't do this as we go through the idFinder as the IDs it returns are
-                                                         *   (lhsId + 1) | ((rhsId + 1) << nbit)
-                                                         * and, depending on the geometry, values of lhsId and/or rhsId can appear multiple times
-                                                         * (e.g. if nbit is 2, idFinder IDs 0x5 and 0x6 both contain lhsId = 0) so we get duplicates
-                                                         * of peaks.  This is not too bad, but it's a bit of a pain to make the lists unique again,
-                                                         * and we avoid this by this two-step process.
-                                                         */
-    FindIdsInFootprint<IdPixelT> idFinder;
-    for (FootprintList::iterator ptr = fs.getFootprints()->begin(), end = fs.getFootprints()->end();
-         ptr != end; ++ptr) {
-        std::shared_ptr<Footprint> foot = *ptr;
-
+    // detect all pixels in rhs + lhs; the scan is row-bucketed across the threads and the pieces
+    // are stitched back together through the strips' alias (union-find) tables
+    FootprintSet fs(*idImage, Threshold(1), 1, false, numThreads);
+    /*
+     * The strip decomposition, and hence the raw Footprint order, depends on the thread count, so
+     * put the merged Footprints into a canonical order -- by their first span -- to make the
+     * result identical however many threads produced it.  Footprints are disjoint, so the first
+     * span (the SpanSet is sorted) is a unique key.
+     */
+    FootprintList &merged = *fs.getFootprints();
+    std::sort(merged.begin(), merged.end(),
+              [](std::shared_ptr<Footprint> const &a, std::shared_ptr<Footprint> const &b) {
+                  geom::Span const &sa = *a->getSpans()->begin();
+                  geom::Span const &sb = *b->getSpans()->begin();
+                  return std::make_pair(sa.getY(), sa.getX0()) < std::make_pair(sb.getY(), sb.getX0());
+              });
+    /*
+     * Now go through the new Footprints looking up and remembering their progenitor's IDs; we'll use
+     * these IDs to merge the peaks in a moment
+     *
+     * We can't do this as we go through the idFinder as the IDs it returns are
+     *   (lhsId + 1) | ((rhsId + 1) << nbit)
+     * and, depending on the geometry, values of lhsId and/or rhsId can appear multiple times
+     * (e.g. if nbit is 2, idFinder IDs 0x5 and 0x6 both contain lhsId = 0) so we get duplicates
+     * of peaks.  This is not too bad, but it's a bit of a pain to make the lists unique again,
+     * and we avoid this by this two-step process.
+     */
+    auto const mergePeaksInto = [&](Footprint &foot, FindIdsInFootprint<IdPixelT> &idFinder) {
         // find the (mangled) [lr]hsFootprint IDs that contribute to foot
-        foot->getSpans()->applyFunctor(idFinder, *idImage);
+        foot.getSpans()->applyFunctor(idFinder, *idImage);
 
         std::set<std::uint64_t> lhsFootprintIndxs, rhsFootprintIndxs;  // indexes into [lr]hsFootprints
 
@@ -393,7 +412,7 @@ FootprintSet mergeFootprintSets(FootprintSet const &lhs,      // the FootprintSe
          * We now have a complete set of Footprints that contributed to this one, so merge
          * all their Peaks into the new one
          */
-        PeakCatalog &peaks = foot->getPeaks();
+        PeakCatalog &peaks = foot.getPeaks();
 
         for (std::set<std::uint64_t>::iterator ptr = lhsFootprintIndxs.begin(), end = lhsFootprintIndxs.end();
              ptr != end; ++ptr) {
@@ -423,6 +442,30 @@ FootprintSet mergeFootprintSets(FootprintSet const &lhs,      // the FootprintSe
                                peaks.getInternal().end(), SortPeaks());
         }
         idFinder.reset();
+    };
+
+    if (numThreads <= 1 || merged.size() < 2) {
+        FindIdsInFootprint<IdPixelT> idFinder;
+        for (auto const &foot : merged) {
+            mergePeaksInto(*foot, idFinder);
+        }
+    } else {
+        /*
+         * Each Footprint's peak gathering is independent of the others (it reads the idImage and
+         * the input Footprints, and writes only its own PeakCatalog), so fan the Footprints out
+         * over the shared pool; the per-Footprint results don't depend on the scheduling
+         */
+        int const nChunks = static_cast<int>(std::min<std::size_t>(numThreads, merged.size()));
+        math::TaskPool::TaskGroup group;
+        for (int chunk = 0; chunk != nChunks; ++chunk) {
+            group.run([&, chunk] {
+                FindIdsInFootprint<IdPixelT> idFinder;
+                for (std::size_t i = chunk; i < merged.size(); i += nChunks) {
+                    mergePeaksInto(*merged[i], idFinder);
+                }
+            });
+        }
+        group.wait();
     }
 
     return fs;
@@ -578,7 +621,14 @@ static inline bool inFootprint(ImagePixelT pixVal, IterT, bool polarity, double
 template <typename ImagePixelT, typename IterT>
 static inline bool inFootprint(ImagePixelT pixVal, IterT var, bool polarity, double thresholdVal,
                                ThresholdPixelLevel_traits) {
-    return (polarity ? pixVal : -pixVal) >= thresholdVal * ::sqrt(*var);
+    if (thresholdVal < 0.0) {
+        return (polarity ? pixVal : -pixVal) >= thresholdVal * ::sqrt(*var);
+    }
+    // Compare in the squared domain to avoid a per-pixel sqrt; the explicit sign tests keep
+    // the same rejections as the direct comparison (negative or NaN variance never matches)
+    double const val = polarity ? pixVal : -pixVal;
+    double const variance = *var;
+    return val >= 0.0 && variance >= 0.0 && val * val >= thresholdVal * thresholdVal * variance;
 }
 
 template <typename ImagePixelT, typename IterT>
@@ -601,20 +651,92 @@ static inline IterT advancePtr(IterT varPtr, ThresholdPixelLevel_traits) {
 }
 
 /*
- * Here's the working routine for the FootprintSet constructors; see documentation
- * of the constructors themselves
+ * Resolve the span IDs against the alias table, then assemble the spans into Footprints, keeping
+ * those that cover at least npixMin pixels and include a pixel over the inclusion threshold
  */
-template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT, typename ThresholdTraitT>
-static void findFootprints(
-        typename FootprintSet::FootprintList *_footprints,  // Footprints
-        lsst::geom::Box2I const &_region,                   // BBox of pixels that are being searched
-        image::ImageBase<ImagePixelT> const &img,           // Image to search for objects
-        image::Image<VariancePixelT> const *var,            // img's variance
-        double const footprintThreshold,                    // threshold value for footprint
-        double const includeThresholdMultiplier,  // threshold (relative to footprintThreshold) for inclusion
-        bool const polarity,                      // if false, search _below_ thresholdVal
-        int const npixMin,                        // minimum number of pixels in an object
-        bool const setPeaks                       // should I set the Peaks list?
+template <typename ImagePixelT, typename ThresholdTraitT>
+static void buildFootprints(typename FootprintSet::FootprintList *_footprints,  // Footprints
+                            lsst::geom::Box2I const &_region,          // BBox of pixels being searched
+                            image::ImageBase<ImagePixelT> const &img,  // Image that was searched
+                            std::vector<IdSpan> &spans,                // y:x0,x1 for objects
+                            std::vector<int> const &aliases,  // aliases for initially disjoint parts
+                            int const npixMin,                // minimum number of pixels in an object
+                            bool const polarity,              // if false, we searched _below_ threshold
+                            bool const setPeaks               // should I set the Peaks list?
+) {
+    int const row0 = img.getY0();
+    int const col0 = img.getX0();
+    /*
+     * Resolve aliases; first alias chains, then the IDs in the spans
+     */
+    for (unsigned int i = 0; i < spans.size(); i++) {
+        spans[i].id = resolve_alias(aliases, spans[i].id);
+    }
+    /*
+     * Sort spans by ID, so we can sweep through them once
+     */
+    if (spans.size() > 0) {
+        std::sort(spans.begin(), spans.end(), IdSpanCompare());
+    }
+    /*
+     * Build Footprints from spans
+     */
+    unsigned int i0;  // initial value of i
+    if (spans.size() > 0) {
+        int id = spans[0].id;
+        i0 = 0;
+        for (unsigned int i = 0; i <= spans.size(); i++) {  // <= size to catch the last object
+            if (i == spans.size() || spans[i].id != id) {
+                bool good = false;  // Span includes pixel sufficient to include footprint in set?
+                std::vector<geom::Span> tempSpanList;
+                for (; i0 < i; i0++) {
+                    good |= spans[i0].good;
+                    tempSpanList.push_back(
+                            geom::Span(spans[i0].y + row0, spans[i0].x0 + col0, spans[i0].x1 + col0));
+                }
+                auto tempSpanSet = std::make_shared<geom::SpanSet>(std::move(tempSpanList));
+                auto fp = std::make_shared<Footprint>(tempSpanSet, _region);
+
+                if (good && fp->getArea() >= static_cast<std::size_t>(npixMin)) {
+                    _footprints->push_back(fp);
+                }
+            }
+
+            if (i < spans.size()) {
+                id = spans[i].id;
+            }
+        }
+    }
+    /*
+     * Find all peaks within those Footprints
+     */
+    if (setPeaks) {
+        typedef FootprintSet::FootprintList::iterator fiterator;
+        for (fiterator ptr = _footprints->begin(), end = _footprints->end(); ptr != end; ++ptr) {
+            findPeaks(*ptr, img, polarity, ThresholdTraitT());
+        }
+    }
+}
+
+/*
+ * Scan rows [yBegin, yEnd) of img for runs of above-threshold pixels, connecting them into objects
+ * with the union-find pass.  This is the per-strip phase of findFootprints: each strip starts with
+ * a blank "previous row", so objects that straddle a strip seam are found as separate pieces and
+ * stitched back together by the caller.
+ *
+ * Spans are appended in row order with strip-local IDs counting from 1, and aliases is the
+ * strip-local union-find table.  Returns the number of strip-local objects found.
+ */
+template <typename ImagePixelT, typename VariancePixelT, typename ThresholdTraitT>
+static int scanStripForSpans(image::ImageBase<ImagePixelT> const &img,  // Image to search for objects
+                             image::Image<VariancePixelT> const *var,   // img's variance
+                             double const footprintThreshold,           // threshold value for footprint
+                             double const includeThresholdMultiplier,  // threshold for inclusion
+                             bool const polarity,       // if false, search _below_ thresholdVal
+                             int const yBegin,          // first row of the strip
+                             int const yEnd,            // one past the last row of the strip
+                             std::vector<IdSpan> &spans,  // y:x0,x1 for objects
+                             std::vector<int> &aliases    // aliases for initially disjoint parts
 ) {
     int id;       /* object ID */
     int in_span;  /* object ID of current IdSpan */
@@ -623,9 +745,6 @@ static void findFootprints(
 
     double includeThreshold = footprintThreshold * includeThresholdMultiplier;  // Threshold for inclusion
 
-    int const row0 = img.getY0();
-    int const col0 = img.getX0();
-    int const height = img.getHeight();
     int const width = img.getWidth();
     /*
      * Storage for arrays that identify objects by ID. We want to be able to
@@ -638,11 +757,8 @@ static void findFootprints(
     std::vector<int>::iterator idc = id1.begin() + 1;  // object IDs in current/
     std::vector<int>::iterator idp = id2.begin() + 1;  //                       previous row
 
-    std::vector<int> aliases;          // aliases for initially disjoint parts of Footprints
-    aliases.reserve(1 + height / 20);  // initial size of aliases
-
-    std::vector<IdSpan> spans;          // y:x0,x1 for objects
-    spans.reserve(aliases.capacity());  // initial size of spans
+    aliases.reserve(1 + (yEnd - yBegin) / 20);  // initial size of aliases
+    spans.reserve(aliases.capacity());          // initial size of spans
 
     aliases.push_back(0);  // 0 --> 0
                            /*
@@ -652,7 +768,7 @@ static void findFootprints(
     typedef typename image::Image<VariancePixelT>::x_iterator x_var_iterator;
 
     in_span = 0;  // not in a span
-    for (int y = 0; y != height; ++y) {
+    for (int y = yBegin; y != yEnd; ++y) {
         if (idc == id1.begin() + 1) {
             idc = id2.begin() + 1;
             idp = id1.begin() + 1;
@@ -716,67 +832,430 @@ static void findFootprints(
             spans.emplace_back(in_span, y, x0, width - 1, good);
         }
     }
-    /*
-     * Resolve aliases; first alias chains, then the IDs in the spans
-     */
-    for (unsigned int i = 0; i < spans.size(); i++) {
-        spans[i].id = resolve_alias(aliases, spans[i].id);
+
+    return nobj;
+}
+
+/*
+ * Renumber each strip's IDs into a single space by offsetting them with the object counts of the
+ * preceding strips, merge the per-strip alias tables into one, stitch objects that touch across
+ * each strip seam, and concatenate the spans.  The scan is 8-connected (it looks at idp[x - 1]
+ * through idp[x + 1]), so a run in the row above a seam joins a run in the row below it if their
+ * column ranges come within one pixel of each other.
+ *
+ * The spans' y values must already be in a common coordinate system; stripY0[i] is the first row
+ * of strip i in that system.
+ */
+static void mergeStripSpans(std::vector<std::vector<IdSpan>> const &stripSpans,
+                            std::vector<std::vector<int>> const &stripAliases,
+                            std::vector<int> const &stripNobj, std::vector<int> const &stripY0,
+                            std::vector<IdSpan> &spans, std::vector<int> &aliases) {
+    int const nStrip = stripSpans.size();
+    std::vector<int> idOffset(nStrip + 1, 0);
+    for (int strip = 0; strip < nStrip; ++strip) {
+        idOffset[strip + 1] = idOffset[strip] + stripNobj[strip];
     }
-    /*
-     * Sort spans by ID, so we can sweep through them once
-     */
-    if (spans.size() > 0) {
-        std::sort(spans.begin(), spans.end(), IdSpanCompare());
+    aliases.resize(idOffset[nStrip] + 1);
+    aliases[0] = 0;
+    for (int strip = 0; strip < nStrip; ++strip) {
+        for (int i = 1; i <= stripNobj[strip]; ++i) {
+            aliases[idOffset[strip] + i] = stripAliases[strip][i] + idOffset[strip];
+        }
     }
-    /*
-     * Build Footprints from spans
-     */
-    unsigned int i0;  // initial value of i
-    if (spans.size() > 0) {
-        id = spans[0].id;
-        i0 = 0;
-        for (unsigned int i = 0; i <= spans.size(); i++) {  // <= size to catch the last object
-            if (i == spans.size() || spans[i].id != id) {
-                bool good = false;  // Span includes pixel sufficient to include footprint in set?
-                std::vector<geom::Span> tempSpanList;
-                for (; i0 < i; i0++) {
-                    good |= spans[i0].good;
-                    tempSpanList.push_back(
-                            geom::Span(spans[i0].y + row0, spans[i0].x0 + col0, spans[i0].x1 + col0));
+    for (int strip = 1; strip < nStrip; ++strip) {
+        int const seamY = stripY0[strip];  // first row of this strip
+        std::vector<IdSpan> const &above = stripSpans[strip - 1];
+        std::vector<IdSpan> const &below = stripSpans[strip];
+        // spans are in row order, so the seam rows sit at the ends of the strips' span lists
+        std::size_t aBegin = above.size();
+        while (aBegin > 0 && above[aBegin - 1].y == seamY - 1) {
+            --aBegin;
+        }
+        std::size_t bEnd = 0;
+        while (bEnd != below.size() && below[bEnd].y == seamY) {
+            ++bEnd;
+        }
+        for (std::size_t ai = aBegin; ai != above.size(); ++ai) {
+            for (std::size_t bi = 0; bi != bEnd; ++bi) {
+                if (below[bi].x0 > above[ai].x1 + 1) {
+                    break;  // runs are sorted by column, so no later run can touch either
                 }
-                auto tempSpanSet = std::make_shared<geom::SpanSet>(std::move(tempSpanList));
-                auto fp = std::make_shared<Footprint>(tempSpanSet, _region);
-
-                if (good && fp->getArea() >= static_cast<std::size_t>(npixMin)) {
-                    _footprints->push_back(fp);
+                if (below[bi].x1 < above[ai].x0 - 1) {
+                    continue;
+                }
+                int const aId = resolve_alias(aliases, above[ai].id + idOffset[strip - 1]);
+                int const bId = resolve_alias(aliases, below[bi].id + idOffset[strip]);
+                if (aId != bId) {
+                    aliases[bId] = aId;
                 }
             }
+        }
+    }
 
-            if (i < spans.size()) {
-                id = spans[i].id;
-            }
+    std::size_t nSpan = 0;
+    for (auto const &stripSpan : stripSpans) {
+        nSpan += stripSpan.size();
+    }
+    spans.reserve(nSpan);
+    for (int strip = 0; strip < nStrip; ++strip) {
+        for (IdSpan span : stripSpans[strip]) {
+            span.id += idOffset[strip];
+            spans.push_back(span);
         }
     }
-    /*
-     * Find all peaks within those Footprints
-     */
-    if (setPeaks) {
-        typedef FootprintSet::FootprintList::iterator fiterator;
-        for (fiterator ptr = _footprints->begin(), end = _footprints->end(); ptr != end; ++ptr) {
-            findPeaks(*ptr, img, polarity, ThresholdTraitT());
+}
+
+/*
+ * Here's the working routine for the FootprintSet constructors; see documentation
+ * of the constructors themselves
+ */
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT, typename ThresholdTraitT>
+static void findFootprints(
+        typename FootprintSet::FootprintList *_footprints,  // Footprints
+        lsst::geom::Box2I const &_region,                   // BBox of pixels that are being searched
+        image::ImageBase<ImagePixelT> const &img,           // Image to search for objects
+        image::Image<VariancePixelT> const *var,            // img's variance
+        double const footprintThreshold,                    // threshold value for footprint
+        double const includeThresholdMultiplier,  // threshold (relative to footprintThreshold) for inclusion
+        bool const polarity,                      // if false, search _below_ thresholdVal
+        int const npixMin,                        // minimum number of pixels in an object
+        bool const setPeaks,                      // should I set the Peaks list?
+        int numThreads                            // number of threads to scan the image with
+) {
+    int const height = img.getHeight();
+
+    std::vector<int> aliases;   // aliases for initially disjoint parts of Footprints
+    std::vector<IdSpan> spans;  // y:x0,x1 for objects
+
+    numThreads = std::min(numThreads, height);
+    if (numThreads <= 1) {
+        scanStripForSpans<ImagePixelT, VariancePixelT, ThresholdTraitT>(
+                img, var, footprintThreshold, includeThresholdMultiplier, polarity, 0, height, spans,
+                aliases);
+    } else {
+        /*
+         * Scan disjoint row strips in parallel.  Each strip knows nothing about its neighbours, so
+         * objects that straddle a seam come back as separate pieces; they are renumbered into one ID
+         * space and stitched together below, giving the same objects as a serial scan (although the
+         * IDs, and hence the order of the Footprints, may differ).
+         */
+        std::vector<std::vector<IdSpan>> stripSpans(numThreads);
+        std::vector<std::vector<int>> stripAliases(numThreads);
+        std::vector<int> stripNobj(numThreads, 0);
+
+        std::vector<std::thread> threads;
+        threads.reserve(numThreads);
+        std::vector<std::exception_ptr> errors(numThreads);
+        for (int strip = 0; strip < numThreads; ++strip) {
+            int const yBegin = strip * height / numThreads;
+            int const yEnd = (strip + 1) * height / numThreads;
+            threads.emplace_back([&, strip, yBegin, yEnd] {
+                try {
+                    stripNobj[strip] = scanStripForSpans<ImagePixelT, VariancePixelT, ThresholdTraitT>(
+                            img, var, footprintThreshold, includeThresholdMultiplier, polarity, yBegin,
+                            yEnd, stripSpans[strip], stripAliases[strip]);
+                } catch (...) {
+                    errors[strip] = std::current_exception();
+                }
+            });
+        }
+        for (auto &thread : threads) {
+            thread.join();
+        }
+        for (auto const &error : errors) {
+            if (error) {
+                std::rethrow_exception(error);
+            }
+        }
+        /*
+         * Renumber, stitch across the seams, and concatenate
+         */
+        std::vector<int> stripY0(numThreads);
+        for (int strip = 0; strip < numThreads; ++strip) {
+            stripY0[strip] = strip * height / numThreads;
         }
+        mergeStripSpans(stripSpans, stripAliases, stripNobj, stripY0, spans, aliases);
     }
+    buildFootprints<ImagePixelT, ThresholdTraitT>(_footprints, _region, img, spans, aliases, npixMin,
+                                                  polarity, setPeaks);
 }
 
 template <typename ImagePixelT>
 FootprintSet::FootprintSet(image::Image<ImagePixelT> const &img, Threshold const &threshold,
-                           int const npixMin, bool const setPeaks)
+                           int const npixMin, bool const setPeaks, int numThreads)
         : _footprints(new FootprintList()), _region(img.getBBox()) {
     typedef float VariancePixelT;
 
     findFootprints<ImagePixelT, image::MaskPixel, VariancePixelT, ThresholdLevel_traits>(
             _footprints.get(), _region, img, NULL, threshold.getValue(img), threshold.getIncludeMultiplier(),
-            threshold.getPolarity(), npixMin, setPeaks);
+            threshold.getPolarity(), npixMin, setPeaks, numThreads);
+}
+
+template <typename ImagePixelT>
+FootprintSet::FootprintSet(image::Image<ImagePixelT> const &img, image::Image<float> const &variance,
+                           Threshold const &threshold, int const npixMin, bool const setPeaks,
+                           int numThreads)
+        : _footprints(new FootprintList()), _region(img.getBBox()) {
+    if (threshold.getType() != Threshold::PIXEL_STDEV) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "Detection against a separate variance plane requires a PIXEL_STDEV threshold");
+    }
+    if (img.getDimensions() != variance.getDimensions()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Image and variance dimensions differ: (%d, %d) vs (%d, %d)") %
+                           img.getWidth() % img.getHeight() % variance.getWidth() % variance.getHeight())
+                                  .str());
+    }
+    findFootprints<ImagePixelT, image::MaskPixel, float, ThresholdPixelLevel_traits>(
+            _footprints.get(), _region, img, &variance, threshold.getValue(),
+            threshold.getIncludeMultiplier(), threshold.getPolarity(), npixMin, setPeaks, numThreads);
+}
+
+template <typename ImagePixelT>
+FootprintSet detectOnConvolvedImage(image::Image<ImagePixelT> const &img, math::Kernel const &kernel,
+                                    Threshold const &threshold, int const npixMin, bool const setPeaks) {
+    typedef float VariancePixelT;
+
+    if (threshold.getType() != Threshold::VALUE) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "detectOnConvolvedImage requires an absolute (VALUE) threshold: the statistics "
+                          "of the convolved image are never available as a whole");
+    }
+
+    int const width = img.getWidth();
+    int const height = img.getHeight();
+    int const kHeight = kernel.getHeight();
+    int const kCtrY = kernel.getCtr().getY();
+    math::ConvolutionControl const control;
+
+    double const thresholdVal = threshold.getValue();
+    double const includeMultiplier = threshold.getIncludeMultiplier();
+    bool const polarity = threshold.getPolarity();
+
+    /*
+     * Convolved rows are produced in bands through a reusable buffer instead of a full-frame
+     * temporary.  Each band's input overlaps its neighbours by (kHeight - 1) rows so every output
+     * row is fully convolved; output rows within the kernel margin of the frame edges are edge
+     * pixels (NaN for floating-point images), exactly as math::convolve leaves them.  The bands
+     * are scanned for spans as they are produced and stitched across the band seams afterwards,
+     * just like the strips of a parallel scan.
+     */
+    int const bandHeight = std::max(4 * kHeight, 256);
+    image::Image<ImagePixelT> buffer(width, std::min(height, bandHeight + kHeight - 1));
+
+    std::vector<std::vector<IdSpan>> bandSpans;
+    std::vector<std::vector<int>> bandAliases;
+    std::vector<int> bandNobj;
+    std::vector<int> bandY0;
+
+    for (int y0 = 0; y0 < height; y0 += bandHeight) {
+        int const y1 = std::min(height, y0 + bandHeight);  // output rows [y0, y1) of the frame
+        int inY0 = std::max(0, y0 - kCtrY);                // input rows feeding them
+        int const inY1 = std::min(height, y1 + (kHeight - 1 - kCtrY));
+        if (inY1 - inY0 < kHeight) {
+            // convolve() needs at least kHeight input rows; a short final band borrows extra
+            // rows above, whose output is simply rescanned as part of the previous band's range
+            inY0 = std::max(0, inY1 - kHeight);
+        }
+        lsst::geom::Box2I const inBox(lsst::geom::Point2I(0, inY0),
+                                      lsst::geom::Extent2I(width, inY1 - inY0));
+        image::Image<ImagePixelT> const inView(img, inBox, image::LOCAL, false);
+        image::Image<ImagePixelT> outView(
+                buffer, lsst::geom::Box2I(lsst::geom::Point2I(0, 0), inBox.getDimensions()),
+                image::LOCAL, false);
+        math::convolve(outView, inView, kernel, control);
+
+        bandSpans.emplace_back();
+        bandAliases.emplace_back();
+        bandY0.push_back(y0);
+        bandNobj.push_back(scanStripForSpans<ImagePixelT, VariancePixelT, ThresholdLevel_traits>(
+                outView, NULL, thresholdVal, includeMultiplier, polarity, y0 - inY0, y1 - inY0,
+                bandSpans.back(), bandAliases.back()));
+        for (IdSpan &span : bandSpans.back()) {
+            span.y += inY0;  // buffer-local rows -> frame-local rows
+        }
+    }
+
+    std::vector<IdSpan> spans;
+    std::vector<int> aliases;
+    mergeStripSpans(bandSpans, bandAliases, bandNobj, bandY0, spans, aliases);
+
+    FootprintSet result(img.getBBox());
+    buildFootprints<ImagePixelT, ThresholdLevel_traits>(result.getFootprints().get(), result.getRegion(),
+                                                        img, spans, aliases, npixMin, polarity,
+                                                        /* setPeaks= */ false);
+
+    if (setPeaks) {
+        /*
+         * Peaks must be measured on the convolved values, which no longer exist as a frame, so
+         * recompute a convolved postage stamp over each Footprint.  The stamp's input is grown by
+         * the kernel size so the convolution is valid over the Footprint and its 8-neighbourhood.
+         */
+        for (auto const &foot : *result.getFootprints()) {
+            lsst::geom::Box2I stampBBox = foot->getBBox();
+            stampBBox.grow(lsst::geom::Extent2I(kernel.getWidth(), kernel.getHeight()));
+            stampBBox.clip(img.getBBox());
+            image::Image<ImagePixelT> const stampIn(img, stampBBox, image::PARENT, false);
+            image::Image<ImagePixelT> stampOut(stampBBox);
+            math::convolve(stampOut, stampIn, kernel, control);
+            findPeaks(foot, stampOut, polarity, ThresholdLevel_traits());
+        }
+    }
+    return result;
+}
+
+template <typename ImagePixelT>
+std::vector<std::shared_ptr<FootprintSet>> FootprintSet::makeMultiThreshold(
+        image::Image<ImagePixelT> const &img, std::vector<Threshold> const &thresholds, int const npixMin,
+        bool const setPeaks) {
+    if (thresholds.empty()) {
+        return {};
+    }
+    bool const polarity = thresholds.front().getPolarity();
+    std::size_t const nLevel = thresholds.size();
+    std::vector<double> levels(nLevel);          // threshold levels, in the caller's order
+    std::vector<double> includeLevels(nLevel);   // levels for footprint inclusion
+    for (std::size_t i = 0; i != nLevel; ++i) {
+        if (thresholds[i].getType() == Threshold::PIXEL_STDEV ||
+            thresholds[i].getType() == Threshold::BITMASK) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                              "Multi-threshold detection requires thresholds that reduce to a single "
+                              "level for the image; PIXEL_STDEV and BITMASK do not");
+        }
+        if (thresholds[i].getPolarity() != polarity) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                              "All thresholds must have the same polarity");
+        }
+        levels[i] = thresholds[i].getValue(img);
+        includeLevels[i] = levels[i] * thresholds[i].getIncludeMultiplier();
+    }
+    /*
+     * Scan in order of increasing level, so a pixel over level l is over every earlier one and we
+     * can stop testing at the first level it fails
+     */
+    std::vector<std::size_t> order(nLevel);
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+              [&levels](std::size_t a, std::size_t b) { return levels[a] < levels[b]; });
+
+    int const height = img.getHeight();
+    int const width = img.getWidth();
+    /*
+     * One run of the usual state machine per level; see scanStripForSpans for the single-level
+     * version this follows
+     */
+    struct LevelState {
+        std::vector<int> id1, id2;          // object IDs in current/previous row
+        std::vector<int>::iterator idc, idp;
+        std::vector<int> aliases;           // aliases for initially disjoint parts of Footprints
+        std::vector<IdSpan> spans;          // y:x0,x1 for objects
+        double level = 0;                   // threshold for membership
+        double includeLevel = 0;            // threshold for inclusion in the set
+        double includeMultiplier = 1;       // includeLevel relative to level
+        int nobj = 0;                       // number of objects found
+        int in_span = 0;                    // object ID of current IdSpan
+        int x0 = 0;                         // start of current IdSpan
+        bool good = false;                  // current IdSpan exceeds includeLevel?
+    };
+    std::vector<LevelState> states(nLevel);
+    for (std::size_t l = 0; l != nLevel; ++l) {
+        LevelState &s = states[l];
+        s.id1.assign(width + 2, 0);
+        s.id2.assign(width + 2, 0);
+        s.idc = s.id1.begin() + 1;
+        s.idp = s.id2.begin() + 1;
+        s.aliases.push_back(0);  // 0 --> 0
+        s.level = levels[order[l]];
+        s.includeLevel = includeLevels[order[l]];
+        s.includeMultiplier = thresholds[order[l]].getIncludeMultiplier();
+    }
+
+    for (int y = 0; y != height; ++y) {
+        for (auto &s : states) {
+            if (s.idc == s.id1.begin() + 1) {
+                s.idc = s.id2.begin() + 1;
+                s.idp = s.id1.begin() + 1;
+            } else {
+                s.idc = s.id1.begin() + 1;
+                s.idp = s.id2.begin() + 1;
+            }
+            std::fill_n(s.idc - 1, width + 2, 0);
+            s.in_span = 0;
+            s.good = (s.includeMultiplier == 1.0);
+        }
+
+        auto pixPtr = img.row_begin(y);
+        for (int x = 0; x < width; ++x, ++pixPtr) {
+            ImagePixelT const pixVal = *pixPtr;
+            /*
+             * The pixel is read once and every level's state machine consumes it from a register;
+             * this is what saves the repeated passes over the image
+             */
+            double const val = polarity ? pixVal : -pixVal;
+            std::size_t nAbove = 0;
+            if (!isBadPixel(pixVal)) {
+                while (nAbove != nLevel && val >= states[nAbove].level) {
+                    ++nAbove;
+                }
+            }
+            for (std::size_t l = 0; l != nLevel; ++l) {
+                LevelState &s = states[l];
+                if (l >= nAbove) {  // below this level (and all higher ones)
+                    if (s.in_span) {
+                        s.spans.emplace_back(s.in_span, y, s.x0, x - 1, s.good);
+                        s.in_span = 0;
+                        s.good = false;
+                    }
+                    continue;
+                }
+                int id;
+                if (s.idc[x - 1] != 0) {
+                    id = s.idc[x - 1];
+                } else if (s.idp[x - 1] != 0) {
+                    id = s.idp[x - 1];
+                } else if (s.idp[x] != 0) {
+                    id = s.idp[x];
+                } else if (s.idp[x + 1] != 0) {
+                    id = s.idp[x + 1];
+                } else {
+                    id = ++s.nobj;
+                    s.aliases.push_back(id);
+                }
+
+                s.idc[x] = id;
+                if (!s.in_span) {
+                    s.x0 = x;
+                    s.in_span = id;
+                }
+
+                if (s.idp[x + 1] != 0 && s.idp[x + 1] != id) {
+                    s.aliases[resolve_alias(s.aliases, s.idp[x + 1])] = resolve_alias(s.aliases, id);
+
+                    s.idc[x] = id = s.idp[x + 1];
+                }
+
+                if (!s.good && val >= s.includeLevel) {
+                    s.good = true;
+                }
+            }
+        }
+
+        for (auto &s : states) {
+            if (s.in_span) {
+                s.spans.emplace_back(s.in_span, y, s.x0, width - 1, s.good);
+            }
+        }
+    }
+
+    std::vector<std::shared_ptr<FootprintSet>> result(nLevel);
+    for (std::size_t l = 0; l != nLevel; ++l) {
+        LevelState &s = states[l];
+        auto fs = std::make_shared<FootprintSet>(img.getBBox());
+        buildFootprints<ImagePixelT, ThresholdLevel_traits>(fs->getFootprints().get(), fs->getRegion(), img,
+                                                            s.spans, s.aliases, npixMin, polarity, setPeaks);
+        result[order[l]] = std::move(fs);
+    }
+    return result;
 }
 
 // NOTE: not a template to appease swig (see note by instantiations at bottom)
@@ -788,13 +1267,13 @@ FootprintSet::FootprintSet(image::Mask<MaskPixelT> const &msk, Threshold const &
         case Threshold::BITMASK:
             findFootprints<MaskPixelT, MaskPixelT, float, ThresholdBitmask_traits>(
                     _footprints.get(), _region, msk, NULL, threshold.getValue(),
-                    threshold.getIncludeMultiplier(), threshold.getPolarity(), npixMin, false);
+                    threshold.getIncludeMultiplier(), threshold.getPolarity(), npixMin, false, 1);
             break;
 
         case Threshold::VALUE:
             findFootprints<MaskPixelT, MaskPixelT, float, ThresholdLevel_traits>(
                     _footprints.get(), _region, msk, NULL, threshold.getValue(),
-                    threshold.getIncludeMultiplier(), threshold.getPolarity(), npixMin, false);
+                    threshold.getIncludeMultiplier(), threshold.getPolarity(), npixMin, false, 1);
             break;
 
         default:
@@ -806,7 +1285,7 @@ FootprintSet::FootprintSet(image::Mask<MaskPixelT> const &msk, Threshold const &
 template <typename ImagePixelT, typename MaskPixelT>
 FootprintSet::FootprintSet(const image::MaskedImage<ImagePixelT, MaskPixelT> &maskedImg,
                            Threshold const &threshold, std::string const &planeName, int const npixMin,
-                           bool const setPeaks)
+                           bool const setPeaks, int numThreads)
         : _footprints(new FootprintList()),
           _region(lsst::geom::Point2I(maskedImg.getX0(), maskedImg.getY0()),
                   lsst::geom::Extent2I(maskedImg.getWidth(), maskedImg.getHeight())) {
@@ -817,13 +1296,13 @@ FootprintSet::FootprintSet(const image::MaskedImage<ImagePixelT, MaskPixelT> &ma
             findFootprints<ImagePixelT, MaskPixelT, VariancePixelT, ThresholdPixelLevel_traits>(
                     _footprints.get(), _region, *maskedImg.getImage(), maskedImg.getVariance().get(),
                     threshold.getValue(maskedImg), threshold.getIncludeMultiplier(), threshold.getPolarity(),
-                    npixMin, setPeaks);
+                    npixMin, setPeaks, numThreads);
             break;
         default:
             findFootprints<ImagePixelT, MaskPixelT, VariancePixelT, ThresholdLevel_traits>(
                     _footprints.get(), _region, *maskedImg.getImage(), maskedImg.getVariance().get(),
                     threshold.getValue(maskedImg), threshold.getIncludeMultiplier(), threshold.getPolarity(),
-                    npixMin, setPeaks);
+                    npixMin, setPeaks, numThreads);
             break;
     }
     // Set Mask if requested
@@ -845,6 +1324,177 @@ FootprintSet::FootprintSet(const image::MaskedImage<ImagePixelT, MaskPixelT> &ma
     }
 }
 
+template <typename MaskPixelT>
+void FootprintSet::setMask(image::Mask<MaskPixelT> *mask, std::string const &planeName, int numThreads) {
+    MaskPixelT const bitmask = image::Mask<MaskPixelT>::getPlaneBitMask(planeName);
+    int const height = mask->getHeight();
+    numThreads = std::min(numThreads, height);
+    if (numThreads <= 1) {
+        for (auto const &foot : *_footprints) {
+            foot->getSpans()->setMask(*mask, bitmask);
+        }
+        return;
+    }
+    // The footprints must lie entirely within the mask, as SpanSet::setMask requires
+    lsst::geom::Box2I const bbox = mask->getBBox();
+    for (auto const &foot : *_footprints) {
+        if (!foot->getSpans()->empty() && !bbox.contains(foot->getBBox())) {
+            throw LSST_EXCEPT(pex::exceptions::OutOfRangeError,
+                              "Footprint Bounds Outside mask, cannot set bits");
+        }
+    }
+    /*
+     * Bucket the spans into horizontal bands, one per thread.  Each row belongs to exactly one
+     * band, so the threads never write to the same pixel and need no synchronization.
+     */
+    int const y0 = mask->getY0();
+    int const x0 = mask->getX0();
+    std::vector<std::vector<geom::Span const *>> bands(numThreads);
+    for (auto const &foot : *_footprints) {
+        for (auto const &span : *foot->getSpans()) {
+            bands[(span.getY() - y0) * numThreads / height].push_back(&span);
+        }
+    }
+    auto array = mask->getArray();
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    std::vector<std::exception_ptr> errors(numThreads);
+    for (int band = 0; band < numThreads; ++band) {
+        threads.emplace_back([&, band] {
+            try {
+                // Stamp in row-major order for cache locality; overlapping footprints may
+                // contribute duplicate spans, but |= makes that harmless
+                std::sort(bands[band].begin(), bands[band].end(),
+                          [](geom::Span const *a, geom::Span const *b) { return *a < *b; });
+                for (auto const *span : bands[band]) {
+                    auto row = array[span->getY() - y0];
+                    auto pixel = row.begin() + (span->getX0() - x0);
+                    for (auto end = pixel + span->getWidth(); pixel != end; ++pixel) {
+                        *pixel |= bitmask;
+                    }
+                }
+            } catch (...) {
+                errors[band] = std::current_exception();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto const &error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+}
+
+namespace detail {
+
+// Uniform grid over the footprint bounding boxes, used by FootprintSet::findOverlapping.  Each
+// footprint is entered (by its position in the footprint list) into every cell its bounding box
+// touches; a query gathers the candidates from the cells the query box touches and then applies the
+// exact bounding-box test.  The cell size is a compromise: large enough that typical footprints
+// touch only a few cells, small enough that a cell holds few footprints.
+class FootprintSetIndex {
+public:
+    explicit FootprintSetIndex(FootprintSet::FootprintList const &footprints) {
+        _bboxes.reserve(footprints.size());
+        for (std::size_t i = 0; i < footprints.size(); ++i) {
+            lsst::geom::Box2I const bbox = footprints[i]->getBBox();
+            _bboxes.push_back(bbox);
+            if (bbox.isEmpty()) {
+                continue;
+            }
+            int const cyEnd = _toCell(bbox.getMaxY());
+            int const cxEnd = _toCell(bbox.getMaxX());
+            for (int cy = _toCell(bbox.getMinY()); cy <= cyEnd; ++cy) {
+                for (int cx = _toCell(bbox.getMinX()); cx <= cxEnd; ++cx) {
+                    _cells[_makeKey(cx, cy)].push_back(i);
+                }
+            }
+        }
+    }
+
+    // Return the indices of the footprints whose bounding boxes overlap the given box, in
+    // footprint-list order (the order a linear scan would produce).
+    std::vector<std::size_t> query(lsst::geom::Box2I const &box) const {
+        std::vector<std::size_t> result;
+        if (box.isEmpty()) {
+            return result;
+        }
+        int const cyEnd = _toCell(box.getMaxY());
+        int const cxEnd = _toCell(box.getMaxX());
+        for (int cy = _toCell(box.getMinY()); cy <= cyEnd; ++cy) {
+            for (int cx = _toCell(box.getMinX()); cx <= cxEnd; ++cx) {
+                auto cell = _cells.find(_makeKey(cx, cy));
+                if (cell != _cells.end()) {
+                    result.insert(result.end(), cell->second.begin(), cell->second.end());
+                }
+            }
+        }
+        std::sort(result.begin(), result.end());
+        result.erase(std::unique(result.begin(), result.end()), result.end());
+        result.erase(std::remove_if(result.begin(), result.end(),
+                                    [this, &box](std::size_t i) { return !_bboxes[i].overlaps(box); }),
+                     result.end());
+        return result;
+    }
+
+private:
+    static int const CELL_SIZE = 64;  // pixels per grid cell on a side
+
+    // Floor division, so the grid is uniform across negative coordinates too
+    static int _toCell(int v) { return v >= 0 ? v / CELL_SIZE : -((-v - 1) / CELL_SIZE) - 1; }
+
+    static std::uint64_t _makeKey(int cx, int cy) {
+        return (static_cast<std::uint64_t>(static_cast<std::uint32_t>(cx)) << 32) |
+               static_cast<std::uint64_t>(static_cast<std::uint32_t>(cy));
+    }
+
+    std::vector<lsst::geom::Box2I> _bboxes;
+    std::unordered_map<std::uint64_t, std::vector<std::size_t>> _cells;
+};
+
+int const FootprintSetIndex::CELL_SIZE;
+
+}  // namespace detail
+
+void FootprintSet::_ensureIndex() const {
+    if (!_index) {
+        _index = std::make_shared<detail::FootprintSetIndex>(*_footprints);
+    }
+}
+
+std::vector<std::shared_ptr<Footprint>> FootprintSet::findOverlapping(lsst::geom::Box2I const &box) const {
+    _ensureIndex();
+    std::vector<std::shared_ptr<Footprint>> result;
+    for (std::size_t i : _index->query(box)) {
+        result.push_back((*_footprints)[i]);
+    }
+    return result;
+}
+
+std::vector<std::shared_ptr<Footprint>> FootprintSet::findOverlapping(geom::SpanSet const &spans) const {
+    _ensureIndex();
+    std::vector<std::shared_ptr<Footprint>> result;
+    for (std::size_t i : _index->query(spans.getBBox())) {
+        if ((*_footprints)[i]->getSpans()->overlaps(spans)) {
+            result.push_back((*_footprints)[i]);
+        }
+    }
+    return result;
+}
+
+std::vector<std::vector<std::shared_ptr<Footprint>>> FootprintSet::findOverlapping(
+        std::vector<lsst::geom::Box2I> const &boxes) const {
+    std::vector<std::vector<std::shared_ptr<Footprint>>> results;
+    results.reserve(boxes.size());
+    for (auto const &box : boxes) {
+        results.push_back(findOverlapping(box));
+    }
+    return results;
+}
+
 FootprintSet::FootprintSet(lsst::geom::Box2I region)
         : _footprints(std::make_shared<FootprintList>()), _region(region) {}
 
@@ -871,9 +1521,9 @@ FootprintSet &FootprintSet::operator=(FootprintSet &&rhs) { return *this = rhs;
 
 FootprintSet::~FootprintSet() = default;
 
-void FootprintSet::merge(FootprintSet const &rhs, int tGrow, int rGrow, bool isotropic) {
+void FootprintSet::merge(FootprintSet const &rhs, int tGrow, int rGrow, bool isotropic, int numThreads) {
     FootprintControl const ctrl(true, isotropic);
-    FootprintSet fs = mergeFootprintSets(*this, tGrow, rhs, rGrow, ctrl);
+    FootprintSet fs = mergeFootprintSets(*this, tGrow, rhs, rGrow, ctrl, numThreads);
     swap(fs);  // Swap the new FootprintSet into place
 }
 
@@ -965,16 +1615,24 @@ void FootprintSet::makeSources(afw::table::SourceCatalog &cat) const {
 
 #define INSTANTIATE(PIXEL)                                                                              \
     template FootprintSet::FootprintSet(image::Image<PIXEL> const &, Threshold const &, int const,      \
-                                        bool const);                                                    \
+                                        bool const, int);                                               \
+    template FootprintSet::FootprintSet(image::Image<PIXEL> const &, image::Image<float> const &,       \
+                                        Threshold const &, int const, bool const, int);                 \
+    template std::vector<std::shared_ptr<FootprintSet>> FootprintSet::makeMultiThreshold(               \
+            image::Image<PIXEL> const &, std::vector<Threshold> const &, int const, bool const);        \
     template FootprintSet::FootprintSet(image::MaskedImage<PIXEL, image::MaskPixel> const &,            \
-                                        Threshold const &, std::string const &, int const, bool const); \
+                                        Threshold const &, std::string const &, int const, bool const,  \
+                                        int);                                                           \
     template void FootprintSet::makeHeavy(image::MaskedImage<PIXEL, image::MaskPixel> const &,          \
-                                          HeavyFootprintCtrl const *)
+                                          HeavyFootprintCtrl const *);                                  \
+    template FootprintSet detectOnConvolvedImage(image::Image<PIXEL> const &, math::Kernel const &,     \
+                                                 Threshold const &, int const, bool const)
 
 template FootprintSet::FootprintSet(image::Mask<image::MaskPixel> const &, Threshold const &, int const);
 
-template void FootprintSet::setMask(image::Mask<image::MaskPixel> *, std::string const &);
-template void FootprintSet::setMask(std::shared_ptr<image::Mask<image::MaskPixel>>, std::string const &);
+template void FootprintSet::setMask(image::Mask<image::MaskPixel> *, std::string const &, int);
+template void FootprintSet::setMask(std::shared_ptr<image::Mask<image::MaskPixel>>, std::string const &,
+                                    int);
 
 INSTANTIATE(std::uint16_t);
 INSTANTIATE(int);
@@ -23,6 +23,7 @@
 #include <cstdint>
 #include <cassert>
 #include <string>
+#include <thread>
 #include <typeinfo>
 #include <algorithm>
 #include "boost/format.hpp"
@@ -75,16 +76,24 @@ template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT>::HeavyFootprint(
         Footprint const& foot, image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const& mimage,
         HeavyFootprintCtrl const* ctrl)
-        : Footprint(foot),
-          _image(ndarray::allocate(ndarray::makeVector(foot.getArea()))),
-          _mask(ndarray::allocate(ndarray::makeVector(foot.getArea()))),
-          _variance(ndarray::allocate(ndarray::makeVector(foot.getArea()))) {
+        : Footprint(foot) {
     HeavyFootprintCtrl ctrl_s = HeavyFootprintCtrl();
 
     if (!ctrl) {
         ctrl = &ctrl_s;
     }
 
+    if (ctrl->getLazy() && ctrl->getModifySource() == HeavyFootprintCtrl::NONE) {
+        // Keep a shallow reference to the parent image and defer flattening
+        // until the pixels are actually needed
+        _parent = std::make_shared<image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>>(mimage);
+        return;
+    }
+
+    _image = ndarray::allocate(ndarray::makeVector(foot.getArea()));
+    _mask = ndarray::allocate(ndarray::makeVector(foot.getArea()));
+    _variance = ndarray::allocate(ndarray::makeVector(foot.getArea()));
+
     switch (ctrl->getModifySource()) {
         case HeavyFootprintCtrl::NONE:
             getSpans()->flatten(_image, mimage.getImage()->getArray(), mimage.getXY0());
@@ -115,9 +124,29 @@ HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT>::HeavyFootprint(Footprin
           _mask(ndarray::allocate(ndarray::makeVector(foot.getArea()))),
           _variance(ndarray::allocate(ndarray::makeVector(foot.getArea()))) {}
 
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT>::_ensureMaterialized() const {
+    if (!_parent) {
+        return;
+    }
+    _image = ndarray::allocate(ndarray::makeVector(getArea()));
+    _mask = ndarray::allocate(ndarray::makeVector(getArea()));
+    _variance = ndarray::allocate(ndarray::makeVector(getArea()));
+    getSpans()->flatten(_image, _parent->getImage()->getArray(), _parent->getXY0());
+    getSpans()->flatten(_mask, _parent->getMask()->getArray(), _parent->getXY0());
+    getSpans()->flatten(_variance, _parent->getVariance()->getArray(), _parent->getXY0());
+    _parent.reset();
+}
+
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 void HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT>::insert(
         image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& mimage) const {
+    if (_parent) {
+        // Still a view onto the parent image; copy straight from it without
+        // materializing the flattened arrays
+        getSpans()->copyMaskedImage(*_parent, mimage);
+        return;
+    }
     getSpans()->unflatten(mimage.getImage()->getArray(), _image, mimage.getXY0());
     getSpans()->unflatten(mimage.getMask()->getArray(), _mask, mimage.getXY0());
     getSpans()->unflatten(mimage.getVariance()->getArray(), _variance, mimage.getXY0());
@@ -125,6 +154,10 @@ void HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT>::insert(
 
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 void HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT>::insert(image::Image<ImagePixelT>& image) const {
+    if (_parent) {
+        getSpans()->copyImage(*_parent->getImage(), image);
+        return;
+    }
     getSpans()->unflatten(image.getArray(), _image, image.getXY0());
 }
 
@@ -202,6 +235,148 @@ double HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT>::dot(
     return sum;
 }
 
+namespace {
+
+// Shared implementation of insertHeavyFootprints for Image and MaskedImage targets.
+template <typename HeavyT, typename TargetT>
+void doInsertHeavyFootprints(std::vector<std::shared_ptr<HeavyT const>> const& heavies, TargetT& target,
+                             int numThreads) {
+    int const height = target.getHeight();
+    int const y0 = target.getY0();
+    numThreads = std::min({numThreads, static_cast<int>(heavies.size()), height});
+    if (numThreads <= 1) {
+        for (auto const& heavy : heavies) {
+            if (heavy) {
+                heavy->insert(target);
+            }
+        }
+        return;
+    }
+    /*
+     * Group the heavies into disjoint row bands of the target so the bands can be scattered
+     * in parallel without two threads ever writing to the same rows.  A heavy whose bounding
+     * box straddles a band boundary is held back and inserted serially once the bands have
+     * been joined.
+     */
+    int const nBands = numThreads;
+    auto bandBeginRow = [y0, height, nBands](int band) { return y0 + band * height / nBands; };
+    auto bandOf = [&bandBeginRow, y0, height, nBands](int y) {
+        int band = std::min(nBands - 1, std::max(0, (y - y0) * nBands / height));
+        // Integer truncation in the band boundaries can leave the first guess off by one
+        while (band + 1 < nBands && bandBeginRow(band + 1) <= y) ++band;
+        while (band > 0 && bandBeginRow(band) > y) --band;
+        return band;
+    };
+    std::vector<std::vector<HeavyT const*>> bands(nBands);
+    std::vector<HeavyT const*> straddlers;
+    for (auto const& heavy : heavies) {
+        if (!heavy) {
+            continue;
+        }
+        lsst::geom::Box2I const bbox = heavy->getBBox();
+        int const band = bandOf(bbox.getMinY());
+        if (band == bandOf(bbox.getMaxY())) {
+            bands[band].push_back(heavy.get());
+        } else {
+            straddlers.push_back(heavy.get());
+        }
+    }
+    std::vector<std::thread> threads;
+    threads.reserve(nBands);
+    std::vector<std::exception_ptr> errors(nBands);
+    for (int band = 0; band < nBands; ++band) {
+        threads.emplace_back([&, band] {
+            try {
+                for (auto const* heavy : bands[band]) {
+                    heavy->insert(target);
+                }
+            } catch (...) {
+                errors[band] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto const& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    for (auto const* heavy : straddlers) {
+        heavy->insert(target);
+    }
+}
+
+}  // namespace
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void insertHeavyFootprints(
+        std::vector<std::shared_ptr<HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT> const>> const&
+                heavies,
+        image::Image<ImagePixelT>& image, int numThreads) {
+    doInsertHeavyFootprints(heavies, image, numThreads);
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void insertHeavyFootprints(
+        std::vector<std::shared_ptr<HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT> const>> const&
+                heavies,
+        image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& mimage, int numThreads) {
+    doInsertHeavyFootprints(heavies, mimage, numThreads);
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+std::vector<std::shared_ptr<HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT>>> makeHeavyFootprints(
+        std::vector<std::shared_ptr<Footprint const>> const& footprints,
+        image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const& mimage,
+        HeavyFootprintCtrl const* ctrl, int numThreads) {
+    using HeavyT = HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT>;
+    std::size_t const size = footprints.size();
+    std::vector<std::shared_ptr<HeavyT>> result(size);
+    auto makeRange = [&footprints, &result, &mimage, ctrl](std::size_t begin, std::size_t end) {
+        for (std::size_t i = begin; i < end; ++i) {
+            if (footprints[i]) {
+                result[i] = std::make_shared<HeavyT>(*footprints[i], mimage, ctrl);
+            }
+        }
+    };
+    numThreads = std::min(numThreads, static_cast<int>(size));
+    if (ctrl && ctrl->getModifySource() != HeavyFootprintCtrl::NONE) {
+        // A source-modifying ctrl writes back into mimage, which would race where
+        // footprints overlap, so extract serially in that case
+        numThreads = 1;
+    }
+    if (numThreads <= 1) {
+        makeRange(0, size);
+        return result;
+    }
+    // Flattening only reads the image, so the footprints can simply be divided among the threads
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads);
+    std::vector<std::exception_ptr> errors(numThreads);
+    for (int t = 0; t < numThreads; ++t) {
+        std::size_t const begin = t * size / numThreads;
+        std::size_t const end = (t + 1) * size / numThreads;
+        threads.emplace_back([&, t, begin, end] {
+            try {
+                makeRange(begin, end);
+            } catch (...) {
+                errors[t] = std::current_exception();
+            }
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto const& error : errors) {
+        if (error) {
+            std::rethrow_exception(error);
+        }
+    }
+    return result;
+}
+
 // Persistence (using afw::table::io)
 //
 
@@ -338,7 +513,17 @@ typename HeavyFootprint<ImagePixelT, MaskPixelT, VariancePixelT>::Factory
             std::shared_ptr<table::io::Persistable> const&);                                         \
     template class detection::HeavyFootprint<TYPE>;                                                  \
     template std::shared_ptr<detection::HeavyFootprint<TYPE>> detection::mergeHeavyFootprints<TYPE>( \
-            detection::HeavyFootprint<TYPE> const&, detection::HeavyFootprint<TYPE> const&);
+            detection::HeavyFootprint<TYPE> const&, detection::HeavyFootprint<TYPE> const&);         \
+    template void detection::insertHeavyFootprints<TYPE>(                                            \
+            std::vector<std::shared_ptr<detection::HeavyFootprint<TYPE> const>> const&,              \
+            image::Image<TYPE>&, int);                                                               \
+    template void detection::insertHeavyFootprints<TYPE>(                                            \
+            std::vector<std::shared_ptr<detection::HeavyFootprint<TYPE> const>> const&,              \
+            image::MaskedImage<TYPE>&, int);                                                         \
+    template std::vector<std::shared_ptr<detection::HeavyFootprint<TYPE>>>                           \
+    detection::makeHeavyFootprints<TYPE>(std::vector<std::shared_ptr<detection::Footprint const>> const&, \
+                                         image::MaskedImage<TYPE> const&,                            \
+                                         detection::HeavyFootprintCtrl const*, int);
 
 INSTANTIATE(std::uint16_t);
 INSTANTIATE(double);
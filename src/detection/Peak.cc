@@ -20,11 +20,13 @@
  * the GNU General Public License along with this program.  If not,
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
+#include <list>
 #include <typeinfo>
 
 #include "lsst/afw/table/io/FitsWriter.h"
 #include "lsst/afw/detection/Peak.h"
 #include "lsst/afw/table/detail/Access.h"
+#include "lsst/afw/table/detail/RecordArena.h"
 
 namespace lsst {
 namespace afw {
@@ -164,11 +166,18 @@ std::shared_ptr<afw::table::BaseTable> PeakTable::_clone() const {
 }
 
 std::shared_ptr<afw::table::BaseRecord> PeakTable::_makeRecord() {
+    if (!getRecordArena()) {
+        setRecordArena(std::make_shared<afw::table::detail::RecordArena>(nRecordsPerArenaBlock));
+    }
     auto record = constructRecord<PeakRecord>();
     if (getIdFactory()) record->setId((*getIdFactory())());
     return record;
 }
 
+// Larger than BaseTable::nRecordsPerBlock because peak records are small and crowded fields make
+// millions of them.
+int PeakTable::nRecordsPerArenaBlock = 512;
+
 }  // namespace detection
 
 namespace table {
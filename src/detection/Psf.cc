@@ -1,11 +1,17 @@
 // -*- LSST-C++ -*-
+#include <algorithm>
+#include <array>
 #include <limits>
+#include <mutex>
+#include <numeric>
+#include <thread>
 #include <typeinfo>
 #include <cmath>
 #include <memory>
 
 #include "lsst/utils/Cache.h"
 #include "lsst/afw/detection/Psf.h"
+#include "lsst/afw/instrumentation.h"
 #include "lsst/afw/math/offsetImage.h"
 #include "lsst/afw/table/io/Persistable.cc"
 
@@ -63,23 +69,79 @@ namespace lsst {
 namespace afw {
 namespace detection {
 
+namespace detail {
+
+// A thread-sharded realization cache.
+//
+// Each shard pairs its own lsst::utils::Cache with its own mutex, and a calling thread
+// is mapped to a shard by hashing its id, so concurrent compute*Image calls on one
+// shared Psf contend only when two threads happen to land on the same shard.  Hot
+// entries may be realized once per shard, which costs far less memory than cloning the
+// whole Psf (and its caches) per thread, as callers had to do before.
+class ShardedPsfCache final {
+public:
+    // Enough shards that a full complement of measurement threads rarely collides.
+    static constexpr std::size_t N_SHARDS = 64;
+
+    explicit ShardedPsfCache(std::size_t capacity) : _capacity(capacity) {
+        for (auto &shard : _shards) {
+            shard.cache = std::make_unique<PsfCache>(capacity);
+        }
+    }
+
+    template <typename Generator>
+    std::shared_ptr<Psf::Image> operator()(PsfCacheKey const &key, Generator &&generator) const {
+        Shard &shard = _shards[std::hash<std::thread::id>()(std::this_thread::get_id()) % N_SHARDS];
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        return (*shard.cache)(key, std::forward<Generator>(generator));
+    }
+
+    std::size_t capacity() const { return _capacity; }
+
+    void reserve(std::size_t capacity) {
+        for (auto &shard : _shards) {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            shard.cache->reserve(capacity);
+        }
+        _capacity = capacity;
+    }
+
+private:
+    using PsfCache = utils::Cache<PsfCacheKey, std::shared_ptr<Psf::Image>>;
+
+    struct Shard {
+        std::mutex mutex;
+        std::unique_ptr<PsfCache> cache;
+    };
+
+    std::size_t _capacity;  // per-shard capacity, recorded for getCacheCapacity
+    mutable std::array<Shard, N_SHARDS> _shards;
+};
+
+constexpr std::size_t ShardedPsfCache::N_SHARDS;
+
+}  // namespace detail
+
 namespace {
 
 bool isPointNull(lsst::geom::Point2D const &p) { return std::isnan(p.getX()) && std::isnan(p.getY()); }
 
 }  // namespace
 
-Psf::Psf(bool isFixed, std::size_t capacity) : _isFixed(isFixed) {
-    _imageCache = std::make_unique<PsfCache>(capacity);
-    _kernelImageCache = std::make_unique<PsfCache>(capacity);
+Psf::Psf(bool isFixed, std::size_t capacity) : _isFixed(isFixed), _cachePositionTolerance(0.0) {
+    _imageCache = std::make_unique<detail::ShardedPsfCache>(capacity);
+    _kernelImageCache = std::make_unique<detail::ShardedPsfCache>(capacity);
 }
 
 Psf::~Psf() = default;
 
-Psf::Psf(Psf const &other) : Psf(other._isFixed, other.getCacheCapacity()) {}
+Psf::Psf(Psf const &other) : Psf(other._isFixed, other.getCacheCapacity()) {
+    _cachePositionTolerance = other._cachePositionTolerance;
+}
 
 Psf::Psf(Psf &&other)
         : _isFixed(other._isFixed),
+          _cachePositionTolerance(other._cachePositionTolerance),
           _imageCache(std::move(other._imageCache)),
           _kernelImageCache(std::move(other._kernelImageCache)) {}
 
@@ -112,13 +174,60 @@ std::shared_ptr<Psf::Image> Psf::computeImage(lsst::geom::Point2D position, imag
     return result;
 }
 
+lsst::geom::Point2D Psf::_quantizePosition(lsst::geom::Point2D const &position) const {
+    if (_cachePositionTolerance <= 0.0) {
+        return position;
+    }
+    return lsst::geom::Point2D(std::round(position.getX() / _cachePositionTolerance) * _cachePositionTolerance,
+                               std::round(position.getY() / _cachePositionTolerance) * _cachePositionTolerance);
+}
+
+std::vector<std::size_t> Psf::_sortPositionsForBatch(
+        std::vector<lsst::geom::Point2D> const &positions) const {
+    auto makeSortKey = [this](lsst::geom::Point2D const &position) {
+        // Map NaNs (e.g. null positions, which evaluate at the average position) to
+        // infinity so they sort together at the end without breaking the ordering
+        double const inf = std::numeric_limits<double>::infinity();
+        lsst::geom::Point2D const quantized = _quantizePosition(position);
+        return std::make_pair(std::isnan(quantized.getY()) ? inf : quantized.getY(),
+                              std::isnan(quantized.getX()) ? inf : quantized.getX());
+    };
+    std::vector<std::size_t> order(positions.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&makeSortKey, &positions](std::size_t a, std::size_t b) {
+        return makeSortKey(positions[a]) < makeSortKey(positions[b]);
+    });
+    return order;
+}
+
+std::vector<std::shared_ptr<Psf::Image>> Psf::computeImageBatch(
+        std::vector<lsst::geom::Point2D> const &positions, image::Color color) const {
+    // Visit the positions sorted by their quantized location so that
+    // near-duplicate evaluations are adjacent and hit the caches before
+    // being evicted; the results are returned in the caller's order
+    std::vector<std::shared_ptr<Image>> results(positions.size());
+    for (std::size_t index : _sortPositionsForBatch(positions)) {
+        results[index] = computeImage(positions[index], color, COPY);
+    }
+    return results;
+}
+
 std::shared_ptr<Psf::Image> Psf::computeKernelImage(lsst::geom::Point2D position, image::Color color,
                                                     ImageOwnerEnum owner) const {
     if (_isFixed || isPointNull(position)) position = getAveragePosition();
     if (_isFixed || color.isIndeterminate()) color = getAverageColor();
-    std::shared_ptr<Psf::Image> result = (*_kernelImageCache)(
-            detail::PsfCacheKey(position, color),
-            [this](detail::PsfCacheKey const &key) { return doComputeKernelImage(key.position, key.color); });
+    // Snap to the tolerance grid (if one is set) so that nearby positions
+    // share a single cached realization of the slowly varying model
+    position = _quantizePosition(position);
+    bool miss = false;
+    std::shared_ptr<Psf::Image> result =
+            (*_kernelImageCache)(detail::PsfCacheKey(position, color),
+                                 [this, &miss](detail::PsfCacheKey const &key) {
+                                     miss = true;
+                                     return doComputeKernelImage(key.position, key.color);
+                                 });
+    instrumentation::add(miss ? instrumentation::Metric::PSF_CACHE_MISSES
+                              : instrumentation::Metric::PSF_CACHE_HITS);
     if (owner == COPY) {
         result = std::make_shared<Image>(*result, true);
     }
@@ -153,6 +262,24 @@ double Psf::computeApertureFlux(double radius, lsst::geom::Point2D position, ima
     return doComputeApertureFlux(radius, position, color);
 }
 
+ndarray::Array<double, 2, 2> Psf::computeApertureFluxBatch(ndarray::Array<double const, 1> const &radii,
+                                                           std::vector<lsst::geom::Point2D> const &positions,
+                                                           image::Color color) const {
+    int const nRadii = radii.getSize<0>();
+    ndarray::Array<double, 2, 2> results =
+            ndarray::allocate(ndarray::makeVector(static_cast<int>(positions.size()), nRadii));
+    // Visit the positions sorted by their quantized location so the kernel-image realization
+    // behind each curve-of-growth evaluation is fetched from the caches rather than recomputed,
+    // and measure every radius at a position before moving on to the next one
+    for (std::size_t index : _sortPositionsForBatch(positions)) {
+        auto row = results[index];
+        for (int j = 0; j != nRadii; ++j) {
+            row[j] = computeApertureFlux(radii[j], positions[index], color);
+        }
+    }
+    return results;
+}
+
 geom::ellipses::Quadrupole Psf::computeShape(lsst::geom::Point2D position, image::Color color) const {
     if (isPointNull(position)) position = getAveragePosition();
     if (color.isIndeterminate()) color = getAverageColor();
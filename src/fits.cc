@@ -1,13 +1,20 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
 #include <cstdint>
 #include <cstdio>
+#include <cstring>
 #include <complex>
 #include <cmath>
+#include <mutex>
 #include <sstream>
 #include <unordered_set>
 #include <unordered_map>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
 #include "fitsio.h"
 extern "C" {
 #include "fitsio2.h"
@@ -21,7 +28,10 @@ extern "C" {
 
 #include "lsst/pex/exceptions.h"
 #include "lsst/log/Log.h"
+#include "lsst/utils/Cache.h"
+#include "lsst/utils/hashCombine.h"
 #include "lsst/afw/fits.h"
+#include "lsst/afw/instrumentation.h"
 #include "lsst/geom/Angle.h"
 #include "lsst/afw/geom/wcsUtils.h"
 #include "lsst/afw/fitsCompression.h"
@@ -472,11 +482,83 @@ std::string makeLimitedFitsHeader(daf::base::PropertySet const &metadata,
     return makeLimitedFitsHeaderImpl(desiredParamNames, metadata);
 }
 
+namespace {
+
+/*
+ * Reserved virtual-address ranges backing mmap-based MemFileManager buffers,
+ * keyed by base address.  cfitsio grows memory files through a plain function
+ * pointer with no state, so the reallocator needs a side channel to recover
+ * the reservation for the pointer it is handed.
+ */
+std::mutex mmapRegistryMutex;
+std::unordered_map<void *, std::size_t> mmapRegistry;
+
+std::size_t roundToPageSize(std::size_t len) {
+    std::size_t const pageSize = sysconf(_SC_PAGESIZE);
+    return (std::max(len, std::size_t(1)) + pageSize - 1) / pageSize * pageSize;
+}
+
+/*
+ * realloc-compatible growth function for mmap-backed buffers, for use by
+ * cfitsio.  As long as the new size fits in the reserved range this simply
+ * returns the same pointer, with physical pages committed by the kernel on
+ * first write; only growth beyond the reservation remaps (and may move) the
+ * buffer.  Returns null on failure, which cfitsio reports as a memory
+ * allocation error.
+ */
+void *mmapReallocate(void *ptr, std::size_t len) {
+    std::lock_guard<std::mutex> lock(mmapRegistryMutex);
+    auto iter = mmapRegistry.find(ptr);
+    if (iter == mmapRegistry.end()) {
+        return nullptr;
+    }
+    if (len <= iter->second) {
+        return ptr;
+    }
+    std::size_t const newReserve = roundToPageSize(std::max(len, 2 * iter->second));
+#if defined(__linux__)
+    void *newPtr = mremap(ptr, iter->second, newReserve, MREMAP_MAYMOVE);
+    if (newPtr == MAP_FAILED) {
+        return nullptr;
+    }
+#else
+    void *newPtr = mmap(nullptr, newReserve, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (newPtr == MAP_FAILED) {
+        return nullptr;
+    }
+    std::memcpy(newPtr, ptr, iter->second);
+    munmap(ptr, iter->second);
+#endif
+    mmapRegistry.erase(iter);
+    mmapRegistry.emplace(newPtr, newReserve);
+    return newPtr;
+}
+
+// Remove the reservation for the given base address from the registry and return its size.
+std::size_t takeMmapReservation(void *ptr) {
+    std::lock_guard<std::mutex> lock(mmapRegistryMutex);
+    auto iter = mmapRegistry.find(ptr);
+    std::size_t const reserve = iter->second;
+    mmapRegistry.erase(iter);
+    return reserve;
+}
+
+}  // namespace
+
 void MemFileManager::reset() {
-    if (_managed) std::free(_ptr);
+    if (_managed) {
+        if (_mmap) {
+            if (_ptr) {
+                munmap(_ptr, takeMmapReservation(_ptr));
+            }
+        } else {
+            std::free(_ptr);
+        }
+    }
     _ptr = 0;
     _len = 0;
     _managed = true;
+    _mmap = false;
 }
 
 void MemFileManager::reset(std::size_t len) {
@@ -486,6 +568,55 @@ void MemFileManager::reset(std::size_t len) {
     _managed = true;
 }
 
+void MemFileManager::resetMmap(std::size_t len, std::size_t reserve) {
+    reset();
+    std::size_t const actualReserve = roundToPageSize(std::max(len, reserve));
+    int flags = MAP_PRIVATE | MAP_ANONYMOUS;
+#ifdef MAP_NORESERVE
+    flags |= MAP_NORESERVE;
+#endif
+    void *ptr = mmap(nullptr, actualReserve, PROT_READ | PROT_WRITE, flags, -1, 0);
+    if (ptr == MAP_FAILED) {
+        throw LSST_EXCEPT(
+                pex::exceptions::MemoryError,
+                (boost::format("Could not reserve %d bytes of address space for a memory FITS file") %
+                 actualReserve)
+                        .str());
+    }
+    {
+        std::lock_guard<std::mutex> lock(mmapRegistryMutex);
+        mmapRegistry.emplace(ptr, actualReserve);
+    }
+    _ptr = ptr;
+    _len = len;
+    _managed = true;
+    _mmap = true;
+}
+
+std::shared_ptr<void> MemFileManager::release(std::size_t &len) {
+    if (!_managed) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          "MemFileManager references external memory it does not own; nothing to release");
+    }
+    len = _len;
+    std::shared_ptr<void> result;
+    if (_mmap && _ptr) {
+        std::size_t const reserve = takeMmapReservation(_ptr);
+        result = std::shared_ptr<void>(_ptr, [reserve](void *ptr) {
+            if (ptr) {
+                munmap(ptr, reserve);
+            }
+        });
+    } else {
+        result = std::shared_ptr<void>(_ptr, [](void *ptr) { std::free(ptr); });
+    }
+    _ptr = 0;
+    _len = 0;
+    _managed = true;
+    _mmap = false;
+    return result;
+}
+
 template <typename T>
 int getBitPix() {
     return FitsBitPix<T>::CONSTANT;
@@ -739,6 +870,33 @@ void readKeyImpl(Fits &fits, char const *key, std::string &value) {
     }
 }
 
+/*
+ * Read the entire header of the current HDU into a single string with one
+ * cfitsio call.
+ *
+ * The result is a concatenation of 80-character cards with no delimiters,
+ * in header order, excluding the END card. Returns an empty string if the
+ * cfitsio status is already set or becomes set.
+ */
+std::string readEntireHeader(Fits &fits) {
+    char *header = nullptr;
+    int nKeys = 0;
+    fits_hdr2str(reinterpret_cast<fitsfile *>(fits.fptr), 0, nullptr, 0, &header, &nKeys, &fits.status);
+    std::string result;
+    if (header) {
+        try {
+            result.assign(header, static_cast<std::size_t>(nKeys) * 80);
+        } catch (...) {
+            int status = 0;
+            fits_free_memory(header, &status);
+            throw;
+        }
+        int status = 0;
+        fits_free_memory(header, &status);
+    }
+    return result;
+}
+
 void readKeyImpl(Fits &fits, char const *key, double &value) {
     // We need to check for the possibility that the value is a special string (for NAN, +/-Inf).
     // If a quote mark (') is present then it's a string.
@@ -779,19 +937,36 @@ void Fits::readKey(std::string const &key, T &value) {
 }
 
 void Fits::forEachKey(HeaderIterationFunctor &functor) {
-    char key[81];  // allow for terminating NUL
+    // Grab the entire header with a single cfitsio call and parse the cards
+    // in memory; calling back into cfitsio once per keyword is measurably
+    // slower for the metadata blocks of hundreds of cards that Exposures
+    // carry. fits_get_keyname and fits_parse_value are pure string parsers
+    // (fits_read_keyn is implemented in terms of them), so the result is
+    // identical to a per-keyword read.
+    std::string const header = readEntireHeader(*this);
+    int const nKeys = header.size() / 80;
+    char card[81];  // allow for terminating NUL
+    char key[81];
     char value[81];
     char comment[81];
-    int nKeys = 0;
-    fits_get_hdrspace(reinterpret_cast<fitsfile *>(fptr), &nKeys, 0, &status);
+    auto getCard = [&header, &card](int i) {
+        std::memcpy(card, header.data() + static_cast<std::size_t>(i - 1) * 80, 80);
+        card[80] = '\0';
+    };
     std::string keyStr;
     std::string valueStr;
     std::string commentStr;
     int i = 1;
     while (i <= nKeys) {
-        fits_read_keyn(reinterpret_cast<fitsfile *>(fptr), i, key, value, comment, &status);
-        // fits_read_keyn does not convert the key case on read, like other fits methods in cfitsio>=3.38
-        // We uppercase to try to be more consistent.
+        getCard(i);
+        int keyLength = 0;
+        key[0] = '\0';
+        value[0] = '\0';
+        comment[0] = '\0';
+        fits_get_keyname(card, key, &keyLength, &status);
+        fits_parse_value(card, value, comment, &status);
+        // fits_get_keyname does not convert the key case on read, like other fits methods in
+        // cfitsio>=3.38. We uppercase to try to be more consistent.
         std::string upperKey(key);
         boost::to_upper(upperKey);
         if (upperKey.compare(key) != 0){
@@ -804,34 +979,33 @@ void Fits::forEachKey(HeaderIterationFunctor &functor) {
         commentStr = comment;
         ++i;
         while (valueStr.size() > 2 && valueStr[valueStr.size() - 2] == '&' && i <= nKeys) {
-            // we're using key to hold the entire record here; the actual key is safe in keyStr
-            fits_read_record(reinterpret_cast<fitsfile *>(fptr), i, key, &status);
-            if (strncmp(key, "CONTINUE", 8) != 0) {
+            getCard(i);
+            if (strncmp(card, "CONTINUE", 8) != 0) {
                 // require both trailing '&' and CONTINUE to invoke long-string handling
                 break;
             }
-            std::string card = key;
+            std::string const record(card);
             valueStr.erase(valueStr.size() - 2);
-            std::size_t firstQuote = card.find('\'');
+            std::size_t firstQuote = record.find('\'');
             if (firstQuote == std::string::npos) {
                 throw LSST_EXCEPT(
                         FitsError,
                         makeErrorMessage(
                                 fptr, status,
-                                boost::format("Invalid CONTINUE at header key %d: \"%s\".") % i % card));
+                                boost::format("Invalid CONTINUE at header key %d: \"%s\".") % i % record));
             }
-            std::size_t lastQuote = card.find('\'', firstQuote + 1);
+            std::size_t lastQuote = record.find('\'', firstQuote + 1);
             if (lastQuote == std::string::npos) {
                 throw LSST_EXCEPT(
                         FitsError,
                         makeErrorMessage(
                                 fptr, status,
-                                boost::format("Invalid CONTINUE at header key %d: \"%s\".") % i % card));
+                                boost::format("Invalid CONTINUE at header key %d: \"%s\".") % i % record));
             }
-            valueStr += card.substr(firstQuote + 1, lastQuote - firstQuote);
-            std::size_t slash = card.find('/', lastQuote + 1);
+            valueStr += record.substr(firstQuote + 1, lastQuote - firstQuote);
+            std::size_t slash = record.find('/', lastQuote + 1);
             if (slash != std::string::npos) {
-                commentStr += strip(card.substr(slash + 1));
+                commentStr += strip(record.substr(slash + 1));
             }
             ++i;
         }
@@ -1214,6 +1388,26 @@ void Fits::readTableScalar(std::size_t row, int col, std::string &value, bool is
     value = std::string(tmp);
 }
 
+void Fits::readTableStringArray(std::size_t row, int col, int nRows, std::string *value) {
+    int anynul = false;
+    long size = getTableArraySize(col);
+    // One null-terminated buffer per row; cfitsio fills each through the pointer array.
+    std::vector<char> buf(nRows * (size + 1), 0);
+    std::vector<char *> ptrs(nRows);
+    for (int i = 0; i < nRows; ++i) {
+        ptrs[i] = &buf[i * (size + 1)];
+    }
+    fits_read_col(reinterpret_cast<fitsfile *>(fptr), TSTRING, col + 1, row + 1, 1, nRows, 0, ptrs.data(),
+                  &anynul, &status);
+    if (behavior & AUTO_CHECK) {
+        LSST_FITS_CHECK_STATUS(*this, boost::format("Reading %d rows of string column %d starting at row %d") %
+                                              nRows % col % row);
+    }
+    for (int i = 0; i < nRows; ++i) {
+        value[i] = std::string(ptrs[i]);
+    }
+}
+
 long Fits::getTableArraySize(int col) {
     int typecode = 0;
     long result = 0;
@@ -1290,6 +1484,77 @@ private:
     ImageCompressionOptions old;  // Former compression options, to be restored
 };
 
+/*
+ * Number of bytes per pixel on disk for cfitsio type codes whose data unit
+ * is a pure byte swap of the in-memory array (no offset or rescaling applied
+ * by cfitsio), or zero if the type needs cfitsio's element-by-element
+ * conversion path.  Unsigned and platform-sized types are stored with an
+ * offset or a width that need not match memory, so they are left to cfitsio.
+ */
+std::size_t bulkWriteElementSize(int fitsType) {
+    switch (fitsType) {
+        case TBYTE:
+            return 1;
+        case TSHORT:
+            return 2;
+        case TINT:
+        case TFLOAT:
+            return 4;
+        case TLONGLONG:
+        case TDOUBLE:
+            return 8;
+        default:
+            return 0;
+    }
+}
+
+/*
+ * Write the data unit of the current (uncompressed) image HDU with bulk
+ * byte-level writes: the pixels are swapped to big-endian in large blocks
+ * using cfitsio's vectorized swap routines and handed to the byte-level
+ * interface, instead of being funneled element by element through cfitsio's
+ * internal buffering.  For NVMe-class storage the buffered path is the
+ * bottleneck for uncompressed multi-megapixel planes.
+ *
+ * The header must be complete; errors are reported through fits.status like
+ * any other cfitsio call.
+ */
+void writeDataUnitRaw(Fits &fits, void const *data, std::size_t nElements, std::size_t elementSize) {
+    auto fptr = reinterpret_cast<fitsfile *>(fits.fptr);
+    // Finalize the header so that the data-unit offset below is defined.
+    ffrdef(fptr, &fits.status);
+    LONGLONG headstart = 0, datastart = 0, dataend = 0;
+    fits_get_hduaddrll(fptr, &headstart, &datastart, &dataend, &fits.status);
+    if (fits.status != 0) {
+        return;
+    }
+    // Swap and write in blocks: large enough that cfitsio passes them
+    // straight through to the I/O driver, small enough to bound the scratch
+    // copy.  The block size is a multiple of every element size.
+    constexpr std::size_t BLOCK_SIZE = std::size_t(1) << 25;  // 32 MiB
+    std::size_t const totalBytes = nElements * elementSize;
+    std::vector<char> buffer(std::min(totalBytes, BLOCK_SIZE));
+    ffmbyt(fptr, datastart, IGNORE_EOF, &fits.status);
+    for (std::size_t offset = 0; offset < totalBytes && fits.status == 0; offset += BLOCK_SIZE) {
+        std::size_t const nBytes = std::min(BLOCK_SIZE, totalBytes - offset);
+        std::memcpy(buffer.data(), reinterpret_cast<char const *>(data) + offset, nBytes);
+#if BYTESWAPPED
+        switch (elementSize) {
+            case 2:
+                ffswap2(reinterpret_cast<short *>(buffer.data()), static_cast<long>(nBytes / 2));
+                break;
+            case 4:
+                ffswap4(reinterpret_cast<INT32BIT *>(buffer.data()), static_cast<long>(nBytes / 4));
+                break;
+            case 8:
+                ffswap8(reinterpret_cast<double *>(buffer.data()), static_cast<long>(nBytes / 8));
+                break;
+        }
+#endif
+        ffpbyt(fptr, nBytes, buffer.data(), &fits.status);
+    }
+}
+
 }  // anonymous namespace
 
 template <typename T>
@@ -1328,7 +1593,7 @@ void Fits::writeImage(image::ImageBase<T> const &image, ImageWriteOptions const
     // Scale the image how we want it on disk
     ndarray::Array<T const, 2, 2> array = makeContiguousArray(image.getArray());
     auto pixels = scale.toFits(array, compression.quantizeLevel != 0, options.scaling.fuzz,
-                               options.compression.tiles, options.scaling.seed);
+                               options.compression.tiles, options.scaling.seed, options.threads);
 
     // We only want cfitsio to do the scale and zero for unsigned 64-bit integer types. For those,
     // "double bzero" has sufficient precision to represent the appropriate value. We'll let
@@ -1345,11 +1610,24 @@ void Fits::writeImage(image::ImageBase<T> const &image, ImageWriteOptions const
 
     // Write the pixels
     int const fitsType = scale.bitpix == 0 ? FitsType<T>::CONSTANT : fitsTypeForBitpix(scale.bitpix);
-    fits_write_img(fits, fitsType, 1, pixels->getNumElements(), const_cast<void *>(pixels->getData()),
-                   &status);
+    std::size_t const bulkElementSize =
+            std::is_same<T, std::uint64_t>::value ? 0 : bulkWriteElementSize(fitsType);
+    if (compression.algorithm == ImageCompressionOptions::NONE && bulkElementSize > 0 &&
+        pixels->getNumElements() > 0 && status == 0) {
+        writeDataUnitRaw(*this, pixels->getData(), pixels->getNumElements(), bulkElementSize);
+    } else {
+        fits_write_img(fits, fitsType, 1, pixels->getNumElements(), const_cast<void *>(pixels->getData()),
+                       &status);
+    }
     if (behavior & AUTO_CHECK) {
         LSST_FITS_CHECK_STATUS(*this, "Writing image");
     }
+    if (status == 0) {
+        // bytes of the (uncompressed) data unit; compression may shrink this on disk
+        int const bitpix = scale.bitpix == 0 ? detail::Bitpix<T>::value : scale.bitpix;
+        instrumentation::add(instrumentation::Metric::FITS_BYTES_WRITTEN,
+                             pixels->getNumElements() * static_cast<std::uint64_t>(std::abs(bitpix) / 8));
+    }
 
     // Now write the headers we didn't want cfitsio to know about when we were writing the pixels
     // (because we don't want it using them to modify the pixels, and we don't want it overwriting
@@ -1394,6 +1672,84 @@ void Fits::writeImage(image::ImageBase<T> const &image, ImageWriteOptions const
     }
 }
 
+template <typename T>
+ImageStripWriter<T>::ImageStripWriter(std::string const &fileName, lsst::geom::Box2I const &bbox,
+                                      ImageWriteOptions const &options,
+                                      std::shared_ptr<daf::base::PropertySet const> header)
+        : _fits(fileName, "w", Fits::AUTO_CLOSE | Fits::AUTO_CHECK),
+          _width(bbox.getWidth()),
+          _height(bbox.getHeight()),
+          _nextRow(0),
+          _closed(false) {
+    if (options.scaling.algorithm != ImageScalingOptions::NONE) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "Scaling requires statistics of the full image, "
+                          "which a strip-at-a-time write cannot provide");
+    }
+    if (bbox.getArea() > 0) {  // cfitsio can't compress empty images
+        _fits.setImageCompression(options.compression);
+    }
+    long nAxes[2] = {_width, _height};
+    _fits.createImageImpl(detail::Bitpix<T>::value, 2, nAxes);
+    std::shared_ptr<daf::base::PropertyList> wcsMetadata =
+            geom::createTrivialWcsMetadata(image::detail::wcsNameForXY0, bbox.getMin());
+    if (header) {
+        std::shared_ptr<daf::base::PropertySet> copy = header->deepCopy();
+        copy->combine(wcsMetadata);
+        header = copy;
+    } else {
+        header = wcsMetadata;
+    }
+    _fits.writeMetadata(*header);
+}
+
+template <typename T>
+ImageStripWriter<T>::~ImageStripWriter() noexcept {
+    if (!_closed) {
+        _fits.status = 0;
+        _fits.closeFile();
+        _closed = true;
+    }
+}
+
+template <typename T>
+void ImageStripWriter<T>::writeStrip(ndarray::Array<T const, 2, 2> const &strip) {
+    if (_closed) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError, "Writer has already been closed");
+    }
+    long const nRows = strip.getShape()[0];
+    if (static_cast<long>(strip.getShape()[1]) != _width) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Strip width %d does not match image width %d") %
+                           strip.getShape()[1] % _width)
+                                  .str());
+    }
+    if (_nextRow + nRows > _height) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Strip of %d rows at row %d overflows image height %d") % nRows %
+                           _nextRow % _height)
+                                  .str());
+    }
+    fits_write_img(reinterpret_cast<fitsfile *>(_fits.fptr), FitsType<T>::CONSTANT, 1 + _nextRow * _width,
+                   strip.getNumElements(), const_cast<T *>(strip.getData()), &_fits.status);
+    LSST_FITS_CHECK_STATUS(_fits, boost::format("Writing %d rows at row %d") % nRows % _nextRow);
+    _nextRow += nRows;
+}
+
+template <typename T>
+void ImageStripWriter<T>::close() {
+    if (_closed) {
+        return;
+    }
+    if (_nextRow != _height) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          (boost::format("Only %d of %d rows have been written") % _nextRow % _height).str());
+    }
+    _fits.closeFile();
+    LSST_FITS_CHECK_STATUS(_fits, "Closing file");
+    _closed = true;
+}
+
 namespace {
 
 /// Value for BLANK pixels
@@ -1417,6 +1773,13 @@ void Fits::readImageImpl(int nAxis, T *data, long *begin, long *end, long *incre
     fits_read_subset(reinterpret_cast<fitsfile *>(fptr), FitsType<T>::CONSTANT, begin, end, increment,
                      reinterpret_cast<void *>(&null), data, &anyNulls, &status);
     if (behavior & AUTO_CHECK) LSST_FITS_CHECK_STATUS(*this, "Reading image");
+    if (status == 0) {
+        std::uint64_t nPixels = 1;
+        for (int i = 0; i < nAxis; ++i) {
+            nPixels *= (end[i] - begin[i]) / increment[i] + 1;
+        }
+        instrumentation::add(instrumentation::Metric::FITS_BYTES_READ, nPixels * sizeof(T));
+    }
 }
 
 int Fits::getImageDim() {
@@ -1431,6 +1794,69 @@ void Fits::getImageShapeImpl(int maxDim, long *nAxes) {
     if (behavior & AUTO_CHECK) LSST_FITS_CHECK_STATUS(*this, "Getting NAXES");
 }
 
+std::shared_ptr<void> Fits::mapImageImpl(int nAxis, long *nAxes, int bitpix) {
+    fitsfile *fd = reinterpret_cast<fitsfile *>(fptr);
+    char urltype[FLEN_VALUE] = "";
+    fits_url_type(fd, urltype, &status);
+    if (behavior & AUTO_CHECK) LSST_FITS_CHECK_STATUS(*this, "Getting file URL type");
+    if (std::strcmp(urltype, "file://") != 0) {
+        return nullptr;  // in-memory or remote file: HDU addresses are not file offsets
+    }
+    if (isCompressedImage()) {
+        return nullptr;
+    }
+    int rawType = 0, equivType = 0;
+    fits_get_img_type(fd, &rawType, &status);
+    fits_get_img_equivtype(fd, &equivType, &status);
+    if (behavior & AUTO_CHECK) LSST_FITS_CHECK_STATUS(*this, "Getting image type");
+    if (rawType != bitpix || equivType != rawType) {
+        return nullptr;  // type conversion or BSCALE/BZERO rescaling required
+    }
+    if (getImageDim() != nAxis) {
+        return nullptr;
+    }
+    if (bitpix > 0) {
+        long blank = 0;
+        fits_read_key_lng(fd, "BLANK", &blank, nullptr, &status);
+        if (status == 0) {
+            return nullptr;  // undefined-pixel substitution requires a copying read
+        }
+        status = 0;  // keyword absent: not an error
+    }
+    getImageShapeImpl(nAxis, nAxes);
+    LONGLONG headStart = 0, dataStart = 0, dataEnd = 0;
+    fits_get_hduaddrll(fd, &headStart, &dataStart, &dataEnd, &status);
+    if (behavior & AUTO_CHECK) LSST_FITS_CHECK_STATUS(*this, "Getting HDU address");
+    std::size_t const elemSize = std::abs(bitpix) / 8;
+    std::size_t numBytes = elemSize;
+    for (int i = 0; i < nAxis; ++i) numBytes *= nAxes[i];
+    std::string fileName = getFileName();
+    int file = ::open(fileName.c_str(), O_RDONLY);
+    if (file < 0) {
+        return nullptr;  // e.g. cfitsio extended filename syntax; fall back to a copying read
+    }
+    // The data unit starts on a 2880-byte FITS block, but mmap offsets must be page-aligned.
+    std::size_t const pageSize = ::sysconf(_SC_PAGESIZE);
+    std::size_t const shift = dataStart % pageSize;
+    std::size_t const length = numBytes + shift;
+    void *mapping = ::mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE, file, dataStart - shift);
+    ::close(file);  // the mapping keeps its own reference to the file
+    if (mapping == MAP_FAILED) {
+        return nullptr;
+    }
+    std::shared_ptr<void> base(mapping, [length](void *ptr) { ::munmap(ptr, length); });
+    unsigned char *pixels = static_cast<unsigned char *>(mapping) + shift;
+    // FITS data are big-endian; swap in place on little-endian hosts.  The mapping
+    // is private, so this dirties the pages without touching the file.
+    std::uint16_t const one = 1;
+    if (elemSize > 1 && *reinterpret_cast<unsigned char const *>(&one) == 1) {
+        for (std::size_t i = 0; i < numBytes; i += elemSize) {
+            std::reverse(pixels + i, pixels + i + elemSize);
+        }
+    }
+    return std::shared_ptr<void>(base, pixels);
+}
+
 template <typename T>
 bool Fits::checkImageType() {
     int imageType = 0;
@@ -1590,13 +2016,13 @@ Fits::Fits(MemFileManager &manager, std::string const &mode, int behavior_)
                           &status);
     } else if (mode == "w" || mode == "wb") {
         Reallocator reallocator = 0;
-        if (manager._managed) reallocator = &std::realloc;
+        if (manager._managed) reallocator = manager._mmap ? &mmapReallocate : &std::realloc;
         fits_create_memfile(reinterpret_cast<fitsfile **>(&fptr), &manager._ptr, &manager._len, 0,
                             reallocator,  // use default deltasize
                             &status);
     } else if (mode == "a" || mode == "ab") {
         Reallocator reallocator = 0;
-        if (manager._managed) reallocator = &std::realloc;
+        if (manager._managed) reallocator = manager._mmap ? &mmapReallocate : &std::realloc;
         fits_open_memfile(reinterpret_cast<fitsfile **>(&fptr), "unused", READWRITE, &manager._ptr,
                           &manager._len, 0, reallocator, &status);
         int nHdu = 0;
@@ -1654,10 +2080,67 @@ std::shared_ptr<daf::base::PropertyList> combineMetadata(
     return combined;
 }
 
+void prefetchFitsFile(std::string const &fileName) {
+    int file = ::open(fileName.c_str(), O_RDONLY);
+    if (file < 0) {
+        return;  // prefetching is only a hint; the real read will report any problem
+    }
+#ifdef POSIX_FADV_WILLNEED
+    ::posix_fadvise(file, 0, 0, POSIX_FADV_WILLNEED);
+#endif
+    ::close(file);
+}
+
+namespace {
+
+// Capacity of the parsed-header cache in readMetadata(fileName, ...).
+constexpr std::size_t HEADER_CACHE_CAPACITY = 128;
+
+/*
+ * Build the cache key for a parsed header: the file name, resolved HDU and
+ * strip flag plus a hash of the raw header block of that HDU (combined with
+ * the primary header when the target HDU may inherit from it). A file that
+ * has been rewritten in place therefore never matches a stale entry; stale
+ * entries simply age out of the LRU.
+ */
+std::string makeHeaderCacheKey(std::string const &fileName, bool strip, Fits &fp) {
+    std::string const header = readEntireHeader(fp);
+    std::size_t hash = std::hash<std::string>()(header);
+    if (fp.getHdu() != 0) {
+        for (std::size_t pos = 0; pos + 8 <= header.size(); pos += 80) {
+            if (header.compare(pos, 8, "INHERIT ") == 0) {
+                HduMoveGuard guard(fp, 0);
+                hash = utils::hashCombine(hash, readEntireHeader(fp));
+                break;
+            }
+        }
+    }
+    return (boost::format("%s;%d;%d;%d") % fileName % fp.getHdu() % int(strip) % hash).str();
+}
+
+}  // namespace
+
 std::shared_ptr<daf::base::PropertyList> readMetadata(std::string const &fileName, int hdu, bool strip) {
     fits::Fits fp(fileName, "r", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK);
     fp.setHdu(hdu);
-    return readMetadata(fp, strip);
+    // Cache the parsed header so that reopening the same file (a common
+    // pattern when the components of an Exposure are read one by one) does
+    // not pay to parse the same cards again.
+    static utils::Cache<std::string, std::shared_ptr<daf::base::PropertyList const>> cache(
+            HEADER_CACHE_CAPACITY);
+    static std::mutex cacheMutex;
+    std::string const key = makeHeaderCacheKey(fileName, strip, fp);
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    bool miss = false;
+    auto const cached = cache(key, [&fp, strip, &miss](std::string const &) {
+        miss = true;
+        return std::shared_ptr<daf::base::PropertyList const>(readMetadata(fp, strip));
+    });
+    instrumentation::add(miss ? instrumentation::Metric::FITS_HEADER_CACHE_MISSES
+                              : instrumentation::Metric::FITS_HEADER_CACHE_HITS);
+    // Callers are free to modify the result, so hand out a deep copy rather
+    // than the cached instance.
+    return std::static_pointer_cast<daf::base::PropertyList>(cached->deepCopy());
 }
 
 std::shared_ptr<daf::base::PropertyList> readMetadata(fits::MemFileManager &manager, int hdu, bool strip) {
@@ -1697,6 +2180,34 @@ std::shared_ptr<daf::base::PropertyList> readMetadata(fits::Fits &fitsfile, bool
 }
 
 
+FitsHandlePool::Lease::~Lease() {
+    if (_pool && _fits) {
+        _pool->_release(std::move(_fits));
+    }
+}
+
+FitsHandlePool::Lease FitsHandlePool::acquire() {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        if (!_idle.empty()) {
+            std::unique_ptr<Fits> fits = std::move(_idle.back());
+            _idle.pop_back();
+            return Lease(*this, std::move(fits));
+        }
+    }
+    // Open outside the lock so that concurrent acquires of a drained pool
+    // do not serialize on file I/O.
+    return Lease(*this, std::make_unique<Fits>(_fileName, "r", Fits::AUTO_CLOSE | Fits::AUTO_CHECK));
+}
+
+void FitsHandlePool::_release(std::unique_ptr<Fits> fits) {
+    if (!fits->fptr || fits->status != 0) {
+        return;  // let the handle close rather than recycle an error state
+    }
+    std::lock_guard<std::mutex> lock(_mutex);
+    _idle.push_back(std::move(fits));
+}
+
 HduMoveGuard::HduMoveGuard(Fits & fits, int hdu, bool relative) :
     _fits(fits),
     _oldHdu(_fits.getHdu()),
@@ -1723,6 +2234,14 @@ HduMoveGuard::~HduMoveGuard() {
     std::swap(status, _fits.status);  // reset the old status
 }
 
+bool Fits::isCompressedImage() {
+    bool isCompressed = fits_is_compressed_image(reinterpret_cast<fitsfile *>(fptr), &status);
+    if (behavior & AUTO_CHECK) {
+        LSST_FITS_CHECK_STATUS(*this, "Checking compression");
+    }
+    return isCompressed;
+}
+
 bool Fits::checkCompressedImagePhu() {
     auto fits = reinterpret_cast<fitsfile *>(fptr);
     if (getHdu() != 0 || countHdus() == 1) {
@@ -1760,7 +2279,9 @@ ImageWriteOptions::ImageWriteOptions(daf::base::PropertySet const &config)
                                                       : std::vector<std::string>{},
                   config.getAsInt("scaling.seed"), config.getAsDouble("scaling.quantizeLevel"),
                   config.getAsDouble("scaling.quantizePad"), config.get<bool>("scaling.fuzz"),
-                  config.getAsDouble("scaling.bscale"), config.getAsDouble("scaling.bzero")) {}
+                  config.getAsDouble("scaling.bscale"), config.getAsDouble("scaling.bzero")) {
+    threads = config.getAsInt("threads");
+}
 
 namespace {
 
@@ -1796,6 +2317,8 @@ std::shared_ptr<daf::base::PropertySet> ImageWriteOptions::validate(daf::base::P
     validateEntry(*validated, config, "scaling.bscale", 1.0);
     validateEntry(*validated, config, "scaling.bzero", 0.0);
 
+    validateEntry(*validated, config, "threads", 1);
+
     // Check for additional entries that we don't support (e.g., from typos)
     for (auto const &name : config.names(false)) {
         if (!validated->exists(name)) {
@@ -1826,7 +2349,8 @@ std::shared_ptr<daf::base::PropertySet> ImageWriteOptions::validate(daf::base::P
                                    std::shared_ptr<image::Mask<image::MaskPixel> const>);  \
     template void Fits::readImageImpl(int, T *, long *, long *, long *);                   \
     template bool Fits::checkImageType<T>();                                               \
-    template int getBitPix<T>();
+    template int getBitPix<T>();                                                           \
+    template class ImageStripWriter<T>;
 
 #define INSTANTIATE_TABLE_OPS(r, data, T)                                \
     template int Fits::addColumn<T>(std::string const &ttype, int size); \
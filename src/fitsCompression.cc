@@ -1,5 +1,9 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
+#include <thread>
+#include <vector>
+
 #include "fitsio.h"
 extern "C" {
 #include "fitsio2.h"
@@ -24,6 +28,9 @@ ImageCompressionOptions::CompressionAlgorithm compressionAlgorithmFromString(std
     if (name == "RICE") return ImageCompressionOptions::RICE;
     if (name == "HCOMPRESS")
         throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "HCOMPRESS is unsupported");
+    if (name == "ZSTD")
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "ZSTD is unsupported: the FITS tiled-image convention defines no ZSTD codec");
     if (name == "PLIO") return ImageCompressionOptions::PLIO;
     throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Unrecognised compression algorithm: " + name);
 }
@@ -144,53 +151,69 @@ ImageScalingOptions::ImageScalingOptions(ScalingAlgorithm algorithm_, int bitpix
 
 namespace {
 
-/// Calculate median and standard deviation for an image
+/// Median, standard deviation and extrema for an image
+template <typename T>
+struct ImageStatistics {
+    T median;
+    T stdev;
+    T min;
+    T max;
+};
+
+/// Calculate median, standard deviation, min and max for an image
+///
+/// The per-pixel work (compaction and extrema) is done in a single traversal,
+/// with selects rather than branches in the loop body so it auto-vectorizes.
 template <typename T, int N>
-std::pair<T, T> calculateMedianStdev(ndarray::Array<T const, N, N> const& image,
-                                     ndarray::Array<bool, N, N> const& mask) {
-    std::size_t num = 0;
-    auto const& flatMask = ndarray::flatten<1>(mask);
-    for (auto mm = flatMask.begin(); mm != flatMask.end(); ++mm) {
-        if (!*mm) ++num;
-    }
-    ndarray::Array<T, 1, 1> array = ndarray::allocate(num);
+ImageStatistics<T> calculateStatistics(ndarray::Array<T const, N, N> const& image,
+                                       ndarray::Array<bool, N, N> const& mask) {
     auto const& flatImage = ndarray::flatten<1>(image);
-    auto mm = ndarray::flatten<1>(mask).begin();
-    auto aa = array.begin();
-    for (auto ii = flatImage.begin(); ii != flatImage.end(); ++ii, ++mm) {
-        if (*mm) continue;
-        *aa = *ii;
-        ++aa;
+    auto const& flatMask = ndarray::flatten<1>(mask);
+    std::size_t const numPixels = flatImage.getNumElements();
+    ndarray::Array<T, 1, 1> array = ndarray::allocate(numPixels);
+    T min = std::numeric_limits<T>::max(), max = std::numeric_limits<T>::min();
+    std::size_t num = 0;
+    for (std::size_t i = 0; i < numPixels; ++i) {
+        T const value = flatImage[i];
+        bool const masked = flatMask[i];
+        bool const use = !masked && std::isfinite(value);
+        min = use && value < min ? value : min;
+        max = use && value > max ? value : max;
+        array[num] = value;
+        num += !masked;
     }
 
     // Quartiles; from https://stackoverflow.com/a/11965377/834250
     auto const q1 = num / 4;
     auto const q2 = num / 2;
     auto const q3 = q1 + q2;
-    std::nth_element(array.begin(), array.begin() + q1, array.end());
-    std::nth_element(array.begin() + q1 + 1, array.begin() + q2, array.end());
-    std::nth_element(array.begin() + q2 + 1, array.begin() + q3, array.end());
+    std::nth_element(array.begin(), array.begin() + q1, array.begin() + num);
+    std::nth_element(array.begin() + q1 + 1, array.begin() + q2, array.begin() + num);
+    std::nth_element(array.begin() + q2 + 1, array.begin() + q3, array.begin() + num);
 
     T const median = num % 2 ? array[num / 2] : 0.5 * (array[num / 2] + array[num / 2 - 1]);
     // No, we're not doing any interpolation for the lower and upper quartiles.
     // We're estimating the noise, so it doesn't need to be super precise.
     T const lq = array[q1];
     T const uq = array[q3];
-    return std::make_pair(median, 0.741 * (uq - lq));
+    return {median, static_cast<T>(0.741 * (uq - lq)), min, max};
 }
 
 /// Calculate min and max for an image
 template <typename T, int N>
 std::pair<T, T> calculateMinMax(ndarray::Array<T const, N, N> const& image,
                                 ndarray::Array<bool, N, N> const& mask) {
-    T min = std::numeric_limits<T>::max(), max = std::numeric_limits<T>::min();
-    auto mm = ndarray::flatten<1>(mask).begin();
     auto const& flatImage = ndarray::flatten<1>(image);
-    for (auto ii = flatImage.begin(); ii != flatImage.end(); ++ii, ++mm) {
-        if (*mm) continue;
-        if (!std::isfinite(*ii)) continue;
-        if (*ii > max) max = *ii;
-        if (*ii < min) min = *ii;
+    auto const& flatMask = ndarray::flatten<1>(mask);
+    std::size_t const numPixels = flatImage.getNumElements();
+    T min = std::numeric_limits<T>::max(), max = std::numeric_limits<T>::min();
+    // Selects rather than branches so the loop auto-vectorizes; masked and
+    // non-finite pixels keep the current extrema.
+    for (std::size_t i = 0; i < numPixels; ++i) {
+        T const value = flatImage[i];
+        bool const use = !flatMask[i] && std::isfinite(value);
+        min = use && value < min ? value : min;
+        max = use && value > max ? value : max;
     }
     return std::make_pair(min, max);
 }
@@ -233,14 +256,14 @@ template <typename T, int N>
 ImageScale ImageScalingOptions::determineFromStdev(ndarray::Array<T const, N, N> const& image,
                                                    ndarray::Array<bool, N, N> const& mask, bool isUnsigned,
                                                    bool cfitsioPadding) const {
-    auto stats = calculateMedianStdev(image, mask);
-    auto const median = stats.first, stdev = stats.second;
+    // One traversal yields the quartile inputs and the extrema together.
+    auto stats = calculateStatistics(image, mask);
+    auto const median = stats.median, stdev = stats.stdev;
     double const bscale = static_cast<T>(stdev / quantizeLevel);
 
     /// Use min/max-based bzero if we can possibly fit everything in
-    auto minMax = calculateMinMax(image, mask);
-    T const min = minMax.first;
-    T const max = minMax.second;
+    T const min = stats.min;
+    T const max = stats.max;
     double range = rangeForBitpix<T>(bitpix, cfitsioPadding);  // Range of values for target BITPIX
     double const numUnique = (max - min) / bscale;             // Number of unique values
 
@@ -367,29 +390,54 @@ public:
     }
 
     /// Generate a flattened image of random numbers
+    ///
+    /// Each tile's sequence is fully determined by the seed and the tile
+    /// index (resetForTile), so tiles may be generated concurrently; the
+    /// result is identical for any thread count.
     template <typename T>
     ndarray::Array<T, 1, 1> forImage(typename ndarray::Array<T const, 2, 2>::Index const& shape,
-                                     ndarray::Array<long, 1> const& tiles) {
+                                     ndarray::Array<long, 1> const& tiles, int numThreads = 1) {
         std::size_t const xSize = shape[1], ySize = shape[0];
         ndarray::Array<T, 1, 1> out = ndarray::allocate(xSize * ySize);
         std::size_t const xTileSize = tiles[0] <= 0 ? xSize : tiles[0];
         std::size_t const yTileSize = tiles[1] < 0 ? ySize : (tiles[1] == 0 ? 1 : tiles[1]);
         int const xNumTiles = std::ceil(xSize / static_cast<float>(xTileSize));
         int const yNumTiles = std::ceil(ySize / static_cast<float>(yTileSize));
-        for (int iTile = 0, yTile = 0; yTile < yNumTiles; ++yTile) {
-            int const yStart = yTile * yTileSize;
-            int const yStop = std::min(yStart + yTileSize, ySize);
-            for (int xTile = 0; xTile < xNumTiles; ++xTile, ++iTile) {
+        int const numTiles = xNumTiles * yNumTiles;
+        auto doTiles = [&, this](int beginTile, int endTile, CfitsioRandom& rng) {
+            for (int iTile = beginTile; iTile < endTile; ++iTile) {
+                int const yTile = iTile / xNumTiles;
+                int const xTile = iTile % xNumTiles;
+                int const yStart = yTile * yTileSize;
+                int const yStop = std::min<std::size_t>(yStart + yTileSize, ySize);
                 int const xStart = xTile * xTileSize;
-                int const xStop = std::min(xStart + xTileSize, xSize);
-                resetForTile(iTile);
+                int const xStop = std::min<std::size_t>(xStart + xTileSize, xSize);
+                rng.resetForTile(iTile);
                 for (int y = yStart; y < yStop; ++y) {
                     auto iter = out.begin() + y * xSize + xStart;
                     for (int x = xStart; x < xStop; ++x, ++iter) {
-                        *iter = static_cast<T>(getNext());
+                        *iter = static_cast<T>(rng.getNext());
                     }
                 }
             }
+        };
+        if (numThreads <= 1 || numTiles < 2) {
+            doTiles(0, numTiles, *this);
+            return out;
+        }
+        int const useThreads = std::min(numThreads, numTiles);
+        std::vector<std::thread> threads;
+        threads.reserve(useThreads);
+        for (int i = 0; i < useThreads; ++i) {
+            int const beginTile = i * numTiles / useThreads;
+            int const endTile = (i + 1) * numTiles / useThreads;
+            threads.emplace_back([this, &doTiles, beginTile, endTile] {
+                CfitsioRandom rng(_seed);  // each thread gets its own generator state
+                doTiles(beginTile, endTile, rng);
+            });
+        }
+        for (auto& thread : threads) {
+            thread.join();
         }
         return out;
     }
@@ -409,7 +457,7 @@ template <typename T>
 std::shared_ptr<detail::PixelArrayBase> ImageScale::toFits(ndarray::Array<T const, 2, 2> const& image,
                                                            bool forceNonfiniteRemoval, bool fuzz,
                                                            ndarray::Array<long, 1> const& tiles,
-                                                           int seed) const {
+                                                           int seed, int numThreads) const {
     if (!std::numeric_limits<T>::is_integer && bitpix < 0) {
         if (bitpix != detail::Bitpix<T>::value) {
             throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
@@ -457,27 +505,40 @@ std::shared_ptr<detail::PixelArrayBase> ImageScale::toFits(ndarray::Array<T cons
             throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
                               "Tile sizes must be provided if fuzzing is desired");
         }
-        out = CfitsioRandom(seed).forImage<double>(image.getShape(), tiles);
+        out = CfitsioRandom(seed).forImage<double>(image.getShape(), tiles, numThreads);
     } else {
         out = ndarray::allocate(num);
         out.deep() = 0;
     }
-    auto outIter = out.begin();
     auto const& flatImage = ndarray::flatten<1>(image);
-    for (auto inIter = flatImage.begin(); inIter != flatImage.end(); ++inIter, ++outIter) {
-        double value = (*inIter - bzero) * scale;
-        if (!std::isfinite(value)) {
-            // This choice of "max" for non-finite and overflow pixels is mainly cosmetic --- it has to be
-            // something, and "min" would produce holes in the cores of bright stars.
-            *outIter = blank;
-            continue;
+    // Each pixel is scaled independently, so the work can be divided into
+    // contiguous bands with no merging; the result is identical for any
+    // thread count.
+    // Selects rather than branches in the loop body so it auto-vectorizes.
+    auto scaleBand = [&](std::size_t beginPix, std::size_t endPix) {
+        for (std::size_t i = beginPix; i != endPix; ++i) {
+            // Adding the random factor [0.0,1.0) adds a variance of 1/12,
+            // but preserves the expectation value given the floor();
+            // non-finite inputs stay non-finite and are blanked below.
+            double const value = (flatImage[i] - bzero) * scale + (applyFuzz ? out[i] : 0.0);
+            // This choice of "max" (blank) for non-finite and overflow pixels is mainly cosmetic --- it
+            // has to be something, and "min" would produce holes in the cores of bright stars.
+            bool const good = std::isfinite(value) && value >= min && value <= max;
+            out[i] = good ? std::floor(value) : blank;
+        }
+    };
+    if (numThreads <= 1 || num < 2) {
+        scaleBand(0, num);
+    } else {
+        std::size_t const useThreads = std::min<std::size_t>(numThreads, num);
+        std::vector<std::thread> threads;
+        threads.reserve(useThreads);
+        for (std::size_t i = 0; i < useThreads; ++i) {
+            threads.emplace_back(scaleBand, i * num / useThreads, (i + 1) * num / useThreads);
         }
-        if (applyFuzz) {
-            // Add random factor [0.0,1.0): adds a variance of 1/12,
-            // but preserves the expectation value given the floor()
-            value += *outIter;
+        for (auto& thread : threads) {
+            thread.join();
         }
-        *outIter = (value < min ? blank : (value > max ? blank : std::floor(value)));
     }
     return detail::makePixelArray(bitpix, out);
 }
@@ -494,7 +555,8 @@ ndarray::Array<T, 2, 2> ImageScale::fromFits(ndarray::Array<T, 2, 2> const& imag
     template ImageScale ImageScalingOptions::determine<TYPE, 2>(                                             \
             ndarray::Array<TYPE const, 2, 2> const& image, ndarray::Array<bool, 2, 2> const& mask) const;    \
     template std::shared_ptr<detail::PixelArrayBase> ImageScale::toFits<TYPE>(                               \
-            ndarray::Array<TYPE const, 2, 2> const&, bool, bool, ndarray::Array<long, 1> const&, int) const; \
+            ndarray::Array<TYPE const, 2, 2> const&, bool, bool, ndarray::Array<long, 1> const&, int, int)   \
+            const;                                                                                           \
     template ndarray::Array<TYPE, 2, 2> ImageScale::fromFits<TYPE>(ndarray::Array<TYPE, 2, 2> const&) const;
 
 INSTANTIATE(std::uint8_t);
@@ -34,40 +34,6 @@ namespace poly = lsst::geom::polynomials;
 
 namespace {
 
-std::pair<poly::PolynomialFunction2dYX, poly::PolynomialFunction2dYX> fitSipOneDirection(
-    int order,
-    lsst::geom::Box2D const & box,
-    double svdThreshold,
-    std::vector<lsst::geom::Point2D> const & input,
-    std::vector<lsst::geom::Point2D> const & output
-) {
-    // The scaled polynomial basis evaluates polynomials after mapping the
-    // input coordinates from the given box to [-1, 1]x[-1, 1] (for numerical
-    // stability).
-    auto basis = poly::ScaledPolynomialBasis2dYX(order, box);
-    auto workspace = basis.makeWorkspace();
-    Eigen::MatrixXd matrix = Eigen::MatrixXd::Zero(input.size(), basis.size());
-    Eigen::VectorXd xRhs(input.size());
-    Eigen::VectorXd yRhs(input.size());
-    for (int i = 0; i < matrix.rows(); ++i) {
-        basis.fill(input[i], matrix.row(i), workspace);
-        auto rhs = output[i] - input[i];
-        xRhs[i] = rhs.getX();
-        yRhs[i] = rhs.getY();
-    }
-    // Since we're not trying to null the zeroth- and first-order terms, the
-    // solution is just linear least squares, and we can do that with SVD.
-    auto decomp = matrix.jacobiSvd(Eigen::ComputeThinU | Eigen::ComputeThinV);
-    if (svdThreshold >= 0) {
-        decomp.setThreshold(svdThreshold);
-    }
-    auto scaledX = makeFunction2d(basis, decomp.solve(xRhs));
-    auto scaledY = makeFunction2d(basis, decomp.solve(yRhs));
-    // On return, we simplify the polynomials by moving the remapping transform
-    // into the coefficients themselves.
-    return std::make_pair(simplified(scaledX), simplified(scaledY));
-}
-
 // Return a vector of points on a grid, covering the given bounding box.
 std::vector<lsst::geom::Point2D> makeGrid(lsst::geom::Box2D const & bbox,
                                           lsst::geom::Extent2I const & shape) {
@@ -157,6 +123,64 @@ struct SipApproximation::Solution {
     poly::PolynomialFunction2dYX bp;
 };
 
+// Private implementation object for SipApproximation that holds the
+// least-squares machinery for fitting one direction of the transform.  The
+// design matrix (and hence its SVD) depends only on the sample positions and
+// the fit parameters, not on the values being fit to, so once constructed a
+// Fitter can solve for new right-hand sides cheaply; SipApproximation caches
+// the forward-direction Fitter to make updateTransform inexpensive.
+class SipApproximation::Fitter {
+public:
+
+    Fitter(int order_, double svdThreshold_, lsst::geom::Box2D const & box,
+           std::vector<lsst::geom::Point2D> const & input) :
+        order(order_),
+        svdThreshold(svdThreshold_),
+        // The scaled polynomial basis evaluates polynomials after mapping the
+        // input coordinates from the given box to [-1, 1]x[-1, 1] (for
+        // numerical stability).
+        _basis(order_, box)
+    {
+        auto workspace = _basis.makeWorkspace();
+        Eigen::MatrixXd matrix = Eigen::MatrixXd::Zero(input.size(), _basis.size());
+        for (int i = 0; i < matrix.rows(); ++i) {
+            _basis.fill(input[i], matrix.row(i), workspace);
+        }
+        // Since we're not trying to null the zeroth- and first-order terms,
+        // the solution is just linear least squares, and we can do that with
+        // SVD.
+        _decomp.compute(matrix, Eigen::ComputeThinU | Eigen::ComputeThinV);
+        if (svdThreshold >= 0) {
+            _decomp.setThreshold(svdThreshold);
+        }
+    }
+
+    std::pair<poly::PolynomialFunction2dYX, poly::PolynomialFunction2dYX> solve(
+        std::vector<lsst::geom::Point2D> const & input,
+        std::vector<lsst::geom::Point2D> const & output
+    ) const {
+        Eigen::VectorXd xRhs(input.size());
+        Eigen::VectorXd yRhs(input.size());
+        for (std::size_t i = 0; i < input.size(); ++i) {
+            auto rhs = output[i] - input[i];
+            xRhs[i] = rhs.getX();
+            yRhs[i] = rhs.getY();
+        }
+        auto scaledX = makeFunction2d(_basis, _decomp.solve(xRhs));
+        auto scaledY = makeFunction2d(_basis, _decomp.solve(yRhs));
+        // On return, we simplify the polynomials by moving the remapping
+        // transform into the coefficients themselves.
+        return std::make_pair(simplified(scaledX), simplified(scaledY));
+    }
+
+    int const order;
+    double const svdThreshold;
+
+private:
+    poly::ScaledPolynomialBasis2dYX _basis;
+    Eigen::JacobiSVD<Eigen::MatrixXd> _decomp;
+};
+
 SipApproximation::Grid::Grid(lsst::geom::Extent2I const & shape_, SipApproximation const & parent) :
     shape(shape_),
     dpix1(makeGrid(parent._bbox, shape)),
@@ -196,13 +220,25 @@ std::unique_ptr<SipApproximation::Solution> SipApproximation::Solution::fit(
 
     lsst::geom::Box2D boxFwd(parent._bbox);
     boxFwd.shift(-parent._crpix);
-    auto fwd = fitSipOneDirection(order, boxFwd, svdThreshold, parent._grid->dpix1, parent._grid->siwc);
+    // The forward-direction Fitter is cached on the parent, because its
+    // design matrix depends only on the grid sample positions and the fit
+    // parameters; updateTransform relies on reusing it when only the
+    // transform has changed.
+    if (!parent._fitter || parent._fitter->order != order
+            || parent._fitter->svdThreshold != svdThreshold) {
+        parent._fitter = std::make_unique<Fitter const>(order, svdThreshold, boxFwd, parent._grid->dpix1);
+    }
+    auto fwd = parent._fitter->solve(parent._grid->dpix1, parent._grid->siwc);
 
+    // The inverse-direction fit takes its input points from the transform
+    // being approximated, so there is nothing to reuse when the transform
+    // changes and no point in caching its Fitter.
     lsst::geom::Box2D boxInv;
     for (auto const & point : parent._grid->siwc) {
         boxInv.include(point);
     }
-    auto inv = fitSipOneDirection(order, boxInv, svdThreshold, parent._grid->siwc, parent._grid->dpix2);
+    auto inv = Fitter(order, svdThreshold, boxInv, parent._grid->siwc).solve(
+        parent._grid->siwc, parent._grid->dpix2);
 
     return std::make_unique<Solution>(fwd.first, fwd.second, inv.first, inv.second);
 }
@@ -364,6 +400,8 @@ lsst::geom::Extent2I SipApproximation::getGridShape() const noexcept {
 
 void SipApproximation::updateGrid(lsst::geom::Extent2I const & shape) {
     _grid = std::make_unique<Grid>(shape, *this);
+    // The cached fit machinery depends on the grid sample positions.
+    _fitter.reset();
 }
 
 void SipApproximation::refineGrid(int f) {
@@ -378,6 +416,25 @@ void SipApproximation::fit(int order, double svdThreshold) {
     _solution = Solution::fit(order, svdThreshold, *this);
 }
 
+void SipApproximation::updateTransform(std::shared_ptr<TransformPoint2ToPoint2> pixelToIwc) {
+    auto oldTransform = std::move(_pixelToIwc);
+    auto oldGrid = std::move(_grid);
+    _pixelToIwc = std::move(pixelToIwc);
+    try {
+        // Re-evaluate the new transform at the same sample positions; the
+        // grid geometry is unchanged, so the Fitter cached by the last fit
+        // (if any) remains valid and Solution::fit reduces to solving for
+        // new right-hand sides in the forward direction.
+        _grid = std::make_unique<Grid>(oldGrid->shape, *this);
+        double const svdThreshold = _fitter ? _fitter->svdThreshold : -1.0;
+        _solution = Solution::fit(getOrder(), svdThreshold, *this);
+    } catch (...) {
+        _pixelToIwc = std::move(oldTransform);
+        _grid = std::move(oldGrid);
+        throw;
+    }
+}
+
 std::pair<double, double> SipApproximation::computeMaxDeviation() const noexcept {
     std::pair<double, double> maxDiff(0.0, 0.0);
     auto ws = _solution->makeWorkspace();
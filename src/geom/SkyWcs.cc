@@ -24,6 +24,7 @@
 #include <cmath>
 #include <cstdint>
 #include <exception>
+#include <limits>
 #include <memory>
 #include <ostream>
 #include <sstream>
@@ -42,6 +43,7 @@
 #include "lsst/afw/geom/detail/transformUtils.h"
 #include "lsst/afw/geom/wcsUtils.h"
 #include "lsst/afw/geom/SkyWcs.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/daf/base/PropertyList.h"
 #include "lsst/pex/exceptions.h"
 #include "lsst/afw/table/io/Persistable.cc"
@@ -215,6 +217,110 @@ std::shared_ptr<SkyWcs> SkyWcs::copyAtShiftedPixelOrigin(lsst::geom::Extent2D co
     return makeModifiedWcs(newToOldPixel, *this, true);
 }
 
+std::shared_ptr<SkyWcs> SkyWcs::deepCopy() const {
+    // The SkyWcs(FrameDict const &) constructor copies the dict (via _checkFrameDict),
+    // so the result shares no AST objects with this one.
+    return std::make_shared<SkyWcs>(*getFrameDict());
+}
+
+void SkyWcs::_setupTanFastPath() noexcept {
+    _hasTanFastPath = false;
+    try {
+        auto const crpix = getPixelOrigin();
+        auto const crval = getSkyOrigin();
+
+        // Measure the CD matrix from unit pixel offsets through the pixels->IWC mapping.
+        // For the pure TAN case that mapping is linear, so this is exact (unlike getCdMatrix,
+        // which differentiates numerically); for any other case the validation below fails.
+        auto const pixelToIwc =
+                TransformPoint2ToPoint2(*getFrameDict()->getMapping(ast::FrameSet::BASE, "IWC"));
+        std::vector<lsst::geom::Point2D> const probe = {
+                crpix,
+                crpix + lsst::geom::Extent2D(1, 0),
+                crpix + lsst::geom::Extent2D(0, 1),
+        };
+        auto const iwc = pixelToIwc.applyForward(probe);
+        // IWC must vanish at the pixel origin, or the gnomonic closed form does not apply
+        if (std::hypot(iwc[0][0], iwc[0][1]) > 1e-9) {
+            return;
+        }
+        double const degPerRad = 180.0 / lsst::geom::PI;
+        Eigen::Matrix2d cd;  // radians/pixel
+        cd(0, 0) = (iwc[1][0] - iwc[0][0]) / degPerRad;
+        cd(1, 0) = (iwc[1][1] - iwc[0][1]) / degPerRad;
+        cd(0, 1) = (iwc[2][0] - iwc[0][0]) / degPerRad;
+        cd(1, 1) = (iwc[2][1] - iwc[0][1]) / degPerRad;
+        if (!(std::abs(cd.determinant()) > 0)) {
+            return;
+        }
+
+        _tanAlpha0 = crval.getLongitude().asRadians();
+        _tanSinDelta0 = std::sin(crval.getLatitude().asRadians());
+        _tanCosDelta0 = std::cos(crval.getLatitude().asRadians());
+        _tanCrpix = crpix;
+        _tanCd = cd;
+        _tanCdInv = cd.inverse();
+
+        // Validate the closed form against the generic transform on a grid of sample
+        // points spanning +/- 2000 pixels; any distortion (e.g. SIP terms) large enough
+        // to matter is enormous compared to these tolerances.
+        std::vector<lsst::geom::Point2D> samples;
+        for (int i = -2; i <= 2; ++i) {
+            for (int j = -2; j <= 2; ++j) {
+                samples.emplace_back(crpix + lsst::geom::Extent2D(i * 1000.0, j * 1000.0));
+            }
+        }
+        auto const exactSky = _transform->applyForward(samples);
+        double const maxSkyErr = 1e-11;  // radians; ~2 micro-arcseconds
+        for (std::size_t k = 0; k < samples.size(); ++k) {
+            if (!exactSky[k].isFinite() ||
+                _tanPixelToSky(samples[k]).separation(exactSky[k]).asRadians() > maxSkyErr) {
+                return;
+            }
+        }
+        auto const exactPix = _transform->applyInverse(exactSky);
+        double const maxPixErr = 1e-4;  // pixels; limited by AST's iterative inverse
+        for (std::size_t k = 0; k < samples.size(); ++k) {
+            if ((_tanSkyToPixel(exactSky[k]) - exactPix[k]).computeNorm() > maxPixErr) {
+                return;
+            }
+        }
+        _hasTanFastPath = true;
+    } catch (...) {
+        // Anything unexpected (no IWC frame, non-finite geometry, ...) just means no fast path
+        _hasTanFastPath = false;
+    }
+}
+
+lsst::geom::SpherePoint SkyWcs::_tanPixelToSky(lsst::geom::Point2D const& pixel) const {
+    double const dx = pixel.getX() - _tanCrpix.getX();
+    double const dy = pixel.getY() - _tanCrpix.getY();
+    // Standard coordinates (gnomonic tangent-plane offsets), in radians
+    double const xi = _tanCd(0, 0) * dx + _tanCd(0, 1) * dy;
+    double const eta = _tanCd(1, 0) * dx + _tanCd(1, 1) * dy;
+    double const w = _tanCosDelta0 - eta * _tanSinDelta0;
+    double const alpha = _tanAlpha0 + std::atan2(xi, w);
+    double const delta = std::atan2(_tanSinDelta0 + eta * _tanCosDelta0, std::hypot(xi, w));
+    return lsst::geom::SpherePoint(alpha * lsst::geom::radians, delta * lsst::geom::radians);
+}
+
+lsst::geom::Point2D SkyWcs::_tanSkyToPixel(lsst::geom::SpherePoint const& sky) const {
+    double const sinDelta = std::sin(sky.getLatitude().asRadians());
+    double const cosDelta = std::cos(sky.getLatitude().asRadians());
+    double const dAlpha = sky.getLongitude().asRadians() - _tanAlpha0;
+    double const sinDAlpha = std::sin(dAlpha);
+    double const cosDAlpha = std::cos(dAlpha);
+    double const denom = sinDelta * _tanSinDelta0 + cosDelta * _tanCosDelta0 * cosDAlpha;
+    if (!(denom > std::numeric_limits<double>::epsilon())) {
+        // At or beyond 90 degrees from the projection center; defer to the generic path
+        return _transform->applyInverse(sky);
+    }
+    double const xi = cosDelta * sinDAlpha / denom;
+    double const eta = (sinDelta * _tanCosDelta0 - cosDelta * _tanSinDelta0 * cosDAlpha) / denom;
+    return lsst::geom::Point2D(_tanCrpix.getX() + _tanCdInv(0, 0) * xi + _tanCdInv(0, 1) * eta,
+                               _tanCrpix.getY() + _tanCdInv(1, 0) * xi + _tanCdInv(1, 1) * eta);
+}
+
 std::shared_ptr<daf::base::PropertyList> SkyWcs::getFitsMetadata(bool precise) const {
     // Make a FrameSet that maps from GRID to SKY; GRID = the base frame (PIXELS or ACTUAL_PIXELS) + 1
     auto const gridToPixel = ast::ShiftMap({-1.0, -1.0});
@@ -523,6 +629,29 @@ std::shared_ptr<SkyWcs> makeModifiedWcs(TransformPoint2ToPoint2 const& pixelTran
     return std::make_shared<SkyWcs>(*newFrameDict);
 }
 
+std::vector<std::shared_ptr<SkyWcs>> makeModifiedWcs(
+        TransformPoint2ToPoint2 const& pixelTransform,
+        std::vector<std::shared_ptr<SkyWcs const>> const& wcsList, bool modifyActualPixels) {
+    for (std::size_t i = 0; i < wcsList.size(); ++i) {
+        if (wcsList[i] == nullptr) {
+            std::ostringstream os;
+            os << "WCS " << i << " of " << wcsList.size() << " is null";
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, os.str());
+        }
+    }
+    std::vector<std::shared_ptr<SkyWcs>> result(wcsList.size());
+    // One task per WCS: each composes and simplifies its own mappings, which
+    // is where nearly all the time goes when updating a whole camera.
+    math::TaskPool::TaskGroup group;
+    for (std::size_t i = 0; i < wcsList.size(); ++i) {
+        group.run([&pixelTransform, &wcsList, &result, modifyActualPixels, i] {
+            result[i] = makeModifiedWcs(pixelTransform, *wcsList[i], modifyActualPixels);
+        });
+    }
+    group.wait();
+    return result;
+}
+
 std::shared_ptr<SkyWcs> makeSkyWcs(daf::base::PropertySet& metadata, bool strip) {
     return std::make_shared<SkyWcs>(metadata, strip);
 }
@@ -22,6 +22,7 @@
  */
 
 #include <algorithm>
+#include <cstdint>
 #include <iterator>
 #include "lsst/afw/geom/SpanSet.h"
 #include "lsst/afw/table/io/CatalogVector.h"
@@ -41,35 +42,77 @@ template std::shared_ptr<geom::SpanSet> table::io::PersistableFacade<geom::SpanS
 namespace geom {
 namespace {
 
-/* These classes are used in the erode operator to quickly calculate the
- * contents of the shrunken SpanSet
+/* These helpers are used by the dilate and erode operators to work on whole
+ * rows of a normalized SpanSet at a time, keeping the cost of the morphology
+ * linear in the number of runs involved
  */
 
-struct PrimaryRun {
-    int m, y, xmin, xmax;
+// A contiguous range of spans sharing a row within a sorted span vector
+struct SpanRow {
+    int y;
+    std::size_t begin, end;  // Half open range of indices into the span vector
 };
 
-bool comparePrimaryRun(PrimaryRun const& first, PrimaryRun const& second) {
-    if (first.y != second.y) {
-        return first.y < second.y;
-    } else if (first.m != second.m) {
-        return first.m < second.m;
-    } else {
-        return first.xmin < second.xmin;
+std::vector<SpanRow> indexSpanRows(std::vector<Span> const& spans) {
+    std::vector<SpanRow> rows;
+    for (std::size_t i = 0; i != spans.size();) {
+        std::size_t j = i + 1;
+        while (j != spans.size() && spans[j].getY() == spans[i].getY()) {
+            ++j;
+        }
+        rows.push_back(SpanRow{spans[i].getY(), i, j});
+        i = j;
     }
+    return rows;
 }
 
-class ComparePrimaryRunY {
-public:
-    bool operator()(PrimaryRun const& pr, int yval) { return pr.y < yval; }
-    bool operator()(int yval, PrimaryRun const& pr) { return yval < pr.y; }
-};
+// Return the SpanRow at the given y, or nullptr if the row is empty
+SpanRow const* findSpanRow(std::vector<SpanRow> const& rows, int y) {
+    auto iter = std::lower_bound(rows.begin(), rows.end(), y,
+                                 [](SpanRow const& row, int yval) { return row.y < yval; });
+    if (iter == rows.end() || iter->y != y) {
+        return nullptr;
+    }
+    return &*iter;
+}
 
-class ComparePrimaryRunM {
-public:
-    bool operator()(PrimaryRun const& pr, int mval) { return pr.m < mval; }
-    bool operator()(int mval, PrimaryRun const& pr) { return mval < pr.m; }
-};
+// Union a list of possibly overlapping x intervals, appending the result to out as Spans at row y
+void appendIntervalUnion(std::vector<std::pair<int, int>>& intervals, int y, std::vector<Span>& out) {
+    std::sort(intervals.begin(), intervals.end());
+    int x0 = intervals.front().first;
+    int x1 = intervals.front().second;
+    for (auto const& interval : intervals) {
+        if (interval.first > x1 + 1) {
+            // Not contiguous with the current run, so emit it and start another
+            out.push_back(Span(y, x0, x1));
+            x0 = interval.first;
+            x1 = interval.second;
+        } else {
+            x1 = std::max(x1, interval.second);
+        }
+    }
+    out.push_back(Span(y, x0, x1));
+}
+
+// Intersect two sorted lists of disjoint x intervals
+std::vector<std::pair<int, int>> intersectIntervals(std::vector<std::pair<int, int>> const& a,
+                                                    std::vector<std::pair<int, int>> const& b) {
+    std::vector<std::pair<int, int>> result;
+    std::size_t i = 0, j = 0;
+    while (i != a.size() && j != b.size()) {
+        int const x0 = std::max(a[i].first, b[j].first);
+        int const x1 = std::min(a[i].second, b[j].second);
+        if (x1 >= x0) {
+            result.emplace_back(x0, x1);
+        }
+        if (a[i].second < b[j].second) {
+            ++i;
+        } else {
+            ++j;
+        }
+    }
+    return result;
+}
 
 /* Determine if two spans overlap
  *
@@ -501,45 +544,62 @@ bool SpanSet::contains(lsst::geom::Point2I const& point) const {
 }
 
 lsst::geom::Point2D SpanSet::computeCentroid() const {
-    // Find the centroid of the SpanSet
-    std::size_t n = 0;
-    double xc = 0, yc = 0;
-    for (auto const& spn : _spanVector) {
-        int const y = spn.getY();
-        int const x0 = spn.getMinX();
-        int const x1 = spn.getMaxX();
-        int const npix = x1 - x0 + 1;
-
-        n += npix;
-        xc += npix * 0.5 * (x1 + x0);
-        yc += npix * y;
-    }
-    assert(n == _area);
+    // Find the centroid of the SpanSet; measurement code calls this repeatedly
+    // on the same immutable SpanSet so the result is computed once and cached.
+    // call_once makes the cached values safe to read from concurrent callers.
+    std::call_once(_centroidOnce, [this]() {
+        std::size_t n = 0;
+        double xc = 0, yc = 0;
+        for (auto const& spn : _spanVector) {
+            int const y = spn.getY();
+            int const x0 = spn.getMinX();
+            int const x1 = spn.getMaxX();
+            int const npix = x1 - x0 + 1;
+
+            n += npix;
+            xc += npix * 0.5 * (x1 + x0);
+            yc += npix * y;
+        }
+        assert(n == _area);
+
+        _xc = xc / _area;
+        _yc = yc / _area;
+    });
 
-    return lsst::geom::Point2D(xc / _area, yc / _area);
+    return lsst::geom::Point2D(_xc, _yc);
 }
 
 ellipses::Quadrupole SpanSet::computeShape() const {
-    // Compute the shape of the SpanSet
-    lsst::geom::Point2D cen = computeCentroid();
-    double const xc = cen.getX();
-    double const yc = cen.getY();
-
-    double sumxx = 0, sumxy = 0, sumyy = 0;
-    for (auto const& spn : _spanVector) {
-        int const y = spn.getY();
-        int const x0 = spn.getX0();
-        int const x1 = spn.getX1();
-        int const npix = x1 - x0 + 1;
-
-        for (int x = x0; x <= x1; ++x) {
-            sumxx += (x - xc) * (x - xc);
+    // Compute the shape of the SpanSet, caching the result as computeCentroid does
+    std::call_once(_shapeOnce, [this]() {
+        lsst::geom::Point2D cen = computeCentroid();
+        double const xc = cen.getX();
+        double const yc = cen.getY();
+
+        // Sum of x and of x^2 from 0 to n inclusive, for the closed form of the
+        // second moment of a span about the centroid
+        auto sumTo = [](double n) { return 0.5 * n * (n + 1); };
+        auto sumSqTo = [](double n) { return n * (n + 1) * (2 * n + 1) / 6.0; };
+
+        double sumxx = 0, sumxy = 0, sumyy = 0;
+        for (auto const& spn : _spanVector) {
+            int const y = spn.getY();
+            int const x0 = spn.getX0();
+            int const x1 = spn.getX1();
+            int const npix = x1 - x0 + 1;
+
+            sumxx += sumSqTo(x1) - sumSqTo(x0 - 1) - 2 * xc * (sumTo(x1) - sumTo(x0 - 1)) +
+                     npix * xc * xc;
+            sumxy += npix * (0.5 * (x1 + x0) - xc) * (y - yc);
+            sumyy += npix * (y - yc) * (y - yc);
         }
-        sumxy += npix * (0.5 * (x1 + x0) - xc) * (y - yc);
-        sumyy += npix * (y - yc) * (y - yc);
-    }
 
-    return ellipses::Quadrupole(sumxx / _area, sumyy / _area, sumxy / _area);
+        _ixx = sumxx / _area;
+        _iyy = sumyy / _area;
+        _ixy = sumxy / _area;
+    });
+
+    return ellipses::Quadrupole(_ixx, _iyy, _ixy);
 }
 
 std::shared_ptr<SpanSet> SpanSet::dilated(int r, Stencil s) const {
@@ -554,20 +614,46 @@ std::shared_ptr<SpanSet> SpanSet::dilated(SpanSet const& other) const {
     if (other.size() == 0) {
         return std::make_shared<SpanSet>(_spanVector.begin(), _spanVector.end(), false);
     }
+    if (this->size() == 0) {
+        return std::make_shared<SpanSet>();
+    }
 
-    // Return a dilated Spanset by the given SpanSet
-    std::vector<Span> tempVec;
+    /* The dilation is the union, over each span of other, of this SpanSet shifted
+     * by that span's position and widened by its extent.  Work one output row at a
+     * time, collecting the contributing intervals and merging them with a single
+     * sorted sweep, rather than building and re-sorting an all-pairs span list
+     */
+    std::vector<SpanRow> const rows = indexSpanRows(_spanVector);
+    std::vector<SpanRow> const otherRows = indexSpanRows(other._spanVector);
 
-    for (auto const& spn : _spanVector) {
-        for (auto const& otherSpn : other) {
-            int const xmin = spn.getMinX() + otherSpn.getMinX();
-            int const xmax = spn.getMaxX() + otherSpn.getMaxX();
-            int const yval = spn.getY() + otherSpn.getY();
-            tempVec.push_back(Span(yval, xmin, xmax));
+    std::vector<Span> tempVec;
+    tempVec.reserve(_spanVector.size());
+    std::vector<std::pair<int, int>> intervals;
+    int const yBegin = rows.front().y + otherRows.front().y;
+    int const yEnd = rows.back().y + otherRows.back().y;
+    for (int y = yBegin; y <= yEnd; ++y) {
+        intervals.clear();
+        for (auto const& otherRow : otherRows) {
+            SpanRow const* row = findSpanRow(rows, y - otherRow.y);
+            if (!row) {
+                continue;
+            }
+            for (std::size_t j = otherRow.begin; j != otherRow.end; ++j) {
+                Span const& otherSpn = other._spanVector[j];
+                for (std::size_t i = row->begin; i != row->end; ++i) {
+                    Span const& spn = _spanVector[i];
+                    intervals.emplace_back(spn.getMinX() + otherSpn.getMinX(),
+                                           spn.getMaxX() + otherSpn.getMaxX());
+                }
+            }
+        }
+        if (!intervals.empty()) {
+            appendIntervalUnion(intervals, y, tempVec);
         }
     }
-    // Allow constructor to handle merging adjacent and overlapping spans
-    return std::make_shared<SpanSet>(std::move(tempVec));
+    // The rows were visited in order and each row's sweep merged its spans, so the
+    // result is already normalized
+    return std::make_shared<SpanSet>(std::move(tempVec), false);
 }
 
 std::shared_ptr<SpanSet> SpanSet::eroded(int r, Stencil s) const {
@@ -583,97 +669,59 @@ std::shared_ptr<SpanSet> SpanSet::eroded(SpanSet const& other) const {
         return std::make_shared<SpanSet>(_spanVector.begin(), _spanVector.end(), false);
     }
 
-    // Return a SpanSet eroded by the given SpanSet
-    std::vector<Span> tempVec;
+    /* A pixel survives the erosion if every pixel of other, translated to it, lands
+     * inside this SpanSet.  Eroding one row of spans by a single span of other is
+     * itself a sorted span list (each span [x0, x1] shrinks to
+     * [x0 - otherX0, x1 - otherX1], or vanishes if other's span is wider), so the
+     * erosion of an output row is the intersection of those lists over every span
+     * of other, computed pairwise with a two pointer sweep
+     */
+    std::vector<SpanRow> const rows = indexSpanRows(_spanVector);
+    std::vector<SpanRow> const otherRows = indexSpanRows(other._spanVector);
 
-    // Calculate all possible primary runs.
-    std::vector<PrimaryRun> primaryRuns;
-    for (auto const& spn : _spanVector) {
-        int m = 0;
-        for (auto const& otherSpn : other) {
-            if ((otherSpn.getMaxX() - otherSpn.getMinX()) <= (spn.getMaxX() - spn.getMinX())) {
-                int xmin = spn.getMinX() - otherSpn.getMinX();
-                int xmax = spn.getMaxX() - otherSpn.getMaxX();
-                int y = spn.getY() - otherSpn.getY();
-                primaryRuns.push_back(PrimaryRun({m, y, xmin, xmax}));
+    std::vector<Span> tempVec;
+    std::vector<std::pair<int, int>> good;      // Intervals surviving every span of other so far
+    std::vector<std::pair<int, int>> eroded1d;  // Erosion of one row by one span of other
+    int const yBegin = rows.front().y - otherRows.front().y;
+    int const yEnd = rows.back().y - otherRows.back().y;
+    for (int y = yBegin; y <= yEnd; ++y) {
+        bool empty = false;
+        good.clear();
+        for (auto otherRow = otherRows.begin(); otherRow != otherRows.end() && !empty; ++otherRow) {
+            SpanRow const* row = findSpanRow(rows, y + otherRow->y);
+            if (!row) {
+                empty = true;
+                break;
             }
-            ++m;
-        }
-    }
-
-    // Iterate over the primary runs in such a way that we consider all values of m
-    // for a given y, then all m for y+1 etc.
-    std::sort(primaryRuns.begin(), primaryRuns.end(), comparePrimaryRun);
-
-    for (int y = primaryRuns.front().y; y <= primaryRuns.back().y; ++y) {
-        auto yRange = std::equal_range(primaryRuns.begin(), primaryRuns.end(), y, ComparePrimaryRunY());
-
-        /* Discard runs for any value of y for which we find fewer groups than M,
-         * the total Y range of the structuring element. This is step 3.1 of the
-         * Kim et al. algorithm.
-         */
-        // Plus one because end points are inclusive
-        auto otherYRange = other.back().getY() - other.front().getY() + 1;
-        if (std::distance(yRange.first, yRange.second) < otherYRange) {
-            continue;
-        }
-
-        /* "good" runs are those which are covered by each value of m, ie by each
-         * row in the structuring element. Our algorithm will consider each value
-         * of m in turn, gradually whittling down the list of good runs, then
-         * finally convert the remainder into Spans.
-         */
-        std::list<PrimaryRun> goodRuns;
-
-        for (int m = 0; m < otherYRange; ++m) {
-            auto mRange = std::equal_range(yRange.first, yRange.second, m, ComparePrimaryRunM());
-            if ((mRange.first == mRange.second)) {
-                // If a particular m is missing, we known that this y contains
-                // no good runs; this is equivalent to Kim et al. step 3.2.
-                goodRuns.clear();
-            } else {
-                // Consolidate all primary runs at this m so that they don't overlap.
-                std::list<PrimaryRun> candidateRuns;
-                int startX = mRange.first->xmin;
-                int endX = mRange.first->xmax;
-                for (auto run = mRange.first + 1; run != mRange.second; ++run) {
-                    if (run->xmin > endX) {
-                        // Start of a new run
-                        candidateRuns.push_back(PrimaryRun{m, y, startX, endX});
-                        startX = run->xmin;
-                        endX = run->xmax;
-                    } else {
-                        // Continuation of an existing run
-                        endX = run->xmax;
+            for (std::size_t j = otherRow->begin; j != otherRow->end && !empty; ++j) {
+                Span const& otherSpn = other._spanVector[j];
+                eroded1d.clear();
+                for (std::size_t i = row->begin; i != row->end; ++i) {
+                    Span const& spn = _spanVector[i];
+                    int const x0 = spn.getMinX() - otherSpn.getMinX();
+                    int const x1 = spn.getMaxX() - otherSpn.getMaxX();
+                    if (x1 >= x0) {
+                        eroded1d.emplace_back(x0, x1);
                     }
                 }
-                candidateRuns.push_back(PrimaryRun{m, y, startX, endX});
-
-                // Otherwise, calculate the intersection of candidate runs at
-                // this m with good runs from all previous m.
-                if (m == 0) {
-                    // For m = 0 we have nothing to compare to; all runs are accepted
-                    std::swap(goodRuns, candidateRuns);
+                if (otherRow == otherRows.begin() && j == otherRow->begin) {
+                    // The first span of other has nothing to intersect with yet
+                    good = eroded1d;
                 } else {
-                    std::list<PrimaryRun> newlist;
-                    for (auto& good : goodRuns) {
-                        for (auto& cand : candidateRuns) {
-                            int start = std::max(good.xmin, cand.xmin);
-                            int end = std::min(good.xmax, cand.xmax);
-                            if (end >= start) {
-                                newlist.push_back(PrimaryRun({m, y, start, end}));
-                            }
-                        }
-                    }
-                    std::swap(newlist, goodRuns);
+                    good = intersectIntervals(good, eroded1d);
                 }
+                empty = good.empty();
             }
         }
-        for (auto& run : goodRuns) {
-            tempVec.push_back(Span(run.y, run.xmin, run.xmax));
+        if (!empty) {
+            for (auto const& interval : good) {
+                tempVec.push_back(Span(y, interval.first, interval.second));
+            }
         }
     }
-    return std::make_shared<SpanSet>(std::move(tempVec));
+    // Intersections of sorted disjoint interval lists stay sorted and disjoint, so the
+    // result is already normalized
+    return std::make_shared<SpanSet>(std::move(tempVec), false);
 }
 
 bool SpanSet::operator==(SpanSet const& other) const {
@@ -714,8 +762,8 @@ std::shared_ptr<SpanSet> SpanSet::fromShape(int r, Stencil s, lsst::geom::Point2
 }
 
 std::shared_ptr<SpanSet> SpanSet::fromShape(ellipses::Ellipse const& ellipse) {
-    ellipses::PixelRegion pr(ellipse);
-    return std::make_shared<SpanSet>(pr.begin(), pr.end());
+    // The temporary PixelRegion hands its span vector over without a copy
+    return ellipses::PixelRegion(ellipse).getSpans();
 }
 
 std::shared_ptr<SpanSet> SpanSet::intersect(SpanSet const& other) const {
@@ -911,13 +959,23 @@ void SpanSet::setImage(image::Image<ImageT>& image, ImageT val, lsst::geom::Box2
     } else {
         bbox = region;
     }
-    auto setterFunc = [](lsst::geom::Point2I const& point, ImageT& out, ImageT in) { out = in; };
+    // Fill the pixels a span at a time rather than through the per-pixel functor machinery
+    auto setter = [val](SpanSet const& spanSet, image::Image<ImageT>& target) {
+        details::makeGetter(target).checkExtents(spanSet.getBBox(), spanSet.getArea());
+        auto const targetArray = target.getArray();
+        auto const xy0 = target.getXY0();
+        for (auto const& spn : spanSet) {
+            auto const row = targetArray[spn.getY() - xy0.getY()];
+            std::fill(row.begin() + (spn.getMinX() - xy0.getX()),
+                      row.begin() + (spn.getMaxX() + 1 - xy0.getX()), val);
+        }
+    };
     try {
         if (doClip) {
             auto tmpSpan = this->clippedTo(bbox);
-            tmpSpan->applyFunctor(setterFunc, image, val);
+            setter(*tmpSpan, image);
         } else {
-            applyFunctor(setterFunc, image, val);
+            setter(*this, image);
         }
     } catch (pex::exceptions::OutOfRangeError const&) {
         throw LSST_EXCEPT(pex::exceptions::OutOfRangeError,
@@ -927,24 +985,33 @@ void SpanSet::setImage(image::Image<ImageT>& image, ImageT val, lsst::geom::Box2
 
 template <typename T>
 void SpanSet::setMask(image::Mask<T>& target, T bitmask) const {
-    // Use a lambda to set bits in a mask at the locations given by SpanSet
+    // Set bits in the mask a span at a time; the inner loop over a contiguous
+    // row is a straightforward target for the compiler's vectorizer
     auto targetArray = target.getArray();
     auto xy0 = target.getBBox().getMin();
-    auto maskFunctor = [](lsst::geom::Point2I const& point,
-                          typename details::ImageNdGetter<T, 2, 1>::Reference maskVal,
-                          T bitmask) { maskVal |= bitmask; };
-    applyFunctor(maskFunctor, ndarray::ndImage(targetArray, xy0), bitmask);
+    ndarray::ndImage(targetArray, xy0).checkExtents(_bbox, _area);
+    for (auto const& spn : _spanVector) {
+        auto const row = targetArray[spn.getY() - xy0.getY()];
+        auto const end = row.begin() + (spn.getMaxX() + 1 - xy0.getX());
+        for (auto pixel = row.begin() + (spn.getMinX() - xy0.getX()); pixel != end; ++pixel) {
+            *pixel |= bitmask;
+        }
+    }
 }
 
 template <typename T>
 void SpanSet::clearMask(image::Mask<T>& target, T bitmask) const {
-    // Use a lambda to clear bits in a mask at the locations given by SpanSet
+    // Clear bits in the mask a span at a time, as in setMask
     auto targetArray = target.getArray();
     auto xy0 = target.getBBox().getMin();
-    auto clearMaskFunctor = [](lsst::geom::Point2I const& point,
-                               typename details::ImageNdGetter<T, 2, 1>::Reference maskVal,
-                               T bitmask) { maskVal &= ~bitmask; };
-    applyFunctor(clearMaskFunctor, ndarray::ndImage(targetArray, xy0), bitmask);
+    ndarray::ndImage(targetArray, xy0).checkExtents(_bbox, _area);
+    for (auto const& spn : _spanVector) {
+        auto const row = targetArray[spn.getY() - xy0.getY()];
+        auto const end = row.begin() + (spn.getMaxX() + 1 - xy0.getX());
+        for (auto pixel = row.begin() + (spn.getMinX() - xy0.getX()); pixel != end; ++pixel) {
+            *pixel &= ~bitmask;
+        }
+    }
 }
 
 template <typename T>
@@ -965,7 +1032,8 @@ std::shared_ptr<SpanSet> SpanSet::union_(image::Mask<T> const& other, T bitmask)
 }
 
 namespace {
-// Singleton helper class that manages the schema and keys for the persistence of SpanSets
+// Singleton helper class that manages the schema and keys for the one-span-per-record
+// persistence format; retained only so we can read SpanSets written by older versions.
 class SpanSetPersistenceHelper {
 public:
     table::Schema spanSetSchema;
@@ -994,6 +1062,109 @@ private:
               spanX1(spanSetSchema.addField<int>("x1", "Second column of span (inclusive)", "pixel")) {}
 };
 
+// Singleton helper class that manages the schema and keys for the compact persistence format:
+// a single record holding all of the spans delta-encoded in one variable-length blob column.
+class SpanSetBlobPersistenceHelper {
+public:
+    table::Schema spanSetSchema;
+    table::Key<int> nSpans;
+    table::Key<table::Array<std::uint8_t>> spanBlob;
+
+    static SpanSetBlobPersistenceHelper const& get() {
+        static SpanSetBlobPersistenceHelper instance;
+        return instance;
+    }
+
+    // No copying
+    SpanSetBlobPersistenceHelper(const SpanSetBlobPersistenceHelper&) = delete;
+    SpanSetBlobPersistenceHelper& operator=(const SpanSetBlobPersistenceHelper&) = delete;
+
+    // No Moving
+    SpanSetBlobPersistenceHelper(SpanSetBlobPersistenceHelper&&) = delete;
+    SpanSetBlobPersistenceHelper& operator=(SpanSetBlobPersistenceHelper&&) = delete;
+
+private:
+    SpanSetBlobPersistenceHelper()
+            : spanSetSchema(),
+              nSpans(spanSetSchema.addField<int>("nspans", "Number of spans encoded in the blob")),
+              spanBlob(spanSetSchema.addField<table::Array<std::uint8_t>>(
+                      "spans",
+                      "Delta-encoded spans: per span a zigzag varint row delta, a zigzag varint"
+                      " column delta, and a varint extent",
+                      "", 0)) {}
+};
+
+// Append `value` to `buffer` as a little-endian base-128 varint: seven payload bits per byte,
+// with the high bit set on every byte except the last.
+void appendVarint(std::uint64_t value, std::vector<std::uint8_t>& buffer) {
+    while (value >= 0x80) {
+        buffer.push_back(static_cast<std::uint8_t>(value) | 0x80);
+        value >>= 7;
+    }
+    buffer.push_back(static_cast<std::uint8_t>(value));
+}
+
+// Read one varint from [data, end), advancing data past it.
+std::uint64_t readVarint(std::uint8_t const*& data, std::uint8_t const* end) {
+    std::uint64_t result = 0;
+    for (int shift = 0; data != end; shift += 7) {
+        std::uint8_t const byte = *data++;
+        result |= static_cast<std::uint64_t>(byte & 0x7f) << shift;
+        if (!(byte & 0x80)) {
+            return result;
+        }
+    }
+    throw LSST_EXCEPT(table::io::MalformedArchiveError, "Truncated varint in encoded SpanSet blob");
+}
+
+// Map a signed integer onto an unsigned one with small absolute values staying small
+// (0 -> 0, -1 -> 1, 1 -> 2, -2 -> 3, ...), so that varints of small deltas stay short.
+std::uint64_t zigzagEncode(std::int64_t value) {
+    return (static_cast<std::uint64_t>(value) << 1) ^ static_cast<std::uint64_t>(value >> 63);
+}
+
+std::int64_t zigzagDecode(std::uint64_t value) {
+    return static_cast<std::int64_t>(value >> 1) ^ -static_cast<std::int64_t>(value & 1);
+}
+
+// Encode the spans as a blob of varints: per span the zigzag-encoded deltas of y and x0
+// relative to the previous span (starting from zero), then the nonnegative extent x1 - x0.
+// The spans in a SpanSet are sorted by (y, x0), so the deltas are small and typical spans
+// encode in three bytes instead of twelve.
+ndarray::Array<std::uint8_t, 1, 1> encodeSpans(SpanSet const& spanSet) {
+    std::vector<std::uint8_t> buffer;
+    buffer.reserve(3 * spanSet.size());
+    int lastY = 0;
+    int lastX0 = 0;
+    for (auto const& span : spanSet) {
+        appendVarint(zigzagEncode(span.getY() - lastY), buffer);
+        appendVarint(zigzagEncode(span.getX0() - lastX0), buffer);
+        appendVarint(static_cast<std::uint64_t>(span.getX1() - span.getX0()), buffer);
+        lastY = span.getY();
+        lastX0 = span.getX0();
+    }
+    ndarray::Array<std::uint8_t, 1, 1> blob = ndarray::allocate(buffer.size());
+    std::copy(buffer.begin(), buffer.end(), blob.begin());
+    return blob;
+}
+
+// Inverse of encodeSpans; decodes exactly nSpans spans from the blob.
+std::vector<Span> decodeSpans(ndarray::Array<std::uint8_t const, 1, 1> const& blob, int nSpans) {
+    std::vector<Span> result;
+    result.reserve(nSpans);
+    std::uint8_t const* data = blob.getData();
+    std::uint8_t const* const end = data + blob.getSize<0>();
+    int lastY = 0;
+    int lastX0 = 0;
+    for (int i = 0; i < nSpans; ++i) {
+        lastY += zigzagDecode(readVarint(data, end));
+        lastX0 += zigzagDecode(readVarint(data, end));
+        int const extent = static_cast<int>(readVarint(data, end));
+        result.emplace_back(lastY, lastX0, lastX0 + extent);
+    }
+    return result;
+}
+
 std::string getSpanSetPersistenceName() { return "SpanSet"; }
 
 class SpanSetFactory : public table::io::PersistableFactory {
@@ -1004,6 +1175,15 @@ public:
         LSST_ARCHIVE_ASSERT(catalogs.size() == 1u);
         // Get the catalog with the spans
         auto spansCatalog = catalogs.front();
+        auto const& blobKeys = SpanSetBlobPersistenceHelper::get();
+        if (spansCatalog.getSchema() == blobKeys.spanSetSchema) {
+            // Compact format: a single record with all spans delta-encoded in one blob
+            LSST_ARCHIVE_ASSERT(spansCatalog.size() == 1u);
+            auto const& record = spansCatalog.front();
+            return std::make_shared<SpanSet>(
+                    decodeSpans(record.get(blobKeys.spanBlob), record.get(blobKeys.nSpans)));
+        }
+        // One-span-per-record format, written by older versions
         // Retrieve the keys that will be used to reference the catalog
         auto const& keys = SpanSetPersistenceHelper::get();
         // Construct a temporary container which will later be turned into the SpanSet
@@ -1026,15 +1206,11 @@ SpanSetFactory registration(getSpanSetPersistenceName());
 std::string SpanSet::getPersistenceName() const { return getSpanSetPersistenceName(); }
 
 void SpanSet::write(OutputArchiveHandle& handle) const {
-    auto const& keys = SpanSetPersistenceHelper::get();
+    auto const& keys = SpanSetBlobPersistenceHelper::get();
     auto spanCat = handle.makeCatalog(keys.spanSetSchema);
-    spanCat.reserve(size());
-    for (auto const& val : *this) {
-        auto record = spanCat.addNew();
-        record->set(keys.spanY, val.getY());
-        record->set(keys.spanX0, val.getX0());
-        record->set(keys.spanX1, val.getX1());
-    }
+    auto record = spanCat.addNew();
+    record->set(keys.nSpans, static_cast<int>(size()));
+    record->set(keys.spanBlob, encodeSpans(*this));
     handle.saveCatalog(spanCat);
 }
 
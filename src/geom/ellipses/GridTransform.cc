@@ -21,6 +21,9 @@
  * the GNU General Public License along with this program.  If not,
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions.h"
 #include "lsst/afw/geom/ellipses/GridTransform.h"
 #include "lsst/afw/geom/ellipses/Quadrupole.h"
 #include "lsst/afw/geom/ellipses/Separable.h"
@@ -142,6 +145,42 @@ Ellipse::GridTransform::operator lsst::geom::AffineTransform() const {
 lsst::geom::AffineTransform Ellipse::GridTransform::inverted() const {
     return lsst::geom::AffineTransform(_coreGt.inverted(), lsst::geom::Extent2D(_input.getCenter()));
 }
+
+CompiledGridTransform::CompiledGridTransform(BaseCore const& core) : _transform(), _determinant(1.0) {
+    BaseCore::GridTransform const gt(core);  // one eigendecomposition, then cached
+    _transform = lsst::geom::AffineTransform(lsst::geom::LinearTransform(gt.getMatrix()));
+    _determinant = gt.getDeterminant();
+}
+
+CompiledGridTransform::CompiledGridTransform(Ellipse const& ellipse) : _transform(), _determinant(1.0) {
+    Ellipse::GridTransform const gt(ellipse);  // one eigendecomposition, then cached
+    _transform = gt;
+    _determinant = gt.getDeterminant();
+}
+
+std::pair<ndarray::Array<double, 1, 1>, ndarray::Array<double, 1, 1>> CompiledGridTransform::operator()(
+        ndarray::Array<double const, 1> const& x, ndarray::Array<double const, 1> const& y) const {
+    std::size_t const num = x.getSize<0>();
+    if (y.getSize<0>() != num) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("x and y have different lengths: %d vs %d") % num % y.getSize<0>())
+                                  .str());
+    }
+    ndarray::Array<double, 1, 1> outX = ndarray::allocate(num);
+    ndarray::Array<double, 1, 1> outY = ndarray::allocate(num);
+    // Hoist the matrix coefficients so the loop is pure arithmetic
+    double const xx = _transform[lsst::geom::AffineTransform::XX];
+    double const xy = _transform[lsst::geom::AffineTransform::XY];
+    double const yx = _transform[lsst::geom::AffineTransform::YX];
+    double const yy = _transform[lsst::geom::AffineTransform::YY];
+    double const tx = _transform[lsst::geom::AffineTransform::X];
+    double const ty = _transform[lsst::geom::AffineTransform::Y];
+    for (std::size_t i = 0; i < num; ++i) {
+        outX[i] = xx * x[i] + xy * y[i] + tx;
+        outY[i] = yx * x[i] + yy * y[i] + ty;
+    }
+    return std::make_pair(outX, outY);
+}
 }  // namespace ellipses
 }  // namespace geom
 }  // namespace afw
@@ -24,6 +24,7 @@
 #include <cmath>
 #include <limits>
 #include "boost/optional.hpp"
+#include "lsst/afw/geom/SpanSet.h"
 #include "lsst/afw/geom/ellipses/PixelRegion.h"
 #include "lsst/afw/geom/ellipses/Quadrupole.h"
 
@@ -78,17 +79,48 @@ public:
         }
     }
 
-    boost::optional<std::pair<double, double>> xAt(double y) const {
-        double yc = y - _center.getY();
-        double xc = _p*yc + _center.getX();
-        double s = _r - _t*yc*yc;
-        if (s < 0) {
-            return boost::none;
-        } else {
-            double d = std::sqrt(s);
-            return std::make_pair(xc - d, xc + d);
+    //
+    // Scans successive integer rows, updating the quadratic solution
+    // incrementally: for a unit step in y the center term xc advances by
+    // exactly p, and the discriminant s = r - t yc^2 decreases by t (2 yc + 1).
+    //
+    class Scanner {
+    public:
+        Scanner(EllipseHorizontalLineIntersection const& parent, double y) :
+            _p(parent._p),
+            _t(parent._t),
+            _yc(y - parent._center.getY()),
+            _xc(_p*_yc + parent._center.getX()),
+            _s(parent._r - _t*_yc*_yc)
+        {}
+
+        /// Boundary points of the ellipse in x at the current row, if any.
+        boost::optional<std::pair<double, double>> intersection() const {
+            if (_s < 0) {
+                return boost::none;
+            } else {
+                double d = std::sqrt(_s);
+                return std::make_pair(_xc - d, _xc + d);
+            }
         }
-    }
+
+        /// Advance to the next row.
+        void advance() {
+            _s -= _t*(2*_yc + 1);
+            _yc += 1;
+            _xc += _p;
+        }
+
+    private:
+        double _p;
+        double _t;
+        double _yc;
+        double _xc;
+        double _s;
+    };
+
+    /// Return a Scanner positioned at row y.
+    Scanner scanAt(double y) const { return Scanner(*this, y); }
 
 private:
     lsst::geom::Point2D _center;
@@ -114,10 +146,13 @@ PixelRegion::PixelRegion(Ellipse const& ellipse)
     EllipseHorizontalLineIntersection intersection(ellipse);
 
     // Iterate over pixel rows in the bounding box, computing the intersection
-    // of the ellipse with that y coordinate.
+    // of the ellipse with that y coordinate incrementally from row to row.
+    int const yBegin = envelope.getBeginY();
     int const yEnd = envelope.getEndY();
-    for (int y = envelope.getBeginY(); y != yEnd; ++y) {
-        auto x = intersection.xAt(y);
+    _spans.reserve(yEnd - yBegin);
+    auto scanner = intersection.scanAt(yBegin);
+    for (int y = yBegin; y != yEnd; ++y, scanner.advance()) {
+        auto x = scanner.intersection();
         if (x) {
             int xMin = std::ceil(x->first);
             int xMax = std::floor(x->second);
@@ -129,6 +164,15 @@ PixelRegion::PixelRegion(Ellipse const& ellipse)
     }
 }
 
+std::shared_ptr<SpanSet> PixelRegion::getSpans() const& {
+    // The spans are sorted and disjoint by construction, so skip normalization.
+    return std::make_shared<SpanSet>(_spans, false);
+}
+
+std::shared_ptr<SpanSet> PixelRegion::getSpans() && {
+    return std::make_shared<SpanSet>(std::move(_spans), false);
+}
+
 Span const PixelRegion::getSpanAt(int y) const {
     if (_bbox.isEmpty()) {
         throw LSST_EXCEPT(
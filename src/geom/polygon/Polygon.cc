@@ -132,14 +132,55 @@ double pixelOverlap(BoostPolygon const& poly, int const x, int const y) {
     return area;
 }
 
-/// @internal Set each pixel in a row to the amount of overlap with polygon
-void pixelRowOverlap(std::shared_ptr<lsst::afw::image::Image<float>> const image, BoostPolygon const& poly,
-                     int const xStart, int const xStop, int const y) {
-    int x = xStart;
-    for (lsst::afw::image::Image<float>::x_iterator i = image->x_at(x - image->getX0(), y - image->getY0());
-         x <= xStop; ++i, ++x) {
-        *i = pixelOverlap(poly, x, y);
+/// @internal One polygon edge, in a form convenient for scanline traversal
+struct Edge {
+    double x0, y0;    // first vertex
+    double x1, y1;    // second vertex
+    double yLo, yHi;  // y range (yLo <= yHi)
+    double slopeInv;  // dx/dy; 0 for horizontal edges
+
+    Edge(LsstPoint const& p, LsstPoint const& q)
+            : x0(p.getX()),
+              y0(p.getY()),
+              x1(q.getX()),
+              y1(q.getY()),
+              yLo(std::min(y0, y1)),
+              yHi(std::max(y0, y1)),
+              slopeInv(y0 == y1 ? 0.0 : (x1 - x0) / (y1 - y0)) {}
+
+    /// @internal x at height y; only valid for non-horizontal edges with yLo <= y <= yHi
+    double xAt(double const y) const { return x0 + (y - y0) * slopeInv; }
+
+    /// @internal Does a horizontal ray extending rightwards from (x, y) cross this edge?
+    ///
+    /// Uses the half-open rule [yLo, yHi) so a vertex shared by two edges is counted once.
+    bool crossedBy(double const x, double const y) const {
+        return (y0 <= y) != (y1 <= y) && x < xAt(y);
     }
+};
+
+/// @internal Convert a polygon's outer ring to an edge table
+std::vector<Edge> makeEdgeTable(BoostPolygon const& poly) {
+    LsstRing const& ring = poly.outer();  // closed: first and last vertex are identical
+    std::vector<Edge> edges;
+    if (ring.size() > 1) {
+        edges.reserve(ring.size() - 1);
+        for (std::size_t i = 0; i + 1 < ring.size(); ++i) {
+            edges.emplace_back(ring[i], ring[i + 1]);
+        }
+    }
+    return edges;
+}
+
+/// @internal Even-odd containment test against an edge table
+bool edgeTableContains(std::vector<Edge> const& edges, double const x, double const y) {
+    bool inside = false;
+    for (Edge const& edge : edges) {
+        if (edge.crossedBy(x, y)) {
+            inside = !inside;
+        }
+    }
+    return inside;
 }
 
 }  // anonymous namespace
@@ -351,6 +392,27 @@ std::size_t Polygon::hash_value() const noexcept {
 
 bool Polygon::contains(LsstPoint const& point) const { return boost::geometry::within(point, _impl->poly); }
 
+template <typename T>
+ndarray::Array<bool, 1, 1> Polygon::contains(ndarray::Array<T const, 1> const& x,
+                                             ndarray::Array<T const, 1> const& y) const {
+    std::size_t const num = x.template getSize<0>();
+    if (y.template getSize<0>() != num) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("x and y have different lengths: %d vs %d") % num %
+                           y.template getSize<0>())
+                                  .str());
+    }
+    std::vector<Edge> const edges = makeEdgeTable(_impl->poly);
+    Box const bounds = getBBox();
+    ndarray::Array<bool, 1, 1> result = ndarray::allocate(num);
+    for (std::size_t i = 0; i < num; ++i) {
+        double const px = x[i], py = y[i];
+        // The bounding-box check rejects most outside points without touching the edge table
+        result[i] = bounds.contains(LsstPoint(px, py)) && edgeTableContains(edges, px, py);
+    }
+    return result;
+}
+
 bool Polygon::overlaps(Polygon const& other) const { return _impl->overlaps(other._impl->poly); }
 
 bool Polygon::overlaps(Box const& box) const { return _impl->overlaps(box); }
@@ -450,72 +512,83 @@ std::shared_ptr<afw::image::Image<float>> Polygon::createImage(lsst::geom::Box2I
     int xMax = std::min(static_cast<int>(::ceil(bounds.getMaxX())), bbox.getMaxX());
     int yMin = std::max(static_cast<int>(bounds.getMinY()), bbox.getMinY());
     int yMax = std::min(static_cast<int>(::ceil(bounds.getMaxY())), bbox.getMaxY());
+    if (xMax < xMin || yMax < yMin) {
+        return image;
+    }
+
+    // Scanline rasterization: sort the edges by minimum y and maintain a table of the
+    // edges active in the current pixel row. Only the pixels an active edge actually
+    // passes through are on the boundary and need exact (Boost.Geometry) area weights;
+    // every other pixel is entirely inside or outside the polygon, decided by the
+    // parity of edge crossings of the line through the pixel centers.
+    std::vector<Edge> edges = makeEdgeTable(_impl->poly);
+    std::sort(edges.begin(), edges.end(), [](Edge const& a, Edge const& b) { return a.yLo < b.yLo; });
+    std::vector<Edge const*> active;  // edges intersecting the current pixel row
+    std::size_t nextEdge = 0;
+
+    std::vector<double> crossings;    // x of edge crossings of the pixel-center line
+    std::vector<char> isBoundary(xMax - xMin + 1);
     for (int y = yMin; y <= yMax; ++y) {
-        double const yPixelMin = (double)y - 0.5, yPixelMax = (double)y + 0.5;
-        BoostPolygon row;  // A polygon of row y
-        boost::geometry::assign(
-                row, LsstBox(lsst::geom::Point2D(xMin, yPixelMin), lsst::geom::Point2D(xMax, yPixelMax)));
-        std::vector<BoostPolygon> intersections;
-        boost::geometry::intersection(_impl->poly, row, intersections);
-
-        if (intersections.size() == 1 && boost::geometry::num_points(intersections[0]) == 5) {
-            // This row is fairly tame, and should have a long run of pixels within the polygon
-            BoostPolygon const& row = intersections[0];
-            std::vector<double> top, bottom;
-            top.reserve(2);
-            bottom.reserve(2);
-            bool failed = false;
-            for (std::vector<Point>::const_iterator i = row.outer().begin(); i != row.outer().end() - 1;
-                 ++i) {
-                double const xCoord = i->getX(), yCoord = i->getY();
-                if (yCoord == yPixelMin) {
-                    bottom.push_back(xCoord);
-                } else if (yCoord == yPixelMax) {
-                    top.push_back(xCoord);
-                } else {
-                    failed = true;
-                    break;
+        double const yPixelMin = y - 0.5, yPixelMax = y + 0.5;
+        while (nextEdge < edges.size() && edges[nextEdge].yLo < yPixelMax) {
+            active.push_back(&edges[nextEdge]);
+            ++nextEdge;
+        }
+        active.erase(std::remove_if(active.begin(), active.end(),
+                                    [yPixelMin](Edge const* edge) { return edge->yHi <= yPixelMin; }),
+                     active.end());
+
+        crossings.clear();
+        std::fill(isBoundary.begin(), isBoundary.end(), 0);
+        for (Edge const* edge : active) {
+            double exMin, exMax;  // x range occupied by the edge within this row
+            if (edge->yLo == edge->yHi) {
+                exMin = std::min(edge->x0, edge->x1);
+                exMax = std::max(edge->x0, edge->x1);
+            } else {
+                double const xa = edge->xAt(std::max(edge->yLo, yPixelMin));
+                double const xb = edge->xAt(std::min(edge->yHi, yPixelMax));
+                exMin = std::min(xa, xb);
+                exMax = std::max(xa, xb);
+                if ((edge->y0 <= y) != (edge->y1 <= y)) {
+                    crossings.push_back(edge->xAt(y));
                 }
             }
-            if (!failed && top.size() == 2 && bottom.size() == 2) {
-                std::sort(top.begin(), top.end());
-                std::sort(bottom.begin(), bottom.end());
-                int const xMin = std::min(top[0], bottom[0]);
-                int const xStart = ::ceil(std::max(top[0], bottom[0])) + 1;
-                int const xStop = std::min(top[1], bottom[1]) - 1;
-                int const xMax = ::ceil(std::max(top[1], bottom[1]));
-                pixelRowOverlap(image, _impl->poly, std::max(xMin, bbox.getMinX()),
-                                std::min(xStart, bbox.getMaxX()), y);
-                int x = xStart;
-                for (Image::x_iterator i = image->x_at(std::max(xStart, bbox.getMinX()) - image->getX0(),
-                                                       y - image->getY0());
-                     x <= std::min(xStop, bbox.getMaxX()); ++i, ++x) {
-                    *i = 1.0;
-                }
-                pixelRowOverlap(image, _impl->poly, std::max(xStop, bbox.getMinX()),
-                                std::min(xMax, bbox.getMaxX()), y);
-                continue;
+            int const colMin = std::max(static_cast<int>(::ceil(exMin - 0.5)), xMin);
+            int const colMax = std::min(static_cast<int>(::floor(exMax + 0.5)), xMax);
+            for (int col = colMin; col <= colMax; ++col) {
+                isBoundary[col - xMin] = 1;
             }
         }
-
-        // Last resort: do each pixel independently...
-        for (std::vector<BoostPolygon>::const_iterator p = intersections.begin(); p != intersections.end();
-             ++p) {
-            double xMinRow = xMax, xMaxRow = xMin;
-            std::vector<LsstPoint> const vertices = p->outer();
-            for (std::vector<LsstPoint>::const_iterator q = vertices.begin(); q != vertices.end(); ++q) {
-                double const x = q->getX();
-                if (x < xMinRow) xMinRow = x;
-                if (x > xMaxRow) xMaxRow = x;
+        std::sort(crossings.begin(), crossings.end());
+
+        // A crossing of the center line can only occur in a boundary pixel, so the
+        // parity is constant over each run of interior/exterior pixels.
+        std::size_t crossed = 0;  // number of crossings at or left of the current pixel center
+        Image::x_iterator pix = image->x_at(xMin - image->getX0(), y - image->getY0());
+        for (int x = xMin; x <= xMax; ++x, ++pix) {
+            while (crossed < crossings.size() && crossings[crossed] <= x) {
+                ++crossed;
+            }
+            if (isBoundary[x - xMin]) {
+                *pix = pixelOverlap(_impl->poly, x, y);
+            } else if ((crossings.size() - crossed) % 2 == 1) {
+                *pix = 1.0;
             }
-
-            pixelRowOverlap(image, _impl->poly, std::max(static_cast<int>(xMinRow), bbox.getMinX()),
-                            std::min(static_cast<int>(::ceil(xMaxRow)), bbox.getMaxX()), y);
         }
     }
     return image;
 }
 
+/// @cond
+template ndarray::Array<bool, 1, 1> Polygon::contains(ndarray::Array<double const, 1> const&,
+                                                      ndarray::Array<double const, 1> const&) const;
+template ndarray::Array<bool, 1, 1> Polygon::contains(ndarray::Array<float const, 1> const&,
+                                                      ndarray::Array<float const, 1> const&) const;
+template ndarray::Array<bool, 1, 1> Polygon::contains(ndarray::Array<int const, 1> const&,
+                                                      ndarray::Array<int const, 1> const&) const;
+/// @endcond
+
 // -------------- Table-based Persistence -------------------------------------------------------------------
 
 /*
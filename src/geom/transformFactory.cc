@@ -21,6 +21,7 @@
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include <algorithm>
 #include <sstream>
 #include <cmath>
 
@@ -215,6 +216,82 @@ std::shared_ptr<TransformPoint2ToPoint2> makeIdentityTransform() {
     return std::make_shared<TransformPoint2ToPoint2>(ast::UnitMap(2));
 }
 
+TiledAffineApproximation makeTiledAffineApproximation(TransformPoint2ToPoint2 const &original,
+                                                      lsst::geom::Box2D const &bbox, double tolerance) {
+    if (bbox.isEmpty()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "Cannot approximate a transform over an empty box");
+    }
+    if (!(tolerance > 0)) {
+        std::ostringstream buffer;
+        buffer << "Tolerance must be positive, got " << tolerance;
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, buffer.str());
+    }
+    double const x0 = bbox.getMinX();
+    double const y0 = bbox.getMinY();
+    int constexpr maxTilesPerAxis = 1024;
+    for (int n = 1; n <= maxTilesPerAxis; n *= 2) {
+        double const tileWidth = bbox.getWidth() / n;
+        double const tileHeight = bbox.getHeight() / n;
+        std::vector<lsst::geom::AffineTransform> tiles;
+        tiles.reserve(static_cast<std::size_t>(n) * n);
+        // A 3x3 grid of sample points per tile (corners, edge midpoints, center), at which
+        // the approximation is compared against the original transform.
+        std::vector<lsst::geom::Point2D> samples;
+        samples.reserve(tiles.capacity() * 9);
+        for (int iy = 0; iy < n; ++iy) {
+            for (int ix = 0; ix < n; ++ix) {
+                lsst::geom::Point2D const center(x0 + (ix + 0.5) * tileWidth,
+                                                 y0 + (iy + 0.5) * tileHeight);
+                tiles.push_back(linearizeTransform(original, center));
+                for (int j = 0; j < 3; ++j) {
+                    for (int i = 0; i < 3; ++i) {
+                        samples.emplace_back(x0 + (ix + 0.5 * i) * tileWidth,
+                                             y0 + (iy + 0.5 * j) * tileHeight);
+                    }
+                }
+            }
+        }
+        // One batched AST call for all sample points of this refinement level.
+        auto const exact = original.applyForward(samples);
+        double maxError = 0;
+        for (std::size_t k = 0; k < samples.size(); ++k) {
+            auto const approx = tiles[k / 9](samples[k]);
+            maxError = std::max(maxError, (approx - exact[k]).computeNorm());
+        }
+        if (maxError <= tolerance) {
+            return TiledAffineApproximation(bbox, tolerance, n, n, std::move(tiles));
+        }
+    }
+    std::ostringstream buffer;
+    buffer << "Transform cannot be approximated to within " << tolerance << " over " << bbox << " with "
+           << maxTilesPerAxis << "x" << maxTilesPerAxis << " tiles";
+    throw LSST_EXCEPT(pex::exceptions::RuntimeError, buffer.str());
+}
+
+lsst::geom::Point2D TiledAffineApproximation::applyForward(lsst::geom::Point2D const &point) const {
+    if (point.getX() < _bbox.getMinX() || point.getX() > _bbox.getMaxX() ||
+        point.getY() < _bbox.getMinY() || point.getY() > _bbox.getMaxY()) {
+        std::ostringstream buffer;
+        buffer << "Point " << point << " is outside the approximated region " << _bbox;
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, buffer.str());
+    }
+    // Points exactly on the upper edges land in the last tile.
+    int const ix = std::min(static_cast<int>((point.getX() - _bbox.getMinX()) / _tileWidth), _nx - 1);
+    int const iy = std::min(static_cast<int>((point.getY() - _bbox.getMinY()) / _tileHeight), _ny - 1);
+    return _tiles[static_cast<std::size_t>(iy) * _nx + ix](point);
+}
+
+std::vector<lsst::geom::Point2D> TiledAffineApproximation::applyForward(
+        std::vector<lsst::geom::Point2D> const &points) const {
+    std::vector<lsst::geom::Point2D> result;
+    result.reserve(points.size());
+    for (auto const &point : points) {
+        result.push_back(applyForward(point));
+    }
+    return result;
+}
+
 }  // namespace geom
 }  // namespace afw
 }  // namespace lsst
@@ -135,6 +135,33 @@ void ApCorrMap::write(OutputArchiveHandle& handle) const {
     handle.saveCatalog(catalog);
 }
 
+ndarray::Array<double, 2, 2> ApCorrMap::evaluateAll(ndarray::Array<double const, 1> const& x,
+                                                    ndarray::Array<double const, 1> const& y) const {
+    if (x.getSize<0>() != y.getSize<0>()) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Size mismatch between x and y arrays: %d vs %d") % x.getSize<0>() %
+                           y.getSize<0>())
+                                  .str());
+    }
+    ndarray::Array<double, 2, 2> result = ndarray::allocate(x.getSize<0>(), _internal.size());
+    // Group columns by the BoundedField that fills them, so a surface shared between several
+    // fields is evaluated only once.
+    std::map<std::shared_ptr<math::BoundedField>, std::vector<std::size_t>> groups;
+    std::size_t col = 0;
+    for (Iterator i = begin(); i != end(); ++i, ++col) {
+        groups[i->second].push_back(col);
+    }
+    for (auto const& group : groups) {
+        ndarray::Array<double, 1, 1> const values = group.first->evaluate(x, y);
+        for (std::size_t c : group.second) {
+            for (std::size_t row = 0; row != x.getSize<0>(); ++row) {
+                result[row][c] = values[row];
+            }
+        }
+    }
+    return result;
+}
+
 ApCorrMap& ApCorrMap::operator*=(double const scale) {
     Internal replacement;
     for (Iterator i = begin(); i != end(); ++i) {
@@ -24,7 +24,9 @@
  * An Image with associated metadata
  */
 #include <cstdint>
+#include <exception>
 #include <iostream>
+#include <thread>
 
 #include "boost/format.hpp"
 #include "boost/mpl/vector.hpp"
@@ -38,6 +40,7 @@
 
 #include "lsst/pex/exceptions.h"
 #include "lsst/afw/fits.h"
+#include "lsst/afw/geom/wcsUtils.h"
 #include "lsst/afw/image/Image.h"
 
 namespace lsst {
@@ -103,6 +106,49 @@ DecoratedImage<PixelT>::DecoratedImage(const std::string& fileName, const int hd
             new Image<PixelT>(fileName, hdu, getMetadata(), bbox, origin, allowUnsafe));
 }
 
+template <typename PixelT>
+DecoratedImage<PixelT> DecoratedImage<PixelT>::readFitsOverlapped(std::string const& fileName, const int hdu,
+                                                                  lsst::geom::Box2I const& bbox,
+                                                                  ImageOrigin const origin,
+                                                                  bool allowUnsafe) {
+    std::shared_ptr<daf::base::PropertySet> metadata;
+    std::exception_ptr headerError;
+    // The header parse gets its own thread and its own cfitsio handle; it blocks on I/O,
+    // so it is kept off the shared compute pool (as ExposurePrefetcher's readers are).
+    std::thread headerThread([&fileName, hdu, &metadata, &headerError] {
+        try {
+            metadata = fits::readMetadata(fileName, hdu, /*strip=*/true);
+            // the xy0 WCS is stripped just as ImageBaseFitsReader::readMetadata does
+            afw::geom::getImageXY0FromMetadata(*metadata, detail::wcsNameForXY0, /*strip=*/true);
+        } catch (...) {
+            headerError = std::current_exception();
+        }
+    });
+    std::shared_ptr<Image<PixelT>> image;
+    try {
+        image = std::make_shared<Image<PixelT>>(fileName, hdu, nullptr, bbox, origin, allowUnsafe);
+    } catch (...) {
+        headerThread.join();
+        throw;
+    }
+    headerThread.join();
+    if (headerError) {
+        std::rethrow_exception(headerError);
+    }
+    DecoratedImage<PixelT> result(image);
+    result.setMetadata(metadata);
+    return result;
+}
+
+template <typename PixelT>
+std::shared_ptr<daf::base::PropertySet> DecoratedImage<PixelT>::readMetadata(std::string const& fileName,
+                                                                             const int hdu) {
+    // strip the same keys the FITS file constructor does (see ImageBaseFitsReader::readMetadata)
+    auto metadata = fits::readMetadata(fileName, hdu, /*strip=*/true);
+    afw::geom::getImageXY0FromMetadata(*metadata, detail::wcsNameForXY0, /*strip=*/true);
+    return metadata;
+}
+
 template <typename PixelT>
 void DecoratedImage<PixelT>::writeFits(std::string const& fileName,
                                        std::shared_ptr<daf::base::PropertySet const> metadata,
@@ -22,11 +22,19 @@
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include <cstring>
+#include <fstream>
+#include <future>
 #include <memory>
 #include <stdexcept>
 #include <sstream>
 #include <cstdint>
 
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
 #include "boost/format.hpp"
 #include "boost/algorithm/string/trim.hpp"
 
@@ -184,6 +192,205 @@ void Exposure<ImageT, MaskT, VarianceT>::writeFits(fits::Fits &fitsfile,
     _info->_finishWriteFits(fitsfile, data);
 }
 
+template <typename ImageT, typename MaskT, typename VarianceT>
+std::future<void> Exposure<ImageT, MaskT, VarianceT>::writeFitsAsync(std::string const &fileName) const {
+    return writeFitsAsync(fileName, fits::ImageWriteOptions(*_maskedImage.getImage()),
+                          fits::ImageWriteOptions(*_maskedImage.getMask()),
+                          fits::ImageWriteOptions(*_maskedImage.getVariance()));
+}
+
+template <typename ImageT, typename MaskT, typename VarianceT>
+std::future<void> Exposure<ImageT, MaskT, VarianceT>::writeFitsAsync(
+        std::string const &fileName, fits::ImageWriteOptions const &imageOptions,
+        fits::ImageWriteOptions const &maskOptions, fits::ImageWriteOptions const &varianceOptions) const {
+    // A shallow copy shares the pixels but gives the background thread its own
+    // ExposureInfo, so replacing planes or components on this object cannot
+    // race with serialization.
+    Exposure snapshot(*this);
+    return std::async(std::launch::async,
+                      [ snapshot = std::move(snapshot), fileName, imageOptions, maskOptions,
+                        varianceOptions ] { snapshot.writeFits(fileName, imageOptions, maskOptions,
+                                                               varianceOptions); });
+}
+
+// Snapshot I/O
+
+namespace {
+
+/*
+ * On-disk layout of a binary Exposure snapshot: this fixed-size header,
+ * followed by the raw native-endian pixel planes at page-aligned offsets and
+ * the ExposureInfo serialized (via the usual archive machinery) as an
+ * embedded in-memory FITS blob.  Plane sizes follow from the dimensions and
+ * the BITPIX codes, which are recorded to catch pixel-type mismatches.
+ */
+struct SnapshotHeader {
+    char magic[8];
+    std::uint32_t version;
+    std::int32_t imageBitpix;
+    std::int32_t maskBitpix;
+    std::int32_t varianceBitpix;
+    std::int32_t x0;
+    std::int32_t y0;
+    std::int32_t width;
+    std::int32_t height;
+    std::uint64_t imageOffset;
+    std::uint64_t maskOffset;
+    std::uint64_t varianceOffset;
+    std::uint64_t infoOffset;
+    std::uint64_t infoSize;
+};
+
+constexpr char SNAPSHOT_MAGIC[8] = {'A', 'F', 'W', 'S', 'N', 'A', 'P', '1'};
+constexpr std::size_t SNAPSHOT_ALIGNMENT = 4096;  // page alignment, so planes can be mapped directly
+
+std::size_t alignSnapshotOffset(std::size_t offset) {
+    return (offset + SNAPSHOT_ALIGNMENT - 1) / SNAPSHOT_ALIGNMENT * SNAPSHOT_ALIGNMENT;
+}
+
+void writeSnapshotBlock(std::ofstream &file, std::size_t offset, void const *data, std::size_t size,
+                        std::string const &fileName) {
+    file.seekp(offset);  // seeking past the end zero-fills the gap
+    file.write(reinterpret_cast<char const *>(data), size);
+    if (!file) {
+        throw LSST_EXCEPT(pex::exceptions::IoError,
+                          (boost::format("Error writing Exposure snapshot to '%s'") % fileName).str());
+    }
+}
+
+// RAII copy-on-write mapping of a snapshot file; the planes of a restored
+// Exposure reference the mapping for as long as they live.
+struct SnapshotMapping {
+    explicit SnapshotMapping(std::string const &fileName) : data(MAP_FAILED), size(0) {
+        int fd = ::open(fileName.c_str(), O_RDONLY);
+        if (fd < 0) {
+            throw LSST_EXCEPT(pex::exceptions::IoError,
+                              (boost::format("Could not open Exposure snapshot '%s'") % fileName).str());
+        }
+        struct ::stat status;
+        if (::fstat(fd, &status) == 0) {
+            size = status.st_size;
+            // MAP_PRIVATE gives copy-on-write pages: modifying the restored
+            // planes never touches the file.
+            data = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+        }
+        ::close(fd);
+        if (data == MAP_FAILED) {
+            throw LSST_EXCEPT(pex::exceptions::IoError,
+                              (boost::format("Could not map Exposure snapshot '%s'") % fileName).str());
+        }
+    }
+
+    SnapshotMapping(SnapshotMapping const &) = delete;
+    SnapshotMapping &operator=(SnapshotMapping const &) = delete;
+
+    ~SnapshotMapping() {
+        if (data != MAP_FAILED) {
+            ::munmap(data, size);
+        }
+    }
+
+    void *data;
+    std::size_t size;
+};
+
+}  // namespace
+
+template <typename ImageT, typename MaskT, typename VarianceT>
+void Exposure<ImageT, MaskT, VarianceT>::writeSnapshot(std::string const &fileName) const {
+    auto const image = fits::makeContiguousArray(_maskedImage.getImage()->getArray());
+    auto const mask = fits::makeContiguousArray(_maskedImage.getMask()->getArray());
+    auto const variance = fits::makeContiguousArray(_maskedImage.getVariance()->getArray());
+
+    // Serialize the ExposureInfo (and nothing else) into an in-memory blob
+    // by writing an Exposure with empty planes; this reuses the archive
+    // machinery for every attached component without the cost of pushing
+    // the pixels through FITS.
+    fits::MemFileManager manager;
+    {
+        MaskedImageT blank;
+        Exposure info(blank, _info);
+        info.writeFits(manager);
+    }
+
+    auto const bbox = getBBox();
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+    header.version = 1;
+    header.imageBitpix = fits::getBitPix<ImageT>();
+    header.maskBitpix = fits::getBitPix<MaskT>();
+    header.varianceBitpix = fits::getBitPix<VarianceT>();
+    header.x0 = bbox.getMinX();
+    header.y0 = bbox.getMinY();
+    header.width = bbox.getWidth();
+    header.height = bbox.getHeight();
+    std::size_t const imageBytes = image.getNumElements() * sizeof(ImageT);
+    std::size_t const maskBytes = mask.getNumElements() * sizeof(MaskT);
+    std::size_t const varianceBytes = variance.getNumElements() * sizeof(VarianceT);
+    header.imageOffset = alignSnapshotOffset(sizeof(header));
+    header.maskOffset = alignSnapshotOffset(header.imageOffset + imageBytes);
+    header.varianceOffset = alignSnapshotOffset(header.maskOffset + maskBytes);
+    header.infoOffset = alignSnapshotOffset(header.varianceOffset + varianceBytes);
+    header.infoSize = manager.getLength();
+
+    std::ofstream file(fileName, std::ios::binary | std::ios::trunc);
+    if (!file) {
+        throw LSST_EXCEPT(pex::exceptions::IoError,
+                          (boost::format("Could not open '%s' for writing") % fileName).str());
+    }
+    writeSnapshotBlock(file, 0, &header, sizeof(header), fileName);
+    writeSnapshotBlock(file, header.imageOffset, image.getData(), imageBytes, fileName);
+    writeSnapshotBlock(file, header.maskOffset, mask.getData(), maskBytes, fileName);
+    writeSnapshotBlock(file, header.varianceOffset, variance.getData(), varianceBytes, fileName);
+    writeSnapshotBlock(file, header.infoOffset, manager.getData(), header.infoSize, fileName);
+}
+
+template <typename ImageT, typename MaskT, typename VarianceT>
+Exposure<ImageT, MaskT, VarianceT> Exposure<ImageT, MaskT, VarianceT>::readSnapshot(
+        std::string const &fileName) {
+    auto mapping = std::make_shared<SnapshotMapping>(fileName);
+    SnapshotHeader header;
+    if (mapping->size < sizeof(header)) {
+        throw LSST_EXCEPT(pex::exceptions::IoError,
+                          (boost::format("'%s' is not an Exposure snapshot") % fileName).str());
+    }
+    std::memcpy(&header, mapping->data, sizeof(header));
+    if (std::memcmp(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic)) != 0 || header.version != 1 ||
+        header.infoOffset + header.infoSize > mapping->size) {
+        throw LSST_EXCEPT(pex::exceptions::IoError,
+                          (boost::format("'%s' is not an Exposure snapshot") % fileName).str());
+    }
+    if (header.imageBitpix != fits::getBitPix<ImageT>() || header.maskBitpix != fits::getBitPix<MaskT>() ||
+        header.varianceBitpix != fits::getBitPix<VarianceT>()) {
+        throw LSST_EXCEPT(
+                pex::exceptions::InvalidParameterError,
+                (boost::format("Exposure snapshot '%s' was written with different pixel types") % fileName)
+                        .str());
+    }
+
+    // The info blob is copied into a MemFileManager of its own because
+    // cfitsio may modify (and wants to be able to grow) its buffer.
+    fits::MemFileManager manager(header.infoSize);
+    char *const base = static_cast<char *>(mapping->data);
+    std::memcpy(manager.getData(), base + header.infoOffset, header.infoSize);
+    Exposure info(manager);
+
+    auto const xy0 = lsst::geom::Point2I(header.x0, header.y0);
+    auto const shape = ndarray::makeVector(static_cast<int>(header.height), static_cast<int>(header.width));
+    auto const strides = ndarray::makeVector(static_cast<int>(header.width), 1);
+    ndarray::Array<ImageT, 2, 1> imageArray = ndarray::external(
+            reinterpret_cast<ImageT *>(base + header.imageOffset), shape, strides, mapping);
+    ndarray::Array<MaskT, 2, 1> maskArray =
+            ndarray::external(reinterpret_cast<MaskT *>(base + header.maskOffset), shape, strides, mapping);
+    ndarray::Array<VarianceT, 2, 1> varianceArray = ndarray::external(
+            reinterpret_cast<VarianceT *>(base + header.varianceOffset), shape, strides, mapping);
+    auto imagePlane = std::make_shared<Image<ImageT>>(imageArray, false, xy0);
+    auto maskPlane = std::make_shared<Mask<MaskT>>(maskArray, false, xy0);
+    auto variancePlane = std::make_shared<Image<VarianceT>>(varianceArray, false, xy0);
+    MaskedImageT maskedImage(imagePlane, maskPlane, variancePlane);
+    return Exposure(maskedImage, info.getInfo());
+}
+
 namespace {
 /**
  * Copy all overlapping pixels from one Exposure to another.
@@ -19,9 +19,11 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
 #include <map>
 #include <regex>
 #include <set>
+#include <vector>
 
 #include "lsst/log/Log.h"
 
@@ -432,6 +434,43 @@ public:
      * @return a map from string IDs to components, or an empty map if the
      *         file could not be read.
      */
+    /**
+     * Return the names of all components available from this archive, using
+     * ExposureInfo's component naming convention.
+     */
+    std::vector<std::string> getComponentNames() const {
+        std::vector<std::string> result;
+        for (int c = 0; c != N_ARCHIVE_COMPONENTS; ++c) {
+            if (_ids[c] != 0) {
+                result.push_back(getComponentName(static_cast<Component>(c)));
+            }
+        }
+        for (auto const& keyValue : _genericIds) {
+            if (std::find(result.begin(), result.end(), keyValue.first) == result.end()) {
+                result.push_back(keyValue.first);
+            }
+        }
+        return result;
+    }
+
+    /// Return the ExposureInfo component name corresponding to a known component.
+    static std::string const& getComponentName(Component c) {
+        static std::array<std::string, N_ARCHIVE_COMPONENTS> const names = {
+                ExposureInfo::KEY_PSF.getId(),           ExposureInfo::KEY_WCS.getId(),
+                ExposureInfo::KEY_COADD_INPUTS.getId(),  ExposureInfo::KEY_AP_CORR_MAP.getId(),
+                ExposureInfo::KEY_VALID_POLYGON.getId(), ExposureInfo::KEY_TRANSMISSION_CURVE.getId(),
+                ExposureInfo::KEY_DETECTOR.getId(),      ExposureInfo::KEY_PHOTO_CALIB.getId()};
+        return names[c];
+    }
+
+    /**
+     * Read the archive catalogs into memory, if the archive is present.
+     *
+     * After this returns, readComponent and readExtraComponents may be
+     * called with a null fitsFile.
+     */
+    bool ensureLoaded(afw::fits::Fits* fitsFile) { return _ensureLoaded(fitsFile); }
+
     std::map<std::string, std::shared_ptr<table::io::Persistable>> readExtraComponents(
             afw::fits::Fits* fitsFile) {
         std::map<std::string, std::shared_ptr<table::io::Persistable>> result;
@@ -460,7 +499,11 @@ private:
         }
         if (_state == ArchiveState::PRESENT) {
             afw::fits::HduMoveGuard guard(*fitsFile, _hdu);
-            _archive = table::io::InputArchive::readFits(*fitsFile);
+            // Use the shared read so that the many near-identical archives
+            // produced by a full-focal-plane write (camera transforms,
+            // transmission curves, etc.) are deserialized only once per
+            // process; see InputArchive::readFitsShared.
+            _archive = table::io::InputArchive::readFitsShared(*fitsFile);
             _state = ArchiveState::LOADED;
         }
         assert(_state == ArchiveState::LOADED);  // constructor body should guarantee it's not UNKNOWN
@@ -477,6 +520,109 @@ private:
     std::set<std::string> _extraIds;  // _genericIds not included in _ids
 };
 
+/**
+ * An ExposureInfo::ComponentLoader that deserializes components from an
+ * already-loaded archive on first access.
+ *
+ * The archive catalogs must have been read into memory (via
+ * ArchiveReader::ensureLoaded) before any component is requested, because the
+ * loader may outlive both the reader and the FITS file it was reading.  It
+ * holds shared ownership of the reader's parsed metadata and archive state
+ * to make that safe.
+ */
+class ExposureFitsReader::LazyComponentLoader final : public ExposureInfo::ComponentLoader {
+public:
+    LazyComponentLoader(std::shared_ptr<MetadataReader> metadataReader,
+                        std::shared_ptr<ArchiveReader> archiveReader)
+            : _metadataReader(std::move(metadataReader)), _archiveReader(std::move(archiveReader)) {}
+
+    std::vector<std::string> getComponentNames() const override {
+        std::vector<std::string> names = _archiveReader->getComponentNames();
+        auto addIfMissing = [&names](std::string const& name) {
+            if (std::find(names.begin(), names.end(), name) == names.end()) {
+                names.push_back(name);
+            }
+        };
+        // Components that may come from the FITS headers rather than the archive.
+        if (_metadataReader->wcs) {
+            addIfMissing(ExposureInfo::KEY_WCS.getId());
+        }
+        if (_metadataReader->version < 2 && _metadataReader->filterLabel) {
+            addIfMissing(ExposureInfo::KEY_FILTER.getId());
+        }
+        if (_metadataReader->version == 0 && _metadataReader->photoCalib) {
+            addIfMissing(ExposureInfo::KEY_PHOTO_CALIB.getId());
+        }
+        return names;
+    }
+
+    std::shared_ptr<typehandling::Storable> loadComponent(std::string const& name) override {
+        // The archive catalogs are already in memory, so readComponent may be
+        // called with a null fitsFile.  As in the eager readExposureInfo, we
+        // warn and return null when a component is present but can't be read
+        // due to its serialization factory not being set up.
+        try {
+            if (name == ExposureInfo::KEY_WCS.getId()) {
+                return _loadWcs();
+            } else if (name == ExposureInfo::KEY_FILTER.getId()) {
+                // Old-style Filters were converted to FilterLabels by MetadataReader.
+                if (_metadataReader->version < 2) {
+                    return _metadataReader->filterLabel;
+                }
+                return _archiveReader->readComponent<FilterLabel>(nullptr, name);
+            } else if (name == ExposureInfo::KEY_PHOTO_CALIB.getId()) {
+                // Version 0 persisted Calib FLUXMAG0 in the metadata.
+                if (_metadataReader->version == 0) {
+                    return _metadataReader->photoCalib;
+                }
+                return _archiveReader->readComponent<PhotoCalib>(nullptr, ArchiveReader::PHOTOCALIB);
+            } else if (name == ExposureInfo::KEY_PSF.getId()) {
+                return _archiveReader->readComponent<detection::Psf>(nullptr, ArchiveReader::PSF);
+            } else if (name == ExposureInfo::KEY_VALID_POLYGON.getId()) {
+                return _archiveReader->readComponent<afw::geom::polygon::Polygon>(
+                        nullptr, ArchiveReader::VALID_POLYGON);
+            } else if (name == ExposureInfo::KEY_AP_CORR_MAP.getId()) {
+                return _archiveReader->readComponent<ApCorrMap>(nullptr, ArchiveReader::AP_CORR_MAP);
+            } else if (name == ExposureInfo::KEY_COADD_INPUTS.getId()) {
+                return _archiveReader->readComponent<CoaddInputs>(nullptr, ArchiveReader::COADD_INPUTS);
+            } else if (name == ExposureInfo::KEY_TRANSMISSION_CURVE.getId()) {
+                return _archiveReader->readComponent<TransmissionCurve>(nullptr,
+                                                                        ArchiveReader::TRANSMISSION_CURVE);
+            } else if (name == ExposureInfo::KEY_DETECTOR.getId()) {
+                return _archiveReader->readComponent<cameraGeom::Detector>(nullptr, ArchiveReader::DETECTOR);
+            } else {
+                return _archiveReader->readComponent<typehandling::Storable>(nullptr, name);
+            }
+        } catch (pex::exceptions::NotFoundError& err) {
+            LOGLS_WARN(_log, "Could not read component " << name << "; setting to null: " << err.what());
+            return nullptr;
+        }
+    }
+
+private:
+    std::shared_ptr<typehandling::Storable> _loadWcs() {
+        // Fall back to the metadata WCS if the one from the archive can't be read.
+        try {
+            auto wcs = _archiveReader->readComponent<afw::geom::SkyWcs>(nullptr, ArchiveReader::WCS);
+            if (!wcs) {
+                LOGLS_DEBUG(_log, "No WCS found in binary table");
+                return _metadataReader->wcs;
+            }
+            return wcs;
+        } catch (pex::exceptions::NotFoundError& err) {
+            auto msg = str(boost::format("Could not read WCS extension; setting to null: %s") % err.what());
+            if (_metadataReader->wcs) {
+                msg += " ; using WCS from FITS header";
+            }
+            LOGLS_WARN(_log, msg);
+            return _metadataReader->wcs;
+        }
+    }
+
+    std::shared_ptr<MetadataReader> _metadataReader;
+    std::shared_ptr<ArchiveReader> _archiveReader;
+};
+
 ExposureFitsReader::ExposureFitsReader(std::string const& fileName) : _maskedImageReader(fileName) {}
 
 ExposureFitsReader::ExposureFitsReader(fits::MemFileManager& manager) : _maskedImageReader(manager) {}
@@ -588,7 +734,18 @@ std::map<std::string, std::shared_ptr<table::io::Persistable>> ExposureFitsReade
     return _archiveReader->readExtraComponents(_getFitsFile());
 }
 
-std::shared_ptr<ExposureInfo> ExposureFitsReader::readExposureInfo() {
+std::shared_ptr<ExposureInfo> ExposureFitsReader::readExposureInfo(bool lazy) {
+    if (lazy) {
+        _ensureReaders();
+        auto result = std::make_shared<ExposureInfo>();
+        result->setMetadata(readMetadata());
+        result->setVisitInfo(readVisitInfo());
+        // Pull the archive catalogs into memory while the file is still
+        // open; the components themselves are deserialized on first access.
+        _archiveReader->ensureLoaded(_getFitsFile());
+        result->setComponentLoader(std::make_shared<LazyComponentLoader>(_metadataReader, _archiveReader));
+        return result;
+    }
     auto result = std::make_shared<ExposureInfo>();
     result->setMetadata(readMetadata());
     result->setPhotoCalib(readPhotoCalib());
@@ -703,28 +860,31 @@ ndarray::Array<VariancePixelT, 2, 2> ExposureFitsReader::readVarianceArray(lsst:
 
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> ExposureFitsReader::readMaskedImage(
-        lsst::geom::Box2I const& bbox, ImageOrigin origin, bool conformMasks, bool allowUnsafe) {
+        lsst::geom::Box2I const& bbox, ImageOrigin origin, bool conformMasks, bool allowUnsafe,
+        bool lazyVariance) {
     return _maskedImageReader.read<ImagePixelT, MaskPixelT, VariancePixelT>(bbox, origin, conformMasks,
                                                                             /* needAllHdus= */ false,
-                                                                            allowUnsafe);
+                                                                            allowUnsafe, lazyVariance);
 }
 
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 Exposure<ImagePixelT, MaskPixelT, VariancePixelT> ExposureFitsReader::read(lsst::geom::Box2I const& bbox,
                                                                            ImageOrigin origin,
                                                                            bool conformMasks,
-                                                                           bool allowUnsafe) {
-    auto mi =
-            readMaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>(bbox, origin, conformMasks, allowUnsafe);
-    return Exposure<ImagePixelT, MaskPixelT, VariancePixelT>(mi, readExposureInfo());
+                                                                           bool allowUnsafe,
+                                                                           bool lazyComponents,
+                                                                           bool lazyVariance) {
+    auto mi = readMaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>(bbox, origin, conformMasks,
+                                                                       allowUnsafe, lazyVariance);
+    return Exposure<ImagePixelT, MaskPixelT, VariancePixelT>(mi, readExposureInfo(lazyComponents));
 }
 
 void ExposureFitsReader::_ensureReaders() {
     if (!_metadataReader) {
-        auto metadataReader = std::make_unique<MetadataReader>(_maskedImageReader.readPrimaryMetadata(),
+        auto metadataReader = std::make_shared<MetadataReader>(_maskedImageReader.readPrimaryMetadata(),
                                                                _maskedImageReader.readImageMetadata(),
                                                                _maskedImageReader.readXY0());
-        _archiveReader = std::make_unique<ArchiveReader>(*metadataReader->metadata);
+        _archiveReader = std::make_shared<ArchiveReader>(*metadataReader->metadata);
         _metadataReader = std::move(metadataReader);  // deferred for exception safety
     }
     assert(_archiveReader);  // should always be initialized with _metadataReader.
@@ -732,12 +892,12 @@ void ExposureFitsReader::_ensureReaders() {
 
 #define INSTANTIATE(ImagePixelT)                                                                            \
     template Exposure<ImagePixelT, MaskPixel, VariancePixel> ExposureFitsReader::read(                      \
-            lsst::geom::Box2I const&, ImageOrigin, bool, bool);                                             \
+            lsst::geom::Box2I const&, ImageOrigin, bool, bool, bool, bool);                                 \
     template Image<ImagePixelT> ExposureFitsReader::readImage(lsst::geom::Box2I const&, ImageOrigin, bool); \
     template ndarray::Array<ImagePixelT, 2, 2> ExposureFitsReader::readImageArray(lsst::geom::Box2I const&, \
                                                                                   ImageOrigin, bool);       \
     template MaskedImage<ImagePixelT, MaskPixel, VariancePixel> ExposureFitsReader::readMaskedImage(        \
-            lsst::geom::Box2I const&, ImageOrigin, bool, bool)
+            lsst::geom::Box2I const&, ImageOrigin, bool, bool, bool)
 
 INSTANTIATE(std::uint16_t);
 INSTANTIATE(int);
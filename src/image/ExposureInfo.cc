@@ -188,7 +188,7 @@ ExposureInfo::ExposureInfo(std::shared_ptr<geom::SkyWcs const> const& wcs,
         : _metadata(metadata ? metadata
                              : std::shared_ptr<daf::base::PropertySet>(new daf::base::PropertyList())),
           _visitInfo(visitInfo),
-          _components(std::make_unique<MapClass>()) {
+          _components(std::make_shared<MapClass>()) {
     // setFilter guards against default filters
     setFilter(filter);
     setWcs(wcs);
@@ -209,8 +209,12 @@ ExposureInfo::ExposureInfo(ExposureInfo&& other) : ExposureInfo(other) {}
 ExposureInfo::ExposureInfo(ExposureInfo const& other, bool copyMetadata)
         : _metadata(other._metadata),
           _visitInfo(other._visitInfo),
-          // ExposureInfos can (historically) share objects, but should each have their own pointers to them
-          _components(std::make_unique<MapClass>(*(other._components))) {
+          // copies share the component map itself; it is cloned on first mutation
+          // (the component objects have always been shared)
+          _components(other._components),
+          // the loader is shared, but each copy caches what it loads independently
+          _componentLoader(other._componentLoader),
+          _unloadedComponents(other._unloadedComponents) {
     if (copyMetadata) _metadata = _metadata->deepCopy();
 }
 
@@ -218,11 +222,55 @@ ExposureInfo& ExposureInfo::operator=(ExposureInfo const& other) {
     if (&other != this) {
         _metadata = other._metadata;
         _visitInfo = other._visitInfo;
-        // ExposureInfos can (historically) share objects, but should each have their own pointers to them
-        _components = std::make_unique<MapClass>(*(other._components));
+        // copies share the component map itself; it is cloned on first mutation
+        _components = other._components;
+        _componentLoader = other._componentLoader;
+        _unloadedComponents = other._unloadedComponents;
     }
     return *this;
 }
+
+void ExposureInfo::setComponentLoader(std::shared_ptr<ComponentLoader> loader) {
+    _componentLoader = std::move(loader);
+    _unloadedComponents.clear();
+    if (_componentLoader) {
+        for (auto const& name : _componentLoader->getComponentNames()) {
+            // components already present take precedence over the loader
+            if (!_components->contains(name)) {
+                _unloadedComponents.insert(name);
+            }
+        }
+    }
+}
+
+void ExposureInfo::_loadAllComponents() const {
+    // copy the names: _loadComponent removes them as it goes
+    std::set<std::string> const names(_unloadedComponents);
+    for (auto const& name : names) {
+        if (name == KEY_WCS.getId()) {
+            _loadComponent(KEY_WCS);
+        } else if (name == KEY_PSF.getId()) {
+            _loadComponent(KEY_PSF);
+        } else if (name == KEY_PHOTO_CALIB.getId()) {
+            _loadComponent(KEY_PHOTO_CALIB);
+        } else if (name == KEY_DETECTOR.getId()) {
+            _loadComponent(KEY_DETECTOR);
+        } else if (name == KEY_VALID_POLYGON.getId()) {
+            _loadComponent(KEY_VALID_POLYGON);
+        } else if (name == KEY_COADD_INPUTS.getId()) {
+            _loadComponent(KEY_COADD_INPUTS);
+        } else if (name == KEY_AP_CORR_MAP.getId()) {
+            _loadComponent(KEY_AP_CORR_MAP);
+        } else if (name == KEY_TRANSMISSION_CURVE.getId()) {
+            _loadComponent(KEY_TRANSMISSION_CURVE);
+        } else if (name == KEY_FILTER.getId()) {
+            _loadComponent(KEY_FILTER);
+        } else {
+            // generic components are stored under Storable keys
+            _loadComponent(typehandling::makeKey<std::shared_ptr<typehandling::Storable const>>(name));
+        }
+    }
+}
 // Delegate to copy-assignment for backwards compatibility
 ExposureInfo& ExposureInfo::operator=(ExposureInfo&& other) { return *this = other; }
 
@@ -258,6 +306,9 @@ std::string _getHeaderComment(std::string mapKey) {
 }  // namespace
 
 ExposureInfo::FitsWriteData ExposureInfo::_startWriteFits(lsst::geom::Point2I const& xy0) const {
+    // Pending lazily-loaded components must be materialized to be persisted
+    _loadAllComponents();
+
     FitsWriteData data;
 
     data.metadata.reset(new daf::base::PropertyList());
@@ -0,0 +1,143 @@
+/*
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <utility>
+
+#include "boost/format.hpp"
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/image/ExposureFitsReader.h"
+#include "lsst/afw/image/ExposurePrefetcher.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace lsst {
+namespace afw {
+namespace image {
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+ExposurePrefetcher<ImagePixelT, MaskPixelT, VariancePixelT>::ExposurePrefetcher(
+        std::vector<std::string> fileNames, std::size_t readAhead, int numThreads, bool allowUnsafe)
+        : _fileNames(std::move(fileNames)),
+          _readAhead(readAhead),
+          _allowUnsafe(allowUnsafe),
+          _slots(_fileNames.size()),
+          _nextToRead(0),
+          _nextToDeliver(0),
+          _stop(false) {
+    if (readAhead < 1) {
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError,
+                          (boost::format("readAhead must be at least 1: saw %d") % readAhead).str());
+    }
+    if (numThreads < 1) {
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError,
+                          (boost::format("numThreads must be at least 1: saw %d") % numThreads).str());
+    }
+    // more readers than the read-ahead budget (or the file list) could use would never have work
+    std::size_t const nThreads =
+            std::min({static_cast<std::size_t>(numThreads), _readAhead, std::max<std::size_t>(_fileNames.size(), 1)});
+    _threads.reserve(nThreads);
+    for (std::size_t i = 0; i < nThreads; ++i) {
+        _threads.emplace_back(&ExposurePrefetcher::_workerMain, this);
+    }
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+ExposurePrefetcher<ImagePixelT, MaskPixelT, VariancePixelT>::~ExposurePrefetcher() noexcept {
+    {
+        std::lock_guard<std::mutex> lock(_mutex);
+        _stop = true;
+    }
+    _stateChanged.notify_all();
+    for (auto &thread : _threads) {
+        thread.join();
+    }
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+bool ExposurePrefetcher<ImagePixelT, MaskPixelT, VariancePixelT>::hasNext() const {
+    std::lock_guard<std::mutex> lock(_mutex);
+    return _nextToDeliver < _slots.size();
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+typename ExposurePrefetcher<ImagePixelT, MaskPixelT, VariancePixelT>::ExposureT
+ExposurePrefetcher<ImagePixelT, MaskPixelT, VariancePixelT>::next() {
+    std::unique_lock<std::mutex> lock(_mutex);
+    if (_nextToDeliver >= _slots.size()) {
+        throw LSST_EXCEPT(pexExcept::OutOfRangeError,
+                          (boost::format("All %d exposures have already been delivered") % _slots.size())
+                                  .str());
+    }
+    Slot &slot = _slots[_nextToDeliver];
+    _stateChanged.wait(lock, [&slot] { return slot.ready; });
+    ++_nextToDeliver;
+    // consuming this slot frees read-ahead budget for the reader threads
+    _stateChanged.notify_all();
+    if (slot.error) {
+        std::rethrow_exception(slot.error);
+    }
+    ExposureT result = std::move(*slot.exposure);
+    slot.exposure.reset();
+    return result;
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void ExposurePrefetcher<ImagePixelT, MaskPixelT, VariancePixelT>::_workerMain() {
+    while (true) {
+        std::size_t index = 0;
+        {
+            std::unique_lock<std::mutex> lock(_mutex);
+            _stateChanged.wait(lock, [this] {
+                return _stop || _nextToRead >= _slots.size() ||
+                       _nextToRead < _nextToDeliver + _readAhead;
+            });
+            if (_stop || _nextToRead >= _slots.size()) {
+                return;
+            }
+            index = _nextToRead++;
+        }
+        Slot &slot = _slots[index];
+        try {
+            ExposureFitsReader reader(_fileNames[index]);
+            slot.exposure.reset(new ExposureT(reader.template read<ImagePixelT, MaskPixelT, VariancePixelT>(
+                    lsst::geom::Box2I(), PARENT, false, _allowUnsafe)));
+        } catch (...) {
+            slot.error = std::current_exception();
+        }
+        {
+            std::lock_guard<std::mutex> lock(_mutex);
+            slot.ready = true;
+        }
+        _stateChanged.notify_all();
+    }
+}
+
+template class ExposurePrefetcher<std::uint16_t>;
+template class ExposurePrefetcher<int>;
+template class ExposurePrefetcher<float>;
+template class ExposurePrefetcher<double>;
+template class ExposurePrefetcher<std::uint64_t>;
+
+}  // namespace image
+}  // namespace afw
+}  // namespace lsst
@@ -25,9 +25,11 @@
 /*
  * Implementation for ImageBase and Image
  */
+#include <algorithm>
 #include <cstdint>
 #include <iostream>
 #include <functional>
+#include <numeric>
 #include <type_traits>
 #include "boost/mpl/vector.hpp"
 #pragma clang diagnostic push
@@ -47,6 +49,8 @@
 #include "lsst/afw/geom/wcsUtils.h"
 #include "lsst/afw/image/Image.h"
 #include "lsst/afw/image/ImageAlgorithm.h"
+#include "lsst/afw/image/ImageAllocator.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/afw/fits.h"
 #include "lsst/afw/image/ImageFitsReader.h"
 
@@ -54,6 +58,47 @@ namespace lsst {
 namespace afw {
 namespace image {
 
+namespace {
+// Set by _allocateView when the buffer it handed out consists of fresh anonymous
+// pages that read as zero; consumed by the Image constructors immediately after
+// the base-class constructor returns, so that a zero initial value does not fault
+// in every page of a large plane on the constructing thread.
+thread_local bool lastAllocationZeroFilled = false;
+
+// Planes at or above this many bytes have their deep copies split into row bands
+// that run on the shared task pool.
+constexpr std::size_t PARALLEL_COPY_MIN_BYTES = std::size_t(8) << 20;
+
+/*
+ * Copy the pixels of `src` into the identically-sized `dst`, in parallel row
+ * bands when the plane is large.  Each row is copied with the contiguous pixel
+ * iterators, so a band is effectively a run of memcpys; this also first-touches
+ * the destination pages from the copying threads.
+ */
+template <typename PixelT>
+void copyPixelsDeep(ImageBase<PixelT>& dst, ImageBase<PixelT> const& src) {
+    int const height = src.getHeight();
+    std::size_t const numBytes = static_cast<std::size_t>(src.getWidth()) * height * sizeof(PixelT);
+    if (numBytes < PARALLEL_COPY_MIN_BYTES || height < 2) {
+        dst.assign(src);
+        return;
+    }
+    int const numBands = std::min(height, math::TaskPool::getInstance().getNumThreads());
+    math::TaskPool::TaskGroup group;
+    for (int band = 0; band != numBands; ++band) {
+        int const yBegin = band * height / numBands;
+        int const yEnd = (band + 1) * height / numBands;
+        group.run([&dst, &src, yBegin, yEnd] {
+            for (int y = yBegin; y != yEnd; ++y) {
+                std::copy(src.row_begin(y), src.row_end(y), dst.row_begin(y));
+            }
+        });
+    }
+    group.wait();
+}
+
+}  // namespace
+
 template <typename PixelT>
 typename ImageBase<PixelT>::_view_t ImageBase<PixelT>::_allocateView(lsst::geom::Extent2I const& dimensions,
                                                                      Manager::Ptr& manager) {
@@ -67,12 +112,51 @@ typename ImageBase<PixelT>::_view_t ImageBase<PixelT>::_allocateView(lsst::geom:
                           str(boost::format("Image dimensions (%d x %d) too large; int overflow detected.") %
                               dimensions.getX() % dimensions.getY()));
     }
-    std::pair<Manager::Ptr, PixelT*> r =
-            ndarray::SimpleManager<PixelT>::allocate(dimensions.getX() * dimensions.getY());
-    manager = r.first;
+    std::size_t const numPixels = static_cast<std::size_t>(dimensions.getX()) * dimensions.getY();
+
+    // Round the row pitch (and the base address) up to the requested alignment, if
+    // any; the padding bytes are not part of the image, so it behaves like a subimage
+    // (in particular, isContiguous() is false).
+    bool const padRows = getCurrentImageRowAlignment() != 0 && numPixels != 0;
+    std::size_t const rowAlignment = std::max(getCurrentImageRowAlignment(), sizeof(PixelT));
+    std::size_t const rowBytes = dimensions.getX() * sizeof(PixelT);
+    std::size_t const pitchBytes =
+            padRows ? (rowBytes + rowAlignment - 1) / rowAlignment * rowAlignment : rowBytes;
+    std::size_t const numBytes = padRows ? pitchBytes * dimensions.getY() + rowAlignment - 1
+                                         : numPixels * sizeof(PixelT);
+
+    PixelT* data;
+    lastAllocationZeroFilled = false;
+    if (std::shared_ptr<ImageAllocator> allocator = getCurrentImageAllocator()) {
+        std::pair<ndarray::Manager::Ptr, void*> r = allocator->allocate(numBytes);
+        manager = r.first;
+        data = static_cast<PixelT*>(r.second);
+    } else {
+        // Large planes get a dedicated, untouched mapping: pages are placed on the
+        // NUMA node of the thread that first writes them, and on Linux carry a
+        // transparent-hugepage hint.  numBytes already includes the slack the row
+        // alignment rounding below may consume.
+        std::pair<ndarray::Manager::Ptr, void*> large = detail::allocateLargeImageStorage(numBytes);
+        if (large.second != nullptr) {
+            manager = large.first;
+            data = static_cast<PixelT*>(large.second);
+            lastAllocationZeroFilled = true;
+        } else if (!padRows) {
+            std::pair<Manager::Ptr, PixelT*> r = ndarray::SimpleManager<PixelT>::allocate(numPixels);
+            manager = r.first;
+            data = r.second;
+        } else {
+            std::pair<Manager::Ptr, char*> r = ndarray::SimpleManager<char>::allocate(numBytes);
+            manager = r.first;
+            data = reinterpret_cast<PixelT*>(r.second);
+        }
+    }
+    if (padRows) {
+        std::uintptr_t const addr = reinterpret_cast<std::uintptr_t>(data);
+        data = reinterpret_cast<PixelT*>((addr + rowAlignment - 1) / rowAlignment * rowAlignment);
+    }
     return boost::gil::interleaved_view(dimensions.getX(), dimensions.getY(),
-                                        (typename _view_t::value_type*)r.second,
-                                        dimensions.getX() * sizeof(PixelT));
+                                        (typename _view_t::value_type*)data, pitchBytes);
 }
 template <typename PixelT>
 typename ImageBase<PixelT>::_view_t ImageBase<PixelT>::_makeSubView(lsst::geom::Extent2I const& dimensions,
@@ -107,7 +191,7 @@ ImageBase<PixelT>::ImageBase(ImageBase const& rhs, bool const deep
         : _origin(rhs._origin), _manager(rhs._manager), _gilView(rhs._gilView) {
     if (deep) {
         ImageBase tmp(getBBox());
-        tmp.assign(*this);  // now copy the pixels
+        copyPixelsDeep(tmp, *this);  // now copy the pixels
         swap(tmp);
     }
 }
@@ -125,7 +209,7 @@ ImageBase<PixelT>::ImageBase(ImageBase const& rhs, lsst::geom::Box2I const& bbox
           _gilView(_makeSubView(bbox.getDimensions(), _origin - rhs._origin, rhs._gilView)) {
     if (deep) {
         ImageBase tmp(getBBox());
-        tmp.assign(*this);  // now copy the pixels
+        copyPixelsDeep(tmp, *this);  // now copy the pixels
         swap(tmp);
     }
 }
@@ -315,18 +399,25 @@ ImageBase<PixelT>& ImageBase<PixelT>::operator=(PixelT const rhs) {
 template <typename PixelT>
 Image<PixelT>::Image(unsigned int width, unsigned int height, PixelT initialValue)
         : ImageBase<PixelT>(lsst::geom::ExtentI(width, height)) {
-    *this = initialValue;
+    // fresh mappings already read as zero; filling them would fault in every page here
+    if (initialValue != 0 || !lastAllocationZeroFilled) {
+        *this = initialValue;
+    }
 }
 
 template <typename PixelT>
 Image<PixelT>::Image(lsst::geom::Extent2I const& dimensions, PixelT initialValue)
         : ImageBase<PixelT>(dimensions) {
-    *this = initialValue;
+    if (initialValue != 0 || !lastAllocationZeroFilled) {
+        *this = initialValue;
+    }
 }
 
 template <typename PixelT>
 Image<PixelT>::Image(lsst::geom::Box2I const& bbox, PixelT initialValue) : ImageBase<PixelT>(bbox) {
-    *this = initialValue;
+    if (initialValue != 0 || !lastAllocationZeroFilled) {
+        *this = initialValue;
+    }
 }
 
 template <typename PixelT>
@@ -340,6 +431,32 @@ Image<PixelT>::Image(Image const& rhs, lsst::geom::Box2I const& bbox, ImageOrigi
                      bool const deep)
         : ImageBase<PixelT>(rhs, bbox, origin, deep) {}
 
+template <typename PixelT>
+Image<PixelT> Image<PixelT>::adoptBuffer(PixelT* data, lsst::geom::Extent2I const& dimensions,
+                                         int rowStride, std::function<void(PixelT*)> deleter,
+                                         lsst::geom::Point2I const& xy0) {
+    if (data == nullptr) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Cannot adopt a null pixel buffer");
+    }
+    if (dimensions.getX() < 0 || dimensions.getY() < 0) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          str(boost::format("Both width and height must be non-negative: %d, %d") %
+                              dimensions.getX() % dimensions.getY()));
+    }
+    if (rowStride < dimensions.getX()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          str(boost::format("rowStride (%d) is smaller than the image width (%d)") %
+                              rowStride % dimensions.getX()));
+    }
+    // the owner keeps the buffer alive (and eventually runs the deleter) for as long
+    // as any Image references it
+    std::shared_ptr<PixelT> owner(data, deleter ? std::move(deleter) : [](PixelT*) {});
+    ndarray::Array<PixelT, 2, 1> array =
+            ndarray::external(data, ndarray::makeVector(dimensions.getY(), dimensions.getX()),
+                              ndarray::makeVector(rowStride, 1), owner);
+    return Image(array, false, xy0);
+}
+
 template <typename PixelT>
 Image<PixelT>& Image<PixelT>::operator=(PixelT const rhs) {
     this->ImageBase<PixelT>::operator=(rhs);
@@ -712,6 +829,47 @@ bool imagesOverlap(ImageBase<T1> const& image1, ImageBase<T2> const& image2) {
     return ptrLess(beg1Addr, end2Addr) && ptrLess(beg2Addr, end1Addr);
 }
 
+template <typename PixelT>
+std::vector<std::shared_ptr<Image<PixelT>>> extractCutouts(Image<PixelT> const& parent,
+                                                           std::vector<lsst::geom::Box2I> const& boxes) {
+    lsst::geom::Box2I const parentBox = parent.getBBox();
+    std::size_t nPixels = 0;
+    for (std::size_t i = 0; i != boxes.size(); ++i) {
+        if (boxes[i].isEmpty() || !parentBox.contains(boxes[i])) {
+            throw LSST_EXCEPT(pex::exceptions::LengthError,
+                              (boost::format("Cutout box %d: %s doesn't fit in image bbox %s") % i %
+                               boxes[i] % parentBox)
+                                      .str());
+        }
+        nPixels += boxes[i].getArea();
+    }
+    // One pooled allocation backs every cutout; each Image is an external view
+    // whose manager keeps the pool alive.
+    ndarray::Array<PixelT, 1, 1> pool = ndarray::allocate(nPixels);
+    std::vector<std::shared_ptr<Image<PixelT>>> cutouts;
+    cutouts.reserve(boxes.size());
+    std::size_t offset = 0;
+    for (auto const& box : boxes) {
+        auto const shape = ndarray::makeVector(box.getHeight(), box.getWidth());
+        auto const strides = ndarray::makeVector(box.getWidth(), 1);
+        ndarray::Array<PixelT, 2, 1> array = ndarray::external(pool.getData() + offset, shape, strides, pool);
+        cutouts.push_back(std::make_shared<Image<PixelT>>(array, false, box.getMin()));
+        offset += box.getArea();
+    }
+    // Fill the cutouts sorted by row range so the parent's rows stream through
+    // roughly sequentially rather than in the callers' random order.
+    std::vector<std::size_t> order(boxes.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&boxes](std::size_t a, std::size_t b) {
+        return std::make_pair(boxes[a].getMinY(), boxes[a].getMinX()) <
+               std::make_pair(boxes[b].getMinY(), boxes[b].getMinX());
+    });
+    for (std::size_t index : order) {
+        cutouts[index]->assign(parent.subset(boxes[index]));
+    }
+    return cutouts;
+}
+
 //
 // Explicit instantiations
 //
@@ -723,12 +881,14 @@ bool imagesOverlap(ImageBase<T1> const& image1, ImageBase<T2> const& image2) {
     template Image<T>& operator OP_EQ(Image<T>& lhs, Image<double> const& rhs);        \
     template Image<T>& operator OP_EQ(Image<T>& lhs, Image<std::uint64_t> const& rhs);
 
-#define INSTANTIATE(T)           \
-    template class ImageBase<T>; \
-    template class Image<T>;     \
-    INSTANTIATE_OPERATOR(+=, T); \
-    INSTANTIATE_OPERATOR(-=, T); \
-    INSTANTIATE_OPERATOR(*=, T); \
+#define INSTANTIATE(T)                                                        \
+    template class ImageBase<T>;                                              \
+    template class Image<T>;                                                  \
+    template std::vector<std::shared_ptr<Image<T>>> extractCutouts(           \
+            Image<T> const&, std::vector<lsst::geom::Box2I> const&);          \
+    INSTANTIATE_OPERATOR(+=, T);                                              \
+    INSTANTIATE_OPERATOR(-=, T);                                              \
+    INSTANTIATE_OPERATOR(*=, T);                                              \
     INSTANTIATE_OPERATOR(/=, T)
 
 #define INSTANTIATE2(T1, T2) template bool imagesOverlap<T1, T2>(ImageBase<T1> const&, ImageBase<T2> const&);
@@ -0,0 +1,134 @@
+/*
+ * LSST Data Management System
+ * Copyright 2008-2020 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/*
+ * Pluggable allocation of pixel storage; see ImageAllocator.h
+ */
+#include <atomic>
+#include <sstream>
+#include <utility>
+
+#if defined(__linux__)
+#include <sys/mman.h>
+#endif
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/image/ImageAllocator.h"
+
+namespace lsst {
+namespace afw {
+namespace image {
+
+namespace {
+thread_local std::shared_ptr<ImageAllocator> currentImageAllocator;
+thread_local std::size_t currentImageRowAlignment = 0;
+// Buffers at or above this many bytes get a dedicated anonymous mapping.
+std::atomic<std::size_t> largeImageAllocationThreshold{std::size_t(4) << 20};
+}  // namespace
+
+ScopedImageAllocator::ScopedImageAllocator(std::shared_ptr<ImageAllocator> allocator)
+        : _previous(std::move(currentImageAllocator)) {
+    if (!allocator) {
+        currentImageAllocator = std::move(_previous);
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "allocator is null");
+    }
+    currentImageAllocator = std::move(allocator);
+}
+
+ScopedImageAllocator::~ScopedImageAllocator() noexcept { currentImageAllocator = std::move(_previous); }
+
+std::shared_ptr<ImageAllocator> getCurrentImageAllocator() { return currentImageAllocator; }
+
+ScopedImageRowAlignment::ScopedImageRowAlignment(std::size_t alignment)
+        : _previous(currentImageRowAlignment) {
+    if (alignment == 0 || (alignment & (alignment - 1)) != 0) {
+        std::ostringstream os;
+        os << "Row alignment must be a power of two; saw " << alignment;
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, os.str());
+    }
+    currentImageRowAlignment = alignment;
+}
+
+ScopedImageRowAlignment::~ScopedImageRowAlignment() noexcept { currentImageRowAlignment = _previous; }
+
+std::size_t getCurrentImageRowAlignment() { return currentImageRowAlignment; }
+
+void setLargeImageAllocationThreshold(std::size_t bytes) {
+    largeImageAllocationThreshold.store(bytes, std::memory_order_relaxed);
+}
+
+std::size_t getLargeImageAllocationThreshold() {
+    return largeImageAllocationThreshold.load(std::memory_order_relaxed);
+}
+
+namespace detail {
+
+std::pair<ndarray::Manager::Ptr, void*> allocateLargeImageStorage(std::size_t bytes) {
+#if defined(__linux__)
+    std::size_t const threshold = largeImageAllocationThreshold.load(std::memory_order_relaxed);
+    if (threshold == 0 || bytes < threshold) {
+        return std::pair<ndarray::Manager::Ptr, void*>(nullptr, nullptr);
+    }
+    void* const data = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (data == MAP_FAILED) {
+        // out of address space or mappings; let the caller try the heap
+        return std::pair<ndarray::Manager::Ptr, void*>(nullptr, nullptr);
+    }
+#if defined(MADV_HUGEPAGE)
+    // best effort: the plane works (just slower) without huge pages
+    ::madvise(data, bytes, MADV_HUGEPAGE);
+#endif
+    std::shared_ptr<void> mapping(data, [bytes](void* p) { ::munmap(p, bytes); });
+    return std::pair<ndarray::Manager::Ptr, void*>(ndarray::makeManager(mapping), data);
+#else
+    (void)bytes;
+    return std::pair<ndarray::Manager::Ptr, void*>(nullptr, nullptr);
+#endif
+}
+
+}  // namespace detail
+
+ArenaImageAllocator::ArenaImageAllocator(std::size_t blockBytes)
+        : _blockBytes(blockBytes == 0 ? 1 : blockBytes), _block(), _used(0) {}
+
+std::pair<ndarray::Manager::Ptr, void*> ArenaImageAllocator::allocate(std::size_t bytes) {
+    // round each request up so the next one stays aligned for any pixel type
+    std::size_t const alignment = alignof(std::max_align_t);
+    std::size_t const padded = (bytes + alignment - 1) / alignment * alignment;
+
+    if (padded > _blockBytes) {
+        // oversize request: give it a dedicated block and leave the current one alone
+        auto block = std::make_shared<std::vector<char>>(padded);
+        return std::make_pair(ndarray::makeManager(block), static_cast<void*>(block->data()));
+    }
+    if (!_block || _used + padded > _blockBytes) {
+        _block = std::make_shared<std::vector<char>>(_blockBytes);
+        _used = 0;
+    }
+    void* const data = _block->data() + _used;
+    _used += padded;
+    return std::make_pair(ndarray::makeManager(_block), data);
+}
+
+}  // namespace image
+}  // namespace afw
+}  // namespace lsst
@@ -19,6 +19,8 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+
 #include "lsst/afw/image/ImageBaseFitsReader.h"
 #include "lsst/afw/geom/wcsUtils.h"
 
@@ -167,6 +169,60 @@ std::string makeDTypeString() {
 
 } // anonymous
 
+template <typename T>
+ndarray::Array<T, 2, 2> ImageBaseFitsReader::_readTileCompressedSubregion(
+    lsst::geom::Box2I const & subBBox, lsst::geom::Box2I const & fullBBox
+) {
+    // The FITS default tile is one full row; ZTILEn overrides that.  A
+    // nonpositive ZTILEn means the tile spans that whole dimension.
+    long tileWidth = fullBBox.getWidth();
+    long tileHeight = 1;
+    try {
+        _fitsFile->readKey("ZTILE1", tileWidth);
+        _fitsFile->readKey("ZTILE2", tileHeight);
+    } catch (fits::FitsError &) {
+        _fitsFile->status = 0;
+    }
+    if (tileWidth <= 0) {
+        tileWidth = fullBBox.getWidth();
+    }
+    if (tileHeight <= 0) {
+        tileHeight = fullBBox.getHeight();
+    }
+    // Expand the requested region to the tile grid (in LOCAL coordinates, so
+    // the grid is anchored at the image origin), clipped to the image; a tile
+    // has to be decompressed in full anyway, so reading all of it costs only
+    // a copy and lets later overlapping requests reuse it.
+    int const x0 = subBBox.getMinX() - fullBBox.getMinX();
+    int const y0 = subBBox.getMinY() - fullBBox.getMinY();
+    lsst::geom::Box2I const aligned(
+        lsst::geom::Point2I((x0/tileWidth)*tileWidth, (y0/tileHeight)*tileHeight),
+        lsst::geom::Point2I(
+            std::min<long>(((x0 + subBBox.getWidth() - 1)/tileWidth + 1)*tileWidth,
+                           fullBBox.getWidth()) - 1,
+            std::min<long>(((y0 + subBBox.getHeight() - 1)/tileHeight + 1)*tileHeight,
+                           fullBBox.getHeight()) - 1
+        )
+    );
+    auto * cache = dynamic_cast<TileCache<T> *>(_tileCache.get());
+    if (cache == nullptr ||
+        !cache->box.contains(lsst::geom::Box2I(lsst::geom::Point2I(x0, y0), subBBox.getDimensions()))) {
+        ndarray::Array<T, 2, 2> tiles = ndarray::allocate(aligned.getHeight(), aligned.getWidth());
+        _fitsFile->readImage(tiles, ndarray::makeVector(aligned.getMinY(), aligned.getMinX()));
+        auto newCache = std::make_unique<TileCache<T>>();
+        newCache->box = aligned;
+        newCache->array = tiles;
+        cache = newCache.get();
+        _tileCache = std::move(newCache);
+    }
+    ndarray::Array<T, 2, 2> result = ndarray::allocate(subBBox.getHeight(), subBBox.getWidth());
+    int const row = y0 - cache->box.getMinY();
+    int const col = x0 - cache->box.getMinX();
+    result.deep() = cache->array[ndarray::view(row, row + subBBox.getHeight())
+                                              (col, col + subBBox.getWidth())];
+    return result;
+}
+
 template <typename T>
 ndarray::Array<T, 2, 2> ImageBaseFitsReader::readArray(lsst::geom::Box2I const & bbox, ImageOrigin origin,
                                                        bool allowUnsafe) {
@@ -192,6 +248,19 @@ ndarray::Array<T, 2, 2> ImageBaseFitsReader::readArray(lsst::geom::Box2I const &
                 _fitsFile->getImageDType() % _hdu % makeDTypeString<T>())
         );
     }
+    if (subBBox != fullBBox && _fitsFile->isCompressedImage()) {
+        // Decompress only the tiles that intersect the requested region, and
+        // keep them around for subsequent overlapping reads (e.g. cutouts).
+        return _readTileCompressedSubregion<T>(subBBox, fullBBox);
+    }
+    if (subBBox == fullBBox) {
+        // For uncompressed local files whose pixel type matches exactly, map the
+        // data unit directly instead of copying it through cfitsio's buffers.
+        auto mapped = _fitsFile->readImageMapped<T, 2>();
+        if (!mapped.isEmpty()) {
+            return mapped;
+        }
+    }
     ndarray::Array<T, 2, 2> result = ndarray::allocate(subBBox.getHeight(), subBBox.getWidth());
     ndarray::Vector<int, 2> offset = ndarray::makeVector(subBBox.getMinY() - fullBBox.getMinY(),
                                                          subBBox.getMinX() - fullBBox.getMinX());
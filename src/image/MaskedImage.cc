@@ -26,6 +26,7 @@
  * Implementation for MaskedImage
  */
 #include <cstdint>
+#include <mutex>
 #include <typeinfo>
 #include <sys/stat.h>
 #pragma clang diagnostic push
@@ -37,6 +38,7 @@
 #include "lsst/pex/exceptions.h"
 
 #include "lsst/afw/image/MaskedImage.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/afw/fits.h"
 #include "lsst/afw/image/MaskedImageFitsReader.h"
 
@@ -44,6 +46,15 @@ namespace lsst {
 namespace afw {
 namespace image {
 
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+struct MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::DeferredVariance {
+    explicit DeferredVariance(std::function<VariancePtr()> generator_) : generator(std::move(generator_)) {}
+
+    std::function<VariancePtr()> generator;
+    std::once_flag once;
+    VariancePtr variance;
+};
+
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::MaskedImage(unsigned int width, unsigned int height,
                                                                   MaskPlaneDict const& planeDict)
@@ -157,13 +168,83 @@ MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::MaskedImage(ImagePtr image
     conformSizes();
 }
 
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::MaskedImage(
+        ImagePtr image, MaskPtr mask, std::function<VariancePtr()> varianceGenerator)
+        : _image(image), _mask(mask), _variance() {
+    setVarianceGenerator(std::move(varianceGenerator));
+    conformSizes();
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::setVarianceGenerator(
+        std::function<VariancePtr()> generator) {
+    if (!generator) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Variance generator must not be null");
+    }
+    _deferredVariance = std::make_shared<DeferredVariance>(std::move(generator));
+    _variance.reset();
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::_materializeVariance() const {
+    if (!_deferredVariance) {
+        return;
+    }
+    // Keep our own reference to the shared state: another sharer that got here
+    // first may drop its _deferredVariance while we are still inside call_once.
+    std::shared_ptr<DeferredVariance> deferred = _deferredVariance;
+    std::call_once(deferred->once, [&deferred, this] {
+        VariancePtr variance = deferred->generator();
+        if (!variance) {
+            throw LSST_EXCEPT(pex::exceptions::RuntimeError, "Variance generator returned a null plane");
+        }
+        if (variance->getDimensions() != _image->getDimensions()) {
+            throw LSST_EXCEPT(
+                    pex::exceptions::LengthError,
+                    (boost::format("Dimension mismatch: Image %dx%d v. generated Variance %dx%d") %
+                     _image->getWidth() % _image->getHeight() % variance->getWidth() % variance->getHeight())
+                            .str());
+        }
+        variance->setXY0(_image->getXY0());
+        deferred->variance = std::move(variance);
+    });
+    // If the generator threw, call_once left the flag unset and rethrew, so we
+    // only get here with a valid plane.
+    _variance = deferred->variance;
+    _deferredVariance.reset();
+}
+
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::MaskedImage(MaskedImage const& rhs, bool deep)
-        : _image(rhs._image), _mask(rhs._mask), _variance(rhs._variance) {
+        : _image(rhs._image),
+          _mask(rhs._mask),
+          _variance(rhs._variance),
+          _deferredVariance(rhs._deferredVariance) {
     if (deep) {
-        _image = std::shared_ptr<Image>(new Image(*rhs.getImage(), deep));
-        _mask = std::shared_ptr<Mask>(new Mask(*rhs.getMask(), deep));
-        _variance = std::shared_ptr<Variance>(new Variance(*rhs.getVariance(), deep));
+        // A deep copy must not run the generator on a pool worker (it may be a
+        // Python callable that needs the GIL), so materialize the source first.
+        rhs._materializeVariance();
+        _variance = rhs._variance;
+        _deferredVariance.reset();
+        // Copy the three planes concurrently when they are big enough for the
+        // dispatch to pay off; each large plane further chunks itself into row
+        // bands.  Small (stamp-sized) copies stay serial.
+        std::size_t const planeBytes =
+                static_cast<std::size_t>(rhs.getWidth()) * rhs.getHeight() * sizeof(ImagePixelT);
+        if (planeBytes >= std::size_t(1) << 20) {
+            math::TaskPool::TaskGroup group;
+            group.run([this, &rhs] { _image = std::shared_ptr<Image>(new Image(*rhs.getImage(), true)); });
+            group.run([this, &rhs] { _mask = std::shared_ptr<Mask>(new Mask(*rhs.getMask(), true)); });
+            group.run([this, &rhs] {
+                _variance = std::shared_ptr<Variance>(new Variance(*rhs.getVariance(), true));
+            });
+            group.wait();
+        } else {
+            _image = std::shared_ptr<Image>(new Image(*rhs.getImage(), true));
+            _mask = std::shared_ptr<Mask>(new Mask(*rhs.getMask(), true));
+            _variance = std::shared_ptr<Variance>(new Variance(*rhs.getVariance(), true));
+        }
     }
     conformSizes();
 }
@@ -181,8 +262,11 @@ MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::MaskedImage(MaskedImage co
                                                                   )
         : _image(new Image(*rhs.getImage(), bbox, origin, deep)),
           _mask(rhs._mask ? new Mask(*rhs.getMask(), bbox, origin, deep) : static_cast<Mask*>(NULL)),
-          _variance(rhs._variance ? new Variance(*rhs.getVariance(), bbox, origin, deep)
-                                  : static_cast<Variance*>(NULL)) {
+          // a subimage of a deferred variance materializes the full plane; the
+          // subimage cannot share the deferred state as its image differs
+          _variance((rhs._variance || rhs._deferredVariance)
+                            ? new Variance(*rhs.getVariance(), bbox, origin, deep)
+                            : static_cast<Variance*>(NULL)) {
     conformSizes();
 }
 
@@ -201,12 +285,14 @@ void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::swap(MaskedImage& rhs
     _image.swap(rhs._image);
     _mask.swap(rhs._mask);
     _variance.swap(rhs._variance);
+    _deferredVariance.swap(rhs._deferredVariance);
 }
 
 // Operators
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::
 operator=(MaskedImage::Pixel const& rhs) {
+    _materializeVariance();
     *_image = rhs.image();
     *_mask = rhs.mask();
     *_variance = rhs.variance();
@@ -217,6 +303,7 @@ operator=(MaskedImage::Pixel const& rhs) {
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::
 operator=(MaskedImage::SinglePixel const& rhs) {
+    _materializeVariance();
     *_image = rhs.image();
     *_mask = rhs.mask();
     *_variance = rhs.variance();
@@ -228,6 +315,7 @@ template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::assign(MaskedImage const& rhs,
                                                                   lsst::geom::Box2I const& bbox,
                                                                   ImageOrigin origin) {
+    _materializeVariance();
     _image->assign(*rhs.getImage(), bbox, origin);
     _mask->assign(*rhs.getMask(), bbox, origin);
     _variance->assign(*rhs.getVariance(), bbox, origin);
@@ -236,18 +324,51 @@ void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::assign(MaskedImage co
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::
 operator+=(MaskedImage const& rhs) {
+    _materializeVariance();
     *_image += *rhs.getImage();
     *_mask |= *rhs.getMask();
     *_variance += *rhs.getVariance();
     return *this;
 }
 
+namespace {
+
+/// @internal Shared dimension check for the fused scaled-plane updates below
+template <typename LhsT, typename RhsT>
+void checkScaledDimensions(LhsT const& lhs, RhsT const& rhs) {
+    if (lhs.getDimensions() != rhs.getDimensions()) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Images are of different size, %dx%d v %dx%d") % lhs.getWidth() %
+                           lhs.getHeight() % rhs.getWidth() % rhs.getHeight())
+                                  .str());
+    }
+}
+
+}  // namespace
+
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::scaledPlus(double const c,
                                                                       MaskedImage const& rhs) {
-    (*_image).scaledPlus(c, *rhs.getImage());
+    _materializeVariance();
+    rhs._materializeVariance();
+    checkScaledDimensions(*_image, *rhs._image);
+    // Update image and variance in one interleaved pass per row rather than
+    // delegating to the per-plane Image methods: coadd weight application
+    // (scaledPlus in a loop over inputs) is bound by this traversal, and the
+    // fused loop halves the trips through memory and gives the compiler a
+    // single vectorizable body.
+    double const c2 = c * c;
+    for (int y = 0; y != getHeight(); ++y) {
+        typename Image::x_iterator rhsImgPtr = rhs._image->row_begin(y);
+        typename Variance::x_iterator varPtr = _variance->row_begin(y);
+        typename Variance::x_iterator rhsVarPtr = rhs._variance->row_begin(y);
+        for (typename Image::x_iterator imgPtr = _image->row_begin(y), end = _image->row_end(y);
+             imgPtr != end; ++imgPtr, ++rhsImgPtr, ++varPtr, ++rhsVarPtr) {
+            *imgPtr += static_cast<ImagePixelT>(c * *rhsImgPtr);
+            *varPtr += static_cast<VariancePixelT>(c2 * *rhsVarPtr);
+        }
+    }
     *_mask |= *rhs.getMask();
-    (*_variance).scaledPlus(c * c, *rhs.getVariance());
 }
 
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
@@ -260,6 +381,7 @@ operator+=(ImagePixelT const rhs) {
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::
 operator-=(MaskedImage const& rhs) {
+    _materializeVariance();
     *_image -= *rhs.getImage();
     *_mask |= *rhs.getMask();
     *_variance += *rhs.getVariance();
@@ -269,9 +391,22 @@ operator-=(MaskedImage const& rhs) {
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::scaledMinus(double const c,
                                                                        MaskedImage const& rhs) {
-    (*_image).scaledMinus(c, *rhs.getImage());
+    _materializeVariance();
+    rhs._materializeVariance();
+    checkScaledDimensions(*_image, *rhs._image);
+    // One interleaved image+variance pass per row; see scaledPlus.
+    double const c2 = c * c;
+    for (int y = 0; y != getHeight(); ++y) {
+        typename Image::x_iterator rhsImgPtr = rhs._image->row_begin(y);
+        typename Variance::x_iterator varPtr = _variance->row_begin(y);
+        typename Variance::x_iterator rhsVarPtr = rhs._variance->row_begin(y);
+        for (typename Image::x_iterator imgPtr = _image->row_begin(y), end = _image->row_end(y);
+             imgPtr != end; ++imgPtr, ++rhsImgPtr, ++varPtr, ++rhsVarPtr) {
+            *imgPtr -= static_cast<ImagePixelT>(c * *rhsImgPtr);
+            *varPtr += static_cast<VariancePixelT>(c2 * *rhsVarPtr);
+        }
+    }
     *_mask |= *rhs.getMask();
-    (*_variance).scaledPlus(c * c, *rhs.getVariance());
 }
 
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
@@ -290,21 +425,13 @@ struct productVariance {
     }
 };
 
-/// @internal Functor to calculate variance of the product of two independent variables, with the rhs scaled
-/// by c
-template <typename ImagePixelT, typename VariancePixelT>
-struct scaledProductVariance {
-    double _c;
-    scaledProductVariance(double const c) : _c(c) {}
-    double operator()(ImagePixelT lhs, ImagePixelT rhs, VariancePixelT varLhs, VariancePixelT varRhs) {
-        return _c * _c * (lhs * lhs * varRhs + rhs * rhs * varLhs);
-    }
-};
 }  // namespace
 
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::
 operator*=(MaskedImage const& rhs) {
+    _materializeVariance();
+    rhs._materializeVariance();
     // Must do variance before we modify the image values
     transform_pixels(_image->_getRawView(),         // lhs
                      rhs._image->_getRawView(),     // rhs,
@@ -321,21 +448,32 @@ operator*=(MaskedImage const& rhs) {
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::scaledMultiplies(double const c,
                                                                             MaskedImage const& rhs) {
-    // Must do variance before we modify the image values
-    transform_pixels(_image->_getRawView(),         // lhs
-                     rhs._image->_getRawView(),     // rhs,
-                     _variance->_getRawView(),      // Var(lhs),
-                     rhs._variance->_getRawView(),  // Var(rhs)
-                     _variance->_getRawView(),      // result
-                     scaledProductVariance<ImagePixelT, VariancePixelT>(c));
-
-    (*_image).scaledMultiplies(c, *rhs.getImage());
+    _materializeVariance();
+    rhs._materializeVariance();
+    checkScaledDimensions(*_image, *rhs._image);
+    // One interleaved image+variance pass per row; see scaledPlus.  Within
+    // each pixel the variance must still be computed before the image value
+    // is overwritten, so the original image values are read into locals.
+    double const c2 = c * c;
+    for (int y = 0; y != getHeight(); ++y) {
+        typename Image::x_iterator rhsImgPtr = rhs._image->row_begin(y);
+        typename Variance::x_iterator varPtr = _variance->row_begin(y);
+        typename Variance::x_iterator rhsVarPtr = rhs._variance->row_begin(y);
+        for (typename Image::x_iterator imgPtr = _image->row_begin(y), end = _image->row_end(y);
+             imgPtr != end; ++imgPtr, ++rhsImgPtr, ++varPtr, ++rhsVarPtr) {
+            ImagePixelT const lhsVal = *imgPtr;
+            ImagePixelT const rhsVal = *rhsImgPtr;
+            *varPtr = c2 * (lhsVal * lhsVal * *rhsVarPtr + rhsVal * rhsVal * *varPtr);
+            *imgPtr = lhsVal * static_cast<ImagePixelT>(c * rhsVal);
+        }
+    }
     *_mask |= *rhs.getMask();
 }
 
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::
 operator*=(ImagePixelT const rhs) {
+    _materializeVariance();
     *_image *= rhs;
     *_variance *= rhs * rhs;
     return *this;
@@ -366,6 +504,8 @@ struct scaledQuotientVariance {
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::
 operator/=(MaskedImage const& rhs) {
+    _materializeVariance();
+    rhs._materializeVariance();
     // Must do variance before we modify the image values
     transform_pixels(_image->_getRawView(),         // lhs
                      rhs._image->_getRawView(),     // rhs,
@@ -382,6 +522,8 @@ operator/=(MaskedImage const& rhs) {
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::scaledDivides(double const c,
                                                                          MaskedImage const& rhs) {
+    _materializeVariance();
+    rhs._materializeVariance();
     // Must do variance before we modify the image values
     transform_pixels(_image->_getRawView(),         // lhs
                      rhs._image->_getRawView(),     // rhs,
@@ -394,9 +536,29 @@ void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::scaledDivides(double
     *_mask |= *rhs._mask;
 }
 
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+std::size_t MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::setWhere(MaskPixelT const planeMask,
+                                                                           ImagePixelT const value) {
+    // The select is written branch-free so the compiler can turn the row loop
+    // into a vectorized mask-compare and blend; cf. scaledPlus for the fused
+    // row-pair traversal this shares.
+    std::size_t n = 0;
+    for (int y = 0; y != getHeight(); ++y) {
+        typename Mask::x_iterator mskPtr = _mask->row_begin(y);
+        for (typename Image::x_iterator imgPtr = _image->row_begin(y), end = _image->row_end(y);
+             imgPtr != end; ++imgPtr, ++mskPtr) {
+            bool const selected = (*mskPtr & planeMask) != 0;
+            *imgPtr = selected ? value : *imgPtr;
+            n += selected ? 1 : 0;
+        }
+    }
+    return n;
+}
+
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::
 operator/=(ImagePixelT const rhs) {
+    _materializeVariance();
     *_image /= rhs;
     *_variance /= rhs * rhs;
     return *this;
@@ -443,6 +605,7 @@ void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::writeFits(
         std::shared_ptr<daf::base::PropertySet const> imageMetadata,
         std::shared_ptr<daf::base::PropertySet const> maskMetadata,
         std::shared_ptr<daf::base::PropertySet const> varianceMetadata) const {
+    _materializeVariance();
     writeFits(fitsfile, fits::ImageWriteOptions(*_image), fits::ImageWriteOptions(*_mask),
               fits::ImageWriteOptions(*_variance), metadata, imageMetadata, maskMetadata, varianceMetadata);
 }
@@ -481,6 +644,7 @@ void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::writeFits(
         std::shared_ptr<daf::base::PropertySet const> imageMetadata,
         std::shared_ptr<daf::base::PropertySet const> maskMetadata,
         std::shared_ptr<daf::base::PropertySet const> varianceMetadata) const {
+    _materializeVariance();
     std::shared_ptr<daf::base::PropertySet> header;
     if (metadata) {
         header = metadata->deepCopy();
@@ -529,6 +693,11 @@ void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::conformSizes() {
         }
     }
 
+    if (_deferredVariance) {
+        // The plane is deferred to a generator; _materializeVariance checks the
+        // dimensions when it eventually runs.
+        return;
+    }
     if (!_variance || _variance->getWidth() == 0 || _variance->getHeight() == 0) {
         _variance = VariancePtr(new Variance(_image->getBBox()));
         *_variance = 0;
@@ -549,6 +718,7 @@ void MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::conformSizes() {
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 typename MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::iterator
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::begin() const {
+    _materializeVariance();
 #if 0  // this doesn't compile; why?
     return iterator(_image->begin(), _mask->begin(), _variance->begin());
 #else
@@ -583,6 +753,7 @@ MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::at(int const x, int const
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 typename MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::reverse_iterator
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::rbegin() const {
+    _materializeVariance();
     typename Image::reverse_iterator imageBegin = _image->rbegin();
     typename Mask::reverse_iterator maskBegin = _mask->rbegin();
     typename Variance::reverse_iterator varianceBegin = _variance->rbegin();
@@ -603,6 +774,7 @@ MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::rend() const {
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 typename MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::x_iterator
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::row_begin(int y) const {
+    _materializeVariance();
     typename Image::x_iterator imageBegin = _image->row_begin(y);
     typename Mask::x_iterator maskBegin = _mask->row_begin(y);
     typename Variance::x_iterator varianceBegin = _variance->row_begin(y);
@@ -623,6 +795,7 @@ MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::row_end(int y) const {
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 typename MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::y_iterator
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::col_begin(int x) const {
+    _materializeVariance();
     typename Image::y_iterator imageBegin = _image->col_begin(x);
     typename Mask::y_iterator maskBegin = _mask->col_begin(x);
     typename Variance::y_iterator varianceBegin = _variance->col_begin(x);
@@ -643,6 +816,7 @@ MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::col_end(int x) const {
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 typename MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::fast_iterator
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>::begin(bool contiguous) const {
+    _materializeVariance();
     typename Image::fast_iterator imageBegin = _image->begin(contiguous);
     typename Mask::fast_iterator maskBegin = _mask->begin(contiguous);
     typename Variance::fast_iterator varianceBegin = _variance->begin(contiguous);
@@ -41,10 +41,18 @@ fits::Fits * nextHdu(fits::Fits * fitsFile) {
     return fitsFile;
 }
 
+// Start asynchronous readahead of the whole file before opening it, so the
+// mask and variance HDUs stream into the page cache while the earlier HDUs
+// are being parsed and read.
+std::string const& prefetched(std::string const& fileName) {
+    fits::prefetchFitsFile(fileName);
+    return fileName;
+}
+
 } // anonymous
 
 MaskedImageFitsReader::MaskedImageFitsReader(std::string const& fileName, int hdu) :
-    _imageReader(fileName, hdu),
+    _imageReader(prefetched(fileName), hdu),
     _maskReader(nextHdu(_imageReader._fitsFile)),
     _varianceReader(nextHdu(_maskReader._fitsFile))
 {}
@@ -169,7 +177,7 @@ ndarray::Array<VariancePixelT, 2, 2> MaskedImageFitsReader::readVarianceArray(ls
 template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
 MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> MaskedImageFitsReader::read(
     lsst::geom::Box2I const & bbox, ImageOrigin origin,
-    bool conformMasks, bool needAllHdus, bool allowUnsafe
+    bool conformMasks, bool needAllHdus, bool allowUnsafe, bool lazyVariance
 ) {
     // When reading a standard Masked Image, we expect four HDUs:
     // * The primary (HDU 0) is empty;
@@ -221,6 +229,20 @@ MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> MaskedImageFitsReader::read
             throw LSST_EXCEPT(pex::exceptions::NotFoundError, "No mask extensions found");
         }
         if (_varianceReader._fitsFile) {
+            std::string const fileName = getFileName();
+            if (lazyVariance && !needAllHdus && !fileName.empty()) {
+                // Defer the variance plane: the generator reopens the file and
+                // reads just the variance HDU the first time the plane is
+                // touched.  With needAllHdus we must surface read errors now,
+                // and an in-memory file may not outlive the MaskedImage, so
+                // both fall through to the eager read.
+                return MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>(
+                        image, mask, [fileName, bbox, origin, allowUnsafe]() {
+                            MaskedImageFitsReader reader(fileName);
+                            return std::make_shared<Image<VariancePixelT>>(
+                                    reader.readVariance<VariancePixelT>(bbox, origin, allowUnsafe));
+                        });
+            }
             try {
                 variance = std::make_shared<Image<VariancePixelT>>(
                     _varianceReader.read<VariancePixelT>(bbox, origin, allowUnsafe)
@@ -245,7 +267,7 @@ MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> MaskedImageFitsReader::read
     template MaskedImage<ImagePixelT, MaskPixel, VariancePixel> MaskedImageFitsReader::read( \
         lsst::geom::Box2I const &, \
         ImageOrigin, \
-        bool, bool, bool \
+        bool, bool, bool, bool \
     ); \
     template Image<ImagePixelT> MaskedImageFitsReader::readImage(\
         lsst::geom::Box2I const &, \
@@ -94,6 +94,21 @@ void toNanojanskyVariance(ndarray::Array<float const, 2, 1> const &instFlux,
                (eigenInstFluxVar / eigenInstFlux.square() + (scaleErr / eigenFlux * eigenInstFlux).square());
 }
 
+/**
+ * As above, but for a spatially-constant calibration, where the scale is known.
+ *
+ * With a single scale the variance reduces to scale^2*instFluxVar + (scaleErr*instFlux)^2,
+ * which avoids the per-pixel divisions of the general form.
+ */
+void toNanojanskyVariance(ndarray::Array<float const, 2, 1> const &instFlux,
+                          ndarray::Array<float const, 2, 1> const &instFluxVar, float scaleErr, float scale,
+                          ndarray::Array<float, 2, 1> out) {
+    auto eigenInstFluxVar = ndarray::asEigen<Eigen::ArrayXpr>(instFluxVar);
+    auto eigenInstFlux = ndarray::asEigen<Eigen::ArrayXpr>(instFlux);
+    auto eigenOut = ndarray::asEigen<Eigen::ArrayXpr>(out);
+    eigenOut = scale * scale * eigenInstFluxVar + (scaleErr * eigenInstFlux).square();
+}
+
 double toMagnitudeErr(double instFlux, double instFluxErr, double scale, double scaleErr) {
     return 2.5 / log(10.0) * hypot(instFluxErr / instFlux, scaleErr / scale);
 }
@@ -263,18 +278,17 @@ MaskedImage<float> PhotoCalib::calibrateImage(MaskedImage<float> const &maskedIm
     // Deep copy construct, as we're mutiplying in-place.
     auto result = MaskedImage<float>(maskedImage, true);
 
+    float const scaleErr = includeScaleUncertainty ? _calibrationErr : 0.0;
     if (_isConstant) {
         *(result.getImage()) *= _calibrationMean;
+        toNanojanskyVariance(maskedImage.getImage()->getArray(), maskedImage.getVariance()->getArray(),
+                             scaleErr, _calibrationMean, result.getVariance()->getArray());
     } else {
+        // multiplyImage evaluates the BoundedField row-by-row and multiplies in
+        // place, so no intermediate calibration image is materialized.
         _calibration->multiplyImage(*(result.getImage()), true);  // only in the overlap region
-    }
-    if (includeScaleUncertainty) {
         toNanojanskyVariance(maskedImage.getImage()->getArray(), maskedImage.getVariance()->getArray(),
-                             _calibrationErr, result.getImage()->getArray(),
-                             result.getVariance()->getArray());
-    } else {
-        toNanojanskyVariance(maskedImage.getImage()->getArray(), maskedImage.getVariance()->getArray(), 0,
-                             result.getImage()->getArray(), result.getVariance()->getArray());
+                             scaleErr, result.getImage()->getArray(), result.getVariance()->getArray());
     }
 
     return result;
@@ -561,17 +575,27 @@ void PhotoCalib::instFluxToNanojanskyArray(afw::table::SourceCatalog const &sour
     auto instFluxErrKey = sourceCatalog.getSchema().find<double>(instFluxField + "_instFluxErr").key;
 
     auto calibration = evaluateCatalog(sourceCatalog);
-    int i = 0;
-    auto iter = result.begin();
+
+    // Gather the instrumental fluxes into contiguous arrays so the conversion
+    // and error propagation below vectorize over the whole catalog.
+    ndarray::Array<double, 1, 1> instFlux = ndarray::allocate(ndarray::makeVector(sourceCatalog.size()));
+    ndarray::Array<double, 1, 1> instFluxErr = ndarray::allocate(ndarray::makeVector(sourceCatalog.size()));
+    std::size_t i = 0;
     for (auto const &rec : sourceCatalog) {
-        double instFlux = rec.get(instFluxKey);
-        double instFluxErr = rec.get(instFluxErrKey);
-        double nanojansky = toNanojansky(instFlux, calibration[i]);
-        (*iter)[0] = nanojansky;
-        (*iter)[1] = toNanojanskyErr(instFlux, instFluxErr, calibration[i], _calibrationErr, nanojansky);
-        ++iter;
+        instFlux[i] = rec.get(instFluxKey);
+        instFluxErr[i] = rec.get(instFluxErrKey);
         ++i;
     }
+
+    auto eigenInstFlux = ndarray::asEigen<Eigen::ArrayXpr>(instFlux);
+    auto eigenInstFluxErr = ndarray::asEigen<Eigen::ArrayXpr>(instFluxErr);
+    auto eigenCalibration = ndarray::asEigen<Eigen::ArrayXpr>(calibration);
+    auto eigenResult = ndarray::asEigen<Eigen::ArrayXpr>(result);
+    eigenResult.col(0) = eigenInstFlux * eigenCalibration;
+    eigenResult.col(1) = eigenResult.col(0).abs() *
+                         ((eigenInstFluxErr / eigenInstFlux).square() +
+                          (_calibrationErr / eigenCalibration).square())
+                                 .sqrt();
 }
 
 void PhotoCalib::instFluxToMagnitudeArray(afw::table::SourceCatalog const &sourceCatalog,
@@ -581,16 +605,29 @@ void PhotoCalib::instFluxToMagnitudeArray(afw::table::SourceCatalog const &sourc
     auto instFluxErrKey = sourceCatalog.getSchema().find<double>(instFluxField + "_instFluxErr").key;
 
     auto calibration = evaluateCatalog(sourceCatalog);
-    auto iter = result.begin();
-    int i = 0;
+
+    // Gather the instrumental fluxes into contiguous arrays so the conversion
+    // and error propagation below vectorize over the whole catalog.
+    ndarray::Array<double, 1, 1> instFlux = ndarray::allocate(ndarray::makeVector(sourceCatalog.size()));
+    ndarray::Array<double, 1, 1> instFluxErr = ndarray::allocate(ndarray::makeVector(sourceCatalog.size()));
+    std::size_t i = 0;
     for (auto const &rec : sourceCatalog) {
-        double instFlux = rec.get(instFluxKey);
-        double instFluxErr = rec.get(instFluxErrKey);
-        (*iter)[0] = toMagnitude(instFlux, calibration[i]);
-        (*iter)[1] = toMagnitudeErr(instFlux, instFluxErr, calibration[i], _calibrationErr);
-        ++iter;
+        instFlux[i] = rec.get(instFluxKey);
+        instFluxErr[i] = rec.get(instFluxErrKey);
         ++i;
     }
+
+    auto eigenInstFlux = ndarray::asEigen<Eigen::ArrayXpr>(instFlux);
+    auto eigenInstFluxErr = ndarray::asEigen<Eigen::ArrayXpr>(instFluxErr);
+    auto eigenCalibration = ndarray::asEigen<Eigen::ArrayXpr>(calibration);
+    auto eigenResult = ndarray::asEigen<Eigen::ArrayXpr>(result);
+    // Expansion of utils::nanojanskyToABMagnitude, written as an Eigen
+    // expression so the whole column vectorizes.
+    eigenResult.col(0) = -2.5 * (eigenInstFlux * eigenCalibration / utils::referenceFlux).log10();
+    eigenResult.col(1) = 2.5 / std::log(10.0) *
+                         ((eigenInstFluxErr / eigenInstFlux).square() +
+                          (_calibrationErr / eigenCalibration).square())
+                                 .sqrt();
 }
 
 std::shared_ptr<PhotoCalib> makePhotoCalibFromMetadata(daf::base::PropertySet &metadata, bool strip) {
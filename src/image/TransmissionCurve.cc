@@ -30,6 +30,7 @@
 #include "gsl/gsl_errno.h"
 
 #include "lsst/afw/image/TransmissionCurve.h"
+#include "lsst/afw/table/aggregates.h"
 #include "lsst/afw/table/io/InputArchive.h"
 #include "lsst/afw/table/io/OutputArchive.h"
 #include "lsst/afw/table/io/CatalogVector.h"
@@ -601,6 +602,178 @@ private:
 
 TransformedTransmissionCurve::Factory TransformedTransmissionCurve::registration;
 
+/*
+ * CompiledTransmissionCurve: the tabulated curve returned by
+ * TransmissionCurve::compiledAt.
+ *
+ * Stores throughput sampled on regular spatial and wavelength grids (with the
+ * wavelength dimension fastest) and answers sampleAt with bilinear table
+ * lookups: four spatial weights computed once per call and a linear blend
+ * between adjacent wavelength samples per output element.
+ */
+class CompiledTransmissionCurve : public TransmissionCurve {
+public:
+    static constexpr char const* NAME = "CompiledTransmissionCurve";
+
+    CompiledTransmissionCurve(ndarray::Array<double, 3, 3> const& table,
+                              ndarray::Array<double, 1, 1> const& wavelengths, lsst::geom::Box2D const& bbox,
+                              std::pair<double, double> atBounds)
+            : _table(table), _wavelengths(wavelengths), _bbox(bbox), _atBounds(atBounds) {}
+
+    std::pair<double, double> getWavelengthBounds() const override {
+        return std::make_pair(_wavelengths.front(), _wavelengths.back());
+    }
+
+    std::pair<double, double> getThroughputAtBounds() const override { return _atBounds; }
+
+    void sampleAt(lsst::geom::Point2D const& position, ndarray::Array<double const, 1, 1> const& wavelengths,
+                  ndarray::Array<double, 1, 1> const& out) const override {
+        LSST_THROW_IF_NE(wavelengths.getSize<0>(), out.getSize<0>(), pex::exceptions::LengthError,
+                         "Length of wavelength array (%d) does not match size of output array (%d)");
+        int const ny = _table.getSize<0>();
+        int const nx = _table.getSize<1>();
+        std::size_t const nl = _wavelengths.getSize<0>();
+        // Fractional grid coordinates, clamped so that positions outside the
+        // compiled region use the value at its boundary.
+        double const gx = _toGrid(position.getX(), _bbox.getMinX(), _bbox.getWidth(), nx);
+        double const gy = _toGrid(position.getY(), _bbox.getMinY(), _bbox.getHeight(), ny);
+        int const ix = std::min(static_cast<int>(gx), std::max(nx - 2, 0));
+        int const iy = std::min(static_cast<int>(gy), std::max(ny - 2, 0));
+        double const fx = gx - ix;
+        double const fy = gy - iy;
+        auto const t00 = _table[iy][ix];
+        auto const t10 = _table[iy][std::min(ix + 1, nx - 1)];
+        auto const t01 = _table[std::min(iy + 1, ny - 1)][ix];
+        auto const t11 = _table[std::min(iy + 1, ny - 1)][std::min(ix + 1, nx - 1)];
+        double const w00 = (1.0 - fx) * (1.0 - fy);
+        double const w10 = fx * (1.0 - fy);
+        double const w01 = (1.0 - fx) * fy;
+        double const w11 = fx * fy;
+        auto blend = [&](std::size_t j) {
+            return w00 * t00[j] + w10 * t10[j] + w01 * t01[j] + w11 * t11[j];
+        };
+        // Left wavelength node of the last lookup, used as a hint: requested
+        // wavelengths are usually sorted, so the binary search rarely runs.
+        std::size_t k = 0;
+        auto wlIter = wavelengths.begin();
+        for (auto outIter = out.begin(); outIter != out.end(); ++outIter, ++wlIter) {
+            double const wl = *wlIter;
+            if (wl < _wavelengths.front()) {
+                *outIter = _atBounds.first;
+            } else if (wl > _wavelengths.back()) {
+                *outIter = _atBounds.second;
+            } else {
+                if (!(_wavelengths[k] <= wl && wl <= _wavelengths[k + 1])) {
+                    k = std::upper_bound(_wavelengths.begin(), _wavelengths.end(), wl) -
+                        _wavelengths.begin() - 1;
+                    k = std::min(k, nl - 2);
+                }
+                double const u = (wl - _wavelengths[k]) / (_wavelengths[k + 1] - _wavelengths[k]);
+                *outIter = (1.0 - u) * blend(k) + u * blend(k + 1);
+            }
+        }
+    }
+
+    bool isPersistable() const noexcept override { return true; }
+
+protected:
+    std::string getPersistenceName() const override { return NAME; }
+
+    struct PersistenceHelper {
+        table::Schema schema;
+        table::Key<double> throughputAtMin;
+        table::Key<double> throughputAtMax;
+        table::PointKey<double> min;
+        table::PointKey<double> max;
+        table::Key<int> gridX;
+        table::Key<int> gridY;
+        table::Key<table::Array<double>> wavelengths;
+        table::Key<table::Array<double>> throughput;
+
+        static PersistenceHelper const& get() {
+            static PersistenceHelper const instance;
+            return instance;
+        }
+
+    private:
+        PersistenceHelper()
+                : schema(),
+                  throughputAtMin(
+                          schema.addField<double>("throughputAtMin", "throughput below minimum wavelength")),
+                  throughputAtMax(
+                          schema.addField<double>("throughputAtMax", "throughput above minimum wavelength")),
+                  min(table::PointKey<double>::addFields(schema, "min", "minimum point of the spatial grid",
+                                                         "pixel")),
+                  max(table::PointKey<double>::addFields(schema, "max", "maximum point of the spatial grid",
+                                                         "pixel")),
+                  gridX(schema.addField<int>("gridX", "number of spatial grid points in x")),
+                  gridY(schema.addField<int>("gridY", "number of spatial grid points in y")),
+                  wavelengths(schema.addField<table::Array<double>>(
+                          "wavelengths", "array of tabulated wavelength values", "angstrom", 0)),
+                  throughput(schema.addField<table::Array<double>>(
+                          "throughput",
+                          "flattened 3-d array of tabulated throughput values, wavelength dimension fastest",
+                          "", 0)) {}
+    };
+
+    void write(OutputArchiveHandle& handle) const override {
+        auto const& keys = PersistenceHelper::get();
+        auto catalog = handle.makeCatalog(keys.schema);
+        auto record = catalog.addNew();
+        record->set(keys.throughputAtMin, _atBounds.first);
+        record->set(keys.throughputAtMax, _atBounds.second);
+        record->set(keys.min, _bbox.getMin());
+        record->set(keys.max, _bbox.getMax());
+        record->set(keys.gridX, static_cast<int>(_table.getSize<1>()));
+        record->set(keys.gridY, static_cast<int>(_table.getSize<0>()));
+        record->set(keys.wavelengths, _wavelengths);
+        record->set(keys.throughput, ndarray::flatten<1>(_table));
+        handle.saveCatalog(catalog);
+    }
+
+    class Factory : public table::io::PersistableFactory {
+    public:
+        std::shared_ptr<table::io::Persistable> read(InputArchive const& archive,
+                                                     CatalogVector const& catalogs) const override {
+            auto const& keys = PersistenceHelper::get();
+            LSST_ARCHIVE_ASSERT(catalogs.size() == 1u);
+            LSST_ARCHIVE_ASSERT(catalogs.front().getSchema() == keys.schema);
+            auto& record = catalogs.front().front();
+            ndarray::Array<double, 1, 1> wavelengths = ndarray::copy(record[keys.wavelengths]);
+            int const nx = record.get(keys.gridX);
+            int const ny = record.get(keys.gridY);
+            ndarray::Array<double, 3, 3> table =
+                    ndarray::allocate(ndarray::makeVector(ny, nx, static_cast<int>(wavelengths.size())));
+            ndarray::flatten<1>(table) = record[keys.throughput];
+            return std::make_shared<CompiledTransmissionCurve>(
+                    table, wavelengths,
+                    lsst::geom::Box2D(record.get(keys.min), record.get(keys.max)),
+                    std::make_pair(record.get(keys.throughputAtMin), record.get(keys.throughputAtMax)));
+        }
+
+        Factory() : table::io::PersistableFactory(NAME) {}
+    };
+
+    static Factory registration;
+
+private:
+    // Map a position to a fractional grid coordinate, clamped to the grid.
+    static double _toGrid(double value, double min, double extent, int n) {
+        if (n < 2) {
+            return 0.0;
+        }
+        double const g = (value - min) * (n - 1) / extent;
+        return std::min(std::max(g, 0.0), static_cast<double>(n - 1));
+    }
+
+    ndarray::Array<double, 3, 3> _table;
+    ndarray::Array<double, 1, 1> _wavelengths;
+    lsst::geom::Box2D _bbox;
+    std::pair<double, double> _atBounds;
+};
+
+CompiledTransmissionCurve::Factory CompiledTransmissionCurve::registration;
+
 }  // namespace
 
 /*
@@ -662,6 +835,34 @@ std::shared_ptr<TransmissionCurve const> TransmissionCurve::transformedBy(
     return _transformedByImpl(std::move(transform));
 }
 
+std::shared_ptr<TransmissionCurve const> TransmissionCurve::compiledAt(
+        ndarray::Array<double const, 1, 1> const& wavelengths, lsst::geom::Box2D const& bbox,
+        lsst::geom::Extent2I const& gridShape) const {
+    if (wavelengths.getSize<0>() < 2) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          "Wavelength grid must contain at least two elements");
+    }
+    if (gridShape.getX() < 1 || gridShape.getY() < 1 || bbox.isEmpty()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "Spatial grid shape must be positive and the bounding box must not be empty");
+    }
+    ndarray::Array<double, 1, 1> wavelengthsCopy = ndarray::copy(wavelengths);
+    int const nx = gridShape.getX();
+    int const ny = gridShape.getY();
+    ndarray::Array<double, 3, 3> table =
+            ndarray::allocate(ndarray::makeVector(ny, nx, static_cast<int>(wavelengthsCopy.size())));
+    double const dx = nx > 1 ? bbox.getWidth() / (nx - 1) : 0.0;
+    double const dy = ny > 1 ? bbox.getHeight() / (ny - 1) : 0.0;
+    for (int iy = 0; iy < ny; ++iy) {
+        for (int ix = 0; ix < nx; ++ix) {
+            lsst::geom::Point2D const position(bbox.getMinX() + ix * dx, bbox.getMinY() + iy * dy);
+            sampleAt(position, wavelengthsCopy, table[iy][ix]);
+        }
+    }
+    return std::make_shared<CompiledTransmissionCurve>(table, wavelengthsCopy, bbox,
+                                                       getThroughputAtBounds());
+}
+
 ndarray::Array<double, 1, 1> TransmissionCurve::sampleAt(
         lsst::geom::Point2D const& position, ndarray::Array<double const, 1, 1> const& wavelengths) const {
     ndarray::Array<double, 1, 1> out = ndarray::allocate(wavelengths.getSize<0>());
@@ -37,13 +37,38 @@ public:
     }
 
     std::shared_ptr<MaskDict> copyOrGetDefault(MaskPlaneDict const & mpd) {
+        if (mpd.empty()) {
+            // The common case (Mask construction with no explicit planes)
+            // never touches the mutex, so plane additions elsewhere cannot
+            // stall it.
+            return getDefault();
+        }
         std::lock_guard<std::recursive_mutex> lock(_mutex);
-        if (!mpd.empty()) {
-            std::shared_ptr<MaskDict> dict(new MaskDict(mpd));
-            _allMaskDicts.insert(dict);
-            return dict;
+        // Hash-cons on content: if an active MaskDict already holds these
+        // plane definitions, share it rather than copying the map.  The
+        // default dictionary is deliberately excluded: Mask branches on
+        // pointer identity with the default (removeAndClearMaskPlane), so
+        // e.g. a Mask read from FITS whose planes happen to match the
+        // defaults must not become an owner of the live default.  Masks
+        // never mutate a non-default dictionary they share
+        // (removeAndClearMaskPlane clones first), so sharing those is safe,
+        // and deliberate updates such as addAllMasksPlane want to reach
+        // every Mask with these definitions anyway.
+        std::size_t const hash = boost::hash<MaskPlaneDict>()(mpd);
+        std::shared_ptr<MaskDict> const defaultDict = getDefault();
+        _prune();
+        for (auto const & ptr : _allMaskDicts) {
+            std::shared_ptr<MaskDict> existing = ptr.lock();
+            if (existing && existing != defaultDict) {
+                auto const snapshot = existing->_load();
+                if (snapshot->hash == hash && snapshot->dict == mpd) {
+                    return existing;
+                }
+            }
         }
-        return _defaultMaskDict;
+        std::shared_ptr<MaskDict> dict(new MaskDict(mpd));
+        _allMaskDicts.insert(dict);
+        return dict;
     }
 
     std::shared_ptr<MaskDict> copy(MaskDict const & dict) {
@@ -54,17 +79,20 @@ public:
     }
 
     std::shared_ptr<MaskDict> getDefault() const noexcept {
-        return _defaultMaskDict;
+        // Lock-free: the default is only ever replaced wholesale, via
+        // atomic_store below.
+        return std::atomic_load_explicit(&_defaultMaskDict, std::memory_order_acquire);
     }
 
     void setDefault(std::shared_ptr<MaskDict> dict) {
-        _defaultMaskDict = std::move(dict);
+        std::atomic_store_explicit(&_defaultMaskDict, std::move(dict), std::memory_order_release);
     }
 
     std::shared_ptr<MaskDict> detachDefault() {
         std::lock_guard<std::recursive_mutex> lock(_mutex);
-        _defaultMaskDict = copy(*_defaultMaskDict);
-        return _defaultMaskDict;
+        std::shared_ptr<MaskDict> result = copy(*getDefault());
+        setDefault(result);
+        return result;
     }
 
     template <typename Functor>
@@ -103,9 +131,11 @@ private:
         }
     }
 
-    std::recursive_mutex _mutex;  // guards _allMaskDicts and synchronizes updates to it and _defaultMaskDict
+    // Guards _allMaskDicts and serializes mutations; readers of
+    // _defaultMaskDict and of the individual dictionaries are lock-free.
+    std::recursive_mutex _mutex;
     std::set<std::weak_ptr<MaskDict>, std::owner_less<std::weak_ptr<MaskDict>>> _allMaskDicts;
-    std::shared_ptr<MaskDict> _defaultMaskDict;
+    std::shared_ptr<MaskDict> _defaultMaskDict;  // all access via atomic_load/atomic_store
 };
 
 std::shared_ptr<MaskDict> MaskDict::copyOrGetDefault(MaskPlaneDict const& mpd) {
@@ -148,24 +178,26 @@ std::shared_ptr<MaskDict> MaskDict::clone() const {
 }
 
 int MaskDict::getUnusedPlane() const {
-    if (empty()) {
+    auto const snapshot = _load();
+    MaskPlaneDict const & dict = snapshot->dict;
+    if (dict.empty()) {
         return 0;
     }
 
     auto const maxIter = std::max_element(
-        begin(), end(),
+        dict.begin(), dict.end(),
         [](auto const & a, auto const & b) { return a.second < b.second; }
     );
-    assert(maxIter != end());
+    assert(maxIter != dict.end());
     int id = maxIter->second + 1;  // The maskPlane to use if there are no gaps
 
     for (int i = 0; i < id; ++i) {
         // is i already used in this Mask?
         auto const sameIter = std::find_if(
-            begin(), end(),
+            dict.begin(), dict.end(),
             [i](auto const & item) { return item.second == i; }
         );
-        if (sameIter == end()) {  // Not used; so we'll use it
+        if (sameIter == dict.end()) {  // Not used; so we'll use it
             return i;
         }
     }
@@ -174,51 +206,68 @@ int MaskDict::getUnusedPlane() const {
 }
 
 int MaskDict::getMaskPlane(std::string const & name) const {
-    auto iter = find(name);
-    return (iter == end()) ? -1 : iter->second;
+    auto const snapshot = _load();
+    auto iter = snapshot->dict.find(name);
+    return (iter == snapshot->dict.end()) ? -1 : iter->second;
 }
 
 void MaskDict::print() const {
-    for (auto const & item : *this) {
+    auto const snapshot = _load();
+    for (auto const & item : snapshot->dict) {
         std::cout << "Plane " << item.second << " -> " << item.first << std::endl;
     }
 }
 
 bool MaskDict::operator==(MaskDict const& rhs) const {
-    return this == &rhs || (_hash == rhs._hash && _dict == rhs._dict);
+    if (this == &rhs) {
+        return true;
+    }
+    auto const lhsSnapshot = _load();
+    auto const rhsSnapshot = rhs._load();
+    return lhsSnapshot->hash == rhsSnapshot->hash && lhsSnapshot->dict == rhsSnapshot->dict;
 }
 
 void MaskDict::add(std::string const & name, int bitId) {
-    _dict[name] = bitId;
-    _hash = boost::hash<MaskPlaneDict>()(_dict);
+    MaskPlaneDict dict = _load()->dict;
+    dict[name] = bitId;
+    _store(std::make_shared<Snapshot const>(dict));
 }
 
 void MaskDict::erase(std::string const & name) {
-    _dict.erase(name);
-    _hash = boost::hash<MaskPlaneDict>()(_dict);
+    MaskPlaneDict dict = _load()->dict;
+    dict.erase(name);
+    _store(std::make_shared<Snapshot const>(dict));
 }
 
 void MaskDict::clear() {
-    _dict.clear();
-    _hash = 0x0;
+    _store(std::make_shared<Snapshot const>());
 }
 
 void MaskDict::_addInitialMaskPlanes() {
+    MaskPlaneDict dict;
     int i = -1;
-    _dict["BAD"] = ++i;
-    _dict["SAT"] = ++i;
-    _dict["INTRP"] = ++i;
-    _dict["CR"] = ++i;
-    _dict["EDGE"] = ++i;
-    _dict["DETECTED"] = ++i;
-    _dict["DETECTED_NEGATIVE"] = ++i;
-    _dict["SUSPECT"] = ++i;
-    _dict["NO_DATA"] = ++i;
-    _hash = boost::hash<MaskPlaneDict>()(_dict);
+    dict["BAD"] = ++i;
+    dict["SAT"] = ++i;
+    dict["INTRP"] = ++i;
+    dict["CR"] = ++i;
+    dict["EDGE"] = ++i;
+    dict["DETECTED"] = ++i;
+    dict["DETECTED_NEGATIVE"] = ++i;
+    dict["SUSPECT"] = ++i;
+    dict["NO_DATA"] = ++i;
+    _store(std::make_shared<Snapshot const>(dict));
 }
 
-MaskDict::MaskDict() : _dict(), _hash(0x0) {}
+MaskDict::Snapshot::Snapshot() : dict(), hash(0x0) {}
+
+MaskDict::Snapshot::Snapshot(MaskPlaneDict const & dict_)
+        : dict(dict_), hash(boost::hash<MaskPlaneDict>()(dict)) {}
+
+MaskDict::MaskDict() : _data(std::make_shared<Snapshot const>()) {}
+
+MaskDict::MaskDict(MaskPlaneDict const & dict) : _data(std::make_shared<Snapshot const>(dict)) {}
 
-MaskDict::MaskDict(MaskPlaneDict const & dict) : _dict(dict), _hash(boost::hash<MaskPlaneDict>()(_dict)) {}
+// Snapshots are immutable, so the copy can share the source's current one.
+MaskDict::MaskDict(MaskDict const & other) : _data(other._load()) {}
 
 }}}} // lsst::afw::image::detail
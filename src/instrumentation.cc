@@ -0,0 +1,123 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#include <array>
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+
+#include "lsst/afw/instrumentation.h"
+
+namespace lsst {
+namespace afw {
+namespace instrumentation {
+
+namespace {
+
+constexpr std::size_t NUM_METRICS = static_cast<std::size_t>(Metric::NUM_METRICS);
+
+// Order must match the Metric enumerators.
+constexpr char const *METRIC_NAMES[NUM_METRICS] = {
+        "convolve.calls",        "convolve.nanos",
+        "warp.calls",            "warp.nanos",
+        "statistics.calls",      "statistics.nanos",
+        "stack.calls",           "stack.nanos",
+        "fits.bytesRead",        "fits.bytesWritten",
+        "fits.headerCacheHits",  "fits.headerCacheMisses",
+        "psf.cacheHits",         "psf.cacheMisses",
+        "table.blockAllocations", "table.blockBytes",
+};
+
+// Every thread accumulates into its own slot; the values are atomics only so
+// that snapshot() can read them from another thread without tearing.
+struct Slot {
+    std::array<std::atomic<std::uint64_t>, NUM_METRICS> counts{};
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::list<std::shared_ptr<Slot>> slots;                          // slots of live threads
+    std::array<std::uint64_t, NUM_METRICS> retired{};                // folded totals of exited threads
+};
+
+Registry &getRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+// Registers the slot on construction and folds it into the retired totals on
+// thread exit, so counts survive their thread.
+struct SlotHolder {
+    SlotHolder() : slot(std::make_shared<Slot>()) {
+        Registry &registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        registry.slots.push_back(slot);
+    }
+
+    ~SlotHolder() {
+        Registry &registry = getRegistry();
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        for (std::size_t i = 0; i < NUM_METRICS; ++i) {
+            registry.retired[i] += slot->counts[i].load(std::memory_order_relaxed);
+        }
+        registry.slots.remove(slot);
+    }
+
+    std::shared_ptr<Slot> slot;
+};
+
+Slot &getSlot() {
+    thread_local SlotHolder holder;
+    return *holder.slot;
+}
+
+}  // namespace
+
+void add(Metric metric, std::uint64_t amount) noexcept {
+    getSlot().counts[static_cast<std::size_t>(metric)].fetch_add(amount, std::memory_order_relaxed);
+}
+
+std::map<std::string, std::uint64_t> snapshot() {
+    std::array<std::uint64_t, NUM_METRICS> totals{};
+    Registry &registry = getRegistry();
+    {
+        std::lock_guard<std::mutex> lock(registry.mutex);
+        totals = registry.retired;
+        for (auto const &slot : registry.slots) {
+            for (std::size_t i = 0; i < NUM_METRICS; ++i) {
+                totals[i] += slot->counts[i].load(std::memory_order_relaxed);
+            }
+        }
+    }
+    std::map<std::string, std::uint64_t> result;
+    for (std::size_t i = 0; i < NUM_METRICS; ++i) {
+        result[METRIC_NAMES[i]] = totals[i];
+    }
+    return result;
+}
+
+}  // namespace instrumentation
+}  // namespace afw
+}  // namespace lsst
@@ -21,9 +21,13 @@
  * the GNU General Public License along with this program.  If not,
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
+#include <cmath>
 #include <sstream>
+#include <typeinfo>
+#include <vector>
 
 #include "lsst/pex/exceptions.h"
+#include "lsst/afw/math/FunctionLibrary.h"
 #include "lsst/afw/math/Kernel.h"
 #include "lsst/afw/math/KernelPersistenceHelper.h"
 #include "lsst/afw/table/io/Persistable.cc"
@@ -108,18 +112,175 @@ std::vector<double> AnalyticKernel::getKernelParameters() const {
 //
 // Protected Member Functions
 //
-double AnalyticKernel::doComputeImage(image::Image<Pixel> &image, bool doNormalize) const {
+
+namespace {
+
+typedef image::Image<Kernel::Pixel> KernelImage;
+
+/*
+ * Specialized rasterization plans for the common kernel function families.
+ *
+ * Each produces the same pixel values as evaluating the function at every pixel (up to
+ * round-off where the factorization changes the arithmetic), but avoids the per-pixel
+ * virtual call through Function2 and exploits the structure of the function:
+ * separability for Gaussians and row-wise Horner evaluation for polynomials.
+ */
+
+/// Rasterize a GaussianFunction2; fully separable when the angle is zero
+double computeGaussianImage(KernelImage &image, std::vector<double> const &params) {
+    double const sigma1 = params[0];
+    double const sigma2 = params[1];
+    double const angle = params[2];
+    double const multFac = 1.0 / (lsst::geom::TWOPI * sigma1 * sigma2);
+    int const width = image.getWidth();
+    int const height = image.getHeight();
     double imSum = 0;
-    for (int y = 0; y != image.getHeight(); ++y) {
-        double const fy = image.indexToPosition(y, image::Y);
-        image::Image<Pixel>::x_iterator ptr = image.row_begin(y);
-        for (int x = 0; x != image.getWidth(); ++x, ++ptr) {
+    if (angle == 0.0) {
+        // one exp per row and per column instead of one per pixel
+        std::vector<double> xExp(width);
+        for (int x = 0; x != width; ++x) {
             double const fx = image.indexToPosition(x, image::X);
-            Pixel const pixelVal = (*_kernelFunctionPtr)(fx, fy);
+            xExp[x] = std::exp(-(fx * fx) / (2.0 * sigma1 * sigma1));
+        }
+        for (int y = 0; y != height; ++y) {
+            double const fy = image.indexToPosition(y, image::Y);
+            double const rowFac = multFac * std::exp(-(fy * fy) / (2.0 * sigma2 * sigma2));
+            KernelImage::x_iterator ptr = image.row_begin(y);
+            for (int x = 0; x != width; ++x, ++ptr) {
+                Kernel::Pixel const pixelVal = rowFac * xExp[x];
+                *ptr = pixelVal;
+                imSum += pixelVal;
+            }
+        }
+    } else {
+        // collapse the rotation into a quadratic in x with per-row coefficients
+        double const cosAngle = std::cos(angle);
+        double const sinAngle = std::sin(angle);
+        double const inv1 = 1.0 / (2.0 * sigma1 * sigma1);
+        double const inv2 = 1.0 / (2.0 * sigma2 * sigma2);
+        double const axx = (cosAngle * cosAngle * inv1) + (sinAngle * sinAngle * inv2);
+        double const axy = 2.0 * cosAngle * sinAngle * (inv1 - inv2);
+        double const ayy = (sinAngle * sinAngle * inv1) + (cosAngle * cosAngle * inv2);
+        for (int y = 0; y != height; ++y) {
+            double const fy = image.indexToPosition(y, image::Y);
+            double const bx = axy * fy;
+            double const cc = ayy * fy * fy;
+            KernelImage::x_iterator ptr = image.row_begin(y);
+            for (int x = 0; x != width; ++x, ++ptr) {
+                double const fx = image.indexToPosition(x, image::X);
+                Kernel::Pixel const pixelVal = multFac * std::exp(-((((axx * fx) + bx) * fx) + cc));
+                *ptr = pixelVal;
+                imSum += pixelVal;
+            }
+        }
+    }
+    return imSum;
+}
+
+/// Rasterize a DoubleGaussianFunction2; both circular Gaussians are separable
+double computeDoubleGaussianImage(KernelImage &image, std::vector<double> const &params) {
+    double const sigma1Sq = params[0] * params[0];
+    double const sigma2Sq = params[1] * params[1];
+    double const b = params[2];
+    double const multFac = 1.0 / (lsst::geom::TWOPI * (sigma1Sq + (b * sigma2Sq)));
+    int const width = image.getWidth();
+    int const height = image.getHeight();
+    double imSum = 0;
+    std::vector<double> xExp1(width);
+    std::vector<double> xExp2(width);
+    for (int x = 0; x != width; ++x) {
+        double const fx = image.indexToPosition(x, image::X);
+        xExp1[x] = std::exp(-(fx * fx) / (2.0 * sigma1Sq));
+        xExp2[x] = std::exp(-(fx * fx) / (2.0 * sigma2Sq));
+    }
+    for (int y = 0; y != height; ++y) {
+        double const fy = image.indexToPosition(y, image::Y);
+        double const yExp1 = std::exp(-(fy * fy) / (2.0 * sigma1Sq));
+        double const yExp2 = std::exp(-(fy * fy) / (2.0 * sigma2Sq));
+        KernelImage::x_iterator ptr = image.row_begin(y);
+        for (int x = 0; x != width; ++x, ++ptr) {
+            Kernel::Pixel const pixelVal = multFac * ((xExp1[x] * yExp1) + (b * xExp2[x] * yExp2));
             *ptr = pixelVal;
             imSum += pixelVal;
         }
     }
+    return imSum;
+}
+
+/**
+ * Rasterize a PolynomialFunction2
+ *
+ * Collapses y into x-coefficients once per row using the same triangular scheme as
+ * PolynomialFunction2::operator(), then runs Horner's rule across the row.
+ */
+double computePolynomialImage(KernelImage &image, std::vector<double> const &params, int order) {
+    int const width = image.getWidth();
+    int const height = image.getHeight();
+    std::vector<double> xCoeffs(order + 1);
+    double imSum = 0;
+    for (int y = 0; y != height; ++y) {
+        double const fy = image.indexToPosition(y, image::Y);
+
+        int paramInd = static_cast<int>(params.size()) - 1;
+        for (int xCoeffInd = 0; xCoeffInd <= order; ++xCoeffInd, --paramInd) {
+            xCoeffs[xCoeffInd] = params[paramInd];
+        }
+        for (int xCoeffInd = 0, endXCoeffInd = order; paramInd >= 0; --paramInd) {
+            xCoeffs[xCoeffInd] = (xCoeffs[xCoeffInd] * fy) + params[paramInd];
+            ++xCoeffInd;
+            if (xCoeffInd >= endXCoeffInd) {
+                xCoeffInd = 0;
+                --endXCoeffInd;
+            }
+        }
+
+        KernelImage::x_iterator ptr = image.row_begin(y);
+        for (int x = 0; x != width; ++x, ++ptr) {
+            double const fx = image.indexToPosition(x, image::X);
+            double retVal = xCoeffs[order];
+            for (int xCoeffInd = order - 1; xCoeffInd >= 0; --xCoeffInd) {
+                retVal = (retVal * fx) + xCoeffs[xCoeffInd];
+            }
+            *ptr = static_cast<Kernel::Pixel>(retVal);
+            imSum += retVal;
+        }
+    }
+    return imSum;
+}
+
+}  // namespace
+
+double AnalyticKernel::doComputeImage(image::Image<Pixel> &image, bool doNormalize) const {
+    double imSum = 0;
+    Function2<Pixel> const &func = *_kernelFunctionPtr;
+    auto const &funcType = typeid(func);
+    // Use a specialized plan for the function families that dominate kernel rasterization;
+    // exact type matches only, so subclasses with redefined operator() take the generic path
+    if (funcType == typeid(GaussianFunction2<Pixel>)) {
+        imSum = computeGaussianImage(image, func.getParameters());
+    } else if (funcType == typeid(DoubleGaussianFunction2<Pixel>)) {
+        imSum = computeDoubleGaussianImage(image, func.getParameters());
+    } else if (funcType == typeid(PolynomialFunction2<Pixel>)) {
+        imSum = computePolynomialImage(image, func.getParameters(),
+                                       static_cast<PolynomialFunction2<Pixel> const &>(func).getOrder());
+    } else {
+        // Evaluate one row at a time so evaluateFunction2Row can devirtualize the function
+        // types it knows about; anything else falls back to one virtual call per pixel
+        int const width = image.getWidth();
+        std::vector<double> xList(width);
+        for (int x = 0; x != width; ++x) {
+            xList[x] = image.indexToPosition(x, image::X);
+        }
+        for (int y = 0; y != image.getHeight(); ++y) {
+            double const fy = image.indexToPosition(y, image::Y);
+            Pixel *ptr = &*image.row_begin(y);
+            evaluateFunction2Row<IntegerDeltaFunction2<Pixel>, LanczosFunction2<Pixel>>(func, xList.data(),
+                                                                                        fy, ptr, width);
+            for (int x = 0; x != width; ++x) {
+                imSum += ptr[x];
+            }
+        }
+    }
 
     if (doNormalize && (imSum != 1)) {
         if (imSum == 0) {
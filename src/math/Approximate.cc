@@ -28,8 +28,12 @@
 #include <limits>
 #include <algorithm>
 #include <cmath>
+#include <cstddef>
+#include <exception>
 #include <memory>
+#include <mutex>
 #include <numeric>
+#include <vector>
 #include "Eigen/Core"
 #include "Eigen/LU"
 #include "boost/format.hpp"
@@ -37,14 +41,19 @@
 #include "lsst/afw/math/FunctionLibrary.h"
 #include "lsst/afw/image/MaskedImage.h"
 #include "lsst/afw/math/Approximate.h"
+#include "lsst/afw/math/TaskPool.h"
 
 namespace lsst {
 namespace ex = pex::exceptions;
 namespace afw {
 namespace math {
 
-ApproximateControl::ApproximateControl(Style style, int orderX, int orderY, bool weighting)
-        : _style(style), _orderX(orderX), _orderY(orderY < 0 ? orderX : orderY), _weighting(weighting) {
+ApproximateControl::ApproximateControl(Style style, int orderX, int orderY, bool weighting, int numThreads)
+        : _style(style),
+          _orderX(orderX),
+          _orderY(orderY < 0 ? orderX : orderY),
+          _weighting(weighting),
+          _numThreads(numThreads) {
     if (_orderX != _orderY) {
         throw LSST_EXCEPT(lsst::pex::exceptions::InvalidParameterError,
                           str(boost::format("X- and Y-orders must be equal (%d != %d) "
@@ -88,6 +97,84 @@ inline void solveMatrix_Eigen(Eigen::MatrixXd& a, Eigen::VectorXd& b, Eigen::Map
     Eigen::PartialPivLU<Eigen::MatrixXd> lu(a);
     c = lu.solve(b);
 }
+
+/*
+ * The basis evaluations termCoeffs[i][alpha] depend only on the fit geometry -- the sample
+ * positions, the bounding box and the polynomial order -- which iterative callers (notably the
+ * sky-background approximation) reuse unchanged call after call. Keep the most recently used
+ * grid for the life of the process, guarded by a mutex.
+ */
+struct ChebyshevBasisGrid {
+    int order;
+    int width;
+    int height;
+    lsst::geom::Box2I bbox;
+    std::vector<double> xVec;
+    std::vector<double> yVec;
+    std::shared_ptr<std::vector<std::vector<double>> const> termCoeffs;
+};
+
+std::mutex chebyshevBasisGridMutex;
+ChebyshevBasisGrid chebyshevBasisGrid;
+
+/**
+ * @internal Return termCoeffs[i][alpha]: basis term i evaluated at data point alpha.
+ *
+ * Reuses the memoized grid when the geometry is unchanged; otherwise computes the grid,
+ * dividing the rows over numThreads threads, and memoizes it.
+ */
+std::shared_ptr<std::vector<std::vector<double>> const> getChebyshevBasisGrid(
+        int order, int width, int height, lsst::geom::Box2I const& bbox, std::vector<double> const& xVec,
+        std::vector<double> const& yVec, int nTerm, int numThreads) {
+    {
+        std::lock_guard<std::mutex> lock(chebyshevBasisGridMutex);
+        if (chebyshevBasisGrid.termCoeffs && chebyshevBasisGrid.order == order &&
+            chebyshevBasisGrid.width == width && chebyshevBasisGrid.height == height &&
+            chebyshevBasisGrid.bbox == bbox && chebyshevBasisGrid.xVec == xVec &&
+            chebyshevBasisGrid.yVec == yVec) {
+            return chebyshevBasisGrid.termCoeffs;
+        }
+    }
+
+    auto termCoeffs = std::make_shared<std::vector<std::vector<double>>>(nTerm);
+    for (int i = 0; i != nTerm; ++i) {
+        (*termCoeffs)[i].resize(static_cast<std::size_t>(width) * height);
+    }
+
+    // each band of rows is filled by one thread with its own copy of the polynomial,
+    // since evaluating one term at a time works by setting that term's coefficient
+    auto fillRows = [order, width, &bbox, &xVec, &yVec, nTerm, &termCoeffs](int beginY, int endY) {
+        math::Chebyshev1Function2<double> poly(order, lsst::geom::Box2D(bbox));
+        for (int i = 0; i != nTerm; ++i) {
+            poly.setParameter(i, 1.0);
+            std::vector<double>& coeffs = (*termCoeffs)[i];
+            for (int iy = beginY; iy != endY; ++iy) {
+                double const y = yVec[iy];
+                std::size_t alpha = static_cast<std::size_t>(iy) * width;
+                for (int ix = 0; ix != width; ++ix, ++alpha) {
+                    coeffs[alpha] = poly(xVec[ix], y);
+                }
+            }
+            poly.setParameter(i, 0.0);
+        }
+    };
+    if (numThreads > 1 && height > 1) {
+        int const numBands = std::min(numThreads, height);
+        TaskPool::TaskGroup group;
+        for (int band = 0; band != numBands; ++band) {
+            int const beginY = band * height / numBands;
+            int const endY = (band + 1) * height / numBands;
+            group.run([&fillRows, beginY, endY] { fillRows(beginY, endY); });
+        }
+        group.wait();
+    } else {
+        fillRows(0, height);
+    }
+
+    std::lock_guard<std::mutex> lock(chebyshevBasisGridMutex);
+    chebyshevBasisGrid = ChebyshevBasisGrid{order, width, height, bbox, xVec, yVec, termCoeffs};
+    return termCoeffs;
+}
 }  // namespace
 
 /**
@@ -110,67 +197,78 @@ ApproximateChebyshev<PixelT>::ApproximateChebyshev(
                0.0);  // i.e. coeffs is initialised to 0.0
     }
 #endif
-    int const nTerm = _poly.getNParameters();          // number of terms in polynomial
-    int const nData = im.getWidth() * im.getHeight();  // number of data points
-                                                       /*
-                                                        * N.b. in the comments,
-                                                        *      i     runs over the 0..nTerm-1 coefficients
-                                                        *      alpha runs over the 0..nData-1 data points
-                                                        */
+    int const nTerm = _poly.getNParameters();  // number of terms in polynomial
+    int const numThreads = ctrl.getNumThreads();
+    /*
+     * N.b. in the comments,
+     *      i     runs over the 0..nTerm-1 coefficients
+     *      alpha runs over the 0..nData-1 data points
+     */
 
     /*
      * We need the value of the polynomials evaluated at every data point, so it's more
-     * efficient to pre-calculate the values:  termCoeffs[i][alpha]
+     * efficient to pre-calculate the values:  termCoeffs[i][alpha]. The grid depends only
+     * on the fit geometry, so it is memoized across calls and its rows are computed in
+     * parallel when more than one thread is requested.
      */
-    std::vector<std::vector<double>> termCoeffs(nTerm);
-
-    for (int i = 0; i != nTerm; ++i) {
-        termCoeffs[i].reserve(nData);
-    }
+    std::shared_ptr<std::vector<std::vector<double>> const> termCoeffsPtr = getChebyshevBasisGrid(
+            ctrl.getOrderX(), im.getWidth(), im.getHeight(), bbox, xVec, yVec, nTerm, numThreads);
+    std::vector<std::vector<double>> const& termCoeffs = *termCoeffsPtr;
 
-    for (int iy = 0; iy != im.getHeight(); ++iy) {
-        double const y = yVec[iy];
-
-        for (int ix = 0; ix != im.getWidth(); ++ix) {
-            double const x = xVec[ix];
-
-            for (int i = 0; i != nTerm; ++i) {
-                _poly.setParameter(i, 1.0);
-                termCoeffs[i].push_back(_poly(x, y));
-                _poly.setParameter(i, 0.0);
-            }
-        }
-    }
     // We'll solve A*c = b
     Eigen::MatrixXd A;
     A.setZero(nTerm, nTerm);  // We'll solve A*c = b
     Eigen::VectorXd b;
     b.setZero(nTerm);
     /*
-     * Go through the data accumulating the values of the A and b matrix/vector
+     * Go through the data accumulating the values of the A and b matrix/vector;
+     * each thread accumulates a band of rows into its own A and b, summed after the join
      */
-    int alpha = 0;
-    for (int iy = 0; iy != im.getHeight(); ++iy) {
-        for (typename image::MaskedImage<PixelT>::const_x_iterator ptr = im.row_begin(iy),
-                                                                   end = im.row_end(iy);
-             ptr != end; ++ptr, ++alpha) {
-            double const val = ptr.image();
-            double const ivar = ctrl.getWeighting() ? 1 / ptr.variance() : 1.0;
-            if (!std::isfinite(val + ivar)) {
-                continue;
-            }
+    auto accumulateRows = [&im, &ctrl, &termCoeffs, nTerm](int beginY, int endY, Eigen::MatrixXd& bandA,
+                                                           Eigen::VectorXd& bandB) {
+        for (int iy = beginY; iy != endY; ++iy) {
+            int alpha = iy * im.getWidth();
+            for (typename image::MaskedImage<PixelT>::const_x_iterator ptr = im.row_begin(iy),
+                                                                       end = im.row_end(iy);
+                 ptr != end; ++ptr, ++alpha) {
+                double const val = ptr.image();
+                double const ivar = ctrl.getWeighting() ? 1 / ptr.variance() : 1.0;
+                if (!std::isfinite(val + ivar)) {
+                    continue;
+                }
 
-            for (int i = 0; i != nTerm; ++i) {
-                double const c_i = termCoeffs[i][alpha];
-                double const tmp = c_i * ivar;
-                b(i) += val * tmp;
-                A(i, i) += c_i * tmp;
-                for (int j = 0; j < i; ++j) {
-                    double const c_j = termCoeffs[j][alpha];
-                    A(i, j) += c_j * tmp;
+                for (int i = 0; i != nTerm; ++i) {
+                    double const c_i = termCoeffs[i][alpha];
+                    double const tmp = c_i * ivar;
+                    bandB(i) += val * tmp;
+                    bandA(i, i) += c_i * tmp;
+                    for (int j = 0; j < i; ++j) {
+                        double const c_j = termCoeffs[j][alpha];
+                        bandA(i, j) += c_j * tmp;
+                    }
                 }
             }
         }
+    };
+    if (numThreads > 1 && im.getHeight() > 1) {
+        int const numBands = std::min(numThreads, im.getHeight());
+        std::vector<Eigen::MatrixXd> bandA(numBands, Eigen::MatrixXd::Zero(nTerm, nTerm));
+        std::vector<Eigen::VectorXd> bandB(numBands, Eigen::VectorXd::Zero(nTerm));
+        TaskPool::TaskGroup group;
+        for (int band = 0; band != numBands; ++band) {
+            int const beginY = band * im.getHeight() / numBands;
+            int const endY = (band + 1) * im.getHeight() / numBands;
+            group.run([&accumulateRows, &bandA, &bandB, band, beginY, endY] {
+                accumulateRows(beginY, endY, bandA[band], bandB[band]);
+            });
+        }
+        group.wait();
+        for (int band = 0; band != numBands; ++band) {
+            A += bandA[band];
+            b += bandB[band];
+        }
+    } else {
+        accumulateRows(0, im.getHeight(), A, b);
     }
     if (A.isZero()) {
         if (ctrl.getWeighting()) {
@@ -114,6 +114,116 @@ void Background::_setCenOrigSize(int const width, int const height, int const nx
     }
 }
 
+template <typename PixelT>
+IterativeBackgroundSubtractor<PixelT>::IterativeBackgroundSubtractor(BackgroundControl const& bgCtrl)
+        : _bctrl(new BackgroundControl(bgCtrl)), _background(), _maskHashes() {}
+
+template <typename PixelT>
+std::size_t IterativeBackgroundSubtractor<PixelT>::_hashCellMask(image::Mask<image::MaskPixel> const& mask,
+                                                                 lsst::geom::Box2I const& cellBox) const {
+    image::Mask<image::MaskPixel> const sub(mask, cellBox, image::LOCAL);
+    std::size_t hash = 17;
+    for (int y = 0; y != sub.getHeight(); ++y) {
+        for (auto ptr = sub.row_begin(y), end = sub.row_end(y); ptr != end; ++ptr) {
+            hash = hash * 1099511628211ULL ^ static_cast<std::size_t>(*ptr);
+        }
+    }
+    return hash;
+}
+
+template <typename PixelT>
+void IterativeBackgroundSubtractor<PixelT>::_subtractModel(image::MaskedImage<PixelT>& image,
+                                                           Background const& model) const {
+    int const bandHeight = 256;
+    lsst::geom::Box2I const bbox = image.getBBox();
+    image::Image<PixelT>& im = *image.getImage();
+    for (int y0 = 0; y0 < bbox.getHeight(); y0 += bandHeight) {
+        int const height = std::min(bandHeight, bbox.getHeight() - y0);
+        lsst::geom::Box2I const bandBox(lsst::geom::Point2I(bbox.getMinX(), bbox.getMinY() + y0),
+                                        lsst::geom::Extent2I(bbox.getWidth(), height));
+        std::shared_ptr<image::Image<Background::InternalPixelT>> band =
+                model.getImage<Background::InternalPixelT>(bandBox, _bctrl->getInterpStyle(),
+                                                           _bctrl->getUndersampleStyle());
+        for (int y = 0; y != height; ++y) {
+            auto bandPtr = band->row_begin(y);
+            for (auto ptr = im.row_begin(y0 + y), end = im.row_end(y0 + y); ptr != end; ++ptr, ++bandPtr) {
+                *ptr -= *bandPtr;
+            }
+        }
+    }
+}
+
+template <typename PixelT>
+int IterativeBackgroundSubtractor<PixelT>::subtract(image::MaskedImage<PixelT>& image) {
+    int const nxSample = _bctrl->getNxSample();
+    int const nySample = _bctrl->getNySample();
+
+    if (!_background) {
+        // First round: measure every cell and subtract the full model
+        _background = std::make_shared<BackgroundMI>(image, *_bctrl);
+        _maskHashes.resize(static_cast<std::size_t>(nxSample) * nySample);
+        for (int iY = 0; iY != nySample; ++iY) {
+            for (int iX = 0; iX != nxSample; ++iX) {
+                _maskHashes[iY * nxSample + iX] =
+                        _hashCellMask(*image.getMask(), _background->getCellBox(iX, iY));
+            }
+        }
+        _subtractModel(image, *_background);
+        return nxSample * nySample;
+    }
+
+    if (image.getBBox() != _background->getImageBBox()) {
+        throw LSST_EXCEPT(ex::InvalidParameterError,
+                          str(boost::format("Image BBox (%d:%d,%d:%d) does not match the BBox of the "
+                                            "first round (%d:%d,%d:%d)") %
+                              image.getBBox().getMinX() % image.getBBox().getMaxX() %
+                              image.getBBox().getMinY() % image.getBBox().getMaxY() %
+                              _background->getImageBBox().getMinX() % _background->getImageBBox().getMaxX() %
+                              _background->getImageBBox().getMinY() % _background->getImageBBox().getMaxY()));
+    }
+
+    // Later rounds: the image already holds the residual of the previous round, so a cell's
+    // statistic under its new mask is directly the correction to apply there.  Cells whose
+    // mask did not change are taken to have a converged (zero) residual and are skipped --
+    // that is the incremental approximation that makes these rounds cheap.
+    image::MaskedImage<Background::InternalPixelT> deltaStats(nxSample, nySample);
+    auto statsImage = _background->getStatsImage();
+    int nChanged = 0;
+    for (int iY = 0; iY != nySample; ++iY) {
+        for (int iX = 0; iX != nxSample; ++iX) {
+            lsst::geom::Box2I const cellBox = _background->getCellBox(iX, iY);
+            std::size_t const hash = _hashCellMask(*image.getMask(), cellBox);
+            if (hash == _maskHashes[iY * nxSample + iX]) {
+                continue;
+            }
+            _maskHashes[iY * nxSample + iX] = hash;
+
+            image::MaskedImage<PixelT> const subimg(image, cellBox, image::LOCAL);
+            std::pair<double, double> const res =
+                    makeStatistics(subimg, _bctrl->getStatisticsProperty() | ERRORS,
+                                   *_bctrl->getStatisticsControl())
+                            .getResult();
+            if (std::isnan(res.first)) {
+                // e.g. the cell is now entirely masked; keep the previous estimate, just as
+                // interpolation would bridge it in a full reconstruction
+                continue;
+            }
+            (*deltaStats.getImage())(iX, iY) = res.first;
+            (*deltaStats.getVariance())(iX, iY) = res.second;
+            (*statsImage.getImage())(iX, iY) += res.first;
+            (*statsImage.getVariance())(iX, iY) = res.second;
+            ++nChanged;
+        }
+    }
+    if (nChanged == 0) {
+        return 0;
+    }
+
+    BackgroundMI const delta(image.getBBox(), deltaStats);
+    _subtractModel(image, delta);
+    return nChanged;
+}
+
 UndersampleStyle stringToUndersampleStyle(std::string const& style) {
     static std::map<std::string, UndersampleStyle> undersampleStrings;
     if (undersampleStrings.size() == 0) {
@@ -140,6 +250,8 @@ UndersampleStyle stringToUndersampleStyle(std::string const& style) {
 
 INSTANTIATE_BACKGROUND(float)
 
+template class IterativeBackgroundSubtractor<float>;
+
 /// @endcond
 }  // namespace math
 }  // namespace afw
@@ -25,6 +25,8 @@
 /*
  * Background estimation class code
  */
+#include <algorithm>
+#include <exception>
 #include <iostream>
 #include <limits>
 #include <vector>
@@ -34,6 +36,7 @@
 #include "lsst/afw/math/Approximate.h"
 #include "lsst/afw/math/Background.h"
 #include "lsst/afw/math/Statistics.h"
+#include "lsst/afw/math/TaskPool.h"
 
 namespace lsst {
 namespace ex = pex::exceptions;
@@ -79,7 +82,9 @@ void cullNan(std::vector<double> const& values, std::vector<double> const& refs,
 
 template <typename ImageT>
 BackgroundMI::BackgroundMI(ImageT const& img, BackgroundControl const& bgCtrl)
-        : Background(img, bgCtrl), _statsImage(image::MaskedImage<InternalPixelT>()) {
+        : Background(img, bgCtrl),
+          _statsImage(image::MaskedImage<InternalPixelT>()),
+          _interpCache(2 * static_cast<std::size_t>(bgCtrl.getNxSample()) + 1) {
     // =============================================================
     // Loop over the cells in the image, computing statistical properties
     // of each cell in turn and using them to set _statsImage
@@ -90,28 +95,53 @@ BackgroundMI::BackgroundMI(ImageT const& img, BackgroundControl const& bgCtrl)
     image::MaskedImage<InternalPixelT>::Image& im = *_statsImage.getImage();
     image::MaskedImage<InternalPixelT>::Variance& var = *_statsImage.getVariance();
 
-    for (int iX = 0; iX < nxSample; ++iX) {
-        for (int iY = 0; iY < nySample; ++iY) {
-            ImageT subimg = ImageT(img,
-                                   lsst::geom::Box2I(lsst::geom::Point2I(_xorig[iX], _yorig[iY]),
-                                                     lsst::geom::Extent2I(_xsize[iX], _ysize[iY])),
-                                   image::LOCAL);
-
-            std::pair<double, double> res = makeStatistics(subimg, bgCtrl.getStatisticsProperty() | ERRORS,
-                                                           *bgCtrl.getStatisticsControl())
-                                                    .getResult();
-            im(iX, iY) = res.first;
-            var(iX, iY) = res.second;
+    // The cells are independent, so with StatisticsControl::getNumThreads() > 1 we shard the
+    // grid columns over threads; every cell is measured exactly as in the serial loop, each
+    // thread writing only its own statsImage pixels.
+    auto processColumns = [this, &img, &im, &var, &bgCtrl, nySample](int const xBegin, int const xEnd,
+                                                                    StatisticsControl const& sctrl) {
+        for (int iX = xBegin; iX != xEnd; ++iX) {
+            for (int iY = 0; iY < nySample; ++iY) {
+                ImageT subimg = ImageT(img,
+                                       lsst::geom::Box2I(lsst::geom::Point2I(_xorig[iX], _yorig[iY]),
+                                                         lsst::geom::Extent2I(_xsize[iX], _ysize[iY])),
+                                       image::LOCAL);
+
+                std::pair<double, double> res =
+                        makeStatistics(subimg, bgCtrl.getStatisticsProperty() | ERRORS, sctrl).getResult();
+                im(iX, iY) = res.first;
+                var(iX, iY) = res.second;
+            }
+        }
+    };
+
+    int const numThreads = std::min(bgCtrl.getStatisticsControl()->getNumThreads(), nxSample);
+    if (numThreads > 1) {
+        StatisticsControl sctrlTmp(*bgCtrl.getStatisticsControl());
+        sctrlTmp.setNumThreads(1);  // the cell columns carry the parallelism, not the per-cell stats
+
+        TaskPool::TaskGroup group;
+        for (int band = 0; band < numThreads; ++band) {
+            int const xBegin = band * nxSample / numThreads;
+            int const xEnd = (band + 1) * nxSample / numThreads;
+            group.run([&processColumns, &sctrlTmp, xBegin, xEnd] {
+                processColumns(xBegin, xEnd, sctrlTmp);
+            });
         }
+        group.wait();
+    } else {
+        processColumns(0, nxSample, *bgCtrl.getStatisticsControl());
     }
 }
 BackgroundMI::BackgroundMI(lsst::geom::Box2I const imageBBox,
                            image::MaskedImage<InternalPixelT> const& statsImage)
-        : Background(imageBBox, statsImage.getWidth(), statsImage.getHeight()), _statsImage(statsImage) {}
+        : Background(imageBBox, statsImage.getWidth(), statsImage.getHeight()),
+          _statsImage(statsImage),
+          _interpCache(2 * static_cast<std::size_t>(statsImage.getWidth()) + 1) {}
 
 void BackgroundMI::_setGridColumns(Interpolate::Style const interpStyle,
-                                   UndersampleStyle const undersampleStyle, int const iX,
-                                   std::vector<int> const& ypix) const {
+                                   UndersampleStyle const undersampleStyle, int const iX, int const yBegin,
+                                   int const yEnd) const {
     image::MaskedImage<InternalPixelT>::Image& im = *_statsImage.getImage();
 
     int const height = _imgBBox.getHeight();
@@ -129,7 +159,7 @@ void BackgroundMI::_setGridColumns(Interpolate::Style const interpStyle,
 
     std::shared_ptr<Interpolate> intobj;
     try {
-        intobj = makeInterpolate(ycenTmp, gridTmp, interpStyle);
+        intobj = _interpCache.makeInterpolate(ycenTmp, gridTmp, interpStyle);
     } catch (pex::exceptions::OutOfRangeError& e) {
         switch (undersampleStyle) {
             case THROW_EXCEPTION:
@@ -141,10 +171,11 @@ void BackgroundMI::_setGridColumns(Interpolate::Style const interpStyle,
                     ycenTmp.push_back(0);
                     gridTmp.push_back(std::numeric_limits<double>::quiet_NaN());
 
-                    intobj = makeInterpolate(ycenTmp, gridTmp, Interpolate::CONSTANT);
+                    intobj = _interpCache.makeInterpolate(ycenTmp, gridTmp, Interpolate::CONSTANT);
                     break;
                 } else {
-                    return _setGridColumns(lookupMaxInterpStyle(gridTmp.size()), undersampleStyle, iX, ypix);
+                    return _setGridColumns(lookupMaxInterpStyle(gridTmp.size()), undersampleStyle, iX, yBegin,
+                                           yEnd);
                 }
             }
             case INCREASE_NXNYSAMPLE:
@@ -162,8 +193,52 @@ void BackgroundMI::_setGridColumns(Interpolate::Style const interpStyle,
         throw;
     }
 
-    for (int iY = 0; iY < height; ++iY) {
-        _gridColumns[iX][iY] = intobj->interpolate(ypix[iY]);
+    for (int iY = yBegin; iY != yEnd; ++iY) {
+        _gridColumns[iX][iY] = intobj->interpolate(iY);
+    }
+}
+
+template <typename ImageT>
+void BackgroundMI::updateRegion(ImageT const& img, lsst::geom::Box2I const& region) {
+    if (img.getBBox() != _imgBBox) {
+        throw LSST_EXCEPT(ex::InvalidParameterError,
+                          str(boost::format("Image BBox (%d:%d,%d:%d) does not match the BBox the "
+                                            "background was estimated from (%d:%d,%d:%d)") %
+                              img.getBBox().getMinX() % img.getBBox().getMaxX() % img.getBBox().getMinY() %
+                              img.getBBox().getMaxY() % _imgBBox.getMinX() % _imgBBox.getMaxX() %
+                              _imgBBox.getMinY() % _imgBBox.getMaxY()));
+    }
+    lsst::geom::Box2I dirty(region);
+    dirty.clip(_imgBBox);
+    if (dirty.isEmpty()) {
+        return;
+    }
+    // cell origins/sizes are in LOCAL coordinates
+    auto const dirtyMin = dirty.getMin() - _imgBBox.getMin();
+    auto const dirtyMax = dirty.getMax() - _imgBBox.getMin();
+
+    image::MaskedImage<InternalPixelT>::Image& im = *_statsImage.getImage();
+    image::MaskedImage<InternalPixelT>::Variance& var = *_statsImage.getVariance();
+
+    for (int iX = 0; iX < _statsImage.getWidth(); ++iX) {
+        if (_xorig[iX] + _xsize[iX] <= dirtyMin.getX() || _xorig[iX] > dirtyMax.getX()) {
+            continue;
+        }
+        for (int iY = 0; iY < _statsImage.getHeight(); ++iY) {
+            if (_yorig[iY] + _ysize[iY] <= dirtyMin.getY() || _yorig[iY] > dirtyMax.getY()) {
+                continue;
+            }
+            ImageT subimg = ImageT(img,
+                                   lsst::geom::Box2I(lsst::geom::Point2I(_xorig[iX], _yorig[iY]),
+                                                     lsst::geom::Extent2I(_xsize[iX], _ysize[iY])),
+                                   image::LOCAL);
+
+            std::pair<double, double> res = makeStatistics(subimg, _bctrl->getStatisticsProperty() | ERRORS,
+                                                           *_bctrl->getStatisticsControl())
+                                                    .getResult();
+            im(iX, iY) = res.first;
+            var(iX, iY) = res.second;
+        }
     }
 }
 
@@ -253,20 +328,16 @@ std::shared_ptr<image::Image<PixelT>> BackgroundMI::doGetImage(
     }
 
     // =============================================================
-    // --> We'll store nxSample fully-interpolated columns to interpolate the rows over
-    // make a vector containing the y pixel coords for the column
+    // --> We'll store nxSample interpolated columns to interpolate the rows over,
+    // evaluated only for the rows the requested bbox actually covers
     int const width = _imgBBox.getWidth();
-    int const height = _imgBBox.getHeight();
     auto const bboxOff = bbox.getMin() - _imgBBox.getMin();
-
-    std::vector<int> ypix(height);
-    for (int iY = 0; iY < height; ++iY) {
-        ypix[iY] = iY;
-    }
+    int const yBegin = bboxOff.getY();
+    int const yEnd = yBegin + bbox.getHeight();
 
     _gridColumns.resize(width);
     for (int iX = 0; iX < nxSample; ++iX) {
-        _setGridColumns(interpStyle, undersampleStyle, iX, ypix);
+        _setGridColumns(interpStyle, undersampleStyle, iX, yBegin, yEnd);
     }
 
     // create a shared_ptr to put the background image in and return to caller
@@ -356,6 +427,10 @@ std::shared_ptr<Approximate<PixelT>> BackgroundMI::doGetApproximate(
     template BackgroundMI::BackgroundMI(image::Image<TYPE> const& img, BackgroundControl const& bgCtrl); \
     template BackgroundMI::BackgroundMI(image::MaskedImage<TYPE> const& img,                             \
                                         BackgroundControl const& bgCtrl);                                \
+    template void BackgroundMI::updateRegion(image::Image<TYPE> const& img,                              \
+                                             lsst::geom::Box2I const& region);                           \
+    template void BackgroundMI::updateRegion(image::MaskedImage<TYPE> const& img,                        \
+                                             lsst::geom::Box2I const& region);                           \
     std::shared_ptr<image::Image<TYPE>> BackgroundMI::_getImage(                                         \
             lsst::geom::Box2I const& bbox,                                                               \
             Interpolate::Style const interpStyle,    /* Style of the interpolation */                    \
@@ -22,10 +22,13 @@
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include <algorithm>
+#include <exception>
 #include <numeric>
 
 #include "lsst/pex/exceptions.h"
 #include "lsst/afw/math/BoundedField.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/afw/table/io/Persistable.cc"
 #include "lsst/afw/image/ImageUtils.h"
 
@@ -46,6 +49,14 @@ ndarray::Array<double, 1, 1> BoundedField::evaluate(ndarray::Array<double const,
     return out;
 }
 
+void BoundedField::evaluate(ndarray::Array<double const, 1> const &x,
+                            ndarray::Array<double const, 1> const &y,
+                            ndarray::Array<double, 1, 1> const &out) const {
+    // Delegate to the allocating overload so subclasses that only batch that one still
+    // get their batched implementation here, at the cost of one copy.
+    out.deep() = evaluate(x, y);
+}
+
 double BoundedField::integrate() const { throw LSST_EXCEPT(pex::exceptions::LogicError, "Not Implemented"); }
 
 double BoundedField::mean() const { throw LSST_EXCEPT(pex::exceptions::LogicError, "Not Implemented"); }
@@ -218,9 +229,41 @@ private:
     double _z00, _z01, _z10, _z11;
 };
 
+// Run work(beginRow, endRow) over contiguous bands of rows on the shared pool, rethrowing
+// the first exception raised by any band after all have finished.
+template <typename WorkT>
+void runOverRowBands(int const height, int const numThreads, WorkT work) {
+    TaskPool::TaskGroup group;
+    for (int band = 0; band < numThreads; ++band) {
+        int const beginRow = band * height / numThreads;
+        int const endRow = (band + 1) * height / numThreads;
+        group.run([work, beginRow, endRow] { work(beginRow, endRow); });
+    }
+    group.wait();
+}
+
+// Apply the functor to the given range of rows of the region (indexed relative to its
+// beginning), evaluating the field one row at a time through the batched evaluate().
+template <typename T, typename F>
+void applyToImageRows(BoundedField const &field, image::Image<T> &subImage,
+                      lsst::geom::Box2I const &region, F functor, int beginRow, int endRow) {
+    auto size = region.getWidth();
+    ndarray::Array<double, 1> xx = ndarray::allocate(ndarray::makeVector(size));
+    ndarray::Array<double, 1> yy = ndarray::allocate(ndarray::makeVector(size));
+    ndarray::Array<double, 1, 1> zz = ndarray::allocate(ndarray::makeVector(size));
+    // y gets incremented each outer loop, x is always xMin->xMax
+    std::iota(xx.begin(), xx.end(), region.getBeginX());
+    auto outRowIter = subImage.getArray().begin() + beginRow;
+    for (int y = region.getBeginY() + beginRow; y < region.getBeginY() + endRow; ++y, ++outRowIter) {
+        yy.deep() = y;  // don't need indexToPosition, as we're already working in the right box (region).
+        field.evaluate(xx, yy, zz);  // reuses zz each row rather than allocating
+        functor(*outRowIter, zz);
+    }
+}
+
 template <typename T, typename F>
 void applyToImage(BoundedField const &field, image::Image<T> &img, F functor, bool overlapOnly, int xStep,
-                  int yStep) {
+                  int yStep, int numThreads) {
     lsst::geom::Box2I region(field.getBBox());
     if (overlapOnly) {
         region.clip(img.getBBox(image::PARENT));
@@ -236,15 +279,16 @@ void applyToImage(BoundedField const &field, image::Image<T> &img, F functor, bo
         // We iterate over rows as a significant optimization for AST-backed bounded fields
         // (it's also slightly faster for other bounded fields, too).
         auto subImage = img.subset(region);
-        auto size = region.getWidth();
-        ndarray::Array<double, 1> xx = ndarray::allocate(ndarray::makeVector(size));
-        ndarray::Array<double, 1> yy = ndarray::allocate(ndarray::makeVector(size));
-        // y gets incremented each outer loop, x is always xMin->xMax
-        std::iota(xx.begin(), xx.end(), region.getBeginX());
-        auto outRowIter = subImage.getArray().begin();
-        for (int y = region.getBeginY(); y < region.getEndY(); ++y, ++outRowIter) {
-            yy.deep() = y;  // don't need indexToPosition, as we're already working in the right box (region).
-            functor(*outRowIter, field.evaluate(xx, yy));
+        numThreads = std::min(numThreads, region.getHeight());
+        if (numThreads > 1 && region.getHeight() >= 2 * numThreads) {
+            // Rows are independent and each band writes a disjoint set of them, so the result
+            // is identical to the serial loop below.
+            runOverRowBands(region.getHeight(), numThreads,
+                            [&field, &subImage, &region, functor](int beginRow, int endRow) {
+                                applyToImageRows(field, subImage, region, functor, beginRow, endRow);
+                            });
+        } else {
+            applyToImageRows(field, subImage, region, functor, 0, region.getHeight());
         }
     }
 }
@@ -256,31 +300,34 @@ std::shared_ptr<BoundedField> operator*(double const scale, std::shared_ptr<Boun
 }
 
 template <typename T>
-void BoundedField::fillImage(image::Image<T> &img, bool overlapOnly, int xStep, int yStep) const {
-    applyToImage(*this, img, Assign(), overlapOnly, xStep, yStep);
+void BoundedField::fillImage(image::Image<T> &img, bool overlapOnly, int xStep, int yStep,
+                             int numThreads) const {
+    applyToImage(*this, img, Assign(), overlapOnly, xStep, yStep, numThreads);
 }
 
 template <typename T>
-void BoundedField::addToImage(image::Image<T> &img, double scaleBy, bool overlapOnly, int xStep,
-                              int yStep) const {
-    applyToImage(*this, img, ScaledAdd(scaleBy), overlapOnly, xStep, yStep);
+void BoundedField::addToImage(image::Image<T> &img, double scaleBy, bool overlapOnly, int xStep, int yStep,
+                              int numThreads) const {
+    applyToImage(*this, img, ScaledAdd(scaleBy), overlapOnly, xStep, yStep, numThreads);
 }
 
 template <typename T>
-void BoundedField::multiplyImage(image::Image<T> &img, bool overlapOnly, int xStep, int yStep) const {
-    applyToImage(*this, img, Multiply(), overlapOnly, xStep, yStep);
+void BoundedField::multiplyImage(image::Image<T> &img, bool overlapOnly, int xStep, int yStep,
+                                 int numThreads) const {
+    applyToImage(*this, img, Multiply(), overlapOnly, xStep, yStep, numThreads);
 }
 
 template <typename T>
-void BoundedField::divideImage(image::Image<T> &img, bool overlapOnly, int xStep, int yStep) const {
-    applyToImage(*this, img, Divide(), overlapOnly, xStep, yStep);
+void BoundedField::divideImage(image::Image<T> &img, bool overlapOnly, int xStep, int yStep,
+                               int numThreads) const {
+    applyToImage(*this, img, Divide(), overlapOnly, xStep, yStep, numThreads);
 }
 
-#define INSTANTIATE(T)                                                                       \
-    template void BoundedField::fillImage(image::Image<T> &, bool, int, int) const;          \
-    template void BoundedField::addToImage(image::Image<T> &, double, bool, int, int) const; \
-    template void BoundedField::multiplyImage(image::Image<T> &, bool, int, int) const;      \
-    template void BoundedField::divideImage(image::Image<T> &, bool, int, int) const
+#define INSTANTIATE(T)                                                                            \
+    template void BoundedField::fillImage(image::Image<T> &, bool, int, int, int) const;          \
+    template void BoundedField::addToImage(image::Image<T> &, double, bool, int, int, int) const; \
+    template void BoundedField::multiplyImage(image::Image<T> &, bool, int, int, int) const;      \
+    template void BoundedField::divideImage(image::Image<T> &, bool, int, int, int) const
 
 INSTANTIATE(float);
 INSTANTIATE(double);
@@ -21,8 +21,12 @@
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include <algorithm>
+#include <limits>
 #include <memory>
+#include <vector>
 
+#include "Eigen/Eigenvalues"
 #include "ndarray/eigen.h"
 #include "lsst/afw/math/LeastSquares.h"
 #include "lsst/afw/math/ChebyshevBoundedField.h"
@@ -211,6 +215,88 @@ std::shared_ptr<ChebyshevBoundedField> ChebyshevBoundedField::fit(image::Image<T
     return result;
 }
 
+ChebyshevBoundedFieldFitter::ChebyshevBoundedFieldFitter(lsst::geom::Box2I const& bbox,
+                                                         ndarray::Array<double const, 1> const& x,
+                                                         ndarray::Array<double const, 1> const& y,
+                                                         Control const& ctrl)
+        : _bbox(bbox), _ctrl(ctrl) {
+    if (x.getSize<0>() != y.getSize<0>()) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Size mismatch between x and y arrays: %d vs %d") % x.getSize<0>() %
+                           y.getSize<0>())
+                                  .str());
+    }
+    Packer const packer(ctrl);
+    ndarray::Array<double, 2, 2> matrix =
+            makeMatrix(x, y, makeChebyshevRangeTransform(lsst::geom::Box2D(bbox)), packer, ctrl);
+    _design = ndarray::asEigenMatrix(matrix);
+    _factor();
+}
+
+ChebyshevBoundedFieldFitter::ChebyshevBoundedFieldFitter(lsst::geom::Box2I const& bbox,
+                                                         ndarray::Array<double const, 1> const& x,
+                                                         ndarray::Array<double const, 1> const& y,
+                                                         ndarray::Array<double const, 1> const& w,
+                                                         Control const& ctrl)
+        : _bbox(bbox), _ctrl(ctrl) {
+    if (x.getSize<0>() != y.getSize<0>() || x.getSize<0>() != w.getSize<0>()) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Size mismatch between x, y and w arrays: %d vs %d vs %d") %
+                           x.getSize<0>() % y.getSize<0>() % w.getSize<0>())
+                                  .str());
+    }
+    Packer const packer(ctrl);
+    ndarray::Array<double, 2, 2> matrix =
+            makeMatrix(x, y, makeChebyshevRangeTransform(lsst::geom::Box2D(bbox)), packer, ctrl);
+    // As in the weighted fit() above, we bake the weights into the design matrix; the data
+    // vector gets multiplied by them in fit().
+    ndarray::asEigenArray(matrix).colwise() *= ndarray::asEigenArray(w);
+    _design = ndarray::asEigenMatrix(matrix);
+    _weights = ndarray::asEigenMatrix(w);
+    _factor();
+}
+
+void ChebyshevBoundedFieldFitter::_factor() {
+    int const size = _design.cols();
+    Eigen::MatrixXd fisher = Eigen::MatrixXd::Zero(size, size);
+    fisher.selfadjointView<Eigen::Lower>().rankUpdate(_design.adjoint());
+    Eigen::SelfAdjointEigenSolver<Eigen::MatrixXd> eig(fisher);
+    // Mirror the NORMAL_EIGENSYSTEM behavior of LeastSquares: eigenvalues below epsilon
+    // times the largest are treated as zero, which yields the minimum-norm solution when
+    // the problem is degenerate.
+    double const threshold = eig.eigenvalues()[size - 1] * std::numeric_limits<double>::epsilon();
+    _eigenvectors = eig.eigenvectors();
+    _invEigenvalues = Eigen::VectorXd::Zero(size);
+    for (int i = 0; i < size; ++i) {
+        if (eig.eigenvalues()[i] > threshold) {
+            _invEigenvalues[i] = 1.0 / eig.eigenvalues()[i];
+        }
+    }
+}
+
+std::shared_ptr<ChebyshevBoundedField> ChebyshevBoundedFieldFitter::fit(
+        ndarray::Array<double const, 1> const& z) const {
+    if (z.getSize<0>() != static_cast<std::size_t>(_design.rows())) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Size mismatch between z array and fitter points: %d vs %d") %
+                           z.getSize<0>() % _design.rows())
+                                  .str());
+    }
+    Eigen::VectorXd rhs;
+    if (_weights.size() > 0) {
+        rhs = _design.adjoint() * (ndarray::asEigenArray(z) * _weights.array()).matrix();
+    } else {
+        rhs = _design.adjoint() * ndarray::asEigenMatrix(z);
+    }
+    // Apply the cached pseudo-inverse of the Fisher matrix to the right-hand side.
+    Eigen::VectorXd packed =
+            _eigenvectors * (_invEigenvalues.array() * (_eigenvectors.adjoint() * rhs).array()).matrix();
+    ndarray::Array<double, 1, 1> packedArray = ndarray::allocate(packed.size());
+    ndarray::asEigenMatrix(packedArray) = packed;
+    Packer const packer(_ctrl);
+    return std::make_shared<ChebyshevBoundedField>(_bbox, packer.unpack(packedArray));
+}
+
 // ------------------ modifier factories ---------------------------------------------------------------
 
 std::shared_ptr<ChebyshevBoundedField> ChebyshevBoundedField::truncate(Control const& ctrl) const {
@@ -277,6 +363,62 @@ struct RecursionArrayImitator {
     double x;
 };
 
+// Ask the compiler to emit AVX2/AVX-512 versions of the batched kernels below and select
+// one at runtime; the hot loops are simple enough for the auto-vectorizer to handle.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define LSST_AFW_CHEBYSHEV_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define LSST_AFW_CHEBYSHEV_TARGET_CLONES
+#endif
+
+// Contract the 2-d coefficient matrix along y, turning f(x,y) into a 1-d Chebyshev
+// function of x for the given (already transformed) y value:
+//   cx[i] = sum_j coefficients[j][i] T_j(y)
+// ty is workspace for the y-direction basis, with size coefficients.getSize<0>().
+LSST_AFW_CHEBYSHEV_TARGET_CLONES
+void contractCoefficients(ndarray::Array<double const, 2, 2> const& coefficients, double y, double* ty,
+                          double* cx) {
+    int const ny = coefficients.getSize<0>();
+    int const nx = coefficients.getSize<1>();
+    if (ny > 0) {
+        ty[0] = 1.0;
+    }
+    if (ny > 1) {
+        ty[1] = y;
+    }
+    for (int j = 2; j < ny; ++j) {
+        ty[j] = 2.0 * y * ty[j - 1] - ty[j - 2];
+    }
+    std::fill(cx, cx + nx, 0.0);
+    for (int j = 0; j < ny; ++j) {
+        double const tyj = ty[j];
+        for (int i = 0; i < nx; ++i) {
+            cx[i] += tyj * coefficients[j][i];
+        }
+    }
+}
+
+// Run the Clenshaw recurrence of evaluateFunction1d across a whole batch of abscissae at
+// once, carrying the b_{k+1}/b_{k+2} state in lane buffers so the inner loop vectorizes.
+// b_kp1 and b_kp2 are workspace arrays with at least n elements.
+LSST_AFW_CHEBYSHEV_TARGET_CLONES
+void evaluateFunction1dBatch(double const* g, int size, double const* x, int n, double* b_kp1, double* b_kp2,
+                             double* out) {
+    std::fill(b_kp1, b_kp1 + n, 0.0);
+    std::fill(b_kp2, b_kp2 + n, 0.0);
+    for (int k = (size - 1); k > 0; --k) {
+        double const g_k = g[k];
+        for (int i = 0; i < n; ++i) {
+            double const b_k = g_k + 2.0 * x[i] * b_kp1[i] - b_kp2[i];
+            b_kp2[i] = b_kp1[i];
+            b_kp1[i] = b_k;
+        }
+    }
+    for (int i = 0; i < n; ++i) {
+        out[i] = g[0] + x[i] * b_kp1[i] - b_kp2[i];
+    }
+}
+
 }  // namespace
 
 double ChebyshevBoundedField::evaluate(lsst::geom::Point2D const& position) const {
@@ -285,6 +427,45 @@ double ChebyshevBoundedField::evaluate(lsst::geom::Point2D const& position) cons
                               _coefficients.getSize<0>());
 }
 
+ndarray::Array<double, 1, 1> ChebyshevBoundedField::evaluate(
+        ndarray::Array<double const, 1> const& x, ndarray::Array<double const, 1> const& y) const {
+    ndarray::Array<double, 1, 1> out = ndarray::allocate(x.getSize<0>());
+    evaluate(x, y, out);
+    return out;
+}
+
+void ChebyshevBoundedField::evaluate(ndarray::Array<double const, 1> const& x,
+                                     ndarray::Array<double const, 1> const& y,
+                                     ndarray::Array<double, 1, 1> const& out) const {
+    int const n = x.getSize<0>();
+    int const nx = _coefficients.getSize<1>();
+    int const ny = _coefficients.getSize<0>();
+    // Map all points into the Chebyshev range up front, so we can detect runs of constant y below.
+    std::vector<double> sx(n), sy(n);
+    for (int i = 0; i < n; ++i) {
+        lsst::geom::Point2D p = _toChebyshevRange(lsst::geom::Point2D(x[i], y[i]));
+        sx[i] = p.getX();
+        sy[i] = p.getY();
+    }
+    std::vector<double> ty(ny), cx(nx);
+    std::vector<double> b1(n), b2(n);
+    // Process maximal runs of constant y together (e.g. image rows, which is what fillImage
+    // and friends pass us): contract the coefficient matrix along y once per run, then apply
+    // the x-direction recurrence to the whole run at once.  Scattered points degenerate to
+    // runs of length one, which costs no more than the generic point-at-a-time loop.
+    int begin = 0;
+    while (begin < n) {
+        int end = begin + 1;
+        while (end < n && sy[end] == sy[begin]) {
+            ++end;
+        }
+        contractCoefficients(_coefficients, sy[begin], ty.data(), cx.data());
+        evaluateFunction1dBatch(cx.data(), nx, sx.data() + begin, end - begin, b1.data(), b2.data(),
+                                out.getData() + begin);
+        begin = end;
+    }
+}
+
 // The integral of T_n(x) over [-1,1]:
 // https://en.wikipedia.org/wiki/Chebyshev_polynomials#Differentiation_and_integration
 double integrateTn(int n) {
@@ -39,6 +39,7 @@
 #include "lsst/log/Log.h"
 #include "lsst/afw/image/ImageUtils.h"
 #include "lsst/afw/image/MaskedImage.h"
+#include "lsst/afw/instrumentation.h"
 #include "lsst/afw/math/Kernel.h"
 #include "lsst/afw/math/detail/Convolve.h"
 
@@ -189,6 +190,8 @@ void scaledPlus(OutImageT& outImage, double c1, InImageT const& inImage1, double
 template <typename OutImageT, typename InImageT, typename KernelT>
 void convolve(OutImageT& convolvedImage, InImageT const& inImage, KernelT const& kernel,
               ConvolutionControl const& convolutionControl) {
+    instrumentation::Timer timer(instrumentation::Metric::CONVOLVE_CALLS,
+                                 instrumentation::Metric::CONVOLVE_NANOS);
     detail::basicConvolve(convolvedImage, inImage, kernel, convolutionControl);
     setEdgePixels(convolvedImage, kernel, inImage, convolutionControl.getDoCopyEdge(),
                   typename image::detail::image_traits<OutImageT>::image_category());
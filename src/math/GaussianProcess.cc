@@ -22,10 +22,14 @@
  * see  < http://www.lsstcorp.org/LegalNotices/ > .
  */
 
-#include <iostream>
+#include <algorithm>
 #include <cmath>
+#include <exception>
+#include <iostream>
+#include <vector>
 
 #include "lsst/afw/math/GaussianProcess.h"
+#include "lsst/afw/math/TaskPool.h"
 
 using namespace std;
 
@@ -774,6 +778,7 @@ GaussianProcess<T>::GaussianProcess(ndarray::Array<T, 2, 2> const &dataIn, ndarr
 
     _krigingParameter = T(1.0);
     _lambda = T(1.0e-5);
+    _maxInducingPoints = 0;
 
     _useMaxMin = 0;
 
@@ -811,6 +816,7 @@ GaussianProcess<T>::GaussianProcess(ndarray::Array<T, 2, 2> const &dataIn, ndarr
 
     _lambda = T(1.0e-5);
     _krigingParameter = T(1.0);
+    _maxInducingPoints = 0;
 
     _max = allocate(ndarray::makeVector(_dimensions));
     _min = allocate(ndarray::makeVector(_dimensions));
@@ -856,6 +862,7 @@ GaussianProcess<T>::GaussianProcess(ndarray::Array<T, 2, 2> const &dataIn, ndarr
     _krigingParameter = T(1.0);
 
     _lambda = T(1.0e-5);
+    _maxInducingPoints = 0;
 
     _useMaxMin = 0;
 
@@ -894,6 +901,7 @@ GaussianProcess<T>::GaussianProcess(ndarray::Array<T, 2, 2> const &dataIn, ndarr
 
     _lambda = T(1.0e-5);
     _krigingParameter = T(1.0);
+    _maxInducingPoints = 0;
 
     _max = allocate(ndarray::makeVector(_dimensions));
     _min = allocate(ndarray::makeVector(_dimensions));
@@ -1240,6 +1248,153 @@ void GaussianProcess<T>::interpolate(ndarray::Array<T, 1, 1> mu, ndarray::Array<
     _timer.addToTotal(1);
 }
 
+template <typename T>
+void GaussianProcess<T>::interpolate(ndarray::Array<T, 1, 1> mu, ndarray::Array<T, 1, 1> variance,
+                                     ndarray::Array<T, 2, 2> const &queries, int numberOfNeighbors,
+                                     int numThreads) const {
+    if (_nFunctions > 1) {
+        throw LSST_EXCEPT(lsst::pex::exceptions::RuntimeError,
+                          "The batched version of GaussianProcess.interpolate() is only "
+                          "available when interpolating a single function.");
+    }
+
+    if (numberOfNeighbors <= 0) {
+        throw LSST_EXCEPT(lsst::pex::exceptions::RuntimeError,
+                          "Asked for zero or negative number of neighbors\n");
+    }
+
+    if (numberOfNeighbors > _kdTree.getNPoints()) {
+        throw LSST_EXCEPT(lsst::pex::exceptions::RuntimeError,
+                          "Asked for more neighbors than you have data points\n");
+    }
+
+    int const nQueries = queries.template getSize<0>();
+
+    if (queries.template getSize<1>() != static_cast<ndarray::Size>(_dimensions)) {
+        throw LSST_EXCEPT(lsst::pex::exceptions::RuntimeError,
+                          "You are interpolating at points with different dimensionality than you data\n");
+    }
+
+    if (mu.getNumElements() != static_cast<ndarray::Size>(nQueries) ||
+        variance.getNumElements() != static_cast<ndarray::Size>(nQueries)) {
+        throw LSST_EXCEPT(lsst::pex::exceptions::RuntimeError,
+                          "Your mu and/or var arrays are improperly sized for the number of queries "
+                          "you are interpolating\n");
+    }
+
+    _timer.start();
+
+    // Normalize the queries and find all of the neighbor sets up front.  This phase has
+    // to be serial, because KdTree::findNeighbors uses mutable scratch space, but it is
+    // cheap relative to the linear algebra below.  The neighbor sets are sorted by index
+    // so that queries selecting the same neighbors are recognized as such even when the
+    // distance ordering differs.
+    ndarray::Array<double, 2, 2> vv = allocate(ndarray::makeVector(nQueries, _dimensions));
+    ndarray::Array<int, 2, 2> neighborIndices = allocate(ndarray::makeVector(nQueries, numberOfNeighbors));
+    ndarray::Array<double, 1, 1> neighborDistances = allocate(ndarray::makeVector(numberOfNeighbors));
+
+    for (int q = 0; q < nQueries; q++) {
+        if (_useMaxMin == 1) {
+            for (int i = 0; i < _dimensions; i++) {
+                vv[q][i] = (queries[q][i] - _min[i]) / (_max[i] - _min[i]);
+            }
+        } else {
+            for (int i = 0; i < _dimensions; i++) {
+                vv[q][i] = queries[q][i];
+            }
+        }
+        _kdTree.findNeighbors(neighborIndices[q], neighborDistances, vv[q], numberOfNeighbors);
+        std::sort(&neighborIndices[q][0], &neighborIndices[q][0] + numberOfNeighbors);
+    }
+
+    _timer.addToSearch();
+
+    // Do the per-query linear algebra, reusing the LDLT factorization of the neighbor
+    // covariance matrix whenever consecutive queries share a neighbor set.
+    auto work = [this, &mu, &variance, &vv, &neighborIndices, numberOfNeighbors](int beginRow, int endRow) {
+        int i, j;
+        T fbar;
+
+        ndarray::Array<T, 1, 1> covarianceTestPoint;
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> covariance, bb, xx;
+        Eigen::LDLT<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > ldlt;
+
+        bb.resize(numberOfNeighbors, 1);
+        xx.resize(numberOfNeighbors, 1);
+        covariance.resize(numberOfNeighbors, numberOfNeighbors);
+        covarianceTestPoint = allocate(ndarray::makeVector(numberOfNeighbors));
+
+        for (int q = beginRow; q < endRow; q++) {
+            int const *neighbors = &neighborIndices[q][0];
+
+            bool const sameNeighbors =
+                    (q > beginRow) &&
+                    std::equal(neighbors, neighbors + numberOfNeighbors, &neighborIndices[q - 1][0]);
+
+            if (!sameNeighbors) {
+                for (i = 0; i < numberOfNeighbors; i++) {
+                    covariance(i, i) = (*_covariogram)(_kdTree.getData(neighbors[i]),
+                                                       _kdTree.getData(neighbors[i])) +
+                                       _lambda;
+
+                    for (j = i + 1; j < numberOfNeighbors; j++) {
+                        covariance(i, j) =
+                                (*_covariogram)(_kdTree.getData(neighbors[i]), _kdTree.getData(neighbors[j]));
+                        covariance(j, i) = covariance(i, j);
+                    }
+                }
+
+                // use Eigen's ldlt solver in place of matrix inversion (for speed purposes)
+                ldlt.compute(covariance);
+            }
+
+            fbar = 0.0;
+            for (i = 0; i < numberOfNeighbors; i++) fbar += _function[neighbors[i]][0];
+            fbar = fbar / double(numberOfNeighbors);
+
+            for (i = 0; i < numberOfNeighbors; i++) {
+                covarianceTestPoint[i] = (*_covariogram)(vv[q], _kdTree.getData(neighbors[i]));
+                bb(i, 0) = _function[neighbors[i]][0] - fbar;
+            }
+
+            xx = ldlt.solve(bb);
+
+            mu[q] = fbar;
+            for (i = 0; i < numberOfNeighbors; i++) {
+                mu[q] += covarianceTestPoint[i] * xx(i, 0);
+            }
+
+            variance[q] = (*_covariogram)(vv[q], vv[q]) + _lambda;
+
+            for (i = 0; i < numberOfNeighbors; i++) bb(i) = covarianceTestPoint[i];
+
+            xx = ldlt.solve(bb);
+
+            for (i = 0; i < numberOfNeighbors; i++) {
+                variance[q] -= covarianceTestPoint[i] * xx(i, 0);
+            }
+
+            variance[q] = variance[q] * _krigingParameter;
+        }
+    };
+
+    numThreads = std::min(numThreads, nQueries);
+    if (numThreads > 1 && nQueries >= 2 * numThreads) {
+        TaskPool::TaskGroup group;
+        for (int band = 0; band < numThreads; band++) {
+            int const beginRow = band * nQueries / numThreads;
+            int const endRow = (band + 1) * nQueries / numThreads;
+            group.run([&work, beginRow, endRow] { work(beginRow, endRow); });
+        }
+        group.wait();
+    } else {
+        work(0, nQueries);
+    }
+
+    _timer.addToEigen();
+    _timer.addToTotal(nQueries);
+}
+
 template <typename T>
 T GaussianProcess<T>::selfInterpolate(ndarray::Array<T, 1, 1> variance, int dex,
                                       int numberOfNeighbors) const {
@@ -1484,6 +1639,107 @@ void GaussianProcess<T>::selfInterpolate(ndarray::Array<T, 1, 1> mu, ndarray::Ar
     _timer.addToTotal(1);
 }
 
+template <typename T>
+void GaussianProcess<T>::_batchInterpolateInducing(
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> &muOut,
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> *varianceOut,
+        ndarray::Array<T, 2, 2> const &queries) const {
+    int i, j, ifn;
+
+    ndarray::Size nQueries = queries.template getSize<0>();
+    int const nInducing = _maxInducingPoints;
+
+    Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> kmm, knm, sigma, rhs, ww;
+    Eigen::Matrix<T, Eigen::Dynamic, 1> kstar;
+    Eigen::LDLT<Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> > ldlt;
+
+    ndarray::Array<T, 1, 1> v1;
+
+    v1 = allocate(ndarray::makeVector(_dimensions));
+
+    // Select the inducing points by striding evenly through the data.  The KdTree
+    // stores the points in an order that interleaves the dimensions, so a uniform
+    // stride gives a reasonable space-filling subset without any extra work.
+    std::vector<int> inducing(nInducing);
+    for (i = 0; i < nInducing; i++) {
+        inducing[i] = (i * _npts) / nInducing;
+    }
+
+    kmm.resize(nInducing, nInducing);
+    knm.resize(_npts, nInducing);
+    kstar.resize(nInducing);
+
+    for (i = 0; i < nInducing; i++) {
+        kmm(i, i) = (*_covariogram)(_kdTree.getData(inducing[i]), _kdTree.getData(inducing[i]));
+        for (j = i + 1; j < nInducing; j++) {
+            kmm(i, j) = (*_covariogram)(_kdTree.getData(inducing[i]), _kdTree.getData(inducing[j]));
+            kmm(j, i) = kmm(i, j);
+        }
+    }
+
+    for (i = 0; i < _npts; i++) {
+        for (j = 0; j < nInducing; j++) {
+            knm(i, j) = (*_covariogram)(_kdTree.getData(i), _kdTree.getData(inducing[j]));
+        }
+    }
+    _timer.addToIteration();
+
+    // Subset-of-regressors normal equations:
+    // (K_mn K_nm + lambda K_mm) w = K_mn (f - fbar)
+    sigma = knm.transpose() * knm + _lambda * kmm;
+    ldlt.compute(sigma);
+
+    std::vector<T> fbar(_nFunctions);
+    rhs.resize(nInducing, _nFunctions);
+    for (ifn = 0; ifn < _nFunctions; ifn++) {
+        fbar[ifn] = 0.0;
+        for (i = 0; i < _npts; i++) fbar[ifn] += _function[i][ifn];
+        fbar[ifn] = fbar[ifn] / T(_npts);
+
+        for (j = 0; j < nInducing; j++) {
+            T sum = 0.0;
+            for (i = 0; i < _npts; i++) {
+                sum += knm(i, j) * (_function[i][ifn] - fbar[ifn]);
+            }
+            rhs(j, ifn) = sum;
+        }
+    }
+    ww = ldlt.solve(rhs);
+    _timer.addToEigen();
+
+    muOut.resize(nQueries, _nFunctions);
+    if (varianceOut != nullptr) {
+        varianceOut->resize(nQueries, 1);
+    }
+
+    for (ndarray::Size ii = 0; ii < nQueries; ii++) {
+        for (i = 0; i < _dimensions; i++) v1[i] = queries[ii][i];
+        if (_useMaxMin == 1) {
+            for (i = 0; i < _dimensions; i++) v1[i] = (v1[i] - _min[i]) / (_max[i] - _min[i]);
+        }
+
+        for (i = 0; i < nInducing; i++) {
+            kstar(i) = (*_covariogram)(v1, _kdTree.getData(inducing[i]));
+        }
+
+        for (ifn = 0; ifn < _nFunctions; ifn++) {
+            muOut(ii, ifn) = fbar[ifn] + kstar.dot(ww.col(ifn));
+        }
+
+        if (varianceOut != nullptr) {
+            // the subset-of-regressors variance; note that this falls to _lambda
+            // (rather than rising to the prior variance) far from the inducing points
+            (*varianceOut)(ii, 0) =
+                    (_lambda * kstar.dot(ldlt.solve(kstar)) + _lambda) * _krigingParameter;
+        }
+    }
+    if (varianceOut != nullptr) {
+        _timer.addToVariance();
+    } else {
+        _timer.addToIteration();
+    }
+}
+
 template <typename T>
 void GaussianProcess<T>::batchInterpolate(ndarray::Array<T, 1, 1> mu, ndarray::Array<T, 1, 1> variance,
                                           ndarray::Array<T, 2, 2> const &queries) const {
@@ -1509,6 +1765,18 @@ void GaussianProcess<T>::batchInterpolate(ndarray::Array<T, 1, 1> mu, ndarray::A
                           "dimensionality for your Gaussian Process\n");
     }
 
+    if (_maxInducingPoints > 0 && _maxInducingPoints < _npts) {
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> muInducing, varianceInducing;
+        _timer.start();
+        _batchInterpolateInducing(muInducing, &varianceInducing, queries);
+        for (ndarray::Size ii = 0; ii < nQueries; ii++) {
+            mu(ii) = muInducing(ii, 0);
+            variance[ii] = varianceInducing(ii, 0);
+        }
+        _timer.addToTotal(nQueries);
+        return;
+    }
+
     T fbar;
     Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> batchCovariance, batchbb, batchxx;
     Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> queryCovariance;
@@ -1610,6 +1878,20 @@ void GaussianProcess<T>::batchInterpolate(ndarray::Array<T, 2, 2> mu, ndarray::A
                           "wrong dimensionality.\n");
     }
 
+    if (_maxInducingPoints > 0 && _maxInducingPoints < _npts) {
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> muInducing, varianceInducing;
+        _timer.start();
+        _batchInterpolateInducing(muInducing, &varianceInducing, queries);
+        for (ndarray::Size ii = 0; ii < nQueries; ii++) {
+            for (ifn = 0; ifn < _nFunctions; ifn++) {
+                mu[ii][ifn] = muInducing(ii, ifn);
+                variance[ii][ifn] = varianceInducing(ii, 0);
+            }
+        }
+        _timer.addToTotal(nQueries);
+        return;
+    }
+
     T fbar;
     Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> batchCovariance, batchbb, batchxx;
     Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> queryCovariance;
@@ -1717,6 +1999,17 @@ void GaussianProcess<T>::batchInterpolate(ndarray::Array<T, 1, 1> mu,
                           "at which you are trying to interpolate your function.\n");
     }
 
+    if (_maxInducingPoints > 0 && _maxInducingPoints < _npts) {
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> muInducing;
+        _timer.start();
+        _batchInterpolateInducing(muInducing, nullptr, queries);
+        for (ndarray::Size ii = 0; ii < nQueries; ii++) {
+            mu(ii) = muInducing(ii, 0);
+        }
+        _timer.addToTotal(nQueries);
+        return;
+    }
+
     T fbar;
     Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> batchCovariance, batchbb, batchxx;
     Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> queryCovariance;
@@ -1796,6 +2089,19 @@ void GaussianProcess<T>::batchInterpolate(ndarray::Array<T, 2, 2> mu,
                           "have the correct dimensionality.\n");
     }
 
+    if (_maxInducingPoints > 0 && _maxInducingPoints < _npts) {
+        Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> muInducing;
+        _timer.start();
+        _batchInterpolateInducing(muInducing, nullptr, queries);
+        for (ndarray::Size ii = 0; ii < nQueries; ii++) {
+            for (ifn = 0; ifn < _nFunctions; ifn++) {
+                mu[ii][ifn] = muInducing(ii, ifn);
+            }
+        }
+        _timer.addToTotal(nQueries);
+        return;
+    }
+
     T fbar;
     Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> batchCovariance, batchbb, batchxx;
     Eigen::Matrix<T, Eigen::Dynamic, Eigen::Dynamic> queryCovariance;
@@ -1977,6 +2283,15 @@ void GaussianProcess<T>::setLambda(T lambda) {
     _lambda = lambda;
 }
 
+template <typename T>
+void GaussianProcess<T>::setMaxInducingPoints(int maxInducingPoints) {
+    if (maxInducingPoints < 0) {
+        throw LSST_EXCEPT(lsst::pex::exceptions::RuntimeError,
+                          "You asked for a negative number of inducing points\n");
+    }
+    _maxInducingPoints = maxInducingPoints;
+}
+
 template <typename T>
 GaussianProcessTimer &GaussianProcess<T>::getTimes() const {
     return _timer;
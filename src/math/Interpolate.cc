@@ -28,6 +28,8 @@
 #include <limits>
 #include <algorithm>
 #include <map>
+#include <set>
+#include <utility>
 #include "boost/format.hpp"
 #include <memory>
 #include "gsl/gsl_errno.h"
@@ -35,6 +37,9 @@
 #include "gsl/gsl_spline.h"
 #include "ndarray.h"
 #include "lsst/pex/exceptions.h"
+#include "lsst/afw/image/Defect.h"
+#include "lsst/afw/image/Image.h"
+#include "lsst/afw/image/MaskedImage.h"
 #include "lsst/afw/math/Interpolate.h"
 
 namespace lsst {
@@ -80,6 +85,7 @@ class InterpolateConstant : public Interpolate {
 
 public:
     ~InterpolateConstant() override {}
+    using Interpolate::interpolate;
     double interpolate(double const x) const override;
 
 private:
@@ -174,12 +180,17 @@ class InterpolateGsl : public Interpolate {
 
 public:
     ~InterpolateGsl() override;
+    using Interpolate::interpolate;
     double interpolate(double const x) const override;
+    std::vector<double> interpolate(std::vector<double> const &x) const override;
+    ndarray::Array<double, 1> interpolate(ndarray::Array<double const, 1> const &x) const override;
 
 private:
     InterpolateGsl(std::vector<double> const &x, std::vector<double> const &y,
                    Interpolate::Style const style);
 
+    double _evaluate(double const xInterp) const;
+
     ::gsl_interp_type const *_interpType;
     ::gsl_interp_accel *_acc;
     ::gsl_interp *_interp;
@@ -221,7 +232,8 @@ InterpolateGsl::~InterpolateGsl() {
     ::gsl_interp_accel_free(_acc);
 }
 
-double InterpolateGsl::interpolate(double const xInterp) const {
+/// @internal Evaluate the spline at one point without any virtual dispatch
+double InterpolateGsl::_evaluate(double const xInterp) const {
     // New GSL versions refuse to extrapolate.
     // gsl_interp_init() requires x to be ordered, so can just check
     // the array endpoints for out-of-bounds.
@@ -254,6 +266,27 @@ double InterpolateGsl::interpolate(double const xInterp) const {
     return ::gsl_interp_eval(_interp, &_x[0], &_y[0], xInterp, _acc);
 }
 
+double InterpolateGsl::interpolate(double const xInterp) const { return _evaluate(xInterp); }
+
+std::vector<double> InterpolateGsl::interpolate(std::vector<double> const &x) const {
+    // one pass over the already-initialized spline: no virtual call per point, and the
+    // accelerator cache stays warm when the abscissae are ordered (the usual case)
+    std::vector<double> out(x.size());
+    for (std::size_t i = 0; i != x.size(); ++i) {
+        out[i] = _evaluate(x[i]);
+    }
+    return out;
+}
+
+ndarray::Array<double, 1> InterpolateGsl::interpolate(ndarray::Array<double const, 1> const &x) const {
+    int const num = x.getShape()[0];
+    ndarray::Array<double, 1> out = ndarray::allocate(ndarray::makeVector(num));
+    for (int i = 0; i < num; ++i) {
+        out[i] = _evaluate(x[i]);
+    }
+    return out;
+}
+
 Interpolate::Style stringToInterpStyle(std::string const &style) {
     static std::map<std::string, Interpolate::Style> gslInterpTypeStrings;
     if (gslInterpTypeStrings.empty()) {
@@ -305,7 +338,6 @@ ndarray::Array<double, 1> Interpolate::interpolate(ndarray::Array<double const,
     int const num = x.getShape()[0];
     ndarray::Array<double, 1> out = ndarray::allocate(ndarray::makeVector(num));
     for (int i = 0; i < num; ++i) {
-        std::cout << "Interpolating " << x[i] << std::endl;
         out[i] = interpolate(x[i]);
     }
     return out;
@@ -356,6 +388,167 @@ std::shared_ptr<Interpolate> makeInterpolate(ndarray::Array<double const, 1> con
     return makeInterpolate(std::vector<double>(x.begin(), x.end()), std::vector<double>(y.begin(), y.end()),
                            style);
 }
+
+InterpolateCache::InterpolateCache(std::size_t const capacity) : _capacity(capacity), _entries() {
+    if (capacity == 0) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "Cache capacity must be positive");
+    }
+}
+
+std::shared_ptr<Interpolate> InterpolateCache::makeInterpolate(std::vector<double> const &x,
+                                                               std::vector<double> const &y,
+                                                               Interpolate::Style const style) {
+    // A linear scan: the capacity is small and comparing the knot vectors is far cheaper than
+    // building a spline, which is what a hit saves us.
+    for (auto it = _entries.begin(); it != _entries.end(); ++it) {
+        if (it->style == style && it->x == x && it->y == y) {
+            _entries.splice(_entries.begin(), _entries, it);  // mark most recently used
+            return _entries.front().interp;
+        }
+    }
+    // may throw, in which case nothing is cached
+    std::shared_ptr<Interpolate> interp = lsst::afw::math::makeInterpolate(x, y, style);
+    _entries.push_front(Entry{x, y, style, interp});
+    if (_entries.size() > _capacity) {
+        _entries.pop_back();
+    }
+    return interp;
+}
+
+namespace {
+
+/*
+ * @internal Decompose the defects into per-row bad spans in LOCAL coordinates, sorted
+ * left-to-right with overlapping and abutting spans merged.  Rows without defects get
+ * empty span lists.
+ */
+std::vector<std::vector<std::pair<int, int>>> collectSpansByRow(
+        lsst::geom::Box2I const &bbox, std::vector<std::shared_ptr<image::DefectBase>> const &defects) {
+    std::vector<std::vector<std::pair<int, int>>> spansByRow(bbox.getHeight());
+    for (auto const &defect : defects) {
+        lsst::geom::Box2I box = defect->getBBox();
+        box.clip(bbox);
+        if (box.isEmpty()) {
+            continue;
+        }
+        int const x0 = box.getMinX() - bbox.getMinX();
+        int const x1 = box.getMaxX() - bbox.getMinX();
+        for (int y = box.getMinY(); y <= box.getMaxY(); ++y) {
+            spansByRow[y - bbox.getMinY()].emplace_back(x0, x1);
+        }
+    }
+    for (auto &spans : spansByRow) {
+        if (spans.empty()) {
+            continue;
+        }
+        std::sort(spans.begin(), spans.end());
+        std::vector<std::pair<int, int>> merged;
+        for (auto const &span : spans) {
+            if (!merged.empty() && span.first <= merged.back().second + 1) {
+                merged.back().second = std::max(merged.back().second, span.second);
+            } else {
+                merged.push_back(span);
+            }
+        }
+        spans.swap(merged);
+    }
+    return spansByRow;
+}
+
+}  // namespace
+
+template <typename PixelT>
+void interpolateOverDefects(image::Image<PixelT> &image,
+                            std::vector<std::shared_ptr<image::DefectBase>> const &defects,
+                            Interpolate::Style const style, int const nGoodPixels,
+                            double const fallbackValue) {
+    if (nGoodPixels <= 0) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          str(boost::format("nGoodPixels = %d; must be positive") % nGoodPixels));
+    }
+    auto const spansByRow = collectSpansByRow(image.getBBox(), defects);
+    int const width = image.getWidth();
+    std::vector<bool> isBad(width);  // bad-column flags, reused from row to row
+    for (int y = 0; y != image.getHeight(); ++y) {
+        auto const &spans = spansByRow[y];
+        if (spans.empty()) {
+            continue;
+        }
+        std::fill(isBad.begin(), isBad.end(), false);
+        for (auto const &span : spans) {
+            std::fill(isBad.begin() + span.first, isBad.begin() + span.second + 1, true);
+        }
+        auto const row = image.row_begin(y);
+        // Collect up to nGoodPixels good anchors flanking each bad run; a std::set keeps them
+        // sorted and deduplicates the narrow gaps shared by two neighbouring runs.
+        std::set<int> anchorCols;
+        for (auto const &span : spans) {
+            for (int x = span.first - 1, n = 0; x >= 0 && n != nGoodPixels && !isBad[x]; --x, ++n) {
+                anchorCols.insert(x);
+            }
+            for (int x = span.second + 1, n = 0; x < width && n != nGoodPixels && !isBad[x]; ++x, ++n) {
+                anchorCols.insert(x);
+            }
+        }
+        if (anchorCols.empty()) {
+            for (auto const &span : spans) {
+                for (int x = span.first; x <= span.second; ++x) {
+                    row[x] = fallbackValue;
+                }
+            }
+            continue;
+        }
+        std::vector<double> xAnchor, yAnchor;
+        xAnchor.reserve(anchorCols.size());
+        yAnchor.reserve(anchorCols.size());
+        for (int x : anchorCols) {
+            xAnchor.push_back(x);
+            yAnchor.push_back(row[x]);
+        }
+        Interpolate::Style rowStyle = style;
+        if (static_cast<int>(xAnchor.size()) < lookupMinInterpPoints(style)) {
+            rowStyle = lookupMaxInterpStyle(xAnchor.size());
+        }
+        auto const interp = makeInterpolate(xAnchor, yAnchor, rowStyle);
+        for (auto const &span : spans) {
+            for (int x = span.first; x <= span.second; ++x) {
+                row[x] = interp->interpolate(x);
+            }
+        }
+    }
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void interpolateOverDefects(image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> &image,
+                            std::vector<std::shared_ptr<image::DefectBase>> const &defects,
+                            Interpolate::Style const style, int const nGoodPixels,
+                            double const fallbackValue) {
+    interpolateOverDefects(*image.getImage(), defects, style, nGoodPixels, fallbackValue);
+    MaskPixelT const interpBit = image.getMask()->getPlaneBitMask("INTRP");
+    for (auto const &defect : defects) {
+        lsst::geom::Box2I box = defect->getBBox();
+        box.clip(image.getBBox());
+        if (box.isEmpty()) {
+            continue;
+        }
+        image::Mask<MaskPixelT> sub(*image.getMask(), box, image::PARENT);
+        sub |= interpBit;
+    }
+}
+
+/// @cond
+#define INSTANTIATE(PIXELT)                                                                           \
+    template void interpolateOverDefects(image::Image<PIXELT> &,                                      \
+                                         std::vector<std::shared_ptr<image::DefectBase>> const &,     \
+                                         Interpolate::Style const, int const, double const);          \
+    template void interpolateOverDefects(                                                             \
+            image::MaskedImage<PIXELT, image::MaskPixel, image::VariancePixel> &,                     \
+            std::vector<std::shared_ptr<image::DefectBase>> const &, Interpolate::Style const,        \
+            int const, double const);
+
+INSTANTIATE(float)
+INSTANTIATE(double)
+/// @endcond
 }  // namespace math
 }  // namespace afw
 }  // namespace lsst
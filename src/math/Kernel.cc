@@ -21,6 +21,7 @@
  * the GNU General Public License along with this program.  If not,
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
+#include <cmath>
 #include <fstream>
 #include <sstream>
 
@@ -55,7 +56,15 @@ deltafunction_kernel_tag deltafunction_kernel_tag_;
 //
 // Constructors
 //
-Kernel::Kernel() : _spatialFunctionList(), _width(0), _height(0), _ctrX(0), _ctrY(0), _nKernelParams(0) {}
+Kernel::Kernel()
+        : _spatialFunctionList(),
+          _width(0),
+          _height(0),
+          _ctrX(0),
+          _ctrY(0),
+          _nKernelParams(0),
+          _imageCacheSize(0),
+          _imageCachePositionQuantum(1.0) {}
 
 Kernel::Kernel(int width, int height, unsigned int nKernelParams, SpatialFunction const &spatialFunction)
         : _spatialFunctionList(),
@@ -63,7 +72,9 @@ Kernel::Kernel(int width, int height, unsigned int nKernelParams, SpatialFunctio
           _height(height),
           _ctrX((width - 1) / 2),
           _ctrY((height - 1) / 2),
-          _nKernelParams(nKernelParams) {
+          _nKernelParams(nKernelParams),
+          _imageCacheSize(0),
+          _imageCachePositionQuantum(1.0) {
     if ((width < 1) || (height < 1)) {
         std::ostringstream os;
         os << "kernel height = " << height << " and/or width = " << width << " < 1";
@@ -90,18 +101,66 @@ double Kernel::computeImage(image::Image<Pixel> &image, bool doNormalize, double
         throw LSST_EXCEPT(pexExcept::InvalidParameterError, os.str());
     }
     image.setXY0(-_ctrX, -_ctrY);
+
+    if (_imageCacheSize > 0) {
+        ImageCacheKey const key(std::lround(x / _imageCachePositionQuantum),
+                                std::lround(y / _imageCachePositionQuantum), doNormalize);
+        auto found = _imageCacheMap.find(key);
+        if (found != _imageCacheMap.end()) {
+            _imageCacheLru.splice(_imageCacheLru.begin(), _imageCacheLru, found->second);
+            image.assign(*found->second->image);
+            return found->second->sum;
+        }
+        // Evaluate the spatial model at the center of the quantization cell, not at (x, y),
+        // so the cached image does not depend on which request in the cell came first
+        if (this->isSpatiallyVarying()) {
+            this->setKernelParametersFromSpatialModel(std::get<0>(key) * _imageCachePositionQuantum,
+                                                      std::get<1>(key) * _imageCachePositionQuantum);
+        }
+        double const sum = doComputeImage(image, doNormalize);
+
+        ImageCacheEntry entry = {key, std::make_shared<image::Image<Pixel>>(image, true), sum};
+        _imageCacheLru.push_front(std::move(entry));
+        _imageCacheMap[key] = _imageCacheLru.begin();
+        if (static_cast<int>(_imageCacheLru.size()) > _imageCacheSize) {
+            _imageCacheMap.erase(_imageCacheLru.back().key);
+            _imageCacheLru.pop_back();
+        }
+        return sum;
+    }
+
     if (this->isSpatiallyVarying()) {
         this->setKernelParametersFromSpatialModel(x, y);
     }
     return doComputeImage(image, doNormalize);
 }
 
+Kernel::DeferredImage Kernel::computeImageDeferred(double x, double y) const {
+    auto image = std::make_shared<image::Image<Pixel>>(this->getDimensions());
+    double const sum = computeImage(*image, false, x, y);
+    return DeferredImage(std::move(image), sum);
+}
+
+std::shared_ptr<image::Image<Kernel::Pixel> const> Kernel::DeferredImage::getNormalizedImage() const {
+    if (!_normalized) {
+        if (_sum == 0) {
+            throw LSST_EXCEPT(pexExcept::OverflowError, "Cannot normalize; kernel sum is 0");
+        }
+        auto normalized = std::make_shared<image::Image<Pixel>>(*_image, true);
+        *normalized /= _sum;
+        _normalized = std::move(normalized);
+    }
+    return _normalized;
+}
+
 Kernel::Kernel(int width, int height, std::vector<SpatialFunctionPtr> spatialFunctionList)
         : _width(width),
           _height(height),
           _ctrX(width / 2),
           _ctrY(height / 2),
-          _nKernelParams(spatialFunctionList.size()) {
+          _nKernelParams(spatialFunctionList.size()),
+          _imageCacheSize(0),
+          _imageCachePositionQuantum(1.0) {
     if ((width < 1) || (height < 1)) {
         std::ostringstream os;
         os << "kernel height = " << height << " and/or width = " << width << " < 1";
@@ -139,6 +198,28 @@ void Kernel::setSpatialParameters(const std::vector<std::vector<double> > params
             this->_spatialFunctionList[ii]->setParameters(params[ii]);
         }
     }
+    _invalidateImageCache();
+}
+
+void Kernel::setImageCacheSize(int cacheSize) {
+    if (cacheSize < 0) {
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError,
+                          (boost::format("cacheSize = %d; must be >= 0") % cacheSize).str());
+    }
+    _imageCacheSize = cacheSize;
+    while (static_cast<int>(_imageCacheLru.size()) > _imageCacheSize) {
+        _imageCacheMap.erase(_imageCacheLru.back().key);
+        _imageCacheLru.pop_back();
+    }
+}
+
+void Kernel::setImageCachePositionQuantum(double quantum) {
+    if (!(quantum > 0.0)) {
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError,
+                          (boost::format("quantum = %g; must be > 0") % quantum).str());
+    }
+    _imageCachePositionQuantum = quantum;
+    _invalidateImageCache();
 }
 
 void Kernel::computeKernelParametersFromSpatialModel(std::vector<double> &kernelParams, double x,
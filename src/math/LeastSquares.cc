@@ -112,6 +112,9 @@ public:
 
     virtual void factor() = 0;
 
+    // Solve for all columns of rhsMat at once, reusing the current factorization.
+    virtual Eigen::MatrixXd solveMultiple(Eigen::MatrixXd const& rhsMat) const = 0;
+
     virtual void updateRank() = 0;
 
     virtual void updateSolution() = 0;
@@ -150,6 +153,21 @@ public:
         }
     }
 
+    Eigen::MatrixXd solveMultiple(Eigen::MatrixXd const& rhsMat) const override {
+        if (rank == 0) {
+            return Eigen::MatrixXd::Zero(dimension, rhsMat.cols());
+        }
+        if (_eig.info() == Eigen::Success) {
+            Eigen::MatrixXd tmp = _eig.eigenvectors().rightCols(rank).adjoint() * rhsMat;
+            tmp.array().colwise() /= _eig.eigenvalues().tail(rank).array();
+            return _eig.eigenvectors().rightCols(rank) * tmp;
+        } else {
+            Eigen::MatrixXd tmp = _svd.matrixU().leftCols(rank).adjoint() * rhsMat;
+            tmp.array().colwise() /= _svd.singularValues().head(rank).array();
+            return _svd.matrixU().leftCols(rank) * tmp;
+        }
+    }
+
     void updateRank() override {
         if (_eig.info() == Eigen::Success) {
             setRank(_eig.eigenvalues().reverse());
@@ -223,6 +241,10 @@ public:
         _ldlt.compute(fisher);
     }
 
+    Eigen::MatrixXd solveMultiple(Eigen::MatrixXd const& rhsMat) const override {
+        return _ldlt.solve(rhsMat);
+    }
+
     void updateRank() override {}
 
     void updateDiagnostic() override {
@@ -260,6 +282,11 @@ public:
         LOGL_DEBUG(_log, "Using direct SVD method; dimension=%d, rank=%d", dimension, rank);
     }
 
+    Eigen::MatrixXd solveMultiple(Eigen::MatrixXd const&) const override {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          "Multiple-RHS solves are not available with the DIRECT_SVD factorization.");
+    }
+
     void updateRank() override { setRank(_svd.singularValues()); }
 
     void updateDiagnostic() override {
@@ -305,6 +332,30 @@ private:
 
 }  // namespace
 
+ndarray::Array<double, 2, 2> LeastSquares::solve(ndarray::Array<double const, 2, 2> const& rhs) {
+    if (_impl->factorization == DIRECT_SVD) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          "Multiple-RHS solves are not available with the DIRECT_SVD factorization.");
+    }
+    if (!(_impl->state & Impl::LOWER_FISHER_MATRIX)) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          "Cannot solve before a matrix has been set and factored.");
+    }
+    if (rhs.getSize<1>() != static_cast<ndarray::Size>(_impl->dimension)) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Number of columns of RHS matrix (%d) does not match"
+                                         " dimension of LeastSquares solver.") %
+                           rhs.getSize<1>() % _impl->dimension)
+                                  .str());
+    }
+    // Transpose in and out so that each solve operates on a column, which is what
+    // the factorizations expect; the transposes are cheap compared to the solves.
+    Eigen::MatrixXd solutions = _impl->solveMultiple(ndarray::asEigenMatrix(rhs).transpose());
+    ndarray::Array<double, 2, 2> result = ndarray::allocate(rhs.getSize<0>(), _impl->dimension);
+    ndarray::asEigenMatrix(result) = solutions.transpose();
+    return result;
+}
+
 void LeastSquares::setThreshold(double threshold) {
     _impl->threshold = threshold;
     _impl->state &= ~Impl::SOLUTION_ARRAY;
@@ -424,6 +475,162 @@ void LeastSquares::_factor(bool haveNormalEquations) {
     }
     _impl->factor();
 }
+
+void LeastSquares::_setRhs() {
+    if (_impl->factorization == DIRECT_SVD) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          "Cannot reset the RHS vector with the DIRECT_SVD factorization; "
+                          "it solves directly from the data vector.");
+    }
+    if (!(_impl->state & Impl::LOWER_FISHER_MATRIX)) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          "Cannot reset the RHS vector before a matrix has been set and factored.");
+    }
+    if (_getRhsVector().size() != _impl->dimension) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Number of elements in RHS vector (%d) does not match"
+                                         " dimension of LeastSquares solver.") %
+                           _getRhsVector().size() % _impl->dimension)
+                                  .str());
+    }
+    // Leave the factorization and everything derived from it alone; only the cached
+    // solution is stale.
+    _impl->state |= Impl::RHS_VECTOR;
+    _impl->state &= ~Impl::SOLUTION_ARRAY;
+}
+
+LeastSquares::Accumulator::Accumulator(int dimension)
+        : _fisher(Eigen::MatrixXd::Zero(dimension, dimension)),
+          _rhs(Eigen::VectorXd::Zero(dimension)),
+          _count(0) {
+    if (dimension < 1) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Dimension of Accumulator (%d) must be positive.") % dimension)
+                                  .str());
+    }
+}
+
+void LeastSquares::Accumulator::addObservation(ndarray::Array<double const, 1> const& row, double value,
+                                               double weight) {
+    if (row.getSize<0>() != static_cast<std::size_t>(getDimension())) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Size of observation row (%d) does not match dimension of"
+                                         " Accumulator (%d).") %
+                           row.getSize<0>() % getDimension())
+                                  .str());
+    }
+    if (weight < 0.0) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Observation weight (%g) must be non-negative.") % weight).str());
+    }
+    auto const rowEigen = ndarray::asEigenMatrix(row);
+    _fisher.selfadjointView<Eigen::Lower>().rankUpdate(rowEigen, weight);
+    _rhs.noalias() += (weight * value) * rowEigen;
+    ++_count;
+}
+
+void LeastSquares::Accumulator::addObservations(ndarray::Array<double const, 2> const& rows,
+                                                ndarray::Array<double const, 1> const& values) {
+    std::size_t const n = rows.getSize<0>();
+    if (rows.getSize<1>() != static_cast<std::size_t>(getDimension())) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Number of columns of observation block (%d) does not match"
+                                         " dimension of Accumulator (%d).") %
+                           rows.getSize<1>() % getDimension())
+                                  .str());
+    }
+    if (values.getSize<0>() != n) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Number of values (%d) does not match number of observation"
+                                         " rows (%d).") %
+                           values.getSize<0>() % n)
+                                  .str());
+    }
+    // Copy into a column-major matrix so Eigen can run the rank-k update as a
+    // blocked self-adjoint product (cf. the design matrix note in the header).
+    Eigen::MatrixXd block = ndarray::asEigenMatrix(rows);
+    _fisher.selfadjointView<Eigen::Lower>().rankUpdate(block.adjoint(), 1.0);
+    _rhs.noalias() += block.adjoint() * ndarray::asEigenMatrix(values);
+    _count += n;
+}
+
+void LeastSquares::Accumulator::addObservations(ndarray::Array<double const, 2> const& rows,
+                                                ndarray::Array<double const, 1> const& values,
+                                                ndarray::Array<double const, 1> const& weights) {
+    std::size_t const n = rows.getSize<0>();
+    if (rows.getSize<1>() != static_cast<std::size_t>(getDimension())) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Number of columns of observation block (%d) does not match"
+                                         " dimension of Accumulator (%d).") %
+                           rows.getSize<1>() % getDimension())
+                                  .str());
+    }
+    if (values.getSize<0>() != n || weights.getSize<0>() != n) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Number of values (%d) and weights (%d) must both match number"
+                                         " of observation rows (%d).") %
+                           values.getSize<0>() % weights.getSize<0>() % n)
+                                  .str());
+    }
+    auto const weightsEigen = ndarray::asEigenMatrix(weights);
+    if ((weightsEigen.array() < 0.0).any()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "All observation weights must be non-negative.");
+    }
+    // Scaling the rows by sqrt(weight) reduces the weighted update to the
+    // same blocked rank-k product as the unweighted case.
+    Eigen::MatrixXd block = ndarray::asEigenMatrix(rows);
+    block.array().colwise() *= weightsEigen.array().sqrt();
+    _fisher.selfadjointView<Eigen::Lower>().rankUpdate(block.adjoint(), 1.0);
+    _rhs.noalias() += ndarray::asEigenMatrix(rows).adjoint() *
+                      weightsEigen.cwiseProduct(ndarray::asEigenMatrix(values));
+    _count += n;
+}
+
+void LeastSquares::Accumulator::reset() {
+    _fisher.setZero();
+    _rhs.setZero();
+    _count = 0;
+}
+
+ndarray::Array<double, 2, 2> LeastSquares::Accumulator::getFisherMatrix() const {
+    ndarray::Array<double, 2, 2> out = ndarray::allocate(getDimension(), getDimension());
+    ndarray::asEigenMatrix(out) = Eigen::MatrixXd(_fisher.selfadjointView<Eigen::Lower>());
+    return out;
+}
+
+ndarray::Array<double, 1, 1> LeastSquares::Accumulator::getRhsVector() const {
+    ndarray::Array<double, 1, 1> out = ndarray::allocate(getDimension());
+    ndarray::asEigenMatrix(out) = _rhs;
+    return out;
+}
+
+LeastSquares LeastSquares::Accumulator::makeSolver(Factorization factorization) const {
+    _checkNotEmpty();
+    LeastSquares solver(factorization, getDimension());
+    solver.setNormalEquations(Eigen::MatrixXd(_fisher.selfadjointView<Eigen::Lower>()), _rhs);
+    return solver;
+}
+
+void LeastSquares::Accumulator::updateSolver(LeastSquares& solver) const {
+    _checkNotEmpty();
+    if (solver.getDimension() != getDimension()) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Dimension of solver (%d) does not match dimension of"
+                                         " Accumulator (%d).") %
+                           solver.getDimension() % getDimension())
+                                  .str());
+    }
+    solver.setNormalEquations(Eigen::MatrixXd(_fisher.selfadjointView<Eigen::Lower>()), _rhs);
+}
+
+void LeastSquares::Accumulator::_checkNotEmpty() const {
+    if (_count == 0) {
+        throw LSST_EXCEPT(pex::exceptions::LogicError,
+                          "No observations have been accumulated; cannot build a solver.");
+    }
+}
+
 }  // namespace math
 }  // namespace afw
 }  // namespace lsst
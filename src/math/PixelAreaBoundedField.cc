@@ -21,6 +21,10 @@
  * along with this program.  If not, see <https://www.gnu.org/licenses/>.
  */
 
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
 #include "lsst/afw/math/PixelAreaBoundedField.h"
 #include "lsst/afw/table/io/CatalogVector.h"
 #include "lsst/afw/table/io/OutputArchive.h"
@@ -44,14 +48,32 @@ template std::shared_ptr<math::PixelAreaBoundedField>
 
 namespace math {
 
+namespace {
+
+// Catmull-Rom cubic weights for a fractional position t in [0, 1) relative
+// to the second of four consecutive grid nodes.
+inline void cubicWeights(double t, double w[4]) {
+    double const t2 = t * t;
+    double const t3 = t2 * t;
+    w[0] = 0.5 * (-t3 + 2.0 * t2 - t);
+    w[1] = 0.5 * (3.0 * t3 - 5.0 * t2 + 2.0);
+    w[2] = 0.5 * (-3.0 * t3 + 4.0 * t2 + t);
+    w[3] = 0.5 * (t3 - t2);
+}
+
+}  // namespace
+
 PixelAreaBoundedField::PixelAreaBoundedField(
     lsst::geom::Box2I const &bbox,
     std::shared_ptr<geom::SkyWcs const> skyWcs,
     lsst::geom::AngleUnit const & unit,
-    double scaling
+    double scaling,
+    int gridSpacing
 ) : BoundedField(bbox),
     _skyWcs(skyWcs),
-    _scaling(scaling)
+    _scaling(scaling),
+    _gridSpacing(gridSpacing),
+    _gridOrigin(0, 0)
 {
     if (_skyWcs == nullptr) {
         throw LSST_EXCEPT(
@@ -59,16 +81,137 @@ PixelAreaBoundedField::PixelAreaBoundedField(
             "SkyWcs passed to PixelAreaBoundedField is null."
         );
     }
+    if (_gridSpacing < 0) {
+        throw LSST_EXCEPT(
+            pex::exceptions::InvalidParameterError,
+            "gridSpacing passed to PixelAreaBoundedField must be non-negative."
+        );
+    }
     _scaling /= std::pow((1.0*unit).asRadians(), 2);
+    if (_gridSpacing > 0) {
+        _buildGrid();
+    }
+}
+
+std::shared_ptr<PixelAreaBoundedField> PixelAreaBoundedField::makeGridded(
+    lsst::geom::Box2I const &bbox,
+    std::shared_ptr<geom::SkyWcs const> skyWcs,
+    double maxRelativeError,
+    lsst::geom::AngleUnit const & unit,
+    double scaling,
+    int maxGridSpacing
+) {
+    if (!(maxRelativeError > 0.0)) {
+        throw LSST_EXCEPT(
+            pex::exceptions::InvalidParameterError,
+            "maxRelativeError passed to makeGridded must be positive."
+        );
+    }
+    int constexpr MIN_GRID_SPACING = 16;
+    for (int spacing = maxGridSpacing; spacing >= MIN_GRID_SPACING; spacing /= 2) {
+        auto candidate = std::make_shared<PixelAreaBoundedField>(bbox, skyWcs, unit, scaling, spacing);
+        // Check the interpolant at the cell centres, where it is farthest
+        // from its nodes.
+        std::vector<double> xsVec, ysVec;
+        for (double yc = bbox.getMinY() + 0.5*spacing; yc <= bbox.getMaxY(); yc += spacing) {
+            for (double xc = bbox.getMinX() + 0.5*spacing; xc <= bbox.getMaxX(); xc += spacing) {
+                xsVec.push_back(xc);
+                ysVec.push_back(yc);
+            }
+        }
+        if (xsVec.empty()) {
+            // Box smaller than a single cell; the corners and centre will
+            // have to do.
+            lsst::geom::Box2D const box(bbox);
+            for (auto const & corner : box.getCorners()) {
+                xsVec.push_back(corner.getX());
+                ysVec.push_back(corner.getY());
+            }
+            xsVec.push_back(box.getCenterX());
+            ysVec.push_back(box.getCenterY());
+        }
+        ndarray::Array<double, 1, 1> xs = ndarray::allocate(xsVec.size());
+        ndarray::Array<double, 1, 1> ys = ndarray::allocate(ysVec.size());
+        std::copy(xsVec.begin(), xsVec.end(), xs.begin());
+        std::copy(ysVec.begin(), ysVec.end(), ys.begin());
+        ndarray::Array<double, 1, 1> exact = ndarray::allocate(xs.size());
+        candidate->_evaluateExact(xs, ys, exact);
+        double maxError = 0.0;
+        for (std::size_t i = 0; i != xs.size(); ++i) {
+            double const interpolated =
+                    candidate->_evaluateGrid(lsst::geom::Point2D(xs[i], ys[i]));
+            maxError = std::max(maxError, std::abs(interpolated - exact[i]) / std::abs(exact[i]));
+        }
+        if (maxError <= maxRelativeError) {
+            return candidate;
+        }
+    }
+    // No acceptable grid; fall back to exact evaluation.
+    return std::make_shared<PixelAreaBoundedField>(bbox, skyWcs, unit, scaling);
+}
+
+void PixelAreaBoundedField::_buildGrid() {
+    lsst::geom::Box2I const bbox = getBBox();
+    int const s = _gridSpacing;
+    // One node beyond the box on every side, so the four-node bicubic
+    // stencil is available everywhere inside it.
+    _gridOrigin = lsst::geom::Point2I(bbox.getMinX() - s, bbox.getMinY() - s);
+    int const nx = (bbox.getWidth() + s - 1) / s + 4;
+    int const ny = (bbox.getHeight() + s - 1) / s + 4;
+    _grid = ndarray::allocate(ny, nx);
+    ndarray::Array<double, 1, 1> xs = ndarray::allocate(static_cast<std::size_t>(nx) * ny);
+    ndarray::Array<double, 1, 1> ys = ndarray::allocate(static_cast<std::size_t>(nx) * ny);
+    std::size_t k = 0;
+    for (int j = 0; j != ny; ++j) {
+        for (int i = 0; i != nx; ++i, ++k) {
+            xs[k] = _gridOrigin.getX() + i * s;
+            ys[k] = _gridOrigin.getY() + j * s;
+        }
+    }
+    ndarray::Array<double, 1, 1> flat = ndarray::flatten<1>(_grid);
+    _evaluateExact(xs, ys, flat);
+}
+
+double PixelAreaBoundedField::_evaluateGrid(lsst::geom::Point2D const & position) const {
+    int const nx = _grid.getSize<1>();
+    int const ny = _grid.getSize<0>();
+    double const gx = (position.getX() - _gridOrigin.getX()) / _gridSpacing;
+    double const gy = (position.getY() - _gridOrigin.getY()) / _gridSpacing;
+    // Clamp so the stencil stays inside the grid; points beyond the outer
+    // nodes become extrapolations of the edge cells.
+    int const ix = std::min(std::max(static_cast<int>(std::floor(gx)), 1), nx - 3);
+    int const iy = std::min(std::max(static_cast<int>(std::floor(gy)), 1), ny - 3);
+    double wx[4], wy[4];
+    cubicWeights(gx - ix, wx);
+    cubicWeights(gy - iy, wy);
+    double z = 0.0;
+    for (int j = 0; j != 4; ++j) {
+        auto const row = _grid[iy + j - 1];
+        z += wy[j] * (row[ix - 1]*wx[0] + row[ix]*wx[1] + row[ix + 1]*wx[2] + row[ix + 2]*wx[3]);
+    }
+    return z;
 }
 
 double PixelAreaBoundedField::evaluate(lsst::geom::Point2D const &position) const {
+    if (_gridSpacing > 0) {
+        return _evaluateGrid(position);
+    }
     return std::pow(_skyWcs->getPixelScale(position).asRadians(), 2) * _scaling;
 }
 
 ndarray::Array<double, 1, 1> PixelAreaBoundedField::evaluate(
     ndarray::Array<double const, 1> const & x,
     ndarray::Array<double const, 1> const & y
+) const {
+    ndarray::Array<double, 1, 1> z = ndarray::allocate(x.getShape());
+    evaluate(x, y, z);
+    return z;
+}
+
+void PixelAreaBoundedField::evaluate(
+    ndarray::Array<double const, 1> const & x,
+    ndarray::Array<double const, 1> const & y,
+    ndarray::Array<double, 1, 1> const & out
 ) const {
     if (x.getShape() != y.getShape()) {
         throw LSST_EXCEPT(
@@ -76,6 +219,21 @@ ndarray::Array<double, 1, 1> PixelAreaBoundedField::evaluate(
             (boost::format("Inconsistent shapes in evaluate; %s != %s.") % x.getShape() % y.getShape()).str()
         );
     }
+    if (_gridSpacing > 0) {
+        std::size_t const n = x.size();
+        for (std::size_t i = 0; i < n; ++i) {
+            out[i] = _evaluateGrid(lsst::geom::Point2D(x[i], y[i]));
+        }
+        return;
+    }
+    _evaluateExact(x, y, out);
+}
+
+void PixelAreaBoundedField::_evaluateExact(
+    ndarray::Array<double const, 1> const & x,
+    ndarray::Array<double const, 1> const & y,
+    ndarray::Array<double, 1, 1> const & out
+) const {
     // Compute _skyWcs->pixelToSky at all of the given points in a single
     // vectorized call, along with points one pixel away in x and y.
     double constexpr side = 1.0;
@@ -89,16 +247,14 @@ ndarray::Array<double, 1, 1> PixelAreaBoundedField::evaluate(
     }
     auto skyPoints = _skyWcs->pixelToSky(pixPoints);
     // Work in 3-space to avoid RA wrapping and pole issues.
-    ndarray::Array<double, 1, 1> z = ndarray::allocate(x.getShape());
     for (std::size_t i = 0; i < n; ++i) {
         std::size_t j = i*3;
         auto skyLL = skyPoints[j].getVector();
         auto skyDx = skyPoints[j + 1].getVector() - skyLL;
         auto skyDy = skyPoints[j + 2].getVector() - skyLL;
         double skyAreaSq = skyDx.cross(skyDy).getSquaredNorm();
-        z[i] = _scaling * std::sqrt(skyAreaSq) / (side*side);
+        out[i] = _scaling * std::sqrt(skyAreaSq) / (side*side);
     }
-    return z;
 }
 
 bool PixelAreaBoundedField::isPersistable() const noexcept {
@@ -106,7 +262,8 @@ bool PixelAreaBoundedField::isPersistable() const noexcept {
 }
 
 std::shared_ptr<BoundedField> PixelAreaBoundedField::operator*(double const scale) const {
-    return std::make_shared<PixelAreaBoundedField>(getBBox(), _skyWcs, lsst::geom::radians, _scaling*scale);
+    return std::make_shared<PixelAreaBoundedField>(getBBox(), _skyWcs, lsst::geom::radians, _scaling*scale,
+                                                   _gridSpacing);
 }
 
 bool PixelAreaBoundedField::operator==(BoundedField const &rhs) const {
@@ -114,12 +271,16 @@ bool PixelAreaBoundedField::operator==(BoundedField const &rhs) const {
     if (!rhsCasted) return false;
 
     return getBBox() == rhsCasted->getBBox() && *_skyWcs == *rhsCasted->_skyWcs &&
-        _scaling == rhsCasted->_scaling;
+        _scaling == rhsCasted->_scaling && _gridSpacing == rhsCasted->_gridSpacing;
 }
 
 std::string PixelAreaBoundedField::toString() const {
     std::ostringstream os;
-    os << "PixelAreaBoundedField(" << (*_skyWcs) << ", scaling=" << _scaling << ")";
+    os << "PixelAreaBoundedField(" << (*_skyWcs) << ", scaling=" << _scaling;
+    if (_gridSpacing > 0) {
+        os << ", gridSpacing=" << _gridSpacing;
+    }
+    os << ")";
     return os.str();
 }
 
@@ -131,6 +292,7 @@ struct PersistenceHelper {
     table::Box2IKey bbox;
     table::Key<int> wcs;
     table::Key<double> scaling;
+    table::Key<int> gridSpacing;
 
     static PersistenceHelper const & get() {
         static PersistenceHelper const instance;
@@ -143,7 +305,10 @@ private:
         bbox(table::Box2IKey::addFields(schema, "bbox", "Bounding box for field.", "pixel")),
         wcs(schema.addField<int>("wcs", "Archive ID for SkyWcs instance.")),
         scaling(schema.addField<double>("scaling",
-                                        "Scaling factor (including any transformation from rad^2."))
+                                        "Scaling factor (including any transformation from rad^2.")),
+        gridSpacing(schema.addField<int>("gridSpacing",
+                                         "Spacing of the interpolation grid; 0 for exact evaluation.",
+                                         "pixel"))
     {}
     PersistenceHelper(PersistenceHelper const &) = delete;
     PersistenceHelper(PersistenceHelper &&) = delete;
@@ -163,11 +328,18 @@ public:
         LSST_ARCHIVE_ASSERT(catalogs.front().size() == 1u);
         table::BaseRecord const& record = catalogs.front().front();
         auto const & keys = PersistenceHelper::get();
-        LSST_ARCHIVE_ASSERT(record.getSchema() == keys.schema);
+        // Records written before the gridded mode was added lack the
+        // gridSpacing field; their remaining fields have the same layout.
+        LSST_ARCHIVE_ASSERT(keys.schema.contains(record.getSchema()));
         lsst::geom::Box2I bbox(record.get(keys.bbox));
         auto wcs = archive.get<afw::geom::SkyWcs>(record.get(keys.wcs));
         double scaling = record.get(keys.scaling);
-        return std::make_shared<PixelAreaBoundedField>(bbox, wcs, lsst::geom::radians, scaling);
+        int gridSpacing = 0;
+        if (record.getSchema() == keys.schema) {
+            gridSpacing = record.get(keys.gridSpacing);
+        }
+        return std::make_shared<PixelAreaBoundedField>(bbox, wcs, lsst::geom::radians, scaling,
+                                                       gridSpacing);
     }
 };
 
@@ -190,6 +362,7 @@ void PixelAreaBoundedField::write(OutputArchiveHandle& handle) const {
     record->set(keys.bbox, getBBox());
     record->set(keys.wcs, handle.put(_skyWcs));
     record->set(keys.scaling, _scaling);
+    record->set(keys.gridSpacing, _gridSpacing);
     handle.saveCatalog(catalog);
 }
 
@@ -86,6 +86,16 @@ double ProductBoundedField::evaluate(lsst::geom::Point2D const& position) const
 ndarray::Array<double, 1, 1> ProductBoundedField::evaluate(
     ndarray::Array<double const, 1> const& x,
     ndarray::Array<double const, 1> const& y
+) const {
+    ndarray::Array<double, 1, 1> z = ndarray::allocate(x.getShape());
+    evaluate(x, y, z);
+    return z;
+}
+
+void ProductBoundedField::evaluate(
+    ndarray::Array<double const, 1> const& x,
+    ndarray::Array<double const, 1> const& y,
+    ndarray::Array<double, 1, 1> const& out
 ) const {
     if (x.getShape() != y.getShape()) {
         throw LSST_EXCEPT(
@@ -93,12 +103,20 @@ ndarray::Array<double, 1, 1> ProductBoundedField::evaluate(
             (boost::format("Inconsistent shapes: %s != %s") % x.getShape() % y.getShape()).str()
         );
     }
-    ndarray::Array<double, 1, 1> z = ndarray::allocate(x.getShape());
-    std::fill(z.begin(), z.end(), 1.0);
-    for (auto const & field : _factors) {
-        ndarray::asEigenArray(z) *= ndarray::asEigenArray(field->evaluate(x, y));
+    // Evaluate the first factor directly into the output, then multiply the remaining
+    // factors in through a single scratch buffer, rather than allocating a fresh lane
+    // buffer for every factor.
+    auto iter = _factors.begin();
+    (**iter).evaluate(x, y, out);
+    ++iter;
+    if (iter == _factors.end()) {
+        return;
+    }
+    ndarray::Array<double, 1, 1> scratch = ndarray::allocate(x.getShape());
+    for (; iter != _factors.end(); ++iter) {
+        (**iter).evaluate(x, y, scratch);
+        ndarray::asEigenArray(out) *= ndarray::asEigenArray(scratch);
     }
-    return z;
 }
 
 // ------------------ persistence ---------------------------------------------------------------------------
@@ -26,6 +26,7 @@
  * Random number generator implementaion.
  */
 
+#include <cstdint>
 #include <cstdlib>
 #include <limits>
 
@@ -44,16 +45,102 @@ namespace lsst {
 namespace afw {
 namespace math {
 
+namespace {
+
+/*
+ * The Philox 4x32-10 counter-based generator of Salmon et al. (2011), exposed through
+ * the GSL generator interface so that the rest of this class does not need to know
+ * about it.  The output is a pure function of a 128-bit counter and a 64-bit key; the
+ * key is derived from the seed, the high 64 bits of the counter identify a stream
+ * (see Random::split), and the low 64 bits count the blocks drawn from that stream.
+ */
+
+struct PhiloxState {
+    std::uint64_t counter;   // number of 4x32 output blocks generated on this stream
+    std::uint64_t stream;    // stream identifier; see Random::split
+    std::uint32_t key[2];    // key material derived from the seed
+    std::uint32_t buffer[4]; // outputs of the most recent block
+    unsigned int bufferPos;  // index of the next unused element of buffer
+};
+
+inline std::uint32_t philoxMulHi(std::uint32_t a, std::uint32_t b, std::uint32_t *lo) {
+    std::uint64_t const product = static_cast<std::uint64_t>(a) * b;
+    *lo = static_cast<std::uint32_t>(product);
+    return static_cast<std::uint32_t>(product >> 32);
+}
+
+void philoxGenerate(PhiloxState *state) {
+    std::uint32_t const mult0 = 0xD2511F53u;
+    std::uint32_t const mult1 = 0xCD9E8D57u;
+    std::uint32_t const bump0 = 0x9E3779B9u;  // golden ratio
+    std::uint32_t const bump1 = 0xBB67AE85u;  // sqrt(3) - 1
+
+    std::uint32_t ctr[4] = {static_cast<std::uint32_t>(state->counter),
+                            static_cast<std::uint32_t>(state->counter >> 32),
+                            static_cast<std::uint32_t>(state->stream),
+                            static_cast<std::uint32_t>(state->stream >> 32)};
+    std::uint32_t key[2] = {state->key[0], state->key[1]};
+
+    for (int round = 0; round < 10; ++round) {
+        std::uint32_t lo0, lo1;
+        std::uint32_t const hi0 = philoxMulHi(mult0, ctr[0], &lo0);
+        std::uint32_t const hi1 = philoxMulHi(mult1, ctr[2], &lo1);
+        ctr[0] = hi1 ^ ctr[1] ^ key[0];
+        ctr[1] = lo1;
+        ctr[2] = hi0 ^ ctr[3] ^ key[1];
+        ctr[3] = lo0;
+        key[0] += bump0;
+        key[1] += bump1;
+    }
+
+    for (int i = 0; i < 4; ++i) {
+        state->buffer[i] = ctr[i];
+    }
+    ++state->counter;
+    state->bufferPos = 0;
+}
+
+void philoxSet(void *vstate, unsigned long int s) {
+    PhiloxState *state = static_cast<PhiloxState *>(vstate);
+    state->counter = 0;
+    state->stream = 0;
+    state->key[0] = static_cast<std::uint32_t>(s);
+    state->key[1] = static_cast<std::uint32_t>(static_cast<std::uint64_t>(s) >> 32);
+    state->bufferPos = 4;
+}
+
+unsigned long int philoxGet(void *vstate) {
+    PhiloxState *state = static_cast<PhiloxState *>(vstate);
+    if (state->bufferPos == 4) {
+        philoxGenerate(state);
+    }
+    return state->buffer[state->bufferPos++];
+}
+
+double philoxGetDouble(void *vstate) { return philoxGet(vstate) / 4294967296.0; }
+
+::gsl_rng_type const philoxRngType = {
+        "PHILOX",             // name
+        0xFFFFFFFFul,         // max
+        0,                    // min
+        sizeof(PhiloxState),  // size of state
+        &philoxSet,
+        &philoxGet,
+        &philoxGetDouble,
+};
+
+}  // namespace
+
 // -- Static data --------
 
 ::gsl_rng_type const *const Random::_gslRngTypes[Random::NUM_ALGORITHMS] = {
         ::gsl_rng_mt19937, ::gsl_rng_ranlxs0, ::gsl_rng_ranlxs1,   ::gsl_rng_ranlxs2, ::gsl_rng_ranlxd1,
         ::gsl_rng_ranlxd2, ::gsl_rng_ranlux,  ::gsl_rng_ranlux389, ::gsl_rng_cmrg,    ::gsl_rng_mrg,
-        ::gsl_rng_taus,    ::gsl_rng_taus2,   ::gsl_rng_gfsr4};
+        ::gsl_rng_taus,    ::gsl_rng_taus2,   ::gsl_rng_gfsr4,     &philoxRngType};
 
 char const *const Random::_algorithmNames[Random::NUM_ALGORITHMS] = {
         "MT19937",   "RANLXS0", "RANLXS1", "RANLXS2", "RANLXD1", "RANLXD2", "RANLUX",
-        "RANLUX389", "CMRG",    "MRG",     "TAUS",    "TAUS2",   "GFSR4"};
+        "RANLUX389", "CMRG",    "MRG",     "TAUS",    "TAUS2",   "GFSR4",   "PHILOX"};
 
 char const *const Random::_algorithmEnvVarName = "LSST_RNG_ALGORITHM";
 char const *const Random::_seedEnvVarName = "LSST_RNG_SEED";
@@ -106,6 +193,22 @@ Random Random::deepCopy() const {
     return rng;
 }
 
+Random Random::split(unsigned long streamIndex) const {
+    if (_algorithm != PHILOX) {
+        throw LSST_EXCEPT(ex::InvalidParameterError,
+                          "Stream splitting is only supported by the PHILOX algorithm");
+    }
+    Random rng = deepCopy();
+    // The key (and hence the seed) is shared with the parent; only the stream
+    // half of the counter distinguishes the child, so the child's output does
+    // not depend on how far along the parent is.
+    PhiloxState *state = static_cast<PhiloxState *>(::gsl_rng_state(rng._rng.get()));
+    state->counter = 0;
+    state->stream = streamIndex;
+    state->bufferPos = 4;
+    return rng;
+}
+
 Random::State Random::getState() const {
     return State(static_cast<char *>(::gsl_rng_state(_rng.get())), getStateSize());
 }
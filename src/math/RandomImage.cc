@@ -25,9 +25,17 @@
 /*
  * Fill Images with Random numbers
  */
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <exception>
+#include <vector>
+
+#include "lsst/geom/Angle.h"
 #include "lsst/afw/image/Image.h"
 #include "lsst/afw/image/ImageAlgorithm.h"
 #include "lsst/afw/math/Random.h"
+#include "lsst/afw/math/TaskPool.h"
 
 namespace lsst {
 namespace afw {
@@ -78,13 +86,6 @@ private:
     double const _b;
 };
 
-template <typename T>
-struct do_gaussian : public do_random<T> {
-    do_gaussian(Random &rand) : do_random<T>(rand) {}
-
-    T operator()() const override { return do_random<T>::_rand.gaussian(); }
-};
-
 template <typename T>
 struct do_chisq : public do_random<T> {
     do_chisq(Random &rand, double nu) : do_random<T>(rand), _nu(nu) {}
@@ -95,15 +96,43 @@ private:
     double const _nu;
 };
 
-template <typename T>
-struct do_poisson : public do_random<T> {
-    do_poisson(Random &rand, double mu) : do_random<T>(rand), _mu(mu) {}
-
-    T operator()() const override { return do_random<T>::_rand.poisson(_mu); }
-
-private:
-    double const _mu;
-};
+/**
+ * Fill a buffer of `n` pixels with N(0, 1) deviates generated in blocks with the
+ * Box-Muller transform.
+ *
+ * The uniform draws have to go through the generator one at a time, but the
+ * transcendental functions - which dominate the per-pixel cost - are applied in
+ * passes over plain arrays with no function calls in between, so the compiler is
+ * free to vectorize them.
+ */
+template <typename Pixel>
+void fillGaussian(Random &rand, Pixel *out, std::ptrdiff_t n) {
+    constexpr std::ptrdiff_t blockSize = 512;  // deviates per block; must be even
+    double radius[blockSize / 2];
+    double cosine[blockSize / 2];
+    double sine[blockSize / 2];
+    while (n > 0) {
+        std::ptrdiff_t const pairs = (std::min(blockSize, n) + 1) / 2;
+        for (std::ptrdiff_t i = 0; i < pairs; ++i) {
+            radius[i] = rand.uniformPos();
+            cosine[i] = rand.uniform();
+        }
+        for (std::ptrdiff_t i = 0; i < pairs; ++i) {
+            double const angle = lsst::geom::TWOPI * cosine[i];
+            radius[i] = std::sqrt(-2.0 * std::log(radius[i]));
+            cosine[i] = std::cos(angle);
+            sine[i] = std::sin(angle);
+        }
+        for (std::ptrdiff_t i = 0; i < pairs && n > 0; ++i) {
+            *out++ = radius[i] * cosine[i];
+            --n;
+            if (n > 0) {
+                *out++ = radius[i] * sine[i];
+                --n;
+            }
+        }
+    }
+}
 }  // namespace
 
 template <typename ImageT>
@@ -128,7 +157,41 @@ void randomFlatImage(ImageT *image, Random &rand, double const a, double const b
 
 template <typename ImageT>
 void randomGaussianImage(ImageT *image, Random &rand) {
-    lsst::afw::image::for_each_pixel(*image, do_gaussian<typename ImageT::Pixel>(rand));
+    for (int y = 0; y != image->getHeight(); ++y) {
+        fillGaussian(rand, &*image->row_begin(y), image->getWidth());
+    }
+}
+
+template <typename ImageT>
+void randomGaussianImage(ImageT *image, Random &rand, int numThreads) {
+    if (rand.getAlgorithm() != Random::PHILOX) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          "Reproducible parallel image generation requires the PHILOX algorithm");
+    }
+    int const height = image->getHeight();
+    // A single draw from the parent generator selects the block of streams used by
+    // this call, so that successive calls with the same generator produce different
+    // (but reproducible) images.  Each row then gets its own stream, making the
+    // result independent of how the rows are divided among threads.
+    unsigned long const epoch = rand.uniformInt(1UL << 31);
+    auto work = [image, &rand, epoch](int beginRow, int endRow) {
+        for (int y = beginRow; y < endRow; ++y) {
+            Random rowRand = rand.split((epoch << 32) | static_cast<unsigned long>(y));
+            fillGaussian(rowRand, &*image->row_begin(y), image->getWidth());
+        }
+    };
+    numThreads = std::min(numThreads, height);
+    if (numThreads > 1 && height >= 2 * numThreads) {
+        TaskPool::TaskGroup group;
+        for (int band = 0; band < numThreads; ++band) {
+            int const beginRow = band * height / numThreads;
+            int const endRow = (band + 1) * height / numThreads;
+            group.run([&work, beginRow, endRow] { work(beginRow, endRow); });
+        }
+        group.wait();
+    } else {
+        work(0, height);
+    }
 }
 
 template <typename ImageT>
@@ -138,7 +201,13 @@ void randomChisqImage(ImageT *image, Random &rand, double const nu) {
 
 template <typename ImageT>
 void randomPoissonImage(ImageT *image, Random &rand, double const mu) {
-    lsst::afw::image::for_each_pixel(*image, do_poisson<typename ImageT::Pixel>(rand, mu));
+    // fill the row buffers directly rather than going through for_each_pixel,
+    // which costs a virtual function call per pixel
+    for (int y = 0; y != image->getHeight(); ++y) {
+        for (auto ptr = image->row_begin(y), end = image->row_end(y); ptr != end; ++ptr) {
+            *ptr = rand.poisson(mu);
+        }
+    }
 }
 
 //
@@ -152,6 +221,7 @@ void randomPoissonImage(ImageT *image, Random &rand, double const mu) {
     template void randomFlatImage(lsst::afw::image::Image<T> *image, Random &rand, double const a,         \
                                   double const b);                                                         \
     template void randomGaussianImage(lsst::afw::image::Image<T> *image, Random &rand);                    \
+    template void randomGaussianImage(lsst::afw::image::Image<T> *image, Random &rand, int numThreads);    \
     template void randomChisqImage(lsst::afw::image::Image<T> *image, Random &rand, double const nu);      \
     template void randomPoissonImage(lsst::afw::image::Image<T> *image, Random &rand, double const mu);
 
@@ -26,8 +26,10 @@
 #include <sstream>
 
 #include "lsst/pex/exceptions.h"
+#include "lsst/afw/math/FunctionLibrary.h"
 #include "lsst/afw/math/Kernel.h"
 #include "lsst/afw/math/KernelPersistenceHelper.h"
+#include "lsst/afw/math/warpExposure.h"
 #include "lsst/afw/table/io/Persistable.cc"
 
 namespace pexExcept = lsst::pex::exceptions;
@@ -196,57 +198,51 @@ void SeparableKernel::setKernelParameter(unsigned int ind, double value) const {
 // Private Member Functions
 //
 
+namespace {
+/**
+ * @internal Evaluate a 1-d kernel function at a list of positions,
+ * devirtualized for the function types that dominate warping and smoothing
+ */
+void _evaluateKernelFunction1(SeparableKernel::KernelFunction const& func, std::vector<double> const& x,
+                              std::vector<Kernel::Pixel>& values) {
+    evaluateFunction1Array<LanczosFunction1<Kernel::Pixel>, GaussianFunction1<Kernel::Pixel>,
+                           BilinearWarpingKernel::BilinearFunction1, NearestWarpingKernel::NearestFunction1>(
+            func, x.data(), values.data(), values.size());
+}
+}  // namespace
+
 double SeparableKernel::basicComputeVectors(std::vector<Pixel>& colList, std::vector<Pixel>& rowList,
                                             bool doNormalize) const {
     double colSum = 0.0;
     if (_kernelColCache.empty()) {
+        _evaluateKernelFunction1(*_kernelColFunctionPtr, _kernelX, colList);
         for (unsigned int i = 0; i != colList.size(); ++i) {
-            double colFuncValue = (*_kernelColFunctionPtr)(_kernelX[i]);
-            colList[i] = colFuncValue;
-            colSum += colFuncValue;
+            colSum += colList[i];
         }
     } else {
         int const cacheSize = _kernelColCache.size();
 
         int const indx = this->getKernelParameter(0) * cacheSize;
 
-        std::vector<double>& cachedValues = _kernelColCache.at(indx);
-        for (unsigned int i = 0; i != colList.size(); ++i) {
-            double colFuncValue = cachedValues[i];
-            colList[i] = colFuncValue;
-            colSum += colFuncValue;
-        }
+        std::vector<double> const& cachedValues = _kernelColCache.at(indx);
+        std::copy(cachedValues.begin(), cachedValues.end(), colList.begin());
+        colSum = _kernelColCacheSums[indx];
     }
 
     double rowSum = 0.0;
     if (_kernelRowCache.empty()) {
+        _evaluateKernelFunction1(*_kernelRowFunctionPtr, _kernelY, rowList);
         for (unsigned int i = 0; i != rowList.size(); ++i) {
-            double rowFuncValue = (*_kernelRowFunctionPtr)(_kernelY[i]);
-            rowList[i] = rowFuncValue;
-            rowSum += rowFuncValue;
+            rowSum += rowList[i];
         }
     } else {
         int const cacheSize = _kernelRowCache.size();
 
         int const indx = this->getKernelParameter(1) * cacheSize;
 
-        std::vector<double>& cachedValues = _kernelRowCache.at(indx);
-        for (unsigned int i = 0; i != rowList.size(); ++i) {
-            double rowFuncValue = cachedValues[i];
-            rowList[i] = rowFuncValue;
-            rowSum += rowFuncValue;
-
-#if 0
-            if (indx == cacheSize/2) {
-                if (::fabs(rowFuncValue - (*_kernelRowFunctionPtr)(_kernelX[i])) > 1e-2) {
-                    std::cout << indx << " " << i << " "
-                              << rowFuncValue << " "
-                              << (*_kernelRowFunctionPtr)(_kernelX[i])
-                              << std::endl;
-                }
-            }
-#endif
-        }
+        std::vector<double> const& cachedValues = _kernelRowCache.at(indx);
+        std::copy(cachedValues.begin(), cachedValues.end(), rowList.begin());
+        rowSum = _kernelRowCacheSums[indx];
     }
 
     double imSum = colSum * rowSum;
@@ -271,9 +267,11 @@ namespace {
  * @internal Compute a cache of pre-computed Kernels
  */
 void _computeCache(int const cacheSize, std::vector<double> const& x,
-                   SeparableKernel::KernelFunctionPtr& func, std::vector<std::vector<double> >* kernelCache) {
+                   SeparableKernel::KernelFunctionPtr& func, std::vector<std::vector<double> >* kernelCache,
+                   std::vector<double>* kernelCacheSums) {
     if (cacheSize <= 0) {
         kernelCache->erase(kernelCache->begin(), kernelCache->end());
+        kernelCacheSums->erase(kernelCacheSums->begin(), kernelCacheSums->end());
         return;
     }
 
@@ -295,14 +293,19 @@ void _computeCache(int const cacheSize, std::vector<double> const& x,
             (*kernelCache)[i].resize(x.size());
         }
     }
+    kernelCacheSums->resize(cacheSize);
     //
     // Actually fill the cache
     //
     for (int i = 0; i != cacheSize; ++i) {
         func->setParameter(0, (i + 0.5) / static_cast<double>(cacheSize));
+        double sum = 0.0;
         for (unsigned int j = 0; j != x.size(); ++j) {
-            (*kernelCache)[i][j] = (*func)(x[j]);
+            double const value = (*func)(x[j]);
+            (*kernelCache)[i][j] = value;
+            sum += value;
         }
+        (*kernelCacheSums)[i] = sum;
     }
 }
 }  // namespace
@@ -311,10 +314,10 @@ void SeparableKernel::computeCache(int const cacheSize) {
     SeparableKernel::KernelFunctionPtr func;
 
     func = getKernelColFunction();
-    _computeCache(cacheSize, _kernelY, func, &_kernelColCache);
+    _computeCache(cacheSize, _kernelY, func, &_kernelColCache, &_kernelColCacheSums);
 
     func = getKernelRowFunction();
-    _computeCache(cacheSize, _kernelX, func, &_kernelRowCache);
+    _computeCache(cacheSize, _kernelX, func, &_kernelRowCache, &_kernelRowCacheSums);
 }
 
 int SeparableKernel::getCacheSize() const { return _kernelColCache.size(); };
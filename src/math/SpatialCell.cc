@@ -301,9 +301,10 @@ std::shared_ptr<SpatialCellCandidate> SpatialCellCandidateIterator::operator*()
 }
 
 SpatialCellSet::SpatialCellSet(lsst::geom::Box2I const &region, int xSize, int ySize)
-        : _region(region), _cellList(CellList()) {
+        : _region(region), _cellList(CellList()), _xSize(xSize), _ySize(ySize), _nx(0), _ny(0) {
     if (ySize == 0) {
         ySize = xSize;
+        _ySize = ySize;
     }
 
     if (xSize <= 0 || ySize <= 0) {
@@ -321,6 +322,9 @@ SpatialCellSet::SpatialCellSet(lsst::geom::Box2I const &region, int xSize, int y
     if (ny * ySize != region.getHeight()) {
         ny++;
     }
+
+    _nx = nx;
+    _ny = ny;
     //
     // N.b. the SpatialCells will be sorted in y at the end of this
     //
@@ -343,32 +347,68 @@ SpatialCellSet::SpatialCellSet(lsst::geom::Box2I const &region, int xSize, int y
     }
 }
 
-namespace {
-struct CellContains : public std::unary_function<std::shared_ptr<SpatialCell>, bool> {
-    CellContains(std::shared_ptr<SpatialCellCandidate> candidate) : _candidate(candidate) {}
-
-    bool operator()(std::shared_ptr<SpatialCell> cell) {
-        return cell->getBBox().contains(
-                lsst::geom::Point2I(image::positionToIndex(_candidate->getXCenter()),
-                                    image::positionToIndex(_candidate->getYCenter())));
+std::shared_ptr<SpatialCell> SpatialCellSet::_lookupCell(lsst::geom::Point2I const &point) const {
+    if (!_region.contains(point)) {
+        return std::shared_ptr<SpatialCell>();
     }
+    // The grid is regular except that the last cell in each direction may be oversized,
+    // so clamping the quotient to the last index makes this exact
+    int const ix = std::min((point.getX() - _region.getMinX()) / _xSize, _nx - 1);
+    int const iy = std::min((point.getY() - _region.getMinY()) / _ySize, _ny - 1);
 
-private:
-    std::shared_ptr<SpatialCellCandidate> _candidate;
-};
-}  // namespace
+    return _cellList[iy * _nx + ix];
+}
 
 void SpatialCellSet::insertCandidate(std::shared_ptr<SpatialCellCandidate> candidate) {
-    CellList::iterator pos = std::find_if(_cellList.begin(), _cellList.end(), CellContains(candidate));
+    std::shared_ptr<SpatialCell> cell =
+            _lookupCell(lsst::geom::Point2I(image::positionToIndex(candidate->getXCenter()),
+                                            image::positionToIndex(candidate->getYCenter())));
 
-    if (pos == _cellList.end()) {
+    if (!cell) {
         throw LSST_EXCEPT(lsst::pex::exceptions::OutOfRangeError,
                           (boost::format("Unable to insert a candidate at (%.2f, %.2f)") %
                            candidate->getXCenter() % candidate->getYCenter())
                                   .str());
     }
 
-    (*pos)->insertCandidate(candidate);
+    cell->insertCandidate(candidate);
+}
+
+SpatialCell::CandidateList SpatialCellSet::findCandidatesIn(lsst::geom::Box2I const &bbox,
+                                                            bool ignoreBad) const {
+    SpatialCell::CandidateList candidates;
+
+    lsst::geom::Box2I search(bbox);
+    search.clip(_region);
+    if (search.isEmpty()) {
+        return candidates;
+    }
+
+    int const ix0 = std::min((search.getMinX() - _region.getMinX()) / _xSize, _nx - 1);
+    int const iy0 = std::min((search.getMinY() - _region.getMinY()) / _ySize, _ny - 1);
+    int const ix1 = std::min((search.getMaxX() - _region.getMinX()) / _xSize, _nx - 1);
+    int const iy1 = std::min((search.getMaxY() - _region.getMinY()) / _ySize, _ny - 1);
+
+    for (int iy = iy0; iy <= iy1; ++iy) {
+        for (int ix = ix0; ix <= ix1; ++ix) {
+            // Cast away const; begin/end is only non-const as they provide access to the Candidates
+            // and we don't (yet) have SpatialCellCandidateConstIterator
+            SpatialCell *cell = const_cast<SpatialCell *>(_cellList[iy * _nx + ix].get());
+            // Cells interior to bbox need no per-candidate containment test
+            bool const interior = bbox.contains(cell->getBBox());
+
+            for (SpatialCellCandidateIterator cand = cell->begin(ignoreBad), candEnd = cell->end(ignoreBad);
+                 cand != candEnd; ++cand) {
+                if (interior ||
+                    bbox.contains(lsst::geom::Point2I(image::positionToIndex((*cand)->getXCenter()),
+                                                      image::positionToIndex((*cand)->getYCenter())))) {
+                    candidates.push_back(*cand);
+                }
+            }
+        }
+    }
+
+    return candidates;
 }
 
 void SpatialCellSet::sortCandidates() {
@@ -26,14 +26,19 @@
  * Provide functions to stack images
  *
  */
+#include <algorithm>
 #include <vector>
 #include <cassert>
+#include <cmath>
+#include <exception>
 #include <memory>
 
 #include "lsst/base.h"
 #include "lsst/pex/exceptions.h"
+#include "lsst/afw/instrumentation.h"
 #include "lsst/afw/math/Stack.h"
 #include "lsst/afw/math/MaskedVector.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/log/Log.h"
 
 namespace pexExcept = lsst::pex::exceptions;
@@ -88,6 +93,24 @@ void checkObjectsAndWeights(ObjectVectorT const &objects, WeightVectorT const &w
     }
 }
 
+/**
+ * @internal Run `work(beginRow, endRow)` over horizontal bands of output rows on the shared pool
+ *
+ * Every output pixel of a z-stack is independent, so the bands need no merging; each band
+ * allocates its own scratch and writes only its own rows.  The first exception thrown by any
+ * band is rethrown here.
+ */
+template <typename WorkT>
+void runOverRowBands(int const height, int const numThreads, WorkT work) {
+    TaskPool::TaskGroup group;
+    for (int band = 0; band < numThreads; ++band) {
+        int const beginRow = band * height / numThreads;
+        int const endRow = (band + 1) * height / numThreads;
+        group.run([work, beginRow, endRow] { work(beginRow, endRow); });
+    }
+    group.wait();
+}
+
 template <typename ImageT>
 void checkImageSizes(ImageT const &out, std::vector<std::shared_ptr<ImageT>> const &images) {
     lsst::geom::Extent2I const &dim = out.getDimensions();
@@ -110,19 +133,19 @@ void checkImageSizes(ImageT const &out, std::vector<std::shared_ptr<ImageT>> con
 
 //@{
 /**
- * @internal A function to handle MaskedImage stacking
+ * @internal Stack a band of rows of a set of MaskedImages into the matching rows of the output
  *
- * A boolean template variable has been used to allow the compiler to generate the different instantiations
- *   to handle cases when we are, or are not, weighting
- *
- * Additionally, we may or may not want to weight based on the variance -- another template boolean
+ * All the scratch needed to gather and measure a pixel stack is allocated here, so concurrent
+ * calls over disjoint row bands share nothing but the (read-only) inputs and their own slice
+ * of the output.
  */
 template <typename PixelT, bool isWeighted, bool useVariance>
-void computeMaskedImageStack(image::MaskedImage<PixelT> &imgStack,
-                             std::vector<std::shared_ptr<image::MaskedImage<PixelT>>> const &images,
-                             Property flags, StatisticsControl const &sctrl, image::MaskPixel const clipped,
-                             std::vector<std::pair<image::MaskPixel, image::MaskPixel>> const &maskMap,
-                             WeightVector const &wvector = WeightVector()) {
+void computeMaskedImageStackRows(image::MaskedImage<PixelT> &imgStack,
+                                 std::vector<std::shared_ptr<image::MaskedImage<PixelT>>> const &images,
+                                 Property flags, StatisticsControl const &sctrlTmp,
+                                 image::MaskPixel const clipped,
+                                 std::vector<std::pair<image::MaskPixel, image::MaskPixel>> const &maskMap,
+                                 WeightVector const &wvector, int const yBegin, int const yEnd) {
     // get a list of row_begin iterators
     typedef typename image::MaskedImage<PixelT>::x_iterator x_iterator;
     std::vector<x_iterator> rows;
@@ -130,29 +153,20 @@ void computeMaskedImageStack(image::MaskedImage<PixelT> &imgStack,
 
     MaskedVector<PixelT> pixelSet(images.size());  // a pixel from x,y for each image
     WeightVector weights;                          // weights; non-const version
-    //
-    StatisticsControl sctrlTmp(sctrl);
 
     if (useVariance) {  // weight using the variance image
-        assert(isWeighted);
-        assert(wvector.empty());
-
         weights.resize(images.size());
-
-        sctrlTmp.setWeighted(true);
     } else if (isWeighted) {
         weights.assign(wvector.begin(), wvector.end());
-
-        sctrlTmp.setWeighted(true);
     }
     assert(weights.empty() || weights.size() == images.size());
 
     // loop over x,y ... the loop over the stack to fill pixelSet
     // - get the stats on pixelSet and put the value in the output image at x,y
-    for (int y = 0; y != imgStack.getHeight(); ++y) {
+    for (int y = yBegin; y != yEnd; ++y) {
         for (unsigned int i = 0; i < images.size(); ++i) {
             x_iterator ptr = images[i]->row_begin(y);
-            if (y == 0) {
+            if (y == yBegin) {
                 rows.push_back(ptr);
             } else {
                 rows[i] = ptr;
@@ -205,6 +219,52 @@ void computeMaskedImageStack(image::MaskedImage<PixelT> &imgStack,
         }
     }
 }
+
+/**
+ * @internal A function to handle MaskedImage stacking
+ *
+ * A boolean template variable has been used to allow the compiler to generate the different instantiations
+ *   to handle cases when we are, or are not, weighting
+ *
+ * Additionally, we may or may not want to weight based on the variance -- another template boolean
+ *
+ * When the control structure requests more than one thread the output rows are sharded into
+ * horizontal bands, one thread per band, each with its own gather scratch; the per-pixel
+ * statistics are unchanged, so the result is identical to the serial one.
+ */
+template <typename PixelT, bool isWeighted, bool useVariance>
+void computeMaskedImageStack(image::MaskedImage<PixelT> &imgStack,
+                             std::vector<std::shared_ptr<image::MaskedImage<PixelT>>> const &images,
+                             Property flags, StatisticsControl const &sctrl, image::MaskPixel const clipped,
+                             std::vector<std::pair<image::MaskPixel, image::MaskPixel>> const &maskMap,
+                             WeightVector const &wvector = WeightVector()) {
+    StatisticsControl sctrlTmp(sctrl);
+
+    if (useVariance) {  // weight using the variance image
+        assert(isWeighted);
+        assert(wvector.empty());
+        sctrlTmp.setWeighted(true);
+    } else if (isWeighted) {
+        sctrlTmp.setWeighted(true);
+    }
+
+    int const numThreads = sctrl.getNumThreads();
+    if (numThreads > 1 && imgStack.getHeight() >= 2 * numThreads) {
+        // the parallelism lives out here; the per-pixel stacks are tiny, so don't let
+        // makeStatistics try to split them again
+        sctrlTmp.setNumThreads(1);
+        runOverRowBands(imgStack.getHeight(), numThreads,
+                        [&imgStack, &images, flags, &sctrlTmp, clipped, &maskMap,
+                         &wvector](int beginRow, int endRow) {
+                            computeMaskedImageStackRows<PixelT, isWeighted, useVariance>(
+                                    imgStack, images, flags, sctrlTmp, clipped, maskMap, wvector, beginRow,
+                                    endRow);
+                        });
+    } else {
+        computeMaskedImageStackRows<PixelT, isWeighted, useVariance>(
+                imgStack, images, flags, sctrlTmp, clipped, maskMap, wvector, 0, imgStack.getHeight());
+    }
+}
 template <typename PixelT, bool isWeighted, bool useVariance>
 void computeMaskedImageStack(image::MaskedImage<PixelT> &imgStack,
                              std::vector<std::shared_ptr<image::MaskedImage<PixelT>>> const &images,
@@ -252,6 +312,7 @@ void statisticsStack(image::MaskedImage<PixelT> &out,
                      std::vector<std::shared_ptr<image::MaskedImage<PixelT>>> &images, Property flags,
                      StatisticsControl const &sctrl, WeightVector const &wvector, image::MaskPixel clipped,
                      image::MaskPixel excuse) {
+    instrumentation::Timer timer(instrumentation::Metric::STACK_CALLS, instrumentation::Metric::STACK_NANOS);
     checkObjectsAndWeights(images, wvector);
     checkOnlyOneFlag(flags);
     checkImageSizes(out, images);
@@ -274,11 +335,51 @@ void statisticsStack(image::MaskedImage<PixelT> &out,
     }
 }
 
+template <typename PixelT>
+void statisticsStack(image::MaskedImage<PixelT> &out, StackStripReader<PixelT> const &reader, int numImages,
+                     Property flags, StatisticsControl const &sctrl, WeightVector const &wvector,
+                     image::MaskPixel clipped, image::MaskPixel excuse, int stripHeight) {
+    if (numImages <= 0) {
+        throw LSST_EXCEPT(pexExcept::LengthError, "Please specify at least one image to stack");
+    }
+    if (stripHeight <= 0) {
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError,
+                          str(boost::format("stripHeight must be positive: %d") % stripHeight));
+    }
+    if (!wvector.empty() && wvector.size() != static_cast<std::size_t>(numImages)) {
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError,
+                          str(boost::format("Weight vector has different length "
+                                            "from number of objects to be stacked: %d v. %d") %
+                              wvector.size() % numImages));
+    }
+    checkOnlyOneFlag(flags);
+
+    std::vector<std::shared_ptr<image::MaskedImage<PixelT>>> strips(numImages);
+    for (int y = 0; y < out.getHeight(); y += stripHeight) {
+        int const rows = std::min(stripHeight, out.getHeight() - y);
+        lsst::geom::Box2I const stripBox(lsst::geom::Point2I(out.getX0(), out.getY0() + y),
+                                         lsst::geom::Extent2I(out.getWidth(), rows));
+        for (int i = 0; i < numImages; ++i) {
+            strips[i] = reader(i, stripBox);
+            if (!strips[i] || strips[i]->getDimensions() != stripBox.getDimensions()) {
+                throw LSST_EXCEPT(pexExcept::InvalidParameterError,
+                                  str(boost::format("Reader returned a bad strip for image %d: "
+                                                    "expected %dx%d") %
+                                      i % stripBox.getWidth() % stripBox.getHeight()));
+            }
+        }
+        // a shallow view: the strip results land directly in the output
+        image::MaskedImage<PixelT> outStrip(out, stripBox, image::PARENT, false);
+        statisticsStack(outStrip, strips, flags, sctrl, wvector, clipped, excuse);
+    }
+}
+
 template <typename PixelT>
 void statisticsStack(image::MaskedImage<PixelT> &out,
                      std::vector<std::shared_ptr<image::MaskedImage<PixelT>>> &images, Property flags,
                      StatisticsControl const &sctrl, WeightVector const &wvector, image::MaskPixel clipped,
                      std::vector<std::pair<image::MaskPixel, image::MaskPixel>> const &maskMap) {
+    instrumentation::Timer timer(instrumentation::Metric::STACK_CALLS, instrumentation::Metric::STACK_NANOS);
     checkObjectsAndWeights(images, wvector);
     checkOnlyOneFlag(flags);
     checkImageSizes(out, images);
@@ -312,22 +413,98 @@ namespace {
  * A boolean template variable has been used to allow the compiler to generate the different instantiations
  *   to handle cases when we are, or are not, weighting
  */
+// Compile the transposed-scratch reduction below for several x86-64 SIMD levels, selecting the
+// best at load time.  target_clones needs gcc and ELF; elsewhere we fall back to a single version.
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+#define LSST_AFW_STACK_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define LSST_AFW_STACK_TARGET_CLONES
+#endif
+
+/**
+ * @internal Reduce one transposed row of epoch vectors to weighted means
+ *
+ * `values` and `valueWeights` hold the epoch vectors back to back: element `x*nImages + i` is
+ * pixel `x` of input `i`.  Rejected samples carry weight zero (and value zero, so they cannot
+ * poison the sums).  Each pixel's vector is contiguous, so the reduction is a linear dot
+ * product the compiler can vectorize; a pixel with no accepted samples comes out NaN (0/0),
+ * as it does from makeStatistics.
+ */
+LSST_AFW_STACK_TARGET_CLONES
+void reduceTransposedWeightedMean(double const *values, double const *valueWeights, int const width,
+                                  int const nImages, double *rowOut) {
+    for (int x = 0; x != width; ++x) {
+        double const *vec = values + static_cast<std::size_t>(x) * nImages;
+        double const *wvec = valueWeights + static_cast<std::size_t>(x) * nImages;
+        double sumwx = 0.0;
+        double sumw = 0.0;
+        for (int i = 0; i != nImages; ++i) {
+            sumwx += wvec[i] * vec[i];
+            sumw += wvec[i];
+        }
+        rowOut[x] = sumwx / sumw;
+    }
+}
+
+/**
+ * @internal Stack a band of rows of plain Images to their (weighted) mean via a transposed scratch
+ *
+ * The generic gather loop strides across all the input buffers once per output pixel.  Here each
+ * input row is instead read sequentially and scattered into a contiguous (pixel, epoch) scratch
+ * block, and every pixel's epoch vector is then reduced linearly, which is far friendlier to the
+ * cache and to SIMD when many epochs are stacked.  Non-finite samples are dropped when the
+ * control structure is NaN-safe, matching the generic path; results can differ from it at the
+ * rounding level because makeStatistics sums about a crude mean.
+ */
+template <typename PixelT>
+void computeImageStackRowsTransposed(image::Image<PixelT> &imgStack,
+                                     std::vector<std::shared_ptr<image::Image<PixelT>>> const &images,
+                                     StatisticsControl const &sctrlTmp, WeightVector const &weights,
+                                     int const yBegin, int const yEnd) {
+    int const width = imgStack.getWidth();
+    int const nImages = images.size();
+    bool const nanSafe = sctrlTmp.getNanSafe();
+    std::vector<double> values(static_cast<std::size_t>(width) * nImages);
+    std::vector<double> valueWeights(static_cast<std::size_t>(width) * nImages);
+    std::vector<double> rowOut(width);
+
+    for (int y = yBegin; y != yEnd; ++y) {
+        for (int i = 0; i != nImages; ++i) {
+            double const weight = weights.empty() ? 1.0 : static_cast<double>(weights[i]);
+            typename image::Image<PixelT>::const_x_iterator ptr = images[i]->row_begin(y);
+            for (int x = 0; x != width; ++x, ++ptr) {
+                double value = *ptr;
+                double wt = weight;
+                if (nanSafe && !std::isfinite(value)) {
+                    value = 0.0;
+                    wt = 0.0;
+                }
+                values[static_cast<std::size_t>(x) * nImages + i] = value;
+                valueWeights[static_cast<std::size_t>(x) * nImages + i] = wt;
+            }
+        }
+
+        reduceTransposedWeightedMean(values.data(), valueWeights.data(), width, nImages, rowOut.data());
+
+        typename image::Image<PixelT>::x_iterator optr = imgStack.row_begin(y);
+        for (int x = 0; x != width; ++x, ++optr) {
+            *optr = static_cast<PixelT>(rowOut[x]);
+        }
+    }
+}
+
 template <typename PixelT, bool isWeighted>
-void computeImageStack(image::Image<PixelT> &imgStack,
-                       std::vector<std::shared_ptr<image::Image<PixelT>>> &images, Property flags,
-                       StatisticsControl const &sctrl, WeightVector const &weights = WeightVector()) {
+void computeImageStackRows(image::Image<PixelT> &imgStack,
+                           std::vector<std::shared_ptr<image::Image<PixelT>>> const &images, Property flags,
+                           StatisticsControl const &sctrlTmp, WeightVector const &weights, int const yBegin,
+                           int const yEnd) {
     MaskedVector<PixelT> pixelSet(images.size());  // a pixel from x,y for each image
-    StatisticsControl sctrlTmp(sctrl);
 
     // set the mask to be an infinite iterator
     MaskImposter<image::MaskPixel> msk;
 
-    if (!weights.empty()) {
-        sctrlTmp.setWeighted(true);
-    }
-
     // get the desired statistic
-    for (int y = 0; y != imgStack.getHeight(); ++y) {
+    for (int y = yBegin; y != yEnd; ++y) {
         for (int x = 0; x != imgStack.getWidth(); ++x) {
             for (unsigned int i = 0; i != images.size(); ++i) {
                 (*pixelSet.getImage())(i, 0) = (*images[i])(x, y);
@@ -342,6 +519,43 @@ void computeImageStack(image::Image<PixelT> &imgStack,
     }
 }
 
+template <typename PixelT, bool isWeighted>
+void computeImageStack(image::Image<PixelT> &imgStack,
+                       std::vector<std::shared_ptr<image::Image<PixelT>>> &images, Property flags,
+                       StatisticsControl const &sctrl, WeightVector const &weights = WeightVector()) {
+    StatisticsControl sctrlTmp(sctrl);
+
+    if (!weights.empty()) {
+        sctrlTmp.setWeighted(true);
+    }
+
+    // a plain (weighted) MEAN needs no per-pixel Statistics object, so it can use the
+    // cache-friendly transposed reduction instead of the generic gather loop
+    bool const useTransposed = (flags == MEAN);
+
+    int const numThreads = sctrl.getNumThreads();
+    if (numThreads > 1 && imgStack.getHeight() >= 2 * numThreads) {
+        sctrlTmp.setNumThreads(1);  // the bands carry the parallelism, not the per-pixel stacks
+        runOverRowBands(imgStack.getHeight(), numThreads,
+                        [&imgStack, &images, flags, &sctrlTmp, &weights,
+                         useTransposed](int beginRow, int endRow) {
+                            if (useTransposed) {
+                                computeImageStackRowsTransposed<PixelT>(imgStack, images, sctrlTmp, weights,
+                                                                        beginRow, endRow);
+                            } else {
+                                computeImageStackRows<PixelT, isWeighted>(imgStack, images, flags, sctrlTmp,
+                                                                          weights, beginRow, endRow);
+                            }
+                        });
+    } else if (useTransposed) {
+        computeImageStackRowsTransposed<PixelT>(imgStack, images, sctrlTmp, weights, 0,
+                                                imgStack.getHeight());
+    } else {
+        computeImageStackRows<PixelT, isWeighted>(imgStack, images, flags, sctrlTmp, weights, 0,
+                                                  imgStack.getHeight());
+    }
+}
+
 }  // end anonymous namespace
 
 template <typename PixelT>
@@ -359,6 +573,7 @@ std::shared_ptr<image::Image<PixelT>> statisticsStack(
 template <typename PixelT>
 void statisticsStack(image::Image<PixelT> &out, std::vector<std::shared_ptr<image::Image<PixelT>>> &images,
                      Property flags, StatisticsControl const &sctrl, WeightVector const &wvector) {
+    instrumentation::Timer timer(instrumentation::Metric::STACK_CALLS, instrumentation::Metric::STACK_NANOS);
     checkObjectsAndWeights(images, wvector);
     checkOnlyOneFlag(flags);
     checkImageSizes(out, images);
@@ -556,6 +771,11 @@ std::shared_ptr<image::MaskedImage<PixelT>> statisticsStack(image::MaskedImage<P
             image::MaskedImage<TYPE> & out, std::vector<std::shared_ptr<image::MaskedImage<TYPE>>> & images, \
             Property flags, StatisticsControl const &sctrl, WeightVector const &wvector, image::MaskPixel,   \
             std::vector<std::pair<image::MaskPixel, image::MaskPixel>> const &);                             \
+    template void statisticsStack<TYPE>(image::MaskedImage<TYPE> & out,                                      \
+                                        StackStripReader<TYPE> const &reader, int numImages,                 \
+                                        Property flags, StatisticsControl const &sctrl,                      \
+                                        WeightVector const &wvector, image::MaskPixel, image::MaskPixel,     \
+                                        int stripHeight);                                                    \
     template std::vector<TYPE> statisticsStack<TYPE>(                                       \
             std::vector<std::vector<TYPE>> & vectors, Property flags,                       \
             StatisticsControl const &sctrl, WeightVector const &wvector);                                    \
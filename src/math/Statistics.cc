@@ -28,6 +28,7 @@
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <exception>
 #include <iostream>
 #include <limits>
 #include <memory>
@@ -35,8 +36,11 @@
 #include <type_traits>
 
 #include "lsst/pex/exceptions.h"
+#include "lsst/afw/geom/SpanSet.h"
 #include "lsst/afw/image/Image.h"
+#include "lsst/afw/instrumentation.h"
 #include "lsst/afw/math/Statistics.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/geom/Angle.h"
 
 using namespace std;
@@ -148,6 +152,98 @@ typedef std::tuple<int,                // n
                    >
         StandardReturn;
 
+/// @internal Partial sums over a band of rows; bands merge in band order to give the full image
+struct PixelSums {
+    int n = 0;
+    double sumw = 0.0;    // sum(weight)  (N.b. weight will be 1.0 if !useWeights)
+    double sumw2 = 0.0;   // sum(weight^2)
+    double sumx = 0.0;    // sum(data*weight)
+    double sumx2 = 0.0;   // sum(data*weight^2)
+    double sumvw2 = 0.0;  // sum(variance*weight^2)
+    double min = MAX_DOUBLE;
+    double max = -MAX_DOUBLE;
+    image::MaskPixel allPixelOrMask = 0x0;
+    std::vector<double> rejectedWeightsByBit;
+
+    void merge(PixelSums const &other) {
+        n += other.n;
+        sumw += other.sumw;
+        sumw2 += other.sumw2;
+        sumx += other.sumx;
+        sumx2 += other.sumx2;
+        sumvw2 += other.sumvw2;
+        min = (other.min < min) ? other.min : min;
+        max = (other.max > max) ? other.max : max;
+        allPixelOrMask |= other.allPixelOrMask;
+        for (std::size_t bit = 0; bit != rejectedWeightsByBit.size(); ++bit) {
+            rejectedWeightsByBit[bit] += other.rejectedWeightsByBit[bit];
+        }
+    }
+};
+
+/**
+ * @internal Run `work(beginRow, endRow, band)` over horizontal bands of rows on the shared pool
+ *
+ * The caller is responsible for giving each band its own output storage and for merging the
+ * per-band results afterwards; the first exception thrown by any band is rethrown here.
+ */
+template <typename WorkT>
+void runOverRowBands(int const height, int const numThreads, WorkT work) {
+    TaskPool::TaskGroup group;
+    for (int band = 0; band < numThreads; ++band) {
+        int const beginRow = band * height / numThreads;
+        int const endRow = (band + 1) * height / numThreads;
+        group.run([work, beginRow, endRow, band] { work(beginRow, endRow, band); });
+    }
+    group.wait();
+}
+
+/**
+ * @internal Present the pixels of an %image that lie in a SpanSet as an image whose rows
+ *           are the spans
+ *
+ * Row `i` of the view is the i'th span -- one contiguous run of pixels -- so the row-based
+ * accumulators (including the vectorized float kernels) iterate a footprint in place,
+ * without flattening it into a temporary array.  The %image and SpanSet must outlive the
+ * view, and every span must lie inside the %image.
+ */
+template <typename ImT>
+class SpanView final {
+public:
+    typedef typename ImT::Pixel Pixel;
+    typedef typename ImT::x_iterator x_iterator;
+
+    SpanView(ImT const &img, geom::SpanSet const &spans) : _img(img), _spans(spans) {}
+
+    int getHeight() const { return static_cast<int>(_spans.size()); }
+    /// The width of the i'th span (unlike an image's, the view's rows vary in width)
+    int getSpanWidth(int i) const { return (_spans.begin() + i)->getWidth(); }
+    /// The total number of pixels under the spans
+    double getArea() const { return static_cast<double>(_spans.getArea()); }
+
+    x_iterator row_begin(int i) const {
+        geom::Span const &span = *(_spans.begin() + i);
+        return _img.x_at(span.getX0() - _img.getX0(), span.getY() - _img.getY0());
+    }
+    x_iterator row_end(int i) const { return row_begin(i) + getSpanWidth(i); }
+
+private:
+    ImT const &_img;
+    geom::SpanSet const &_spans;
+};
+
+/// @internal The number of pixels an image-like object presents to the accumulators
+template <typename ImageT>
+double pixelCount(ImageT const &img) {
+    return img.getWidth() * static_cast<double>(img.getHeight());
+}
+
+/// @internal A SpanView's rows vary in width, so count the pixels under the spans
+template <typename ImT>
+double pixelCount(SpanView<ImT> const &img) {
+    return img.getArea();
+}
+
 /*
  * Functions which convert the booleans into calls to the proper templated types, one type per
  * recursion level
@@ -160,15 +256,17 @@ typedef std::tuple<int,                // n
  * user requests a test (eg check for NaNs), the function is instantiated with the appropriate functor.
  * Otherwise, an 'AlwaysTrue' or 'AlwaysFalse' object is passed in.  The compiler then compiles-out
  * a test which is always false, or removes the conditional for a test which is always true.
+ *
+ * The sums over [beginRow, endRow) are added to `sums`, so disjoint bands of rows can be
+ * accumulated independently (e.g. on separate threads) and merged.
  */
 template <typename IsFinite, typename HasValueLtMin, typename HasValueGtMax, typename InClipRange,
           bool useWeights, typename ImageT, typename MaskT, typename VarianceT, typename WeightT>
-StandardReturn processPixels(ImageT const &img, MaskT const &msk, VarianceT const &var,
-                             WeightT const &weights, int const, int const nCrude, int const stride,
-                             double const meanCrude, double const cliplimit,
-                             bool const weightsAreMultiplicative, int const andMask,
-                             bool const calcErrorFromInputVariance,
-                             std::vector<double> const &maskPropagationThresholds) {
+void accumulatePixels(ImageT const &img, MaskT const &msk, VarianceT const &var, WeightT const &weights,
+                      int const beginRow, int const endRow, int const stride, double const meanCrude,
+                      double const cliplimit, bool const weightsAreMultiplicative, int const andMask,
+                      bool const calcErrorFromInputVariance,
+                      std::vector<double> const &maskPropagationThresholds, PixelSums &sums) {
     int n = 0;
     double sumw = 0.0;   // sum(weight)  (N.b. weight will be 1.0 if !useWeights)
     double sumw2 = 0.0;  // sum(weight^2)
@@ -177,19 +275,19 @@ StandardReturn processPixels(ImageT const &img, MaskT const &msk, VarianceT cons
 #if 1
     double sumvw2 = 0.0;  // sum(variance*weight^2)
 #endif
-    double min = (nCrude) ? meanCrude : MAX_DOUBLE;
-    double max = (nCrude) ? meanCrude : -MAX_DOUBLE;
+    double min = sums.min;
+    double max = sums.max;
 
     image::MaskPixel allPixelOrMask = 0x0;
 
     std::vector<double> rejectedWeightsByBit(maskPropagationThresholds.size(), 0.0);
 
-    for (int iY = 0; iY < img.getHeight(); iY += stride) {
+    for (int iY = beginRow; iY < endRow; iY += stride) {
         typename MaskT::x_iterator mptr = msk.row_begin(iY);
         typename VarianceT::x_iterator vptr = var.row_begin(iY);
         typename WeightT::x_iterator wptr = weights.row_begin(iY);
 
-        for (typename ImageT::x_iterator ptr = img.row_begin(iY), end = ptr + img.getWidth(); ptr != end;
+        for (typename ImageT::x_iterator ptr = img.row_begin(iY), end = img.row_end(iY); ptr != end;
              ++ptr, ++mptr, ++vptr, ++wptr) {
             if (IsFinite()(*ptr) && !(*mptr & andMask) &&
                 InClipRange()(*ptr, meanCrude, cliplimit)) {  // clip
@@ -255,6 +353,71 @@ StandardReturn processPixels(ImageT const &img, MaskT const &msk, VarianceT cons
             }
         }
     }
+    sums.n += n;
+    sums.sumw += sumw;
+    sums.sumw2 += sumw2;
+    sums.sumx += sumx;
+    sums.sumx2 += sumx2;
+    sums.sumvw2 += sumvw2;
+    sums.min = min;
+    sums.max = max;
+    sums.allPixelOrMask |= allPixelOrMask;
+    for (std::size_t bit = 0; bit != rejectedWeightsByBit.size(); ++bit) {
+        sums.rejectedWeightsByBit[bit] += rejectedWeightsByBit[bit];
+    }
+}
+
+/**
+ * @internal Accumulate over the whole image (serially, or in parallel over bands of rows)
+ * and turn the sums into the statistics that processPixels reports
+ */
+template <typename IsFinite, typename HasValueLtMin, typename HasValueGtMax, typename InClipRange,
+          bool useWeights, typename ImageT, typename MaskT, typename VarianceT, typename WeightT>
+StandardReturn processPixels(ImageT const &img, MaskT const &msk, VarianceT const &var,
+                             WeightT const &weights, int const, int const nCrude, int const stride,
+                             double const meanCrude, double const cliplimit,
+                             bool const weightsAreMultiplicative, int const andMask,
+                             bool const calcErrorFromInputVariance,
+                             std::vector<double> const &maskPropagationThresholds, int const numThreads) {
+    PixelSums sums;
+    sums.min = (nCrude) ? meanCrude : MAX_DOUBLE;
+    sums.max = (nCrude) ? meanCrude : -MAX_DOUBLE;
+    sums.rejectedWeightsByBit.assign(maskPropagationThresholds.size(), 0.0);
+
+    if (numThreads > 1 && stride == 1 && img.getHeight() >= 2 * numThreads) {
+        // each band accumulates privately; merging in band order keeps the result
+        // deterministic for a given number of threads
+        std::vector<PixelSums> bandSums(numThreads, sums);
+        runOverRowBands(img.getHeight(), numThreads,
+                        [&img, &msk, &var, &weights, &bandSums, meanCrude, cliplimit,
+                         weightsAreMultiplicative, andMask, calcErrorFromInputVariance,
+                         &maskPropagationThresholds](int beginRow, int endRow, int band) {
+                            accumulatePixels<IsFinite, HasValueLtMin, HasValueGtMax, InClipRange, useWeights>(
+                                    img, msk, var, weights, beginRow, endRow, 1, meanCrude, cliplimit,
+                                    weightsAreMultiplicative, andMask, calcErrorFromInputVariance,
+                                    maskPropagationThresholds, bandSums[band]);
+                        });
+        for (auto const &bandSum : bandSums) {
+            sums.merge(bandSum);
+        }
+    } else {
+        accumulatePixels<IsFinite, HasValueLtMin, HasValueGtMax, InClipRange, useWeights>(
+                img, msk, var, weights, 0, img.getHeight(), stride, meanCrude, cliplimit,
+                weightsAreMultiplicative, andMask, calcErrorFromInputVariance, maskPropagationThresholds,
+                sums);
+    }
+
+    int const n = sums.n;
+    double sumw = sums.sumw;
+    double sumw2 = sums.sumw2;
+    double sumx = sums.sumx;
+    double const sumx2 = sums.sumx2;
+    double const sumvw2 = sums.sumvw2;
+    double min = sums.min;
+    double max = sums.max;
+    image::MaskPixel allPixelOrMask = sums.allPixelOrMask;
+    std::vector<double> rejectedWeightsByBit = sums.rejectedWeightsByBit;
+
     if (n == 0) {
         min = NaN;
         max = NaN;
@@ -304,15 +467,15 @@ StandardReturn processPixels(ImageT const &img, MaskT const &msk, VarianceT cons
                              double const meanCrude, double const cliplimit,
                              bool const weightsAreMultiplicative, int const andMask,
                              bool const calcErrorFromInputVariance, bool doGetWeighted,
-                             std::vector<double> const &maskPropagationThresholds) {
+                             std::vector<double> const &maskPropagationThresholds, int const numThreads) {
     if (doGetWeighted) {
         return processPixels<IsFinite, HasValueLtMin, HasValueGtMax, InClipRange, true>(
                 img, msk, var, weights, flags, nCrude, 1, meanCrude, cliplimit, weightsAreMultiplicative,
-                andMask, calcErrorFromInputVariance, maskPropagationThresholds);
+                andMask, calcErrorFromInputVariance, maskPropagationThresholds, numThreads);
     } else {
         return processPixels<IsFinite, HasValueLtMin, HasValueGtMax, InClipRange, false>(
                 img, msk, var, weights, flags, nCrude, 1, meanCrude, cliplimit, weightsAreMultiplicative,
-                andMask, calcErrorFromInputVariance, maskPropagationThresholds);
+                andMask, calcErrorFromInputVariance, maskPropagationThresholds, numThreads);
     }
 }
 
@@ -323,16 +486,393 @@ StandardReturn processPixels(ImageT const &img, MaskT const &msk, VarianceT cons
                              double const meanCrude, double const cliplimit,
                              bool const weightsAreMultiplicative, int const andMask,
                              bool const calcErrorFromInputVariance, bool doCheckFinite, bool doGetWeighted,
-                             std::vector<double> const &maskPropagationThresholds) {
+                             std::vector<double> const &maskPropagationThresholds, int const numThreads) {
     if (doCheckFinite) {
         return processPixels<CheckFinite, HasValueLtMin, HasValueGtMax, InClipRange, useWeights>(
                 img, msk, var, weights, flags, nCrude, 1, meanCrude, cliplimit, weightsAreMultiplicative,
-                andMask, calcErrorFromInputVariance, doGetWeighted, maskPropagationThresholds);
+                andMask, calcErrorFromInputVariance, doGetWeighted, maskPropagationThresholds, numThreads);
     } else {
         return processPixels<AlwaysTrue, HasValueLtMin, HasValueGtMax, InClipRange, useWeights>(
                 img, msk, var, weights, flags, nCrude, 1, meanCrude, cliplimit, weightsAreMultiplicative,
-                andMask, calcErrorFromInputVariance, doGetWeighted, maskPropagationThresholds);
+                andMask, calcErrorFromInputVariance, doGetWeighted, maskPropagationThresholds, numThreads);
+    }
+}
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+// Compile the single-pass accumulation kernels as runtime-dispatched function clones so that
+// AVX2/AVX-512 code is used where the CPU supports it, without requiring -march at build time.
+#define LSST_AFW_STATISTICS_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define LSST_AFW_STATISTICS_TARGET_CLONES
+#endif
+
+/**
+ * @internal Branch-free accumulation over one contiguous row of float pixels
+ *
+ * Computes the same sums as the unweighted arm of processPixels (n, sum of deltas, sum of
+ * squared deltas, min, max and the or-mask), but with every per-pixel test folded into
+ * arithmetic selects so the compiler can vectorize the loop.  The finite and clip tests are
+ * controlled by loop-invariant booleans, which the optimizer hoists; when `checkFinite` is
+ * false a NaN pixel poisons the sums, exactly as in the generic path.
+ */
+LSST_AFW_STATISTICS_TARGET_CLONES
+inline void accumulateFloatRow(float const *imageRow, image::MaskPixel const *maskRow, int const width,
+                               double const center, int const andMask, bool const checkFinite,
+                               bool const doClip, double const cliplimit, int &n, double &sumx,
+                               double &sumx2, double &min, double &max, image::MaskPixel &orMask) {
+    int rowN = 0;
+    double rowSumx = 0.0;
+    double rowSumx2 = 0.0;
+    double rowMin = min;
+    double rowMax = max;
+    image::MaskPixel rowOrMask = 0x0;
+    for (int x = 0; x < width; ++x) {
+        double const value = imageRow[x];
+        double const delta = value - center;
+        bool use = (maskRow[x] & andMask) == 0;
+        use = use & (!checkFinite || std::isfinite(imageRow[x]));
+        use = use & (!doClip || std::fabs(delta) <= cliplimit);
+        double const contrib = use ? delta : 0.0;
+        rowSumx += contrib;
+        rowSumx2 += contrib * contrib;
+        rowN += use ? 1 : 0;
+        rowOrMask |= use ? maskRow[x] : image::MaskPixel(0x0);
+        rowMin = (use && value < rowMin) ? value : rowMin;
+        rowMax = (use && value > rowMax) ? value : rowMax;
+    }
+    n += rowN;
+    sumx += rowSumx;
+    sumx2 += rowSumx2;
+    min = rowMin;
+    max = rowMax;
+    orMask |= rowOrMask;
+}
+
+/// @internal As above, for images with no mask plane (the mask tests are compiled out)
+LSST_AFW_STATISTICS_TARGET_CLONES
+inline void accumulateFloatRow(float const *imageRow, int const width, double const center,
+                               bool const checkFinite, bool const doClip, double const cliplimit, int &n,
+                               double &sumx, double &sumx2, double &min, double &max) {
+    int rowN = 0;
+    double rowSumx = 0.0;
+    double rowSumx2 = 0.0;
+    double rowMin = min;
+    double rowMax = max;
+    for (int x = 0; x < width; ++x) {
+        double const value = imageRow[x];
+        double const delta = value - center;
+        bool use = !checkFinite || std::isfinite(imageRow[x]);
+        use = use & (!doClip || std::fabs(delta) <= cliplimit);
+        double const contrib = use ? delta : 0.0;
+        rowSumx += contrib;
+        rowSumx2 += contrib * contrib;
+        rowN += use ? 1 : 0;
+        rowMin = (use && value < rowMin) ? value : rowMin;
+        rowMax = (use && value > rowMax) ? value : rowMax;
+    }
+    n += rowN;
+    sumx += rowSumx;
+    sumx2 += rowSumx2;
+    min = rowMin;
+    max = rowMax;
+}
+
+/**
+ * @internal Assemble a StandardReturn from the sums accumulated by accumulateFloatRow
+ *
+ * This reproduces, exactly, the post-loop arithmetic of processPixels for the unweighted
+ * case with no mask-propagation thresholds and no input-variance error estimate.
+ */
+StandardReturn finishFastSums(int const n, double sumx, double const sumx2, double min, double max,
+                              image::MaskPixel const allPixelOrMask, double const meanCrude) {
+    if (n == 0) {
+        min = NaN;
+        max = NaN;
+    }
+
+    double const sumw = n;
+    double const sumw2 = n;
+
+    double mean = sumx / sumw;
+    double variance = sumx2 / sumw - ::pow(mean, 2);     // biased estimator
+    variance *= sumw * sumw / (sumw * sumw - sumw2);     // debias
+    double const meanVar = variance * sumw2 / (sumw * sumw);
+    double const varVar = varianceError(variance, n);
+
+    sumx += sumw * meanCrude;
+    mean += meanCrude;
+
+    return StandardReturn(n, sumx, Statistics::Value(mean, meanVar), Statistics::Value(variance, varVar), min,
+                          max, allPixelOrMask);
+}
+
+/**
+ * @internal Attempt the vectorized single-pass accumulation; the catch-all overload
+ *
+ * The generic form is not eligible (MaskedImage zip iterators, integer pixels, etc.) and
+ * always reports failure, sending getStandard down the processPixels path.  The concrete
+ * overloads below recognize contiguous float pixel buffers and accumulate mean, variance,
+ * min and max in one vectorized pass.
+ */
+template <typename ImageT, typename MaskT, typename VarianceT, typename WeightT>
+bool getStandardFast(ImageT const &, MaskT const &, VarianceT const &, WeightT const &, int const, int const,
+                     double const, bool const, double const, int const, bool const, bool const, bool const,
+                     std::vector<double> const &, int const, StandardReturn *) {
+    return false;
+}
+
+/// @internal Vectorized accumulation for a float image with a real mask (unweighted MaskedImage)
+template <typename VarianceT, typename WeightT>
+bool getStandardFast(image::Image<float> const &img, image::Mask<image::MaskPixel> const &msk,
+                     VarianceT const &, WeightT const &, int const flags, int const nCrude,
+                     double const meanCrude, bool const doClip, double const cliplimit, int const andMask,
+                     bool const calcErrorFromInputVariance, bool const doCheckFinite, bool const doGetWeighted,
+                     std::vector<double> const &maskPropagationThresholds, int const numThreads,
+                     StandardReturn *result) {
+    if (doGetWeighted || calcErrorFromInputVariance || !maskPropagationThresholds.empty()) {
+        return false;
+    }
+    // MIN/MAX force the finite test on, as in getStandard's dispatch to processPixels
+    bool const checkFinite = (flags & (MIN | MAX)) ? true : doCheckFinite;
+
+    int n = 0;
+    double sumx = 0.0;
+    double sumx2 = 0.0;
+    double min = (nCrude) ? meanCrude : MAX_DOUBLE;
+    double max = (nCrude) ? meanCrude : -MAX_DOUBLE;
+    image::MaskPixel orMask = 0x0;
+    if (numThreads > 1 && img.getHeight() >= 2 * numThreads) {
+        std::vector<PixelSums> bandSums(numThreads);
+        runOverRowBands(img.getHeight(), numThreads,
+                        [&img, &msk, &bandSums, meanCrude, andMask, checkFinite, doClip,
+                         cliplimit](int beginRow, int endRow, int band) {
+                            PixelSums &sums = bandSums[band];
+                            for (int iY = beginRow; iY < endRow; ++iY) {
+                                accumulateFloatRow(
+                                        reinterpret_cast<float const *>(&(*img.row_begin(iY))),
+                                        reinterpret_cast<image::MaskPixel const *>(&(*msk.row_begin(iY))),
+                                        img.getWidth(), meanCrude, andMask, checkFinite, doClip, cliplimit,
+                                        sums.n, sums.sumx, sums.sumx2, sums.min, sums.max,
+                                        sums.allPixelOrMask);
+                            }
+                        });
+        for (auto const &sums : bandSums) {
+            n += sums.n;
+            sumx += sums.sumx;
+            sumx2 += sums.sumx2;
+            min = (sums.min < min) ? sums.min : min;
+            max = (sums.max > max) ? sums.max : max;
+            orMask |= sums.allPixelOrMask;
+        }
+    } else {
+        for (int iY = 0; iY < img.getHeight(); ++iY) {
+            // Single-channel GIL pixels are layout-compatible with their channel type.
+            accumulateFloatRow(reinterpret_cast<float const *>(&(*img.row_begin(iY))),
+                               reinterpret_cast<image::MaskPixel const *>(&(*msk.row_begin(iY))),
+                               img.getWidth(), meanCrude, andMask, checkFinite, doClip, cliplimit, n, sumx,
+                               sumx2, min, max, orMask);
+        }
+    }
+    if (!(flags & (MIN | MAX))) {
+        // the generic path does not track min/max unless they were requested
+        min = (nCrude) ? meanCrude : MAX_DOUBLE;
+        max = (nCrude) ? meanCrude : -MAX_DOUBLE;
+    }
+    *result = finishFastSums(n, sumx, sumx2, min, max, orMask, meanCrude);
+    return true;
+}
+
+/// @internal Shared implementation for float images whose mask is a constant imposter value
+template <typename ImageT>
+bool getStandardFastUnmasked(ImageT const &img, image::MaskPixel const maskVal, int const flags,
+                             int const nCrude, double const meanCrude, bool const doClip,
+                             double const cliplimit, int const andMask,
+                             bool const calcErrorFromInputVariance, bool const doCheckFinite,
+                             bool const doGetWeighted, std::vector<double> const &maskPropagationThresholds,
+                             int const numThreads, StandardReturn *result) {
+    if (doGetWeighted || calcErrorFromInputVariance || !maskPropagationThresholds.empty() ||
+        (maskVal & andMask) || img.getWidth() == 0 || img.getHeight() == 0) {
+        return false;
+    }
+    bool const checkFinite = (flags & (MIN | MAX)) ? true : doCheckFinite;
+
+    int n = 0;
+    double sumx = 0.0;
+    double sumx2 = 0.0;
+    double min = (nCrude) ? meanCrude : MAX_DOUBLE;
+    double max = (nCrude) ? meanCrude : -MAX_DOUBLE;
+    if (numThreads > 1 && img.getHeight() >= 2 * numThreads) {
+        std::vector<PixelSums> bandSums(numThreads);
+        runOverRowBands(img.getHeight(), numThreads,
+                        [&img, &bandSums, meanCrude, checkFinite, doClip, cliplimit](int beginRow,
+                                                                                    int endRow, int band) {
+                            PixelSums &sums = bandSums[band];
+                            for (int iY = beginRow; iY < endRow; ++iY) {
+                                accumulateFloatRow(reinterpret_cast<float const *>(&(*img.row_begin(iY))),
+                                                   img.getWidth(), meanCrude, checkFinite, doClip, cliplimit,
+                                                   sums.n, sums.sumx, sums.sumx2, sums.min, sums.max);
+                            }
+                        });
+        for (auto const &sums : bandSums) {
+            n += sums.n;
+            sumx += sums.sumx;
+            sumx2 += sums.sumx2;
+            min = (sums.min < min) ? sums.min : min;
+            max = (sums.max > max) ? sums.max : max;
+        }
+    } else {
+        for (int iY = 0; iY < img.getHeight(); ++iY) {
+            accumulateFloatRow(reinterpret_cast<float const *>(&(*img.row_begin(iY))), img.getWidth(),
+                               meanCrude, checkFinite, doClip, cliplimit, n, sumx, sumx2, min, max);
+        }
+    }
+    if (!(flags & (MIN | MAX))) {
+        min = (nCrude) ? meanCrude : MAX_DOUBLE;
+        max = (nCrude) ? meanCrude : -MAX_DOUBLE;
+    }
+    image::MaskPixel const orMask = (n > 0) ? maskVal : image::MaskPixel(0x0);
+    *result = finishFastSums(n, sumx, sumx2, min, max, orMask, meanCrude);
+    return true;
+}
+
+/// @internal Vectorized accumulation for a plain float image (phony mask)
+template <typename ValueT, typename VarianceT, typename WeightT>
+bool getStandardFast(image::Image<float> const &img, MaskImposter<ValueT> const &msk, VarianceT const &,
+                     WeightT const &, int const flags, int const nCrude, double const meanCrude,
+                     bool const doClip, double const cliplimit, int const andMask,
+                     bool const calcErrorFromInputVariance, bool const doCheckFinite, bool const doGetWeighted,
+                     std::vector<double> const &maskPropagationThresholds, int const numThreads,
+                     StandardReturn *result) {
+    return getStandardFastUnmasked(img, *msk.row_begin(0), flags, nCrude, meanCrude, doClip, cliplimit,
+                                   andMask, calcErrorFromInputVariance, doCheckFinite, doGetWeighted,
+                                   maskPropagationThresholds, numThreads, result);
+}
+
+/// @internal Vectorized accumulation for a std::vector<float> (phony mask)
+template <typename ValueT, typename VarianceT, typename WeightT>
+bool getStandardFast(ImageImposter<float> const &img, MaskImposter<ValueT> const &msk, VarianceT const &,
+                     WeightT const &, int const flags, int const nCrude, double const meanCrude,
+                     bool const doClip, double const cliplimit, int const andMask,
+                     bool const calcErrorFromInputVariance, bool const doCheckFinite, bool const doGetWeighted,
+                     std::vector<double> const &maskPropagationThresholds, int const numThreads,
+                     StandardReturn *result) {
+    return getStandardFastUnmasked(img, *msk.row_begin(0), flags, nCrude, meanCrude, doClip, cliplimit,
+                                   andMask, calcErrorFromInputVariance, doCheckFinite, doGetWeighted,
+                                   maskPropagationThresholds, numThreads, result);
+}
+
+/// @internal Vectorized accumulation over the spans of a float image with a real mask
+template <typename VarianceT, typename WeightT>
+bool getStandardFast(SpanView<image::Image<float>> const &img,
+                     SpanView<image::Mask<image::MaskPixel>> const &msk, VarianceT const &, WeightT const &,
+                     int const flags, int const nCrude, double const meanCrude, bool const doClip,
+                     double const cliplimit, int const andMask, bool const calcErrorFromInputVariance,
+                     bool const doCheckFinite, bool const doGetWeighted,
+                     std::vector<double> const &maskPropagationThresholds, int const numThreads,
+                     StandardReturn *result) {
+    if (doGetWeighted || calcErrorFromInputVariance || !maskPropagationThresholds.empty()) {
+        return false;
+    }
+    bool const checkFinite = (flags & (MIN | MAX)) ? true : doCheckFinite;
+
+    int n = 0;
+    double sumx = 0.0;
+    double sumx2 = 0.0;
+    double min = (nCrude) ? meanCrude : MAX_DOUBLE;
+    double max = (nCrude) ? meanCrude : -MAX_DOUBLE;
+    image::MaskPixel orMask = 0x0;
+    if (numThreads > 1 && img.getHeight() >= 2 * numThreads) {
+        std::vector<PixelSums> bandSums(numThreads);
+        runOverRowBands(img.getHeight(), numThreads,
+                        [&img, &msk, &bandSums, meanCrude, andMask, checkFinite, doClip,
+                         cliplimit](int beginRow, int endRow, int band) {
+                            PixelSums &sums = bandSums[band];
+                            for (int iY = beginRow; iY < endRow; ++iY) {
+                                accumulateFloatRow(
+                                        reinterpret_cast<float const *>(&(*img.row_begin(iY))),
+                                        reinterpret_cast<image::MaskPixel const *>(&(*msk.row_begin(iY))),
+                                        img.getSpanWidth(iY), meanCrude, andMask, checkFinite, doClip,
+                                        cliplimit, sums.n, sums.sumx, sums.sumx2, sums.min, sums.max,
+                                        sums.allPixelOrMask);
+                            }
+                        });
+        for (auto const &sums : bandSums) {
+            n += sums.n;
+            sumx += sums.sumx;
+            sumx2 += sums.sumx2;
+            min = (sums.min < min) ? sums.min : min;
+            max = (sums.max > max) ? sums.max : max;
+            orMask |= sums.allPixelOrMask;
+        }
+    } else {
+        for (int iY = 0; iY < img.getHeight(); ++iY) {
+            accumulateFloatRow(reinterpret_cast<float const *>(&(*img.row_begin(iY))),
+                               reinterpret_cast<image::MaskPixel const *>(&(*msk.row_begin(iY))),
+                               img.getSpanWidth(iY), meanCrude, andMask, checkFinite, doClip, cliplimit, n,
+                               sumx, sumx2, min, max, orMask);
+        }
+    }
+    if (!(flags & (MIN | MAX))) {
+        min = (nCrude) ? meanCrude : MAX_DOUBLE;
+        max = (nCrude) ? meanCrude : -MAX_DOUBLE;
+    }
+    *result = finishFastSums(n, sumx, sumx2, min, max, orMask, meanCrude);
+    return true;
+}
+
+/// @internal Vectorized accumulation over the spans of a plain float image (phony mask)
+template <typename ValueT, typename VarianceT, typename WeightT>
+bool getStandardFast(SpanView<image::Image<float>> const &img, MaskImposter<ValueT> const &msk,
+                     VarianceT const &, WeightT const &, int const flags, int const nCrude,
+                     double const meanCrude, bool const doClip, double const cliplimit, int const andMask,
+                     bool const calcErrorFromInputVariance, bool const doCheckFinite, bool const doGetWeighted,
+                     std::vector<double> const &maskPropagationThresholds, int const numThreads,
+                     StandardReturn *result) {
+    image::MaskPixel const maskVal = *msk.row_begin(0);
+    if (doGetWeighted || calcErrorFromInputVariance || !maskPropagationThresholds.empty() ||
+        (maskVal & andMask) || img.getHeight() == 0) {
+        return false;
+    }
+    bool const checkFinite = (flags & (MIN | MAX)) ? true : doCheckFinite;
+
+    int n = 0;
+    double sumx = 0.0;
+    double sumx2 = 0.0;
+    double min = (nCrude) ? meanCrude : MAX_DOUBLE;
+    double max = (nCrude) ? meanCrude : -MAX_DOUBLE;
+    if (numThreads > 1 && img.getHeight() >= 2 * numThreads) {
+        std::vector<PixelSums> bandSums(numThreads);
+        runOverRowBands(img.getHeight(), numThreads,
+                        [&img, &bandSums, meanCrude, checkFinite, doClip, cliplimit](int beginRow,
+                                                                                    int endRow, int band) {
+                            PixelSums &sums = bandSums[band];
+                            for (int iY = beginRow; iY < endRow; ++iY) {
+                                accumulateFloatRow(reinterpret_cast<float const *>(&(*img.row_begin(iY))),
+                                                   img.getSpanWidth(iY), meanCrude, checkFinite, doClip,
+                                                   cliplimit, sums.n, sums.sumx, sums.sumx2, sums.min,
+                                                   sums.max);
+                            }
+                        });
+        for (auto const &sums : bandSums) {
+            n += sums.n;
+            sumx += sums.sumx;
+            sumx2 += sums.sumx2;
+            min = (sums.min < min) ? sums.min : min;
+            max = (sums.max > max) ? sums.max : max;
+        }
+    } else {
+        for (int iY = 0; iY < img.getHeight(); ++iY) {
+            accumulateFloatRow(reinterpret_cast<float const *>(&(*img.row_begin(iY))), img.getSpanWidth(iY),
+                               meanCrude, checkFinite, doClip, cliplimit, n, sumx, sumx2, min, max);
+        }
     }
+    if (!(flags & (MIN | MAX))) {
+        min = (nCrude) ? meanCrude : MAX_DOUBLE;
+        max = (nCrude) ? meanCrude : -MAX_DOUBLE;
+    }
+    image::MaskPixel const orMask = (n > 0) ? maskVal : image::MaskPixel(0x0);
+    *result = finishFastSums(n, sumx, sumx2, min, max, orMask, meanCrude);
+    return true;
 }
 
 /** ==========================================================
@@ -356,14 +896,14 @@ template <typename ImageT, typename MaskT, typename VarianceT, typename WeightT>
 StandardReturn getStandard(ImageT const &img, MaskT const &msk, VarianceT const &var, WeightT const &weights,
                            int const flags, bool const weightsAreMultiplicative, int const andMask,
                            bool const calcErrorFromInputVariance, bool doCheckFinite, bool doGetWeighted,
-                           std::vector<double> const &maskPropagationThresholds) {
+                           std::vector<double> const &maskPropagationThresholds, int const numThreads) {
     // =====================================================
     // a crude estimate of the mean, used for numerical stability of variance
     int nCrude = 0;
     double meanCrude = 0.0;
 
     // for small numbers of values, use a small stride
-    int const nPix = img.getWidth() * img.getHeight();
+    int const nPix = static_cast<int>(pixelCount(img));
     int strideCrude;
     if (nPix < 100) {
         strideCrude = 2;
@@ -372,10 +912,16 @@ StandardReturn getStandard(ImageT const &img, MaskT const &msk, VarianceT const
     }
 
     double cliplimit = -1;  // unused
-    StandardReturn values = processPixels<ChkFin, AlwaysF, AlwaysF, AlwaysT, true>(
-            img, msk, var, weights, flags, nCrude, strideCrude, meanCrude, cliplimit,
-            weightsAreMultiplicative, andMask, calcErrorFromInputVariance, doCheckFinite, doGetWeighted,
-            maskPropagationThresholds);
+    // MIN | MAX are stripped here so the fast path mirrors the AlwaysF min/max functors below
+    StandardReturn values;
+    if (!getStandardFast(img, msk, var, weights, flags & ~(MIN | MAX), nCrude, meanCrude, false, cliplimit,
+                         andMask, calcErrorFromInputVariance, doCheckFinite, doGetWeighted,
+                         maskPropagationThresholds, numThreads, &values)) {
+        values = processPixels<ChkFin, AlwaysF, AlwaysF, AlwaysT, true>(
+                img, msk, var, weights, flags, nCrude, strideCrude, meanCrude, cliplimit,
+                weightsAreMultiplicative, andMask, calcErrorFromInputVariance, doCheckFinite, doGetWeighted,
+                maskPropagationThresholds, numThreads);
+    }
     nCrude = std::get<0>(values);
     double sumCrude = std::get<1>(values);
 
@@ -388,14 +934,26 @@ StandardReturn getStandard(ImageT const &img, MaskT const &msk, VarianceT const
     // Estimate the full precision variance using that crude mean
     // - get the min and max as well
 
+    // Contiguous float pixels take a vectorized single-pass accumulation; anything the fast
+    // path cannot reproduce exactly (weights, input-variance errors, mask-propagation
+    // thresholds) falls through to processPixels.
+    StandardReturn fastValues;
+    if (getStandardFast(img, msk, var, weights, flags, nCrude, meanCrude, false, cliplimit, andMask,
+                        calcErrorFromInputVariance, doCheckFinite, doGetWeighted,
+                        maskPropagationThresholds, numThreads, &fastValues)) {
+        return fastValues;
+    }
+
     if (flags & (MIN | MAX)) {
         return processPixels<ChkFin, ChkMin, ChkMax, AlwaysT, true>(
                 img, msk, var, weights, flags, nCrude, 1, meanCrude, cliplimit, weightsAreMultiplicative,
-                andMask, calcErrorFromInputVariance, true, doGetWeighted, maskPropagationThresholds);
+                andMask, calcErrorFromInputVariance, true, doGetWeighted, maskPropagationThresholds,
+                numThreads);
     } else {
         return processPixels<ChkFin, AlwaysF, AlwaysF, AlwaysT, true>(
                 img, msk, var, weights, flags, nCrude, 1, meanCrude, cliplimit, weightsAreMultiplicative,
-                andMask, calcErrorFromInputVariance, doCheckFinite, doGetWeighted, maskPropagationThresholds);
+                andMask, calcErrorFromInputVariance, doCheckFinite, doGetWeighted, maskPropagationThresholds,
+                numThreads);
     }
 }
 
@@ -423,7 +981,7 @@ StandardReturn getStandard(ImageT const &img, MaskT const &msk, VarianceT const
 
                            bool const weightsAreMultiplicative, int const andMask,
                            bool const calcErrorFromInputVariance, bool doCheckFinite, bool doGetWeighted,
-                           std::vector<double> const &maskPropagationThresholds) {
+                           std::vector<double> const &maskPropagationThresholds, int const numThreads) {
     double const center = clipinfo.first;
     double const cliplimit = clipinfo.second;
 
@@ -437,14 +995,25 @@ StandardReturn getStandard(ImageT const &img, MaskT const &msk, VarianceT const
     int const stride = 1;
     int nCrude = 0;
 
+    // The vectorized accumulation also handles the clip test, so each sigma-clipping
+    // iteration benefits as well.
+    StandardReturn fastValues;
+    if (getStandardFast(img, msk, var, weights, flags, nCrude, center, true, cliplimit, andMask,
+                        calcErrorFromInputVariance, doCheckFinite, doGetWeighted,
+                        maskPropagationThresholds, numThreads, &fastValues)) {
+        return fastValues;
+    }
+
     if (flags & (MIN | MAX)) {
         return processPixels<ChkFin, ChkMin, ChkMax, ChkClip, true>(
                 img, msk, var, weights, flags, nCrude, stride, center, cliplimit, weightsAreMultiplicative,
-                andMask, calcErrorFromInputVariance, true, doGetWeighted, maskPropagationThresholds);
+                andMask, calcErrorFromInputVariance, true, doGetWeighted, maskPropagationThresholds,
+                numThreads);
     } else {  // fast loop ... just the mean & variance
         return processPixels<ChkFin, AlwaysF, AlwaysF, ChkClip, true>(
                 img, msk, var, weights, flags, nCrude, stride, center, cliplimit, weightsAreMultiplicative,
-                andMask, calcErrorFromInputVariance, doCheckFinite, doGetWeighted, maskPropagationThresholds);
+                andMask, calcErrorFromInputVariance, doCheckFinite, doGetWeighted, maskPropagationThresholds,
+                numThreads);
     }
 }
 
@@ -722,6 +1291,127 @@ std::shared_ptr<std::vector<typename ImageT::Pixel> > makeVectorCopy(ImageT cons
 
     return imgcp;
 }
+
+int const QUANTILE_NBINS = 1024;  // bins per histogram refinement pass
+
+/**
+ * @internal One streaming pass for the histogram quantile engine
+ *
+ * Counts the accepted pixels falling in each of QUANTILE_NBINS equal-width bins of
+ * [lo, lo + nBins*binWidth) and, separately, those falling below lo; pixels at or above the
+ * upper edge are ignored (they are beyond the bracket being refined).
+ */
+template <typename IsFinite, typename ImageT, typename MaskT>
+void histogramPass(ImageT const &img, MaskT const &msk, int const andMask, double const lo,
+                   double const binWidth, std::vector<std::size_t> &bins, std::size_t &countBelow) {
+    double const hi = lo + binWidth * bins.size();
+    for (int iY = 0; iY < img.getHeight(); ++iY) {
+        typename MaskT::x_iterator mptr = msk.row_begin(iY);
+        for (typename ImageT::x_iterator ptr = img.row_begin(iY), end = img.row_end(iY); ptr != end;
+             ++ptr, ++mptr) {
+            if (IsFinite()(*ptr) && !(*mptr & andMask)) {
+                double const value = *ptr;
+                if (value < lo) {
+                    ++countBelow;
+                } else if (value < hi) {
+                    std::size_t indx = static_cast<std::size_t>((value - lo) / binWidth);
+                    if (indx >= bins.size()) {  // rounding at the upper edge
+                        indx = bins.size() - 1;
+                    }
+                    ++bins[indx];
+                }
+            }
+        }
+    }
+}
+
+/**
+ * @internal Estimate quantiles with a fixed-bin histogram, refined in streaming passes
+ *
+ * For each requested fraction the bracket containing the interpolated order statistic
+ * (rank fraction*(n - 1), as in percentile()) is narrowed by a factor of QUANTILE_NBINS per
+ * pass until the bin width is at most `tolerance`; the estimate is then interpolated
+ * uniformly within the final bin.  No copy of the pixels is made, so the extra memory is one
+ * histogram regardless of image size.
+ *
+ * Non-finite pixels never satisfy the bracketing comparisons and so are always excluded,
+ * even when the caller does not request the finite test.
+ */
+template <typename IsFinite, typename ImageT, typename MaskT>
+std::vector<double> histogramQuantiles(ImageT const &img, MaskT const &msk, int const andMask,
+                                       std::vector<double> const &fractions, double const tolerance) {
+    assert(tolerance > 0);
+
+    // One pass for the count and full range of the accepted pixels
+    std::size_t n = 0;
+    double min = MAX_DOUBLE;
+    double max = -MAX_DOUBLE;
+    for (int iY = 0; iY < img.getHeight(); ++iY) {
+        typename MaskT::x_iterator mptr = msk.row_begin(iY);
+        for (typename ImageT::x_iterator ptr = img.row_begin(iY), end = img.row_end(iY); ptr != end;
+             ++ptr, ++mptr) {
+            if (IsFinite()(*ptr) && !(*mptr & andMask)) {
+                double const value = *ptr;
+                if (std::isfinite(value)) {
+                    min = (value < min) ? value : min;
+                    max = (value > max) ? value : max;
+                    ++n;
+                }
+            }
+        }
+    }
+
+    std::vector<double> results(fractions.size(), NaN);
+    if (n == 0) {
+        return results;
+    }
+    if (n == 1 || max <= min + tolerance) {
+        // a single pixel, or a range already inside the tolerance: the midpoint will do
+        std::fill(results.begin(), results.end(), 0.5 * (min + max));
+        return results;
+    }
+
+    std::vector<std::size_t> bins(QUANTILE_NBINS);
+    for (std::size_t iFrac = 0; iFrac != fractions.size(); ++iFrac) {
+        assert(fractions[iFrac] >= 0.0 && fractions[iFrac] <= 1.0);
+        double const target = fractions[iFrac] * (n - 1);  // fractional rank, as in percentile()
+
+        double lo = min;
+        double hi = max;
+        for (;;) {
+            // use one bin of slack so the upper edge falls strictly inside the histogram
+            double binWidth = (hi - lo) / (QUANTILE_NBINS - 1);
+            if (binWidth <= 0.0) {
+                results[iFrac] = lo;
+                break;
+            }
+            std::fill(bins.begin(), bins.end(), 0);
+            std::size_t countBelow = 0;  // accepted pixels below lo, over the whole image
+            histogramPass<IsFinite>(img, msk, andMask, lo, binWidth, bins, countBelow);
+
+            // find the bin whose cumulative count crosses the target rank
+            double cumulative = countBelow;
+            std::size_t indx = 0;
+            while (indx + 1 < bins.size() && cumulative + bins[indx] <= target) {
+                cumulative += bins[indx];
+                ++indx;
+            }
+            double const binLo = lo + indx * binWidth;
+
+            if (binWidth <= tolerance) {
+                // interpolate uniformly within the bin; the error is below one bin width
+                double const inBin = (bins[indx] > 0) ? (target - cumulative) / bins[indx] : 0.5;
+                results[iFrac] = binLo + binWidth * std::min(std::max(inBin, 0.0), 1.0);
+                break;
+            }
+
+            // refine: the next pass resolves just this bin
+            lo = binLo;
+            hi = binLo + binWidth;
+        }
+    }
+    return results;
+}
 }  // namespace
 
 double StatisticsControl::getMaskPropagationThreshold(int bit) const {
@@ -786,6 +1476,8 @@ Statistics::Statistics(ImageT const &img, MaskT const &msk, VarianceT const &var
           _iqrange(NaN),
           _sctrl(sctrl),
           _weightsAreMultiplicative(false) {
+    instrumentation::Timer timer(instrumentation::Metric::STATISTICS_CALLS,
+                                 instrumentation::Metric::STATISTICS_NANOS);
     doStatistics(img, msk, var, var, _flags, _sctrl);
 }
 
@@ -816,6 +1508,9 @@ template <typename ImageT, typename PixelT>
 void checkDimensions(ImageT const &image1, MaskImposter<PixelT> const &image2) {}
 template <typename ImageT, typename PixelT>
 void checkDimensions(MaskImposter<PixelT> const &image1, ImageT const &image2) {}
+// Overload for SpanViews (the factory functions build every view over the same SpanSet)
+template <typename ImT1, typename ImT2>
+void checkDimensions(SpanView<ImT1> const &image1, SpanView<ImT2> const &image2) {}
 }  // namespace
 
 template <typename ImageT, typename MaskT, typename VarianceT, typename WeightT>
@@ -835,6 +1530,8 @@ Statistics::Statistics(ImageT const &img, MaskT const &msk, VarianceT const &var
           _iqrange(NaN),
           _sctrl(sctrl),
           _weightsAreMultiplicative(true) {
+    instrumentation::Timer timer(instrumentation::Metric::STATISTICS_CALLS,
+                                 instrumentation::Metric::STATISTICS_NANOS);
     if (!isEmpty(weights)) {
         if (_sctrl.getWeightedIsSet() && !_sctrl.getWeighted()) {
             throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
@@ -849,7 +1546,7 @@ Statistics::Statistics(ImageT const &img, MaskT const &msk, VarianceT const &var
 template <typename ImageT, typename MaskT, typename VarianceT, typename WeightT>
 void Statistics::doStatistics(ImageT const &img, MaskT const &msk, VarianceT const &var,
                               WeightT const &weights, int const flags, StatisticsControl const &sctrl) {
-    int const num = img.getWidth() * img.getHeight();
+    int const num = static_cast<int>(pixelCount(img));
     _n = num;
     if (_n == 0) {
         throw LSST_EXCEPT(pexExceptions::InvalidParameterError, "Image contains no pixels");
@@ -861,13 +1558,13 @@ void Statistics::doStatistics(ImageT const &img, MaskT const &msk, VarianceT con
     }
 
     // Check that an int's large enough to hold the number of pixels
-    assert(img.getWidth() * static_cast<double>(img.getHeight()) < std::numeric_limits<int>::max());
+    assert(pixelCount(img) < std::numeric_limits<int>::max());
 
     // get the standard statistics
     StandardReturn standard =
             getStandard(img, msk, var, weights, flags, _weightsAreMultiplicative, _sctrl.getAndMask(),
                         _sctrl.getCalcErrorFromInputVariance(), _sctrl.getNanSafe(), _sctrl.getWeighted(),
-                        _sctrl._maskPropagationThresholds);
+                        _sctrl._maskPropagationThresholds, _sctrl.getNumThreads());
 
     _n = std::get<0>(standard);
     _sum = std::get<1>(standard);
@@ -886,21 +1583,47 @@ void Statistics::doStatistics(ImageT const &img, MaskT const &msk, VarianceT con
 
     // copy the image for any routines that will use median or quantiles
     if (flags & (MEDIAN | IQRANGE | MEANCLIP | STDEVCLIP | VARIANCECLIP)) {
-        // make a vector copy of the image to get the median and quartiles (will move values)
-        std::shared_ptr<std::vector<typename ImageT::Pixel> > imgcp;
-        if (_sctrl.getNanSafe()) {
-            imgcp = makeVectorCopy<ChkFin>(img, msk, var, _sctrl.getAndMask());
+        bool const medianOnly = (flags & (MEDIAN)) && !(flags & (IQRANGE | MEANCLIP | STDEVCLIP |
+                                                                 VARIANCECLIP));
+        if (_sctrl.getQuantileTolerance() > 0.0) {
+            // estimate the quantiles from a streaming histogram; no pixel copy is made
+            std::vector<double> fractions;
+            if (medianOnly) {
+                fractions = {0.5};
+            } else {
+                fractions = {0.25, 0.5, 0.75};
+            }
+            std::vector<double> quantiles;
+            if (_sctrl.getNanSafe()) {
+                quantiles = histogramQuantiles<ChkFin>(img, msk, _sctrl.getAndMask(), fractions,
+                                                       _sctrl.getQuantileTolerance());
+            } else {
+                quantiles = histogramQuantiles<AlwaysT>(img, msk, _sctrl.getAndMask(), fractions,
+                                                        _sctrl.getQuantileTolerance());
+            }
+            if (medianOnly) {
+                _median = Value(quantiles[0], NaN);
+            } else {
+                _median = Value(quantiles[1], NaN);
+                _iqrange = quantiles[2] - quantiles[0];
+            }
         } else {
-            imgcp = makeVectorCopy<AlwaysT>(img, msk, var, _sctrl.getAndMask());
-        }
+            // make a vector copy of the image to get the median and quartiles (will move values)
+            std::shared_ptr<std::vector<typename ImageT::Pixel> > imgcp;
+            if (_sctrl.getNanSafe()) {
+                imgcp = makeVectorCopy<ChkFin>(img, msk, var, _sctrl.getAndMask());
+            } else {
+                imgcp = makeVectorCopy<AlwaysT>(img, msk, var, _sctrl.getAndMask());
+            }
 
-        // if we *only* want the median, just use percentile(), otherwise use medianAndQuartiles()
-        if ((flags & (MEDIAN)) && !(flags & (IQRANGE | MEANCLIP | STDEVCLIP | VARIANCECLIP))) {
-            _median = Value(percentile(*imgcp, 0.5), NaN);
-        } else {
-            MedianQuartileReturn mq = medianAndQuartiles(*imgcp);
-            _median = Value(std::get<0>(mq), NaN);
-            _iqrange = std::get<2>(mq) - std::get<1>(mq);
+            // if we *only* want the median, just use percentile(), otherwise use medianAndQuartiles()
+            if (medianOnly) {
+                _median = Value(percentile(*imgcp, 0.5), NaN);
+            } else {
+                MedianQuartileReturn mq = medianAndQuartiles(*imgcp);
+                _median = Value(std::get<0>(mq), NaN);
+                _iqrange = std::get<2>(mq) - std::get<1>(mq);
+            }
         }
 
         if (flags & (MEANCLIP | STDEVCLIP | VARIANCECLIP)) {
@@ -914,7 +1637,7 @@ void Statistics::doStatistics(ImageT const &img, MaskT const &msk, VarianceT con
                 StandardReturn clipped = getStandard(
                         img, msk, var, weights, flags, clipinfo, _weightsAreMultiplicative,
                         _sctrl.getAndMask(), _sctrl.getCalcErrorFromInputVariance(), _sctrl.getNanSafe(),
-                        _sctrl.getWeighted(), _sctrl._maskPropagationThresholds);
+                        _sctrl.getWeighted(), _sctrl._maskPropagationThresholds, _sctrl.getNumThreads());
 
                 int const nClip = std::get<0>(clipped);             // number after clipping
                 _nClipped = _n - nClip;                             // number clipped
@@ -1057,6 +1780,136 @@ double Statistics::getValue(Property const prop) const { return getResult(prop).
 
 double Statistics::getError(Property const prop) const { return getResult(prop).second; }
 
+namespace {
+/**
+ * @internal Accumulate one region into a StatisticsAccumulator's raw sums
+ *
+ * Anchors the offset to the first accepted pixel when the accumulator is still empty, then
+ * reuses accumulatePixels (min/max always tracked, no clipping, no weights) so the per-pixel
+ * tests match Statistics exactly.
+ */
+template <typename ImageT, typename MaskT>
+void accumulateRegionSums(ImageT const &img, MaskT const &msk, bool const nanSafe, int const andMask,
+                          bool &hasOffset, double &offset, int &n, double &sumx, double &sumx2, double &min,
+                          double &max, image::MaskPixel &orMask) {
+    if (!hasOffset) {
+        // anchor the offset to the first accepted pixel for numerical stability
+        for (int iY = 0; iY < img.getHeight() && !hasOffset; ++iY) {
+            typename MaskT::x_iterator mptr = msk.row_begin(iY);
+            for (typename ImageT::x_iterator ptr = img.row_begin(iY), end = img.row_end(iY); ptr != end;
+                 ++ptr, ++mptr) {
+                if ((!nanSafe || ChkFin()(*ptr)) && !(*mptr & andMask)) {
+                    offset = *ptr;
+                    hasOffset = true;
+                    break;
+                }
+            }
+        }
+    }
+
+    PixelSums sums;
+    sums.min = min;
+    sums.max = max;
+    MaskImposter<WeightPixel> const weights;
+    std::vector<double> const noThresholds;
+    if (nanSafe) {
+        accumulatePixels<ChkFin, ChkMin, ChkMax, AlwaysT, false>(img, msk, weights, weights, 0,
+                                                                 img.getHeight(), 1, offset, -1.0, false,
+                                                                 andMask, false, noThresholds, sums);
+    } else {
+        accumulatePixels<AlwaysT, ChkMin, ChkMax, AlwaysT, false>(img, msk, weights, weights, 0,
+                                                                  img.getHeight(), 1, offset, -1.0, false,
+                                                                  andMask, false, noThresholds, sums);
+    }
+    n += sums.n;
+    sumx += sums.sumx;
+    sumx2 += sums.sumx2;
+    min = sums.min;
+    max = sums.max;
+    orMask |= sums.allPixelOrMask;
+}
+}  // namespace
+
+StatisticsAccumulator::StatisticsAccumulator(StatisticsControl const &sctrl)
+        : _sctrl(sctrl),
+          _hasOffset(false),
+          _offset(0.0),
+          _n(0),
+          _sumx(0.0),
+          _sumx2(0.0),
+          _min(MAX_DOUBLE),
+          _max(-MAX_DOUBLE),
+          _allPixelOrMask(0x0) {}
+
+template <typename Pixel>
+StatisticsAccumulator &StatisticsAccumulator::operator+=(image::Image<Pixel> const &img) {
+    MaskImposter<image::MaskPixel> const msk;
+    accumulateRegionSums(img, msk, _sctrl.getNanSafe(), _sctrl.getAndMask(), _hasOffset, _offset, _n, _sumx,
+                         _sumx2, _min, _max, _allPixelOrMask);
+    return *this;
+}
+
+template <typename Pixel>
+StatisticsAccumulator &StatisticsAccumulator::operator+=(image::MaskedImage<Pixel> const &mimg) {
+    accumulateRegionSums(*mimg.getImage(), *mimg.getMask(), _sctrl.getNanSafe(), _sctrl.getAndMask(),
+                         _hasOffset, _offset, _n, _sumx, _sumx2, _min, _max, _allPixelOrMask);
+    return *this;
+}
+
+StatisticsAccumulator &StatisticsAccumulator::operator+=(std::vector<double> const &values) {
+    ImageImposter<double> const img(values);
+    MaskImposter<image::MaskPixel> const msk;
+    if (!values.empty()) {
+        accumulateRegionSums(img, msk, _sctrl.getNanSafe(), _sctrl.getAndMask(), _hasOffset, _offset, _n,
+                             _sumx, _sumx2, _min, _max, _allPixelOrMask);
+    }
+    return *this;
+}
+
+void StatisticsAccumulator::merge(StatisticsAccumulator const &other) {
+    if (other._n == 0) {
+        return;
+    }
+    if (_n == 0) {
+        _hasOffset = other._hasOffset;
+        _offset = other._offset;
+        _n = other._n;
+        _sumx = other._sumx;
+        _sumx2 = other._sumx2;
+        _min = other._min;
+        _max = other._max;
+        _allPixelOrMask = other._allPixelOrMask;
+        return;
+    }
+    // re-center the incoming sums about our offset before adding them
+    double const delta = other._offset - _offset;
+    _sumx2 += other._sumx2 + 2 * delta * other._sumx + other._n * delta * delta;
+    _sumx += other._sumx + other._n * delta;
+    _n += other._n;
+    _min = (other._min < _min) ? other._min : _min;
+    _max = (other._max > _max) ? other._max : _max;
+    _allPixelOrMask |= other._allPixelOrMask;
+}
+
+double StatisticsAccumulator::getSum() const noexcept { return _sumx + _n * _offset; }
+
+double StatisticsAccumulator::getMean() const noexcept { return _offset + _sumx / _n; }
+
+double StatisticsAccumulator::getVariance() const noexcept {
+    // the same biased estimator and debias factor as processPixels, with unit weights
+    double const n = _n;
+    double mean = _sumx / n;
+    double variance = _sumx2 / n - ::pow(mean, 2);
+    variance *= n * n / (n * n - n);
+    return variance;
+}
+
+double StatisticsAccumulator::getStdev() const noexcept { return std::sqrt(getVariance()); }
+
+double StatisticsAccumulator::getMin() const noexcept { return (_n > 0) ? _min : NaN; }
+
+double StatisticsAccumulator::getMax() const noexcept { return (_n > 0) ? _max : NaN; }
+
 /**
  * @internal Specialisation for Masks; just calculate the "Sum" as the bitwise OR of all pixels
  *
@@ -1115,6 +1968,45 @@ Statistics makeStatistics(image::Mask<image::MaskPixel> const &msk, int const fl
     return Statistics(msk, msk, msk, flags, sctrl);
 }
 
+namespace {
+/// @internal Throw unless the spans lie wholly inside the image
+template <typename ImageT>
+void checkSpansInImage(ImageT const &img, geom::SpanSet const &spans) {
+    if (!img.getBBox().contains(spans.getBBox())) {
+        throw LSST_EXCEPT(pexExceptions::InvalidParameterError,
+                          (boost::format("SpanSet bbox %s extends outside the image bbox %s") %
+                           spans.getBBox() % img.getBBox())
+                                  .str());
+    }
+}
+}  // namespace
+
+template <typename Pixel>
+Statistics makeStatistics(image::Image<Pixel> const &img, geom::SpanSet const &spans, int const flags,
+                          StatisticsControl const &sctrl) {
+    checkSpansInImage(img, spans);
+    SpanView<image::Image<Pixel>> const view(img, spans);
+    // make a phony mask that will be compiled out
+    MaskImposter<image::MaskPixel> const msk;
+    MaskImposter<WeightPixel> const var;
+    return Statistics(view, msk, var, flags, sctrl);
+}
+
+template <typename Pixel>
+Statistics makeStatistics(image::MaskedImage<Pixel> const &mimg, geom::SpanSet const &spans, int const flags,
+                          StatisticsControl const &sctrl) {
+    checkSpansInImage(*mimg.getImage(), spans);
+    SpanView<image::Image<Pixel>> const img(*mimg.getImage(), spans);
+    SpanView<image::Mask<image::MaskPixel>> const msk(*mimg.getMask(), spans);
+    if (sctrl.getWeighted() || sctrl.getCalcErrorFromInputVariance()) {
+        SpanView<image::Image<image::VariancePixel>> const var(*mimg.getVariance(), spans);
+        return Statistics(img, msk, var, flags, sctrl);
+    } else {
+        MaskImposter<WeightPixel> const var;
+        return Statistics(img, msk, var, flags, sctrl);
+    }
+}
+
 /*
  * Explicit instantiations
  *
@@ -1170,12 +2062,27 @@ typedef image::VariancePixel VPixel;
                               MaskImposter<VPixel> const &var, ImageImposter<VPixel> const &weights,     \
                               int const flags, StatisticsControl const &sctrl)
 
+#define INSTANTIATE_SPANSET_STATISTICS(TYPE)                                                   \
+    template Statistics makeStatistics<TYPE>(image::Image<TYPE> const &img,                    \
+                                             geom::SpanSet const &spans, int const flags,      \
+                                             StatisticsControl const &sctrl);                  \
+    template Statistics makeStatistics<TYPE>(image::MaskedImage<TYPE> const &mimg,             \
+                                             geom::SpanSet const &spans, int const flags,      \
+                                             StatisticsControl const &sctrl)
+
 #define INSTANTIATE_IMAGE_STATISTICS(T)            \
     INSTANTIATE_MASKEDIMAGE_STATISTICS(T);         \
     INSTANTIATE_MASKEDIMAGE_STATISTICS_NO_VAR(T);  \
     INSTANTIATE_MASKEDIMAGE_STATISTICS_NO_MASK(T); \
     INSTANTIATE_REGULARIMAGE_STATISTICS(T);        \
-    INSTANTIATE_VECTOR_STATISTICS(T)
+    INSTANTIATE_VECTOR_STATISTICS(T);              \
+    INSTANTIATE_SPANSET_STATISTICS(T)
+
+#define INSTANTIATE_STATISTICS_ACCUMULATOR(TYPE)                                              \
+    template StatisticsAccumulator &StatisticsAccumulator::operator+=(                        \
+            image::Image<TYPE> const &img);                                                   \
+    template StatisticsAccumulator &StatisticsAccumulator::operator+=(                        \
+            image::MaskedImage<TYPE> const &mimg)
 
 INSTANTIATE_IMAGE_STATISTICS(double);
 INSTANTIATE_IMAGE_STATISTICS(float);
@@ -1183,6 +2090,12 @@ INSTANTIATE_IMAGE_STATISTICS(int);
 INSTANTIATE_IMAGE_STATISTICS(std::uint16_t);
 INSTANTIATE_IMAGE_STATISTICS(std::uint64_t);
 
+INSTANTIATE_STATISTICS_ACCUMULATOR(double);
+INSTANTIATE_STATISTICS_ACCUMULATOR(float);
+INSTANTIATE_STATISTICS_ACCUMULATOR(int);
+INSTANTIATE_STATISTICS_ACCUMULATOR(std::uint16_t);
+INSTANTIATE_STATISTICS_ACCUMULATOR(std::uint64_t);
+
 /// @endcond
 }  // namespace math
 }  // namespace afw
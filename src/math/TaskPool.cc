@@ -0,0 +1,263 @@
+// -*- lsst-c++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008-2021 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+#include <algorithm>
+#include <utility>
+
+#if defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/afw/math/TaskPool.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace lsst {
+namespace afw {
+namespace math {
+
+/// @internal Completion state shared by a TaskGroup and its in-flight tasks.
+struct TaskGroupState {
+    std::atomic<std::size_t> pending{0};
+    std::mutex mutex;
+    std::condition_variable done;
+    std::exception_ptr error;  // first task failure; guarded by mutex
+};
+
+TaskPool &TaskPool::getInstance() {
+    static TaskPool pool;
+    return pool;
+}
+
+TaskPool::TaskPool()
+        : _numThreads(std::max(1u, std::thread::hardware_concurrency())),
+          _pinThreads(false),
+          _started(false),
+          _submitIndex(0),
+          _numQueued(0),
+          _stop(false) {}
+
+TaskPool::~TaskPool() {
+    {
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        _stop = true;
+    }
+    _workAvailable.notify_all();
+    for (auto &thread : _threads) {
+        thread.join();
+    }
+}
+
+int TaskPool::getNumThreads() const {
+    std::lock_guard<std::mutex> lock(_configMutex);
+    return _numThreads;
+}
+
+void TaskPool::setNumThreads(int numThreads) {
+    if (numThreads < 1) {
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError,
+                          "TaskPool must have at least one worker thread");
+    }
+    std::lock_guard<std::mutex> lock(_configMutex);
+    if (_started) {
+        throw LSST_EXCEPT(pexExcept::LogicError,
+                          "TaskPool size cannot be changed after its workers have started");
+    }
+    _numThreads = numThreads;
+}
+
+bool TaskPool::getAffinity() const {
+    std::lock_guard<std::mutex> lock(_configMutex);
+    return _pinThreads;
+}
+
+void TaskPool::setAffinity(bool pin) {
+    std::lock_guard<std::mutex> lock(_configMutex);
+    if (_started) {
+        throw LSST_EXCEPT(pexExcept::LogicError,
+                          "TaskPool affinity cannot be changed after its workers have started");
+    }
+    _pinThreads = pin;
+}
+
+void TaskPool::_start() {
+    _workers.reserve(_numThreads);
+    _threads.reserve(_numThreads);
+    for (int index = 0; index < _numThreads; ++index) {
+        _workers.emplace_back(new Worker);
+    }
+    // _workers must be complete before any thread runs: workers scan every queue
+    for (int index = 0; index < _numThreads; ++index) {
+        _threads.emplace_back(&TaskPool::_workerMain, this, static_cast<std::size_t>(index));
+    }
+    _started = true;
+}
+
+void TaskPool::_submit(Task task) {
+    {
+        std::lock_guard<std::mutex> lock(_configMutex);
+        if (!_started) {
+            _start();
+        }
+    }
+    std::size_t const index = _submitIndex++ % _workers.size();
+    {
+        // The increment must precede the push: once the task is visible in a
+        // worker deque a concurrent pop may decrement, and a decrement-first
+        // ordering would wrap the unsigned counter and defeat the sleep
+        // predicate in _workerMain.  At worst a worker wakes before the task
+        // is pushed, fails to pop, and goes back to sleep.  Taking the lock
+        // orders the increment against a worker's sleep decision.
+        std::lock_guard<std::mutex> lock(_sleepMutex);
+        ++_numQueued;
+    }
+    {
+        Worker &worker = *_workers[index];
+        std::lock_guard<std::mutex> lock(worker.mutex);
+        worker.tasks.push_back(std::move(task));
+    }
+    _workAvailable.notify_one();
+}
+
+bool TaskPool::_popTask(std::size_t self, Task &task) {
+    std::size_t const numWorkers = _workers.size();
+    if (self < numWorkers) {
+        // own queue: take the newest task for cache locality
+        Worker &own = *_workers[self];
+        std::lock_guard<std::mutex> lock(own.mutex);
+        if (!own.tasks.empty()) {
+            task = std::move(own.tasks.back());
+            own.tasks.pop_back();
+            --_numQueued;
+            return true;
+        }
+    }
+    // steal the oldest task from another worker's queue
+    for (std::size_t offset = 1; offset <= numWorkers; ++offset) {
+        Worker &victim = *_workers[(self + offset) % numWorkers];
+        std::lock_guard<std::mutex> lock(victim.mutex);
+        if (!victim.tasks.empty()) {
+            task = std::move(victim.tasks.front());
+            victim.tasks.pop_front();
+            --_numQueued;
+            return true;
+        }
+    }
+    return false;
+}
+
+bool TaskPool::_tryRunOneTask() {
+    Task task;
+    if (!_popTask(_workers.size(), task)) {
+        return false;
+    }
+    _runTask(std::move(task));
+    return true;
+}
+
+void TaskPool::_runTask(Task task) {
+    std::shared_ptr<TaskGroupState> const group = std::move(task.group);
+    try {
+        task.func();
+    } catch (...) {
+        std::lock_guard<std::mutex> lock(group->mutex);
+        if (!group->error) {
+            group->error = std::current_exception();
+        }
+    }
+    if (group->pending.fetch_sub(1) == 1) {
+        // taking the lock orders the decrement against the waiter's sleep decision
+        std::lock_guard<std::mutex> lock(group->mutex);
+        group->done.notify_all();
+    }
+}
+
+void TaskPool::_workerMain(std::size_t index) {
+#if defined(__linux__)
+    if (_pinThreads) {
+        unsigned const numCpus = std::max(1u, std::thread::hardware_concurrency());
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        CPU_SET(index % numCpus, &cpuSet);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpuSet), &cpuSet);
+    }
+#endif
+    for (;;) {
+        Task task;
+        if (_popTask(index, task)) {
+            _runTask(std::move(task));
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(_sleepMutex);
+        _workAvailable.wait(lock, [this] { return _stop || _numQueued.load() > 0; });
+        if (_stop && _numQueued.load() == 0) {
+            return;
+        }
+    }
+}
+
+TaskPool::TaskGroup::TaskGroup() : TaskGroup(TaskPool::getInstance()) {}
+
+TaskPool::TaskGroup::TaskGroup(TaskPool &pool) : _pool(pool), _state(std::make_shared<TaskGroupState>()) {}
+
+TaskPool::TaskGroup::~TaskGroup() {
+    try {
+        wait();
+    } catch (...) {
+        // wait() already ran every task; the exception is lost, but the
+        // destructor must not throw
+    }
+}
+
+void TaskPool::TaskGroup::run(std::function<void()> task) {
+    _state->pending.fetch_add(1);
+    _pool._submit(Task{std::move(task), _state});
+}
+
+void TaskPool::TaskGroup::wait() {
+    // Help drain the queues (running other groups' tasks too, so a task that
+    // waits on a nested group makes progress) until our tasks are all at
+    // least started, then sleep for the stragglers.
+    while (_state->pending.load() != 0) {
+        if (!_pool._tryRunOneTask()) {
+            break;
+        }
+    }
+    std::exception_ptr error;
+    {
+        std::unique_lock<std::mutex> lock(_state->mutex);
+        _state->done.wait(lock, [this] { return _state->pending.load() == 0; });
+        error = _state->error;
+        _state->error = nullptr;
+    }
+    if (error) {
+        std::rethrow_exception(error);
+    }
+}
+
+}  // namespace math
+}  // namespace afw
+}  // namespace lsst
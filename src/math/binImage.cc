@@ -23,9 +23,14 @@
 /*
  * Bin an Image or MaskedImage by an integral factor (the same in x and y)
  */
+#include <algorithm>
 #include <cstdint>
+#include <exception>
+#include <limits>
+#include <vector>
 
 #include "lsst/pex/exceptions.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/afw/math/offsetImage.h"
 
 namespace pexExcept = lsst::pex::exceptions;
@@ -34,17 +39,119 @@ namespace lsst {
 namespace afw {
 namespace math {
 
+namespace {
+
+// Reduce one bin of a single-plane image into the given output pixel.
+template <typename PixelT>
+void binOnePixel(image::Image<PixelT> const& bin, image::Image<PixelT>& out, int ox, int oy,
+                 lsst::afw::math::Property const flags, StatisticsControl const& sctrl) {
+    out(ox, oy) = makeStatistics(bin, flags, sctrl).getValue(flags);
+}
+
+/*
+ * Reduce one bin of a MaskedImage into the given output pixel.
+ *
+ * The statistic itself comes from makeStatistics, which honors
+ * sctrl.getAndMask() (and, for MEANCLIP, the clipping parameters).  The
+ * output mask is the OR of the unmasked pixels' masks and the variance is
+ * propagated assuming an unweighted mean of those pixels; a bin with no
+ * unmasked pixels is set to NaN with the OR of all of its pixels' masks.
+ */
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void binOnePixel(image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const& bin,
+                 image::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& out, int ox, int oy,
+                 lsst::afw::math::Property const flags, StatisticsControl const& sctrl) {
+    MaskPixelT const badMask = sctrl.getAndMask();
+    MaskPixelT orGood = 0;
+    MaskPixelT orAll = 0;
+    double sumVariance = 0.0;
+    int num = 0;
+    for (int y = 0; y != bin.getHeight(); ++y) {
+        for (auto ptr = bin.row_begin(y), end = bin.row_end(y); ptr != end; ++ptr) {
+            orAll |= ptr.mask();
+            if ((ptr.mask() & badMask) == 0) {
+                orGood |= ptr.mask();
+                sumVariance += ptr.variance();
+                ++num;
+            }
+        }
+    }
+    if (num == 0) {
+        auto const nan = std::numeric_limits<double>::quiet_NaN();
+        (*out.getImage())(ox, oy) = nan;
+        (*out.getMask())(ox, oy) = orAll;
+        (*out.getVariance())(ox, oy) = nan;
+    } else {
+        (*out.getImage())(ox, oy) = makeStatistics(bin, flags, sctrl).getValue(flags);
+        (*out.getMask())(ox, oy) = orGood;
+        (*out.getVariance())(ox, oy) = sumVariance / (static_cast<double>(num) * num);
+    }
+}
+
+}  // namespace
+
 template <typename ImageT>
 std::shared_ptr<ImageT> binImage(ImageT const& in, int const binsize, lsst::afw::math::Property const flags) {
     return binImage(in, binsize, binsize, flags);
 }
 
+template <typename ImageT>
+std::shared_ptr<ImageT> binImage(ImageT const& in, int const binX, int const binY,
+                                 lsst::afw::math::Property const flags, StatisticsControl const& sctrl,
+                                 int numThreads) {
+    if (flags != lsst::afw::math::MEAN && flags != lsst::afw::math::MEDIAN &&
+        flags != lsst::afw::math::MEANCLIP) {
+        throw LSST_EXCEPT(
+                pexExcept::InvalidParameterError,
+                (boost::format("Only MEAN, MEDIAN, and MEANCLIP are supported, saw 0x%x") % flags).str());
+    }
+    if (binX <= 0 || binY <= 0) {
+        throw LSST_EXCEPT(pexExcept::DomainError,
+                          (boost::format("Binning must be >= 0, saw %dx%d") % binX % binY).str());
+    }
+
+    int const outWidth = in.getWidth() / binX;
+    int const outHeight = in.getHeight() / binY;
+
+    std::shared_ptr<ImageT> out =
+            std::shared_ptr<ImageT>(new ImageT(lsst::geom::Extent2I(outWidth, outHeight)));
+    out->setXY0(in.getXY0());
+
+    auto reduceRows = [&in, &out, binX, binY, outWidth, flags, &sctrl](int beginRow, int endRow) {
+        for (int oy = beginRow; oy < endRow; ++oy) {
+            for (int ox = 0; ox != outWidth; ++ox) {
+                lsst::geom::Box2I const bbox(lsst::geom::Point2I(ox * binX, oy * binY),
+                                             lsst::geom::Extent2I(binX, binY));
+                ImageT const bin(in, bbox, image::LOCAL);
+                binOnePixel(bin, *out, ox, oy, flags, sctrl);
+            }
+        }
+    };
+
+    numThreads = std::min(numThreads, outHeight);
+    if (numThreads > 1) {
+        // Bins are independent and each band writes a disjoint set of output
+        // rows, so the result is identical to the serial loop.
+        TaskPool::TaskGroup group;
+        for (int band = 0; band < numThreads; ++band) {
+            int const beginRow = band * outHeight / numThreads;
+            int const endRow = (band + 1) * outHeight / numThreads;
+            group.run([&reduceRows, beginRow, endRow] { reduceRows(beginRow, endRow); });
+        }
+        group.wait();
+    } else {
+        reduceRows(0, outHeight);
+    }
+
+    return out;
+}
+
 template <typename ImageT>
 std::shared_ptr<ImageT> binImage(ImageT const& in, int const binX, int const binY,
                                  lsst::afw::math::Property const flags) {
     if (flags != lsst::afw::math::MEAN) {
-        throw LSST_EXCEPT(pexExcept::InvalidParameterError,
-                          (boost::format("Only afwMath::MEAN is supported, saw 0x%x") % flags).str());
+        // MEDIAN and MEANCLIP go through the Statistics-based engine.
+        return binImage(in, binX, binY, flags, StatisticsControl());
     }
     if (binX <= 0 || binY <= 0) {
         throw LSST_EXCEPT(pexExcept::DomainError,
@@ -94,7 +201,13 @@ std::shared_ptr<ImageT> binImage(ImageT const& in, int const binX, int const bin
     template std::shared_ptr<image::MaskedImage<TYPE>> binImage(image::MaskedImage<TYPE> const&, int,      \
                                                                 lsst::afw::math::Property const);          \
     template std::shared_ptr<image::MaskedImage<TYPE>> binImage(image::MaskedImage<TYPE> const&, int, int, \
-                                                                lsst::afw::math::Property const);
+                                                                lsst::afw::math::Property const);          \
+    template std::shared_ptr<image::Image<TYPE>> binImage(image::Image<TYPE> const&, int, int,             \
+                                                          lsst::afw::math::Property const,                 \
+                                                          StatisticsControl const&, int);                  \
+    template std::shared_ptr<image::MaskedImage<TYPE>> binImage(image::MaskedImage<TYPE> const&, int, int, \
+                                                                lsst::afw::math::Property const,           \
+                                                                StatisticsControl const&, int);
 
 INSTANTIATE(std::uint16_t)
 INSTANTIATE(int)
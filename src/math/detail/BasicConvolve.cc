@@ -28,7 +28,9 @@
 #include <algorithm>
 #include <cmath>
 #include <cstdint>
+#include <exception>
 #include <sstream>
+#include <type_traits>
 #include <vector>
 
 #include "lsst/pex/exceptions.h"
@@ -37,6 +39,7 @@
 #include "lsst/afw/image/MaskedImage.h"
 #include "lsst/afw/math/ConvolveImage.h"
 #include "lsst/afw/math/Kernel.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/afw/math/detail/Convolve.h"
 
 namespace pexExcept = lsst::pex::exceptions;
@@ -75,6 +78,139 @@ void assertDimensionsOK(OutImageT const& convolvedImage, InImageT const& inImage
         throw LSST_EXCEPT(pexExcept::InvalidParameterError, os.str());
     }
 }
+
+#if defined(__x86_64__) && defined(__GNUC__) && !defined(__clang__)
+// Compile the contiguous dot-product kernels as runtime-dispatched function clones so that
+// AVX2/AVX-512 code is used where the CPU supports it, without requiring -march at build time.
+#define LSST_AFW_CONVOLVE_TARGET_CLONES __attribute__((target_clones("avx512f", "avx2", "default")))
+#else
+#define LSST_AFW_CONVOLVE_TARGET_CLONES
+#endif
+
+/**
+ * @internal Branch-free kernel dot product over contiguous rows of channel data.
+ *
+ * The generic kernelDotProduct below tests every kernel value against zero; that branch
+ * (and the iterator abstraction) prevents the compiler from vectorizing the loop, which
+ * dominates the cost of large-kernel convolution. These overloads are only used for
+ * floating-point image rows, where including the (rare) zero kernel values in the sum
+ * is harmless.
+ */
+LSST_AFW_CONVOLVE_TARGET_CLONES
+inline double kernelDotProductRow(float const* imageRow, double const* kernelRow, int kWidth) {
+    double sum = 0.0;
+    for (int x = 0; x < kWidth; ++x) {
+        sum += imageRow[x] * kernelRow[x];
+    }
+    return sum;
+}
+
+LSST_AFW_CONVOLVE_TARGET_CLONES
+inline double kernelDotProductRow(double const* imageRow, double const* kernelRow, int kWidth) {
+    double sum = 0.0;
+    for (int x = 0; x < kWidth; ++x) {
+        sum += imageRow[x] * kernelRow[x];
+    }
+    return sum;
+}
+
+/**
+ * @internal Map an iterator onto the channel type of the flat buffer it traverses.
+ *
+ * The default (void) marks iterators with no contiguous channel buffer, e.g. MaskedImage
+ * zip iterators and GIL step (column) iterators; those take the generic dot-product path.
+ */
+template <typename IterT>
+struct IterChannel {
+    typedef void type;
+};
+template <typename ChannelT, typename LayoutT>
+struct IterChannel<boost::gil::pixel<ChannelT, LayoutT>*> {
+    typedef ChannelT type;
+};
+template <typename ChannelT, typename LayoutT>
+struct IterChannel<boost::gil::pixel<ChannelT, LayoutT> const*> {
+    typedef ChannelT type;
+};
+template <>
+struct IterChannel<std::vector<double>::const_iterator> {
+    typedef double type;
+};
+
+// Generic form; the trailing ellipsis makes this the worst-ranked overload, so the
+// tag arguments select a vectorized form whenever one exists for the channel types.
+template <typename OutPixelT, typename KernelPixelT, typename ImageIterT, typename KernelIterT>
+inline OutPixelT kernelDotProductDispatch(ImageIterT imageIter, KernelIterT kernelIter, int kWidth, ...) {
+    OutPixelT outPixel(0);
+    for (int x = 0; x < kWidth; ++x, ++imageIter, ++kernelIter) {
+        KernelPixelT kVal = *kernelIter;
+        if (kVal != 0) {
+            outPixel += static_cast<OutPixelT>((*imageIter) * kVal);
+        }
+    }
+    return outPixel;
+}
+
+template <typename OutPixelT, typename KernelPixelT, typename ImageIterT, typename KernelIterT>
+inline OutPixelT kernelDotProductDispatch(ImageIterT imageIter, KernelIterT kernelIter, int kWidth, float*,
+                                          double*) {
+    // Single-channel GIL pixels are layout-compatible with their channel type.
+    return static_cast<OutPixelT>(kernelDotProductRow(reinterpret_cast<float const*>(&(*imageIter)),
+                                                      reinterpret_cast<double const*>(&(*kernelIter)),
+                                                      kWidth));
+}
+
+template <typename OutPixelT, typename KernelPixelT, typename ImageIterT, typename KernelIterT>
+inline OutPixelT kernelDotProductDispatch(ImageIterT imageIter, KernelIterT kernelIter, int kWidth, double*,
+                                          double*) {
+    return static_cast<OutPixelT>(kernelDotProductRow(reinterpret_cast<double const*>(&(*imageIter)),
+                                                      reinterpret_cast<double const*>(&(*kernelIter)),
+                                                      kWidth));
+}
+
+/**
+ * @internal Convolve horizontal bands of the output image in parallel.
+ *
+ * Each band is handed to `worker` as a pair of shallow subimage views whose height includes
+ * the kernel overlap, so every output pixel sees its full kernel footprint; the sets of output
+ * pixels the workers actually write do not overlap. Returns false (without touching the images)
+ * when the control does not request threading or the image is too short to split profitably,
+ * in which case the caller should run its serial loop.
+ */
+template <typename OutImageT, typename InImageT, typename WorkerT>
+bool convolveInBands(OutImageT& convolvedImage, InImageT const& inImage,
+                     lsst::afw::math::Kernel const& kernel,
+                     lsst::afw::math::ConvolutionControl const& convolutionControl, WorkerT worker) {
+    int const numThreads = convolutionControl.getNumThreads();
+    int const kHeight = kernel.getHeight();
+    int const goodHeight = inImage.getHeight() + 1 - kHeight;
+    if (numThreads <= 1 || goodHeight < 2 * numThreads) {
+        return false;
+    }
+    lsst::afw::math::ConvolutionControl bandControl(convolutionControl);
+    bandControl.setNumThreads(1);
+    // a workspace is not thread safe; each band allocates privately
+    bandControl.setWorkspace(nullptr);
+
+    lsst::afw::math::TaskPool::TaskGroup group;
+    for (int band = 0; band < numThreads; ++band) {
+        // Parcel out the fully-convolvable rows; each band reads kHeight - 1 rows beyond the
+        // rows it writes.
+        int const beginRow = band * goodHeight / numThreads;
+        int const endRow = (band + 1) * goodHeight / numThreads;
+        lsst::geom::Box2I const bandBBox(
+                lsst::geom::Point2I(0, beginRow),
+                lsst::geom::Extent2I(inImage.getWidth(), endRow - beginRow + kHeight - 1));
+        group.run([&convolvedImage, &inImage, &bandControl, &worker, bandBBox] {
+            InImageT bandIn(inImage, bandBBox, lsst::afw::image::LOCAL, false);
+            OutImageT bandOut(convolvedImage, bandBBox, lsst::afw::image::LOCAL, false);
+            worker(bandOut, bandIn, bandControl);
+        });
+    }
+    group.wait();
+    return true;
+}
+
 /**
  * @internal Compute the dot product of a kernel row or column and the overlapping portion of an %image
  *
@@ -122,15 +258,43 @@ inline OutPixelT kernelDotProduct(
         KernelIterT kernelIter,  ///< @internal start of kernel vector
         int kWidth)              ///< @internal width of kernel
 {
-    OutPixelT outPixel(0);
-    for (int x = 0; x < kWidth; ++x, ++imageIter, ++kernelIter) {
-        KernelPixelT kVal = *kernelIter;
-        if (kVal != 0) {
-            outPixel += static_cast<OutPixelT>((*imageIter) * kVal);
+    typedef typename IterChannel<ImageIterT>::type ImageChannel;
+    typedef typename IterChannel<KernelIterT>::type KernelChannel;
+    return kernelDotProductDispatch<OutPixelT, KernelPixelT>(
+            imageIter, kernelIter, kWidth, static_cast<ImageChannel*>(nullptr),
+            static_cast<KernelChannel*>(nullptr));
+}
+
+/**
+ * @internal Kernel dot product with the kernel width fixed at compile time.
+ *
+ * With a constant trip count the compiler fully unrolls the loop, so 3x3 to 7x7 smoothing
+ * kernels pay no per-pixel loop or dispatch overhead. The zero test of the generic form is
+ * dropped, which is only harmless for plain floating-point Image rows (as in
+ * kernelDotProductRow), so the unrolled form is restricted to those via IterChannel;
+ * MaskedImage and integer images keep the generic zero-skipping dot product, in which
+ * zero-weight pixels contribute neither mask bits nor variance (IgnoreKernelZeroPixels).
+ * KWidth = 0 (width only known at run time) also falls back to kernelDotProduct.
+ */
+template <int KWidth, typename OutPixelT, typename ImageIterT, typename KernelIterT, typename KernelPixelT,
+          bool Unroll = (KWidth != 0) &&
+                        std::is_floating_point<typename IterChannel<ImageIterT>::type>::value>
+struct KernelDotProductFixed {
+    static inline OutPixelT apply(ImageIterT imageIter, KernelIterT kernelIter, int) {
+        OutPixelT outPixel(0);
+        for (int x = 0; x < KWidth; ++x, ++imageIter, ++kernelIter) {
+            outPixel += static_cast<OutPixelT>((*imageIter) * static_cast<KernelPixelT>(*kernelIter));
         }
+        return outPixel;
     }
-    return outPixel;
-}
+};
+template <int KWidth, typename OutPixelT, typename ImageIterT, typename KernelIterT, typename KernelPixelT>
+struct KernelDotProductFixed<KWidth, OutPixelT, ImageIterT, KernelIterT, KernelPixelT, false> {
+    static inline OutPixelT apply(ImageIterT imageIter, KernelIterT kernelIter, int kWidth) {
+        return kernelDotProduct<OutPixelT, ImageIterT, KernelIterT, KernelPixelT>(imageIter, kernelIter,
+                                                                                  kWidth);
+    }
+};
 }  // anonymous namespace
 
 namespace lsst {
@@ -178,6 +342,40 @@ void basicConvolve(OutImageT& convolvedImage, InImageT const& inImage, math::Ker
     }
 }
 
+namespace {
+
+/**
+ * @internal Copy the shifted input region of a delta function convolution into the output region.
+ *
+ * When the input and output image types match, the copy goes through shallow subimage views and
+ * a single bulk assign, which copies each plane of a MaskedImage as flat buffers instead of
+ * walking a per-pixel zip iterator.  The boxes are in LOCAL (index) coordinates.
+ */
+template <typename ImageT>
+void copyDeltaShiftedRegion(ImageT& convolvedImage, ImageT const& inImage,
+                            lsst::geom::Box2I const& cnvBBox, lsst::geom::Box2I const& inBBox) {
+    ImageT cnvView(convolvedImage, cnvBBox, image::LOCAL, false);
+    ImageT const inView(inImage, inBBox, image::LOCAL, false);
+    cnvView.assign(inView);
+}
+
+/// @internal Fallback for mismatched image types: copy pixel by pixel, converting as we go
+template <typename OutImageT, typename InImageT>
+void copyDeltaShiftedRegion(OutImageT& convolvedImage, InImageT const& inImage,
+                            lsst::geom::Box2I const& cnvBBox, lsst::geom::Box2I const& inBBox) {
+    for (int i = 0; i < cnvBBox.getHeight(); ++i) {
+        typename InImageT::const_x_iterator inPtr = inImage.x_at(inBBox.getMinX(), i + inBBox.getMinY());
+        for (typename OutImageT::x_iterator
+                     cnvPtr = convolvedImage.x_at(cnvBBox.getMinX(), i + cnvBBox.getMinY()),
+                     cnvEnd = cnvPtr + cnvBBox.getWidth();
+             cnvPtr != cnvEnd; ++cnvPtr, ++inPtr) {
+            *cnvPtr = *inPtr;
+        }
+    }
+}
+
+}  // namespace
+
 template <typename OutImageT, typename InImageT>
 void basicConvolve(OutImageT& convolvedImage, InImageT const& inImage,
                    math::DeltaFunctionKernel const& kernel,
@@ -196,14 +394,11 @@ void basicConvolve(OutImageT& convolvedImage, InImageT const& inImage,
 
     LOGL_DEBUG("TRACE2.afw.math.convolve.basicConvolve", "DeltaFunctionKernel basicConvolve");
 
-    for (int i = 0; i < cnvHeight; ++i) {
-        typename InImageT::x_iterator inPtr = inImage.x_at(inStartX, i + inStartY);
-        for (typename OutImageT::x_iterator cnvPtr = convolvedImage.x_at(cnvStartX, i + cnvStartY),
-                                            cnvEnd = cnvPtr + cnvWidth;
-             cnvPtr != cnvEnd; ++cnvPtr, ++inPtr) {
-            *cnvPtr = *inPtr;
-        }
-    }
+    // delta function convolution is a pure integer shift, so it reduces to a region copy
+    lsst::geom::Extent2I const dims(cnvWidth, cnvHeight);
+    copyDeltaShiftedRegion(convolvedImage, inImage,
+                           lsst::geom::Box2I(lsst::geom::Point2I(cnvStartX, cnvStartY), dims),
+                           lsst::geom::Box2I(lsst::geom::Point2I(inStartX, inStartY), dims));
 }
 
 template <typename OutImageT, typename InImageT>
@@ -252,16 +447,28 @@ void basicConvolve(OutImageT& convolvedImage, InImageT const& inImage, math::Sep
     typedef typename InImageT::const_x_iterator InXIterator;
     typedef typename InImageT::const_xy_locator InXYLocator;
     typedef typename OutImageT::x_iterator OutXIterator;
-    typedef typename OutImageT::y_iterator OutYIterator;
     typedef typename OutImageT::SinglePixel OutPixel;
 
     assertDimensionsOK(convolvedImage, inImage, kernel);
 
+    if (convolveInBands(convolvedImage, inImage, kernel, convolutionControl,
+                        [&kernel](OutImageT& bandOut, InImageT const& bandIn,
+                                  math::ConvolutionControl const& bandControl) {
+                            basicConvolve(bandOut, bandIn, kernel, bandControl);
+                        })) {
+        return;
+    }
+
     lsst::geom::Box2I const fullBBox = inImage.getBBox(image::LOCAL);
     lsst::geom::Box2I const goodBBox = kernel.shrinkBBox(fullBBox);
 
-    KernelVector kernelXVec(kernel.getWidth());
-    KernelVector kernelYVec(kernel.getHeight());
+    std::shared_ptr<ConvolutionWorkspace> const workspace = convolutionControl.getWorkspace();
+    KernelVector localKernelXVec;
+    KernelVector localKernelYVec;
+    KernelVector& kernelXVec = workspace ? workspace->getKernelXVector(kernel.getWidth()) : localKernelXVec;
+    KernelVector& kernelYVec = workspace ? workspace->getKernelYVector(kernel.getHeight()) : localKernelYVec;
+    kernelXVec.resize(kernel.getWidth());
+    kernelYVec.resize(kernel.getHeight());
 
     if (kernel.isSpatiallyVarying()) {
         LOGL_DEBUG("TRACE2.afw.math.convolve.basicConvolve",
@@ -288,66 +495,130 @@ void basicConvolve(OutImageT& convolvedImage, InImageT const& inImage, math::Sep
         }
     } else {
         // kernel is spatially invariant
-        // The basic sequence:
-        // - For each output row:
-        // - Compute x-convolved data: a kernel height's strip of input image convolved with kernel x vector
-        // - Compute one row of output by dotting each column of x-convolved data with the kernel y vector
-        // The x-convolved data is stored in a kernel-height by good-width buffer.
-        // This is circular buffer along y (to avoid shifting pixels before setting each new row);
-        // so for each new row the kernel y vector is rotated to match the order of the x-convolved data.
+        // The kernel is applied in two fused passes over column strips:
+        // - the x pass convolves a strip of each input row with the kernel x vector, storing
+        //   the result in a ring buffer holding a kernel height's worth of strip rows;
+        // - the y pass accumulates the kernel-y-weighted sum of the ring buffer rows into the
+        //   output row, running along x so that the inner loops stay contiguous.
+        // The strip width is chosen to keep the ring buffer cache resident even for large kernels.
 
         LOGL_DEBUG("TRACE2.afw.math.convolve.basicConvolve",
                    "SeparableKernel basicConvolve: kernel is spatially invariant");
 
         kernel.computeVectors(kernelXVec, kernelYVec, convolutionControl.getDoNormalize());
         KernelIterator const kernelXVecBegin = kernelXVec.begin();
-        KernelIterator const kernelYVecBegin = kernelYVec.begin();
-
-        // buffer for x-convolved data
-        OutImageT buffer(lsst::geom::Extent2I(goodBBox.getWidth(), kernel.getHeight()));
-
-        // pre-fill x-convolved data buffer with all but one row of data
-        int yInd = 0;  // during initial fill bufY = inImageY
-        int const yPrefillEnd = buffer.getHeight() - 1;
-        for (; yInd < yPrefillEnd; ++yInd) {
-            OutXIterator bufXIter = buffer.x_at(0, yInd);
-            OutXIterator const bufXEnd = buffer.x_at(goodBBox.getWidth(), yInd);
-            InXIterator inXIter = inImage.x_at(0, yInd);
-            for (; bufXIter != bufXEnd; ++bufXIter, ++inXIter) {
-                *bufXIter = kernelDotProduct<OutPixel, InXIterator, KernelIterator, KernelPixel>(
-                        inXIter, kernelXVecBegin, kernel.getWidth());
+        int const kWidth = kernel.getWidth();
+        int const kHeight = kernel.getHeight();
+
+        // target a ring buffer of roughly 32k pixels, but keep enough width per strip
+        // for the row loops to amortize their setup
+        int const stripWidth = std::min(goodBBox.getWidth(), std::max(64, 32768 / kHeight));
+
+        // ring buffer for x-convolved data, reused for every strip (and, via the workspace,
+        // across calls with the same geometry)
+        lsst::geom::Extent2I const bufferDimensions(stripWidth, kHeight);
+        std::shared_ptr<OutImageT> const bufferPtr =
+                workspace ? workspace->template getBuffer<OutImageT>(bufferDimensions)
+                          : std::make_shared<OutImageT>(bufferDimensions);
+        OutImageT& buffer = *bufferPtr;
+
+        for (int x0 = 0; x0 < goodBBox.getWidth(); x0 += stripWidth) {
+            int const thisStripWidth = std::min(stripWidth, goodBBox.getWidth() - x0);
+
+            // pre-fill the ring buffer with all but one row of x-convolved data
+            int const yPrefillEnd = kHeight - 1;
+            for (int yInd = 0; yInd < yPrefillEnd; ++yInd) {
+                OutXIterator bufXIter = buffer.x_at(0, yInd);
+                InXIterator inXIter = inImage.x_at(x0, yInd);
+                for (int x = 0; x < thisStripWidth; ++x, ++bufXIter, ++inXIter) {
+                    *bufXIter = kernelDotProduct<OutPixel, InXIterator, KernelIterator, KernelPixel>(
+                            inXIter, kernelXVecBegin, kWidth);
+                }
             }
-        }
 
-        // compute output pixels using the sequence described above
-        int inY = yPrefillEnd;
-        int bufY = yPrefillEnd;
-        int cnvY = goodBBox.getMinY();
-        while (true) {
-            // fill next buffer row and compute output row
-            InXIterator inXIter = inImage.x_at(0, inY);
-            OutXIterator bufXIter = buffer.x_at(0, bufY);
-            OutXIterator cnvXIter = convolvedImage.x_at(goodBBox.getMinX(), cnvY);
-            for (int bufX = 0; bufX < goodBBox.getWidth(); ++bufX, ++cnvXIter, ++bufXIter, ++inXIter) {
-                // note: bufXIter points to the row of the buffer that is being updated,
-                // whereas bufYIter points to row 0 of the buffer
-                *bufXIter = kernelDotProduct<OutPixel, InXIterator, KernelIterator, KernelPixel>(
-                        inXIter, kernelXVecBegin, kernel.getWidth());
-
-                OutYIterator bufYIter = buffer.y_at(bufX, 0);
-                *cnvXIter = kernelDotProduct<OutPixel, OutYIterator, KernelIterator, KernelPixel>(
-                        bufYIter, kernelYVecBegin, kernel.getHeight());
+            int inY = yPrefillEnd;
+            int bufY = yPrefillEnd;
+            for (int cnvY = goodBBox.getMinY(); cnvY <= goodBBox.getMaxY(); ++cnvY) {
+                // x pass: fill the ring buffer row for the newest input row
+                InXIterator inXIter = inImage.x_at(x0, inY);
+                OutXIterator bufXIter = buffer.x_at(0, bufY);
+                for (int x = 0; x < thisStripWidth; ++x, ++bufXIter, ++inXIter) {
+                    *bufXIter = kernelDotProduct<OutPixel, InXIterator, KernelIterator, KernelPixel>(
+                            inXIter, kernelXVecBegin, kWidth);
+                }
+
+                // y pass: accumulate the weighted ring buffer rows into the output row;
+                // buffer row (bufY + 1 + j) % kHeight holds input row cnvY - goodBBox.getMinY() + j.
+                // Rows with an exactly zero kernel value are skipped, as in kernelDotProduct,
+                // so that (for MaskedImage) zero-weight rows contribute neither mask bits
+                // nor variance.
+                bool firstTap = true;
+                for (int j = 0; j < kHeight; ++j) {
+                    KernelPixel const kVal = kernelYVec[j];
+                    if (kVal == 0) {
+                        continue;
+                    }
+                    OutXIterator accBufXIter = buffer.x_at(0, (bufY + 1 + j) % kHeight);
+                    OutXIterator cnvXIter = convolvedImage.x_at(goodBBox.getMinX() + x0, cnvY);
+                    if (firstTap) {
+                        for (int x = 0; x < thisStripWidth; ++x, ++accBufXIter, ++cnvXIter) {
+                            *cnvXIter = *accBufXIter * kVal;
+                        }
+                        firstTap = false;
+                    } else {
+                        for (int x = 0; x < thisStripWidth; ++x, ++accBufXIter, ++cnvXIter) {
+                            *cnvXIter += *accBufXIter * kVal;
+                        }
+                    }
+                }
+                if (firstTap) {
+                    // every y kernel value was zero: the zero-skipping dot product is empty
+                    OutXIterator cnvXIter = convolvedImage.x_at(goodBBox.getMinX() + x0, cnvY);
+                    for (int x = 0; x < thisStripWidth; ++x, ++cnvXIter) {
+                        *cnvXIter = OutPixel(0);
+                    }
+                }
+
+                ++inY;
+                bufY = (bufY + 1) % kHeight;
             }
+        }
+    }
+}
 
-            // test for done now, instead of the start of the loop,
-            // to avoid an unnecessary extra rotation of the kernel Y vector
-            if (cnvY >= goodBBox.getMaxY()) break;
+/**
+ * @internal The spatially invariant loops of convolveWithBruteForce, with the kernel width
+ * as a compile-time parameter (0 means the width is only known at run time).
+ */
+template <int KWidth, typename OutImageT, typename InImageT>
+void convolveWithKernelImage(OutImageT& convolvedImage, InImageT const& inImage,
+                             image::Image<math::Kernel::Pixel> const& kernelImage, int cnvStartX,
+                             int cnvStartY, int cnvWidth, int cnvHeight) {
+    typedef typename math::Kernel::Pixel KernelPixel;
+    typedef typename image::Image<KernelPixel>::const_x_iterator KernelXIterator;
+    typedef typename InImageT::const_x_iterator InXIterator;
+    typedef typename OutImageT::x_iterator OutXIterator;
+    typedef typename OutImageT::SinglePixel OutPixel;
 
-            // update y indices, including bufY, and rotate the kernel y vector to match
-            ++inY;
-            bufY = (bufY + 1) % kernel.getHeight();
-            ++cnvY;
-            std::rotate(kernelYVec.begin(), kernelYVec.end() - 1, kernelYVec.end());
+    int const kWidth = kernelImage.getWidth();
+    int const kHeight = kernelImage.getHeight();
+
+    for (int inStartY = 0, cnvY = cnvStartY; inStartY < cnvHeight; ++inStartY, ++cnvY) {
+        KernelXIterator kernelXIter = kernelImage.x_at(0, 0);
+        InXIterator inXIter = inImage.x_at(0, inStartY);
+        OutXIterator cnvXIter = convolvedImage.x_at(cnvStartX, cnvY);
+        for (int x = 0; x < cnvWidth; ++x, ++cnvXIter, ++inXIter) {
+            *cnvXIter = KernelDotProductFixed<KWidth, OutPixel, InXIterator, KernelXIterator,
+                                              KernelPixel>::apply(inXIter, kernelXIter, kWidth);
+        }
+        for (int kernelY = 1, inY = inStartY + 1; kernelY < kHeight; ++inY, ++kernelY) {
+            KernelXIterator kernelXIter = kernelImage.x_at(0, kernelY);
+            InXIterator inXIter = inImage.x_at(0, inY);
+            OutXIterator cnvXIter = convolvedImage.x_at(cnvStartX, cnvY);
+            for (int x = 0; x < cnvWidth; ++x, ++cnvXIter, ++inXIter) {
+                *cnvXIter += KernelDotProductFixed<KWidth, OutPixel, InXIterator, KernelXIterator,
+                                                   KernelPixel>::apply(inXIter, kernelXIter, kWidth);
+            }
         }
     }
 }
@@ -355,20 +626,29 @@ void basicConvolve(OutImageT& convolvedImage, InImageT const& inImage, math::Sep
 template <typename OutImageT, typename InImageT>
 void convolveWithBruteForce(OutImageT& convolvedImage, InImageT const& inImage, math::Kernel const& kernel,
                             math::ConvolutionControl const& convolutionControl) {
+    if (tryConvolveWithFFT(convolvedImage, inImage, kernel, convolutionControl)) {
+        return;
+    }
+
     bool doNormalize = convolutionControl.getDoNormalize();
 
     typedef typename math::Kernel::Pixel KernelPixel;
     typedef image::Image<KernelPixel> KernelImage;
 
-    typedef typename KernelImage::const_x_iterator KernelXIterator;
     typedef typename KernelImage::const_xy_locator KernelXYLocator;
-    typedef typename InImageT::const_x_iterator InXIterator;
     typedef typename InImageT::const_xy_locator InXYLocator;
     typedef typename OutImageT::x_iterator OutXIterator;
-    typedef typename OutImageT::SinglePixel OutPixel;
 
     assertDimensionsOK(convolvedImage, inImage, kernel);
 
+    if (convolveInBands(convolvedImage, inImage, kernel, convolutionControl,
+                        [&kernel](OutImageT& bandOut, InImageT const& bandIn,
+                                  math::ConvolutionControl const& bandControl) {
+                            convolveWithBruteForce(bandOut, bandIn, kernel, bandControl);
+                        })) {
+        return;
+    }
+
     int const inImageWidth = inImage.getWidth();
     int const inImageHeight = inImage.getHeight();
     int const kWidth = kernel.getWidth();
@@ -380,7 +660,11 @@ void convolveWithBruteForce(OutImageT& convolvedImage, InImageT const& inImage,
     int const cnvEndX = cnvStartX + cnvWidth;   // end index + 1
     int const cnvEndY = cnvStartY + cnvHeight;  // end index + 1
 
-    KernelImage kernelImage(kernel.getDimensions());
+    std::shared_ptr<ConvolutionWorkspace> const workspace = convolutionControl.getWorkspace();
+    std::shared_ptr<KernelImage> const kernelImagePtr =
+            workspace ? workspace->getKernelImage(kernel.getDimensions())
+                      : std::make_shared<KernelImage>(kernel.getDimensions());
+    KernelImage& kernelImage = *kernelImagePtr;
     KernelXYLocator const kernelLoc = kernelImage.xy_at(0, 0);
 
     if (kernel.isSpatiallyVarying()) {
@@ -408,23 +692,32 @@ void convolveWithBruteForce(OutImageT& convolvedImage, InImageT const& inImage,
 
         (void)kernel.computeImage(kernelImage, doNormalize);
 
-        for (int inStartY = 0, cnvY = cnvStartY; inStartY < cnvHeight; ++inStartY, ++cnvY) {
-            KernelXIterator kernelXIter = kernelImage.x_at(0, 0);
-            InXIterator inXIter = inImage.x_at(0, inStartY);
-            OutXIterator cnvXIter = convolvedImage.x_at(cnvStartX, cnvY);
-            for (int x = 0; x < cnvWidth; ++x, ++cnvXIter, ++inXIter) {
-                *cnvXIter = kernelDotProduct<OutPixel, InXIterator, KernelXIterator, KernelPixel>(
-                        inXIter, kernelXIter, kWidth);
-            }
-            for (int kernelY = 1, inY = inStartY + 1; kernelY < kHeight; ++inY, ++kernelY) {
-                KernelXIterator kernelXIter = kernelImage.x_at(0, kernelY);
-                InXIterator inXIter = inImage.x_at(0, inY);
-                OutXIterator cnvXIter = convolvedImage.x_at(cnvStartX, cnvY);
-                for (int x = 0; x < cnvWidth; ++x, ++cnvXIter, ++inXIter) {
-                    *cnvXIter += kernelDotProduct<OutPixel, InXIterator, KernelXIterator, KernelPixel>(
-                            inXIter, kernelXIter, kWidth);
-                }
-            }
+        // dispatch the common small smoothing widths to fully unrolled inner loops
+        switch (kWidth) {
+            case 3:
+                convolveWithKernelImage<3>(convolvedImage, inImage, kernelImage, cnvStartX, cnvStartY,
+                                           cnvWidth, cnvHeight);
+                break;
+            case 4:
+                convolveWithKernelImage<4>(convolvedImage, inImage, kernelImage, cnvStartX, cnvStartY,
+                                           cnvWidth, cnvHeight);
+                break;
+            case 5:
+                convolveWithKernelImage<5>(convolvedImage, inImage, kernelImage, cnvStartX, cnvStartY,
+                                           cnvWidth, cnvHeight);
+                break;
+            case 6:
+                convolveWithKernelImage<6>(convolvedImage, inImage, kernelImage, cnvStartX, cnvStartY,
+                                           cnvWidth, cnvHeight);
+                break;
+            case 7:
+                convolveWithKernelImage<7>(convolvedImage, inImage, kernelImage, cnvStartX, cnvStartY,
+                                           cnvWidth, cnvHeight);
+                break;
+            default:
+                convolveWithKernelImage<0>(convolvedImage, inImage, kernelImage, cnvStartX, cnvStartY,
+                                           cnvWidth, cnvHeight);
+                break;
         }
     }
 }
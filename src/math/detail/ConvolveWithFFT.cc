@@ -0,0 +1,285 @@
+// -*- LSST-C++ -*-
+
+/*
+ * LSST Data Management System
+ * Copyright 2008, 2009, 2010 LSST Corporation.
+ *
+ * This product includes software developed by the
+ * LSST Project (http://www.lsst.org/).
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the LSST License Statement and
+ * the GNU General Public License along with this program.  If not,
+ * see <http://www.lsstcorp.org/LegalNotices/>.
+ */
+
+/*
+ * Definition of tryConvolveWithFFT declared in detail/Convolve.h
+ */
+#include <algorithm>
+#include <complex>
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "fftw3.h"
+
+#include "lsst/pex/exceptions.h"
+#include "lsst/log/Log.h"
+#include "lsst/geom.h"
+#include "lsst/afw/image/MaskedImage.h"
+#include "lsst/afw/math/ConvolveImage.h"
+#include "lsst/afw/math/Kernel.h"
+#include "lsst/afw/math/detail/Convolve.h"
+
+namespace pexExcept = lsst::pex::exceptions;
+
+namespace lsst {
+namespace afw {
+namespace math {
+namespace detail {
+
+namespace {
+
+/// @internal Kernel area at which CONVOLUTION_AUTO switches from direct evaluation to the FFT;
+/// below roughly a 31x31 kernel the direct algorithm wins because of the transform overhead.
+int const fftKernelAreaCrossover = 31 * 31;
+
+/**
+ * @internal Cached FFTW state for one padded image size.
+ *
+ * The buffers are allocated with fftw_malloc so the plans may assume SIMD alignment.
+ * A plan may only be executed on the arrays it was created with, so the entry mutex
+ * serializes use of the buffers and plans.
+ */
+struct FftPlanCacheEntry {
+    FftPlanCacheEntry(int width, int height)
+            : width(width),
+              height(height),
+              freqWidth(width / 2 + 1),
+              real(fftw_alloc_real(static_cast<std::size_t>(width) * height)),
+              freq(fftw_alloc_complex(static_cast<std::size_t>(freqWidth) * height)) {
+        if (!real || !freq) {
+            throw std::bad_alloc();
+        }
+        forward = fftw_plan_dft_r2c_2d(height, width, real, freq, FFTW_ESTIMATE);
+        backward = fftw_plan_dft_c2r_2d(height, width, freq, real, FFTW_ESTIMATE);
+    }
+
+    FftPlanCacheEntry(FftPlanCacheEntry const&) = delete;
+    FftPlanCacheEntry& operator=(FftPlanCacheEntry const&) = delete;
+
+    ~FftPlanCacheEntry() {
+        fftw_destroy_plan(forward);
+        fftw_destroy_plan(backward);
+        fftw_free(real);
+        fftw_free(freq);
+    }
+
+    std::mutex mutex;
+    int const width;
+    int const height;
+    int const freqWidth;
+    double* const real;
+    fftw_complex* const freq;
+    fftw_plan forward;
+    fftw_plan backward;
+};
+
+/**
+ * @internal Return the cached FFTW plans and buffers for a padded size, creating them on first use.
+ *
+ * A pipeline convolves a small number of distinct image sizes over and over, so entries are
+ * kept for the life of the process. FFTW's planner is not thread safe; plans are created while
+ * holding the cache mutex.
+ */
+FftPlanCacheEntry& getFftPlanCacheEntry(int width, int height) {
+    static std::map<std::pair<int, int>, std::unique_ptr<FftPlanCacheEntry>> cache;
+    static std::mutex cacheMutex;
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto& entry = cache[std::make_pair(width, height)];
+    if (!entry) {
+        entry.reset(new FftPlanCacheEntry(width, height));
+    }
+    return *entry;
+}
+
+/**
+ * @internal Convolve a plain floating-point image with a spatially invariant kernel in Fourier space.
+ *
+ * Only the fully-convolved region of convolvedImage is written, exactly as for the direct
+ * algorithm; edge pixels are left for the caller (convolve() overwrites them). The input is
+ * zero padded to (inWidth + kWidth - 1, inHeight + kHeight - 1) so circular wrap-around cannot
+ * reach the fully-convolved region. afw convolution does not flip the kernel, so the image
+ * spectrum is multiplied by the conjugate of the kernel spectrum (cross-correlation theorem).
+ */
+template <typename OutImageT, typename InImageT>
+void fftConvolve(OutImageT& convolvedImage, InImageT const& inImage, math::Kernel const& kernel,
+                 bool doNormalize) {
+    typedef math::Kernel::Pixel KernelPixel;
+
+    int const inWidth = inImage.getWidth();
+    int const inHeight = inImage.getHeight();
+    int const kWidth = kernel.getWidth();
+    int const kHeight = kernel.getHeight();
+    int const padWidth = inWidth + kWidth - 1;
+    int const padHeight = inHeight + kHeight - 1;
+
+    image::Image<KernelPixel> kernelImage(kernel.getDimensions());
+    (void)kernel.computeImage(kernelImage, doNormalize);
+
+    FftPlanCacheEntry& entry = getFftPlanCacheEntry(padWidth, padHeight);
+    std::lock_guard<std::mutex> lock(entry.mutex);
+    std::size_t const nFreq = static_cast<std::size_t>(entry.freqWidth) * padHeight;
+
+    // transform of the zero-padded kernel
+    std::fill(entry.real, entry.real + static_cast<std::size_t>(padWidth) * padHeight, 0.0);
+    for (int y = 0; y < kHeight; ++y) {
+        typename image::Image<KernelPixel>::const_x_iterator kIter = kernelImage.row_begin(y);
+        double* row = entry.real + static_cast<std::size_t>(y) * padWidth;
+        for (int x = 0; x < kWidth; ++x, ++kIter) {
+            row[x] = *kIter;
+        }
+    }
+    fftw_execute(entry.forward);
+    std::vector<std::complex<double>> kernelFreq(nFreq);
+    for (std::size_t i = 0; i < nFreq; ++i) {
+        kernelFreq[i] = std::complex<double>(entry.freq[i][0], entry.freq[i][1]);
+    }
+
+    // transform of the zero-padded input image
+    std::fill(entry.real, entry.real + static_cast<std::size_t>(padWidth) * padHeight, 0.0);
+    for (int y = 0; y < inHeight; ++y) {
+        typename InImageT::const_x_iterator inIter = inImage.row_begin(y);
+        double* row = entry.real + static_cast<std::size_t>(y) * padWidth;
+        for (int x = 0; x < inWidth; ++x, ++inIter) {
+            row[x] = *inIter;
+        }
+    }
+    fftw_execute(entry.forward);
+
+    // multiply by the conjugate kernel spectrum; fold in the FFTW inverse-transform normalization
+    double const scale = 1.0 / (static_cast<double>(padWidth) * padHeight);
+    for (std::size_t i = 0; i < nFreq; ++i) {
+        std::complex<double> product =
+                std::complex<double>(entry.freq[i][0], entry.freq[i][1]) * std::conj(kernelFreq[i]) * scale;
+        entry.freq[i][0] = product.real();
+        entry.freq[i][1] = product.imag();
+    }
+    fftw_execute(entry.backward);
+
+    // copy out the fully-convolved region
+    int const cnvStartX = kernel.getCtr().getX();
+    int const cnvStartY = kernel.getCtr().getY();
+    int const cnvWidth = inWidth + 1 - kWidth;
+    int const cnvHeight = inHeight + 1 - kHeight;
+    for (int y = 0; y < cnvHeight; ++y) {
+        typename OutImageT::x_iterator cnvIter = convolvedImage.x_at(cnvStartX, y + cnvStartY);
+        double const* row = entry.real + static_cast<std::size_t>(y) * padWidth;
+        for (int x = 0; x < cnvWidth; ++x, ++cnvIter) {
+            *cnvIter = static_cast<typename OutImageT::Pixel>(row[x]);
+        }
+    }
+}
+
+// Eligible case: plain Image in and out, floating-point pixels on both sides.
+template <typename OutImageT, typename InImageT>
+bool fftConvolveIfSupported(OutImageT& convolvedImage, InImageT const& inImage, math::Kernel const& kernel,
+                            bool doNormalize, image::detail::Image_tag, std::true_type) {
+    fftConvolve(convolvedImage, inImage, kernel, doNormalize);
+    return true;
+}
+
+// Fallback for MaskedImage (whose mask propagation depends on per-pixel zero tests) and for
+// integer pixel types; the caller runs the direct algorithm instead.
+template <typename OutImageT, typename InImageT, typename ImageTagT, typename IsEligibleT>
+bool fftConvolveIfSupported(OutImageT&, InImageT const&, math::Kernel const&, bool, ImageTagT, IsEligibleT) {
+    return false;
+}
+
+}  // anonymous namespace
+
+template <typename OutImageT, typename InImageT>
+bool tryConvolveWithFFT(OutImageT& convolvedImage, InImageT const& inImage, math::Kernel const& kernel,
+                        math::ConvolutionControl const& convolutionControl) {
+    switch (convolutionControl.getAlgorithm()) {
+        case CONVOLUTION_DIRECT:
+            return false;
+        case CONVOLUTION_AUTO:
+            if (kernel.getWidth() * kernel.getHeight() < fftKernelAreaCrossover) {
+                return false;
+            }
+            break;
+        case CONVOLUTION_FFT:
+            break;
+    }
+    if (kernel.isSpatiallyVarying()) {
+        // the kernel has no single spectrum; only the direct algorithms apply
+        return false;
+    }
+    if (convolvedImage.getDimensions() != inImage.getDimensions() ||
+        inImage.getWidth() < kernel.getWidth() || inImage.getHeight() < kernel.getHeight()) {
+        // let the direct path produce its usual diagnostics
+        return false;
+    }
+
+    typedef typename image::detail::image_traits<OutImageT>::image_category OutCategory;
+    typedef std::integral_constant<bool,
+                                   std::is_floating_point<typename OutImageT::Pixel>::value &&
+                                           std::is_floating_point<typename InImageT::Pixel>::value>
+            IsEligible;
+    bool const used = fftConvolveIfSupported(convolvedImage, inImage, kernel,
+                                             convolutionControl.getDoNormalize(), OutCategory(),
+                                             IsEligible());
+    if (used) {
+        LOGL_DEBUG("TRACE2.afw.math.convolve.tryConvolveWithFFT", "convolving in Fourier space");
+    } else if (convolutionControl.getAlgorithm() == CONVOLUTION_FFT) {
+        LOGL_DEBUG("TRACE2.afw.math.convolve.tryConvolveWithFFT",
+                   "FFT requested but image/pixel types not supported; using direct algorithm");
+    }
+    return used;
+}
+
+/*
+ * Explicit instantiation
+ */
+/// @cond
+#define IMAGE(PIXTYPE) image::Image<PIXTYPE>
+#define MASKEDIMAGE(PIXTYPE) image::MaskedImage<PIXTYPE, image::MaskPixel, image::VariancePixel>
+#define NL /* */
+// Instantiate Image or MaskedImage versions
+#define INSTANTIATE_IM_OR_MI(IMGMACRO, OUTPIXTYPE, INPIXTYPE)                                    \
+    template bool tryConvolveWithFFT(IMGMACRO(OUTPIXTYPE)&, IMGMACRO(INPIXTYPE) const&,          \
+                                     math::Kernel const&, math::ConvolutionControl const&);
+// Instantiate both Image and MaskedImage versions
+#define INSTANTIATE(OUTPIXTYPE, INPIXTYPE)             \
+    INSTANTIATE_IM_OR_MI(IMAGE, OUTPIXTYPE, INPIXTYPE) \
+    INSTANTIATE_IM_OR_MI(MASKEDIMAGE, OUTPIXTYPE, INPIXTYPE)
+
+INSTANTIATE(double, double)
+INSTANTIATE(double, float)
+INSTANTIATE(double, int)
+INSTANTIATE(double, std::uint16_t)
+INSTANTIATE(float, float)
+INSTANTIATE(float, int)
+INSTANTIATE(float, std::uint16_t)
+INSTANTIATE(int, int)
+INSTANTIATE(std::uint16_t, std::uint16_t)
+/// @endcond
+}  // namespace detail
+}  // namespace math
+}  // namespace afw
+}  // namespace lsst
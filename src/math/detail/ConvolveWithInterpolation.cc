@@ -26,8 +26,10 @@
  * Definition of convolveWithInterpolation and helper functions declared in detail/ConvolveImage.h
  */
 #include <algorithm>
+#include <atomic>
 #include <cmath>
 #include <cstdint>
+#include <exception>
 #include <sstream>
 #include <vector>
 #include <iostream>
@@ -37,6 +39,7 @@
 #include "lsst/geom.h"
 #include "lsst/afw/image/MaskedImage.h"
 #include "lsst/afw/math/Kernel.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/afw/math/detail/Convolve.h"
 
 namespace pexExcept = lsst::pex::exceptions;
@@ -76,6 +79,31 @@ void convolveWithInterpolation(OutImageT &outImage, InImageT const &inImage, mat
     LOGL_DEBUG("TRACE3.afw.math.convolve.convolveWithInterpolation",
                "convolveWithInterpolation: divide into %d x %d subregions", nx, ny);
 
+    if (convolutionControl.getNumThreads() > 1) {
+        int const numThreads = convolutionControl.getNumThreads();
+        // Materialize the subdivision with every corner kernel image computed eagerly, spreading
+        // the spatial kernel evaluations over the thread pool; the returned regions are read-only
+        // and each writes a disjoint piece of the output, making them safe to convolve
+        // concurrently.
+        std::vector<std::shared_ptr<KernelImagesForRegion>> regions =
+                goodRegion.precomputeSubregions(nx, ny, numThreads);
+
+        // work queue: tasks pull regions off a shared counter until none remain, so each task
+        // amortizes its working images over many regions
+        std::atomic<std::size_t> nextRegion(0);
+        TaskPool::TaskGroup group;
+        for (int taskInd = 0; taskInd < numThreads; ++taskInd) {
+            group.run([&outImage, &inImage, &kernel, &regions, &nextRegion] {
+                ConvolveWithInterpolationWorkingImages taskImages(kernel.getDimensions());
+                for (std::size_t index = nextRegion++; index < regions.size(); index = nextRegion++) {
+                    convolveRegionWithInterpolation(outImage, inImage, *regions[index], taskImages);
+                }
+            });
+        }
+        group.wait();
+        return;
+    }
+
     ConvolveWithInterpolationWorkingImages workingImages(kernel.getDimensions());
     RowOfKernelImagesForRegion regionRow(nx, ny);
     while (goodRegion.computeNextRow(regionRow)) {
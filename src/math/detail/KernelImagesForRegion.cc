@@ -26,7 +26,9 @@
  * Definition of KernelImagesForRegion class declared in detail/ConvolveImage.h
  */
 #include <algorithm>
+#include <atomic>
 #include <cmath>
+#include <exception>
 #include <iostream>
 #include <sstream>
 #include <vector>
@@ -37,6 +39,7 @@
 #include "lsst/log/Log.h"
 #include "lsst/geom.h"
 #include "lsst/afw/image/ImageUtils.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/afw/math/detail/Convolve.h"
 
 namespace pexExcept = lsst::pex::exceptions;
@@ -171,6 +174,69 @@ bool KernelImagesForRegion::computeNextRow(RowOfKernelImagesForRegion &regionRow
     return true;
 }
 
+std::vector<std::shared_ptr<KernelImagesForRegion>> KernelImagesForRegion::precomputeSubregions(
+        int nx, int ny, int numThreads) const {
+    if (numThreads < 1) {
+        std::ostringstream os;
+        os << "numThreads = " << numThreads << " < 1";
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError, os.str());
+    }
+    std::vector<int> const widthList = _computeSubregionLengths(_bbox.getWidth(), nx);
+    std::vector<int> const heightList = _computeSubregionLengths(_bbox.getHeight(), ny);
+
+    // pixel indices of the grid of subregion corners; one more entry than subregions per axis
+    std::vector<int> xIndexList(nx + 1);
+    std::vector<int> yIndexList(ny + 1);
+    xIndexList[0] = _bbox.getMinX();
+    for (int xInd = 0; xInd < nx; ++xInd) {
+        xIndexList[xInd + 1] = xIndexList[xInd] + widthList[xInd];
+    }
+    yIndexList[0] = _bbox.getMinY();
+    for (int yInd = 0; yInd < ny; ++yInd) {
+        yIndexList[yInd + 1] = yIndexList[yInd] + heightList[yInd];
+    }
+
+    // compute the kernel image at every grid corner; tasks pull corner indices off a shared
+    // counter, each using its own clone of the kernel
+    std::vector<ImagePtr> imageList(xIndexList.size() * yIndexList.size());
+    std::atomic<std::size_t> nextCorner(0);
+    TaskPool::TaskGroup group;
+    for (int taskInd = 0; taskInd < numThreads; ++taskInd) {
+        group.run([this, &xIndexList, &yIndexList, &imageList, &nextCorner] {
+            std::shared_ptr<Kernel> kernelPtr = _kernelPtr->clone();
+            for (std::size_t index = nextCorner++; index < imageList.size(); index = nextCorner++) {
+                int const xInd = index % xIndexList.size();
+                int const yInd = index / xIndexList.size();
+                ImagePtr imagePtr(new Image(kernelPtr->getDimensions()));
+                kernelPtr->computeImage(*imagePtr, _doNormalize,
+                                        image::indexToPosition(xIndexList[xInd] + _xy0[0]),
+                                        image::indexToPosition(yIndexList[yInd] + _xy0[1]));
+                imageList[index] = imagePtr;
+            }
+        });
+    }
+    group.wait();
+
+    // assemble the subregions; horizontally and vertically adjacent subregions share their
+    // common corner images
+    std::vector<std::shared_ptr<KernelImagesForRegion>> regionList;
+    regionList.reserve(static_cast<std::size_t>(nx) * ny);
+    for (int yInd = 0; yInd < ny; ++yInd) {
+        for (int xInd = 0; xInd < nx; ++xInd) {
+            lsst::geom::Box2I const bbox(
+                    lsst::geom::Point2I(xIndexList[xInd], yIndexList[yInd]),
+                    lsst::geom::Extent2I(widthList[xInd], heightList[yInd]));
+            regionList.push_back(std::make_shared<KernelImagesForRegion>(
+                    _kernelPtr, bbox, _xy0, _doNormalize,
+                    imageList[yInd * xIndexList.size() + xInd],
+                    imageList[yInd * xIndexList.size() + xInd + 1],
+                    imageList[(yInd + 1) * xIndexList.size() + xInd],
+                    imageList[(yInd + 1) * xIndexList.size() + xInd + 1]));
+        }
+    }
+    return regionList;
+}
+
 void KernelImagesForRegion::_computeImage(Location location) const {
     ImagePtr imagePtr = _imagePtrList[location];
     if (!imagePtr) {
@@ -21,6 +21,8 @@
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include <algorithm>
+
 #include "lsst/afw/math/detail/TrapezoidalPacker.h"
 
 namespace lsst {
@@ -47,51 +49,56 @@ TrapezoidalPacker::TrapezoidalPacker(ChebyshevBoundedFieldControl const& ctrl)
 void TrapezoidalPacker::pack(ndarray::Array<double, 1, 1> const& out,
                              ndarray::Array<double const, 1, 1> const& tx,
                              ndarray::Array<double const, 1, 1> const& ty) const {
+    // work through raw pointers with the row scale factor hoisted, so the compiler can
+    // vectorize the inner loops
     double* outIter = out.begin();
+    double const* txIter = tx.begin();
     for (int i = 0; i < m; ++i) {  // loop over rectangular part
-        for (int j = 0; j < nx; ++j, ++outIter) {
-            *outIter = ty[i] * tx[j];
+        double const tyValue = ty[i];
+        for (int j = 0; j < nx; ++j) {
+            outIter[j] = tyValue * txIter[j];
         }
+        outIter += nx;
     }
     for (int i = m; i < ny; ++i) {  // loop over wide trapezoidal part
-        for (int j = 0, nj = nx + m - i; j < nj; ++j, ++outIter) {
-            *outIter = ty[i] * tx[j];
+        double const tyValue = ty[i];
+        int const nj = nx + m - i;
+        for (int j = 0; j < nj; ++j) {
+            outIter[j] = tyValue * txIter[j];
         }
+        outIter += nj;
     }
 }
 
 void TrapezoidalPacker::pack(ndarray::Array<double, 1, 1> const& out,
                              ndarray::Array<double const, 2, 2> const& unpacked) const {
+    // rows are contiguous, so each one can be moved with a single bulk copy
     double* outIter = out.begin();
     for (int i = 0; i < m; ++i) {  // loop over rectangular part
         ndarray::Array<double const, 1, 1> unpackedRow = unpacked[i];
-        for (int j = 0; j < nx; ++j, ++outIter) {
-            *outIter = unpackedRow[j];
-        }
+        outIter = std::copy(unpackedRow.begin(), unpackedRow.begin() + nx, outIter);
     }
     for (int i = m; i < ny; ++i) {  // loop over wide trapezoidal part
         ndarray::Array<double const, 1, 1> unpackedRow = unpacked[i];
-        for (int j = 0, nj = nx + m - i; j < nj; ++j, ++outIter) {
-            *outIter = unpackedRow[j];
-        }
+        outIter = std::copy(unpackedRow.begin(), unpackedRow.begin() + (nx + m - i), outIter);
     }
 }
 
 void TrapezoidalPacker::unpack(ndarray::Array<double, 2, 2> const& out,
                                ndarray::Array<double const, 1, 1> const& packed) const {
     out.deep() = 0.0;
+    // rows are contiguous, so each one can be moved with a single bulk copy
     double const* packedIter = packed.begin();
     for (int i = 0; i < m; ++i) {  // loop over rectangular part
         ndarray::Array<double, 1, 1> outRow = out[i];
-        for (int j = 0; j < nx; ++j, ++packedIter) {
-            outRow[j] = *packedIter;
-        }
+        std::copy(packedIter, packedIter + nx, outRow.begin());
+        packedIter += nx;
     }
     for (int i = m; i < ny; ++i) {  // loop over wide trapezoidal part
         ndarray::Array<double, 1, 1> outRow = out[i];
-        for (int j = 0, nj = nx + m - i; j < nj; ++j, ++packedIter) {
-            outRow[j] = *packedIter;
-        }
+        int const nj = nx + m - i;
+        std::copy(packedIter, packedIter + nj, outRow.begin());
+        packedIter += nj;
     }
 }
 
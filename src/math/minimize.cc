@@ -28,6 +28,8 @@
  * This file is meant to be included by lsst/afw/math/minimize.h
  */
 
+#include <algorithm>
+#include <cstddef>
 #include <string>
 
 #include "Minuit2/FunctionMinimum.h"
@@ -37,6 +39,7 @@
 
 #include "lsst/log/Log.h"
 #include "lsst/afw/math/minimize.h"
+#include "lsst/afw/math/TaskPool.h"
 
 namespace lsst {
 namespace afw {
@@ -52,7 +55,8 @@ public:
     explicit MinimizerFunctionBase1(Function1<ReturnT> const &function,
                                     std::vector<double> const &measurementList,
                                     std::vector<double> const &varianceList,
-                                    std::vector<double> const &xPositionList, double errorDef);
+                                    std::vector<double> const &xPositionList, double errorDef,
+                                    int numThreads = 1);
     MinimizerFunctionBase1(MinimizerFunctionBase1 const &) = default;
     MinimizerFunctionBase1(MinimizerFunctionBase1 &&) = default;
     MinimizerFunctionBase1 &operator=(MinimizerFunctionBase1 const &) = default;
@@ -74,6 +78,13 @@ private:
     std::vector<double> _varianceList;
     std::vector<double> _xPositionList;
     double _errorDef;
+    int _numThreads;
+    // Per-chunk clones of the function: setParameters mutates the functor, so
+    // concurrent chunks each need their own copy.  Minuit calls operator()
+    // serially, which makes these mutable caches safe.
+    mutable std::vector<std::shared_ptr<Function1<ReturnT> > > _chunkFunctions;
+    mutable std::vector<double> _lastParameters;
+    mutable double _lastChiSq;
 };
 
 /*
@@ -86,7 +97,8 @@ public:
                                     std::vector<double> const &measurementList,
                                     std::vector<double> const &varianceList,
                                     std::vector<double> const &xPositionList,
-                                    std::vector<double> const &yPositionList, double errorDef);
+                                    std::vector<double> const &yPositionList, double errorDef,
+                                    int numThreads = 1);
     MinimizerFunctionBase2(MinimizerFunctionBase2 const &) = default;
     MinimizerFunctionBase2(MinimizerFunctionBase2 &&) = default;
     MinimizerFunctionBase2 &operator=(MinimizerFunctionBase2 const &) = default;
@@ -110,6 +122,11 @@ private:
     std::vector<double> _xPositionList;
     std::vector<double> _yPositionList;
     double _errorDef;
+    int _numThreads;
+    // See MinimizerFunctionBase1 for why these caches are mutable
+    mutable std::vector<std::shared_ptr<Function2<ReturnT> > > _chunkFunctions;
+    mutable std::vector<double> _lastParameters;
+    mutable double _lastChiSq;
 };
 }  // namespace
 
@@ -119,12 +136,14 @@ MinimizerFunctionBase1<ReturnT>::MinimizerFunctionBase1(Function1<ReturnT> const
                                                         std::vector<double> const &measurementList,
                                                         std::vector<double> const &varianceList,
                                                         std::vector<double> const &xPositionList,
-                                                        double errorDef)
+                                                        double errorDef, int numThreads)
         : _functionPtr(function.clone()),
           _measurementList(measurementList),
           _varianceList(varianceList),
           _xPositionList(xPositionList),
-          _errorDef(errorDef) {}
+          _errorDef(errorDef),
+          _numThreads(numThreads),
+          _lastChiSq(0.0) {}
 
 template <typename ReturnT>
 MinimizerFunctionBase2<ReturnT>::MinimizerFunctionBase2(Function2<ReturnT> const &function,
@@ -132,41 +151,122 @@ MinimizerFunctionBase2<ReturnT>::MinimizerFunctionBase2(Function2<ReturnT> const
                                                         std::vector<double> const &varianceList,
                                                         std::vector<double> const &xPositionList,
                                                         std::vector<double> const &yPositionList,
-                                                        double errorDef)
+                                                        double errorDef, int numThreads)
         : _functionPtr(function.clone()),
           _measurementList(measurementList),
           _varianceList(varianceList),
           _xPositionList(xPositionList),
           _yPositionList(yPositionList),
-          _errorDef(errorDef) {}
+          _errorDef(errorDef),
+          _numThreads(numThreads),
+          _lastChiSq(0.0) {}
 
 // Only method we need to set up; basically this is a chi^2 routine
 template <typename ReturnT>
 double MinimizerFunctionBase1<ReturnT>::operator()(const std::vector<double> &par) const {
-    // Initialize the function with the fit parameters
-    this->_functionPtr->setParameters(par);
+    // Minuit re-evaluates the objective at unchanged parameters (e.g. while
+    // Hesse and Minos probe around the minimum), so reuse the last value
+    if (!_lastParameters.empty() && par == _lastParameters) {
+        return _lastChiSq;
+    }
 
+    std::size_t const nMeasurements = this->_measurementList.size();
+    int const numChunks = std::min(this->_numThreads, static_cast<int>(nMeasurements));
     double chi2 = 0.0;
-    for (unsigned int i = 0; i < this->_measurementList.size(); i++) {
-        double resid = (*(this->_functionPtr))(this->_xPositionList[i]) - this->_measurementList[i];
-        chi2 += resid * resid / this->_varianceList[i];
+    if (numChunks <= 1) {
+        // Initialize the function with the fit parameters
+        this->_functionPtr->setParameters(par);
+        for (std::size_t i = 0; i < nMeasurements; i++) {
+            double resid = (*(this->_functionPtr))(this->_xPositionList[i]) - this->_measurementList[i];
+            chi2 += resid * resid / this->_varianceList[i];
+        }
+    } else {
+        if (_chunkFunctions.empty()) {
+            _chunkFunctions.reserve(numChunks);
+            for (int chunk = 0; chunk != numChunks; ++chunk) {
+                _chunkFunctions.push_back(this->_functionPtr->clone());
+            }
+        }
+        TaskPool::TaskGroup group;
+        std::vector<double> partial(numChunks, 0.0);
+        for (int chunk = 0; chunk != numChunks; ++chunk) {
+            std::size_t const begin = chunk * nMeasurements / numChunks;
+            std::size_t const end = (chunk + 1) * nMeasurements / numChunks;
+            Function1<ReturnT> &func = *_chunkFunctions[chunk];
+            double &sum = partial[chunk];
+            group.run([this, &par, &func, &sum, begin, end] {
+                func.setParameters(par);
+                for (std::size_t i = begin; i != end; ++i) {
+                    double resid = func(this->_xPositionList[i]) - this->_measurementList[i];
+                    sum += resid * resid / this->_varianceList[i];
+                }
+            });
+        }
+        group.wait();
+        // Sum the partials in chunk order so the result does not depend on
+        // thread scheduling
+        for (double sum : partial) {
+            chi2 += sum;
+        }
     }
 
+    _lastParameters = par;
+    _lastChiSq = chi2;
     return chi2;
 }
 
 template <typename ReturnT>
 double MinimizerFunctionBase2<ReturnT>::operator()(const std::vector<double> &par) const {
-    // Initialize the function with the fit parameters
-    this->_functionPtr->setParameters(par);
+    // Minuit re-evaluates the objective at unchanged parameters (e.g. while
+    // Hesse and Minos probe around the minimum), so reuse the last value
+    if (!_lastParameters.empty() && par == _lastParameters) {
+        return _lastChiSq;
+    }
 
+    std::size_t const nMeasurements = this->_measurementList.size();
+    int const numChunks = std::min(this->_numThreads, static_cast<int>(nMeasurements));
     double chi2 = 0.0;
-    for (unsigned int i = 0; i < this->_measurementList.size(); i++) {
-        double resid = (*(this->_functionPtr))(this->_xPositionList[i], this->_yPositionList[i]) -
-                       this->_measurementList[i];
-        chi2 += resid * resid / this->_varianceList[i];
+    if (numChunks <= 1) {
+        // Initialize the function with the fit parameters
+        this->_functionPtr->setParameters(par);
+        for (std::size_t i = 0; i < nMeasurements; i++) {
+            double resid = (*(this->_functionPtr))(this->_xPositionList[i], this->_yPositionList[i]) -
+                           this->_measurementList[i];
+            chi2 += resid * resid / this->_varianceList[i];
+        }
+    } else {
+        if (_chunkFunctions.empty()) {
+            _chunkFunctions.reserve(numChunks);
+            for (int chunk = 0; chunk != numChunks; ++chunk) {
+                _chunkFunctions.push_back(this->_functionPtr->clone());
+            }
+        }
+        TaskPool::TaskGroup group;
+        std::vector<double> partial(numChunks, 0.0);
+        for (int chunk = 0; chunk != numChunks; ++chunk) {
+            std::size_t const begin = chunk * nMeasurements / numChunks;
+            std::size_t const end = (chunk + 1) * nMeasurements / numChunks;
+            Function2<ReturnT> &func = *_chunkFunctions[chunk];
+            double &sum = partial[chunk];
+            group.run([this, &par, &func, &sum, begin, end] {
+                func.setParameters(par);
+                for (std::size_t i = begin; i != end; ++i) {
+                    double resid = func(this->_xPositionList[i], this->_yPositionList[i]) -
+                                   this->_measurementList[i];
+                    sum += resid * resid / this->_varianceList[i];
+                }
+            });
+        }
+        group.wait();
+        // Sum the partials in chunk order so the result does not depend on
+        // thread scheduling
+        for (double sum : partial) {
+            chi2 += sum;
+        }
     }
 
+    _lastParameters = par;
+    _lastChiSq = chi2;
     return chi2;
 }
 /// @endcond
@@ -175,7 +275,7 @@ template <typename ReturnT>
 FitResults minimize(Function1<ReturnT> const &function, std::vector<double> const &initialParameterList,
                     std::vector<double> const &stepSizeList, std::vector<double> const &measurementList,
                     std::vector<double> const &varianceList, std::vector<double> const &xPositionList,
-                    double errorDef) {
+                    double errorDef, int numThreads) {
     unsigned int const nParameters = function.getNParameters();
     if (initialParameterList.size() != nParameters) {
         throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "initialParameterList is the wrong length");
@@ -192,7 +292,7 @@ FitResults minimize(Function1<ReturnT> const &function, std::vector<double> cons
     }
 
     MinimizerFunctionBase1<ReturnT> minimizerFunc(function, measurementList, varianceList, xPositionList,
-                                                  errorDef);
+                                                  errorDef, numThreads);
 
     ROOT::Minuit2::MnUserParameters fitPar;
     std::vector<std::string> paramNames;
@@ -229,7 +329,7 @@ template <typename ReturnT>
 FitResults minimize(Function2<ReturnT> const &function, std::vector<double> const &initialParameterList,
                     std::vector<double> const &stepSizeList, std::vector<double> const &measurementList,
                     std::vector<double> const &varianceList, std::vector<double> const &xPositionList,
-                    std::vector<double> const &yPositionList, double errorDef) {
+                    std::vector<double> const &yPositionList, double errorDef, int numThreads) {
     unsigned int const nParameters = function.getNParameters();
     if (initialParameterList.size() != nParameters) {
         throw LSST_EXCEPT(pex::exceptions::InvalidParameterError, "initialParameterList is the wrong length");
@@ -249,7 +349,7 @@ FitResults minimize(Function2<ReturnT> const &function, std::vector<double> cons
     }
 
     MinimizerFunctionBase2<ReturnT> minimizerFunc(function, measurementList, varianceList, xPositionList,
-                                                  yPositionList, errorDef);
+                                                  yPositionList, errorDef, numThreads);
 
     ROOT::Minuit2::MnUserParameters fitPar;
     std::vector<std::string> paramNames;
@@ -288,11 +388,12 @@ FitResults minimize(Function2<ReturnT> const &function, std::vector<double> cons
 #define minimizeFuncs(ReturnT)                                                                      \
     template FitResults minimize(Function1<ReturnT> const &, std::vector<double> const &,           \
                                  std::vector<double> const &, std::vector<double> const &,          \
-                                 std::vector<double> const &, std::vector<double> const &, double); \
+                                 std::vector<double> const &, std::vector<double> const &, double,  \
+                                 int);                                                              \
     NL template FitResults minimize(Function2<ReturnT> const &, std::vector<double> const &,        \
                                     std::vector<double> const &, std::vector<double> const &,       \
                                     std::vector<double> const &, std::vector<double> const &,       \
-                                    std::vector<double> const &, double);
+                                    std::vector<double> const &, double, int);
 
 minimizeFuncs(float) minimizeFuncs(double)
 /// @endcond
@@ -25,6 +25,7 @@
 /*
  * Offset an Image (or Mask or MaskedImage) by a constant vector (dx, dy)
  */
+#include <algorithm>
 #include <iterator>
 #include "lsst/geom.h"
 #include "lsst/afw/math/offsetImage.h"
@@ -122,6 +123,129 @@ std::shared_ptr<ImageT> offsetImage(ImageT const& inImage, float dx, float dy,
     return outImage;
 }
 
+template <typename PixelT>
+SubpixelOffset<PixelT>::SubpixelOffset(double dx, double dy, std::string const& algorithmName) {
+    if (!(dx > -1 && dx < 1 && dy > -1 && dy < 1)) {
+        throw LSST_EXCEPT(
+                pexExcept::InvalidParameterError,
+                (boost::format("SubpixelOffset requires offsets in (-1, 1); saw (%g, %g)") % dx % dy).str());
+    }
+    std::shared_ptr<SeparableKernel> offsetKernel = makeWarpingKernel(algorithmName);
+    // Same conventions as offsetImage: the kernel parameters are the negated
+    // shift, and the centre of a kernel computed for a negative shift is moved
+    // one pixel to centre up the largest coefficients.
+    double const dKerX = -dx;
+    double const dKerY = -dy;
+    if (dKerX < 0) {
+        offsetKernel->setCtr(offsetKernel->getCtr() + lsst::geom::Extent2I(1, 0));
+    }
+    if (dKerY < 0) {
+        offsetKernel->setCtr(offsetKernel->getCtr() + lsst::geom::Extent2I(0, 1));
+    }
+    offsetKernel->setKernelParameters(std::make_pair(dKerX, dKerY));
+    _kernelX.resize(offsetKernel->getWidth());
+    _kernelY.resize(offsetKernel->getHeight());
+    offsetKernel->computeVectors(_kernelX, _kernelY, true);
+    _ctr = offsetKernel->getCtr();
+}
+
+template <typename PixelT>
+void SubpixelOffset<PixelT>::apply(afwImage::Image<PixelT>& outImage,
+                                   afwImage::Image<PixelT> const& inImage) {
+    if (outImage.getDimensions() != inImage.getDimensions()) {
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError,
+                          (boost::format("outImage dimensions (%dx%d) do not match inImage (%dx%d)") %
+                           outImage.getWidth() % outImage.getHeight() % inImage.getWidth() %
+                           inImage.getHeight())
+                                  .str());
+    }
+    int const width = inImage.getWidth();
+    int const height = inImage.getHeight();
+    int const kWidth = _kernelX.size();
+    int const kHeight = _kernelY.size();
+    if (kWidth > width || kHeight > height) {
+        throw LSST_EXCEPT(pexExcept::LengthError,
+                          (boost::format("Image of size %dx%d is too small to offset using a %dx%d kernel") %
+                           width % height % kWidth % kHeight)
+                                  .str());
+    }
+    int const ctrX = _ctr.getX();
+    int const ctrY = _ctr.getY();
+    int const xStart = ctrX;
+    int const xEnd = width - (kWidth - 1 - ctrX);
+    int const yStart = ctrY;
+    int const yEnd = height - (kHeight - 1 - ctrY);
+
+    // The scratch space only reallocates when the image is wider than any seen before.
+    if (static_cast<int>(_ring.size()) != kHeight) {
+        _ring.resize(kHeight);
+    }
+    for (auto& row : _ring) {
+        if (static_cast<int>(row.size()) < width) {
+            row.resize(width);
+        }
+    }
+    _rows.resize(kHeight);
+
+    auto const in = inImage.getArray();
+    auto const out = outImage.getArray();
+
+    // Convolve input row iy with the x kernel into its ring buffer slot.
+    auto convolveRow = [&](int iy) {
+        auto const inRow = in[iy];
+        double* ringRow = _ring[iy % kHeight].data();
+        for (int x = xStart; x != xEnd; ++x) {
+            double sum = 0.0;
+            for (int i = 0; i != kWidth; ++i) {
+                sum += _kernelX[i] * inRow[x + i - ctrX];
+            }
+            ringRow[x] = sum;
+        }
+    };
+
+    // Prime the ring with the rows the first output row needs.  Each later
+    // input row is convolved as its slot frees up, which is always before the
+    // output row at the same y is written; that ordering is what makes the
+    // in-place case safe.
+    for (int iy = 0; iy != kHeight; ++iy) {
+        convolveRow(iy);
+    }
+    for (int y = yStart; y != yEnd; ++y) {
+        for (int j = 0; j != kHeight; ++j) {
+            _rows[j] = _ring[(y - ctrY + j) % kHeight].data();
+        }
+        auto outRow = out[y];
+        for (int x = xStart; x != xEnd; ++x) {
+            double sum = 0.0;
+            for (int j = 0; j != kHeight; ++j) {
+                sum += _kernelY[j] * _rows[j][x];
+            }
+            outRow[x] = sum;
+        }
+        int const nextRow = y - ctrY + kHeight;
+        if (nextRow < height) {
+            convolveRow(nextRow);
+        }
+    }
+
+    // offsetImage convolves with doCopyEdge set: pixels whose kernel footprint
+    // overhangs the image are copied from the input.  In place there is
+    // nothing to do, since the loops above never touch the edges.
+    if (out.getData() != in.getData()) {
+        for (int y = 0; y != height; ++y) {
+            auto const inRow = in[y];
+            auto outRow = out[y];
+            if (y < yStart || y >= yEnd) {
+                std::copy(inRow.begin(), inRow.end(), outRow.begin());
+            } else {
+                std::copy(inRow.begin(), inRow.begin() + xStart, outRow.begin());
+                std::copy(inRow.begin() + xEnd, inRow.end(), outRow.begin() + xEnd);
+            }
+        }
+    }
+    outImage.setXY0(inImage.getXY0());
+}
+
 //
 // Explicit instantiations
 //
@@ -130,7 +254,8 @@ std::shared_ptr<ImageT> offsetImage(ImageT const& inImage, float dx, float dy,
     template std::shared_ptr<afwImage::Image<TYPE>> offsetImage(afwImage::Image<TYPE> const&, float, float, \
                                                                 std::string const&, unsigned int);          \
     template std::shared_ptr<afwImage::MaskedImage<TYPE>> offsetImage(                                      \
-            afwImage::MaskedImage<TYPE> const&, float, float, std::string const&, unsigned int);
+            afwImage::MaskedImage<TYPE> const&, float, float, std::string const&, unsigned int);            \
+    template class SubpixelOffset<TYPE>;
 
 INSTANTIATE(double)
 INSTANTIATE(float)
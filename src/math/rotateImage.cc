@@ -23,10 +23,12 @@
 /*
  * Rotate an Image (or Mask or MaskedImage) by a fixed angle or number of quarter turns
  */
+#include <algorithm>
 #include <cstdint>
 
 #include "lsst/geom.h"
 #include "lsst/afw/math/offsetImage.h"
+#include "lsst/afw/image/MaskedImage.h"
 #include "lsst/afw/image/LsstImageTypes.h"
 
 namespace afwImage = lsst::afw::image;
@@ -35,6 +37,147 @@ namespace lsst {
 namespace afw {
 namespace math {
 
+namespace {
+
+// Tile edge, in pixels, for the blocked quarter-turn rotations below.  A pair
+// of 64x64 double tiles is 64KiB, small enough that both the row-strided and
+// column-strided sides of a transpose stay cache-resident.
+constexpr int ROTATE_TILE = 64;
+
+/*
+ * Copy a single plane into its quarter-turn rotation.
+ *
+ * The transposing turns (1 and 3) are blocked into tiles: walking a full
+ * image column per output row thrashes the cache on large frames, whereas
+ * within a tile both the reads and the writes stay cache-resident and the
+ * small inner loops vectorize.  The half turn (2) is a row reversal and
+ * already streams through both images.
+ */
+template <typename PixelT>
+void rotateArrayBy90(ndarray::Array<PixelT const, 2, 1> const& in, ndarray::Array<PixelT, 2, 1> const& out,
+                     int nQuarter) {
+    int const width = in.getSize<1>();
+    int const height = in.getSize<0>();
+    switch (nQuarter) {
+        case 1:
+            for (int y0 = 0; y0 < height; y0 += ROTATE_TILE) {
+                int const y1 = std::min(y0 + ROTATE_TILE, height);
+                for (int x0 = 0; x0 < width; x0 += ROTATE_TILE) {
+                    int const x1 = std::min(x0 + ROTATE_TILE, width);
+                    for (int x = x0; x < x1; ++x) {
+                        auto outRow = out[x];
+                        for (int y = y0; y < y1; ++y) {
+                            outRow[height - y - 1] = in[y][x];
+                        }
+                    }
+                }
+            }
+            break;
+        case 2:
+            for (int y = 0; y != height; ++y) {
+                auto const inRow = in[y];
+                std::reverse_copy(inRow.begin(), inRow.end(), out[height - y - 1].begin());
+            }
+            break;
+        case 3:
+            for (int y0 = 0; y0 < height; y0 += ROTATE_TILE) {
+                int const y1 = std::min(y0 + ROTATE_TILE, height);
+                for (int x0 = 0; x0 < width; x0 += ROTATE_TILE) {
+                    int const x1 = std::min(x0 + ROTATE_TILE, width);
+                    for (int x = x0; x < x1; ++x) {
+                        auto outRow = out[width - x - 1];
+                        for (int y = y0; y < y1; ++y) {
+                            outRow[y] = in[y][x];
+                        }
+                    }
+                }
+            }
+            break;
+    }
+}
+
+// Copy a single plane into its transpose, tiled like the quarter turns above.
+template <typename PixelT>
+void transposeArray(ndarray::Array<PixelT const, 2, 1> const& in, ndarray::Array<PixelT, 2, 1> const& out) {
+    int const width = in.getSize<1>();
+    int const height = in.getSize<0>();
+    for (int y0 = 0; y0 < height; y0 += ROTATE_TILE) {
+        int const y1 = std::min(y0 + ROTATE_TILE, height);
+        for (int x0 = 0; x0 < width; x0 += ROTATE_TILE) {
+            int const x1 = std::min(x0 + ROTATE_TILE, width);
+            for (int x = x0; x < x1; ++x) {
+                auto outRow = out[x];
+                for (int y = y0; y < y1; ++y) {
+                    outRow[y] = in[y][x];
+                }
+            }
+        }
+    }
+}
+
+// Copy a single plane into its left-right and/or top-bottom reflection.
+template <typename PixelT>
+void flipArray(ndarray::Array<PixelT const, 2, 1> const& in, ndarray::Array<PixelT, 2, 1> const& out,
+               bool flipLR, bool flipTB) {
+    int const height = in.getSize<0>();
+    for (int y = 0; y != height; ++y) {
+        auto const inRow = in[y];
+        auto outRow = out[flipTB ? height - y - 1 : y];
+        if (flipLR) {
+            std::reverse_copy(inRow.begin(), inRow.end(), outRow.begin());
+        } else {
+            std::copy(inRow.begin(), inRow.end(), outRow.begin());
+        }
+    }
+}
+
+// Plane-by-plane dispatch: single-plane images go straight to the array
+// kernels, while MaskedImages rotate/flip each of their planes in turn.
+
+template <typename PixelT>
+void rotateImagePixels(afwImage::ImageBase<PixelT> const& in, afwImage::ImageBase<PixelT>& out,
+                       int nQuarter) {
+    rotateArrayBy90(in.getArray(), out.getArray(), nQuarter);
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void rotateImagePixels(afwImage::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const& in,
+                       afwImage::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& out, int nQuarter) {
+    rotateImagePixels(*in.getImage(), *out.getImage(), nQuarter);
+    rotateImagePixels(*in.getMask(), *out.getMask(), nQuarter);
+    rotateImagePixels(*in.getVariance(), *out.getVariance(), nQuarter);
+}
+
+template <typename PixelT>
+void transposeImagePixels(afwImage::ImageBase<PixelT> const& in, afwImage::ImageBase<PixelT>& out) {
+    transposeArray(in.getArray(), out.getArray());
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void transposeImagePixels(afwImage::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const& in,
+                          afwImage::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& out) {
+    transposeImagePixels(*in.getImage(), *out.getImage());
+    transposeImagePixels(*in.getMask(), *out.getMask());
+    transposeImagePixels(*in.getVariance(), *out.getVariance());
+}
+
+template <typename PixelT>
+void flipImagePixels(afwImage::ImageBase<PixelT> const& in, afwImage::ImageBase<PixelT>& out, bool flipLR,
+                     bool flipTB) {
+    flipArray(in.getArray(), out.getArray(), flipLR, flipTB);
+}
+
+template <typename ImagePixelT, typename MaskPixelT, typename VariancePixelT>
+void flipImagePixels(afwImage::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT> const& in,
+                     afwImage::MaskedImage<ImagePixelT, MaskPixelT, VariancePixelT>& out, bool flipLR,
+                     bool flipTB) {
+    flipImagePixels(*in.getImage(), *out.getImage(), flipLR, flipTB);
+    flipImagePixels(*in.getMask(), *out.getMask(), flipLR, flipTB);
+    flipImagePixels(*in.getVariance(), *out.getVariance(), flipLR, flipTB);
+}
+
+}  // namespace
+
 template <typename ImageT>
 std::shared_ptr<ImageT> rotateImageBy90(ImageT const& inImage, int nQuarter) {
     std::shared_ptr<ImageT> outImage;  // output image
@@ -46,42 +189,15 @@ std::shared_ptr<ImageT> rotateImageBy90(ImageT const& inImage, int nQuarter) {
     switch (nQuarter % 4) {
         case 0:
             outImage.reset(new ImageT(inImage, true));  // a deep copy of inImage
-            break;
-        case 1:
-            outImage.reset(new ImageT(lsst::geom::Extent2I(inImage.getHeight(), inImage.getWidth())));
-
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::y_iterator optr = outImage->col_begin(inImage.getHeight() - y - 1);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, ++optr) {
-                    *optr = *iptr;
-                }
-            }
-
             break;
         case 2:
             outImage.reset(new ImageT(inImage.getDimensions()));
-
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::x_iterator optr =
-                        outImage->x_at(inImage.getWidth() - 1, inImage.getHeight() - y - 1);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, optr -= 1) {
-                    *optr = *iptr;
-                }
-            }
+            rotateImagePixels(inImage, *outImage, 2);
             break;
+        case 1:
         case 3:
             outImage.reset(new ImageT(lsst::geom::Extent2I(inImage.getHeight(), inImage.getWidth())));
-
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::y_iterator optr = outImage->y_at(y, inImage.getWidth() - 1);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, optr -= 1) {
-                    *optr = *iptr;
-                }
-            }
-
+            rotateImagePixels(inImage, *outImage, nQuarter % 4);
             break;
     }
 
@@ -92,42 +208,21 @@ template <typename ImageT>
 std::shared_ptr<ImageT> flipImage(ImageT const& inImage, bool flipLR, bool flipTB) {
     std::shared_ptr<ImageT> outImage(new ImageT(inImage, true));  // Output image
 
-    if (flipLR) {
-        if (flipTB) {
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::x_iterator optr =
-                        outImage->x_at(inImage.getWidth() - 1, inImage.getHeight() - y - 1);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, optr -= 1) {
-                    *optr = *iptr;
-                }
-            }
-        } else {
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::x_iterator optr = outImage->x_at(inImage.getWidth() - 1, y);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, optr -= 1) {
-                    *optr = *iptr;
-                }
-            }
-        }
-    } else {
-        if (flipTB) {
-            for (int y = 0; y != inImage.getHeight(); ++y) {
-                typename ImageT::x_iterator optr = outImage->row_begin(inImage.getHeight() - y - 1);
-                for (typename ImageT::x_iterator iptr = inImage.row_begin(y), end = inImage.row_end(y);
-                     iptr != end; ++iptr, ++optr) {
-                    *optr = *iptr;
-                }
-            }
-        } else {
-            ;  // nothing to do
-        }
+    if (flipLR || flipTB) {
+        flipImagePixels(inImage, *outImage, flipLR, flipTB);
     }
 
     return outImage;
 }
 
+template <typename ImageT>
+std::shared_ptr<ImageT> transposeImage(ImageT const& inImage) {
+    std::shared_ptr<ImageT> outImage(
+            new ImageT(lsst::geom::Extent2I(inImage.getHeight(), inImage.getWidth())));
+    transposeImagePixels(inImage, *outImage);
+    return outImage;
+}
+
 //
 // Explicit instantiations
 //
@@ -139,7 +234,10 @@ std::shared_ptr<ImageT> flipImage(ImageT const& inImage, bool flipLR, bool flipT
     template std::shared_ptr<afwImage::Image<TYPE>> flipImage(afwImage::Image<TYPE> const&, bool flipLR, \
                                                               bool flipTB);                              \
     template std::shared_ptr<afwImage::MaskedImage<TYPE>> flipImage(afwImage::MaskedImage<TYPE> const&,  \
-                                                                    bool flipLR, bool flipTB);
+                                                                    bool flipLR, bool flipTB);          \
+    template std::shared_ptr<afwImage::Image<TYPE>> transposeImage(afwImage::Image<TYPE> const&);       \
+    template std::shared_ptr<afwImage::MaskedImage<TYPE>> transposeImage(                               \
+            afwImage::MaskedImage<TYPE> const&);
 
 INSTANTIATE(std::uint16_t)
 INSTANTIATE(int)
@@ -149,6 +247,8 @@ template std::shared_ptr<afwImage::Mask<afwImage::MaskPixel>> rotateImageBy90(
         afwImage::Mask<afwImage::MaskPixel> const&, int);
 template std::shared_ptr<afwImage::Mask<afwImage::MaskPixel>> flipImage(
         afwImage::Mask<afwImage::MaskPixel> const&, bool flipLR, bool flipTB);
+template std::shared_ptr<afwImage::Mask<afwImage::MaskPixel>> transposeImage(
+        afwImage::Mask<afwImage::MaskPixel> const&);
 /// @endcond
 }  // namespace math
 }  // namespace afw
@@ -25,9 +25,11 @@
  * Support for warping an %image to a new Wcs.
  */
 
+#include <atomic>
 #include <cassert>
 #include <cmath>
 #include <cstdint>
+#include <exception>
 #include <limits>
 #include <memory>
 #include <sstream>
@@ -46,7 +48,9 @@
 #include "lsst/geom.h"
 #include "lsst/afw/math/warpExposure.h"
 #include "lsst/afw/geom.h"
+#include "lsst/afw/instrumentation.h"
 #include "lsst/afw/math/Kernel.h"
+#include "lsst/afw/math/TaskPool.h"
 #include "lsst/afw/image/PhotoCalib.h"
 #include "lsst/afw/math/detail/WarpAtOnePoint.h"
 
@@ -100,6 +104,87 @@ std::shared_ptr<Kernel> LanczosWarpingKernel::clone() const {
 
 int LanczosWarpingKernel::getOrder() const { return this->getWidth() / 2; }
 
+namespace {
+
+/**
+ * @internal Fill one axis of a Lanczos warping kernel in closed form
+ *
+ * The tap at index i lies at offset k - frac from the kernel function's origin, where
+ * k = i - ctr is an integer, so sin(pi (k - frac)) = -(-1)^k sin(pi frac) for every tap
+ * and sin(pi (k - frac) / n) expands over the precomputed per-tap sin/cos of pi k / n.
+ * The loop body is then free of transcendental calls and vectorizes.
+ *
+ * @returns the sum of the taps
+ */
+double fillLanczosVector(std::vector<double>& kernelList, std::vector<double> const& tapSinList,
+                         std::vector<double> const& tapCosList, int ctr, double invN, double frac) {
+    double const sinPiFrac = std::sin(lsst::geom::PI * frac);
+    double const sinPiFracInvN = std::sin(lsst::geom::PI * frac * invN);
+    double const cosPiFracInvN = std::cos(lsst::geom::PI * frac * invN);
+    double sum = 0.0;
+    for (std::size_t i = 0, size = kernelList.size(); i < size; ++i) {
+        int const k = static_cast<int>(i) - ctr;
+        double const xArg1 = (k - frac) * lsst::geom::PI;
+        double const xArg2 = xArg1 * invN;
+        double value = 1.0;
+        if (std::fabs(xArg1) > 1.0e-5) {
+            double const sin1 = (k % 2 == 0) ? -sinPiFrac : sinPiFrac;
+            double const sin2 = tapSinList[i] * cosPiFracInvN - tapCosList[i] * sinPiFracInvN;
+            value = sin1 * sin2 / (xArg1 * xArg2);
+        }
+        kernelList[i] = value;
+        sum += value;
+    }
+    return sum;
+}
+
+}  // namespace
+
+void LanczosWarpingKernel::_setTapTable(TapTable& table, int size, int ctr) const {
+    double const invN = 1.0 / static_cast<double>(getOrder());
+    table.ctr = ctr;
+    table.sinPiKInvN.resize(size);
+    table.cosPiKInvN.resize(size);
+    for (int i = 0; i < size; ++i) {
+        double const piKInvN = lsst::geom::PI * (i - ctr) * invN;
+        table.sinPiKInvN[i] = std::sin(piKInvN);
+        table.cosPiKInvN[i] = std::cos(piKInvN);
+    }
+}
+
+double LanczosWarpingKernel::computeLanczosVectors(std::vector<double>& colList,
+                                                   std::vector<double>& rowList, double xFrac,
+                                                   double yFrac) const {
+    if (static_cast<int>(colList.size()) != this->getWidth() ||
+        static_cast<int>(rowList.size()) != this->getHeight()) {
+        std::ostringstream os;
+        os << "colList.size(), rowList.size() = (" << colList.size() << ", " << rowList.size() << ") != ("
+           << this->getWidth() << ", " << this->getHeight() << ") = "
+           << "kernel dimensions";
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError, os.str());
+    }
+    // keep the kernel's own parameters in step with the values used here
+    this->setKernelParameter(0, xFrac);
+    this->setKernelParameter(1, yFrac);
+
+    lsst::geom::Point2I const ctr = this->getCtr();
+    if (_colTapTable.ctr != ctr.getX()) {
+        _setTapTable(_colTapTable, this->getWidth(), ctr.getX());
+    }
+    if (_rowTapTable.ctr != ctr.getY()) {
+        _setTapTable(_rowTapTable, this->getHeight(), ctr.getY());
+    }
+
+    double const invN = 1.0 / static_cast<double>(getOrder());
+    double const colSum =
+            fillLanczosVector(colList, _colTapTable.sinPiKInvN, _colTapTable.cosPiKInvN, ctr.getX(), invN,
+                              xFrac);
+    double const rowSum =
+            fillLanczosVector(rowList, _rowTapTable.sinPiKInvN, _rowTapTable.cosPiKInvN, ctr.getY(), invN,
+                              yFrac);
+    return colSum * rowSum;
+}
+
 void LanczosWarpingKernel::setKernelParameter(unsigned int ind, double value) const {
     checkWarpingKernelParameter(this, ind, value);
     SeparableKernel::setKernelParameter(ind, value);
@@ -251,6 +336,68 @@ int warpExposure(DestExposureT &destExposure, SrcExposureT const &srcExposure, W
                      padValue);
 }
 
+template <typename DestExposureT, typename SrcExposureT>
+std::vector<std::shared_ptr<DestExposureT>> warpExposureBatch(
+        SrcExposureT const &srcExposure, std::vector<StampWarpRequest> const &requests,
+        WarpingControl const &control, typename DestExposureT::MaskedImageT::SinglePixel padValue) {
+    if (!srcExposure.hasWcs()) {
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError, "srcExposure has no Wcs");
+    }
+    for (auto const &request : requests) {
+        if (!request.wcs) {
+            throw LSST_EXCEPT(pexExcept::InvalidParameterError, "warp request has no Wcs");
+        }
+    }
+    std::vector<std::shared_ptr<DestExposureT>> stamps(requests.size());
+    if (requests.empty()) {
+        return stamps;
+    }
+
+    // Setup shared by every stamp; captured once instead of once per warpExposure call
+    auto const srcWcsPtr = srcExposure.getWcs();
+    auto const srcPhotoCalib = srcExposure.getPhotoCalib();
+    auto const srcFilter = srcExposure.getFilter();
+    auto const srcVisitInfo = srcExposure.getInfo()->getVisitInfo();
+    typename SrcExposureT::MaskedImageT const srcMaskedImage = srcExposure.getMaskedImage();
+
+    int const numThreads =
+            std::max(1, std::min(control.getNumThreads(), static_cast<int>(requests.size())));
+
+    std::atomic<std::size_t> nextRequest(0);
+    auto const worker = [&] {
+        // each worker owns private kernel clones; kernel evaluation sets parameters in place
+        WarpingControl stampControl(control);
+        stampControl.setNumThreads(1);
+        stampControl.setWarpMappingCache(nullptr);
+        stampControl.setWarpingKernel(*control.getWarpingKernel());
+        if (control.hasMaskWarpingKernel()) {
+            stampControl.setMaskWarpingKernel(*control.getMaskWarpingKernel());
+        }
+        for (std::size_t index = nextRequest++; index < requests.size(); index = nextRequest++) {
+            StampWarpRequest const &request = requests[index];
+            auto stamp = std::make_shared<DestExposureT>(request.bbox, request.wcs);
+            stamp->setPhotoCalib(srcPhotoCalib);
+            stamp->setFilter(srcFilter);
+            stamp->getInfo()->setVisitInfo(srcVisitInfo);
+            typename DestExposureT::MaskedImageT stampMaskedImage = stamp->getMaskedImage();
+            warpImage(stampMaskedImage, *request.wcs, srcMaskedImage, *srcWcsPtr, stampControl,
+                      padValue);
+            stamps[index] = std::move(stamp);
+        }
+    };
+
+    if (numThreads == 1) {
+        worker();
+    } else {
+        TaskPool::TaskGroup group;
+        for (int taskId = 0; taskId < numThreads; ++taskId) {
+            group.run(worker);
+        }
+        group.wait();
+    }
+    return stamps;
+}
+
 namespace {
 
 inline lsst::geom::Point2D computeSrcPos(
@@ -283,6 +430,8 @@ template <typename DestImageT, typename SrcImageT>
 int warpImage(DestImageT &destImage, geom::SkyWcs const &destWcs, SrcImageT const &srcImage,
               geom::SkyWcs const &srcWcs, WarpingControl const &control,
               typename DestImageT::SinglePixel padValue) {
+    // timed here rather than in the Transform overload, which the banded path re-enters
+    instrumentation::Timer timer(instrumentation::Metric::WARP_CALLS, instrumentation::Metric::WARP_NANOS);
     auto srcToDest = geom::makeWcsPairTransform(srcWcs, destWcs);
     return warpImage(destImage, srcImage, *srcToDest, control, padValue);
 }
@@ -310,6 +459,39 @@ int warpImage(DestImageT &destImage, SrcImageT const &srcImage,
         }
         return 0;
     }
+
+    if (control.getNumThreads() > 1 && destImage.getHeight() >= 2 * control.getNumThreads()) {
+        // Divide the destination image into horizontal bands and warp them concurrently,
+        // recursing into this function with a shallow view of each band. Each band gets a
+        // single-threaded copy of the control whose kernels are private clones, because
+        // evaluating a kernel sets its parameters in place.
+        int const numThreads = control.getNumThreads();
+        int const destWidth = destImage.getWidth();
+        int const destHeight = destImage.getHeight();
+        std::atomic<int> numGoodPixelsTotal(0);
+        TaskPool::TaskGroup group;
+        for (int band = 0; band < numThreads; ++band) {
+            int const beginRow = (band * destHeight) / numThreads;
+            int const endRow = ((band + 1) * destHeight) / numThreads;
+            group.run([&, beginRow, endRow] {
+                WarpingControl bandControl(control);
+                bandControl.setNumThreads(1);
+                // recording into a shared cache from concurrent bands would race
+                bandControl.setWarpMappingCache(nullptr);
+                bandControl.setWarpingKernel(*control.getWarpingKernel());
+                if (control.hasMaskWarpingKernel()) {
+                    bandControl.setMaskWarpingKernel(*control.getMaskWarpingKernel());
+                }
+                lsst::geom::Box2I const bandBBox(lsst::geom::Point2I(0, beginRow),
+                                                 lsst::geom::Extent2I(destWidth, endRow - beginRow));
+                DestImageT bandDestImage(destImage, bandBBox, image::LOCAL, false);
+                numGoodPixelsTotal += warpImage(bandDestImage, srcImage, srcToDest, bandControl, padValue);
+            });
+        }
+        group.wait();
+        return numGoodPixelsTotal;
+    }
+
     int interpLength = control.getInterpLength();
 
     std::shared_ptr<LanczosWarpingKernel const> const lanczosKernelPtr =
@@ -341,6 +523,29 @@ int warpImage(DestImageT &destImage, SrcImageT const &srcImage,
 
     detail::WarpAtOnePoint<DestImageT, SrcImageT> warpAtOnePoint(srcImage, control, padValue);
 
+    std::shared_ptr<WarpMappingCache> const mappingCachePtr = control.getWarpMappingCache();
+    if (mappingCachePtr && mappingCachePtr->matches(destImage.getBBox())) {
+        // Replay the recorded mapping: pure resampling, no transform evaluation.
+        LOGL_DEBUG("TRACE3.afw.math.warp", "Replaying cached warp mapping");
+        std::vector<lsst::geom::Point2D> const &srcPositions = mappingCachePtr->getSrcPositions();
+        std::vector<double> const &relativeAreas = mappingCachePtr->getRelativeAreas();
+        std::size_t index = 0;
+        for (int row = 0; row < destHeight; ++row) {
+            typename DestImageT::x_iterator destXIter = destImage.row_begin(row);
+            for (int col = 0; col < destWidth; ++col, ++destXIter, ++index) {
+                if (warpAtOnePoint(destXIter, srcPositions[index], relativeAreas[index],
+                                   typename image::detail::image_traits<DestImageT>::image_category())) {
+                    ++numGoodPixels;
+                }
+            }
+        }
+        return numGoodPixels;
+    }
+    bool const recordMapping = static_cast<bool>(mappingCachePtr);
+    if (recordMapping) {
+        mappingCachePtr->reset(destImage.getBBox());
+    }
+
     if (interpLength > 0) {
         // Use interpolation. Note that 1 produces the same result as no interpolation
         // but uses this code branch, thus providing an easy way to compare the two branches.
@@ -456,6 +661,10 @@ int warpImage(DestImageT &destImage, SrcImageT const &srcImage,
 
                         srcPosView[col] = srcPos;
 
+                        if (recordMapping) {
+                            mappingCachePtr->append(srcPos, relativeArea);
+                        }
+
                         if (warpAtOnePoint(
                                     destXIter, srcPos, relativeArea,
                                     typename image::detail::image_traits<DestImageT>::image_category())) {
@@ -492,6 +701,10 @@ int warpImage(DestImageT &destImage, SrcImageT const &srcImage,
                 double relativeArea =
                         computeRelativeArea(srcPos, prevSrcPosList[col], prevSrcPosList[col + 1]);
 
+                if (recordMapping) {
+                    mappingCachePtr->append(srcPos, relativeArea);
+                }
+
                 if (warpAtOnePoint(destXIter, srcPos, relativeArea,
                                    typename image::detail::image_traits<DestImageT>::image_category())) {
                     ++numGoodPixels;
@@ -503,6 +716,10 @@ int warpImage(DestImageT &destImage, SrcImageT const &srcImage,
         }  // for row
     }      // if interp
 
+    if (recordMapping) {
+        mappingCachePtr->markValid();
+    }
+
     return numGoodPixels;
 }
 
@@ -551,6 +768,78 @@ int warpCenteredImage(DestImageT &destImage, SrcImageT const &srcImage,
     return n;
 }
 
+template <typename PixelT>
+CoaddAccumulator<PixelT>::CoaddAccumulator(lsst::geom::Box2I const &bbox, image::MaskPixel badPixelMask)
+        : _bbox(bbox),
+          _badPixelMask(badPixelMask),
+          _sumValue(bbox),
+          _sumVariance(bbox),
+          _sumWeight(bbox),
+          _orMask(bbox),
+          _scratch(bbox) {}
+
+template <typename PixelT>
+int CoaddAccumulator<PixelT>::accumulate(MaskedImageT const &srcImage,
+                                         geom::TransformPoint2ToPoint2 const &srcToDest,
+                                         WarpingControl const &control, double weight) {
+    if (!(weight > 0)) {
+        std::ostringstream os;
+        os << "weight = " << weight << "; must be positive";
+        throw LSST_EXCEPT(pexExcept::InvalidParameterError, os.str());
+    }
+    warpImage(_scratch, srcImage, srcToDest, control);
+
+    int numAccumulated = 0;
+    for (int y = 0, height = _bbox.getHeight(); y < height; ++y) {
+        typename MaskedImageT::const_x_iterator warpIter = _scratch.row_begin(y);
+        image::Image<double>::x_iterator sumValueIter = _sumValue.row_begin(y);
+        image::Image<double>::x_iterator sumVarianceIter = _sumVariance.row_begin(y);
+        image::Image<double>::x_iterator sumWeightIter = _sumWeight.row_begin(y);
+        image::Mask<image::MaskPixel>::x_iterator orMaskIter = _orMask.row_begin(y);
+        for (int x = 0, width = _bbox.getWidth(); x < width; ++x, ++warpIter, ++sumValueIter,
+                 ++sumVarianceIter, ++sumWeightIter, ++orMaskIter) {
+            double const value = warpIter.image();
+            // edge pixels are padded with non-finite values, so the finite test also rejects them
+            if ((warpIter.mask() & _badPixelMask) == 0 && std::isfinite(value)) {
+                *sumValueIter += weight * value;
+                *sumVarianceIter += weight * weight * warpIter.variance();
+                *sumWeightIter += weight;
+                *orMaskIter |= warpIter.mask();
+                ++numAccumulated;
+            }
+        }
+    }
+    return numAccumulated;
+}
+
+template <typename PixelT>
+typename CoaddAccumulator<PixelT>::MaskedImageT CoaddAccumulator<PixelT>::getCoadd() const {
+    MaskedImageT coadd(_bbox);
+    image::MaskPixel const noDataMask = image::Mask<image::MaskPixel>::getPlaneBitMask("NO_DATA");
+    for (int y = 0, height = _bbox.getHeight(); y < height; ++y) {
+        typename MaskedImageT::x_iterator coaddIter = coadd.row_begin(y);
+        image::Image<double>::const_x_iterator sumValueIter = _sumValue.row_begin(y);
+        image::Image<double>::const_x_iterator sumVarianceIter = _sumVariance.row_begin(y);
+        image::Image<double>::const_x_iterator sumWeightIter = _sumWeight.row_begin(y);
+        image::Mask<image::MaskPixel>::const_x_iterator orMaskIter = _orMask.row_begin(y);
+        for (int x = 0, width = _bbox.getWidth(); x < width; ++x, ++coaddIter, ++sumValueIter,
+                 ++sumVarianceIter, ++sumWeightIter, ++orMaskIter) {
+            double const sumWeight = *sumWeightIter;
+            if (sumWeight > 0) {
+                coaddIter.image() = static_cast<PixelT>(*sumValueIter / sumWeight);
+                coaddIter.variance() =
+                        static_cast<image::VariancePixel>(*sumVarianceIter / (sumWeight * sumWeight));
+                coaddIter.mask() = *orMaskIter;
+            } else {
+                coaddIter.image() = std::numeric_limits<PixelT>::quiet_NaN();
+                coaddIter.variance() = std::numeric_limits<image::VariancePixel>::infinity();
+                coaddIter.mask() = noDataMask;
+            }
+        }
+    }
+    return coadd;
+}
+
 //
 // Explicit instantiations
 //
@@ -586,7 +875,10 @@ int warpCenteredImage(DestImageT &destImage, SrcImageT const &srcImage,
                               MASKEDIMAGE(DESTIMAGEPIXELT)::SinglePixel padValue);                           \
     NL template int warpExposure(EXPOSURE(DESTIMAGEPIXELT) & destExposure,                                   \
                                  EXPOSURE(SRCIMAGEPIXELT) const &srcExposure, WarpingControl const &control, \
-                                 EXPOSURE(DESTIMAGEPIXELT)::MaskedImageT::SinglePixel padValue);
+                                 EXPOSURE(DESTIMAGEPIXELT)::MaskedImageT::SinglePixel padValue);             \
+    NL template std::vector<std::shared_ptr<EXPOSURE(DESTIMAGEPIXELT)>> warpExposureBatch(                   \
+            EXPOSURE(SRCIMAGEPIXELT) const &srcExposure, std::vector<StampWarpRequest> const &requests,      \
+            WarpingControl const &control, EXPOSURE(DESTIMAGEPIXELT)::MaskedImageT::SinglePixel padValue);
 
 INSTANTIATE(double, double)
 INSTANTIATE(double, float)
@@ -597,6 +889,9 @@ INSTANTIATE(float, int)
 INSTANTIATE(float, std::uint16_t)
 INSTANTIATE(int, int)
 INSTANTIATE(std::uint16_t, std::uint16_t)
+
+template class CoaddAccumulator<float>;
+template class CoaddAccumulator<double>;
 /// @endcond
 }  // namespace math
 }  // namespace afw
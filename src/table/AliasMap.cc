@@ -64,9 +64,31 @@ void AliasMap::_apply(std::string& name) const {
                       (boost::format("Cycle detected in schema aliases involving name '%s'") % name).str());
 }
 
+AliasMap& AliasMap::operator=(AliasMap const& other) {
+    if (this != &other) {
+        _internal = other._internal;
+        _table = other._table;
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        _cache.clear();
+    }
+    return *this;
+}
+
 std::string AliasMap::apply(std::string const& name) const {
+    if (_internal.empty()) {
+        return name;
+    }
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        auto cached = _cache.find(name);
+        if (cached != _cache.end()) {
+            return cached->second;
+        }
+    }
     std::string result(name);
     _apply(result);
+    std::lock_guard<std::mutex> lock(_cacheMutex);
+    _cache.insert(std::make_pair(name, result));
     return result;
 }
 
@@ -81,6 +103,10 @@ std::string AliasMap::get(std::string const& name) const {
 
 void AliasMap::set(std::string const& alias, std::string const& target) {
     _internal[alias] = target;
+    {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        _cache.clear();
+    }
     if (_table) {
         _table->handleAliasChange(alias);
     }
@@ -88,6 +114,10 @@ void AliasMap::set(std::string const& alias, std::string const& target) {
 
 bool AliasMap::erase(std::string const& alias) {
     bool result = _internal.erase(alias);
+    if (result) {
+        std::lock_guard<std::mutex> lock(_cacheMutex);
+        _cache.clear();
+    }
     if (_table) {
         _table->handleAliasChange(alias);
     }
@@ -133,6 +133,70 @@ BitsColumn BaseColumnView::getBits(std::vector<Key<Flag> > const &keys) const {
 
 namespace {
 
+// Pack one flag column into bits, 64 records per word: record i -> bit (i % 64) of word (i / 64).
+// The inner loop is a strided load, a test, and a shift with no branches, which the compiler can
+// unroll and vectorize; bits past the last record are left zero.
+void packFlagWords(Field<Flag>::Element const *elements, std::size_t stride, Field<Flag>::Element mask,
+                   std::size_t n, std::uint64_t *words) {
+    std::fill(words, words + (n + 63) / 64, std::uint64_t(0));
+    for (std::size_t i = 0; i < n; ++i) {
+        words[i >> 6] |= std::uint64_t((elements[i * stride] & mask) != 0) << (i & 63);
+    }
+}
+
+}  // namespace
+
+ndarray::Array<std::uint64_t, 1, 1> BaseColumnView::packBits(Key<Flag> const &key) const {
+    if (!key.isValid()) {
+        throw LSST_EXCEPT(
+            pex::exceptions::LogicError,
+            "Key is not valid (if this is a SourceCatalog, make sure slot aliases have been set up).");
+    }
+    std::size_t const n = _impl->recordCount;
+    ndarray::Array<std::uint64_t, 1, 1> result = ndarray::allocate((n + 63) / 64);
+    packFlagWords(reinterpret_cast<Field<Flag>::Element const *>(reinterpret_cast<char *>(_impl->buf) +
+                                                                 key.getOffset()),
+                  _impl->table->getSchema().getRecordSize() / sizeof(Field<Flag>::Element),
+                  Field<Flag>::Element(1) << key.getBit(), n, result.getData());
+    return result;
+}
+
+ndarray::Array<std::size_t, 1, 1> BaseColumnView::selectRecords(
+        std::vector<Key<Flag> > const &mustBeSet, std::vector<Key<Flag> > const &mustBeClear) const {
+    std::size_t const n = _impl->recordCount;
+    std::size_t const nWords = (n + 63) / 64;
+    std::vector<std::uint64_t> accepted(nWords, ~std::uint64_t(0));
+    auto apply = [&](Key<Flag> const &key, bool wanted) {
+        ndarray::Array<std::uint64_t, 1, 1> packed = packBits(key);
+        for (std::size_t j = 0; j < nWords; ++j) {
+            accepted[j] &= wanted ? packed[j] : ~packed[j];
+        }
+    };
+    for (Key<Flag> const &key : mustBeSet) apply(key, true);
+    for (Key<Flag> const &key : mustBeClear) apply(key, false);
+    if (nWords > 0 && (n & 63) != 0) {
+        accepted.back() &= (std::uint64_t(1) << (n & 63)) - 1;  // mask off the bits past the last record
+    }
+    std::vector<std::size_t> indices;
+    for (std::size_t j = 0; j < nWords; ++j) {
+        std::uint64_t const word = accepted[j];
+        if (word == 0) continue;  // reject 64 records at a time; the common case in flag cuts
+        std::size_t const base = j << 6;
+        if (word == ~std::uint64_t(0)) {
+            for (std::size_t b = 0; b != 64; ++b) indices.push_back(base + b);
+        } else {
+            for (std::size_t b = 0; b != 64; ++b) {
+                if ((word >> b) & 1) indices.push_back(base + b);
+            }
+        }
+    }
+    ndarray::Array<std::size_t, 1, 1> result = ndarray::allocate(indices.size());
+    std::copy(indices.begin(), indices.end(), result.getData());
+    return result;
+}
+
+namespace {
+
 struct ExtractFlagItems {
     template <typename T>
     void operator()(SchemaItem<T> const &) const {}
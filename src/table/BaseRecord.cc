@@ -1,5 +1,6 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
 #include <cstring>
 #include <iostream>
 
@@ -121,10 +122,24 @@ private:
 }  // namespace
 
 void BaseRecord::assign(BaseRecord const& other) {
-    if (this->getSchema() != other.getSchema()) {
+    Schema const schema = this->getSchema();
+    // Schema::compare short-circuits on shared SchemaImpls, so the common bulk-copy case
+    // (records from the same table, e.g. catalog concatenation) is O(1) per record; only
+    // genuinely distinct schemas pay for the full key-by-key comparison.  A fingerprint
+    // check is not sound here: a hash collision would turn the exception into a memcpy
+    // of mismatched layouts.
+    if (!schema.compare(other.getSchema(), Schema::EQUAL_KEYS)) {
         throw LSST_EXCEPT(lsst::pex::exceptions::LogicError, "Unequal schemas in record assignment.");
     }
-    this->getSchema().forEach(CopyValue(&other, this));
+    if (this->_data != other._data) {
+        if (schema.isRawCopyable()) {
+            // No variable-length fields, so the record is a flat block of plain data (Flag
+            // fields are bit-packed integers) and can be copied in one go.
+            std::memcpy(this->_data, other._data, schema.getRecordSize());
+        } else {
+            schema.forEach(CopyValue(&other, this));
+        }
+    }
     this->_assign(other);  // let derived classes assign their own stuff
 }
 
@@ -137,8 +152,17 @@ void BaseRecord::assign(BaseRecord const& other, SchemaMapper const& mapper) {
         throw LSST_EXCEPT(lsst::pex::exceptions::LogicError,
                           "Unequal schemas between output record and mapper.");
     }
-    mapper.forEach(CopyValue(&other, this));  // use the functor we defined above
-    this->_assign(other);                     // let derived classes assign their own stuff
+    // The mapper's copy plan turns runs of contiguously-mapped fixed-size fields into raw
+    // memcpy ranges; only Flag and variable-length fields go through the per-key functor.
+    detail::CopyPlan const& plan = mapper.getCopyPlan();
+    char const* inputData = reinterpret_cast<char const*>(other._data);
+    char* outputData = reinterpret_cast<char*>(this->_data);
+    for (detail::CopyPlan::Chunk const& chunk : plan.chunks) {
+        std::memcpy(outputData + chunk.outputOffset, inputData + chunk.inputOffset, chunk.size);
+    }
+    detail::SchemaMapperImpl::VisitorWrapper<CopyValue> copyExceptional{CopyValue(&other, this)};
+    std::for_each(plan.exceptional.begin(), plan.exceptional.end(), copyExceptional);
+    this->_assign(other);  // let derived classes assign their own stuff
 }
 
 BaseRecord::BaseRecord(ConstructionToken const &, detail::RecordData && data) :
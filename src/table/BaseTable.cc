@@ -1,9 +1,11 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
 #include <memory>
 
 #include "boost/shared_ptr.hpp"  // only for ndarray
 
+#include "lsst/afw/instrumentation.h"
 #include "lsst/afw/table/BaseColumnView.h"
 #include "lsst/afw/table/BaseRecord.h"
 #include "lsst/afw/table/BaseTable.h"
@@ -11,6 +13,7 @@
 #include "lsst/afw/table/SchemaMapper.h"
 #include "lsst/afw/table/io/FitsWriter.h"
 #include "lsst/afw/table/detail/Access.h"
+#include "lsst/afw/table/detail/RecordArena.h"
 
 namespace lsst {
 namespace afw {
@@ -97,6 +100,8 @@ private:
               _end(_next + recordSize * recordCount) {
         assert((recordSize * recordCount) % sizeof(AllocType) == 0);
         std::fill(_next, _end, 0);  // initialize to zero; we'll later initialize floats to NaN.
+        instrumentation::add(instrumentation::Metric::TABLE_BLOCK_ALLOCATIONS);
+        instrumentation::add(instrumentation::Metric::TABLE_BLOCK_BYTES, recordSize * recordCount);
     }
 
     std::unique_ptr<AllocType[]> _mem;
@@ -110,6 +115,23 @@ private:
 
 void BaseTable::preallocate(std::size_t n) { Block::preallocate(_schema.getRecordSize(), n, _manager); }
 
+std::vector<std::shared_ptr<BaseRecord>> BaseTable::makeRecords(std::size_t n) {
+    std::vector<std::shared_ptr<BaseRecord>> records;
+    records.reserve(n);
+    if (!_recordArena) {
+        // Pool the record objects themselves, too; slabs are recycled as batches of records
+        // come and go, so repeated bulk creation stops touching the global allocator.
+        _recordArena = std::make_shared<detail::RecordArena>(std::max<std::size_t>(n, nRecordsPerBlock));
+    }
+    // preallocate guarantees one block with room for all n records, and sequential _makeRecord
+    // calls then bump through it in order, so the field data ends up contiguous.
+    preallocate(n);
+    for (std::size_t i = 0; i < n; ++i) {
+        records.push_back(_makeRecord());
+    }
+    return records;
+}
+
 std::size_t BaseTable::getBufferSize() const {
     if (_manager) {
         return Block::getBufferSize(_schema.getRecordSize(), _manager);
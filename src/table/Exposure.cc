@@ -254,10 +254,13 @@ void ExposureFitsWriter::_writeRecord(BaseRecord const &r) {
 template <typename T, void (ExposureRecord::*Setter)(std::shared_ptr<T const>)>
 class PersistableObjectColumnReader : public io::FitsColumnReader {
 public:
-    static void setup(std::string const &name, io::FitsSchemaInputMapper &mapper) {
+    // Associate a column reader with the column called name, if present.  When skip is set the
+    // column is simply dropped instead, so the component is never fetched from the archive and
+    // is left unset on the records.
+    static void setup(std::string const &name, io::FitsSchemaInputMapper &mapper, bool const skip = false) {
         auto item = mapper.find(name);
         if (item) {
-            if (mapper.hasArchive()) {
+            if (!skip && mapper.hasArchive()) {
                 std::unique_ptr<io::FitsColumnReader> reader(new PersistableObjectColumnReader(item->column));
                 mapper.customize(std::move(reader));
             }
@@ -295,32 +298,34 @@ public:
         // we happen to know there are no ExposureCatalogs sitting on disk with with versions
         // older than what this routine supports.
         auto tableVersion = getTableVersion(*metadata);
-        PersistableObjectColumnReader<detection::Psf, &ExposureRecord::setPsf>::setup("psf", mapper);
-        PersistableObjectColumnReader<geom::SkyWcs, &ExposureRecord::setWcs>::setup("wcs", mapper);
-        PersistableObjectColumnReader<image::ApCorrMap, &ExposureRecord::setApCorrMap>::setup("apCorrMap",
-                                                                                              mapper);
+        PersistableObjectColumnReader<detection::Psf, &ExposureRecord::setPsf>::setup(
+                "psf", mapper, ioFlags & EXPOSURE_IO_NO_PSF);
+        PersistableObjectColumnReader<geom::SkyWcs, &ExposureRecord::setWcs>::setup(
+                "wcs", mapper, ioFlags & EXPOSURE_IO_NO_WCS);
+        PersistableObjectColumnReader<image::ApCorrMap, &ExposureRecord::setApCorrMap>::setup(
+                "apCorrMap", mapper, ioFlags & EXPOSURE_IO_NO_APCORRMAP);
         PersistableObjectColumnReader<geom::polygon::Polygon, &ExposureRecord::setValidPolygon>::setup(
-                "validPolygon", mapper);
+                "validPolygon", mapper, ioFlags & EXPOSURE_IO_NO_VALID_POLYGON);
         if (tableVersion > 1) {
-            PersistableObjectColumnReader<image::VisitInfo, &ExposureRecord::setVisitInfo>::setup("visitInfo",
-                                                                                                  mapper);
+            PersistableObjectColumnReader<image::VisitInfo, &ExposureRecord::setVisitInfo>::setup(
+                    "visitInfo", mapper, ioFlags & EXPOSURE_IO_NO_VISIT_INFO);
         }
         if (tableVersion > 2) {
             PersistableObjectColumnReader<image::TransmissionCurve,
-                                          &ExposureRecord::setTransmissionCurve>::setup("transmissionCurve",
-                                                                                        mapper);
+                                          &ExposureRecord::setTransmissionCurve>::setup(
+                    "transmissionCurve", mapper, ioFlags & EXPOSURE_IO_NO_TRANSMISSION_CURVE);
         }
         if (tableVersion > 3) {
             PersistableObjectColumnReader<cameraGeom::Detector, &ExposureRecord::setDetector>::setup(
-                    "detector", mapper);
+                    "detector", mapper, ioFlags & EXPOSURE_IO_NO_DETECTOR);
         }
         // Load the PhotoCalib from the `calib` table prior to version 5.
         if (tableVersion <= 4) {
-            PersistableObjectColumnReader<image::PhotoCalib, &ExposureRecord::setPhotoCalib>::setup("calib",
-                                                                                                    mapper);
+            PersistableObjectColumnReader<image::PhotoCalib, &ExposureRecord::setPhotoCalib>::setup(
+                    "calib", mapper, ioFlags & EXPOSURE_IO_NO_PHOTOCALIB);
         } else {
             PersistableObjectColumnReader<image::PhotoCalib, &ExposureRecord::setPhotoCalib>::setup(
-                    "photoCalib", mapper);
+                    "photoCalib", mapper, ioFlags & EXPOSURE_IO_NO_PHOTOCALIB);
         }
 
         auto schema = mapper.finalize();
@@ -329,7 +334,11 @@ public:
         return table;
     }
 
-    bool usesArchive(int ioFlags) const override { return true; }
+    bool usesArchive(int ioFlags) const override {
+        // When every component is skipped there is nothing to fetch, so don't even read the
+        // archive HDUs.
+        return (ioFlags & EXPOSURE_IO_NO_COMPONENTS) != EXPOSURE_IO_NO_COMPONENTS;
+    }
 };
 
 static ExposureFitsReader const exposureFitsReader;
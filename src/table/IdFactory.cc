@@ -1,3 +1,4 @@
+#include <atomic>
 #include <memory>
 #include "boost/format.hpp"
 
@@ -65,6 +66,56 @@ private:
     RecordId _lower;
 };
 
+// Same ID sequence as SourceIdFactory, but with an atomic counter so operator() may be
+// called concurrently.
+class AtomicSourceIdFactory : public IdFactory {
+public:
+    RecordId operator()() override {
+        RecordId const lower = ++_lower;
+        if (lower & _upperMask) {
+            --_lower;
+            throw LSST_EXCEPT(pex::exceptions::LengthError,
+                              (boost::format("Next ID '%s' is too large for the number of reserved bits") %
+                               lower)
+                                      .str());
+        }
+        return _upper | lower;
+    }
+
+    void notify(RecordId id) override {
+        RecordId newLower = id & (~_upper);  // chop off the exact exposure ID
+        if (newLower & _upperMask) {
+            throw LSST_EXCEPT(
+                    pex::exceptions::InvalidParameterError,
+                    (boost::format("Explicit ID '%s' does not have the correct form.") % newLower).str());
+        }
+        _lower.store(newLower);
+    }
+
+    std::shared_ptr<IdFactory> clone() const override {
+        // std::atomic is not copyable, so we cannot rely on the implicit copy constructor.
+        return std::shared_ptr<IdFactory>(new AtomicSourceIdFactory(*this));
+    }
+
+    AtomicSourceIdFactory(RecordId expId, int reserved)
+            : _upper(expId << reserved),
+              _upperMask(std::numeric_limits<RecordId>::max() << reserved),
+              _lower(0) {
+        if (_upper >> reserved != expId) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                              (boost::format("Exposure ID '%s' is too large.") % expId).str());
+        }
+    }
+
+private:
+    AtomicSourceIdFactory(AtomicSourceIdFactory const &other)
+            : _upper(other._upper), _upperMask(other._upperMask), _lower(other._lower.load()) {}
+
+    RecordId const _upper;
+    RecordId const _upperMask;
+    std::atomic<RecordId> _lower;
+};
+
 }  // namespace
 
 std::shared_ptr<IdFactory> IdFactory::makeSimple() { return std::make_shared<SimpleIdFactory>(); }
@@ -72,6 +123,37 @@ std::shared_ptr<IdFactory> IdFactory::makeSimple() { return std::make_shared<Sim
 std::shared_ptr<IdFactory> IdFactory::makeSource(RecordId expId, int reserved) {
     return std::make_shared<SourceIdFactory>(expId, reserved);
 }
+
+std::shared_ptr<IdFactory> IdFactory::makeSourceThreadSafe(RecordId expId, int reserved) {
+    return std::make_shared<AtomicSourceIdFactory>(expId, reserved);
+}
+
+std::vector<std::shared_ptr<IdFactory>> IdFactory::makeSourceShards(RecordId expId, int reserved,
+                                                                    int nShards) {
+    if (nShards < 1) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Number of shards '%d' must be positive.") % nShards).str());
+    }
+    int shardBits = 0;
+    while ((RecordId(1) << shardBits) < static_cast<RecordId>(nShards)) {
+        ++shardBits;
+    }
+    if (shardBits >= reserved) {
+        throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                          (boost::format("Cannot split %d reserved bits into %d shards; "
+                                         "no sequence bits would remain.") %
+                           reserved % nShards)
+                                  .str());
+    }
+    // Each shard is an ordinary SourceIdFactory whose packed "exposure ID" is the true
+    // exposure ID with the shard index appended, so the shards' sequence blocks are disjoint.
+    std::vector<std::shared_ptr<IdFactory>> result;
+    result.reserve(nShards);
+    for (int i = 0; i < nShards; ++i) {
+        result.push_back(makeSource((expId << shardBits) | i, reserved - shardBits));
+    }
+    return result;
+}
 }  // namespace table
 }  // namespace afw
 }  // namespace lsst
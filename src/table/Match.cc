@@ -24,7 +24,10 @@
 
 #include <algorithm>
 #include <cmath>
+#include <exception>
+#include <limits>
 #include <memory>
+#include <thread>
 
 #include "lsst/pex/exceptions.h"
 #include "lsst/log/Log.h"
@@ -69,8 +72,8 @@ struct CmpRecordPtr {
  *                         RecordPos instances
  * @returns                 The number of sources with positions not containing a NaN.
  */
-template <typename Cat>
-size_t makeRecordPositions(Cat const &cat, RecordPos<typename Cat::Record> *positions) {
+template <typename Cat, typename Pos>
+size_t makeRecordPositions(Cat const &cat, Pos *positions) {
     size_t n = 0;
     Key<lsst::geom::Angle> raKey = Cat::Table::getCoordKey().getRa();
     Key<lsst::geom::Angle> decKey = Cat::Table::getCoordKey().getDec();
@@ -88,7 +91,7 @@ size_t makeRecordPositions(Cat const &cat, RecordPos<typename Cat::Record> *posi
         positions[n].src = i;
         ++n;
     }
-    std::sort(positions, positions + n);
+    std::sort(positions, positions + n, [](Pos const &a, Pos const &b) { return a.dec < b.dec; });
     if (n < cat.size()) {
         LOGLS_WARN("afw.table.matchRaDec", "At least one source had ra or dec equal to NaN");
     }
@@ -141,8 +144,146 @@ lsst::geom::Angle fromUnitSphereDistanceSquared(double d2) noexcept {
     return 2.0 * std::asin(0.5 * std::sqrt(d2)) * lsst::geom::radians;
 }
 
+/**
+ * @internal Run func(begin, end, out) over numThreads contiguous bands of [0, n) and concatenate
+ * the per-band outputs onto `matches` in band order.
+ *
+ * Because every matcher in this file emits a given first-catalog record's matches consecutively
+ * and independently of other records, banding the (sorted) first catalog and concatenating in
+ * order reproduces the serial output exactly.
+ */
+template <typename MatchT, typename Func>
+void runBanded(std::vector<MatchT> &matches, size_t n, int numThreads, Func func) {
+    if (numThreads > int(n)) {
+        numThreads = int(n);
+    }
+    if (numThreads <= 1) {
+        func(size_t(0), n, matches);
+        return;
+    }
+    std::vector<std::vector<MatchT>> results(numThreads);
+    std::vector<std::thread> threads;
+    std::vector<std::exception_ptr> exceptions(numThreads);
+    threads.reserve(numThreads);
+    for (int t = 0; t < numThreads; ++t) {
+        size_t const begin = std::size_t(t) * n / numThreads;
+        size_t const end = std::size_t(t + 1) * n / numThreads;
+        threads.emplace_back([&func, &results, &exceptions, t, begin, end]() {
+            try {
+                func(begin, end, results[t]);
+            } catch (...) {
+                exceptions[t] = std::current_exception();
+            }
+        });
+    }
+    for (auto &thread : threads) {
+        thread.join();
+    }
+    for (auto const &exception : exceptions) {
+        if (exception) {
+            std::rethrow_exception(exception);
+        }
+    }
+    for (auto &result : results) {
+        matches.insert(matches.end(), std::make_move_iterator(result.begin()),
+                       std::make_move_iterator(result.end()));
+    }
+}
+
 }  // namespace
 
+template <typename Cat>
+MatchIndex<Cat>::MatchIndex(Cat const &catalog) : _positions(catalog.size()) {
+    _positions.resize(makeRecordPositions(catalog, _positions.data()));
+}
+
+template <typename Cat>
+template <typename QueryCat>
+std::vector<Match<typename QueryCat::Record, typename Cat::Record>> MatchIndex<Cat>::match(
+        QueryCat const &query, lsst::geom::Angle radius, MatchControl const &mc, int numThreads) const {
+    typedef Match<typename QueryCat::Record, Record> MatchT;
+    std::vector<MatchT> matches;
+
+    if (radius < 0.0 || (radius > (45. * lsst::geom::degrees))) {
+        throw LSST_EXCEPT(pex::exceptions::RangeError, "match radius out of range (0 to 45 degrees)");
+    }
+    if (query.size() == 0 || _positions.empty()) {
+        return matches;
+    }
+    double const d2Limit = toUnitSphereDistanceSquared(radius);
+    double const radiusRadians = radius.asRadians();
+
+    typedef RecordPos<typename QueryCat::Record> QueryPos;
+    std::unique_ptr<QueryPos[]> queryPos(new QueryPos[query.size()]);
+    size_t const nQuery = makeRecordPositions(query, queryPos.get());
+
+    std::size_t const len2 = _positions.size();
+    // This is the inner loop of matchRaDec with the indexed catalog on the second side, except
+    // that the starting point in the (dec-sorted) index is found by binary search so that each
+    // band of query records is independent of the ones before it.
+    auto matchBand = [&](size_t qBegin, size_t qEnd, std::vector<MatchT> &out) {
+        if (qBegin == qEnd) {
+            return;
+        }
+        std::shared_ptr<Record> const nullRecord;
+        size_t start = std::lower_bound(_positions.begin(), _positions.end(),
+                                        queryPos[qBegin].dec - radiusRadians,
+                                        [](Position const &p, double dec) { return p.dec < dec; }) -
+                       _positions.begin();
+        for (size_t i = qBegin; i < qEnd; ++i) {
+            double minDec = queryPos[i].dec - radiusRadians;
+            while (start < len2 && _positions[start].dec < minDec) {
+                ++start;
+            }
+            if (start == len2) {
+                break;
+            }
+            double maxDec = queryPos[i].dec + radiusRadians;
+            size_t closestIndex = -1;    // Index of closest match (if any)
+            double d2Include = d2Limit;  // Squared distance for inclusion of match
+            bool found = false;          // Found anything?
+            size_t nMatches = 0;         // Number of matches
+            for (size_t j = start; j < len2 && _positions[j].dec <= maxDec; ++j) {
+                double dx = queryPos[i].x - _positions[j].x;
+                double dy = queryPos[i].y - _positions[j].y;
+                double dz = queryPos[i].z - _positions[j].z;
+                double d2 = dx * dx + dy * dy + dz * dz;
+                if (d2 < d2Include) {
+                    if (mc.findOnlyClosest) {
+                        d2Include = d2;
+                        closestIndex = j;
+                        found = true;
+                    } else {
+                        out.push_back(MatchT(queryPos[i].src, _positions[j].src,
+                                             fromUnitSphereDistanceSquared(d2)));
+                    }
+                    ++nMatches;
+                }
+            }
+            if (mc.includeMismatches && nMatches == 0) {
+                out.push_back(MatchT(queryPos[i].src, nullRecord, NAN));
+            }
+            if (mc.findOnlyClosest && found) {
+                out.push_back(MatchT(queryPos[i].src, _positions[closestIndex].src,
+                                     fromUnitSphereDistanceSquared(d2Include)));
+            }
+        }
+    };
+
+    runBanded(matches, nQuery, numThreads, matchBand);
+    return matches;
+}
+
+template class MatchIndex<SimpleCatalog>;
+template class MatchIndex<SourceCatalog>;
+
+template SimpleMatchVector MatchIndex<SimpleCatalog>::match(SimpleCatalog const &, lsst::geom::Angle,
+                                                            MatchControl const &, int) const;
+template ReferenceMatchVector MatchIndex<SourceCatalog>::match(SimpleCatalog const &, lsst::geom::Angle,
+                                                               MatchControl const &, int) const;
+template SourceMatchVector MatchIndex<SourceCatalog>::match(SourceCatalog const &, lsst::geom::Angle,
+                                                            MatchControl const &, int) const;
+
 template <typename Cat1, typename Cat2>
 std::vector<Match<typename Cat1::Record, typename Cat2::Record> > matchRaDec(Cat1 const &cat1,
                                                                              Cat2 const &cat2,
@@ -164,65 +305,10 @@ std::vector<Match<typename Cat1::Record, typename Cat2::Record> > matchRaDec(Cat
 
     if (doSelfMatchIfSame(matches, cat1, cat2, radius)) return matches;
 
-    if (radius < 0.0 || (radius > (45. * lsst::geom::degrees))) {
-        throw LSST_EXCEPT(pex::exceptions::RangeError, "match radius out of range (0 to 45 degrees)");
-    }
-    if (cat1.size() == 0 || cat2.size() == 0) {
-        return matches;
-    }
-    // setup match parameters
-    double const d2Limit = toUnitSphereDistanceSquared(radius);
-
-    // Build position lists
-    size_t len1 = cat1.size();
-    size_t len2 = cat2.size();
-
-    typedef RecordPos<typename Cat1::Record> Pos1;
-    typedef RecordPos<typename Cat2::Record> Pos2;
-    std::unique_ptr<Pos1[]> pos1(new Pos1[len1]);
-    std::unique_ptr<Pos2[]> pos2(new Pos2[len2]);
-    len1 = makeRecordPositions(cat1, pos1.get());
-    len2 = makeRecordPositions(cat2, pos2.get());
-    std::shared_ptr<typename Cat2::Record> nullRecord = std::shared_ptr<typename Cat2::Record>();
-
-    for (size_t i = 0, start = 0; i < len1; ++i) {
-        double minDec = pos1[i].dec - radius.asRadians();
-        while (start < len2 && pos2[start].dec < minDec) {
-            ++start;
-        }
-        if (start == len2) {
-            break;
-        }
-        double maxDec = pos1[i].dec + radius.asRadians();
-        size_t closestIndex = -1;    // Index of closest match (if any)
-        double d2Include = d2Limit;  // Squared distance for inclusion of match
-        bool found = false;          // Found anything?
-        size_t nMatches = 0;         // Number of matches
-        for (size_t j = start; j < len2 && pos2[j].dec <= maxDec; ++j) {
-            double dx = pos1[i].x - pos2[j].x;
-            double dy = pos1[i].y - pos2[j].y;
-            double dz = pos1[i].z - pos2[j].z;
-            double d2 = dx * dx + dy * dy + dz * dz;
-            if (d2 < d2Include) {
-                if (mc.findOnlyClosest) {
-                    d2Include = d2;
-                    closestIndex = j;
-                    found = true;
-                } else {
-                    matches.push_back(MatchT(pos1[i].src, pos2[j].src, fromUnitSphereDistanceSquared(d2)));
-                }
-                ++nMatches;
-            }
-        }
-        if (mc.includeMismatches && nMatches == 0) {
-            matches.push_back(MatchT(pos1[i].src, nullRecord, NAN));
-        }
-        if (mc.findOnlyClosest && found) {
-            matches.push_back(
-                    MatchT(pos1[i].src, pos2[closestIndex].src, fromUnitSphereDistanceSquared(d2Include)));
-        }
-    }
-    return matches;
+    // Delegate to MatchIndex, which implements the same declination sweep (and obeys
+    // mc.numThreads); building the index here is the same sorting work this function
+    // used to do for cat2 directly.
+    return MatchIndex<Cat2>(cat2).match(cat1, radius, mc, mc.numThreads);
 }
 
 #define LSST_MATCH_RADEC(RTYPE, C1, C2)                                         \
@@ -267,22 +353,26 @@ std::vector<Match<typename Cat::Record, typename Cat::Record> > matchRaDec(Cat c
     std::unique_ptr<Pos[]> pos(new Pos[len]);
     len = makeRecordPositions(cat, pos.get());
 
-    for (size_t i = 0; i < len; ++i) {
-        double maxDec = pos[i].dec + radius.asRadians();
-        for (size_t j = i + 1; j < len && pos[j].dec <= maxDec; ++j) {
-            double dx = pos[i].x - pos[j].x;
-            double dy = pos[i].y - pos[j].y;
-            double dz = pos[i].z - pos[j].z;
-            double d2 = dx * dx + dy * dy + dz * dz;
-            if (d2 < d2Limit) {
-                lsst::geom::Angle d = fromUnitSphereDistanceSquared(d2);
-                matches.push_back(MatchT(pos[i].src, pos[j].src, d));
-                if (mc.symmetricMatch) {
-                    matches.push_back(MatchT(pos[j].src, pos[i].src, d));
+    // Each record's pairs (j > i) are found independently, so the outer loop can be banded.
+    auto matchBand = [&](size_t iBegin, size_t iEnd, std::vector<MatchT> &out) {
+        for (size_t i = iBegin; i < iEnd; ++i) {
+            double maxDec = pos[i].dec + radius.asRadians();
+            for (size_t j = i + 1; j < len && pos[j].dec <= maxDec; ++j) {
+                double dx = pos[i].x - pos[j].x;
+                double dy = pos[i].y - pos[j].y;
+                double dz = pos[i].z - pos[j].z;
+                double d2 = dx * dx + dy * dy + dz * dz;
+                if (d2 < d2Limit) {
+                    lsst::geom::Angle d = fromUnitSphereDistanceSquared(d2);
+                    out.push_back(MatchT(pos[i].src, pos[j].src, d));
+                    if (mc.symmetricMatch) {
+                        out.push_back(MatchT(pos[j].src, pos[i].src, d));
+                    }
                 }
             }
         }
-    }
+    };
+    runBanded(matches, len, mc.numThreads, matchBand);
     return matches;
 }
 
@@ -339,44 +429,58 @@ SourceMatchVector matchXy(SourceCatalog const &cat1, SourceCatalog const &cat2,
     std::sort(pos2.get(), pos2.get() + len2, CmpRecordPtr());
 
     SourceMatchVector matches;
-    for (size_t i = 0, start = 0; i < len1; ++i) {
-        double y = pos1[i]->getY();
-        double minY = y - radius;
-        while (start < len2 && pos2[start]->getY() < minY) {
-            ++start;
-        }
-        if (start == len2) {
-            break;
+    // Band the y-sorted first catalog; each band finds its starting point in pos2 by binary
+    // search, so its output is independent of (and identical to) the serial sweep.
+    auto matchBand = [&](size_t iBegin, size_t iEnd, SourceMatchVector &out) {
+        if (iBegin == iEnd) {
+            return;
         }
-        double x = pos1[i]->getX();
-        double maxY = y + radius;
-        double y2;
-        size_t closestIndex = -1;  // Index of closest match (if any)
-        double r2Include = r2;     // Squared radius for inclusion of match
-        bool found = false;        // Found anything?
-        size_t nMatches = 0;       // Number of matches
-        for (size_t j = start; j < len2 && (y2 = pos2[j]->getY()) <= maxY; ++j) {
-            double dx = x - pos2[j]->getX();
-            double dy = y - y2;
-            double d2 = dx * dx + dy * dy;
-            if (d2 < r2Include) {
-                if (mc.findOnlyClosest) {
-                    r2Include = d2;
-                    closestIndex = j;
-                    found = true;
-                } else {
-                    matches.push_back(SourceMatch(pos1[i], pos2[j], std::sqrt(d2)));
+        size_t start = std::lower_bound(
+                               pos2.get(), pos2.get() + len2, pos1[iBegin]->getY() - radius,
+                               [](std::shared_ptr<SourceRecord> const &p, double y) {
+                                   return p->getY() < y;
+                               }) -
+                       pos2.get();
+        for (size_t i = iBegin; i < iEnd; ++i) {
+            double y = pos1[i]->getY();
+            double minY = y - radius;
+            while (start < len2 && pos2[start]->getY() < minY) {
+                ++start;
+            }
+            if (start == len2) {
+                break;
+            }
+            double x = pos1[i]->getX();
+            double maxY = y + radius;
+            double y2;
+            size_t closestIndex = -1;  // Index of closest match (if any)
+            double r2Include = r2;     // Squared radius for inclusion of match
+            bool found = false;        // Found anything?
+            size_t nMatches = 0;       // Number of matches
+            for (size_t j = start; j < len2 && (y2 = pos2[j]->getY()) <= maxY; ++j) {
+                double dx = x - pos2[j]->getX();
+                double dy = y - y2;
+                double d2 = dx * dx + dy * dy;
+                if (d2 < r2Include) {
+                    if (mc.findOnlyClosest) {
+                        r2Include = d2;
+                        closestIndex = j;
+                        found = true;
+                    } else {
+                        out.push_back(SourceMatch(pos1[i], pos2[j], std::sqrt(d2)));
+                    }
+                    ++nMatches;
                 }
-                ++nMatches;
+            }
+            if (mc.includeMismatches && nMatches == 0) {
+                out.push_back(SourceMatch(pos1[i], nullRecord, NAN));
+            }
+            if (mc.findOnlyClosest && found) {
+                out.push_back(SourceMatch(pos1[i], pos2[closestIndex], std::sqrt(r2Include)));
             }
         }
-        if (mc.includeMismatches && nMatches == 0) {
-            matches.push_back(SourceMatch(pos1[i], nullRecord, NAN));
-        }
-        if (mc.findOnlyClosest && found) {
-            matches.push_back(SourceMatch(pos1[i], pos2[closestIndex], std::sqrt(r2Include)));
-        }
-    }
+    };
+    runBanded(matches, len1, mc.numThreads, matchBand);
     return matches;
 }
 
@@ -407,24 +511,28 @@ SourceMatchVector matchXy(SourceCatalog const &cat, double radius, MatchControl
     std::sort(pos.get(), pos.get() + len, CmpRecordPtr());
 
     SourceMatchVector matches;
-    for (size_t i = 0; i < len; ++i) {
-        double x = pos[i]->getX();
-        double y = pos[i]->getY();
-        double maxY = y + radius;
-        double y2;
-        for (size_t j = i + 1; j < len && (y2 = pos[j]->getY()) <= maxY; ++j) {
-            double dx = x - pos[j]->getX();
-            double dy = y - y2;
-            double d2 = dx * dx + dy * dy;
-            if (d2 < r2) {
-                double d = std::sqrt(d2);
-                matches.push_back(SourceMatch(pos[i], pos[j], d));
-                if (mc.symmetricMatch) {
-                    matches.push_back(SourceMatch(pos[j], pos[i], d));
+    // Each record's pairs (j > i) are found independently, so the outer loop can be banded.
+    auto matchBand = [&](size_t iBegin, size_t iEnd, SourceMatchVector &out) {
+        for (size_t i = iBegin; i < iEnd; ++i) {
+            double x = pos[i]->getX();
+            double y = pos[i]->getY();
+            double maxY = y + radius;
+            double y2;
+            for (size_t j = i + 1; j < len && (y2 = pos[j]->getY()) <= maxY; ++j) {
+                double dx = x - pos[j]->getX();
+                double dy = y - y2;
+                double d2 = dx * dx + dy * dy;
+                if (d2 < r2) {
+                    double d = std::sqrt(d2);
+                    out.push_back(SourceMatch(pos[i], pos[j], d));
+                    if (mc.symmetricMatch) {
+                        out.push_back(SourceMatch(pos[j], pos[i], d));
+                    }
                 }
             }
         }
-    }
+    };
+    runBanded(matches, len, mc.numThreads, matchBand);
     return matches;
 }
 
@@ -490,6 +598,92 @@ template SimpleMatchVector unpackMatches(BaseCatalog const &, SimpleCatalog cons
 template ReferenceMatchVector unpackMatches(BaseCatalog const &, SimpleCatalog const &,
                                             SourceCatalog const &);
 template SourceMatchVector unpackMatches(BaseCatalog const &, SourceCatalog const &, SourceCatalog const &);
+
+namespace {
+
+// Unpack the match coords into contiguous arrays, so the trig kernels below run over plain
+// doubles (which the compiler can vectorize) instead of chasing record pointers.  Null records
+// (from MatchControl::includeMismatches) become NaNs, which propagate through the kernels.
+template <typename Record1, typename Record2>
+void extractMatchCoords(std::vector<Match<Record1, Record2> > const &matches, std::vector<double> &ra1,
+                        std::vector<double> &dec1, std::vector<double> &ra2, std::vector<double> &dec2) {
+    std::size_t const n = matches.size();
+    ra1.resize(n);
+    dec1.resize(n);
+    ra2.resize(n);
+    dec2.resize(n);
+    double const nan = std::numeric_limits<double>::quiet_NaN();
+    for (std::size_t i = 0; i < n; ++i) {
+        if (!matches[i].first || !matches[i].second) {
+            ra1[i] = dec1[i] = ra2[i] = dec2[i] = nan;
+            continue;
+        }
+        lsst::geom::SpherePoint const c1 = matches[i].first->getCoord();
+        lsst::geom::SpherePoint const c2 = matches[i].second->getCoord();
+        ra1[i] = c1.getLongitude().asRadians();
+        dec1[i] = c1.getLatitude().asRadians();
+        ra2[i] = c2.getLongitude().asRadians();
+        dec2[i] = c2.getLatitude().asRadians();
+    }
+}
+
+}  // namespace
+
+template <typename Record1, typename Record2>
+ndarray::Array<double, 1, 1> matchSeparations(std::vector<Match<Record1, Record2> > const &matches) {
+    std::vector<double> ra1, dec1, ra2, dec2;
+    extractMatchCoords(matches, ra1, dec1, ra2, dec2);
+    ndarray::Array<double, 1, 1> result = ndarray::allocate(matches.size());
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+        // haversine formula; well-conditioned for the small separations matches have
+        double const sinHalfDDec = std::sin(0.5 * (dec2[i] - dec1[i]));
+        double const sinHalfDRa = std::sin(0.5 * (ra2[i] - ra1[i]));
+        double const a =
+                sinHalfDDec * sinHalfDDec + std::cos(dec1[i]) * std::cos(dec2[i]) * sinHalfDRa * sinHalfDRa;
+        result[i] = 2.0 * std::asin(std::min(1.0, std::sqrt(a)));
+    }
+    return result;
+}
+
+template <typename Record1, typename Record2>
+ndarray::Array<double, 1, 1> matchPositionAngles(std::vector<Match<Record1, Record2> > const &matches) {
+    std::vector<double> ra1, dec1, ra2, dec2;
+    extractMatchCoords(matches, ra1, dec1, ra2, dec2);
+    ndarray::Array<double, 1, 1> result = ndarray::allocate(matches.size());
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+        double const dRa = ra2[i] - ra1[i];
+        double const y = std::sin(dRa) * std::cos(dec2[i]);
+        double const x = std::cos(dec1[i]) * std::sin(dec2[i]) -
+                         std::sin(dec1[i]) * std::cos(dec2[i]) * std::cos(dRa);
+        result[i] = std::atan2(y, x);
+    }
+    return result;
+}
+
+template <typename Record1, typename Record2>
+ndarray::Array<double, 2, 2> matchOffsets(std::vector<Match<Record1, Record2> > const &matches) {
+    std::vector<double> ra1, dec1, ra2, dec2;
+    extractMatchCoords(matches, ra1, dec1, ra2, dec2);
+    ndarray::Array<double, 2, 2> result = ndarray::allocate(matches.size(), 2);
+    for (std::size_t i = 0; i < matches.size(); ++i) {
+        double const dRa = std::remainder(ra2[i] - ra1[i], 2.0 * lsst::geom::PI);
+        result[i][0] = dRa * std::cos(dec1[i]);
+        result[i][1] = dec2[i] - dec1[i];
+    }
+    return result;
+}
+
+template ndarray::Array<double, 1, 1> matchSeparations(SimpleMatchVector const &);
+template ndarray::Array<double, 1, 1> matchSeparations(ReferenceMatchVector const &);
+template ndarray::Array<double, 1, 1> matchSeparations(SourceMatchVector const &);
+
+template ndarray::Array<double, 1, 1> matchPositionAngles(SimpleMatchVector const &);
+template ndarray::Array<double, 1, 1> matchPositionAngles(ReferenceMatchVector const &);
+template ndarray::Array<double, 1, 1> matchPositionAngles(SourceMatchVector const &);
+
+template ndarray::Array<double, 2, 2> matchOffsets(SimpleMatchVector const &);
+template ndarray::Array<double, 2, 2> matchOffsets(ReferenceMatchVector const &);
+template ndarray::Array<double, 2, 2> matchOffsets(SourceMatchVector const &);
 }  // namespace table
 }  // namespace afw
 }  // namespace lsst
@@ -200,20 +200,20 @@ struct ExtractItemByName : public boost::static_visitor<> {
 // Here's the driver for the find-by-name algorithm.
 template <typename T>
 SchemaItem<T> SchemaImpl::find(std::string const &name) const {
-    NameMap::const_iterator i = _names.lower_bound(name);
-    if (i != _names.end()) {
-        if (i->first == name) {
-            // got an exact match; we're done if it has the right type, and dead if it doesn't.
-            try {
-                return boost::get<SchemaItem<T> const>(_items[i->second]);
-            } catch (boost::bad_get &err) {
-                throw LSST_EXCEPT(lsst::pex::exceptions::TypeError,
-                                  (boost::format("Field '%s' does not have the given type.") % name).str());
-            }
+    HashNameMap::const_iterator h = _hashNames.find(name);
+    if (h != _hashNames.end()) {
+        // got an exact match; we're done if it has the right type, and dead if it doesn't.
+        try {
+            return boost::get<SchemaItem<T> const>(_items[h->second]);
+        } catch (boost::bad_get &err) {
+            throw LSST_EXCEPT(lsst::pex::exceptions::TypeError,
+                              (boost::format("Field '%s' does not have the given type.") % name).str());
         }
     }
     // We didn't get an exact match, but we might be searching for "a.x/a_x" and "a" might be a point field.
-    // Because the names are sorted, we know we overshot it, so we work backwards.
+    // Because the names in the sorted map are ordered, lower_bound overshoots any such
+    // field, so we work backwards.
+    NameMap::const_iterator i = _names.lower_bound(name);
     ExtractItemByName<T> extractor(name, getDelimiter());
     while (i != _names.begin()) {
         --i;
@@ -403,8 +403,11 @@ void SchemaImpl::replaceField(Key<T> const &key, Field<T> const &field) {
                               (boost::format("Incorrect key type '%s'.") % key).str());
         }
         j = _names.find(item->field.getName());
-        _names.insert(j, std::pair<std::string, int>(field.getName(), j->second));
+        int const index = j->second;
+        _names.insert(j, std::pair<std::string, int>(field.getName(), index));
         _names.erase(j);
+        _hashNames.erase(item->field.getName());
+        _hashNames.insert(std::pair<std::string, int>(field.getName(), index));
     }
     item->field = field;
 }
@@ -548,7 +551,9 @@ Key<Flag> SchemaImpl::addField(Field<Flag> const &field, bool doReplace) {
         ++_lastFlagBit;
         _flags.insert(std::pair<std::pair<int, int>, int>(
                 std::make_pair(item.key.getOffset(), item.key.getBit()), _items.size()));
+        _hashNames.insert(std::pair<std::string, int>(field.getName(), _items.size()));
         _items.push_back(item);
+        _updateCache();  // the key layout changed
         return item.key;
     }
 }
@@ -593,11 +598,54 @@ Key<T> SchemaImpl::addFieldImpl(int elementSize, int elementCount, Field<T> cons
         SchemaItem<T> item(detail::Access::makeKey(field, _recordSize), field);
         _recordSize += elementCount * elementSize;
         _offsets.insert(std::pair<int, int>(item.key.getOffset(), _items.size()));
+        _hashNames.insert(std::pair<std::string, int>(field.getName(), _items.size()));
         _items.push_back(item);
+        _updateCache();  // the key layout changed
         return item.key;
     }
 }
 
+namespace {
+
+// Visitor that accumulates the quantities cached by SchemaImpl::_updateCache: a hash over all
+// keys, and whether any field is variable-length (and hence unsafe to copy with a raw memcpy,
+// because variable-length fields hold ndarray or std::string objects in the record memory).
+struct CacheUpdateVisitor {
+    // Key's own hash covers only the offset and element count, so we fold in the field type
+    // string as well to distinguish different field types at the same offset.
+    template <typename T>
+    void operator()(SchemaItem<T> const &item) {
+        fingerprint = utils::hashCombine(fingerprint, Field<T>::getTypeString(), item.key);
+    }
+
+    template <typename T>
+    void operator()(SchemaItem<Array<T> > const &item) {
+        fingerprint = utils::hashCombine(fingerprint, Field<Array<T> >::getTypeString(), item.key);
+        if (item.key.isVariableLength()) rawCopyable = false;
+    }
+
+    void operator()(SchemaItem<std::string> const &item) {
+        fingerprint = utils::hashCombine(fingerprint, Field<std::string>::getTypeString(), item.key);
+        if (item.key.isVariableLength()) rawCopyable = false;
+    }
+
+    std::size_t fingerprint;
+    bool rawCopyable;
+};
+
+}  // namespace
+
+void SchemaImpl::_updateCache() {
+    // Arbitrary seed, deliberately different from the one in Schema::hash_value so the two
+    // hashes are not trivially equal; the record size and item count are folded in so schemas
+    // that differ only in layout padding or Flag packing are distinguished.
+    std::size_t seed = utils::hashCombine(37, _recordSize, _items.size());
+    CacheUpdateVisitor visitor = {seed, true};
+    std::for_each(_items.begin(), _items.end(), VisitorWrapper<CacheUpdateVisitor &>(visitor));
+    _fingerprint = visitor.fingerprint;
+    _rawCopyable = visitor.rawCopyable;
+}
+
 }  // namespace detail
 
 //-----------------------------------------------------------------------------------------------------------
@@ -654,9 +702,8 @@ std::set<std::string> Schema::getNames(bool topOnly) const { return _impl->getNa
 
 template <typename T>
 SchemaItem<T> Schema::find(std::string const &name) const {
-    std::string tmp(name);
-    _aliases->_apply(tmp);
-    return _impl->find<T>(tmp);
+    // go through apply() rather than _apply() so repeated lookups hit the alias cache
+    return _impl->find<T>(_aliases->apply(name));
 }
 
 template <typename T>
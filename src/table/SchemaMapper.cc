@@ -107,6 +107,46 @@ struct RemoveMinimalSchema {
     Schema minimal;
 };
 
+// SchemaMapper::forEach functor that sorts each key pair into a CopyPlan: fixed-size
+// fields become byte ranges (coalesced later), while Flag and variable-length fields
+// are set aside to be copied individually.
+struct CopyPlanBuilder {
+    template <typename T>
+    void operator()(Key<T> const &inputKey, Key<T> const &outputKey) const {
+        addChunk(inputKey, outputKey);
+    }
+
+    template <typename T>
+    void operator()(Key<Array<T> > const &inputKey, Key<Array<T> > const &outputKey) const {
+        if (inputKey.isVariableLength() || outputKey.isVariableLength()) {
+            plan->exceptional.push_back(std::make_pair(inputKey, outputKey));
+        } else {
+            addChunk(inputKey, outputKey);
+        }
+    }
+
+    void operator()(Key<std::string> const &inputKey, Key<std::string> const &outputKey) const {
+        if (inputKey.isVariableLength() || outputKey.isVariableLength()) {
+            plan->exceptional.push_back(std::make_pair(inputKey, outputKey));
+        } else {
+            addChunk(inputKey, outputKey);
+        }
+    }
+
+    void operator()(Key<Flag> const &inputKey, Key<Flag> const &outputKey) const {
+        plan->exceptional.push_back(std::make_pair(inputKey, outputKey));
+    }
+
+    template <typename T>
+    void addChunk(Key<T> const &inputKey, Key<T> const &outputKey) const {
+        int const size = inputKey.getElementCount() * sizeof(typename Field<T>::Element);
+        plan->chunks.push_back(
+                detail::CopyPlan::Chunk{inputKey.getOffset(), outputKey.getOffset(), size});
+    }
+
+    detail::CopyPlan *plan;
+};
+
 }  // namespace
 
 SchemaMapper::SchemaMapper() : _impl(new Impl(Schema(), Schema())) {}
@@ -135,6 +175,7 @@ SchemaMapper::~SchemaMapper() = default;
 
 template <typename T>
 Key<T> SchemaMapper::addMapping(Key<T> const &inputKey, bool doReplace) {
+    _impl->_copyPlan.reset();
     typename Impl::KeyPairMap::iterator i =
             std::find_if(_impl->_map.begin(), _impl->_map.end(), KeyPairCompareEqual<T>(inputKey));
     Field<T> inputField = _impl->_input.find(inputKey).field;
@@ -151,6 +192,7 @@ Key<T> SchemaMapper::addMapping(Key<T> const &inputKey, bool doReplace) {
 
 template <typename T>
 Key<T> SchemaMapper::addMapping(Key<T> const &inputKey, Field<T> const &field, bool doReplace) {
+    _impl->_copyPlan.reset();
     typename Impl::KeyPairMap::iterator i =
             std::find_if(_impl->_map.begin(), _impl->_map.end(), KeyPairCompareEqual<T>(inputKey));
     if (i != _impl->_map.end()) {
@@ -166,6 +208,7 @@ Key<T> SchemaMapper::addMapping(Key<T> const &inputKey, Field<T> const &field, b
 
 template <typename T>
 Key<T> SchemaMapper::addMapping(Key<T> const &inputKey, std::string const &outputName, bool doReplace) {
+    _impl->_copyPlan.reset();
     typename Impl::KeyPairMap::iterator i =
             std::find_if(_impl->_map.begin(), _impl->_map.end(), KeyPairCompareEqual<T>(inputKey));
     if (i != _impl->_map.end()) {
@@ -200,6 +243,7 @@ SchemaMapper SchemaMapper::removeMinimalSchema(Schema const &input, Schema const
 }
 
 void SchemaMapper::invert() {
+    _impl->_copyPlan.reset();
     std::swap(_impl->_input, _impl->_output);
     std::for_each(_impl->_map.begin(), _impl->_map.end(), SwapKeyPair());
 }
@@ -219,6 +263,33 @@ Key<T> SchemaMapper::getMapping(Key<T> const &inputKey) const {
     return boost::get<std::pair<Key<T>, Key<T> > >(*i).second;
 }
 
+detail::CopyPlan const &SchemaMapper::getCopyPlan() const {
+    if (!_impl->_copyPlan) {
+        std::shared_ptr<detail::CopyPlan> plan = std::make_shared<detail::CopyPlan>();
+        CopyPlanBuilder builder = {plan.get()};
+        forEach(builder);
+        // Coalesce ranges that are adjacent in both the input and output records, so a
+        // run of contiguously-mapped fields becomes a single memcpy.
+        std::sort(plan->chunks.begin(), plan->chunks.end(),
+                  [](detail::CopyPlan::Chunk const &a, detail::CopyPlan::Chunk const &b) {
+                      return a.inputOffset < b.inputOffset;
+                  });
+        std::vector<detail::CopyPlan::Chunk> merged;
+        merged.reserve(plan->chunks.size());
+        for (detail::CopyPlan::Chunk const &chunk : plan->chunks) {
+            if (!merged.empty() && merged.back().inputOffset + merged.back().size == chunk.inputOffset &&
+                merged.back().outputOffset + merged.back().size == chunk.outputOffset) {
+                merged.back().size += chunk.size;
+            } else {
+                merged.push_back(chunk);
+            }
+        }
+        plan->chunks.swap(merged);
+        _impl->_copyPlan = std::move(plan);
+    }
+    return *_impl->_copyPlan;
+}
+
 std::vector<SchemaMapper> SchemaMapper::join(std::vector<Schema> const &inputs,
                                              std::vector<std::string> const &prefixes) {
     std::size_t const size = inputs.size();
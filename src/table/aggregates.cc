@@ -21,10 +21,13 @@
  * see <http://www.lsstcorp.org/LegalNotices/>.
  */
 
+#include <cmath>
+
 #include "lsst/afw/geom/ellipses/Quadrupole.h"
 #include "lsst/geom/Box.h"
 #include "lsst/afw/table/aggregates.h"
 #include "lsst/afw/table/BaseRecord.h"
+#include "lsst/afw/table/BaseColumnView.h"
 
 namespace lsst {
 namespace afw {
@@ -51,6 +54,30 @@ void PointKey<T>::set(BaseRecord &record, lsst::geom::Point<T, 2> const &value)
     record.set(_y, value.getY());
 }
 
+template <typename T>
+std::pair<ndarray::Array<T, 1>, ndarray::Array<T, 1>> PointKey<T>::getArrays(
+        BaseColumnView const &columns) const {
+    ndarray::Array<T, 1> x = columns[_x];
+    ndarray::Array<T, 1> y = columns[_y];
+    return std::make_pair(x, y);
+}
+
+template <typename T>
+void PointKey<T>::setArrays(BaseColumnView const &columns, ndarray::Array<T const, 1> const &x,
+                            ndarray::Array<T const, 1> const &y) const {
+    ndarray::Array<T, 1> xColumn = columns[_x];
+    ndarray::Array<T, 1> yColumn = columns[_y];
+    std::size_t const nRecords = xColumn.template getSize<0>();
+    if (x.template getSize<0>() != nRecords || y.template getSize<0>() != nRecords) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Array sizes (%d, %d) do not match catalog size %d") %
+                           x.template getSize<0>() % y.template getSize<0>() % nRecords)
+                                  .str());
+    }
+    xColumn.deep() = x;
+    yColumn.deep() = y;
+}
+
 template class PointKey<int>;
 template class PointKey<double>;
 
@@ -95,6 +122,58 @@ void CoordKey::set(BaseRecord &record, lsst::geom::SpherePoint const &value) con
     record.set(_dec, value.getLatitude());
 }
 
+std::pair<ndarray::Array<lsst::geom::Angle, 1>, ndarray::Array<lsst::geom::Angle, 1>> CoordKey::getArrays(
+        BaseColumnView const &columns) const {
+    ndarray::Array<lsst::geom::Angle, 1> ra = columns[_ra];
+    ndarray::Array<lsst::geom::Angle, 1> dec = columns[_dec];
+    return std::make_pair(ra, dec);
+}
+
+ndarray::Array<double, 2, 2> CoordKey::getUnitVectors(BaseColumnView const &columns) const {
+    ndarray::Array<lsst::geom::Angle, 1> raColumn = columns[_ra];
+    ndarray::Array<lsst::geom::Angle, 1> decColumn = columns[_dec];
+    std::size_t const nRecords = raColumn.getSize<0>();
+    ndarray::Array<double, 2, 2> vectors = ndarray::allocate(nRecords, std::size_t(3));
+    for (std::size_t i = 0; i < nRecords; ++i) {
+        double const ra = raColumn[i].asRadians();
+        double const dec = decColumn[i].asRadians();
+        double const cosDec = std::cos(dec);
+        vectors[i][0] = cosDec * std::cos(ra);
+        vectors[i][1] = cosDec * std::sin(ra);
+        vectors[i][2] = std::sin(dec);
+    }
+    return vectors;
+}
+
+void CoordKey::setUnitVectors(BaseColumnView const &columns,
+                              ndarray::Array<double const, 2> const &vectors) const {
+    ndarray::Array<lsst::geom::Angle, 1> raColumn = columns[_ra];
+    ndarray::Array<lsst::geom::Angle, 1> decColumn = columns[_dec];
+    std::size_t const nRecords = raColumn.getSize<0>();
+    if (vectors.getSize<0>() != nRecords || vectors.getSize<1>() != 3) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Array shape (%d, %d) does not match (%d, 3)") %
+                           vectors.getSize<0>() % vectors.getSize<1>() % nRecords)
+                                  .str());
+    }
+    for (std::size_t i = 0; i < nRecords; ++i) {
+        double const x = vectors[i][0];
+        double const y = vectors[i][1];
+        double const z = vectors[i][2];
+        double const norm = std::sqrt(x * x + y * y + z * z);
+        if (!(norm > 0.0)) {
+            throw LSST_EXCEPT(pex::exceptions::InvalidParameterError,
+                              (boost::format("Vector %d has zero norm") % i).str());
+        }
+        double ra = std::atan2(y, x);
+        if (ra < 0.0) {
+            ra += lsst::geom::TWOPI;
+        }
+        raColumn[i] = ra * lsst::geom::radians;
+        decColumn[i] = std::asin(z / norm) * lsst::geom::radians;
+    }
+}
+
 //============ QuadrupoleKey ================================================================================
 
 QuadrupoleKey QuadrupoleKey::addFields(Schema &schema, std::string const &name, std::string const &doc,
@@ -367,6 +446,73 @@ void CovarianceMatrixKey<T, N>::setElement(BaseRecord &record, int i, int j, T v
     }
 }
 
+template <typename T, int N>
+ndarray::Array<T, 1> CovarianceMatrixKey<T, N>::getElementArray(BaseColumnView const &columns, int i,
+                                                                int j) const {
+    if (i == j) {
+        ndarray::Array<T, 1> const err = columns[_err[i]];
+        std::size_t const nRecords = err.template getSize<0>();
+        ndarray::Array<T, 1> result = ndarray::allocate(nRecords);
+        for (std::size_t k = 0; k < nRecords; ++k) {
+            result[k] = err[k] * err[k];
+        }
+        return result;
+    }
+    Key<T> key;
+    if (!_cov.empty()) {
+        key = (i < j) ? _cov[j * (j - 1) / 2 + i] : _cov[i * (i - 1) / 2 + j];
+    }
+    if (key.isValid()) {
+        ndarray::Array<T, 1> result = ndarray::allocate(columns[key].template getSize<0>());
+        result.deep() = columns[key];
+        return result;
+    }
+    // No field for this element: it is implicitly zero, as in getElement.
+    ndarray::Array<T, 1> result = ndarray::allocate(columns[_err[0]].template getSize<0>());
+    result.deep() = static_cast<T>(0);
+    return result;
+}
+
+template <typename T, int N>
+void CovarianceMatrixKey<T, N>::setElementArray(BaseColumnView const &columns, int i, int j,
+                                                ndarray::Array<T const, 1> const &values) const {
+    if (i == j) {
+        ndarray::Array<T, 1> err = columns[_err[i]];
+        std::size_t const nRecords = err.template getSize<0>();
+        if (values.template getSize<0>() != nRecords) {
+            throw LSST_EXCEPT(pex::exceptions::LengthError,
+                              (boost::format("Array size %d does not match catalog size %d") %
+                               values.template getSize<0>() % nRecords)
+                                      .str());
+        }
+        for (std::size_t k = 0; k < nRecords; ++k) {
+            err[k] = std::sqrt(values[k]);
+        }
+        return;
+    }
+    if (_cov.empty()) {
+        throw LSST_EXCEPT(
+                pex::exceptions::LogicError,
+                (boost::format("Cannot set covariance element %d,%d; no fields for covariance") % i % j)
+                        .str());
+    }
+    Key<T> key = (i < j) ? _cov[j * (j - 1) / 2 + i] : _cov[i * (i - 1) / 2 + j];
+    if (!key.isValid()) {
+        throw LSST_EXCEPT(
+                pex::exceptions::LogicError,
+                (boost::format("Cannot set covariance element %d,%d; no field for this element") % i % j)
+                        .str());
+    }
+    ndarray::Array<T, 1> column = columns[key];
+    if (values.template getSize<0>() != column.template getSize<0>()) {
+        throw LSST_EXCEPT(pex::exceptions::LengthError,
+                          (boost::format("Array size %d does not match catalog size %d") %
+                           values.template getSize<0>() % column.template getSize<0>())
+                                  .str());
+    }
+    column.deep() = values;
+}
+
 template class CovarianceMatrixKey<float, 2>;
 template class CovarianceMatrixKey<float, 3>;
 template class CovarianceMatrixKey<float, 4>;
@@ -90,6 +90,9 @@ public:
     std::vector<std::unique_ptr<FitsColumnReader>> readers;
     std::vector<Key<Flag>> flagKeys;
     std::unique_ptr<bool[]> flagWorkspace;
+    std::unique_ptr<bool[]> flagCache;  // prepped block of flag values, flagKeys.size() per row
+    std::size_t flagCacheFirstRow = 0;
+    std::size_t flagCacheRows = 0;
     std::shared_ptr<io::InputArchive> archive;
     InputContainer inputs;
     std::size_t nRowsToPrep = 1;
@@ -310,7 +313,10 @@ bool FitsSchemaInputMapper::readArchive(afw::fits::Fits &fits) {
     if (_impl->archiveHdu < 0) _impl->archiveHdu = oldHdu + 1;
     try {
         fits.setHdu(_impl->archiveHdu);
-        _impl->archive.reset(new io::InputArchive(InputArchive::readFits(fits)));
+        // Read the index eagerly (validating that this HDU really is an archive) but
+        // defer the data catalogs until an object is actually fetched, so reads that
+        // never touch the archive (e.g. SOURCE_IO_NO_FOOTPRINTS) skip them entirely.
+        _impl->archive.reset(new io::InputArchive(InputArchive::readFitsLazy(fits)));
         fits.setHdu(oldHdu);
         return true;
     } catch (afw::fits::FitsError &) {
@@ -409,7 +415,6 @@ private:
     Key<T> _key;
     std::vector<typename FieldBase<T>::Element> _cache;
     std::size_t _cacheFirstRow;
-    std::size_t _nRowsToPrep;
 };
 
 class AngleReader : public FitsColumnReader {
@@ -469,19 +474,40 @@ public:
     StringReader(Schema &schema, FitsSchemaItem const &item, int size)
             : _column(item.column),
               _key(schema.addField<std::string>(item.ttype, item.doc, item.tunit, size)),
-              _isVariableLength(size == 0) {}
+              _isVariableLength(size == 0),
+              _cache(),
+              _cacheFirstRow(0) {}
+
+    void prepRead(std::size_t firstRow, std::size_t nRows, fits::Fits &fits) override {
+        // Variable-length strings live in the heap rather than the main table,
+        // so they cannot be read a block of rows at a time.
+        if (!_isVariableLength) {
+            _cache.resize(nRows);
+            _cacheFirstRow = firstRow;
+            fits.readTableStringArray(firstRow, _column, nRows, &_cache.front());
+        }
+    }
 
     void readCell(BaseRecord &record, std::size_t row, afw::fits::Fits &fits,
                   std::shared_ptr<InputArchive> const &archive) const override {
-        std::string s;
-        fits.readTableScalar(row, _column, s, _isVariableLength);
-        record.set(_key, s);
+        if (_cache.empty()) {
+            std::string s;
+            fits.readTableScalar(row, _column, s, _isVariableLength);
+            record.set(_key, s);
+        } else {
+            assert(row >= _cacheFirstRow);
+            std::size_t offset = row - _cacheFirstRow;
+            assert(offset < _cache.size());
+            record.set(_key, _cache[offset]);
+        }
     }
 
 private:
     int _column;
     Key<std::string> _key;
     bool _isVariableLength;
+    std::vector<std::string> _cache;
+    std::size_t _cacheFirstRow;
 };
 
 template <typename T>
@@ -878,20 +904,39 @@ Schema FitsSchemaInputMapper::finalize() {
 }
 
 void FitsSchemaInputMapper::readRecord(BaseRecord &record, afw::fits::Fits &fits, std::size_t row) {
-    if (!_impl->flagKeys.empty()) {
-        fits.readTableArray<bool>(row, _impl->flagColumn, _impl->flagKeys.size(), _impl->flagWorkspace.get());
-        for (std::size_t bit = 0; bit < _impl->flagKeys.size(); ++bit) {
-            record.set(_impl->flagKeys[bit], _impl->flagWorkspace[bit]);
-        }
-    }
     if (_impl->nRowsToPrep != 1 && row % _impl->nRowsToPrep == 0) {
         // Give readers a chance to read and cache up to nRowsToPrep rows-
         // worth of values.
         std::size_t size = std::min(_impl->nRowsToPrep, fits.countRows() - row);
+        if (!_impl->flagKeys.empty()) {
+            // Read the flag column for the whole block in one cfitsio call; bit-array
+            // reads continue across rows just like the other column types.
+            if (!_impl->flagCache) {
+                _impl->flagCache.reset(new bool[_impl->nRowsToPrep * _impl->flagKeys.size()]);
+            }
+            fits.readTableArray<bool>(row, _impl->flagColumn, size * _impl->flagKeys.size(),
+                                      _impl->flagCache.get());
+            _impl->flagCacheFirstRow = row;
+            _impl->flagCacheRows = size;
+        }
         for (auto & reader : _impl->readers) {
             reader->prepRead(row, size, fits);
         }
     }
+    if (!_impl->flagKeys.empty()) {
+        bool const *flags = nullptr;
+        if (_impl->flagCacheRows != 0 && row >= _impl->flagCacheFirstRow &&
+            row - _impl->flagCacheFirstRow < _impl->flagCacheRows) {
+            flags = _impl->flagCache.get() + (row - _impl->flagCacheFirstRow) * _impl->flagKeys.size();
+        } else {
+            fits.readTableArray<bool>(row, _impl->flagColumn, _impl->flagKeys.size(),
+                                      _impl->flagWorkspace.get());
+            flags = _impl->flagWorkspace.get();
+        }
+        for (std::size_t bit = 0; bit < _impl->flagKeys.size(); ++bit) {
+            record.set(_impl->flagKeys[bit], flags[bit]);
+        }
+    }
     for (auto const & reader : _impl->readers) {
         reader->readCell(record, row, fits, _impl->archive);
     }
@@ -1,6 +1,8 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
 #include <memory>
+#include <vector>
 
 #include "lsst/afw/table/io/FitsWriter.h"
 #include "lsst/afw/table/BaseTable.h"
@@ -130,14 +132,84 @@ void FitsWriter::_writeTable(std::shared_ptr<BaseTable const> const& table, std:
 // The driver code is at the bottom of this section; it's easier to understand if you start there
 // and work your way up.
 
+namespace {
+
+// Base class for buffers that stage a block of rows of one scalar column in memory
+// so the whole block can be written with a single cfitsio call at flush time.
+class ColumnBuffer {
+public:
+    explicit ColumnBuffer(int col) : _col(col) {}
+
+    virtual void append(BaseRecord const& record) = 0;
+    virtual void flush(Fits& fits, std::size_t firstRow) = 0;
+
+    virtual ~ColumnBuffer() = default;
+
+protected:
+    int _col;
+};
+
+template <typename T>
+class ScalarColumnBuffer : public ColumnBuffer {
+public:
+    ScalarColumnBuffer(int col, Key<T> const& key, std::size_t nRowsToBuffer)
+            : ColumnBuffer(col), _key(key) {
+        _data.reserve(nRowsToBuffer);
+    }
+
+    void append(BaseRecord const& record) override { _data.push_back(*record.getElement(_key)); }
+
+    void flush(Fits& fits, std::size_t firstRow) override {
+        if (!_data.empty()) {
+            fits.writeTableArray(firstRow, _col, static_cast<int>(_data.size()), _data.data());
+            _data.clear();
+        }
+    }
+
+private:
+    Key<T> _key;
+    std::vector<typename FieldBase<T>::Element> _data;
+};
+
+// A Schema::forEach functor that creates staging buffers for the scalar columns, with the
+// same column-numbering logic as ProcessSchema and ProcessRecords.  Array and string
+// columns are not staged: they are written row by row by ProcessRecords, matching the
+// restriction to scalar columns in the reader's prepRead caching.
+struct MakeColumnBuffers {
+    template <typename T>
+    void operator()(SchemaItem<T> const& item) const {
+        buffers->push_back(std::unique_ptr<ColumnBuffer>(
+                new ScalarColumnBuffer<T>(col, item.key, nRowsToBuffer)));
+        ++col;
+    }
+
+    template <typename T>
+    void operator()(SchemaItem<Array<T> > const& item) const {
+        ++col;  // written row by row
+    }
+
+    void operator()(SchemaItem<std::string> const& item) const {
+        ++col;  // written row by row
+    }
+
+    void operator()(SchemaItem<Flag> const& item) const {}  // flag bits share one column, staged separately
+
+    std::vector<std::unique_ptr<ColumnBuffer>>* buffers;
+    std::size_t nRowsToBuffer;
+    mutable int col;
+};
+
+}  // namespace
+
 // A Schema::forEach functor that writes table data for a single record when it is called.
 // We instantiate one of these, then reuse it on all the records after updating the data
-// members that tell it which record and row number it's on.
+// members that tell it which record and row number it's on.  Scalar columns and flag bits
+// are staged in per-column buffers and flushed a block of rows at a time; only array and
+// string columns are written to the file here.
 struct FitsWriter::ProcessRecords {
     template <typename T>
     void operator()(SchemaItem<T> const& item) const {
-        fits->writeTableArray(row, col, item.key.getElementCount(), record->getElement(item.key));
-        ++col;
+        ++col;  // staged in a ScalarColumnBuffer rather than written per record
     }
 
     template <typename T>
@@ -158,13 +230,25 @@ struct FitsWriter::ProcessRecords {
     }
 
     void operator()(SchemaItem<Flag> const& item) const {
-        flags[bit] = record->get(item.key);
+        flags[nBuffered * nFlags + bit] = record->get(item.key);
         ++bit;
     }
 
     ProcessRecords(Fits* fits_, Schema const& schema_, int nFlags_, std::size_t const& row_)
-            : row(row_), col(0), bit(0), nFlags(nFlags_), fits(fits_), schema(schema_) {
-        if (nFlags) flags.reset(new bool[nFlags]);
+            : row(row_),
+              col(0),
+              bit(0),
+              nFlags(nFlags_),
+              firstBufferedRow(0),
+              nBuffered(0),
+              nRowsToBuffer(std::max(FitsWriter::BUFFERED_ROWS_FACTOR /
+                                             static_cast<std::size_t>(std::max(schema_.getRecordSize(), 1)),
+                                     std::size_t(1))),
+              fits(fits_),
+              schema(schema_) {
+        if (nFlags) flags.reset(new bool[nFlags * nRowsToBuffer]);
+        MakeColumnBuffers f = {&buffers, nRowsToBuffer, nFlags ? 1 : 0};
+        schema.forEach(f);
     }
 
     void apply(BaseRecord const* r) {
@@ -172,24 +256,53 @@ struct FitsWriter::ProcessRecords {
         col = 0;
         bit = 0;
         if (nFlags) ++col;
+        if (nBuffered == 0) firstBufferedRow = row;
         schema.forEach(*this);
-        if (nFlags) fits->writeTableArray(row, 0, nFlags, flags.get());
+        for (auto const& buffer : buffers) {
+            buffer->append(*r);
+        }
+        ++nBuffered;
+        if (nBuffered == nRowsToBuffer) flush();
+    }
+
+    void flush() {
+        if (nBuffered == 0) return;
+        if (nFlags) {
+            // Bit-array writes continue across rows just like the other column types.
+            fits->writeTableArray(firstBufferedRow, 0, static_cast<int>(nFlags * nBuffered), flags.get());
+        }
+        for (auto const& buffer : buffers) {
+            buffer->flush(*fits, firstBufferedRow);
+        }
+        nBuffered = 0;
     }
 
     std::size_t const& row;
     mutable int col;
     mutable int bit;
     int nFlags;
+    std::size_t firstBufferedRow;
+    std::size_t nBuffered;
+    std::size_t nRowsToBuffer;
     Fits* fits;
     std::unique_ptr<bool[]> flags;
+    std::vector<std::unique_ptr<ColumnBuffer>> buffers;
     BaseRecord const* record;
     Schema schema;
 };
 
+std::size_t FitsWriter::BUFFERED_ROWS_FACTOR = 1 << 15;  // same heuristic as the reader; see DM-19461.
+
 void FitsWriter::_writeRecord(BaseRecord const& record) {
     ++_row;
     _processor->apply(&record);
 }
+
+void FitsWriter::_flushRecords() {
+    if (_processor) {
+        _processor->flush();
+    }
+}
 }  // namespace io
 }  // namespace table
 }  // namespace afw
@@ -1,6 +1,11 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
+#include <mutex>
+#include <unordered_map>
+
 #include "boost/format.hpp"
+#include "boost/functional/hash.hpp"
 
 #include "lsst/pex/exceptions.h"
 #include "lsst/afw/table/io/InputArchive.h"
@@ -31,6 +36,103 @@ struct IndexSortCompare {
     }
 };
 
+// Helpers for hashing and comparing catalog contents, used by readFitsShared
+// to identify archives that can be shared.  Hashing and comparison go through
+// the typed field accessors rather than raw bytes so that padding and
+// alignment differences between otherwise-identical catalogs don't matter.
+
+template <typename T>
+void hashFieldValue(std::size_t& seed, T const& value) {
+    boost::hash_combine(seed, value);
+}
+
+void hashFieldValue(std::size_t& seed, lsst::geom::Angle const& value) {
+    boost::hash_combine(seed, value.asRadians());
+}
+
+// Treat NaNs as equal so re-reads of the same file compare (and hence share);
+// NaNs with different payloads can only meet here after a hash match anyway.
+template <typename T>
+bool fieldValuesEqual(T const& a, T const& b) {
+    return a == b || (a != a && b != b);
+}
+
+// Functor for Schema::forEach that hashes one column of a catalog.
+struct HashCatalogField {
+    template <typename T>
+    void operator()(SchemaItem<T> const& item) const {
+        boost::hash_combine(*seed, item.field.getName());
+        for (auto const& record : *catalog) {
+            hashFieldValue(*seed, record.get(item.key));
+        }
+    }
+
+    template <typename U>
+    void operator()(SchemaItem<Array<U>> const& item) const {
+        boost::hash_combine(*seed, item.field.getName());
+        for (auto const& record : *catalog) {
+            auto value = record.get(item.key);
+            boost::hash_combine(*seed, value.size());
+            for (auto iter = value.begin(); iter != value.end(); ++iter) {
+                hashFieldValue(*seed, *iter);
+            }
+        }
+    }
+
+    BaseCatalog const* catalog;
+    std::size_t* seed;
+};
+
+std::size_t hashCatalog(BaseCatalog const& catalog, std::size_t seed = 0) {
+    boost::hash_combine(seed, catalog.size());
+    catalog.getSchema().forEach(HashCatalogField{&catalog, &seed});
+    return seed;
+}
+
+// Functor for Schema::forEach that compares one column of two catalogs.
+struct CompareCatalogField {
+    template <typename T>
+    void operator()(SchemaItem<T> const& item) const {
+        if (!*equal) return;
+        auto bIter = other->begin();
+        for (auto aIter = catalog->begin(); aIter != catalog->end(); ++aIter, ++bIter) {
+            if (!fieldValuesEqual(aIter->get(item.key), bIter->get(item.key))) {
+                *equal = false;
+                return;
+            }
+        }
+    }
+
+    template <typename U>
+    void operator()(SchemaItem<Array<U>> const& item) const {
+        if (!*equal) return;
+        auto bIter = other->begin();
+        for (auto aIter = catalog->begin(); aIter != catalog->end(); ++aIter, ++bIter) {
+            auto a = aIter->get(item.key);
+            auto b = bIter->get(item.key);
+            if (a.size() != b.size() ||
+                !std::equal(a.begin(), a.end(), b.begin(),
+                            [](U x, U y) { return fieldValuesEqual(x, y); })) {
+                *equal = false;
+                return;
+            }
+        }
+    }
+
+    BaseCatalog const* catalog;
+    BaseCatalog const* other;
+    bool* equal;
+};
+
+bool catalogsEqual(BaseCatalog const& a, BaseCatalog const& b) {
+    if (a.size() != b.size() || a.getSchema() != b.getSchema()) {
+        return false;
+    }
+    bool equal = true;
+    a.getSchema().forEach(CompareCatalogField{&a, &b, &equal});
+    return equal;
+}
+
 }  // namespace
 
 // ----- InputArchive::Impl ---------------------------------------------------------------------------------
@@ -82,7 +184,7 @@ public:
                              indexIter->get(indexKeys.id) % catN % _catalogs.size())
                                     .str());
                 }
-                BaseCatalog& fullCatalog = _catalogs[catN];
+                BaseCatalog& fullCatalog = getCatalog(catN);
                 std::size_t i1 = indexIter->get(indexKeys.row0);
                 std::size_t i2 = i1 + indexIter->get(indexKeys.nRows);
                 if (i2 > fullCatalog.size()) {
@@ -134,6 +236,54 @@ public:
         return _map;
     }
 
+    /// Hash of the full catalog contents, for use by readFitsShared.
+    std::size_t hashContents() const {
+        std::size_t seed = hashCatalog(_index);
+        boost::hash_combine(seed, _catalogs.size());
+        for (auto const& catalog : _catalogs) {
+            seed = hashCatalog(catalog, seed);
+        }
+        return seed;
+    }
+
+    /// Exact content comparison, guarding hashContents against collisions.
+    bool hasSameContents(Impl const& other) const {
+        if (_catalogs.size() != other._catalogs.size() || !catalogsEqual(_index, other._index)) {
+            return false;
+        }
+        for (std::size_t n = 0; n < _catalogs.size(); ++n) {
+            if (!catalogsEqual(_catalogs[n], other._catalogs[n])) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    /// Return the data catalog with the given (0-indexed) number, reading it first if
+    /// this is a lazily-read archive and the catalog has not been read yet.
+    BaseCatalog& getCatalog(std::size_t catN) {
+        if (!_catalogLoaded.empty() && !_catalogLoaded[catN]) {
+            fits::Fits fitsfile(_fileName, "r", fits::Fits::AUTO_CLOSE | fits::Fits::AUTO_CHECK);
+            fitsfile.setHdu(_firstDataHdu + catN);
+            BaseCatalog catalog = BaseCatalog::readFits(fitsfile);
+            std::shared_ptr<daf::base::PropertyList> metadata = catalog.getTable()->popMetadata();
+            if (metadata->get<std::string>("EXTTYPE") != "ARCHIVE_DATA") {
+                throw LSST_FITS_EXCEPT(fits::FitsError, fitsfile,
+                                       boost::format("Wrong value for archive data EXTTYPE: '%s'") %
+                                               metadata->get<std::string>("EXTTYPE"));
+            }
+            if (metadata->get<int>("AR_CATN") != static_cast<int>(catN + 1)) {
+                throw LSST_FITS_EXCEPT(
+                        fits::FitsError, fitsfile,
+                        boost::format("Incorrect archive catalog at HDU %d: AR_CATN=%d, expected %d") %
+                                (_firstDataHdu + catN) % metadata->get<int>("AR_CATN") % (catN + 1));
+            }
+            _catalogs[catN] = std::move(catalog);
+            _catalogLoaded[catN] = true;
+        }
+        return _catalogs[catN];
+    }
+
     Impl() : _index(ArchiveIndexSchema::get().schema) {}
 
     Impl(BaseCatalog const& index, CatalogVector const& catalogs) : _index(index), _catalogs(catalogs) {
@@ -144,6 +294,18 @@ public:
         _index.sort(IndexSortCompare());
     }
 
+    /// Construct a lazily-read archive: data catalogs are read from fileName on demand.
+    Impl(BaseCatalog const& index, std::string const& fileName, int firstDataHdu, std::size_t nCatalogs)
+            : _index(index), _fileName(fileName), _firstDataHdu(firstDataHdu) {
+        if (index.getSchema() != indexKeys.schema) {
+            throw LSST_EXCEPT(pex::exceptions::RuntimeError, "Incorrect schema for index catalog");
+        }
+        _map.insert(std::make_pair(0, std::shared_ptr<Persistable>()));
+        _index.sort(IndexSortCompare());
+        _catalogs.resize(nCatalogs);
+        _catalogLoaded.resize(nCatalogs, false);
+    }
+
     // No copying
     Impl(const Impl&) = delete;
     Impl& operator=(const Impl&) = delete;
@@ -155,6 +317,9 @@ public:
     Map _map;
     BaseCatalog _index;
     CatalogVector _catalogs;
+    std::vector<bool> _catalogLoaded;  // non-empty only for lazily-read archives
+    std::string _fileName;             // file to reopen for lazy catalog reads
+    int _firstDataHdu = 0;             // HDU of the first data catalog in a lazily-read archive
 };
 
 // ----- InputArchive ---------------------------------------------------------------------------------------
@@ -214,6 +379,55 @@ InputArchive InputArchive::readFits(fits::Fits& fitsfile) {
     std::shared_ptr<Impl> impl(new Impl(index, catalogs));
     return InputArchive(impl);
 }
+
+InputArchive InputArchive::readFitsLazy(fits::Fits& fitsfile) {
+    std::string fileName = fitsfile.getFileName();
+    if (fileName.empty()) {
+        // In-memory and other unnamed files cannot be reopened later; read eagerly.
+        return readFits(fitsfile);
+    }
+    BaseCatalog index = BaseCatalog::readFits(fitsfile);
+    std::shared_ptr<daf::base::PropertyList> metadata = index.getTable()->popMetadata();
+    assert(metadata);  // BaseCatalog::readFits should always read metadata, even if there's nothing there
+    if (metadata->get<std::string>("EXTTYPE") != "ARCHIVE_INDEX") {
+        throw LSST_FITS_EXCEPT(fits::FitsError, fitsfile,
+                               boost::format("Wrong value for archive index EXTTYPE: '%s'") %
+                                       metadata->get<std::string>("EXTTYPE"));
+    }
+    int nCatalogs = metadata->get<int>("AR_NCAT");
+    int firstDataHdu = fitsfile.getHdu() + 1;
+    if (nCatalogs > 1) {
+        // Leave the file positioned on the last data catalog HDU, as readFits would.
+        fitsfile.setHdu(nCatalogs - 1, true);
+    }
+    std::shared_ptr<Impl> impl(new Impl(index, fileName, firstDataHdu, nCatalogs - 1));
+    return InputArchive(impl);
+}
+
+InputArchive InputArchive::readFitsShared(fits::Fits& fitsfile) {
+    // Process-wide registry of live archives, keyed by content hash; weak
+    // pointers let archives be destroyed normally once all readers are done
+    // with them.
+    static std::mutex cacheMutex;
+    static std::unordered_multimap<std::size_t, std::weak_ptr<Impl>> cache;
+    InputArchive archive = readFits(fitsfile);
+    std::size_t const hash = archive._impl->hashContents();
+    std::lock_guard<std::mutex> lock(cacheMutex);
+    auto range = cache.equal_range(hash);
+    for (auto iter = range.first; iter != range.second;) {
+        std::shared_ptr<Impl> existing = iter->second.lock();
+        if (!existing) {
+            iter = cache.erase(iter);
+            continue;
+        }
+        if (existing->hasSameContents(*archive._impl)) {
+            return InputArchive(existing);
+        }
+        ++iter;
+    }
+    cache.emplace(hash, archive._impl);
+    return archive;
+}
 }  // namespace io
 }  // namespace table
 }  // namespace afw
@@ -1,11 +1,14 @@
 // -*- lsst-c++ -*-
 
+#include <algorithm>
 #include <typeinfo>
+#include <unordered_map>
 #include <vector>
 #include <map>
 #include <memory>
 
 #include "boost/format.hpp"
+#include "boost/functional/hash.hpp"
 
 #include "lsst/pex/exceptions.h"
 #include "lsst/afw/table/io/OutputArchive.h"
@@ -30,6 +33,72 @@ using Map = std::map<std::weak_ptr<Persistable const>, int,
 
 typedef Map::value_type MapItem;
 
+// Helpers for hashing and comparing the serialized form of a single record, used by the
+// optional content-based deduplication in put().  These mirror the catalog-level helpers
+// used by InputArchive::readFitsShared: hashing and comparison go through the typed field
+// accessors rather than raw bytes so padding never matters, and NaNs compare equal so
+// repeated saves of the same object match.
+
+template <typename T>
+void hashFieldValue(std::size_t& seed, T const& value) {
+    boost::hash_combine(seed, value);
+}
+
+void hashFieldValue(std::size_t& seed, lsst::geom::Angle const& value) {
+    boost::hash_combine(seed, value.asRadians());
+}
+
+template <typename T>
+bool fieldValuesEqual(T const& a, T const& b) {
+    return a == b || (a != a && b != b);
+}
+
+// Functor for Schema::forEach that hashes one field of a record.
+struct HashRecordField {
+    template <typename T>
+    void operator()(SchemaItem<T> const& item) const {
+        hashFieldValue(*seed, record->get(item.key));
+    }
+
+    template <typename U>
+    void operator()(SchemaItem<Array<U>> const& item) const {
+        auto value = record->get(item.key);
+        boost::hash_combine(*seed, value.size());
+        for (auto iter = value.begin(); iter != value.end(); ++iter) {
+            hashFieldValue(*seed, *iter);
+        }
+    }
+
+    BaseRecord const* record;
+    std::size_t* seed;
+};
+
+// Functor for Schema::forEach that compares one field of two records.
+struct CompareRecordField {
+    template <typename T>
+    void operator()(SchemaItem<T> const& item) const {
+        if (!*equal) return;
+        if (!fieldValuesEqual(a->get(item.key), b->get(item.key))) {
+            *equal = false;
+        }
+    }
+
+    template <typename U>
+    void operator()(SchemaItem<Array<U>> const& item) const {
+        if (!*equal) return;
+        auto x = a->get(item.key);
+        auto y = b->get(item.key);
+        if (x.size() != y.size() ||
+            !std::equal(x.begin(), x.end(), y.begin(), [](U p, U q) { return fieldValuesEqual(p, q); })) {
+            *equal = false;
+        }
+    }
+
+    BaseRecord const* a;
+    BaseRecord const* b;
+    bool* equal;
+};
+
 }  // namespace
 
 // ----- OutputArchive::Impl --------------------------------------------------------------------------------
@@ -104,6 +173,122 @@ public:
         iter->insert(iter->end(), catalog.begin(), catalog.end(), false);
     }
 
+    // Return the index records that describe the object with the given ID, in the
+    // order they were added.
+    std::vector<BaseCatalog::iterator> findIndexRecords(int id) {
+        std::vector<BaseCatalog::iterator> result;
+        for (BaseCatalog::iterator iter = _index.begin(); iter != _index.end(); ++iter) {
+            if (iter->get(indexKeys.id) == id) {
+                result.push_back(iter);
+            }
+        }
+        return result;
+    }
+
+    // Hash the serialized form of an object: its index entries (excluding id and row0,
+    // so identical content at different archive positions hashes the same) and the
+    // catalog rows those entries point to.
+    std::size_t hashObject(std::vector<BaseCatalog::iterator> const &indexRecords) {
+        std::size_t seed = 0;
+        boost::hash_combine(seed, indexRecords.size());
+        for (auto const &indexRecord : indexRecords) {
+            boost::hash_combine(seed, indexRecord->get(indexKeys.name));
+            boost::hash_combine(seed, indexRecord->get(indexKeys.module));
+            boost::hash_combine(seed, indexRecord->get(indexKeys.catArchive));
+            boost::hash_combine(seed, indexRecord->get(indexKeys.nRows));
+            int const catArchive = indexRecord->get(indexKeys.catArchive);
+            if (catArchive == ArchiveIndexSchema::NO_CATALOGS_SAVED) continue;
+            BaseCatalog const &catalog = _catalogs[catArchive - 1];
+            std::size_t const row0 = indexRecord->get(indexKeys.row0);
+            std::size_t const end = row0 + indexRecord->get(indexKeys.nRows);
+            for (std::size_t row = row0; row != end; ++row) {
+                catalog.getSchema().forEach(HashRecordField{&catalog[row], &seed});
+            }
+        }
+        return seed;
+    }
+
+    // Compare the serialized forms of two objects field by field.
+    bool objectsEqual(std::vector<BaseCatalog::iterator> const &a,
+                      std::vector<BaseCatalog::iterator> const &b) {
+        if (a.size() != b.size()) return false;
+        for (std::size_t i = 0; i != a.size(); ++i) {
+            BaseRecord const &aIndex = *a[i];
+            BaseRecord const &bIndex = *b[i];
+            if (aIndex.get(indexKeys.name) != bIndex.get(indexKeys.name) ||
+                aIndex.get(indexKeys.module) != bIndex.get(indexKeys.module) ||
+                aIndex.get(indexKeys.catArchive) != bIndex.get(indexKeys.catArchive) ||
+                aIndex.get(indexKeys.nRows) != bIndex.get(indexKeys.nRows)) {
+                return false;
+            }
+            int const catArchive = aIndex.get(indexKeys.catArchive);
+            if (catArchive == ArchiveIndexSchema::NO_CATALOGS_SAVED) continue;
+            BaseCatalog const &catalog = _catalogs[catArchive - 1];
+            std::size_t aRow = aIndex.get(indexKeys.row0);
+            std::size_t bRow = bIndex.get(indexKeys.row0);
+            std::size_t const nRows = aIndex.get(indexKeys.nRows);
+            for (std::size_t n = 0; n != nRows; ++n, ++aRow, ++bRow) {
+                bool equal = true;
+                catalog.getSchema().forEach(CompareRecordField{&catalog[aRow], &catalog[bRow], &equal});
+                if (!equal) return false;
+            }
+        }
+        return true;
+    }
+
+    // Remove an object's index entries and catalog rows, returning false (and removing
+    // nothing) unless they are all still at the very end of their catalogs.
+    bool removeObjectRows(std::vector<BaseCatalog::iterator> const &indexRecords) {
+        std::size_t const n = indexRecords.size();
+        if (n > _index.size()) return false;
+        for (std::size_t i = 0; i != n; ++i) {
+            if (indexRecords[i] != _index.begin() + (_index.size() - n + i)) return false;
+        }
+        // Walk the row ranges in reverse, checking that each one ends where the
+        // previous one (or the catalog itself) ends.
+        std::map<int, std::size_t> newSizes;
+        for (auto iter = indexRecords.rbegin(); iter != indexRecords.rend(); ++iter) {
+            int const catArchive = (*iter)->get(indexKeys.catArchive);
+            if (catArchive == ArchiveIndexSchema::NO_CATALOGS_SAVED) continue;
+            std::size_t const row0 = (*iter)->get(indexKeys.row0);
+            std::size_t const nRows = (*iter)->get(indexKeys.nRows);
+            auto newSize = newSizes.emplace(catArchive, _catalogs[catArchive - 1].size()).first;
+            if (row0 + nRows != newSize->second) return false;
+            newSize->second = row0;
+        }
+        for (auto const &newSize : newSizes) {
+            BaseCatalog &catalog = _catalogs[newSize.first - 1];
+            catalog.erase(catalog.begin() + newSize.second, catalog.end());
+        }
+        _index.erase(_index.begin() + (_index.size() - n), _index.end());
+        return true;
+    }
+
+    // Called after the object with the given ID has been written: look for a previously
+    // saved object with identical content and, if one is found, remove the just-written
+    // rows and return the existing ID.  Otherwise register the new object's content hash
+    // and return the given ID unchanged.
+    int deduplicate(int id) {
+        std::vector<BaseCatalog::iterator> const indexRecords = findIndexRecords(id);
+        std::size_t const hash = hashObject(indexRecords);
+        auto const range = _contentHashes.equal_range(hash);
+        for (auto iter = range.first; iter != range.second; ++iter) {
+            if (objectsEqual(findIndexRecords(iter->second), indexRecords)) {
+                // The new object's rows can only be removed if they are still at the
+                // end of the index and data catalogs; they always are when its nested
+                // objects were deduplicated too (a content match implies they were),
+                // but if a writer produced something stranger we keep the duplicate
+                // rather than corrupt the archive.
+                if (removeObjectRows(indexRecords)) {
+                    return iter->second;
+                }
+                break;
+            }
+        }
+        _contentHashes.insert(std::make_pair(hash, id));
+        return id;
+    }
+
     int put(Persistable const *obj, std::shared_ptr<Impl> const &self, bool permissive) {
         if (!obj) return 0;
         if (permissive && !obj->isPersistable()) return 0;
@@ -111,6 +296,9 @@ public:
         ++_nextId;
         OutputArchiveHandle handle(currentId, obj->getPersistenceName(), obj->getPythonModule(), self);
         obj->write(handle);
+        if (_deduplicate) {
+            return deduplicate(currentId);
+        }
         return currentId;
     }
 
@@ -120,8 +308,11 @@ public:
         MapItem item(obj, _nextId);
         std::pair<Map::iterator, bool> r = _map.insert(item);
         if (r.second) {
-            // We've never seen this object before.  Save it.
-            return put(obj.get(), self, permissive);
+            // We've never seen this object before.  Save it, updating the map entry
+            // in case content deduplication replaced the provisional ID.
+            int const id = put(obj.get(), self, permissive);
+            r.first->second = id;
+            return id;
         } else {
             // We had already saved this object, and insert returned an iterator
             // to the ID we used before; return that.
@@ -139,7 +330,7 @@ public:
         }
     }
 
-    Impl() : _nextId(1), _map(), _index(ArchiveIndexSchema::get().schema) {
+    Impl() : _nextId(1), _deduplicate(false), _map(), _index(ArchiveIndexSchema::get().schema) {
         std::shared_ptr<daf::base::PropertyList> metadata(new daf::base::PropertyList());
         metadata->set("EXTTYPE", "ARCHIVE_INDEX");
         metadata->set("AR_CATN", 0, "# of this catalog relative to the start of this archive");
@@ -147,7 +338,9 @@ public:
     }
 
     int _nextId;
+    bool _deduplicate;
     Map _map;
+    std::unordered_multimap<std::size_t, int> _contentHashes;
     BaseCatalog _index;
     CatalogVector _catalogs;
 };
@@ -185,6 +378,16 @@ int OutputArchive::put(std::shared_ptr<Persistable const> obj, bool permissive)
     return _impl->put(std::move(obj), _impl, permissive);
 }
 
+void OutputArchive::setContentDeduplication(bool deduplicate) {
+    if (!_impl.unique()) {  // copy on write
+        std::shared_ptr<Impl> tmp(new Impl(*_impl));
+        _impl.swap(tmp);
+    }
+    _impl->_deduplicate = deduplicate;
+}
+
+bool OutputArchive::getContentDeduplication() const { return _impl->_deduplicate; }
+
 BaseCatalog const &OutputArchive::getIndexCatalog() const { return _impl->_index; }
 
 BaseCatalog const &OutputArchive::getCatalog(int n) const {
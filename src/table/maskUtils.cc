@@ -0,0 +1,114 @@
+// -*- lsst-c++ -*-
+
+/*
+ * This file is part of afw.
+ *
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+#include "lsst/afw/detection/Footprint.h"
+#include "lsst/afw/table/Source.h"
+#include "lsst/afw/table/maskUtils.h"
+
+namespace lsst {
+namespace afw {
+namespace table {
+namespace {
+
+// Get the footprint from a record
+std::shared_ptr<detection::Footprint> getFootprint(SourceRecord const &record) {
+    return record.getFootprint();
+}
+
+// Get the footprint from a shared pointer to a record
+std::shared_ptr<detection::Footprint> getFootprint(std::shared_ptr<const SourceRecord> const record) {
+    return record->getFootprint();
+}
+
+// One footprint span tagged with the index of the source it belongs to
+struct TaggedSpan {
+    int y;
+    int x0;
+    int x1;
+    std::size_t index;
+};
+
+}  // namespace
+
+template <typename SourceCollection>
+ndarray::Array<image::MaskPixel, 1, 1> getFootprintMaskBits(image::Mask<image::MaskPixel> const &mask,
+                                                            SourceCollection const &sources) {
+    ndarray::Array<image::MaskPixel, 1, 1> result = ndarray::allocate(sources.size());
+    result.deep() = static_cast<image::MaskPixel>(0);
+    lsst::geom::Box2I const bbox = mask.getBBox();
+    // Gather all footprint spans, clipped to the mask, tagged with their source's index.
+    std::vector<TaggedSpan> spans;
+    std::size_t index = 0;
+    for (auto const &source : sources) {
+        auto const footprint = getFootprint(source);
+        if (footprint) {
+            for (auto const &span : *footprint->getSpans()) {
+                int const y = span.getY();
+                if (y < bbox.getMinY() || y > bbox.getMaxY()) {
+                    continue;
+                }
+                int const x0 = std::max(span.getX0(), bbox.getMinX());
+                int const x1 = std::min(span.getX1(), bbox.getMaxX());
+                if (x0 > x1) {
+                    continue;
+                }
+                spans.push_back(TaggedSpan{y, x0, x1, index});
+            }
+        }
+        ++index;
+    }
+    // Sort by row so the sweep below touches each mask row once, in memory order,
+    // no matter how the footprints overlap or how the catalog is ordered.
+    std::sort(spans.begin(), spans.end(), [](TaggedSpan const &a, TaggedSpan const &b) {
+        return (a.y < b.y) || (a.y == b.y && a.x0 < b.x0);
+    });
+    auto const array = mask.getArray();
+    int const xOffset = mask.getX0();
+    int const yOffset = mask.getY0();
+    for (auto const &span : spans) {
+        auto const row = array[span.y - yOffset];
+        image::MaskPixel bits = 0;
+        for (int x = span.x0 - xOffset; x <= span.x1 - xOffset; ++x) {
+            bits |= row[x];
+        }
+        result[span.index] |= bits;
+    }
+    return result;
+}
+
+/// @cond
+template ndarray::Array<image::MaskPixel, 1, 1> getFootprintMaskBits(
+        image::Mask<image::MaskPixel> const &, std::vector<std::shared_ptr<SourceRecord>> const &);
+template ndarray::Array<image::MaskPixel, 1, 1> getFootprintMaskBits(image::Mask<image::MaskPixel> const &,
+                                                                     SourceCatalog const &);
+/// @endcond
+
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
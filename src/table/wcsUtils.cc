@@ -25,6 +25,8 @@
 #include <memory>
 #include <vector>
 
+#include "ndarray.h"
+
 #include "lsst/pex/exceptions.h"
 #include "lsst/afw/table/fwd.h"
 #include "lsst/afw/table/aggregates.h"
@@ -78,17 +80,24 @@ void updateRefCentroids(geom::SkyWcs const &wcs, ReferenceCollection &refList) {
     CoordKey const coordKey(schema["coord"]);
     Point2DKey const centroidKey(schema["centroid"]);
     Key<Flag> const hasCentroidKey(schema["hasCentroid"]);
-    std::vector<lsst::geom::SpherePoint> skyList;
-    skyList.reserve(refList.size());
+    // Gather all coordinates into a single [axis][point] array and transform them with
+    // one call to the underlying mapping, so the AST frameset is crossed once for the
+    // whole collection instead of once per record.
+    int const nPoints = static_cast<int>(refList.size());
+    ndarray::Array<double, 2, 2> sky = ndarray::allocate(ndarray::makeVector(2, nPoints));
+    int i = 0;
     for (auto const &record : refList) {
-        skyList.emplace_back(getValue(record, coordKey));
+        auto const coord = getValue(record, coordKey);
+        sky[0][i] = coord.getRa().asRadians();
+        sky[1][i] = coord.getDec().asRadians();
+        ++i;
     }
-    std::vector<lsst::geom::Point2D> const pixelList = wcs.skyToPixel(skyList);
-    auto pixelPos = pixelList.cbegin();
+    auto const pixels = wcs.getTransform()->getMapping()->applyInverse(sky);
+    i = 0;
     for (auto &refObj : refList) {
-        setValue(refObj, centroidKey, *pixelPos);
+        setValue(refObj, centroidKey, lsst::geom::Point2D(pixels[0][i], pixels[1][i]));
         setValue(refObj, hasCentroidKey, true);
-        ++pixelPos;
+        ++i;
     }
 }
 
@@ -100,16 +109,22 @@ void updateSourceCoords(geom::SkyWcs const &wcs, SourceCollection &sourceList) {
     auto const schema = getSchema(sourceList[0]);
     Point2DKey const centroidKey(schema["slot_Centroid"]);
     CoordKey const coordKey(schema["coord"]);
-    std::vector<lsst::geom::Point2D> pixelList;
-    pixelList.reserve(sourceList.size());
+    // As in updateRefCentroids: one batched mapping call for the whole collection.
+    int const nPoints = static_cast<int>(sourceList.size());
+    ndarray::Array<double, 2, 2> pixels = ndarray::allocate(ndarray::makeVector(2, nPoints));
+    int i = 0;
     for (auto const &source : sourceList) {
-        pixelList.emplace_back(getValue(source, centroidKey));
+        auto const centroid = getValue(source, centroidKey);
+        pixels[0][i] = centroid.getX();
+        pixels[1][i] = centroid.getY();
+        ++i;
     }
-    std::vector<lsst::geom::SpherePoint> const skyList = wcs.pixelToSky(pixelList);
-    auto skyCoord = skyList.cbegin();
+    auto const sky = wcs.getTransform()->getMapping()->applyForward(pixels);
+    i = 0;
     for (auto &source : sourceList) {
-        setValue(source, coordKey, *skyCoord);
-        ++skyCoord;
+        setValue(source, coordKey, lsst::geom::SpherePoint(sky[0][i] * lsst::geom::radians,
+                                                           sky[1][i] * lsst::geom::radians));
+        ++i;
     }
 }
 
@@ -21,9 +21,11 @@
  */
 
 //  -*- lsst-c++ -*-
+#include <cstdint>
 #include <iostream>
 #include <string>
 #include <algorithm>
+#include <vector>
 
 #define BOOST_TEST_DYN_LINK
 #define BOOST_TEST_MODULE Image
@@ -35,6 +37,8 @@
 #include "boost/test/floating_point_comparison.hpp"
 
 #include "lsst/geom.h"
+#include "lsst/afw/image/ImageAlgorithm.h"
+#include "lsst/afw/image/ImageAllocator.h"
 #include "lsst/afw/image/LsstImageTypes.h"
 #include "lsst/afw/image/MaskedImage.h"
 
@@ -375,3 +379,188 @@ BOOST_AUTO_TEST_CASE(
         BOOST_CHECK_EQUAL(loc[below], 100);
     }
 }
+
+BOOST_AUTO_TEST_CASE(
+        imageAllocator) { /* parasoft-suppress  LsstDm-3-2a LsstDm-3-4a LsstDm-4-6 LsstDm-5-25 "Boost non-Std" */
+    // no allocator installed by default
+    BOOST_CHECK(!image::getCurrentImageAllocator());
+
+    auto arena = std::make_shared<image::ArenaImageAllocator>(4096);
+    {
+        image::ScopedImageAllocator guard(arena);
+        BOOST_CHECK(image::getCurrentImageAllocator() == arena);
+
+        // images built from the arena behave like any other image
+        ImageT img(lsst::geom::Extent2I(5, 6), 0);
+        img(3, 4) = 304;
+        BOOST_CHECK_EQUAL(img(0, 0), 0);
+        BOOST_CHECK_EQUAL(img(3, 4), 304);
+
+        // consecutive stamps come out of the same block, one padded request apart
+        ImageT stamp1(lsst::geom::Extent2I(4, 4), 1);
+        ImageT stamp2(lsst::geom::Extent2I(4, 4), 2);
+        std::size_t const alignment = alignof(std::max_align_t);
+        std::size_t const padded = (16 * sizeof(PixelT) + alignment - 1) / alignment * alignment;
+        BOOST_CHECK_EQUAL(&stamp2(0, 0) - &stamp1(0, 0),
+                          static_cast<std::ptrdiff_t>(padded / sizeof(PixelT)));
+        BOOST_CHECK_EQUAL(stamp1(3, 3), 1);
+        BOOST_CHECK_EQUAL(stamp2(0, 0), 2);
+
+        // requests larger than a block still succeed
+        ImageT big(lsst::geom::Extent2I(100, 100), 3);
+        BOOST_CHECK_EQUAL(big(99, 99), 3);
+
+        // guards nest
+        {
+            auto inner = std::make_shared<image::ArenaImageAllocator>();
+            image::ScopedImageAllocator innerGuard(inner);
+            BOOST_CHECK(image::getCurrentImageAllocator() == inner);
+        }
+        BOOST_CHECK(image::getCurrentImageAllocator() == arena);
+    }
+    BOOST_CHECK(!image::getCurrentImageAllocator());
+}
+
+BOOST_AUTO_TEST_CASE(
+        transformEachPixel) { /* parasoft-suppress  LsstDm-3-2a LsstDm-3-4a LsstDm-4-6 LsstDm-5-25 "Boost non-Std" */
+    ImageT img = make_image();
+    ImageT sky = make_image();
+    sky = 10;
+
+    // reference: three eager passes
+    ImageT ref(img, true);
+    ref -= sky;
+    ref *= 2;
+    ref += 3;
+
+    // the same arithmetic fused into one pass
+    image::transformEachPixel(img, sky,
+                              [](PixelT pix, PixelT skyPix) { return (pix - skyPix) * 2 + 3; });
+
+    for (int y = 0; y != img.getHeight(); ++y) {
+        for (ImageT::x_iterator ptr = img.row_begin(y), refPtr = ref.row_begin(y), end = img.row_end(y);
+             ptr != end; ++ptr, ++refPtr) {
+            BOOST_CHECK_EQUAL(*ptr, *refPtr);
+        }
+    }
+
+    // scalar-only form
+    ImageT img2 = make_image();
+    ImageT ref2(img2, true);
+    ref2 *= 4;
+    image::transformEachPixel(img2, [](PixelT pix) { return pix * 4; });
+    BOOST_CHECK_EQUAL(img2(3, 4), ref2(3, 4));
+
+    // shape mismatch is an error
+    ImageT small(lsst::geom::Extent2I(1, 1));
+    BOOST_CHECK_THROW(image::transformEachPixel(img, small, [](PixelT a, PixelT b) { return a + b; }),
+                      lsst::pex::exceptions::LengthError);
+}
+
+BOOST_AUTO_TEST_CASE(
+        imageRowAlignment) { /* parasoft-suppress  LsstDm-3-2a LsstDm-3-4a LsstDm-4-6 LsstDm-5-25 "Boost non-Std" */
+    std::size_t const alignment = 64;
+    image::ScopedImageRowAlignment guard(alignment);
+    BOOST_CHECK_EQUAL(image::getCurrentImageRowAlignment(), alignment);
+
+    ImageT img = make_image(5, 6);  // 5*sizeof(float) == 20 bytes/row, so rows get padded
+
+    // every row starts on an alignment boundary
+    for (int y = 0; y != img.getHeight(); ++y) {
+        BOOST_CHECK_EQUAL(reinterpret_cast<std::uintptr_t>(&img(0, y)) % alignment, std::size_t(0));
+    }
+    // the padding is not part of the image; it looks like a subimage
+    BOOST_CHECK(!img.isContiguous());
+    BOOST_CHECK_EQUAL(reinterpret_cast<char const*>(&img(0, 1)) - reinterpret_cast<char const*>(&img(0, 0)),
+                      static_cast<std::ptrdiff_t>(alignment));
+    BOOST_CHECK_EQUAL(img(3, 4), 304);
+
+    // getArray() picks up the padded stride
+    BOOST_CHECK_EQUAL(img.getArray().template getStride<0>(),
+                      static_cast<std::ptrdiff_t>(alignment / sizeof(PixelT)));
+
+    {
+        image::ScopedImageRowAlignment inner(16);
+        BOOST_CHECK_EQUAL(image::getCurrentImageRowAlignment(), std::size_t(16));
+    }
+    BOOST_CHECK_EQUAL(image::getCurrentImageRowAlignment(), alignment);
+
+    BOOST_CHECK_THROW(image::ScopedImageRowAlignment badGuard(48), lsst::pex::exceptions::InvalidParameterError);
+}
+
+BOOST_AUTO_TEST_CASE(
+        largeImageAllocation) { /* parasoft-suppress  LsstDm-3-2a LsstDm-3-4a LsstDm-4-6 LsstDm-5-25 "Boost non-Std" */
+    std::size_t const previous = image::getLargeImageAllocationThreshold();
+    BOOST_CHECK(previous > 0);  // enabled by default
+
+    // force even a small image through the dedicated-mapping path
+    image::setLargeImageAllocationThreshold(4096);
+    BOOST_CHECK_EQUAL(image::getLargeImageAllocationThreshold(), std::size_t(4096));
+    {
+        ImageT img(lsst::geom::Extent2I(128, 128));  // 64 KiB of float
+        // a default-constructed image still reads as zero ...
+        BOOST_CHECK_EQUAL(img(0, 0), 0);
+        BOOST_CHECK_EQUAL(img(127, 127), 0);
+        // ... and behaves like any other image
+        img(3, 4) = 34;
+        ImageT copy(img, true);
+        BOOST_CHECK_EQUAL(copy(3, 4), 34);
+        BOOST_CHECK_EQUAL(copy(0, 0), 0);
+
+        // a non-zero initial value is honored
+        ImageT filled(lsst::geom::Extent2I(128, 128), 7);
+        BOOST_CHECK_EQUAL(filled(64, 64), 7);
+
+        // an installed allocator takes precedence over the mapping path
+        auto arena = std::make_shared<image::ArenaImageAllocator>(1 << 20);
+        image::ScopedImageAllocator guard(arena);
+        ImageT arenaImg(lsst::geom::Extent2I(128, 128), 0);
+        BOOST_CHECK_EQUAL(arenaImg(127, 127), 0);
+    }
+
+    // 0 disables the path; images still work
+    image::setLargeImageAllocationThreshold(0);
+    {
+        ImageT img(lsst::geom::Extent2I(128, 128));
+        BOOST_CHECK_EQUAL(img(127, 127), 0);
+    }
+
+    image::setLargeImageAllocationThreshold(previous);
+}
+
+BOOST_AUTO_TEST_CASE(
+        adoptBuffer) { /* parasoft-suppress  LsstDm-3-2a LsstDm-3-4a LsstDm-4-6 LsstDm-5-25 "Boost non-Std" */
+    int const width = 5, height = 4, rowStride = 7;  // rows padded by 2 pixels
+    std::vector<PixelT> buffer(rowStride * height);
+    for (int y = 0; y != height; ++y) {
+        for (int x = 0; x != width; ++x) {
+            buffer[y * rowStride + x] = 100 * x + y;
+        }
+    }
+
+    bool deleted = false;
+    {
+        ImageT img = ImageT::adoptBuffer(buffer.data(), lsst::geom::Extent2I(width, height), rowStride,
+                                         [&deleted](PixelT*) { deleted = true; });
+        // no copy was made: the image reads and writes the caller's buffer
+        BOOST_CHECK_EQUAL(&img(0, 0), buffer.data());
+        BOOST_CHECK_EQUAL(img(3, 2), 302);
+        img(3, 2) = -1;
+        BOOST_CHECK_EQUAL(buffer[2 * rowStride + 3], -1);
+        BOOST_CHECK(!img.isContiguous());  // rowStride > width
+
+        // a subimage keeps the buffer alive after the adopting Image goes away
+        ImageT sub(img, lsst::geom::Box2I(lsst::geom::Point2I(1, 1), lsst::geom::Extent2I(2, 2)));
+        ImageT tmp(std::move(img));
+        BOOST_CHECK(!deleted);
+        BOOST_CHECK_EQUAL(sub(0, 0), 101);
+    }
+    BOOST_CHECK(deleted);
+
+    BOOST_CHECK_THROW(ImageT::adoptBuffer(nullptr, lsst::geom::Extent2I(width, height), rowStride,
+                                          [](PixelT*) {}),
+                      lsst::pex::exceptions::InvalidParameterError);
+    BOOST_CHECK_THROW(ImageT::adoptBuffer(buffer.data(), lsst::geom::Extent2I(width, height), width - 1,
+                                          [](PixelT*) {}),
+                      lsst::pex::exceptions::InvalidParameterError);
+}
@@ -157,3 +157,49 @@ BOOST_AUTO_TEST_CASE(
     BOOST_CHECK_CLOSE(parab_volume_integrate, parab_volume_analytic, 1e-6);
     BOOST_CHECK_CLOSE(parab_volume_integrate_function, parab_volume_analytic, 1e-6);
 }
+
+/* a narrow Gaussian forces the adaptive integrator to subdivide, which is
+ * what an IntegrationPlan is supposed to capture.
+ */
+template <typename IntegrandT>
+class Gauss1D : public std::unary_function<IntegrandT, IntegrandT> {
+public:
+    Gauss1D(double mu, double sig) : _mu(mu), _sig(sig) {}
+    IntegrandT operator()(IntegrandT const x) const {
+        double const SQRTTWOPI = 2.50662827463;
+        return std::exp(-0.5 * (x - _mu) * (x - _mu) / (_sig * _sig)) / (SQRTTWOPI * _sig);
+    }
+
+private:
+    double _mu, _sig;
+};
+
+/*
+ * Test that an IntegrationPlan adapted to one member of an integrand family
+ * reproduces the adaptive integrator for other members, both through the
+ * point-by-point and the batched (precomputed values) interfaces.
+ */
+BOOST_AUTO_TEST_CASE(
+        IntegrationPlan1D) { /* parasoft-suppress  LsstDm-3-2a LsstDm-3-4a LsstDm-4-6 LsstDm-5-25 "Boost non-Std" */
+
+    double const x1 = -10.0, x2 = 10.0;
+
+    // Adapt a plan to a prototype and check the prototype's own integral
+    Gauss1D<double> prototype(0.0, 0.1);
+    math::IntegrationPlan<double> plan = math::makeIntegrationPlan(prototype, x1, x2);
+    BOOST_CHECK_CLOSE(plan.getArea(), math::integrate(prototype, x1, x2), 1e-4);
+
+    // Re-use the plan for a slightly shifted member of the same family
+    Gauss1D<double> shifted(0.25, 0.12);
+    double const planned = plan(shifted);
+    double const adaptive = math::integrate(shifted, x1, x2);
+    BOOST_CHECK_CLOSE(planned, adaptive, 1e-4);
+
+    // The batched interface must agree exactly with operator()
+    std::vector<double> values;
+    values.reserve(plan.size());
+    for (size_t i = 0; i < plan.getNodes().size(); i++) {
+        values.push_back(shifted(plan.getNodes()[i]));
+    }
+    BOOST_CHECK_EQUAL(plan.integrateValues(values), planned);
+}
@@ -36,6 +36,7 @@
 #include "boost/test/floating_point_comparison.hpp"
 
 #include "boost/iterator/zip_iterator.hpp"
+#include "lsst/afw/image/ImageAlgorithm.h"
 #include "lsst/afw/image/MaskedImage.h"
 
 namespace image = lsst::afw::image;
@@ -483,3 +484,49 @@ BOOST_AUTO_TEST_CASE(
         BOOST_CHECK_EQUAL(pix.image(), 1452);
     }
 }
+
+BOOST_AUTO_TEST_CASE(
+        transformEachPixel) { /* parasoft-suppress  LsstDm-3-2a LsstDm-3-4a LsstDm-4-6 LsstDm-5-25 "Boost non-Std" */
+    ImageT img(lsst::geom::Extent2I(5, 6));
+    img = ImageT::Pixel(100, 0x4, 16);
+    ImageT rhs(img.getDimensions());
+    rhs = ImageT::Pixel(10, 0x2, 4);
+
+    // reference: two eager passes with MaskedImage's own operators
+    ImageT ref(img, true);
+    ref -= rhs;
+    ref *= 2;
+
+    // the same arithmetic fused into one pass via the single-pixel expression templates
+    image::transformEachPixel(img, rhs, [](auto pix, auto rhsPix) { return (pix - rhsPix) * 2; });
+
+    BOOST_CHECK_EQUAL(img.getImage()->get(lsst::geom::Point2I(3, 4), image::LOCAL),
+                      ref.getImage()->get(lsst::geom::Point2I(3, 4), image::LOCAL));
+    BOOST_CHECK_EQUAL(img.getMask()->get(lsst::geom::Point2I(3, 4), image::LOCAL),
+                      ref.getMask()->get(lsst::geom::Point2I(3, 4), image::LOCAL));
+    BOOST_CHECK_EQUAL(img.getVariance()->get(lsst::geom::Point2I(3, 4), image::LOCAL),
+                      ref.getVariance()->get(lsst::geom::Point2I(3, 4), image::LOCAL));
+    BOOST_CHECK_EQUAL(img.getMask()->get(lsst::geom::Point2I(0, 0), image::LOCAL), 0x6);
+}
+
+BOOST_AUTO_TEST_CASE(
+        applyWhere) { /* parasoft-suppress  LsstDm-3-2a LsstDm-3-4a LsstDm-4-6 LsstDm-5-25 "Boost non-Std" */
+    ImageT img(lsst::geom::Extent2I(8, 5));
+    img = ImageT::Pixel(100, 0x0, 16);
+    (*img.getMask())(1, 2) = 0x1;
+    (*img.getMask())(4, 3) = 0x2;
+    (*img.getMask())(6, 0) = 0x3;
+
+    // the constant-value (branch-free) form
+    BOOST_CHECK_EQUAL(img.setWhere(0x1, -1), 2U);
+    BOOST_CHECK_EQUAL(img.getImage()->get(lsst::geom::Point2I(1, 2), image::LOCAL), -1);
+    BOOST_CHECK_EQUAL(img.getImage()->get(lsst::geom::Point2I(6, 0), image::LOCAL), -1);
+    BOOST_CHECK_EQUAL(img.getImage()->get(lsst::geom::Point2I(4, 3), image::LOCAL), 100);
+    BOOST_CHECK_EQUAL(img.getVariance()->get(lsst::geom::Point2I(1, 2), image::LOCAL), 16);
+
+    // the general functor form
+    BOOST_CHECK_EQUAL(img.applyWhere(0x2, [](float& pix) { pix *= 10; }), 2U);
+    BOOST_CHECK_EQUAL(img.getImage()->get(lsst::geom::Point2I(4, 3), image::LOCAL), 1000);
+    BOOST_CHECK_EQUAL(img.getImage()->get(lsst::geom::Point2I(6, 0), image::LOCAL), -10);
+    BOOST_CHECK_EQUAL(img.getImage()->get(lsst::geom::Point2I(0, 0), image::LOCAL), 100);
+}
@@ -24,7 +24,9 @@ import numpy as np
 
 import lsst.utils.tests
 import lsst.geom
-from lsst.afw.cameraGeom import Amplifier, ReadoutCorner
+import lsst.afw.image
+import lsst.pex.exceptions
+from lsst.afw.cameraGeom import Amplifier, ReadoutCorner, makeVariancePlane
 
 
 class AmplifierTestCase(unittest.TestCase):
@@ -127,6 +129,64 @@ class AmplifierTestCase(unittest.TestCase):
         self.assertEqual(newPrescanBBox2,
                          amplifier.getRawPrescanBBox())
 
+    @staticmethod
+    def _makeAmplifier(name, bbox, gain, readNoise):
+        builder = Amplifier.Builder()
+        builder.setName(name)
+        builder.setBBox(bbox)
+        builder.setGain(gain)
+        builder.setReadNoise(readNoise)
+        return builder.finish()
+
+    def testMakeVariancePlane(self):
+        # A non-zero xy0 checks that amplifier bboxes are interpreted in
+        # parent coordinates.
+        box = lsst.geom.Box2I(lsst.geom.Point2I(10, -5),
+                              lsst.geom.Extent2I(64, 48))
+        mimg = lsst.afw.image.MaskedImageF(box)
+        rng = np.random.RandomState(6)
+        mimg.image.array[:] = rng.uniform(100.0, 2000.0,
+                                          size=mimg.image.array.shape)
+
+        gains = (1.5, 0.9)
+        readNoises = (8.0, 5.5)
+        halfWidth = box.getWidth()//2
+        amplifiers = []
+        for i, (gain, readNoise) in enumerate(zip(gains, readNoises)):
+            ampBox = lsst.geom.Box2I(
+                lsst.geom.Point2I(box.getMinX() + i*halfWidth, box.getMinY()),
+                lsst.geom.Extent2I(halfWidth, box.getHeight()))
+            amplifiers.append(
+                self._makeAmplifier("A%d" % i, ampBox, gain, readNoise))
+
+        makeVariancePlane(mimg.image, mimg.variance, amplifiers)
+
+        for amplifier, gain, readNoise in zip(amplifiers, gains, readNoises):
+            sub = mimg.Factory(mimg, amplifier.getBBox())
+            expected = sub.image.array/gain + (readNoise/gain)**2
+            np.testing.assert_allclose(sub.variance.array, expected,
+                                       rtol=1e-6)
+
+        # An amplifier extending outside the image is an error.
+        outside = self._makeAmplifier(
+            "outside",
+            lsst.geom.Box2I(lsst.geom.Point2I(0, 0),
+                            lsst.geom.Extent2I(5, 5)),
+            1.0, 3.0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            makeVariancePlane(mimg.image, mimg.variance, [outside])
+
+        # So is a non-positive gain ...
+        zeroGain = self._makeAmplifier(
+            "zeroGain", amplifiers[0].getBBox(), 0.0, 3.0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            makeVariancePlane(mimg.image, mimg.variance, [zeroGain])
+
+        # ... and a variance plane whose bbox does not match the image's.
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            makeVariancePlane(mimg.image, lsst.afw.image.ImageF(10, 10),
+                              amplifiers)
+
 
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
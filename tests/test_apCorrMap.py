@@ -135,6 +135,20 @@ class ApCorrMapTestCase(lsst.utils.tests.TestCase):
         record = cat[0]
         self.assertIsNone(record.getApCorrMap())
 
+    def testEvaluateAll(self):
+        """Test that bulk evaluation matches per-field evaluation.
+        """
+        # "d" shares "a"'s field, so only three distinct surfaces are evaluated
+        self.map.set("d", self.map.get("a"))
+        x = np.random.uniform(-5.0, 5.0, 20)
+        y = np.random.uniform(-5.0, 5.0, 20)
+        corrections = self.map.evaluateAll(x, y)
+        self.assertEqual(corrections.shape, (20, len(self.map)))
+        for col, (name, value) in enumerate(self.map.items()):
+            self.assertFloatsAlmostEqual(corrections[:, col], value.evaluate(x, y), rtol=0.0)
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            self.map.evaluateAll(x, y[:-1])
+
     def testScale(self):
         """Test that we can scale an ApCorrMap.
         """
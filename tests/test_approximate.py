@@ -93,6 +93,29 @@ class ApproximateTestCase(lsst.utils.tests.TestCase):
                 self.assertEqual(
                     aim[x, y, afwImage.LOCAL], rampCoeffs[0] + rampCoeffs[1]*x + rampCoeffs[1]*y)
 
+    def testNumThreadsFit(self):
+        """Check that the multithreaded fit matches the serial fit"""
+        binsize = 1
+        ramp, rampCoeffs, xVec, yVec = self.makeRamp(binsize)
+        ramp[ramp.getWidth()//2, ramp.getHeight()//2, afwImage.LOCAL] = (0, 0x1, np.nan)
+        bbox = lsst.geom.BoxI(lsst.geom.PointI(0, 0),
+                              lsst.geom.PointI(binsize*ramp.getWidth() - 1,
+                                               binsize*ramp.getHeight() - 1))
+
+        order = 3
+        actrl = afwMath.ApproximateControl(
+            afwMath.ApproximateControl.CHEBYSHEV, order)
+        refImage = afwMath.makeApproximate(
+            xVec, yVec, ramp, bbox, actrl).getImage()
+
+        for numThreads in (2, 5):
+            actrl = afwMath.ApproximateControl(
+                afwMath.ApproximateControl.CHEBYSHEV, order, -1, True, numThreads)
+            self.assertEqual(actrl.getNumThreads(), numThreads)
+            aim = afwMath.makeApproximate(xVec, yVec, ramp, bbox, actrl).getImage()
+            self.assertImagesAlmostEqual(
+                aim, refImage, msg="numThreads=%d" % (numThreads,))
+
     def testChebyshevEqualOrder(self):
         """Check that we enforce the condition orderX == orderY"""
 
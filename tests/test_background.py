@@ -89,6 +89,110 @@ class BackgroundTestCase(lsst.utils.tests.TestCase):
                           [back[0, y, afwImage.LOCAL] for y in range(H)]):
             self.assertLess(abs(iy - by), 5)
 
+    def testNumThreads(self):
+        """Threaded per-cell statistics must give exactly the serial statsImage
+
+        The threads shard the grid columns; every cell is measured just as in
+        the serial loop, so the stats image (and hence the interpolated
+        background) must be identical.
+        """
+        image = afwImage.ImageF(lsst.geom.Extent2I(256, 256))
+        image.array[:] = np.random.normal(100.0, 5.0, image.array.shape)
+
+        def makeControl(numThreads):
+            sctrl = afwMath.StatisticsControl()
+            sctrl.setNumThreads(numThreads)
+            bgCtrl = afwMath.BackgroundControl(8, 8, sctrl)
+            return bgCtrl
+
+        serial = afwMath.makeBackground(image, makeControl(1))
+        threaded = afwMath.makeBackground(image, makeControl(4))
+
+        self.assertFloatsEqual(threaded.getStatsImage().image.array,
+                               serial.getStatsImage().image.array)
+        self.assertFloatsEqual(threaded.getStatsImage().variance.array,
+                               serial.getStatsImage().variance.array)
+        self.assertFloatsEqual(threaded.getImageF(afwMath.Interpolate.AKIMA_SPLINE).array,
+                               serial.getImageF(afwMath.Interpolate.AKIMA_SPLINE).array)
+
+    def testUpdateRegion(self):
+        """Re-estimating only the dirty cells must match a full rebuild"""
+        x0, y0 = 1234, 5678
+        box = lsst.geom.Box2I(lsst.geom.Point2I(x0, y0), lsst.geom.Extent2I(200, 160))
+        image = afwImage.ImageF(box)
+        image.array[:] = np.random.normal(50.0, 2.0, image.array.shape)
+
+        bgCtrl = afwMath.BackgroundControl(8, 8)
+        bkgd = afwMath.makeBackground(image, bgCtrl)
+
+        # dirty a small patch, as defect interpolation would
+        dirty = lsst.geom.Box2I(lsst.geom.Point2I(x0 + 30, y0 + 40), lsst.geom.Extent2I(25, 15))
+        sub = image.Factory(image, dirty, afwImage.PARENT)
+        sub.array[:] += 100.0
+
+        before = bkgd.getStatsImage().image.array.copy()
+        bkgd.updateRegion(image, dirty)
+        after = bkgd.getStatsImage().image.array
+
+        # only the intersecting cells changed, and they match a from-scratch estimate
+        fresh = afwMath.makeBackground(image, bgCtrl)
+        self.assertFloatsEqual(after, fresh.getStatsImage().image.array)
+        self.assertFloatsEqual(bkgd.getImageF(afwMath.Interpolate.AKIMA_SPLINE).array,
+                               fresh.getImageF(afwMath.Interpolate.AKIMA_SPLINE).array)
+        nChanged = np.sum(after != before)
+        self.assertGreater(nChanged, 0)
+        self.assertLess(nChanged, before.size)
+
+        # a region outside the image is a no-op; a mismatched image is an error
+        bkgd.updateRegion(image, lsst.geom.Box2I(lsst.geom.Point2I(0, 0), lsst.geom.Extent2I(5, 5)))
+        self.assertFloatsEqual(bkgd.getStatsImage().image.array, after)
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            bkgd.updateRegion(afwImage.ImageF(lsst.geom.Extent2I(10, 10)), dirty)
+
+    def testIterativeSubtraction(self):
+        """Incremental re-estimation must only touch cells whose mask changed"""
+        mimage = afwImage.MaskedImageF(lsst.geom.Extent2I(256, 256))
+        yy, xx = np.meshgrid(np.arange(256, dtype=np.float32),
+                             np.arange(256, dtype=np.float32), indexing="ij")
+        sky = 100.0 + 0.05*xx + 0.02*yy
+        mimage.image.array[:] = sky + np.random.normal(0.0, 1.0, sky.shape)
+        mimage.variance.set(1.0)
+
+        sctrl = afwMath.StatisticsControl()
+        sctrl.setAndMask(afwImage.Mask.getPlaneBitMask("DETECTED"))
+        bgCtrl = afwMath.BackgroundControl(8, 8, sctrl)
+
+        subtractor = afwMath.IterativeBackgroundSubtractorF(bgCtrl)
+
+        # round 1 measures every cell and removes the sky
+        nCells = subtractor.subtract(mimage)
+        self.assertEqual(nCells, 8*8)
+        self.assertLess(abs(np.mean(mimage.image.array)), 0.5)
+
+        # an unchanged mask makes the next round free
+        self.assertEqual(subtractor.subtract(mimage), 0)
+
+        # mask a bright "source" and bias its neighbourhood; only the cells
+        # under the new mask are re-measured
+        source = lsst.geom.Box2I(lsst.geom.Point2I(100, 100), lsst.geom.Extent2I(40, 40))
+        sub = mimage.Factory(mimage, source, afwImage.LOCAL)
+        sub.image.array[:] += 20.0
+        sub.mask.array[:] |= afwImage.Mask.getPlaneBitMask("DETECTED")
+        before = subtractor.getBackground().getStatsImage().image.array.copy()
+        nCells = subtractor.subtract(mimage)
+        self.assertGreater(nCells, 0)
+        self.assertLess(nCells, 8*8)
+        after = subtractor.getBackground().getStatsImage().image.array
+        self.assertEqual(np.sum(after != before), nCells)
+
+        # the masked source survives subtraction; its surroundings stay flat
+        self.assertGreater(np.mean(mimage.image.array[110:130, 110:130]), 15.0)
+        self.assertLess(abs(np.mean(mimage.image.array[:80, :80])), 0.5)
+
+        # a mismatched image is an error
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            subtractor.subtract(afwImage.MaskedImageF(lsst.geom.Extent2I(10, 10)))
+
     @unittest.skipIf(AfwdataDir is None, "afwdata not setup")
     def testBackgroundTestImages(self):
         """Tests Laher's afwdata/Statistics/*.fits images (doubles)"""
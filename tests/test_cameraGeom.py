@@ -224,6 +224,53 @@ class CameraGeomTestCase(lsst.utils.tests.TestCase):
             for dets in detList:
                 self.assertEqual(len(dets), 1)
 
+    def testTransformByDetector(self):
+        """Test the bulk Camera.transform overloads that take points grouped
+        by detector ID.
+        """
+        for cw in self.cameraList:
+            camera = cw.camera
+            pointsByDetector = {det.getId(): [lsst.geom.Point2D(10, 10), lsst.geom.Point2D(20, 5)]
+                                for det in camera}
+            fpByDetector = camera.transform(pointsByDetector, PIXELS, FOCAL_PLANE)
+            self.assertEqual(set(fpByDetector.keys()), set(pointsByDetector.keys()))
+            for detId, fpPoints in fpByDetector.items():
+                pixSys = camera[detId].makeCameraSys(PIXELS)
+                for pixPoint, fpPoint in zip(pointsByDetector[detId], fpPoints):
+                    self.assertPairsAlmostEqual(camera.transform(pixPoint, pixSys, FOCAL_PLANE),
+                                                fpPoint)
+            # Round-trip back to PIXELS with the opposite overload.
+            pixByDetector = camera.transform(fpByDetector, FOCAL_PLANE, PIXELS)
+            for detId, pixPoints in pixByDetector.items():
+                for pixPoint, origPoint in zip(pixPoints, pointsByDetector[detId]):
+                    self.assertPairsAlmostEqual(pixPoint, origPoint)
+            with self.assertRaises(pexExcept.NotFoundError):
+                camera.transform({-12345: [lsst.geom.Point2D(0, 0)]}, PIXELS, FOCAL_PLANE)
+
+    def testDetectorCollectionFindDetectors(self):
+        """Test DetectorCollection.findDetectors and findDetectorsList
+        directly, and check that they agree with the Camera equivalents.
+        """
+        for cw in self.cameraList:
+            camera = cw.camera
+            collection = DetectorCollection(list(camera))
+            points = [det.getCenter(FOCAL_PLANE) for det in camera]
+            # A point just off a detector edge and one far outside the
+            # focal plane.
+            points.append(points[0] + lsst.geom.Extent2D(0.0, 1e3))
+            points.append(lsst.geom.Point2D(1e6, 1e6))
+            for point in points:
+                expected = camera.findDetectors(point, FOCAL_PLANE)
+                found = collection.findDetectors(point)
+                self.assertEqual([d.getName() for d in found],
+                                 [d.getName() for d in expected])
+            foundLists = collection.findDetectorsList(points)
+            self.assertEqual(len(foundLists), len(points))
+            for point, found in zip(points, foundLists):
+                self.assertEqual([d.getName() for d in found],
+                                 [d.getName() for d in collection.findDetectors(point)])
+            self.assertEqual(len(collection.findDetectors(lsst.geom.Point2D(1e6, 1e6))), 0)
+
     def testFpBbox(self):
         for cw in self.cameraList:
             camera = cw.camera
@@ -148,13 +148,47 @@ class ChebyshevBoundedFieldTestCase(lsst.utils.tests.TestCase):
             self.assertFloatsEqual(
                 scaled.getCoefficients(), factor*field.getCoefficients())
 
+    def testFillImageNumThreads(self):
+        """Filling an image with multiple threads must give results identical
+        to the serial path, since each thread writes a disjoint set of rows.
+        """
+        ctrl, coefficients = self.cases[-2]
+        bbox = lsst.geom.Box2I(lsst.geom.Point2I(10, 15), lsst.geom.Extent2I(123, 147))
+        field = lsst.afw.math.ChebyshevBoundedField(bbox, coefficients)
+        serial = lsst.afw.image.ImageD(bbox)
+        field.fillImage(serial)
+        threaded = lsst.afw.image.ImageD(bbox)
+        field.fillImage(threaded, numThreads=4)
+        self.assertFloatsEqual(threaded.array, serial.array)
+
+        serial.array[:, :] = 2.0
+        threaded.array[:, :] = 2.0
+        field.multiplyImage(serial)
+        field.multiplyImage(threaded, numThreads=4)
+        self.assertFloatsEqual(threaded.array, serial.array)
+
+    def testFillImageAgreesWithEvaluate(self):
+        """fillImage feeds whole rows to the batched array evaluate; the result
+        must agree with point-at-a-time evaluation to rounding precision.
+        """
+        for ctrl, coefficients in self.cases[::7]:
+            field = lsst.afw.math.ChebyshevBoundedField(self.bbox, coefficients)
+            image = lsst.afw.image.ImageD(self.bbox)
+            field.fillImage(image)
+            expect = np.array([[field.evaluate(x, y)
+                                for x in range(self.bbox.getMinX(), self.bbox.getMaxX() + 1)]
+                               for y in range(self.bbox.getMinY(), self.bbox.getMaxY() + 1)])
+            self.assertFloatsAlmostEqual(image.array, expect, rtol=1E-12, atol=1E-14)
+
     def testProductEvaluate(self):
         """Test that ProductBoundedField.evaluate is equivalent to multiplying
         its nested BoundedFields.
         """
         zFlat1 = self.product.evaluate(self.xFlat, self.yFlat)
         zFlat2 = np.array([self.product.evaluate(x, y) for x, y in zip(self.xFlat, self.yFlat)])
-        self.assertFloatsAlmostEqual(zFlat1, zFlat2)
+        # The array overload batches the Chebyshev recurrence by rows, so it agrees with
+        # point-at-a-time evaluation only to rounding precision, not bitwise.
+        self.assertFloatsAlmostEqual(zFlat1, zFlat2, rtol=1E-12)
         zFlat3 = np.ones(zFlat1.shape, dtype=float)
         for field in self.fields:
             zFlat3 *= field.evaluate(self.xFlat, self.yFlat)
@@ -370,6 +404,37 @@ class ChebyshevBoundedFieldTestCase(lsst.utils.tests.TestCase):
                 self.assertFloatsAlmostEqual(
                     outField2.getCoefficients(), coefficients, rtol=1E-7, atol=1E-7)
 
+    def testFitter(self):
+        """Test that ChebyshevBoundedFieldFitter reproduces the one-shot fit()
+        when refitting new values at a fixed set of positions.
+        """
+        for ctrl, coefficients in self.cases[::5]:
+            inField = lsst.afw.math.ChebyshevBoundedField(self.bbox, coefficients)
+            array = inField.evaluate(self.xFlat, self.yFlat)
+
+            fitter = lsst.afw.math.ChebyshevBoundedFieldFitter(self.bbox, self.xFlat, self.yFlat, ctrl)
+            self.assertEqual(fitter.getNumPoints(), self.xFlat.size)
+            outField1 = fitter.fit(array)
+            expect = lsst.afw.math.ChebyshevBoundedField.fit(self.bbox, self.xFlat, self.yFlat,
+                                                             array, ctrl)
+            self.assertFloatsAlmostEqual(outField1.getCoefficients(), expect.getCoefficients(),
+                                         rtol=1E-8, atol=1E-10)
+            # A refit with scaled values must not require rebuilding anything.
+            outField2 = fitter.fit(3.0*array)
+            self.assertFloatsAlmostEqual(outField2.getCoefficients(), 3.0*expect.getCoefficients(),
+                                         rtol=1E-8, atol=1E-9)
+
+            weights = (1.0 + np.random.randn(array.size)**2)
+            wFitter = lsst.afw.math.ChebyshevBoundedFieldFitter(self.bbox, self.xFlat, self.yFlat,
+                                                                weights, ctrl)
+            self.assertFloatsAlmostEqual(wFitter.fit(array).getCoefficients(), coefficients,
+                                         rtol=1E-6, atol=1E-7)
+
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            fitter.fit(array[:-1])
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            lsst.afw.math.ChebyshevBoundedFieldFitter(self.bbox, self.xFlat, self.yFlat[:-1], ctrl)
+
     def testApproximate(self):
         """Test the approximate instantiation with the example of
         fitting a PixelAreaBoundedField to reasonable precision.
@@ -383,6 +383,117 @@ class ConvolveTestCase(lsst.utils.tests.TestCase):
             self.assertEqual(
                 convControl.getMaxInterpolationDistance(), maxInterpDist)
 
+        self.assertEqual(convControl.getNumThreads(), 1)
+        for numThreads in (1, 2, 8, 64):
+            convControl.setNumThreads(numThreads)
+            self.assertEqual(convControl.getNumThreads(), numThreads)
+
+    def testConvolutionWorkspace(self):
+        """Verify that convolution with a reused workspace matches fresh-scratch convolution
+        """
+        gaussFunc1 = afwMath.GaussianFunction1D(1.5)
+        separableKernel = afwMath.SeparableKernel(7, 7, gaussFunc1, gaussFunc1)
+        kFunc = afwMath.GaussianFunction2D(2.0, 1.5, 0.2)
+        analyticKernel = afwMath.AnalyticKernel(6, 5, kFunc)
+
+        image = afwImage.ImageF(lsst.geom.Extent2I(45, 40))
+        image.getArray()[:] = numpy.random.RandomState(3).uniform(
+            size=(image.getHeight(), image.getWidth()))
+
+        workspace = afwMath.ConvolutionWorkspace()
+        convControl = afwMath.ConvolutionControl()
+        convControl.setDoCopyEdge(True)
+        convControl.setWorkspace(workspace)
+
+        refControl = afwMath.ConvolutionControl()
+        refControl.setDoCopyEdge(True)
+
+        for kernel in (separableKernel, analyticKernel):
+            refImage = afwImage.ImageF(image.getDimensions())
+            afwMath.convolve(refImage, image, kernel, refControl)
+            # convolve twice so the second call reuses the workspace buffers
+            for trial in range(2):
+                cnvImage = afwImage.ImageF(image.getDimensions())
+                afwMath.convolve(cnvImage, image, kernel, convControl)
+                self.assertImagesAlmostEqual(
+                    cnvImage, refImage, msg="workspace trial %d" % (trial,))
+
+    def testFFTConvolution(self):
+        """Verify that FFT convolution matches the direct algorithm
+        """
+        kFunc = afwMath.GaussianFunction2D(5.5, 4.5, 0.3)
+        kernel = afwMath.AnalyticKernel(33, 35, kFunc)
+        image = afwImage.ImageD(lsst.geom.Extent2I(80, 75))
+        image.getArray()[:] = numpy.random.RandomState(17).uniform(
+            size=(image.getHeight(), image.getWidth()))
+
+        refControl = afwMath.ConvolutionControl()
+        refControl.setDoCopyEdge(True)
+        refImage = afwImage.ImageD(image.getDimensions())
+        afwMath.convolve(refImage, image, kernel, refControl)
+
+        # the kernel area is above the crossover, so both FFT and AUTO should use the FFT
+        for algorithm in (afwMath.CONVOLUTION_FFT, afwMath.CONVOLUTION_AUTO):
+            convControl = afwMath.ConvolutionControl()
+            convControl.setDoCopyEdge(True)
+            convControl.setAlgorithm(algorithm)
+            cnvImage = afwImage.ImageD(image.getDimensions())
+            afwMath.convolve(cnvImage, image, kernel, convControl)
+            self.assertImagesAlmostEqual(
+                cnvImage, refImage, rtol=1e-10, msg="algorithm=%s" % (algorithm,))
+
+    def testNumThreadsConvolution(self):
+        """Verify that banded multithreaded convolution matches the serial result
+        """
+        kFunc = afwMath.GaussianFunction2D(2.5, 1.5, 0.5)
+        kernel = afwMath.AnalyticKernel(7, 6, kFunc)
+        image = afwImage.ImageF(lsst.geom.Extent2I(50, 55))
+        image.getArray()[:] = numpy.random.RandomState(42).uniform(
+            size=(image.getHeight(), image.getWidth()))
+
+        refControl = afwMath.ConvolutionControl()
+        refControl.setDoCopyEdge(True)
+        refImage = afwImage.ImageF(image.getDimensions())
+        afwMath.convolve(refImage, image, kernel, refControl)
+
+        for numThreads in (2, 4, 7):
+            convControl = afwMath.ConvolutionControl()
+            convControl.setDoCopyEdge(True)
+            convControl.setNumThreads(numThreads)
+            cnvImage = afwImage.ImageF(image.getDimensions())
+            afwMath.convolve(cnvImage, image, kernel, convControl)
+            self.assertImagesAlmostEqual(
+                cnvImage, refImage, msg="numThreads=%d" % (numThreads,))
+
+    def testNumThreadsInterpolatedConvolution(self):
+        """Verify that work-queue multithreaded interpolated convolution matches the serial result
+        """
+        kFunc = afwMath.GaussianFunction2D(1.0, 1.0, 0.0)
+        spFunc = afwMath.PolynomialFunction2D(1)
+        kernel = afwMath.AnalyticKernel(7, 7, kFunc, spFunc)
+        kernel.setSpatialParameters([
+            (1.0, 0.004, 0.002),
+            (1.0, 0.002, 0.004),
+            (0.0, 0.0, 0.0),
+        ])
+        image = afwImage.ImageF(lsst.geom.Extent2I(60, 45))
+        image.getArray()[:] = numpy.random.RandomState(17).uniform(
+            size=(image.getHeight(), image.getWidth()))
+
+        refControl = afwMath.ConvolutionControl()
+        refControl.setDoCopyEdge(True)
+        refImage = afwImage.ImageF(image.getDimensions())
+        afwMath.convolve(refImage, image, kernel, refControl)
+
+        for numThreads in (2, 5):
+            convControl = afwMath.ConvolutionControl()
+            convControl.setDoCopyEdge(True)
+            convControl.setNumThreads(numThreads)
+            cnvImage = afwImage.ImageF(image.getDimensions())
+            afwMath.convolve(cnvImage, image, kernel, convControl)
+            self.assertImagesAlmostEqual(
+                cnvImage, refImage, msg="numThreads=%d" % (numThreads,))
+
     @unittest.skipIf(dataDir is None, "afwdata not setup")
     def testUnityConvolution(self):
         """Verify that convolution with a centered delta function reproduces the original.
@@ -443,6 +554,52 @@ class ConvolveTestCase(lsst.utils.tests.TestCase):
             refKernel=analyticKernel,
             kernelDescr="Gaussian Separable Kernel (compared to AnalyticKernel equivalent)")
 
+    def testSeparableConvolveZeroTaps(self):
+        """Test convolve of a separable kernel whose y vector has exactly zero values
+
+        Kernel values that are exactly zero must be skipped (IgnoreKernelZeroPixels):
+        zero-weight input pixels contribute neither mask bits nor NaN to the output.
+        A delta function y vector makes the y taps exactly (0, 1, 0).
+        """
+        gaussFunc1 = afwMath.GaussianFunction1D(1.0)
+        deltaFunc1 = afwMath.IntegerDeltaFunction1D(0.0)
+        separableKernel = afwMath.SeparableKernel(3, 3, gaussFunc1, deltaFunc1)
+
+        kernelImage = afwImage.ImageD(separableKernel.getDimensions())
+        separableKernel.computeImage(kernelImage, False)
+        fixedKernel = afwMath.FixedKernel(kernelImage)
+
+        satMask = afwImage.Mask.getPlaneBitMask("SAT")
+        maskedImage = afwImage.MaskedImageF(20, 16)
+        maskedImage.getImage().getArray()[:, :] = numpy.random.uniform(size=(16, 20))
+        maskedImage.getVariance().getArray()[:, :] = 0.1
+        maskedImage.getImage()[5, 4, afwImage.LOCAL] = numpy.nan
+        maskedImage.getMask()[7, 8, afwImage.LOCAL] = satMask
+
+        cnvSeparable = afwImage.MaskedImageF(maskedImage.getDimensions())
+        afwMath.convolve(cnvSeparable, maskedImage, separableKernel, afwMath.ConvolutionControl())
+        cnvFixed = afwImage.MaskedImageF(maskedImage.getDimensions())
+        afwMath.convolve(cnvFixed, maskedImage, fixedKernel, afwMath.ConvolutionControl())
+
+        # the mask smear ignores exactly-zero kernel pixels, so the two paths agree exactly
+        self.assertMasksEqual(cnvSeparable.getMask(), cnvFixed.getMask())
+
+        # the mask bit spreads along the nonzero x taps but not to the zero-weight rows
+        self.assertEqual(cnvSeparable.getMask()[7, 8, afwImage.LOCAL] & satMask, satMask)
+        self.assertEqual(cnvSeparable.getMask()[7, 7, afwImage.LOCAL] & satMask, 0)
+        self.assertEqual(cnvSeparable.getMask()[7, 9, afwImage.LOCAL] & satMask, 0)
+
+        # likewise NaN must not leak into rows with zero y weight
+        self.assertTrue(numpy.isnan(cnvSeparable.getImage()[5, 4, afwImage.LOCAL]))
+        self.assertFalse(numpy.isnan(cnvSeparable.getImage()[5, 3, afwImage.LOCAL]))
+        self.assertFalse(numpy.isnan(cnvSeparable.getImage()[5, 5, afwImage.LOCAL]))
+
+        # the 3x3 fixed kernel goes through the small-width brute-force dispatch;
+        # its exactly-zero rows must be skipped there as well
+        self.assertTrue(numpy.isnan(cnvFixed.getImage()[5, 4, afwImage.LOCAL]))
+        self.assertFalse(numpy.isnan(cnvFixed.getImage()[5, 3, afwImage.LOCAL]))
+        self.assertFalse(numpy.isnan(cnvFixed.getImage()[5, 5, afwImage.LOCAL]))
+
     @unittest.skipIf(dataDir is None, "afwdata not setup")
     def testSpatiallyInvariantConvolve(self):
         """Test convolution with a spatially invariant Gaussian function
@@ -111,6 +111,42 @@ class EllipseTestCase(lsst.utils.tests.TestCase):
                 self.assertFloatsAlmostEqual(
                     t1.getParameterVector(), core.getParameterVector())
 
+    def testCompiledGridTransform(self):
+        # Restrict to non-degenerate cores: the grid transform of a line
+        # segment is singular.
+        cores = [core for core in self.cores if core.getDeterminantRadius() > 0.1]
+        self.assertGreater(len(cores), 0)
+        for core in cores:
+            with self.subTest(core=core):
+                e = lsst.afw.geom.ellipses.Ellipse(
+                    core, lsst.geom.Point2D(*np.random.randn(2)))
+                gt = e.getGridTransform()
+                ct = lsst.afw.geom.ellipses.CompiledGridTransform(e)
+                self.assertFloatsAlmostEqual(ct.getTransform().getMatrix(),
+                                             gt.getMatrix())
+                self.assertFloatsAlmostEqual(
+                    ct.getDeterminant(),
+                    np.linalg.det(gt.getMatrix()[:2, :2]), rtol=1e-14)
+                x = np.random.randn(20)
+                y = np.random.randn(20)
+                outX, outY = ct(x, y)
+                for i in range(len(x)):
+                    point = gt(lsst.geom.Point2D(x[i], y[i]))
+                    self.assertFloatsAlmostEqual(outX[i], point.getX(), rtol=1e-14)
+                    self.assertFloatsAlmostEqual(outY[i], point.getY(), rtol=1e-14)
+                    single = ct(lsst.geom.Point2D(x[i], y[i]))
+                    self.assertFloatsAlmostEqual(single.getX(), outX[i], rtol=1e-14)
+                    self.assertFloatsAlmostEqual(single.getY(), outY[i], rtol=1e-14)
+                # Core-only version has no translation
+                coreCt = lsst.afw.geom.ellipses.CompiledGridTransform(core)
+                self.assertFloatsAlmostEqual(
+                    coreCt.getTransform().getMatrix()[:2, :2],
+                    gt.getMatrix()[:2, :2])
+                self.assertEqual(coreCt.getTransform().getTranslation().getX(), 0.0)
+                self.assertEqual(coreCt.getTransform().getTranslation().getY(), 0.0)
+                with self.assertRaises(lsst.pex.exceptions.LengthError):
+                    ct(np.zeros(3), np.zeros(4))
+
     def testPixelRegion(self):
         for core in self.cores:
             with self.subTest(core=core):
@@ -146,6 +182,18 @@ class EllipseTestCase(lsst.utils.tests.TestCase):
                     self.assertTrue(bbox.contains(span.getMin()))
                     self.assertTrue(bbox.contains(span.getMax()))
 
+    def testPixelRegionGetSpans(self):
+        for core in self.cores:
+            with self.subTest(core=core):
+                e = lsst.afw.geom.ellipses.Ellipse(
+                    core, lsst.geom.Point2D(*np.random.randn(2)))
+                region = lsst.afw.geom.ellipses.PixelRegion(e)
+                spanSet = region.getSpans()
+                self.assertEqual(list(spanSet), list(region))
+                self.assertEqual(spanSet.getBBox(), region.getBBox())
+                self.assertEqual(spanSet.getArea(),
+                                 sum(span.getWidth() for span in region))
+
 
 class MemoryTester(lsst.utils.tests.MemoryTestCase):
     pass
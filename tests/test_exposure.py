@@ -496,6 +496,44 @@ class ExposureTestCase(lsst.utils.tests.TestCase):
             self.assertIsNotNone(psf)
             self.assertEqual(psf, self.psf)
 
+    def testSnapshot(self):
+        """Test the binary snapshot round trip.
+        """
+        exposure = afwImage.ExposureF(inFilePathSmall)
+        exposure.setDetector(self.detector)
+        exposure.setPsf(self.psf)
+        exposure.setXY0(lsst.geom.Point2I(5, 7))
+        exposure.getMaskedImage().getVariance().set(1.25)
+
+        with lsst.utils.tests.getTempFilePath(".snap") as tmpFile:
+            exposure.writeSnapshot(tmpFile)
+            readExposure = afwImage.ExposureF.readSnapshot(tmpFile)
+
+            self.assertEqual(exposure.getXY0(), readExposure.getXY0())
+            self.assertMaskedImagesEqual(exposure.getMaskedImage(),
+                                         readExposure.getMaskedImage())
+            self.assertEqual(exposure.getDetector().getName(),
+                             readExposure.getDetector().getName())
+            self.assertEqual(exposure.getPsf(), readExposure.getPsf())
+            self.assertWcsAlmostEqualOverBBox(exposure.getWcs(),
+                                              readExposure.getWcs(),
+                                              exposure.getBBox())
+
+            # The restored planes are copy-on-write mappings of the file;
+            # writing to them must not corrupt later reads.
+            readExposure.getMaskedImage().getImage().set(0.0)
+            rereadExposure = afwImage.ExposureF.readSnapshot(tmpFile)
+            self.assertImagesEqual(exposure.getMaskedImage().getImage(),
+                                   rereadExposure.getMaskedImage().getImage())
+
+            # A snapshot records its pixel types; reading with others fails
+            with self.assertRaises(pexExcept.InvalidParameterError):
+                afwImage.ExposureD.readSnapshot(tmpFile)
+
+        # Not a snapshot at all
+        with self.assertRaises(pexExcept.IoError):
+            afwImage.ExposureF.readSnapshot(inFilePathSmall)
+
     def checkWcs(self, parentExposure, subExposure):
         """Compare WCS at corner points of a sub-exposure and its parent exposure
            By using the function indexToPosition, we should be able to convert the indices
@@ -621,6 +659,31 @@ class ExposureTestCase(lsst.utils.tests.TestCase):
         self.assertTrue(np.all(mi.getMask().getArray() == 5))
         self.assertFloatsAlmostEqual(mi.getVariance().getArray(), 200)
 
+    def testCopyComponentsIndependent(self):
+        """Make sure copies share components but not changes to them
+
+        Copies of an Exposure share the component map copy-on-write, so
+        setting or removing a component on one must not affect the other.
+        """
+        exp = afwImage.ExposureF(6, 7)
+        exp.setPsf(self.psf)
+        info = exp.getInfo()
+        for key, value in self.extras.items():
+            info.setComponent(key, value)
+
+        expCopy = afwImage.ExposureF(exp, deep=False)
+        self.assertEqual(expCopy.getPsf(), self.psf)
+
+        expCopy.setPsf(DummyPsf(9.0))
+        self.assertEqual(exp.getPsf(), self.psf)
+        self.assertEqual(expCopy.getPsf(), DummyPsf(9.0))
+
+        infoCopy = expCopy.getInfo()
+        for key in self.extras:
+            infoCopy.removeComponent(key)
+            self.assertFalse(infoCopy.hasComponent(key))
+            self.assertTrue(info.hasComponent(key))
+
     def testDeepCopyMetadata(self):
         """Make sure a deep copy of an Exposure has a deep copy of metadata (ticket #2568)
         """
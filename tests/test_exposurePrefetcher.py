@@ -0,0 +1,105 @@
+# This file is part of afw.
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (https://www.lsst.org).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+import os
+import tempfile
+import unittest
+
+import lsst.utils.tests
+import lsst.geom
+import lsst.afw.image as afwImage
+import lsst.pex.exceptions as pexExcept
+
+
+class ExposurePrefetcherTestCase(lsst.utils.tests.TestCase):
+
+    def setUp(self):
+        self.tempDir = tempfile.TemporaryDirectory()
+        self.fileNames = []
+        for i in range(5):
+            exposure = afwImage.ExposureF(lsst.geom.Extent2I(8, 6))
+            exposure.image.set(float(i + 1))
+            exposure.variance.set(0.25 * (i + 1))
+            fileName = os.path.join(self.tempDir.name, "exposure-%d.fits" % i)
+            exposure.writeFits(fileName)
+            self.fileNames.append(fileName)
+
+    def tearDown(self):
+        self.tempDir.cleanup()
+
+    def testInOrderDelivery(self):
+        prefetcher = afwImage.ExposurePrefetcherF(self.fileNames)
+        self.assertEqual(len(prefetcher), len(self.fileNames))
+        for i in range(len(self.fileNames)):
+            self.assertTrue(prefetcher.hasNext())
+            exposure = prefetcher.next()
+            self.assertEqual(exposure.image[0, 0], float(i + 1))
+            self.assertEqual(exposure.variance[0, 0], 0.25 * (i + 1))
+        self.assertFalse(prefetcher.hasNext())
+        with self.assertRaises(pexExcept.OutOfRangeError):
+            prefetcher.next()
+
+    def testIteration(self):
+        values = [exposure.image[0, 0]
+                  for exposure in afwImage.ExposurePrefetcherF(self.fileNames, readAhead=3, numThreads=2)]
+        self.assertEqual(values, [1.0, 2.0, 3.0, 4.0, 5.0])
+
+    def testErrorInSequence(self):
+        # a bad file raises at its position without disturbing its neighbors
+        fileNames = list(self.fileNames)
+        fileNames[2] = os.path.join(self.tempDir.name, "no-such-file.fits")
+        prefetcher = afwImage.ExposurePrefetcherF(fileNames)
+        self.assertEqual(prefetcher.next().image[0, 0], 1.0)
+        self.assertEqual(prefetcher.next().image[0, 0], 2.0)
+        with self.assertRaises(Exception):
+            prefetcher.next()
+        self.assertEqual(prefetcher.next().image[0, 0], 4.0)
+        self.assertEqual(prefetcher.next().image[0, 0], 5.0)
+
+    def testEarlyDestruction(self):
+        # dropping a prefetcher with undelivered files must not hang or crash
+        prefetcher = afwImage.ExposurePrefetcherF(self.fileNames, readAhead=1)
+        prefetcher.next()
+        del prefetcher
+
+    def testInvalidArguments(self):
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            afwImage.ExposurePrefetcherF(self.fileNames, readAhead=0)
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            afwImage.ExposurePrefetcherF(self.fileNames, numThreads=0)
+
+    def testEmptySequence(self):
+        prefetcher = afwImage.ExposurePrefetcherF([])
+        self.assertEqual(len(prefetcher), 0)
+        self.assertFalse(prefetcher.hasNext())
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
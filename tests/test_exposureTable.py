@@ -198,6 +198,55 @@ class ExposureTableTestCase(lsst.utils.tests.TestCase):
             for key in self.plist:
                 self.assertEqual(self.plist[key], cat1.getMetadata()[key])
 
+    def testComponentSkippingFlags(self):
+        """Test reading with flags that skip deserializing selected components."""
+        with lsst.utils.tests.getTempFilePath(".fits") as tmpFile:
+            self.cat.writeFits(tmpFile)
+            # Skip everything except the Wcs
+            flags = lsst.afw.table.EXPOSURE_IO_NO_COMPONENTS & ~lsst.afw.table.EXPOSURE_IO_NO_WCS
+            cat1 = lsst.afw.table.ExposureCatalog.readFits(tmpFile, flags=flags)
+            self.assertEqual(self.cat[0].getWcs(), cat1[0].getWcs())
+            self.assertEqual(self.cat[1].getWcs(), cat1[1].getWcs())
+            # the ordinary columns are unaffected by the skips
+            self.assertEqual(self.cat[0].get(self.ka), cat1[0].get(self.ka))
+            self.assertEqual(self.cat[1].get(self.kb), cat1[1].get(self.kb))
+            self.assertIsNone(cat1[0].getPsf())
+            self.assertIsNone(cat1[0].getPhotoCalib())
+            self.assertIsNone(cat1[0].getVisitInfo())
+            self.assertIsNone(cat1[1].getValidPolygon())
+            self.assertIsNone(cat1[1].getDetector())
+            # Skipping every component doesn't read the archive at all
+            cat2 = lsst.afw.table.ExposureCatalog.readFits(
+                tmpFile, flags=lsst.afw.table.EXPOSURE_IO_NO_COMPONENTS)
+            self.assertEqual(self.cat[0].get(self.ka), cat2[0].get(self.ka))
+            self.assertIsNone(cat2[0].getWcs())
+            self.assertIsNone(cat2[1].getDetector())
+
+    def testReadFitsRows(self):
+        """Test reading a catalog in row chunks."""
+        with lsst.utils.tests.getTempFilePath(".fits") as tmpFile:
+            self.cat.writeFits(tmpFile)
+            chunk = lsst.afw.table.ExposureCatalog.readFitsRows(tmpFile, 1, 2)
+            self.assertEqual(len(chunk), 1)
+            self.assertEqual(chunk[0].getId(), 2)
+            self.assertEqual(self.cat[1].get(self.ka), chunk[0].get(self.ka))
+            self.assertEqual(self.cat[1].getWcs(), chunk[0].getWcs())
+            self.assertDetectorsEqual(chunk[0].getDetector(), self.detector)
+            # last is clamped to the catalog length
+            chunk = lsst.afw.table.ExposureCatalog.readFitsRows(tmpFile, 0, 100)
+            self.assertEqual(len(chunk), len(self.cat))
+            self.assertEqual([record.getId() for record in chunk],
+                             [record.getId() for record in self.cat])
+            # an empty range yields an empty catalog with the full schema
+            chunk = lsst.afw.table.ExposureCatalog.readFitsRows(tmpFile, 2, 2)
+            self.assertEqual(len(chunk), 0)
+            self.assertEqual(chunk.schema, lsst.afw.table.ExposureCatalog.readFits(tmpFile).schema)
+            # chunked reads combine with component-skipping flags
+            chunk = lsst.afw.table.ExposureCatalog.readFitsRows(
+                tmpFile, 1, 2, flags=lsst.afw.table.EXPOSURE_IO_NO_COMPONENTS)
+            self.assertEqual(len(chunk), 1)
+            self.assertIsNone(chunk[0].getWcs())
+
     def testGeometry(self):
         bigBox = lsst.geom.Box2D(lsst.geom.Box2I(self.bbox0))
         bigBox.include(lsst.geom.Box2D(self.bbox1))
@@ -86,6 +86,16 @@ class FitsTestCase(lsst.utils.tests.TestCase):
         # was undefined
         self.assertAlmostEqual(metadata.getScalar("DOM-WND"), 4.8)
 
+    def testPrefetch(self):
+        """Check that prefetching is harmless for present and absent files.
+
+        Prefetching is only a readahead hint, so there is nothing observable
+        to assert beyond it not raising.
+        """
+        testFile = os.path.join(testPath, "data", "ticket18864.fits")
+        lsst.afw.fits.prefetchFitsFile(testFile)
+        lsst.afw.fits.prefetchFitsFile(os.path.join(testPath, "data", "does-not-exist.fits"))
+
     def testReadBlankKeywordComment(self):
         """Read a header that uses blank keyword comments."""
         testFile = os.path.join(testPath, "data", "ticket20143.fits")
@@ -94,6 +104,71 @@ class FitsTestCase(lsst.utils.tests.TestCase):
         self.assertEqual("---- Checksums ----", metadata["COMMENT"])
         self.assertNotIn("", metadata, "Check empty strings as keys")
 
+    def testMmapManager(self):
+        """Write to an mmap-backed growable memory file and read it back."""
+        header = PropertyList()
+        header["ASTRING"] = "Test String"
+        header["ANINT"] = 42
+
+        # Start from a zero-length buffer so that every block written
+        # exercises growth within the reserved address range.
+        fitsFile = lsst.afw.fits.MemFileManager()
+        fitsFile.resetMmap(0)
+        with lsst.afw.fits.Fits(fitsFile, "w") as fits:
+            fits.createEmpty()
+            fits.writeMetadata(header)
+        with lsst.afw.fits.Fits(fitsFile, "r") as fits:
+            metadata = fits.readMetadata()
+
+        for k in self.single:
+            if k in metadata:
+                del metadata[k]
+        if "COMMENT" in metadata:
+            del metadata["COMMENT"]
+        self.assertEqual(metadata.toDict(), header.toDict())
+
+    def testRepeatedReadMetadata(self):
+        """Read the same file twice, and again after rewriting it.
+
+        Repeated reads are served from a parsed-header cache, so check that
+        they return independent copies and that rewriting the file in place
+        is picked up.
+        """
+        with lsst.utils.tests.getTempFilePath(".fits") as filename:
+            header = PropertyList()
+            header["ASTRING"] = "Test String"
+            header["ANINT"] = 42
+            with lsst.afw.fits.Fits(filename, "w") as fits:
+                fits.createEmpty()
+                fits.writeMetadata(header)
+            first = lsst.afw.fits.readMetadata(filename)
+            second = lsst.afw.fits.readMetadata(filename)
+            self.assertEqual(first.toDict(), second.toDict())
+            first["ANINT"] = 1
+            self.assertEqual(second.getScalar("ANINT"), 42)
+            self.assertEqual(lsst.afw.fits.readMetadata(filename).getScalar("ANINT"), 42)
+            header["ANINT"] = 43
+            with lsst.afw.fits.Fits(filename, "w") as fits:
+                fits.createEmpty()
+                fits.writeMetadata(header)
+            self.assertEqual(lsst.afw.fits.readMetadata(filename).getScalar("ANINT"), 43)
+
+    def testHandlePool(self):
+        """Check that pooled handles read like fresh opens and are reused."""
+        testFile = os.path.join(testPath, "data", "ticket18864.fits")
+        pool = lsst.afw.fits.FitsHandlePool(testFile)
+        self.assertEqual(pool.getFileName(), testFile)
+
+        expected = lsst.afw.fits.readMetadata(testFile)
+        lease1 = pool.acquire()
+        lease2 = pool.acquire()
+        self.assertEqual(lease1.get().readMetadata().toDict(), expected.toDict())
+        self.assertEqual(lease2.get().readMetadata().toDict(), expected.toDict())
+        del lease1, lease2
+        # A recycled handle must behave like a fresh open
+        lease3 = pool.acquire()
+        self.assertEqual(lease3.get().readMetadata().toDict(), expected.toDict())
+
     def testIgnoreKeywords(self):
         """Check that certain keywords are ignored in read/write of headers"""
         # May not appear at all in the FITS file (cfitsio doesn't write these by default)
@@ -590,6 +590,25 @@ class ImageCompressionTestCase(lsst.utils.tests.TestCase):
             image = self.makeImage(cls)
             self.checkCompressedImage(cls, image, compression, scaling, atol=self.noise/quantize)
 
+    def testThreadedWrite(self):
+        """Test that multi-threaded scaling gives identical results
+
+        The scaling/quantisation (including the fuzz) is deterministic, so
+        the pixels written with multiple threads must be bit-identical to
+        those written with a single thread.
+        """
+        compression = ImageCompressionOptions(lsst.afw.fits.compressionAlgorithmFromString("GZIP"),
+                                              quantizeLevel=0.0)
+        scaling = ImageScalingOptions(ImageScalingOptions.STDEV_BOTH, 16, quantizeLevel=4.0, fuzz=True)
+        image = self.makeImage(lsst.afw.image.ImageF)
+        unpersisted = {}
+        for threads in (1, 4):
+            options = lsst.afw.fits.ImageWriteOptions(compression, scaling)
+            options.threads = threads
+            with lsst.utils.tests.getTempFilePath(self.extension) as filename:
+                unpersisted[threads] = self.readWriteImage(lsst.afw.image.ImageF, image, filename, options)
+        self.assertFloatsEqual(unpersisted[4].getArray(), unpersisted[1].getArray())
+
     def readWriteMaskedImage(self, image, filename, imageOptions, maskOptions, varianceOptions):
         """Read the MaskedImage after it has been written
 
@@ -109,6 +109,27 @@ class FootprintTestCase(unittest.TestCase):
         for peak in self.footprint.peaks:
             self.assertNotEqual(peak['i_x'], 1)
 
+    def testPeakRecordChurn(self):
+        # Create and destroy enough peaks to cycle the record arena through
+        # several blocks, and check the surviving records are untouched
+        table = afwDet.PeakTable.make(self.schema, True)
+        catalog = afwDet.PeakCatalog(table)
+        nPeaks = 4*afwDet.PeakTable.nRecordsPerArenaBlock
+        for i in range(nPeaks):
+            record = catalog.addNew()
+            record.setIx(i)
+            record.setPeakValue(float(i))
+        # Drop every other record, then allocate a fresh batch
+        catalog = catalog[::2]
+        for i in range(nPeaks):
+            catalog.addNew().setIx(nPeaks + i)
+        self.assertEqual(len(catalog), nPeaks//2 + nPeaks)
+        for i, record in enumerate(catalog[:nPeaks//2]):
+            self.assertEqual(record.getIx(), 2*i)
+            self.assertEqual(record.getPeakValue(), float(2*i))
+        for i, record in enumerate(catalog[nPeaks//2:]):
+            self.assertEqual(record.getIx(), nPeaks + i)
+
     def testGeometry(self):
         # Move the base footprint by 2 in x and 2 in y
         offsetX = 2
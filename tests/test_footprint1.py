@@ -43,6 +43,7 @@ import lsst.afw.image as afwImage
 import lsst.afw.math as afwMath
 import lsst.afw.detection as afwDetect
 import lsst.afw.detection.utils as afwDetectUtils
+import lsst.pex.exceptions
 import lsst.afw.display as afwDisplay
 
 try:
@@ -714,6 +715,34 @@ class FootprintTestCase(lsst.utils.tests.TestCase):
             self.assertEqual(peak.getIx(), truth[0]*scaleFactor)
             self.assertEqual(peak.getIy(), truth[1]*scaleFactor)
 
+    def testTransformFootprintsBatch(self):
+        dims = lsst.geom.Extent2I(512, 512)
+        bbox = lsst.geom.Box2I(lsst.geom.Point2I(0, 0), dims)
+        offset = lsst.geom.Extent2D(123, 456)
+        crval = lsst.geom.SpherePoint(0, 0, lsst.geom.degrees)
+        crpix = lsst.geom.Point2D(0, 0)
+        cdMatrix = np.array([[1.0e-5, 0.0], [0.0, 1.0e-5]])
+        source = afwGeom.makeSkyWcs(crval=crval, crpix=crpix, cdMatrix=cdMatrix)
+        target = afwGeom.makeSkyWcs(crval=crval, crpix=crpix + offset, cdMatrix=cdMatrix)
+
+        footprints = []
+        for radius, x, y in [(5, 12, 34), (3, 300, 200), (8, 40, 400)]:
+            spans = afwGeom.SpanSet.fromShape(radius, afwGeom.Stencil.CIRCLE).shiftedBy(x, y)
+            footprint = afwDetect.Footprint(spans, bbox)
+            footprint.addPeak(x, y, 10)
+            footprints.append(footprint)
+
+        transformed = afwDetect.transformFootprints(footprints, source, target, bbox)
+        self.assertEqual(len(transformed), len(footprints))
+        for fpBatch, fpSource in zip(transformed, footprints):
+            check = fpSource.transform(source, target, bbox)
+            self.assertEqual(fpBatch.getSpans(), check.getSpans())
+            self.assertEqual(fpBatch.getRegion(), check.getRegion())
+            for peakBatch, peakCheck in zip(fpBatch.peaks, check.peaks):
+                self.assertEqual(peakBatch.getFx(), peakCheck.getFx())
+                self.assertEqual(peakBatch.getFy(), peakCheck.getFy())
+                self.assertEqual(peakBatch.getPeakValue(), peakCheck.getPeakValue())
+
     def testCopyWithinFootprintImage(self):
         W, H = 10, 10
         dims = lsst.geom.Extent2I(W, H)
@@ -1061,6 +1090,36 @@ class FootprintSetTestCase(unittest.TestCase):
         for i in range(len(objects)):
             self.assertEqual(objects[i], self.objects[i])
 
+    def testFootprintsImageVariance(self):
+        """Check detection on an Image thresholded against a separate variance plane"""
+        threshold = 4.5                 # in units of sigma
+
+        self.ms[2, 4, afwImage.LOCAL] = (10, 0x0, 36)  # not detected (high variance)
+
+        y, x = self.objects[2].spans[0][0:2]
+        self.ms[x, y, afwImage.LOCAL] = (threshold, 0x0, 1.0)
+
+        ds = afwDetect.FootprintSet(self.ms.getImage(), self.ms.getVariance(),
+                                    afwDetect.createThreshold(threshold, "pixel_stdev"))
+
+        objects = ds.getFootprints()
+
+        self.assertEqual(len(objects), len(self.objects))
+        for i in range(len(objects)):
+            self.assertEqual(objects[i], self.objects[i])
+
+        # The equivalent MaskedImage detection must find the same objects
+        ds2 = afwDetect.FootprintSet(self.ms, afwDetect.createThreshold(threshold, "pixel_stdev"))
+        self.assertEqual(len(ds2.getFootprints()), len(objects))
+
+        # Only PIXEL_STDEV thresholds make sense with a separate variance plane
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwDetect.FootprintSet(self.ms.getImage(), self.ms.getVariance(), afwDetect.Threshold(10))
+        # Dimensions must match
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwDetect.FootprintSet(self.ms.getImage(), afwImage.ImageF(3, 3),
+                                   afwDetect.createThreshold(threshold, "pixel_stdev"))
+
     def testFootprintsMasks(self):
         """Check that detectionSets have the proper mask bits set"""
         ds = afwDetect.FootprintSet(self.ms, afwDetect.Threshold(10), "OBJECT")
@@ -1141,6 +1200,114 @@ class FootprintSetTestCase(unittest.TestCase):
 
         self.assertEqual(len(foot.getPeaks()), 5)
 
+    def testFootprintsParallel(self):
+        """Check that a multi-threaded scan finds the same Footprints as a serial one"""
+        def footprintKeys(fs):
+            return sorted(sorted((sp.getY(), sp.getX0(), sp.getX1()) for sp in foot.getSpans())
+                          for foot in fs.getFootprints())
+
+        # self.ms is 8 rows, so 4 threads puts strip seams through the objects
+        serial = afwDetect.FootprintSet(self.ms, afwDetect.Threshold(10))
+        parallel = afwDetect.FootprintSet(self.ms, afwDetect.Threshold(10), numThreads=4)
+        self.assertEqual(footprintKeys(parallel), footprintKeys(serial))
+
+        # A busier image, with objects crossing every seam
+        im = afwImage.ImageF(64, 64)
+        rng = np.random.Generator(np.random.MT19937(12345))
+        im.getArray()[:, :] = rng.normal(0.0, 1.0, size=(64, 64))
+        for numThreads in (2, 5):
+            serial = afwDetect.FootprintSet(im, afwDetect.Threshold(1), 1)
+            parallel = afwDetect.FootprintSet(im, afwDetect.Threshold(1), 1, numThreads=numThreads)
+            self.assertEqual(footprintKeys(parallel), footprintKeys(serial))
+
+    def testMergeParallel(self):
+        """Check that a multi-threaded merge matches a serial one, in the same order"""
+        im1 = afwImage.ImageF(64, 64)
+        im2 = afwImage.ImageF(64, 64)
+        rng = np.random.Generator(np.random.MT19937(6789))
+        im1.getArray()[:, :] = rng.normal(0.0, 1.0, size=(64, 64))
+        im2.getArray()[:, :] = rng.normal(0.0, 1.0, size=(64, 64))
+
+        def makeMerged(numThreads):
+            fs1 = afwDetect.FootprintSet(im1, afwDetect.Threshold(1), 1)
+            fs2 = afwDetect.FootprintSet(im2, afwDetect.Threshold(1), 1)
+            fs1.merge(fs2, 1, 1, numThreads=numThreads)
+            return fs1
+
+        serial = makeMerged(1)
+        for numThreads in (2, 5):
+            parallel = makeMerged(numThreads)
+            self.assertEqual(len(parallel.getFootprints()),
+                             len(serial.getFootprints()))
+            for foot, expected in zip(parallel.getFootprints(), serial.getFootprints()):
+                self.assertEqual([(sp.getY(), sp.getX0(), sp.getX1()) for sp in foot.getSpans()],
+                                 [(sp.getY(), sp.getX0(), sp.getX1()) for sp in expected.getSpans()])
+                self.assertEqual([(p.getIx(), p.getIy()) for p in foot.getPeaks()],
+                                 [(p.getIx(), p.getIy()) for p in expected.getPeaks()])
+
+    def testMakeMultiThreshold(self):
+        """Check that a single-scan multi-threshold detection matches repeated single scans"""
+        im = afwImage.ImageF(64, 64)
+        rng = np.random.Generator(np.random.MT19937(54321))
+        im.getArray()[:, :] = rng.normal(0.0, 3.0, size=(64, 64))
+
+        thresholds = [afwDetect.Threshold(2), afwDetect.Threshold(5), afwDetect.Threshold(9)]
+        multi = afwDetect.FootprintSet.makeMultiThreshold(im, thresholds, 2)
+        self.assertEqual(len(multi), len(thresholds))
+
+        for fs, threshold in zip(multi, thresholds):
+            single = afwDetect.FootprintSet(im, threshold, 2)
+            self.assertEqual(len(fs.getFootprints()), len(single.getFootprints()))
+            for foot, expected in zip(fs.getFootprints(), single.getFootprints()):
+                self.assertEqual([(sp.getY(), sp.getX0(), sp.getX1()) for sp in foot.getSpans()],
+                                 [(sp.getY(), sp.getX0(), sp.getX1()) for sp in expected.getSpans()])
+                self.assertEqual([(p.getIx(), p.getIy()) for p in foot.getPeaks()],
+                                 [(p.getIx(), p.getIy()) for p in expected.getPeaks()])
+
+        # thresholds may be given in any order, and results come back in that order
+        shuffled = afwDetect.FootprintSet.makeMultiThreshold(im, thresholds[::-1], 2)
+        for fs, expected in zip(shuffled[::-1], multi):
+            self.assertEqual(len(fs.getFootprints()), len(expected.getFootprints()))
+
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwDetect.FootprintSet.makeMultiThreshold(
+                im, [afwDetect.Threshold(2), afwDetect.Threshold(5, afwDetect.Threshold.VALUE, False)])
+
+    def testDetectOnConvolvedImage(self):
+        """Check that fused convolve-and-detect matches convolve-then-detect"""
+        # tall enough that the convolution is done in more than one band, with
+        # a pair of objects straddling the band seam
+        im = afwImage.ImageF(64, 300)
+        im.setXY0(100, -20)
+        rng = np.random.Generator(np.random.MT19937(666))
+        im.getArray()[:, :] = rng.normal(0.0, 0.5, size=(300, 64))
+        for x, y, peak in [(10, 12, 30), (11, 13, 20), (40, 5, 25), (30, 150, 40), (62, 298, 35),
+                           (20, 255, 30), (21, 257, 25)]:
+            im[x, y, afwImage.LOCAL] += peak
+
+        kernel = afwMath.AnalyticKernel(7, 7, afwMath.GaussianFunction2D(1.5, 1.5))
+        threshold = afwDetect.Threshold(3)
+
+        smoothed = im.Factory(im.getDimensions())
+        afwMath.convolve(smoothed, im, kernel)
+        expected = afwDetect.FootprintSet(smoothed, threshold)
+
+        fused = afwDetect.detectOnConvolvedImage(im, kernel, threshold)
+        self.assertEqual(fused.getRegion(), im.getBBox())
+
+        expectedFeet = expected.getFootprints()
+        fusedFeet = fused.getFootprints()
+        self.assertEqual(len(fusedFeet), len(expectedFeet))
+        for foot, expect in zip(fusedFeet, expectedFeet):
+            self.assertEqual([(sp.getY(), sp.getX0(), sp.getX1()) for sp in foot.getSpans()],
+                             [(sp.getY(), sp.getX0(), sp.getX1()) for sp in expect.getSpans()])
+            self.assertEqual([(p.getIx(), p.getIy()) for p in foot.getPeaks()],
+                             [(p.getIx(), p.getIy()) for p in expect.getPeaks()])
+
+        # only absolute thresholds make sense: the smoothed frame is never available as a whole
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwDetect.detectOnConvolvedImage(im, kernel, afwDetect.Threshold(3, afwDetect.Threshold.STDEV))
+
 
 class MaskFootprintSetTestCase(unittest.TestCase):
     """A test case for generating FootprintSet from Masks"""
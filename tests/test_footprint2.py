@@ -30,6 +30,8 @@ or
 
 import unittest
 
+import numpy as np
+
 import lsst.utils.tests
 import lsst.geom
 import lsst.afw.image as afwImage
@@ -126,6 +128,42 @@ class FootprintSetTestCase(unittest.TestCase):
         for i in range(len(objects)):
             self.assertEqual(objects[i], self.objects[i])
 
+    def testSetMaskNumThreads(self):
+        """Check that parallel mask stamping sets the same bits as the serial path"""
+        ds = afwDetect.FootprintSet(self.im, afwDetect.Threshold(10))
+
+        serial = afwImage.Mask(self.im.getDimensions())
+        serial.addMaskPlane("DETECTED")
+        ds.setMask(serial, "DETECTED")
+
+        for numThreads in (2, 4, 64):
+            parallel = afwImage.Mask(self.im.getDimensions())
+            parallel.addMaskPlane("DETECTED")
+            ds.setMask(parallel, "DETECTED", numThreads)
+            self.assertTrue(np.all(serial.getArray() == parallel.getArray()),
+                            msg="numThreads=%d" % (numThreads,))
+
+    def testFindOverlapping(self):
+        """Check that indexed overlap queries agree with a linear scan"""
+        ds = afwDetect.FootprintSet(self.im, afwDetect.Threshold(10))
+        footprints = ds.getFootprints()
+
+        boxes = [lsst.geom.Box2I(lsst.geom.Point2I(3, 1), lsst.geom.Extent2I(3, 3)),
+                 lsst.geom.Box2I(lsst.geom.Point2I(7, 5), lsst.geom.Extent2I(4, 2)),
+                 lsst.geom.Box2I(lsst.geom.Point2I(0, 0), lsst.geom.Extent2I(12, 8)),
+                 lsst.geom.Box2I(lsst.geom.Point2I(11, 0), lsst.geom.Extent2I(1, 1))]
+        for box in boxes:
+            expected = [foot for foot in footprints if foot.getBBox().overlaps(box)]
+            self.assertEqual(ds.findOverlapping(box), expected)
+        self.assertEqual(ds.findOverlapping(boxes),
+                         [ds.findOverlapping(box) for box in boxes])
+
+        # The SpanSet query requires real pixel overlap, not just bbox overlap
+        spans = afwGeom.SpanSet([afwGeom.Span(1, 5, 11)])
+        expected = [foot for foot in footprints if foot.spans.overlaps(spans)]
+        self.assertEqual(ds.findOverlapping(spans), expected)
+        self.assertLess(len(expected), len(ds.findOverlapping(spans.getBBox())))
+
     def testFootprintsImageId(self):
         """Check that we can insert footprints into an Image"""
         ds = afwDetect.FootprintSet(self.im, afwDetect.Threshold(10))
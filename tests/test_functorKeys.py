@@ -103,6 +103,115 @@ class FunctorKeysTestCase(lsst.utils.tests.TestCase):
         self.doTestPointKey("D", lsst.afw.table.Point2DKey,
                             lsst.geom.Point2D)
 
+    def testPointKeyArrays(self):
+        schema = lsst.afw.table.Schema()
+        fKey = lsst.afw.table.Point2DKey.addFields(
+            schema, "a", "position", "pixel")
+        catalog = lsst.afw.table.BaseCatalog(schema)
+        catalog.reserve(5)
+        for i in range(5):
+            record = catalog.addNew()
+            record.set(fKey, lsst.geom.Point2D(i, 2*i))
+        columns = catalog.getColumnView()
+        x, y = fKey.getArrays(columns)
+        self.assertFloatsEqual(x, numpy.arange(5, dtype=float))
+        self.assertFloatsEqual(y, 2*numpy.arange(5, dtype=float))
+        # the returned arrays are views into the catalog's memory
+        x[2] = 40.0
+        self.assertEqual(catalog[2].get(fKey.getX()), 40.0)
+        # setArrays scatters arrays back into the columns
+        fKey.setArrays(columns, numpy.ones(5), numpy.zeros(5))
+        for record in catalog:
+            self.assertEqual(record.get(fKey), lsst.geom.Point2D(1.0, 0.0))
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            fKey.setArrays(columns, numpy.ones(4), numpy.zeros(5))
+
+    def testCoordKeyArrays(self):
+        schema = lsst.afw.table.Schema()
+        fKey = lsst.afw.table.CoordKey.addFields(schema, "a", "position")
+        catalog = lsst.afw.table.BaseCatalog(schema)
+        catalog.reserve(3)
+        for i in range(3):
+            record = catalog.addNew()
+            record.set(fKey, lsst.geom.SpherePoint(
+                0.1*i*lsst.geom.radians, 0.05*i*lsst.geom.radians))
+        ra, dec = fKey.getArrays(catalog.getColumnView())
+        self.assertFloatsAlmostEqual(ra, 0.1*numpy.arange(3), rtol=1E-15)
+        self.assertFloatsAlmostEqual(dec, 0.05*numpy.arange(3), rtol=1E-15)
+        # the returned (radian) arrays are views into the catalog's memory
+        dec[1] = 0.25
+        self.assertFloatsAlmostEqual(
+            catalog[1].get(fKey.getDec()).asRadians(), 0.25, rtol=1E-15)
+
+    def testCoordKeyUnitVectors(self):
+        schema = lsst.afw.table.Schema()
+        fKey = lsst.afw.table.CoordKey.addFields(schema, "a", "position")
+        catalog = lsst.afw.table.BaseCatalog(schema)
+        catalog.reserve(4)
+        points = [lsst.geom.SpherePoint(30.0*i*lsst.geom.degrees, (15.0*i - 20.0)*lsst.geom.degrees)
+                  for i in range(4)]
+        for point in points:
+            catalog.addNew().set(fKey, point)
+        columns = catalog.getColumnView()
+        vectors = fKey.getUnitVectors(columns)
+        expected = numpy.array([[point.getVector()[i] for i in range(3)] for point in points])
+        self.assertFloatsAlmostEqual(vectors, expected, rtol=1E-15)
+        # setUnitVectors should accept unnormalized vectors and round-trip
+        # through SpherePoint semantics, including longitude wrapping.
+        fKey.setUnitVectors(columns, 2.5*expected[::-1].copy())
+        for record, point in zip(catalog, reversed(points)):
+            self.assertAlmostEqual(
+                record.get(fKey).separation(point).asRadians(), 0.0, places=15)
+            self.assertGreaterEqual(record.get(fKey.getRa()).asRadians(), 0.0)
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            fKey.setUnitVectors(columns, expected[:2].copy())
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            fKey.setUnitVectors(columns, numpy.zeros((4, 2), dtype=float))
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            fKey.setUnitVectors(columns, numpy.zeros((4, 3), dtype=float))
+
+    def testCovarianceMatrixKeyArrays(self):
+        schema = lsst.afw.table.Schema()
+        fKey = lsst.afw.table.CovarianceMatrix2fKey.addFields(
+            schema, "a", ["x", "y"], "pixel")
+        catalog = lsst.afw.table.BaseCatalog(schema)
+        catalog.reserve(4)
+        for i in range(4):
+            record = catalog.addNew()
+            fKey.setElement(record, 0, 0, 1.0 + i)
+            fKey.setElement(record, 1, 1, 2.0 + i)
+            fKey.setElement(record, 0, 1, 0.5*i)
+        columns = catalog.getColumnView()
+        self.assertFloatsAlmostEqual(fKey.getElementArray(columns, 0, 0),
+                                     1.0 + numpy.arange(4), rtol=1E-6)
+        self.assertFloatsAlmostEqual(fKey.getElementArray(columns, 1, 1),
+                                     2.0 + numpy.arange(4), rtol=1E-6)
+        self.assertFloatsAlmostEqual(fKey.getElementArray(columns, 1, 0),
+                                     0.5*numpy.arange(4), rtol=1E-6)
+        # the inverse: set a whole element column from an array
+        fKey.setElementArray(columns, 0, 0, numpy.full(4, 4.0, dtype=numpy.float32))
+        fKey.setElementArray(columns, 0, 1, numpy.full(4, -1.0, dtype=numpy.float32))
+        for record in catalog:
+            self.assertFloatsAlmostEqual(
+                fKey.getElement(record, 0, 0), 4.0, rtol=1E-6)
+            self.assertFloatsAlmostEqual(
+                fKey.getElement(record, 1, 0), -1.0, rtol=1E-6)
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            fKey.setElementArray(columns, 0, 0,
+                                 numpy.zeros(3, dtype=numpy.float32))
+        # a variance-only key has no field for off-diagonal elements
+        schema2 = lsst.afw.table.Schema()
+        fKey2 = lsst.afw.table.CovarianceMatrix2fKey.addFields(
+            schema2, "b", ["x", "y"], "pixel", diagonalOnly=True)
+        catalog2 = lsst.afw.table.BaseCatalog(schema2)
+        catalog2.addNew()
+        columns2 = catalog2.getColumnView()
+        self.assertFloatsEqual(fKey2.getElementArray(columns2, 0, 1),
+                               numpy.zeros(1, dtype=numpy.float32))
+        with self.assertRaises(lsst.pex.exceptions.LogicError):
+            fKey2.setElementArray(columns2, 0, 1,
+                                  numpy.zeros(1, dtype=numpy.float32))
+
     def doTestBoxKey(self, pointFieldType, functorKeyType, valueType):
         """Run type-parameterized tests on a Box FunctorKey.
 
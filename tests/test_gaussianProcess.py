@@ -1090,6 +1090,112 @@ class GaussianProcessTestCase(lsst.utils.tests.TestCase):
         self.assertLess(worstMuErr, tol)
         self.assertLess(worstSigErr, tol)
 
+    def testBatchedNeighborInterpolate(self):
+        """
+        Test the batched version of GaussianProcess.interpolate that accepts
+        a 2-D array of query points.
+
+        The batched method sorts each query's neighbor set by index before
+        solving, so its results can differ from the one-point-at-a-time
+        interpolate() at the level of round-off; verify agreement to a
+        tolerance well above machine precision but far below the statistical
+        uncertainty of the interpolation.  Also verify that running with
+        multiple threads gives results identical to running serially.
+        """
+        rng = np.random.RandomState(119)
+        pp = 200
+        dd = 4
+        kk = 10
+        nQueries = 53
+
+        data = rng.random_sample((pp, dd))
+        fn = rng.random_sample(pp)
+
+        xx = afwMath.SquaredExpCovariogramD()
+        xx.setEllSquared(2.0)
+
+        gg = afwMath.GaussianProcessD(data, fn, xx)
+        gg.setLambda(0.002)
+
+        queries = rng.random_sample((nQueries, dd))
+
+        mu = np.zeros(nQueries)
+        sig2 = np.zeros(nQueries)
+        gg.interpolate(mu, sig2, queries, kk)
+
+        sigmaShld = np.zeros(1)
+        worstMuErr = -1.0
+        worstSigErr = -1.0
+        for q in range(nQueries):
+            muShld = gg.interpolate(sigmaShld, queries[q], kk)
+            err = np.abs(mu[q] - muShld)
+            if muShld != 0.0:
+                err = err / np.abs(muShld)
+            if err > worstMuErr:
+                worstMuErr = err
+            err = np.abs(sig2[q] - sigmaShld[0])
+            if sigmaShld[0] != 0.0:
+                err = err / np.abs(sigmaShld[0])
+            if err > worstSigErr:
+                worstSigErr = err
+
+        self.assertLess(worstMuErr, 1.0e-10)
+        self.assertLess(worstSigErr, 1.0e-10)
+
+        # multi-threaded results must be identical to serial results, since
+        # the threads just partition the list of queries
+        muThreaded = np.zeros(nQueries)
+        sig2Threaded = np.zeros(nQueries)
+        gg.interpolate(muThreaded, sig2Threaded, queries, kk, numThreads=4)
+
+        for q in range(nQueries):
+            self.assertEqual(mu[q], muThreaded[q])
+            self.assertEqual(sig2[q], sig2Threaded[q])
+
+        # the normalized-coordinate constructor should go through the same
+        # code path
+        mins = np.zeros(dd)
+        maxs = np.ones(dd)
+        ggMinMax = afwMath.GaussianProcessD(data, mins, maxs, fn, xx)
+        ggMinMax.setLambda(0.002)
+        ggMinMax.interpolate(mu, sig2, queries, kk)
+
+        worstMuErr = -1.0
+        for q in range(nQueries):
+            muShld = ggMinMax.interpolate(sigmaShld, queries[q], kk)
+            err = np.abs(mu[q] - muShld)
+            if muShld != 0.0:
+                err = err / np.abs(muShld)
+            if err > worstMuErr:
+                worstMuErr = err
+
+        self.assertLess(worstMuErr, 1.0e-10)
+
+        # exceptions: the batched method only supports a single function
+        many_fn = rng.random_sample((pp, 3))
+        gg_many = afwMath.GaussianProcessD(data, many_fn, xx)
+        with self.assertRaises(RuntimeError) as context:
+            gg_many.interpolate(mu, sig2, queries, kk)
+        self.assertIn("single function", context.exception.args[0])
+
+        with self.assertRaises(RuntimeError) as context:
+            gg.interpolate(mu, sig2, queries, 0)
+        self.assertIn("zero or negative number of neighbors",
+                      context.exception.args[0])
+
+        with self.assertRaises(RuntimeError) as context:
+            gg.interpolate(mu, sig2, queries, pp + 1)
+        self.assertIn("more neighbors than you have",
+                      context.exception.args[0])
+
+        with self.assertRaises(RuntimeError) as context:
+            gg.interpolate(mu, sig2, rng.random_sample((nQueries, dd + 1)), kk)
+        self.assertIn("different dimensionality", context.exception.args[0])
+
+        with self.assertRaises(RuntimeError) as context:
+            gg.interpolate(np.zeros(nQueries - 1), sig2, queries, kk)
+        self.assertIn("improperly sized", context.exception.args[0])
+
     def testMinMax(self):
         """
         This test will test GaussianProcess.interpolate using the constructor
@@ -1452,6 +1558,107 @@ class GaussianProcessTestCase(lsst.utils.tests.TestCase):
         print("worst mu error ", worstMuErr)
         print("worst sig2 error ", worstVarErr)
 
+    def testInducingPointBatchInterpolate(self):
+        """
+        Test the subset-of-regressors approximation mode of batchInterpolate
+        that is enabled with setMaxInducingPoints.
+
+        Interpolate a smooth function and check that the approximate results
+        agree with the exact results to a tolerance much smaller than the
+        scale of the function.  Also check that setting the number of
+        inducing points to zero (or to more points than exist) restores the
+        exact calculation.
+        """
+        rng = np.random.RandomState(432)
+        pp = 300
+        dd = 2
+        nQueries = 40
+        tol = 0.01
+
+        data = rng.random_sample((pp, dd))
+        fn = np.sin(data[:, 0]) + np.cos(data[:, 1])
+
+        xx = afwMath.SquaredExpCovariogramD()
+        xx.setEllSquared(0.5)
+
+        gg = afwMath.GaussianProcessD(data, fn, xx)
+
+        queries = rng.random_sample((nQueries, dd))
+
+        muExact = np.zeros(nQueries)
+        varExact = np.zeros(nQueries)
+        gg.batchInterpolate(muExact, varExact, queries)
+
+        # asking for at least as many inducing points as there are data
+        # points should fall back to the exact calculation
+        mu = np.zeros(nQueries)
+        var = np.zeros(nQueries)
+        gg.setMaxInducingPoints(pp)
+        gg.batchInterpolate(mu, var, queries)
+        for i in range(nQueries):
+            self.assertEqual(mu[i], muExact[i])
+            self.assertEqual(var[i], varExact[i])
+
+        # the approximation should reproduce the exact mean to well within
+        # the scale of the function being interpolated
+        gg.setMaxInducingPoints(60)
+        gg.batchInterpolate(mu, var, queries)
+
+        worstMuErr = -1.0
+        for i in range(nQueries):
+            err = np.abs(mu[i] - muExact[i])
+            if err > worstMuErr:
+                worstMuErr = err
+            self.assertGreater(var[i], 0.0)
+
+        print("\nThe errors for inducing point batch interpolation\n")
+        print("worst mu error ", worstMuErr)
+        self.assertLess(worstMuErr, tol)
+
+        # the version without variances should give the same mean
+        muNoVar = np.zeros(nQueries)
+        gg.batchInterpolate(muNoVar, queries)
+        for i in range(nQueries):
+            self.assertEqual(muNoVar[i], mu[i])
+
+        # the many-function version should approximate each function
+        manyFn = np.zeros((pp, 2))
+        manyFn[:, 0] = fn
+        manyFn[:, 1] = data[:, 0] * data[:, 1]
+        ggMany = afwMath.GaussianProcessD(data, manyFn, xx)
+
+        muManyExact = np.zeros((nQueries, 2))
+        ggMany.batchInterpolate(muManyExact, queries)
+
+        muMany = np.zeros((nQueries, 2))
+        varMany = np.zeros((nQueries, 2))
+        ggMany.setMaxInducingPoints(60)
+        ggMany.batchInterpolate(muMany, varMany, queries)
+
+        worstMuErr = -1.0
+        for i in range(nQueries):
+            for ifn in range(2):
+                err = np.abs(muMany[i][ifn] - muManyExact[i][ifn])
+                if err > worstMuErr:
+                    worstMuErr = err
+            # the variance is shared by all of the functions
+            self.assertEqual(varMany[i][0], varMany[i][1])
+
+        self.assertLess(worstMuErr, tol)
+
+        # setting the number of inducing points back to zero restores
+        # the exact calculation
+        gg.setMaxInducingPoints(0)
+        gg.batchInterpolate(mu, var, queries)
+        for i in range(nQueries):
+            self.assertEqual(mu[i], muExact[i])
+            self.assertEqual(var[i], varExact[i])
+
+        with self.assertRaises(RuntimeError) as context:
+            gg.setMaxInducingPoints(-1)
+        self.assertIn("negative number of inducing points",
+                      context.exception.args[0])
+
     def testSelf(self):
         """
         This test will test GaussianProcess.selfInterpolation
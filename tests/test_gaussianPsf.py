@@ -106,6 +106,37 @@ class GaussianPsfTestCase(lsst.utils.tests.TestCase):
         self.assertEqual(self.psf.computeKernelImage(lsst.geom.Point2D(0.0, 0.0)).getBBox(),
                          self.psf.computeBBox(lsst.geom.Point2D(0.0, 0.0)))
 
+    def testImageBatch(self):
+        positions = [lsst.geom.Point2D(0.25, 0.25),
+                     lsst.geom.Point2D(10.5, -3.0),
+                     lsst.geom.Point2D(0.25, 0.25)]
+        images = self.psf.computeImageBatch(positions)
+        self.assertEqual(len(images), len(positions))
+        for image, position in zip(images, positions):
+            check = self.psf.computeImage(position)
+            self.assertFloatsEqual(image.getArray(), check.getArray())
+
+    def testApertureFluxBatch(self):
+        radii = np.array([1.0, 2.5, 4.0])
+        positions = [lsst.geom.Point2D(0.25, 0.25),
+                     lsst.geom.Point2D(10.5, -3.0),
+                     lsst.geom.Point2D(0.25, 0.25)]
+        fluxes = self.psf.computeApertureFluxBatch(radii, positions)
+        self.assertEqual(fluxes.shape, (len(positions), len(radii)))
+        for i, position in enumerate(positions):
+            for j, radius in enumerate(radii):
+                self.assertFloatsEqual(fluxes[i, j], self.psf.computeApertureFlux(radius, position))
+
+    def testCachePositionTolerance(self):
+        # GaussianPsf is fixed, so use the tolerance accessors only to check
+        # the round trip; quantization itself cannot change a fixed PSF
+        self.assertEqual(self.psf.getCachePositionTolerance(), 0.0)
+        self.psf.setCachePositionTolerance(0.5)
+        self.assertEqual(self.psf.getCachePositionTolerance(), 0.5)
+        image = self.psf.computeKernelImage(lsst.geom.Point2D(10.1, 10.2))
+        check = makeGaussianImage(image.getBBox(), self.psf.getSigma())
+        self.assertFloatsAlmostEqual(image.getArray(), check.getArray())
+
     def testResized(self):
         for pad in [0, -10, 10]:
             newLen = self.kernelSize - pad
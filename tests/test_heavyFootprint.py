@@ -110,6 +110,34 @@ class HeavyFootprintTestCase(lsst.utils.tests.TestCase):
         for x in arr:
             pass
 
+    def testLazy(self):
+        """Check that a lazy HeavyFootprint defers copying the parent pixels"""
+
+        ctrl = afwDetect.HeavyFootprintCtrl()
+        ctrl.setLazy(True)
+        hfoot = afwDetect.makeHeavyFootprint(self.foot, self.mi, ctrl)
+        self.assertFalse(hfoot.isMaterialized())
+
+        # insert reads through the parent reference without materializing
+        omi = self.mi.Factory(self.mi.getDimensions())
+        hfoot.insert(omi)
+        self.assertFalse(hfoot.isMaterialized())
+
+        eager = afwDetect.makeHeavyFootprint(self.foot, self.mi)
+        emi = self.mi.Factory(self.mi.getDimensions())
+        eager.insert(emi)
+        self.assertMaskedImagesEqual(omi, emi)
+
+        # Accessing the arrays forces materialization, after which the
+        # flattened pixels must match the eager copy
+        self.assertFloatsEqual(hfoot.getImageArray(), eager.getImageArray())
+        self.assertTrue(hfoot.isMaterialized())
+        self.assertFloatsEqual(hfoot.getVarianceArray(), eager.getVarianceArray())
+        self.assertEqual(hfoot.getMaskBitsSet(), eager.getMaskBitsSet())
+
+        # An eager HeavyFootprint is born materialized
+        self.assertTrue(eager.isMaterialized())
+
     def testSetFootprint(self):
         """Check that we can create a HeavyFootprint and set the pixels under it"""
 
@@ -301,6 +329,48 @@ class HeavyFootprintTestCase(lsst.utils.tests.TestCase):
             self.assertEqual(hfp1.dot(hfp2), dot)
             self.assertEqual(hfp2.dot(hfp1), dot)
 
+    def testBulkInsertExtract(self):
+        """Test makeHeavyFootprints and insertHeavyFootprints over many footprints"""
+        width, height = 40, 60
+        mi = afwImage.MaskedImageF(width, height)
+        mi.setXY0(lsst.geom.Point2I(5, -7))
+        np.random.seed(42)
+        mi.image.array[:] = np.random.randn(height, width).astype(np.float32)
+        mi.variance.array[:] = 1.0
+        x0, y0 = mi.getXY0()
+
+        # Two-row footprints starting every fourth row, so with four row bands
+        # some of them straddle a band boundary
+        footprints = []
+        for i, y in enumerate(range(y0 + 1, y0 + height - 2, 4)):
+            spanSet = afwGeom.SpanSet([afwGeom.Span(y, x0 + 2, x0 + 10),
+                                       afwGeom.Span(y + 1, x0 + 3, x0 + 20 + i % 7)])
+            footprints.append(afwDetect.Footprint(spanSet))
+
+        heavies = afwDetect.makeHeavyFootprints(footprints, mi, numThreads=4)
+        self.assertEqual(len(heavies), len(footprints))
+        for foot, heavy in zip(footprints, heavies):
+            expected = afwDetect.makeHeavyFootprint(foot, mi)
+            self.assertFloatsEqual(heavy.getImageArray(), expected.getImageArray())
+            self.assertFloatsEqual(heavy.getVarianceArray(), expected.getVarianceArray())
+
+        # The parallel insert must reproduce a serial loop over the heavies
+        serial = afwImage.MaskedImageF(mi.getBBox())
+        for heavy in heavies:
+            heavy.insert(serial)
+        parallel = afwImage.MaskedImageF(mi.getBBox())
+        afwDetect.insertHeavyFootprints(heavies, parallel, numThreads=4)
+        self.assertFloatsEqual(parallel.image.array, serial.image.array)
+        self.assertFloatsEqual(parallel.variance.array, serial.variance.array)
+
+        # Image-only insert; None entries are skipped
+        img = afwImage.ImageF(mi.getBBox())
+        afwDetect.insertHeavyFootprints(heavies[:-1] + [None], img, numThreads=3)
+        imgSerial = afwImage.ImageF(mi.getBBox())
+        for heavy in heavies[:-1]:
+            heavy.insert(imgSerial)
+        self.assertFloatsEqual(img.array, imgSerial.array)
+
 
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
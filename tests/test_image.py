@@ -485,6 +485,39 @@ class ImageTestCase(lsst.utils.tests.TestCase):
 
         self.assertRaises(lsst.pex.exceptions.LengthError, tst)
 
+    def testExtractCutouts(self):
+        parent = afwImage.ImageF(lsst.geom.Box2I(lsst.geom.Point2I(5, -3),
+                                                 lsst.geom.Extent2I(40, 30)))
+        parent.array[:] = np.random.uniform(low=0, high=10,
+                                            size=parent.array.shape).astype(np.float32)
+
+        boxes = []
+        for _ in range(20):
+            width = np.random.randint(1, 8)
+            height = np.random.randint(1, 8)
+            x0 = np.random.randint(5, 45 - width)
+            y0 = np.random.randint(-3, 27 - height)
+            boxes.append(lsst.geom.Box2I(lsst.geom.Point2I(x0, y0),
+                                         lsst.geom.Extent2I(width, height)))
+
+        cutouts = afwImage.extractCutouts(parent, boxes)
+        self.assertEqual(len(cutouts), len(boxes))
+        for box, cutout in zip(boxes, cutouts):
+            self.assertEqual(cutout.getBBox(), box)
+            self.assertImagesEqual(cutout, parent.subset(box))
+
+        # the cutouts are deep copies, not views into the parent
+        saved = cutouts[0].array.copy()
+        parent.array += 1
+        self.assertFloatsEqual(cutouts[0].array, saved)
+
+        # empty boxes and boxes extending beyond the parent are rejected
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            afwImage.extractCutouts(parent, [lsst.geom.Box2I()])
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            afwImage.extractCutouts(
+                parent, [lsst.geom.Box2I(lsst.geom.Point2I(0, 0), lsst.geom.Extent2I(3, 3))])
+
     def testImageInitialisation(self):
         dims = self.image1.getDimensions()
         factory = self.image1.Factory
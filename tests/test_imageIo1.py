@@ -26,6 +26,8 @@ import itertools
 import os.path
 import unittest
 
+import numpy as np
+
 import lsst.utils
 import lsst.daf.base as dafBase
 import lsst.geom
@@ -99,6 +101,33 @@ class ReadFitsTestCase(lsst.utils.tests.TestCase):
             im.writeFits(tmpFile)
             afwImage.ImageD(tmpFile)
 
+    def testDecoratedImageOverlappedRead(self):
+        """Test the overlapped header+pixel read and metadata-only open"""
+        with lsst.utils.tests.getTempFilePath(".fits") as tmpFile:
+            im = afwImage.DecoratedImageF(lsst.geom.Extent2I(20, 10))
+            im.image.array[:] = np.arange(200, dtype=np.float32).reshape(10, 20)
+            im.image.setXY0(lsst.geom.Point2I(5, 7))
+            im.getMetadata().set("TESTKEY", 42)
+            im.writeFits(tmpFile)
+
+            ref = afwImage.DecoratedImageF(tmpFile)
+            overlapped = afwImage.DecoratedImageF.readFitsOverlapped(tmpFile)
+            self.assertImagesEqual(overlapped.image, ref.image)
+            self.assertEqual(overlapped.getX0(), ref.getX0())
+            self.assertEqual(overlapped.getY0(), ref.getY0())
+            self.assertEqual(overlapped.getMetadata().toDict(),
+                             ref.getMetadata().toDict())
+
+            # the metadata-only open returns the same (stripped) header
+            # without touching the data unit
+            metadata = afwImage.DecoratedImageF.readMetadata(tmpFile)
+            self.assertEqual(metadata.toDict(), ref.getMetadata().toDict())
+
+        with self.assertRaises(afwFits.FitsError):
+            afwImage.DecoratedImageF.readFitsOverlapped("/no/such/file.fits")
+        with self.assertRaises(afwFits.FitsError):
+            afwImage.DecoratedImageF.readMetadata("/no/such/file.fits")
+
     @unittest.skipIf(dataDir is None, "afwdata not setup")
     def testSubimage(self):
         """Test reading a subimage image"""
@@ -117,6 +146,51 @@ class ReadFitsTestCase(lsst.utils.tests.TestCase):
         self.assertEqual(im2.getX0(), sim.getX0())
         self.assertEqual(im2.getY0(), sim.getY0())
 
+    def testMappedRead(self):
+        """Test that a full read of an uncompressed file round-trips
+
+        Full reads of uncompressed local files with a matching pixel type go
+        through a copy-on-write memory mapping of the data unit; check the
+        pixels are correct and that modifying them does not affect the file.
+        """
+        with lsst.utils.tests.getTempFilePath(".fits") as tmpFile:
+            im = afwImage.ImageF(lsst.geom.Extent2I(25, 30))
+            np.random.seed(42)
+            im.array[:] = np.random.uniform(size=im.array.shape).astype(np.float32)
+            im.writeFits(tmpFile)
+
+            unpersisted = afwImage.ImageF(tmpFile)
+            self.assertFloatsEqual(unpersisted.array, im.array)
+
+            # The mapping is private: writes must not leak back into the file.
+            unpersisted.array[:] = 0.0
+            rereadim = afwImage.ImageF(tmpFile)
+            self.assertFloatsEqual(rereadim.array, im.array)
+
+    def testStripWriter(self):
+        """Test writing an image incrementally as row strips"""
+        bbox = lsst.geom.Box2I(lsst.geom.Point2I(12, 34), lsst.geom.Extent2I(20, 10))
+        im = afwImage.ImageF(bbox)
+        np.random.seed(6563)
+        im.array[:] = np.random.uniform(size=im.array.shape).astype(np.float32)
+
+        with lsst.utils.tests.getTempFilePath(".fits") as tmpFile:
+            writer = afwFits.ImageStripWriterF(tmpFile, bbox)
+            for start in range(0, bbox.getHeight(), 3):
+                writer.writeStrip(im.array[start:start + 3])
+            writer.close()
+
+            unpersisted = afwImage.ImageF(tmpFile)
+            self.assertEqual(unpersisted.getBBox(), bbox)
+            self.assertFloatsEqual(unpersisted.array, im.array)
+
+        # Closing before all declared rows have arrived is an error
+        with lsst.utils.tests.getTempFilePath(".fits") as tmpFile:
+            writer = afwFits.ImageStripWriterF(tmpFile, bbox)
+            writer.writeStrip(im.array[:3])
+            with self.assertRaises(pexExcept.LogicError):
+                writer.close()
+
     def testMEF(self):
         """Test writing a set of images to an MEF fits file, and then reading them back
 
@@ -0,0 +1,80 @@
+# This file is part of afw.
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (https://www.lsst.org).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+import unittest
+
+import lsst.utils.tests
+import lsst.afw.image as afwImage
+import lsst.afw.instrumentation as afwInstrumentation
+import lsst.afw.math as afwMath
+
+
+class InstrumentationTestCase(lsst.utils.tests.TestCase):
+    """Tests for the always-on instrumentation counters.
+
+    Counters are cumulative over the process and shared with every other test
+    running in this process, so we only ever assert on deltas between two
+    snapshots taken around an operation we perform ourselves.
+    """
+
+    def testSnapshotKeys(self):
+        snap = afwInstrumentation.snapshot()
+        self.assertIsInstance(snap, dict)
+        for key in ("convolve.calls", "convolve.nanos",
+                    "warp.calls", "warp.nanos",
+                    "statistics.calls", "statistics.nanos",
+                    "stack.calls", "stack.nanos",
+                    "fits.bytesRead", "fits.bytesWritten",
+                    "fits.headerCacheHits", "fits.headerCacheMisses",
+                    "psf.cacheHits", "psf.cacheMisses",
+                    "table.blockAllocations", "table.blockBytes"):
+            self.assertIn(key, snap)
+            self.assertGreaterEqual(snap[key], 0)
+
+    def testStatisticsCounted(self):
+        image = afwImage.ImageF(64, 64)
+        image.set(3.0)
+        before = afwInstrumentation.snapshot()
+        afwMath.makeStatistics(image, afwMath.MEAN)
+        after = afwInstrumentation.snapshot()
+        self.assertGreaterEqual(after["statistics.calls"] - before["statistics.calls"], 1)
+        self.assertGreaterEqual(after["statistics.nanos"], before["statistics.nanos"])
+
+    def testMonotonic(self):
+        image = afwImage.ImageF(32, 32)
+        first = afwInstrumentation.snapshot()
+        afwMath.makeStatistics(image, afwMath.NPOINT)
+        second = afwInstrumentation.snapshot()
+        for key, value in first.items():
+            self.assertGreaterEqual(second[key], value)
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
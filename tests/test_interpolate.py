@@ -34,6 +34,8 @@ import unittest
 import numpy as np
 
 import lsst.utils.tests
+import lsst.geom
+import lsst.afw.image as afwImage
 import lsst.afw.math as afwMath
 import lsst.pex.exceptions as pexExcept
 
@@ -94,6 +96,46 @@ class InterpolateTestCase(lsst.utils.tests.TestCase):
 
         self.assertEqual(youtS, self.y2test)
 
+    def testVectorized(self):
+        """The array overload must agree exactly with point-at-a-time calls
+
+        Includes points outside the knot range, which take the quadratic
+        extrapolation branch.
+        """
+        for style in (afwMath.Interpolate.LINEAR, afwMath.Interpolate.AKIMA_SPLINE,
+                      afwMath.Interpolate.CONSTANT):
+            interp = afwMath.makeInterpolate(self.x, self.y2, style)
+            xtest = np.linspace(-2.0, self.n + 1.0, 57)
+            ytest = interp.interpolate(xtest)
+            for xx, yy in zip(xtest, ytest):
+                self.assertEqual(yy, interp.interpolate(float(xx)))
+
+    def testCache(self):
+        """InterpolateCache must reuse interpolators only for matching knots"""
+        cache = afwMath.InterpolateCache(capacity=2)
+        x = list(self.x)
+        y = list(self.y2)
+
+        first = cache.makeInterpolate(x, y, afwMath.Interpolate.AKIMA_SPLINE)
+        again = cache.makeInterpolate(x, y, afwMath.Interpolate.AKIMA_SPLINE)
+        self.assertIs(again, first)
+        self.assertEqual(cache.size(), 1)
+        self.assertEqual(first.interpolate(self.xtest), self.y2test)
+
+        # different values or style mean a different interpolator
+        other = cache.makeInterpolate(x, list(self.y1), afwMath.Interpolate.AKIMA_SPLINE)
+        self.assertIsNot(other, first)
+        self.assertEqual(cache.size(), 2)
+        styled = cache.makeInterpolate(x, y, afwMath.Interpolate.LINEAR)
+        self.assertIsNot(styled, first)
+        self.assertEqual(cache.size(), 2)  # capacity 2: the oldest entry was evicted
+
+        cache.clear()
+        self.assertEqual(cache.size(), 0)
+
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            afwMath.InterpolateCache(capacity=0)
+
     def testConstant(self):
         """test the constant interpolator"""
         # [xy]vec:   point samples
@@ -188,6 +230,70 @@ class InterpolateTestCase(lsst.utils.tests.TestCase):
             with self.assertRaises(pexExcept.InvalidParameterError):
                 afwMath.stringToInterpStyle(badName)
 
+    def testInterpolateOverDefects(self):
+        """Test the bulk row-sweep defect interpolation"""
+        # a plane is recovered exactly by linear interpolation along rows
+        width, height = 20, 15
+        x0, y0 = 7, -3
+        yy, xx = np.meshgrid(np.arange(height, dtype=np.float64),
+                             np.arange(width, dtype=np.float64), indexing="ij")
+        truth = 1.0 + 2.0*xx + 3.0*yy
+
+        image = afwImage.ImageD(lsst.geom.Extent2I(width, height))
+        image.setXY0(lsst.geom.Point2I(x0, y0))
+        image.getArray()[:] = truth
+        defects = [
+            # a bad column crossing the whole frame
+            afwImage.DefectBase(lsst.geom.Box2I(lsst.geom.Point2I(x0 + 5, y0),
+                                                lsst.geom.Extent2I(1, height))),
+            # a blob, overlapping a second blob so the spans must be merged
+            afwImage.DefectBase(lsst.geom.Box2I(lsst.geom.Point2I(x0 + 9, y0 + 3),
+                                                lsst.geom.Extent2I(3, 4))),
+            afwImage.DefectBase(lsst.geom.Box2I(lsst.geom.Point2I(x0 + 11, y0 + 5),
+                                                lsst.geom.Extent2I(4, 3))),
+            # a run touching the left edge, healed by extrapolation
+            afwImage.DefectBase(lsst.geom.Box2I(lsst.geom.Point2I(x0, y0 + 10),
+                                                lsst.geom.Extent2I(2, 1))),
+            # partially outside the frame; must be clipped, not fatal
+            afwImage.DefectBase(lsst.geom.Box2I(lsst.geom.Point2I(x0 + 18, y0 - 2),
+                                                lsst.geom.Extent2I(5, 4))),
+        ]
+        bad = np.zeros_like(truth, dtype=bool)
+        for defect in defects:
+            box = lsst.geom.Box2I(defect.getBBox())
+            box.clip(image.getBBox())
+            bad[box.getMinY() - y0:box.getMaxY() - y0 + 1,
+                box.getMinX() - x0:box.getMaxX() - x0 + 1] = True
+        image.getArray()[bad] = 1.0e10
+        afwMath.interpolateOverDefects(image, defects, afwMath.Interpolate.LINEAR)
+        self.assertFloatsAlmostEqual(image.getArray(), truth, rtol=1.0e-12)
+
+        # a row with no good pixels at all gets the fallback value
+        rowImage = afwImage.ImageD(lsst.geom.Extent2I(6, 3), 4.0)
+        rowDefect = afwImage.DefectBase(lsst.geom.Box2I(lsst.geom.Point2I(0, 1),
+                                                        lsst.geom.Extent2I(6, 1)))
+        afwMath.interpolateOverDefects(rowImage, [rowDefect], afwMath.Interpolate.LINEAR,
+                                       fallbackValue=-7.0)
+        self.assertFloatsEqual(rowImage.getArray()[1], -7.0)
+        self.assertFloatsEqual(rowImage.getArray()[0], 4.0)
+
+        # the MaskedImage overload heals the image plane, flags INTRP and
+        # leaves the variance alone
+        mimage = afwImage.MaskedImageD(lsst.geom.Extent2I(width, height))
+        mimage.setXY0(lsst.geom.Point2I(x0, y0))
+        mimage.getImage().getArray()[:] = truth
+        mimage.getImage().getArray()[bad] = 1.0e10
+        mimage.getVariance().set(0.5)
+        afwMath.interpolateOverDefects(mimage, defects, afwMath.Interpolate.LINEAR)
+        self.assertFloatsAlmostEqual(mimage.getImage().getArray(), truth, rtol=1.0e-12)
+        intrp = mimage.getMask().getPlaneBitMask("INTRP")
+        self.assertTrue(np.all((mimage.getMask().getArray() & intrp).astype(bool) == bad))
+        self.assertFloatsEqual(mimage.getVariance().getArray(), 0.5)
+
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            afwMath.interpolateOverDefects(image, defects, afwMath.Interpolate.LINEAR,
+                                           nGoodPixels=0)
+
 
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
@@ -115,6 +115,39 @@ class KernelTestCase(lsst.utils.tests.TestCase):
 
         self.verifyCache(kernel, hasCache=False)
 
+    def testAnalyticKernelSpecializedFamilies(self):
+        """Test that the specialized rasterization plans for Gaussian,
+        double Gaussian and polynomial functions match direct evaluation
+        """
+        kWidth = 7
+        kHeight = 7
+
+        funcs = [
+            afwMath.GaussianFunction2D(1.5, 0.8, 0.0),
+            afwMath.GaussianFunction2D(1.5, 0.8, 0.4),
+            afwMath.DoubleGaussianFunction2D(1.2, 2.4, 0.1),
+            afwMath.PolynomialFunction2D(3),
+        ]
+        funcs[-1].setParameters(
+            [0.5, 0.1, -0.2, 0.01, 0.02, -0.03, 0.001, 0.002, -0.003, 0.004])
+
+        for func in funcs:
+            kernel = afwMath.AnalyticKernel(kWidth, kHeight, func)
+            center = kernel.getCtr()
+            kImage = afwImage.ImageD(kernel.getDimensions())
+            kSum = kernel.computeImage(kImage, False)
+            kArr = kImage.getArray()
+
+            fArr = np.zeros_like(kArr)
+            for row in range(kHeight):
+                y = row - center.getY()
+                for col in range(kWidth):
+                    x = col - center.getX()
+                    fArr[row, col] = func(x, y)
+            assert_allclose(kArr, fArr, rtol=1e-13, atol=1e-300,
+                            err_msg=str(func))
+            self.assertAlmostEqual(kSum, fArr.sum(), places=10)
+
     def verifyResized(self, kernel, testClip=True, oddPadRaises=False):
         """Verify kernels can be resized properly.
 
@@ -423,6 +456,39 @@ class KernelTestCase(lsst.utils.tests.TestCase):
 
         self.verifyCache(kernel, hasCache=False)
 
+    def testLinearCombinationKernelManyBases(self):
+        """Test that blending many basis kernels matches a numpy reference
+
+        Uses enough bases to exercise both the unrolled and the remainder
+        part of the blending loop.
+        """
+        kWidth = 7
+        kHeight = 7
+
+        gaussParamsList = [(1.0 + 0.2*ii, 0.8 + 0.1*ii, 0.1*ii)
+                           for ii in range(6)]
+        basisKernelList = makeGaussianKernelList(
+            kWidth, kHeight, gaussParamsList)
+        basisImArrList = []
+        for basisKernel in basisKernelList:
+            basisImage = afwImage.ImageD(basisKernel.getDimensions())
+            basisKernel.computeImage(basisImage, False)
+            basisImArrList.append(basisImage.getArray().copy())
+
+        kParams = [0.2, -0.1, 0.7, 0.05, -0.3, 0.4]
+        kernel = afwMath.LinearCombinationKernel(basisKernelList, kParams)
+
+        kImage = afwImage.ImageD(kernel.getDimensions())
+        kSum = kernel.computeImage(kImage, False)
+
+        refImArr = np.zeros((kHeight, kWidth), dtype=float)
+        refSum = 0.0
+        for param, basisImArr in zip(kParams, basisImArrList):
+            refImArr += param*basisImArr
+            refSum += param*basisImArr.sum()
+        assert_allclose(kImage.getArray(), refImArr, atol=1e-14)
+        self.assertAlmostEqual(kSum, refSum)
+
     def testSeparableKernel(self):
         """Test SeparableKernel using a Gaussian function
         """
@@ -702,6 +768,107 @@ class KernelTestCase(lsst.utils.tests.TestCase):
             self.fail(
                 "Clone was modified by changing original's spatial parameters")
 
+    def testImageCache(self):
+        """Test the LRU kernel image cache on computeImage"""
+        kWidth = 5
+        kHeight = 5
+
+        basisKernelList = makeGaussianKernelList(
+            kWidth, kHeight, [(1.5, 1.5, 0.0), (2.5, 1.5, 0.0)])
+        spFunc = afwMath.PolynomialFunction2D(1)
+        sParams = (
+            (1.0, 0.001, 0.0005),
+            (0.5, 0.0005, 0.001),
+        )
+        kernel = afwMath.LinearCombinationKernel(basisKernelList, spFunc)
+        kernel.setSpatialParameters(sParams)
+
+        # caching is off by default
+        self.assertEqual(kernel.getImageCacheSize(), 0)
+
+        refImage = afwImage.ImageD(kernel.getDimensions())
+        kImage = afwImage.ImageD(kernel.getDimensions())
+        positions = [(0.0, 0.0), (100.0, 0.0), (0.0, 200.0), (100.0, 200.0)]
+        refList = []
+        for x, y in positions:
+            kernel.computeImage(refImage, False, x, y)
+            refList.append(refImage.getArray().copy())
+
+        # cached images at integer positions match the uncached ones exactly,
+        # on first computation and on cache hits
+        kernel.setImageCacheSize(10)
+        self.assertEqual(kernel.getImageCacheSize(), 10)
+        for repeat in range(2):
+            for (x, y), refArr in zip(positions, refList):
+                kernel.computeImage(kImage, False, x, y)
+                self.assertImagesEqual(kImage, afwImage.makeImageFromArray(refArr))
+
+        # positions in the same quantization cell share an entry, evaluated
+        # at the cell center
+        kernel.computeImage(kImage, False, 100.2, 199.9)
+        self.assertImagesEqual(kImage, afwImage.makeImageFromArray(refList[3]))
+
+        # eviction keeps the results correct
+        kernel.setImageCacheSize(2)
+        for (x, y), refArr in zip(positions, refList):
+            kernel.computeImage(kImage, False, x, y)
+            self.assertImagesEqual(kImage, afwImage.makeImageFromArray(refArr))
+
+        # changing the spatial parameters discards the cache
+        newSParams = (
+            (0.6, 0.002, 0.0),
+            (0.7, 0.0, 0.002),
+        )
+        kernel.setSpatialParameters(newSParams)
+        kernel.computeImage(kImage, False, 100.0, 200.0)
+        kernel.setImageCacheSize(0)
+        kernel.computeImage(refImage, False, 100.0, 200.0)
+        self.assertImagesEqual(kImage, refImage)
+
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            kernel.setImageCacheSize(-1)
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            kernel.setImageCachePositionQuantum(0.0)
+
+    def testComputeImageDeferred(self):
+        """Test computeImageDeferred and its lazily-normalized view"""
+        kWidth = 5
+        kHeight = 5
+
+        basisKernelList = makeGaussianKernelList(
+            kWidth, kHeight, [(1.5, 1.5, 0.0), (2.5, 1.5, 0.0)])
+        spFunc = afwMath.PolynomialFunction2D(1)
+        sParams = (
+            (1.0, 0.001, 0.0005),
+            (0.5, 0.0005, 0.001),
+        )
+        kernel = afwMath.LinearCombinationKernel(basisKernelList, spFunc)
+        kernel.setSpatialParameters(sParams)
+
+        refImage = afwImage.ImageD(kernel.getDimensions())
+        for x, y in [(0.0, 0.0), (100.0, 0.0), (0.0, 200.0), (100.0, 200.0)]:
+            refSum = kernel.computeImage(refImage, False, x, y)
+            deferred = kernel.computeImageDeferred(x, y)
+            self.assertImagesEqual(deferred.getImage(), refImage)
+            self.assertEqual(deferred.getImage().getXY0(), refImage.getXY0())
+            self.assertFloatsEqual(deferred.getSum(), refSum)
+
+            # the normalized view matches an eager doNormalize=True call,
+            # and the unnormalized image is left untouched
+            kernel.computeImage(refImage, True, x, y)
+            self.assertImagesAlmostEqual(deferred.getNormalizedImage(), refImage)
+            self.assertImagesAlmostEqual(deferred.getNormalizedImage(), refImage)
+            self.assertFloatsAlmostEqual(
+                deferred.getImage().getArray().sum(), deferred.getSum(), rtol=1e-14)
+
+        # a zero-sum kernel only fails if the normalized view is requested
+        zeroKernel = afwMath.FixedKernel(
+            afwImage.ImageD(lsst.geom.Extent2I(kWidth, kHeight), 0.0))
+        deferred = zeroKernel.computeImageDeferred()
+        self.assertFloatsEqual(deferred.getSum(), 0.0)
+        with self.assertRaises(pexExcept.OverflowError):
+            deferred.getNormalizedImage()
+
     def testSetCtr(self):
         """Test setCtrCol/Row"""
         kWidth = 3
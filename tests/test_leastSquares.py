@@ -177,6 +177,134 @@ class LeastSquaresTestCase(lsst.utils.tests.TestCase):
         self._assertClose(s_svd.getSolution(), s_design_eigen.getSolution())
         self._assertClose(s_svd.getSolution(), s_normal_eigen.getSolution())
 
+    def testSetRhsVector(self):
+        dimension = 10
+        nData = 500
+        design = np.random.randn(dimension, nData).transpose()
+        data1 = np.random.randn(nData)
+        data2 = np.random.randn(nData)
+        fisher = np.dot(design.transpose(), design)
+        for factorization in (LeastSquares.NORMAL_EIGENSYSTEM,
+                              LeastSquares.NORMAL_CHOLESKY):
+            solver = LeastSquares.fromDesignMatrix(design, data1, factorization)
+            solution1 = np.array(solver.getSolution())
+            self._assertClose(solution1,
+                              np.linalg.lstsq(design, data1, rcond=None)[0])
+            # replacing the RHS reuses the factorization and changes only
+            # the solution
+            solver.setRhsVector(np.dot(design.transpose(), data2))
+            self._assertClose(solver.getSolution(),
+                              np.linalg.lstsq(design, data2, rcond=None)[0])
+            self._assertClose(solver.getFisherMatrix(), fisher)
+            self._assertClose(solver.getCovariance(), np.linalg.inv(fisher))
+            self._assertNotClose(solver.getSolution(), solution1)
+        # DIRECT_SVD does not use the RHS of the normal equations
+        s_svd = LeastSquares.fromDesignMatrix(design, data1, LeastSquares.DIRECT_SVD)
+        with self.assertRaises(lsst.pex.exceptions.LogicError):
+            s_svd.setRhsVector(np.dot(design.transpose(), data2))
+        # a factorization must exist before the RHS can be replaced
+        with self.assertRaises(lsst.pex.exceptions.LogicError):
+            LeastSquares(LeastSquares.NORMAL_CHOLESKY, dimension).setRhsVector(
+                np.dot(design.transpose(), data2))
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            LeastSquares.fromDesignMatrix(design, data1).setRhsVector(
+                np.zeros(dimension + 1))
+
+    def testMultiRhsSolve(self):
+        dimension = 10
+        nData = 500
+        nRhs = 7
+        design = np.random.randn(dimension, nData).transpose()
+        data = np.random.randn(nData, nRhs)
+        rhs = np.dot(design.transpose(), data).transpose().copy()
+        expected = np.linalg.lstsq(design, data, rcond=None)[0].transpose()
+        for factorization in (LeastSquares.NORMAL_EIGENSYSTEM,
+                              LeastSquares.NORMAL_CHOLESKY):
+            solver = LeastSquares.fromDesignMatrix(design, data[:, 0],
+                                                   factorization)
+            solutions = solver.solve(rhs)
+            self.assertEqual(solutions.shape, (nRhs, dimension))
+            self._assertClose(solutions, expected)
+            # the solver's own RHS and solution are untouched
+            self._assertClose(solver.getSolution(), expected[0])
+        s_svd = LeastSquares.fromDesignMatrix(design, data[:, 0],
+                                              LeastSquares.DIRECT_SVD)
+        with self.assertRaises(lsst.pex.exceptions.LogicError):
+            s_svd.solve(rhs)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            LeastSquares.fromDesignMatrix(design, data[:, 0]).solve(
+                np.zeros((nRhs, dimension + 1)))
+
+    def testAccumulator(self):
+        dimension = 8
+        nData = 300
+        design = np.random.randn(nData, dimension)
+        data = np.random.randn(nData)
+        weights = np.random.uniform(0.5, 2.0, nData)
+
+        # Row-at-a-time accumulation matches the normal equations built from
+        # the full design matrix.
+        accumulator = LeastSquares.Accumulator(dimension)
+        self.assertEqual(accumulator.getDimension(), dimension)
+        for row, value, weight in zip(design, data, weights):
+            accumulator.addObservation(row, value, weight)
+        self.assertEqual(accumulator.getCount(), nData)
+        fisher = np.dot(design.transpose()*weights, design)
+        rhs = np.dot(design.transpose(), weights*data)
+        self._assertClose(accumulator.getFisherMatrix(), fisher)
+        self._assertClose(accumulator.getRhsVector(), rhs)
+
+        # Blocked accumulation gives the same terms.
+        blocked = LeastSquares.Accumulator(dimension)
+        half = nData//2
+        blocked.addObservations(design[:half], data[:half], weights[:half])
+        blocked.addObservations(design[half:], data[half:], weights[half:])
+        self._assertClose(blocked.getFisherMatrix(), fisher)
+        self._assertClose(blocked.getRhsVector(), rhs)
+
+        # The solver built from the accumulator matches the weighted direct
+        # solution.
+        expected = np.linalg.solve(fisher, rhs)
+        solver = accumulator.makeSolver()
+        self._assertClose(solver.getSolution(), expected)
+
+        # updateSolver refreshes an existing solver in place.
+        other = LeastSquares.Accumulator(dimension)
+        other.addObservations(design, np.zeros(nData))
+        other.updateSolver(solver)
+        self._assertClose(solver.getSolution(), np.zeros(dimension))
+
+        # Unweighted blocks behave as weight == 1.
+        unweighted = LeastSquares.Accumulator(dimension)
+        unweighted.addObservations(design, data)
+        self._assertClose(unweighted.getFisherMatrix(),
+                          np.dot(design.transpose(), design))
+
+        # reset() empties the accumulator but keeps the dimension.
+        unweighted.reset()
+        self.assertEqual(unweighted.getCount(), 0)
+        self.assertEqual(unweighted.getDimension(), dimension)
+        self._assertClose(unweighted.getFisherMatrix(),
+                          np.zeros((dimension, dimension)), atol=0.0)
+
+        # Error checking.
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            LeastSquares.Accumulator(0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            accumulator.addObservation(np.zeros(dimension + 1), 1.0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            accumulator.addObservation(np.zeros(dimension), 1.0, -1.0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            accumulator.addObservations(design, data[:half])
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            accumulator.addObservations(design, data, -weights)
+        with self.assertRaises(lsst.pex.exceptions.LogicError):
+            LeastSquares.Accumulator(dimension).makeSolver()
+        mismatched = LeastSquares.Accumulator(dimension + 1)
+        mismatched.addObservation(np.ones(dimension + 1), 1.0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            mismatched.updateSolver(solver)
+
 
 class MemoryTester(lsst.utils.tests.MemoryTestCase):
     pass
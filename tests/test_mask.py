@@ -171,6 +171,33 @@ class MaskTestCase(utilsTests.TestCase):
         expect[:] = self.val1 ^ self.val2
         self.assertMasksEqual(self.mask1, expect)
 
+    def testCountMaskBits(self):
+        numPix = self.mask1.getWidth()*self.mask1.getHeight()
+        numVal1Bits = bin(self.val1).count("1")
+
+        # every pixel holds val1, so all of its bits are counted...
+        self.assertEqual(self.mask1.countMaskBits(), numPix*numVal1Bits)
+        self.assertEqual(self.mask1.countMaskBits(self.BAD), numPix)
+        # ... and planes that are not set contribute nothing
+        self.assertEqual(self.mask1.countMaskBits(self.EDGE), 0)
+
+        # restrict the count to a sub-region, in both PARENT and LOCAL coordinates
+        bbox = lsst.geom.BoxI(lsst.geom.PointI(10, 20), lsst.geom.ExtentI(5, 7))
+        self.assertEqual(self.mask1.countMaskBits(self.CR, bbox), bbox.getArea())
+        self.mask1.setXY0(lsst.geom.PointI(3, 4))
+        self.assertEqual(self.mask1.countMaskBits(self.CR, bbox, afwImage.LOCAL),
+                         bbox.getArea())
+
+        # matches a numpy count on random mask data
+        arr = np.random.randint(0, 2**16, size=self.mask1.getArray().shape)
+        self.mask1.getArray()[:] = arr
+        expect = sum(bin(v).count("1") for v in arr.flat)
+        self.assertEqual(self.mask1.countMaskBits(), expect)
+
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            self.mask1.countMaskBits(self.BAD, lsst.geom.BoxI(lsst.geom.PointI(-10, -10),
+                                                              lsst.geom.ExtentI(5, 5)))
+
     def testLogicalMasksMismatch(self):
         "Test logical operations on Masks of different sizes"
         i1 = afwImage.Mask(lsst.geom.ExtentI(100, 100))
@@ -321,6 +321,29 @@ class MaskedImageTestCase(lsst.utils.tests.TestCase):
 
         self.assertEqual(self.mimage2[0, 0, afwImage.LOCAL], mimage2_copy[0, 0, afwImage.LOCAL])
 
+    def testSetWhere(self):
+        """Test conditionally setting image pixels from the mask in one pass"""
+        SAT = afwImage.Mask.getPlaneBitMask("SAT")
+        self.mimage.mask[10, 20, afwImage.LOCAL] = SAT
+        self.mimage.mask[30, 40, afwImage.LOCAL] = self.BAD | SAT
+
+        # EDGE border (2 pixels wide) plus the two pixels set above
+        nEdge = 100*200 - 96*196
+        self.assertEqual(self.mimage.setWhere(self.EDGE | SAT, np.nan), nEdge + 2)
+
+        self.assertTrue(np.isnan(self.mimage.image[0, 0, afwImage.LOCAL]))
+        self.assertTrue(np.isnan(self.mimage.image[10, 20, afwImage.LOCAL]))
+        self.assertTrue(np.isnan(self.mimage.image[30, 40, afwImage.LOCAL]))
+        # unselected pixels (and the other planes) are untouched
+        self.assertEqual(self.mimage.image[5, 5, afwImage.LOCAL], self.imgVal1)
+        self.assertEqual(self.mimage.variance[0, 0, afwImage.LOCAL], self.varVal1)
+        self.assertEqual(self.mimage.mask[0, 0, afwImage.LOCAL], self.EDGE)
+        self.assertEqual(np.sum(np.isnan(self.mimage.image.array)), nEdge + 2)
+
+        # no pixels have an unused plane set
+        self.assertEqual(self.mimage.setWhere(afwImage.Mask.getPlaneBitMask("CR"), 0.0), 0)
+        self.assertTrue(np.isnan(self.mimage.image[0, 0, afwImage.LOCAL]))
+
     def testAssignWithBBox(self):
         """Test assign(rhs, bbox) with non-empty bbox
         """
@@ -611,6 +634,76 @@ class MaskedImageTestCase(lsst.utils.tests.TestCase):
         self.assertEqual(dimage.image[0, 0, afwImage.LOCAL], self.imgVal1)
         self.assertEqual(simage.image[0, 0, afwImage.LOCAL], self.imgVal1 + 2)
 
+    def testLargeDeepCopy(self):
+        """A plane big enough to be copied in parallel bands comes out identical"""
+        large = afwImage.MaskedImageF(lsst.geom.Extent2I(1024, 3000))
+        np.random.seed(20)
+        large.image.array[:] = np.random.uniform(size=large.image.array.shape)
+        large.mask.array[:] = np.random.randint(0, 16, size=large.mask.array.shape)
+        large.variance.array[:] = np.random.uniform(size=large.variance.array.shape)
+
+        copy = afwImage.MaskedImageF(large, True)
+        self.assertMaskedImagesEqual(copy, large)
+
+        large += 1                       # must not affect the deep copy
+        self.assertFloatsEqual(copy.image.array + 1, large.image.array)
+
+    def testVarianceGenerator(self):
+        """The variance plane is not materialized until something touches it"""
+        calls = []
+
+        def makeVariance():
+            calls.append(None)
+            variance = afwImage.ImageF(self.mimage.getDimensions())
+            variance.set(self.varVal1)
+            return variance
+
+        mimage = afwImage.MaskedImageF(self.mimage.getDimensions())
+        mimage.image.set(self.imgVal1)
+        mimage.setVarianceGenerator(makeVariance)
+        self.assertTrue(mimage.isVarianceDeferred())
+        self.assertEqual(len(calls), 0)
+
+        # image-only operations must not run the generator
+        self.assertEqual(mimage.image[0, 0, afwImage.LOCAL], self.imgVal1)
+        self.assertEqual(len(calls), 0)
+
+        # first access to the variance runs it exactly once
+        self.assertEqual(mimage.variance[0, 0, afwImage.LOCAL], self.varVal1)
+        self.assertFalse(mimage.isVarianceDeferred())
+        self.assertEqual(len(calls), 1)
+        mimage.variance[0, 0, afwImage.LOCAL]
+        self.assertEqual(len(calls), 1)
+
+    def testVarianceGeneratorSharedAndArithmetic(self):
+        def makeVariance():
+            variance = afwImage.ImageF(self.mimage.getDimensions())
+            variance.set(self.varVal1)
+            return variance
+
+        mimage = afwImage.MaskedImageF(self.mimage.getDimensions())
+        mimage.image.set(self.imgVal1)
+        mimage.setVarianceGenerator(makeVariance)
+
+        # a shallow copy shares the deferred state and, once one of the two is
+        # materialized, the plane itself
+        shallow = afwImage.MaskedImageF(mimage)
+        self.assertTrue(shallow.isVarianceDeferred())
+        mimage *= 2.0                    # scales the variance, so materializes it
+        self.assertFalse(mimage.isVarianceDeferred())
+        self.assertFalse(shallow.isVarianceDeferred())
+        self.assertEqual(shallow.variance[0, 0, afwImage.LOCAL], 4*self.varVal1)
+
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            mimage.setVarianceGenerator(None)
+
+    def testVarianceGeneratorBadPlane(self):
+        mimage = afwImage.MaskedImageF(self.mimage.getDimensions())
+        mimage.setVarianceGenerator(
+            lambda: afwImage.ImageF(lsst.geom.Extent2I(1, 1)))
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            mimage.getVariance()
+
     def checkImgPatch12(self, img, x0, y0):
         """Check that a patch of an image is correct; origin of patch is at (x0, y0) in full image
         N.b. This isn't a general routine!  Works only for testSubimages[12]"""
@@ -70,6 +70,37 @@ class MinimizeTestCase(lsst.utils.tests.TestCase):
         self.assertFloatsAlmostEqual(
             np.array(modelParams), np.array(fitResults.parameterList), 1e-11)
 
+    def testMinimize2Parallel(self):
+        rng = np.random.RandomState(42)
+        xPositions = rng.uniform(-1.0, 1.0, 100)
+        yPositions = rng.uniform(-1.0, 1.0, 100)
+        variances = np.full(100, 0.01)
+
+        polyFunc = afwMath.PolynomialFunction2D(1)
+        modelParams = [0.1, 0.2, 0.3]
+        polyFunc.setParameters(modelParams)
+        measurements = [polyFunc(x, y) for x, y in zip(xPositions, yPositions)]
+
+        nParameters = polyFunc.getNParameters()
+        initialParameters = np.zeros(nParameters, float)
+        stepsize = np.full(nParameters, 0.1)
+
+        fitResults = afwMath.minimize(
+            polyFunc,
+            initialParameters,
+            stepsize,
+            measurements,
+            variances,
+            xPositions,
+            yPositions,
+            0.1,
+            numThreads=4,
+        )
+
+        self.assertTrue(fitResults.isValid, "fit failed")
+        self.assertFloatsAlmostEqual(
+            np.array(modelParams), np.array(fitResults.parameterList), 1e-8)
+
 
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
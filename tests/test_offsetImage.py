@@ -27,6 +27,7 @@ Run with:
 or
    pytest test_offsetImage.py
 """
+import itertools
 import math
 import unittest
 
@@ -34,6 +35,7 @@ import numpy as np
 
 import lsst.utils.tests
 import lsst.geom
+import lsst.pex.exceptions
 import lsst.afw.image as afwImage
 import lsst.afw.math as afwMath
 import lsst.afw.display as afwDisplay
@@ -162,6 +164,37 @@ class OffsetImageTestCase(unittest.TestCase):
                         print(f"failed on algorithm={algorithm}; dx = {dx}; dy = {dy}")
                         raise
 
+    def testSubpixelOffset(self):
+        """SubpixelOffset should reproduce offsetImage for fractional shifts.
+        """
+        rng = np.random.Generator(np.random.MT19937(42))
+        inImage = afwImage.ImageF(64, 64)
+        inImage.getArray()[:, :] = rng.normal(100.0, 10.0, size=(64, 64))
+        outImage = afwImage.ImageF(inImage.getDimensions())
+
+        for algorithm in ("lanczos5", "bilinear"):
+            for dx, dy in [(0.35, -0.12), (-0.49, 0.51), (0.0, 0.25)]:
+                expected = afwMath.offsetImage(inImage, dx, dy, algorithm)
+                shifter = afwMath.SubpixelOffsetF(dx, dy, algorithm)
+
+                shifter.apply(outImage, inImage)
+                np.testing.assert_allclose(outImage.getArray(), expected.getArray(), rtol=1e-6)
+
+                # The same engine applied in place must give the same answer.
+                inPlace = afwImage.ImageF(inImage, True)
+                shifter.apply(inPlace, inPlace)
+                np.testing.assert_allclose(inPlace.getArray(), expected.getArray(), rtol=1e-6)
+
+    def testSubpixelOffsetErrors(self):
+        """SubpixelOffset should reject whole-pixel shifts and mismatched images.
+        """
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwMath.SubpixelOffsetF(1.5, 0.0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwMath.SubpixelOffsetF(0.25, 0.25).apply(afwImage.ImageF(10, 10), afwImage.ImageF(10, 12))
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            afwMath.SubpixelOffsetF(0.25, 0.25).apply(afwImage.ImageF(5, 5), afwImage.ImageF(5, 5))
+
 # the following would be preferable if there was an easy way to NaN pixels
 #
 #         stats = afwMath.makeStatistics(im, afwMath.MEAN | afwMath.MAX | afwMath.MIN)
@@ -236,6 +269,34 @@ class TransformImageTestCase(unittest.TestCase):
         # for a while, swig couldn't handle the resulting std::shared_ptr<Mask>
         afwMath.flipImage(mask, True, False)
 
+    def testTranspose(self):
+        """Test that transposing turns columns into rows.
+        """
+        rng = np.random.RandomState(42)
+        # Dimensions deliberately not multiples of the internal tile size.
+        inImage = afwImage.ImageF(100, 37)
+        inImage.array[:] = rng.uniform(size=inImage.array.shape)
+        outImage = afwMath.transposeImage(inImage)
+        self.assertEqual(outImage.getDimensions(),
+                         lsst.geom.Extent2I(37, 100))
+        np.testing.assert_array_equal(outImage.array, inImage.array.T)
+        # Transposing twice is the identity.
+        backImage = afwMath.transposeImage(outImage)
+        np.testing.assert_array_equal(backImage.array, inImage.array)
+
+    def testTransposeMasked(self):
+        """Test that a MaskedImage is transposed plane by plane.
+        """
+        rng = np.random.RandomState(43)
+        mimg = afwImage.MaskedImageF(30, 20)
+        mimg.image.array[:] = rng.uniform(size=mimg.image.array.shape)
+        mimg.mask.array[:] = rng.randint(0, 4, size=mimg.mask.array.shape)
+        mimg.variance.array[:] = rng.uniform(size=mimg.variance.array.shape)
+        outMimg = afwMath.transposeImage(mimg)
+        np.testing.assert_array_equal(outMimg.image.array, mimg.image.array.T)
+        np.testing.assert_array_equal(outMimg.mask.array, mimg.mask.array.T)
+        np.testing.assert_array_equal(outMimg.variance.array, mimg.variance.array.T)
+
 
 class BinImageTestCase(unittest.TestCase):
     """A test case for binning images.
@@ -291,6 +352,46 @@ class BinImageTestCase(unittest.TestCase):
             afwDisplay.Display(frame=2).mtv(inImage, title="unbinned")
             afwDisplay.Display(frame=3).mtv(outImage, title=f"binned {binX}x{binY}")
 
+    def testBinStatistics(self):
+        """Test binning with a statistic other than the mean.
+        """
+        inImage = afwImage.ImageF(16, 16)
+        inImage.set(1)
+        inImage[0, 0, afwImage.LOCAL] = 1000  # an outlier in the first bin
+
+        sctrl = afwMath.StatisticsControl()
+        for numThreads in (1, 4):
+            outImage = afwMath.binImage(inImage, 8, 8, afwMath.MEDIAN, sctrl, numThreads)
+            stats = afwMath.makeStatistics(outImage, afwMath.MAX | afwMath.MIN)
+            self.assertEqual(stats.getValue(afwMath.MIN), 1)
+            self.assertEqual(stats.getValue(afwMath.MAX), 1)
+
+    def testBinMasked(self):
+        """Test that masked pixels are excluded from the reduction.
+        """
+        mi = afwImage.MaskedImageF(8, 8)
+        mi.image.set(1)
+        mi.variance.set(4)
+        bad = mi.mask.getPlaneBitMask("BAD")
+        sat = mi.mask.getPlaneBitMask("SAT")
+        mi.image[0, 0, afwImage.LOCAL] = 1000
+        mi.mask[0, 0, afwImage.LOCAL] = bad
+        # a fully-masked bin
+        for x, y in itertools.product(range(4), range(4)):
+            mi.mask[4 + x, y, afwImage.LOCAL] = sat
+
+        sctrl = afwMath.StatisticsControl()
+        sctrl.setAndMask(bad | sat)
+        outImage = afwMath.binImage(mi, 4, 4, afwMath.MEAN, sctrl)
+
+        self.assertEqual(outImage.image[0, 0, afwImage.LOCAL], 1)
+        self.assertEqual(outImage.mask[0, 0, afwImage.LOCAL], 0)
+        self.assertAlmostEqual(outImage.variance[0, 0, afwImage.LOCAL], 4*15/15**2)
+
+        self.assertTrue(np.isnan(outImage.image[1, 0, afwImage.LOCAL]))
+        self.assertEqual(outImage.mask[1, 0, afwImage.LOCAL], sat)
+        self.assertTrue(np.isnan(outImage.variance[1, 0, afwImage.LOCAL]))
+
 
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
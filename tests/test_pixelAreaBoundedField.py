@@ -26,6 +26,7 @@ import numpy as np
 import lsst.utils.tests
 import lsst.geom
 import lsst.afw.geom
+import lsst.pex.exceptions
 from lsst.afw.math import PixelAreaBoundedField
 
 
@@ -121,6 +122,60 @@ class PixelAreaBoundedFieldTestCase(lsst.utils.tests.TestCase):
             out = lsst.afw.math.PixelAreaBoundedField.readFits(filename)
             self.assertEqual(self.boundedField, out)
 
+    def testGridded(self):
+        """Test that gridded evaluation reproduces exact evaluation.
+        """
+        gridded = PixelAreaBoundedField(self.bbox, self.skyWcs,
+                                        unit=lsst.geom.arcseconds,
+                                        gridSpacing=50)
+        self.assertEqual(gridded.getGridSpacing(), 50)
+        self.assertEqual(self.boundedField.getGridSpacing(), 0)
+        xx = np.linspace(self.bbox.getMinX(), self.bbox.getMaxX())
+        yy = np.linspace(self.bbox.getMinY(), self.bbox.getMaxY())
+        xv, yv = np.meshgrid(xx, yy)
+        exact = self.boundedField.evaluate(xv.flatten(), yv.flatten())
+        interpolated = gridded.evaluate(xv.flatten(), yv.flatten())
+        self.assertFloatsAlmostEqual(interpolated, exact, rtol=1e-6)
+        # Scalar evaluation goes through the same grid.
+        point = lsst.geom.Point2D(17.5, 111.25)
+        self.assertFloatsAlmostEqual(gridded.evaluate(point),
+                                     self.boundedField.evaluate(point),
+                                     rtol=1e-6)
+        # Scaling preserves the grid mode.
+        product = gridded * 2.5
+        self.assertEqual(product.getGridSpacing(), 50)
+        self.assertFloatsAlmostEqual(product.evaluate(point),
+                                     2.5*gridded.evaluate(point), rtol=1e-14)
+        # Differing grid spacing breaks equality.
+        self.assertNotEqual(gridded, self.boundedField)
+        # The grid mode round-trips through persistence.
+        with lsst.utils.tests.getTempFilePath(".fits") as filename:
+            gridded.writeFits(filename)
+            out = lsst.afw.math.PixelAreaBoundedField.readFits(filename)
+            self.assertEqual(gridded, out)
+            self.assertEqual(out.getGridSpacing(), 50)
+
+    def testMakeGridded(self):
+        """Test the error-bounded factory.
+        """
+        tolerance = 1e-10
+        gridded = PixelAreaBoundedField.makeGridded(
+            self.bbox, self.skyWcs, maxRelativeError=tolerance,
+            unit=lsst.geom.arcseconds)
+        xx = np.linspace(self.bbox.getMinX(), self.bbox.getMaxX())
+        yy = np.linspace(self.bbox.getMinY(), self.bbox.getMaxY())
+        xv, yv = np.meshgrid(xx, yy)
+        exact = self.boundedField.evaluate(xv.flatten(), yv.flatten())
+        interpolated = gridded.evaluate(xv.flatten(), yv.flatten())
+        # The bound is enforced at cell centres; allow a little slop at
+        # arbitrary points.
+        self.assertFloatsAlmostEqual(interpolated, exact, rtol=10*tolerance)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            PixelAreaBoundedField.makeGridded(self.bbox, self.skyWcs,
+                                              maxRelativeError=0.0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            PixelAreaBoundedField(self.bbox, self.skyWcs, gridSpacing=-1)
+
 
 class MemoryTester(lsst.utils.tests.MemoryTestCase):
     pass
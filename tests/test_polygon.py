@@ -26,6 +26,7 @@ import numpy as np
 
 import lsst.utils.tests
 import lsst.geom
+import lsst.pex.exceptions
 import lsst.afw.geom as afwGeom
 import lsst.afw.image  # noqa: F401 required by Polygon.createImage
 
@@ -147,6 +148,21 @@ class PolygonTest(lsst.utils.tests.TestCase):
             self.assertFalse(poly.contains(
                 lsst.geom.Point2D(self.x0 + radius, self.y0 + radius)))
 
+    def testContainsArray(self):
+        """Test the array version of Polygon.contains"""
+        radius = 1.0
+        rng = np.random.RandomState(6)
+        for num in range(3, 30):
+            poly = self.polygon(num, radius=radius)
+            x = rng.uniform(-1.5*radius, 1.5*radius, 100)
+            y = rng.uniform(-1.5*radius, 1.5*radius, 100)
+            expect = np.array([poly.contains(lsst.geom.Point2D(xx, yy))
+                               for xx, yy in zip(x, y)])
+            np.testing.assert_array_equal(poly.contains(x, y), expect)
+        poly = self.polygon(10, radius=radius)
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            poly.contains(np.zeros(3), np.zeros(4))
+
     def testOverlaps(self):
         """Test Polygon.overlaps"""
         radius = 1.0
@@ -268,6 +284,26 @@ class PolygonTest(lsst.utils.tests.TestCase):
             self.assertAlmostEqual(
                 image.getArray().sum()/poly.calculateArea(), 1.0, 6)
 
+    def testImageConcave(self):
+        """Test Polygon.createImage on a concave polygon
+
+        A star-shaped polygon produces rows with multiple interior runs,
+        exercising the scanline rasterizer's parity handling.
+        """
+        theta = np.linspace(0, 2*np.pi, num=20, endpoint=False)
+        radius = np.where(np.arange(20) % 2 == 0, 40.0, 15.0)
+        vertices = [lsst.geom.Point2D(r*np.cos(t) + 75, r*np.sin(t) + 75)
+                    for r, t in zip(radius, theta)]
+        poly = afwGeom.Polygon(vertices)
+        box = lsst.geom.Box2I(lsst.geom.Point2I(15, 15),
+                              lsst.geom.Extent2I(115, 115))
+        image = poly.createImage(box)
+        self.assertAlmostEqual(
+            image.getArray().sum()/poly.calculateArea(), 1.0, 6)
+        # Pixels well inside/outside must be exactly 1/0
+        self.assertEqual(image[lsst.geom.Point2I(75, 75)], 1.0)
+        self.assertEqual(image[lsst.geom.Point2I(20, 20)], 0.0)
+
     def testTransform(self):
         """Test constructor for Polygon involving transforms"""
         box = lsst.geom.Box2D(lsst.geom.Point2D(0.0, 0.0),
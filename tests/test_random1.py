@@ -78,6 +78,44 @@ class RandomTestCase(unittest.TestCase):
         rng2 = rng1.deepCopy()
         checkRngEquivalence(rng1, rng2)
 
+    def testPhiloxSplit(self):
+        """
+        Test the stream-splitting behavior of the counter-based PHILOX
+        algorithm
+        """
+        seed = getSeed()
+        rng = afwMath.Random(afwMath.Random.PHILOX, seed)
+
+        # a fresh generator draws from stream 0
+        checkRngEquivalence(afwMath.Random(afwMath.Random.PHILOX, seed),
+                            rng.split(0))
+
+        # split streams do not depend on how far along the parent is
+        rng.uniform()
+        checkRngEquivalence(afwMath.Random(afwMath.Random.PHILOX, seed).split(17),
+                            rng.split(17))
+
+        # different streams produce different sequences
+        self.assertNotEqual([rng.split(1).uniform() for i in range(10)],
+                            [rng.split(2).uniform() for i in range(10)])
+
+        # only PHILOX supports splitting
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwMath.Random(afwMath.Random.MT19937, seed).split(1)
+
+    def testPhiloxState(self):
+        """
+        Test that getState/setState round-trip the PHILOX generator
+        """
+        rng = afwMath.Random(afwMath.Random.PHILOX, getSeed())
+        for i in range(100):
+            rng.uniform()
+        state = rng.getState()
+        v1 = [rng.uniform() for i in range(100)]
+        rng.setState(state)
+        v2 = [rng.uniform() for i in range(100)]
+        self.assertEqual(v1, v2)
+
 
 class RandomImageTestCase(unittest.TestCase):
     """A test case for lsst.afw.math.Random applied to Images"""
@@ -117,6 +155,43 @@ class RandomImageTestCase(unittest.TestCase):
 
     def testRandomGaussianImage(self):
         afwMath.randomGaussianImage(self.image, self.rand)
+        stats = afwMath.makeStatistics(
+            self.image, afwMath.MEAN | afwMath.VARIANCE)
+        self.assertAlmostEqual(stats.getValue(afwMath.MEAN), 0.0, 2)
+        self.assertAlmostEqual(stats.getValue(afwMath.VARIANCE), 1.0, 2)
+
+        # the same seed gives the same image
+        image2 = afwImage.ImageF(self.image.getDimensions())
+        afwMath.randomGaussianImage(image2, afwMath.Random())
+        self.assertTrue((self.image.getArray() == image2.getArray()).all())
+
+    def testRandomGaussianImageParallel(self):
+        """
+        Test that the parallel overload of randomGaussianImage gives the
+        same image for every thread count, advances the parent generator,
+        and rejects algorithms that cannot split streams
+        """
+        rand = afwMath.Random(afwMath.Random.PHILOX, 42)
+        image1 = afwImage.ImageF(lsst.geom.Extent2I(200, 100))
+        afwMath.randomGaussianImage(image1, rand, numThreads=1)
+
+        image4 = afwImage.ImageF(lsst.geom.Extent2I(200, 100))
+        afwMath.randomGaussianImage(image4, afwMath.Random(afwMath.Random.PHILOX, 42),
+                                    numThreads=4)
+        self.assertTrue((image1.getArray() == image4.getArray()).all())
+
+        stats = afwMath.makeStatistics(image1, afwMath.MEAN | afwMath.VARIANCE)
+        self.assertAlmostEqual(stats.getValue(afwMath.MEAN), 0.0, 1)
+        self.assertAlmostEqual(stats.getValue(afwMath.VARIANCE), 1.0, 1)
+
+        # a second call with the same generator produces a different image
+        image2 = afwImage.ImageF(lsst.geom.Extent2I(200, 100))
+        afwMath.randomGaussianImage(image2, rand, numThreads=4)
+        self.assertFalse((image1.getArray() == image2.getArray()).all())
+
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwMath.randomGaussianImage(image1, afwMath.Random(afwMath.Random.MT19937, 42),
+                                        numThreads=4)
 
     def testRandomChisqImage(self):
         nu = 10
@@ -217,6 +217,11 @@ class FitsReaderTestCase(lsst.utils.tests.TestCase):
         record = reader.readCoaddInputs().ccds[0]
         self.assertEqual(record.getWcs(), reader.readWcs())
         self.assertEqual(record.getPsf(), reader.readPsf())
+        # Archives with identical content are shared process-wide, so a
+        # second reader of the same file gets the same component instances.
+        reader2 = ExposureFitsReader(fileName)
+        self.assertEqual(reader2.readPsf(), reader.readPsf())
+        self.assertEqual(reader2.readWcs(), reader.readWcs())
         self.assertEqual(record.getValidPolygon(), reader.readValidPolygon())
         self.assertEqual(record.getApCorrMap(), reader.readApCorrMap())
         self.assertEqual(record.getPhotoCalib(), reader.readPhotoCalib())
@@ -226,6 +231,72 @@ class FitsReaderTestCase(lsst.utils.tests.TestCase):
             compare=lambda a, b: self.assertMaskedImagesEqual(a.maskedImage, b.maskedImage)
         )
 
+    def checkLazyExposureFitsReader(self, exposureIn, fileName):
+        """Test reading an Exposure with lazy component loading.
+
+        Parameters
+        ----------
+        exposureIn : `Exposure`
+            Object originally saved, to compare against.
+        fileName : `str`
+            Name of the file the reader is reading.
+        """
+        reader = ExposureFitsReader(fileName)
+        exposure = reader.read(lazyComponents=True)
+        # Components must remain accessible after the reader (and hence the
+        # FITS file) is gone; only their deserialization is deferred.
+        del reader
+        self.assertTrue(exposure.hasPsf())
+        self.assertTrue(exposure.hasWcs())
+        self.assertImagesEqual(exposureIn.getPsf().computeImage(), exposure.getPsf().computeImage())
+        self.assertWcsAlmostEqualOverBBox(exposureIn.getWcs(), exposure.getWcs(), self.bbox,
+                                          maxDiffPix=0, maxDiffSky=0*degrees)
+        self.assertEqual(exposureIn.getFilterLabel(), exposure.getFilterLabel())
+        self.assertEqual(exposureIn.getPhotoCalib(), exposure.getPhotoCalib())
+        self.assertEqual(exposureIn.getInfo().getValidPolygon(), exposure.getInfo().getValidPolygon())
+        self.assertCountEqual(exposureIn.getInfo().getApCorrMap(), exposure.getInfo().getApCorrMap())
+        self.assertEqual(exposureIn.getInfo().getVisitInfo().getExposureTime(),
+                         exposure.getInfo().getVisitInfo().getExposureTime())
+        point = Point2D(2.3, 3.1)
+        wavelengths = np.linspace(4000, 5000, 5)
+        self.assertFloatsEqual(exposureIn.getInfo().getTransmissionCurve().sampleAt(point, wavelengths),
+                               exposure.getInfo().getTransmissionCurve().sampleAt(point, wavelengths))
+        self.assertEqual(exposureIn.getDetector().getName(), exposure.getDetector().getName())
+        # Writing must materialize any components that were never accessed.
+        exposure2 = reader2 = None
+        with lsst.utils.tests.getTempFilePath(".fits") as fileName2:
+            ExposureFitsReader(fileName).read(lazyComponents=True).writeFits(fileName2)
+            reader2 = ExposureFitsReader(fileName2)
+            exposure2 = reader2.read()
+        self.assertImagesEqual(exposureIn.getPsf().computeImage(), exposure2.getPsf().computeImage())
+        self.assertEqual(exposureIn.getInfo().getValidPolygon(), exposure2.getInfo().getValidPolygon())
+        self.assertEqual(exposureIn.getDetector().getName(), exposure2.getDetector().getName())
+
+    def checkLazyVarianceReader(self, exposureIn, fileName):
+        """Test reading with the variance plane deferred to first access.
+
+        Parameters
+        ----------
+        exposureIn : `Exposure`
+            Object originally saved, to compare against.
+        fileName : `str`
+            Name of the file the reader is reading.
+        """
+        reader = MaskedImageFitsReader(fileName)
+        maskedImage = reader.read(lazyVariance=True)
+        # The plane is re-read from the file by name, so the reader itself is
+        # not needed once read() returns.
+        del reader
+        self.assertTrue(maskedImage.isVarianceDeferred())
+        self.assertImagesEqual(maskedImage.image, exposureIn.image)
+        self.assertMasksEqual(maskedImage.mask, exposureIn.mask)
+        self.assertTrue(maskedImage.isVarianceDeferred())
+        self.assertImagesEqual(maskedImage.variance, exposureIn.variance)
+        self.assertFalse(maskedImage.isVarianceDeferred())
+        exposure = ExposureFitsReader(fileName).read(lazyVariance=True)
+        self.assertTrue(exposure.maskedImage.isVarianceDeferred())
+        self.assertImagesEqual(exposure.variance, exposureIn.variance)
+
     def testCompressedSinglePlaneExposureFitsReader(self):
         """Test that a compressed single plane image can be read as exposure.
         """
@@ -236,6 +307,21 @@ class FitsReaderTestCase(lsst.utils.tests.TestCase):
 
         self.assertMaskedImagesEqual(uncompressed.maskedImage, compressed.maskedImage)
 
+    def testCompressedSubregionRead(self):
+        """Test that subregion reads of a tile-compressed image match the
+        corresponding subimage of a full read.
+        """
+        compressed_file = os.path.join(TESTDIR, "data", "ticketdm26260.fits.fz")
+        reader = ImageFitsReader(compressed_file)
+        full = reader.read()
+        fullBBox = reader.readBBox()
+        bbox = Box2I(fullBBox.getMin() + Extent2I(1, 1),
+                     Extent2I(fullBBox.getWidth()//2, fullBBox.getHeight()//2))
+        for _ in range(2):  # the second read is served from the tile cache
+            sub = reader.read(bbox)
+            self.assertEqual(sub.getBBox(), bbox)
+            self.assertImagesEqual(sub, full.subset(bbox))
+
     def testMultiPlaneFitsReaders(self):
         """Run tests for MaskedImageFitsReader and ExposureFitsReader.
         """
@@ -285,6 +371,8 @@ class FitsReaderTestCase(lsst.utils.tests.TestCase):
                     exposureIn.writeFits(fileName)
                     self.checkMaskedImageFitsReader(exposureIn, fileName, self.dtypes[n:])
                     self.checkExposureFitsReader(exposureIn, fileName, self.dtypes[n:])
+                    self.checkLazyExposureFitsReader(exposureIn, fileName)
+                    self.checkLazyVarianceReader(exposureIn, fileName)
 
 
 class TestMemory(lsst.utils.tests.MemoryTestCase):
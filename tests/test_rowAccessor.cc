@@ -0,0 +1,85 @@
+/*
+ * Developed for the LSST Data Management System.
+ * This product includes software developed by the LSST Project
+ * (https://www.lsst.org).
+ * See the COPYRIGHT file at the top-level directory of this distribution
+ * for details of code ownership.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_DYN_LINK
+#define BOOST_TEST_MODULE RowAccessorCpp
+
+#pragma clang diagnostic push
+#pragma clang diagnostic ignored "-Wunused-variable"
+#include "boost/test/unit_test.hpp"
+#pragma clang diagnostic pop
+
+#include "lsst/geom/Angle.h"
+#include "lsst/afw/table/BaseTable.h"
+#include "lsst/afw/table/Catalog.h"
+#include "lsst/afw/table/RowAccessor.h"
+
+/*
+ * Unit tests for the typed row accessor, which is C++-only.
+ */
+namespace lsst {
+namespace afw {
+namespace table {
+
+BOOST_AUTO_TEST_CASE(RowAccessorBasics) {
+    Schema schema;
+    auto kInt = schema.addField<std::int32_t>("i", "");
+    auto kDouble = schema.addField<double>("d", "");
+    auto kAngle = schema.addField<lsst::geom::Angle>("a", "");
+
+    CatalogT<BaseRecord> catalog(BaseTable::make(schema));
+    for (int i = 0; i != 10; ++i) {
+        auto record = catalog.addNew();
+        record->set(kInt, i);
+        record->set(kDouble, 0.5 * i);
+        record->set(kAngle, i * lsst::geom::degrees);
+    }
+
+    auto accessor = makeRowAccessor(kInt, kDouble, kAngle);
+
+    // reads through a ConstRow match keyed access
+    for (std::size_t i = 0; i != catalog.size(); ++i) {
+        BaseRecord const& record = catalog[i];
+        auto row = accessor(record);
+        BOOST_CHECK_EQUAL(row.get<0>(), record.get(kInt));
+        BOOST_CHECK_EQUAL(row.get<1>(), record.get(kDouble));
+        BOOST_CHECK_EQUAL(row.get<2>().asDegrees(), record.get(kAngle).asDegrees());
+    }
+
+    // writes through a mutable Row are seen by keyed access
+    for (std::size_t i = 0; i != catalog.size(); ++i) {
+        auto row = accessor(catalog[i]);
+        row.get<0>() *= 2;
+        row.get<1>() += 1.0;
+    }
+    for (std::size_t i = 0; i != catalog.size(); ++i) {
+        BOOST_CHECK_EQUAL(catalog[i].get(kInt), 2 * static_cast<std::int32_t>(i));
+        BOOST_CHECK_EQUAL(catalog[i].get(kDouble), 0.5 * i + 1.0);
+    }
+
+    // an invalid key is rejected at construction, not at access time
+    Key<double> invalid;
+    BOOST_CHECK_THROW(makeRowAccessor(kInt, invalid), pex::exceptions::LogicError);
+}
+
+}  // namespace table
+}  // namespace afw
+}  // namespace lsst
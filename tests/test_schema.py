@@ -191,6 +191,27 @@ class SchemaTestCase(unittest.TestCase):
         self.assertFalse(schema1.compare(
             schema3, lsst.afw.table.Schema.EQUAL_NAMES))
 
+    def testFingerprint(self):
+        schema1 = lsst.afw.table.Schema()
+        schema1.addField("a", type=np.float32, doc="doc for a", units="m")
+        schema1.addField("b", type=np.int32, doc="doc for b", units="s")
+        # Names, docs, and units are not part of the key layout, so schemas
+        # that differ only in those have the same fingerprint (just as they
+        # compare equal with ==).
+        schema2 = lsst.afw.table.Schema()
+        schema2.addField("c", type=np.float32, doc="doc for c")
+        schema2.addField("d", type=np.int32, doc="doc for d")
+        self.assertEqual(schema1, schema2)
+        self.assertEqual(schema1.getFingerprint(), schema2.getFingerprint())
+        # Adding a field changes the key layout and hence the fingerprint.
+        schema2.addField("e", type="Flag", doc="doc for e")
+        self.assertNotEqual(schema1.getFingerprint(), schema2.getFingerprint())
+        # Reordering fields changes the key offsets and hence the fingerprint.
+        schema3 = lsst.afw.table.Schema()
+        schema3.addField("b", type=np.int32, doc="doc for b", units="s")
+        schema3.addField("a", type=np.float32, doc="doc for a", units="m")
+        self.assertNotEqual(schema1.getFingerprint(), schema3.getFingerprint())
+
     def testPickle(self):
         schema = lsst.afw.table.Schema()
         addTestFields(schema)
@@ -310,6 +331,49 @@ class SchemaMapperTestCase(unittest.TestCase):
         mapper3.addMapping(ka, "c", True)
         self.assertEqual(mapper3.getMapping(ka), kc)
 
+    def testMappedAssignFieldTypes(self):
+        """Test that assigning a record through a mapper copies every field
+        type faithfully, including after the mapper is modified.
+        """
+        schema = lsst.afw.table.Schema()
+        ka = schema.addField("a", type=np.float64, doc="doc for a")
+        kb = schema.addField("b", type=np.int32, doc="doc for b")
+        kc = schema.addField("c", type="ArrayF", size=3, doc="doc for c")
+        kd = schema.addField("d", type="ArrayD", size=0, doc="doc for d")
+        ke = schema.addField("e", type="Flag", doc="doc for e")
+        kf = schema.addField("f", type="String", size=8, doc="doc for f")
+        kg = schema.addField("g", type=lsst.geom.Angle, doc="doc for g")
+        mapper = lsst.afw.table.SchemaMapper(schema)
+        for key in (kb, ka, kc, kd, ke, kg):  # permuted order; 'f' initially unmapped
+            mapper.addMapping(key)
+        inputRecord = lsst.afw.table.BaseTable.make(schema).makeRecord()
+        inputRecord.set(ka, 3.25)
+        inputRecord.set(kb, 21623)
+        inputRecord.set(kc, np.array([1.5, 2.5, 3.5], dtype=np.float32))
+        inputRecord.set(kd, np.array([0.25, 0.5], dtype=np.float64))
+        inputRecord.set(ke, True)
+        inputRecord.set(kf, "values")
+        inputRecord.set(kg, 1.25*lsst.geom.radians)
+        outputRecord = lsst.afw.table.BaseTable.make(
+            mapper.getOutputSchema()).makeRecord()
+        outputRecord.assign(inputRecord, mapper)
+        self.assertEqual(outputRecord.get(mapper.getMapping(ka)), 3.25)
+        self.assertEqual(outputRecord.get(mapper.getMapping(kb)), 21623)
+        np.testing.assert_array_equal(
+            outputRecord.get(mapper.getMapping(kc)), inputRecord.get(kc))
+        np.testing.assert_array_equal(
+            outputRecord.get(mapper.getMapping(kd)), inputRecord.get(kd))
+        self.assertTrue(outputRecord.get(mapper.getMapping(ke)))
+        self.assertEqual(outputRecord.get(mapper.getMapping(kg)),
+                         1.25*lsst.geom.radians)
+        # Mappings added after a copy must be honored by subsequent copies.
+        mapper.addMapping(kf)
+        outputRecord2 = lsst.afw.table.BaseTable.make(
+            mapper.getOutputSchema()).makeRecord()
+        outputRecord2.assign(inputRecord, mapper)
+        self.assertEqual(outputRecord2.get(mapper.getMapping(kf)), "values")
+        self.assertEqual(outputRecord2.get(mapper.getMapping(ka)), 3.25)
+
     def testJoin2(self):
         s1 = lsst.afw.table.Schema()
         self.assertEqual(s1.join("a", "b"), "a_b")
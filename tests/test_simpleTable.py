@@ -189,6 +189,34 @@ class SimpleTableTestCase(lsst.utils.tests.TestCase):
         mem = lsst.afw.fits.MemFileManager()
         self._testBaseFits(mem)
 
+    def testBlockedFitsRead(self):
+        """Test a round-trip large enough to span several of the row blocks
+        the FITS reader reads flag, string, and scalar columns in.
+        """
+        schema = lsst.afw.table.Schema()
+        kD = schema.addField("fD", type="D")
+        kFlag1 = schema.addField("fFlag1", type="Flag")
+        kFlag2 = schema.addField("fFlag2", type="Flag")
+        kS = schema.addField("fS", type="String", size=8)
+        cat1 = lsst.afw.table.BaseCatalog(schema)
+        nRecords = 5000
+        cat1.reserve(nRecords)
+        for i in range(nRecords):
+            record = cat1.addNew()
+            record.set(kD, np.random.randn())
+            record.set(kFlag1, i % 3 == 0)
+            record.set(kFlag2, i % 7 == 0)
+            record.set(kS, "s%06d" % i)
+        with lsst.utils.tests.getTempFilePath(".fits") as tmpFile:
+            cat1.writeFits(tmpFile)
+            cat2 = lsst.afw.table.BaseCatalog.readFits(tmpFile)
+        self.assertEqual(len(cat1), len(cat2))
+        for r1, r2 in zip(cat1, cat2):
+            self.assertEqual(r1.get(kD), r2.get(kD))
+            self.assertEqual(r1.get(kFlag1), r2.get(kFlag1))
+            self.assertEqual(r1.get(kFlag2), r2.get(kFlag2))
+            self.assertEqual(r1.get(kS), r2.get(kS))
+
     def testColumnView(self):
         schema = lsst.afw.table.Schema()
         kB = schema.addField("fB", type="B")
@@ -383,6 +411,88 @@ class SimpleTableTestCase(lsst.utils.tests.TestCase):
         d = schema.extract("b_f*")
         self.assertEqual(sorted(d.keys()), ["b_f_c1", "b_f_c2"])
 
+    def testSetColumnNonContiguous(self):
+        schema = lsst.afw.table.Schema()
+        kInt = schema.addField("i", type=np.int32)
+        kFloat = schema.addField("f", type=np.float64)
+        kAngle = schema.addField("ang", type="Angle")
+        catalog = lsst.afw.table.BaseCatalog(schema)
+        for i in range(150):  # spans more than one memory block, so not contiguous
+            catalog.addNew()
+        self.assertFalse(catalog.isContiguous())
+        ints = np.arange(len(catalog), dtype=np.int32)
+        floats = np.random.randn(len(catalog))
+        angles = np.random.uniform(size=len(catalog))
+        catalog[kInt] = ints
+        catalog[kFloat] = floats
+        catalog[kAngle] = angles
+        np.testing.assert_array_equal(catalog[kInt], ints)
+        np.testing.assert_array_equal(catalog[kFloat], floats)
+        np.testing.assert_array_equal(catalog[kAngle], angles)
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            catalog[kFloat] = np.zeros(5)
+
+    def testSelectRecords(self):
+        schema = lsst.afw.table.Schema()
+        kGood = schema.addField("good", type="Flag")
+        kBad = schema.addField("bad", type="Flag")
+        catalog = lsst.afw.table.BaseCatalog(schema)
+        catalog.preallocate(200)  # not a multiple of 64, so the last word is partial
+        good = np.random.randn(200) > 0
+        bad = np.random.randn(200) > 0
+        for i in range(200):
+            record = catalog.addNew()
+            record.set(kGood, bool(good[i]))
+            record.set(kBad, bool(bad[i]))
+        columns = catalog.getColumnView()
+        packed = columns.packBits(kGood)
+        unpacked = (packed[np.arange(200) // 64] >> (np.arange(200) % 64)) & 1
+        np.testing.assert_array_equal(unpacked.astype(bool), good)
+        np.testing.assert_array_equal(columns.selectRecords(mustBeSet=[kGood], mustBeClear=["bad"]),
+                                      np.nonzero(good & ~bad)[0])
+        np.testing.assert_array_equal(columns.selectRecords(mustBeClear=[kBad]), np.nonzero(~bad)[0])
+        np.testing.assert_array_equal(columns.selectRecords(), np.arange(200))
+
+    def testMakeRecords(self):
+        schema = lsst.afw.table.Schema()
+        kInt = schema.addField("i", type=np.int32)
+        table = lsst.afw.table.BaseTable.make(schema)
+        # Break up the current memory block so plain makeRecord calls would not be contiguous.
+        table.makeRecord()
+        catalog = lsst.afw.table.BaseCatalog(table)
+        catalog.extend(table.makeRecords(150))  # more than one ordinary memory block
+        self.assertEqual(len(catalog), 150)
+        self.assertTrue(catalog.isContiguous())
+        ints = np.arange(len(catalog), dtype=np.int32)
+        catalog[kInt] = ints
+        np.testing.assert_array_equal(catalog[kInt], ints)
+        # Recycling: records from a dropped catalog do not prevent a new batch from working.
+        del catalog
+        catalog = lsst.afw.table.BaseCatalog(table)
+        catalog.extend(table.makeRecords(150))
+        self.assertTrue(catalog.isContiguous())
+
+    def testAppendRecords(self):
+        schema = lsst.afw.table.Schema()
+        kInt = schema.addField("i", type=np.int32)
+        catalog = lsst.afw.table.BaseCatalog(schema)
+        view = catalog.appendRecords(150)  # more than one ordinary memory block
+        self.assertEqual(len(catalog), 150)
+        self.assertEqual(len(view), 150)
+        self.assertTrue(catalog.isContiguous())
+        # the view shares records with the catalog, so writes through either are seen by both
+        ints = np.arange(150, dtype=np.int32)
+        view[kInt] = ints
+        np.testing.assert_array_equal(catalog[kInt], ints)
+        # a second batch appends after the first; the new records are contiguous
+        # among themselves even though they live in a fresh memory block
+        view2 = catalog.appendRecords(50)
+        self.assertEqual(len(catalog), 200)
+        self.assertTrue(view2.isContiguous())
+        view2[kInt] = np.arange(150, 200, dtype=np.int32)
+        np.testing.assert_array_equal(view2[kInt], np.arange(150, 200, dtype=np.int32))
+        self.assertEqual(catalog[199].get(kInt), 199)
+
     def testExtend(self):
         schema1 = lsst.afw.table.SourceTable.makeMinimalSchema()
         k1 = schema1.addField("f1", type=np.int32)
@@ -546,6 +656,87 @@ class SimpleTableTestCase(lsst.utils.tests.TestCase):
         self.assertEqual(s.start, cat.lower_bound(3, ki))
         self.assertEqual(s.stop, cat.upper_bound(3, ki))
 
+    def testSortedView(self):
+        """Test that sorted() returns a sorted shallow copy without reordering
+        the original catalog.
+        """
+        schema = lsst.afw.table.SimpleTable.makeMinimalSchema()
+        kl = schema.addField("l", type=np.int64, doc="doc for l")
+        cat = lsst.afw.table.SimpleCatalog(schema)
+        for j in range(50, 0, -1):
+            cat.addNew().set(kl, j)
+        view = cat.sorted(kl)
+        self.assertTrue(view.isSorted(kl))
+        self.assertFalse(cat.isSorted(kl))
+        # the view shares records with the original catalog
+        view.find(10, kl).set(kl, -10)
+        self.assertEqual(cat[40].get(kl), -10)
+
+    def testMergedSorted(self):
+        """Test the k-way streaming merge of pre-sorted catalogs.
+        """
+        schema = lsst.afw.table.SimpleTable.makeMinimalSchema()
+        kl = schema.addField("l", type=np.int64, doc="doc for l")
+        table = lsst.afw.table.SimpleTable.make(schema)
+        # interleaved, with a tie between the first two catalogs
+        values = ([0, 3, 6, 9, 12], [1, 3, 7, 10], [2, 5, 8])
+        cats = []
+        for vals in values:
+            cat = lsst.afw.table.SimpleCatalog(table)
+            for v in vals:
+                cat.addNew().set(kl, v)
+            cats.append(cat)
+        merged = lsst.afw.table.SimpleCatalog.merged(cats, kl)
+        self.assertEqual(len(merged), sum(len(c) for c in cats))
+        self.assertTrue(merged.isSorted(kl))
+        self.assertEqual([record.get(kl) for record in merged], sorted(sum(values, [])))
+        # ties are broken in favor of the earlier catalog
+        ties = [record.getId() for record in merged if record.get(kl) == 3]
+        self.assertEqual(ties, [cats[0][1].getId(), cats[1][1].getId()])
+        # the shallow merge shares records with the inputs
+        merged.find(12, kl).set(kl, 13)
+        self.assertEqual(cats[0][-1].get(kl), 13)
+        cats[0][-1].set(kl, 12)
+        # a deep merge copies into a contiguous table
+        deep = lsst.afw.table.SimpleCatalog.merged(cats, kl, deep=True)
+        self.assertTrue(deep.isContiguous())
+        self.assertEqual(list(deep[kl]), sorted(sum(values, [])))
+        deep.find(12, kl).set(kl, 13)
+        self.assertEqual(cats[0][-1].get(kl), 12)
+        # inputs must be sorted by the given key
+        cats[1][0].set(kl, 100)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            lsst.afw.table.SimpleCatalog.merged(cats, kl)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            lsst.afw.table.SimpleCatalog.merged([], kl)
+
+    def testIdIndex(self):
+        """Test hash-indexed ID lookups via defineIdIndex/findById.
+        """
+        table = lsst.afw.table.SimpleTable.make(lsst.afw.table.SimpleTable.makeMinimalSchema())
+        records = [table.makeRecord() for i in range(10)]
+        cat = lsst.afw.table.SimpleCatalog(table)
+        for record in reversed(records):
+            cat.append(record)
+        self.assertFalse(cat.hasIdIndex())
+        with self.assertRaises(lsst.pex.exceptions.LogicError):
+            cat.findById(records[0].getId())
+        cat.defineIdIndex()
+        self.assertTrue(cat.hasIdIndex())
+        # lookups do not require the catalog to be sorted
+        self.assertFalse(cat.isSorted())
+        for record in records:
+            self.assertEqual(cat.findById(record.getId()).getId(), record.getId())
+        self.assertIsNone(cat.findById(-1))
+        # records added after the index is built are indexed incrementally
+        extra = cat.addNew()
+        self.assertEqual(cat.findById(extra.getId()).getId(), extra.getId())
+        # removing records discards the index
+        del cat[0]
+        self.assertFalse(cat.hasIdIndex())
+        with self.assertRaises(lsst.pex.exceptions.LogicError):
+            cat.findById(extra.getId())
+
     def testRename(self):
         """Test field-renaming functionality in Field, SchemaMapper.
         """
@@ -727,6 +918,40 @@ class SimpleTableTestCase(lsst.utils.tests.TestCase):
         np.testing.assert_array_equal(record4.get(kArrayD), dataD)
         self.assertEqual(record4.get(kString), dataString)
 
+    def testAssignRawCopy(self):
+        """Assignment between records whose schema has no variable-length
+        fields is done with a single raw copy of the record data; check that
+        it copies every field type correctly, including bit-packed Flags.
+        """
+        schema = lsst.afw.table.Schema()
+        kI = schema.addField("fI", type=np.int32, doc="int")
+        kFlag1 = schema.addField("fFlag1", type="Flag", doc="flag 1")
+        kD = schema.addField("fD", type=np.float64, doc="double")
+        kArrayF = schema.addField("fArrayF", type="ArrayF", doc="fixed-size array", size=3)
+        kFlag2 = schema.addField("fFlag2", type="Flag", doc="flag 2")
+        cat = lsst.afw.table.BaseCatalog(schema)
+        record1 = cat.addNew()
+        record1.set(kI, 42)
+        record1.set(kFlag1, True)
+        record1.set(kD, 3.25)
+        record1.set(kArrayF, np.array([1.0, 2.0, 3.0], dtype=np.float32))
+        record1.set(kFlag2, False)
+        record2 = cat.addNew()
+        record2.set(kFlag2, True)
+        record2.assign(record1)
+        self.assertEqual(record2.get(kI), 42)
+        self.assertTrue(record2.get(kFlag1))
+        self.assertEqual(record2.get(kD), 3.25)
+        self.assertFloatsEqual(record2.get(kArrayF), record1.get(kArrayF))
+        self.assertFalse(record2.get(kFlag2))
+        # The copy must be deep for fixed-size arrays.
+        record1[kArrayF][1] = 5.0
+        self.assertEqual(record2[kArrayF][1], 2.0)
+        # Assignment between records with different schemas must still throw.
+        otherCat = lsst.afw.table.BaseCatalog(lsst.afw.table.Schema())
+        with self.assertRaises(lsst.pex.exceptions.LogicError):
+            record2.assign(otherCat.addNew())
+
     def testCompoundFieldFitsConversion(self):
         """Test that we convert compound fields saved with an older version of the pipeline
         into the set of multiple fields used by their replacement FunctorKeys.
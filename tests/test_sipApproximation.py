@@ -524,6 +524,37 @@ class SipApproximationTestCases(lsst.utils.tests.TestCase):
         run(self.calexp03, order=3)
         run(self.wcs22, order=8)
 
+    def testUpdateTransform(self):
+        """Check that updateTransform refits to a new transform while keeping
+        the grid and fit parameters, and agrees with a from-scratch fit.
+        """
+        md2 = dict(self.calexp03)
+        md2["A_2_0"] *= 1.01
+        md2["B_0_2"] *= 0.99
+        md2["AP_2_0"] *= 1.01
+        md2["BP_0_2"] *= 0.99
+        kwds1 = extractCtorArgs(self.calexp03)
+        kwds2 = extractCtorArgs(md2)
+        gridShape = Extent2I(20, 20)
+        approx = SipApproximation(gridShape=gridShape, order=3, **kwds1)
+        approx.updateTransform(kwds2["pixelToIwc"])
+        self.assertEqual(approx.getOrder(), 3)
+        self.assertEqual(approx.getGridShape(), gridShape)
+        fresh = SipApproximation(gridShape=gridShape, order=3, **kwds2)
+        assert_allclose(approx.getA(), fresh.getA(), rtol=1E-10, atol=1E-16)
+        assert_allclose(approx.getB(), fresh.getB(), rtol=1E-10, atol=1E-16)
+        assert_allclose(approx.getAP(), fresh.getAP(), rtol=1E-10, atol=1E-16)
+        assert_allclose(approx.getBP(), fresh.getBP(), rtol=1E-10, atol=1E-16)
+        diffs = approx.computeMaxDeviation()
+        self.assertLess(diffs[0], 0.1)
+        self.assertLess(diffs[1], 0.1)
+        # A subsequent grid change must invalidate the cached fit machinery.
+        approx.updateGrid(Extent2I(21, 21))
+        approx.fit(3)
+        diffs = approx.computeMaxDeviation()
+        self.assertLess(diffs[0], 0.1)
+        self.assertLess(diffs[1], 0.1)
+
     def testCalculateSipWcsHeader(self):
         """Test the calculateSipWcsHeader function
 
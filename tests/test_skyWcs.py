@@ -11,6 +11,7 @@ import numpy as np
 from numpy.testing import assert_allclose
 
 import lsst.utils.tests
+import lsst.pex.exceptions
 from lsst.daf.base import PropertyList
 import lsst.geom
 import lsst.afw.cameraGeom as cameraGeom
@@ -418,6 +419,41 @@ class SimpleSkyWcsTestCase(SkyWcsBaseTestCase):
 
             self.checkNonFitsWcs(modifiedWcs)
 
+    def testMakeModifiedWcsList(self):
+        """Test the bulk overload of makeModifiedWcs
+        """
+        cdMatrix = makeCdMatrix(scale=self.scale)
+        wcsList = [makeSkyWcs(crpix=self.crpix + lsst.geom.Extent2D(100.0*i, -50.0*i),
+                              crval=self.crvalList[0], cdMatrix=cdMatrix)
+                   for i in range(5)]
+        pixelTransform = makeRadialTransform([0.0, 1.0, 0.0, 0.0011])
+        pixPointList = (
+            lsst.geom.Point2D(0.0, 0.0),
+            lsst.geom.Point2D(1000.0, 0.0),
+            lsst.geom.Point2D(-1111.0, -2222.0),
+        )
+        for modifyActualPixels in (False, True):
+            modifiedList = makeModifiedWcs(pixelTransform=pixelTransform,
+                                           wcsList=wcsList,
+                                           modifyActualPixels=modifyActualPixels)
+            self.assertEqual(len(modifiedList), len(wcsList))
+            for wcs, modifiedWcs in zip(wcsList, modifiedList):
+                # each output must match the scalar overload applied to the
+                # corresponding input
+                desiredWcs = makeModifiedWcs(pixelTransform=pixelTransform,
+                                             wcs=wcs,
+                                             modifyActualPixels=modifyActualPixels)
+                self.assertSpherePointListsAlmostEqual(
+                    modifiedWcs.pixelToSky(pixPointList),
+                    desiredWcs.pixelToSky(pixPointList))
+        # an empty list is allowed
+        self.assertEqual(makeModifiedWcs(pixelTransform=pixelTransform, wcsList=[],
+                                         modifyActualPixels=False), [])
+        # null entries are not
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            makeModifiedWcs(pixelTransform=pixelTransform, wcsList=[wcsList[0], None],
+                            modifyActualPixels=False)
+
     def testMakeModifiedWcsWithActualPixels(self):
         """Test makeModifiedWcs on a SkyWcs that has an ACTUAL_PIXELS frame
         """
@@ -569,6 +605,58 @@ class SimpleSkyWcsTestCase(SkyWcsBaseTestCase):
             self.assertAlmostEqual(r, spherePoint.getRa().asDegrees())
             self.assertAlmostEqual(d, spherePoint.getDec().asDegrees())
 
+    def testDeepCopy(self):
+        """Test that deepCopy gives an equivalent but independent SkyWcs
+        """
+        cdMatrix = makeCdMatrix(scale=self.scale)
+        wcs = makeSkyWcs(crpix=self.crpix, crval=self.crvalList[0], cdMatrix=cdMatrix)
+        copy = wcs.deepCopy()
+        self.assertEqual(wcs, copy)
+
+        pixPointList = [lsst.geom.Point2D(x, y) for x, y in
+                        zip([0.0, 1000.0, 0.0, -1111.0], [0.0, 0.0, 2000.0, -2222.0])]
+        self.assertSpherePointListsAlmostEqual(wcs.pixelToSky(pixPointList),
+                                               copy.pixelToSky(pixPointList))
+        self.assertIsNot(copy, wcs)
+
+    def testTanFastPathConsistency(self):
+        """Test that pixelToSky/skyToPixel agree with the generic transform
+
+        A pure TAN WCS takes a closed-form fast path in pixelToSky and
+        skyToPixel; it must give the same answers as the underlying
+        transform, which always uses the generic path.
+        """
+        pixPointList = [lsst.geom.Point2D(x, y) for x, y in
+                        zip([0.0, 100.0, 1500.0, -1111.0, 0.3],
+                            [0.0, 100.0, 0.0, -2222.0, 1e5])]
+        for crval in self.crvalList:
+            for orientation in self.orientationList:
+                for flipX in (False, True):
+                    cdMatrix = makeCdMatrix(scale=self.scale, orientation=orientation, flipX=flipX)
+                    wcs = makeSkyWcs(crpix=self.crpix, crval=crval, cdMatrix=cdMatrix)
+                    transform = wcs.getTransform()
+                    skyPointList = wcs.pixelToSky(pixPointList)
+                    self.assertSpherePointListsAlmostEqual(
+                        skyPointList, transform.applyForward(pixPointList),
+                        maxSep=1e-5*lsst.geom.arcseconds)
+                    for pixPoint, roundTrip in zip(pixPointList, wcs.skyToPixel(skyPointList)):
+                        self.assertPairsAlmostEqual(pixPoint, roundTrip)
+
+        # A distorted WCS must fall back to the generic path and still agree
+        cdMatrix = makeCdMatrix(scale=self.scale)
+        tanWcs = makeSkyWcs(crpix=self.crpix, crval=self.crvalList[0], cdMatrix=cdMatrix)
+        pixelTransform = makeRadialTransform([0.0, 1.0, 0.0, 1e-8])
+        distortedWcs = makeModifiedWcs(pixelTransform=pixelTransform, wcs=tanWcs,
+                                       modifyActualPixels=False)
+        transform = distortedWcs.getTransform()
+        self.assertSpherePointListsAlmostEqual(
+            distortedWcs.pixelToSky(pixPointList), transform.applyForward(pixPointList),
+            maxSep=self.tinyAngle)
+        # The distorted and undistorted WCS must differ far from the pixel origin
+        self.assertGreater(
+            distortedWcs.pixelToSky(pixPointList[3]).separation(tanWcs.pixelToSky(pixPointList[3])),
+            1*lsst.geom.arcseconds)
+
     def testSkyToPixelArray(self):
         """Test the numpy-array version of skyToPixel
         """
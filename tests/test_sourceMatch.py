@@ -305,6 +305,71 @@ class SourceMatchTestCase(lsst.utils.tests.TestCase):
                 catMismatches, cat2, 1.0*lsst.geom.arcseconds, mc)
             self.assertEqual(len(noMatches), 0)
 
+    def testMatchIndex(self):
+        """Check that a persistent SourceMatchIndex reproduces matchRaDec,
+        including sharded (numThreads > 1) queries.
+        """
+        nobj = 500
+        rng = np.random.RandomState(42)
+        raRef = 10 + 0.01*rng.uniform(size=nobj)
+        decRef = 10 + 0.01*rng.uniform(size=nobj)
+        coordKey = afwTable.SourceTable.getCoordKey()
+        for i in range(nobj):
+            s = self.ss1.addNew()
+            s.setId(i)
+            s.set(coordKey.getRa(), raRef[i] * lsst.geom.degrees)
+            s.set(coordKey.getDec(), decRef[i] * lsst.geom.degrees)
+            s = self.ss2.addNew()
+            s.setId(2*nobj + i)
+            s.set(coordKey.getRa(), (raRef[i] + 1e-7*i) * lsst.geom.degrees)
+            s.set(coordKey.getDec(), (decRef[i] + 1e-7*i) * lsst.geom.degrees)
+        index = afwTable.SourceMatchIndex(self.ss2)
+        self.assertEqual(len(index), nobj)
+        for closest in (True, False):
+            mc = afwTable.MatchControl()
+            mc.findOnlyClosest = closest
+            expected = afwTable.matchRaDec(self.ss1, self.ss2, 1.0*lsst.geom.arcseconds, mc)
+            for numThreads in (1, 4):
+                matches = index.match(self.ss1, 1.0*lsst.geom.arcseconds, mc, numThreads=numThreads)
+                self.assertEqual(len(matches), len(expected))
+                for m1, m2 in zip(expected, matches):
+                    self.assertEqual(m1.first, m2.first)
+                    self.assertEqual(m1.second, m2.second)
+                    self.assertEqual(m1.distance, m2.distance)
+
+    def testMatchNumThreads(self):
+        """Check that MatchControl.numThreads reproduces the serial results exactly."""
+        nobj = 400
+        rng = np.random.RandomState(7)
+        coordKey = afwTable.SourceTable.getCoordKey()
+        for i in range(nobj):
+            for ss in (self.ss1, self.ss2):
+                s = ss.addNew()
+                s.setId(len(ss))
+                s.set(coordKey.getRa(), (10 + 0.002*rng.uniform()) * lsst.geom.degrees)
+                s.set(coordKey.getDec(), (10 + 0.002*rng.uniform()) * lsst.geom.degrees)
+
+        def assertSameMatches(expected, matches):
+            self.assertEqual(len(matches), len(expected))
+            for m1, m2 in zip(expected, matches):
+                self.assertEqual(m1.first, m2.first)
+                self.assertEqual(m1.second, m2.second)
+                self.assertEqual(m1.distance, m2.distance)
+
+        for symmetric in (True, False):
+            mc = afwTable.MatchControl()
+            mc.symmetricMatch = symmetric
+            expected = afwTable.matchRaDec(self.ss1, 10.0*lsst.geom.arcseconds, mc)
+            mc.numThreads = 4
+            assertSameMatches(expected, afwTable.matchRaDec(self.ss1, 10.0*lsst.geom.arcseconds, mc))
+        for closest in (True, False):
+            mc = afwTable.MatchControl()
+            mc.findOnlyClosest = closest
+            expected = afwTable.matchRaDec(self.ss1, self.ss2, 10.0*lsst.geom.arcseconds, mc)
+            mc.numThreads = 4
+            assertSameMatches(expected,
+                              afwTable.matchRaDec(self.ss1, self.ss2, 10.0*lsst.geom.arcseconds, mc))
+
     def checkMatchToFromCatalog(self, matches, catalog):
         """Check the conversion of matches to and from a catalog
 
@@ -380,6 +445,58 @@ class SourceMatchTestCase(lsst.utils.tests.TestCase):
         self.assertLess(diff.std(), tol)  # I get 4e-12
         self.assertFloatsAlmostEqual(dist1, dist2, atol=tol)
 
+    def testMatchKernels(self):
+        """Test the vectorized separation/position-angle/offset kernels against
+        scalar SpherePoint computations over the same matches.
+        """
+        num = 200
+        radius = 1.0*lsst.geom.arcseconds
+        rng = np.random.RandomState(54321)
+        coordKey = afwTable.SourceTable.getCoordKey()
+        raKey = coordKey.getRa()
+        decKey = coordKey.getDec()
+        for ii in range(num):
+            src1 = self.ss1.addNew()
+            src1.setId(ii)
+            src1.set(raKey, (10 + 0.001*ii) * lsst.geom.degrees)
+            src1.set(decKey, (10 + 0.001*ii) * lsst.geom.degrees)
+
+            src2 = self.ss2.addNew()
+            src2.setId(2*num + ii)
+            src2.set(coordKey,
+                     src1.getCoord().offset(rng.uniform(high=360)*lsst.geom.degrees,
+                                            rng.uniform(high=radius.asArcseconds())*lsst.geom.arcseconds))
+
+        matches = afwTable.matchRaDec(self.ss1, self.ss2, radius)
+        self.assertEqual(len(matches), num)
+
+        separations = afwTable.matchSeparations(matches)
+        expected = np.array([mm.first.getCoord().separation(mm.second.getCoord()).asRadians()
+                             for mm in matches])
+        self.assertFloatsAlmostEqual(separations, expected, atol=1.0e-14)
+
+        ra1 = np.array([mm.first.getRa().asRadians() for mm in matches])
+        dec1 = np.array([mm.first.getDec().asRadians() for mm in matches])
+        ra2 = np.array([mm.second.getRa().asRadians() for mm in matches])
+        dec2 = np.array([mm.second.getDec().asRadians() for mm in matches])
+
+        positionAngles = afwTable.matchPositionAngles(matches)
+        dRa = ra2 - ra1
+        expected = np.arctan2(np.sin(dRa)*np.cos(dec2),
+                              np.cos(dec1)*np.sin(dec2) - np.sin(dec1)*np.cos(dec2)*np.cos(dRa))
+        self.assertFloatsAlmostEqual(positionAngles, expected, atol=1.0e-15)
+
+        offsets = afwTable.matchOffsets(matches)
+        self.assertEqual(offsets.shape, (num, 2))
+        self.assertFloatsAlmostEqual(offsets[:, 0], dRa*np.cos(dec1), atol=1.0e-15)
+        self.assertFloatsAlmostEqual(offsets[:, 1], dec2 - dec1, atol=1.0e-15)
+
+        # a mismatch (null second record) yields NaNs rather than an error
+        matches[0].second = None
+        self.assertTrue(np.isnan(afwTable.matchSeparations(matches)[0]))
+        self.assertTrue(np.isnan(afwTable.matchPositionAngles(matches)[0]))
+        self.assertTrue(np.all(np.isnan(afwTable.matchOffsets(matches)[0])))
+
 
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
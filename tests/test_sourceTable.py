@@ -408,6 +408,47 @@ class SourceTableTestCase(lsst.utils.tests.TestCase):
         with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
             lsst.afw.table.IdFactory.makeSource(0x1FFFFFFFF, reserved)
 
+    def testThreadSafeIdFactory(self):
+        expId = int(1257198)
+        reserved = 32
+        # the thread-safe factory produces the same IDs as makeSource
+        factory = lsst.afw.table.IdFactory.makeSource(expId, reserved)
+        atomic = lsst.afw.table.IdFactory.makeSourceThreadSafe(expId, reserved)
+        for i in range(5):
+            self.assertEqual(factory(), atomic())
+        atomic.notify(0xFFFFFFFF)
+        with self.assertRaises(lsst.pex.exceptions.LengthError):
+            atomic()
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            atomic.notify(0x1FFFFFFFF)
+        # a clone counts independently of the original
+        atomic2 = atomic.clone()
+        atomic2.notify(0)
+        self.assertEqual(atomic2(), (expId << reserved) | 1)
+
+    def testShardedIdFactory(self):
+        expId = int(1257198)
+        reserved = 32
+        factories = lsst.afw.table.IdFactory.makeSourceShards(expId, reserved, 4)
+        self.assertEqual(len(factories), 4)
+        # all shards pack the exposure ID into the same upper bits as makeSource
+        # and produce mutually disjoint IDs
+        ids = set()
+        for shard, factory in enumerate(factories):
+            for i in range(100):
+                newId = factory()
+                self.assertEqual(newId >> reserved, expId)
+                self.assertEqual((newId >> (reserved - 2)) & 0x3, shard)
+                ids.add(newId)
+        self.assertEqual(len(ids), 400)
+        # shard 0 of a power-of-two split starts at the same ID as makeSource
+        self.assertEqual(lsst.afw.table.IdFactory.makeSourceShards(expId, reserved, 2)[0](),
+                         lsst.afw.table.IdFactory.makeSource(expId, reserved)())
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            lsst.afw.table.IdFactory.makeSourceShards(expId, reserved, 0)
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            lsst.afw.table.IdFactory.makeSourceShards(expId, 2, 4)
+
     def testFamilies(self):
         self.catalog.sort()
         parents = self.catalog.getChildren(0)
@@ -124,6 +124,8 @@ class SpanSetTestCase(lsst.utils.tests.TestCase):
 
         self.assertEqual(center.getX(), 2)
         self.assertEqual(center.getY(), 2)
+        # Repeat queries come from the cache and must agree
+        self.assertEqual(spanSetShape.computeCentroid(), center)
 
     def testComputeShape(self):
         spanSetShape = afwGeom.SpanSet.fromShape(1, afwGeom.Stencil.CIRCLE)
@@ -132,6 +134,11 @@ class SpanSetTestCase(lsst.utils.tests.TestCase):
         self.assertEqual(quad.getIxx(), 0.4)
         self.assertEqual(quad.getIyy(), 0.4)
         self.assertEqual(quad.getIxy(), 0)
+        # Repeat queries come from the cache and must agree
+        quadAgain = spanSetShape.computeShape()
+        self.assertEqual(quadAgain.getIxx(), quad.getIxx())
+        self.assertEqual(quadAgain.getIyy(), quad.getIyy())
+        self.assertEqual(quadAgain.getIxy(), quad.getIxy())
 
     def testdilated(self):
         spanSetPredilated = afwGeom.SpanSet.fromShape(1, afwGeom.Stencil.CIRCLE)
@@ -149,6 +156,33 @@ class SpanSetTestCase(lsst.utils.tests.TestCase):
         self.assertEqual(bBox.getMinX(), -1)
         self.assertEqual(bBox.getMinY(), -1)
 
+    def testMorphologyEquivalence(self):
+        # dilated and eroded should agree with brute-force set morphology,
+        # including for structuring elements with several spans in one row
+        a = afwGeom.SpanSet([afwGeom.Span(0, 0, 8),
+                             afwGeom.Span(1, 2, 4),
+                             afwGeom.Span(1, 7, 10),
+                             afwGeom.Span(3, 0, 12)])
+        b = afwGeom.SpanSet([afwGeom.Span(-1, 0, 0),
+                             afwGeom.Span(0, -1, 1),
+                             afwGeom.Span(1, -2, -1),
+                             afwGeom.Span(1, 1, 2)])
+
+        def pixels(spanSet):
+            return {(x, span.getY())
+                    for span in spanSet
+                    for x in range(span.getMinX(), span.getMaxX() + 1)}
+
+        for structure in (b, afwGeom.SpanSet.fromShape(2, afwGeom.Stencil.CIRCLE)):
+            aPix = pixels(a)
+            sPix = pixels(structure)
+            self.assertEqual(pixels(a.dilated(structure)),
+                             {(xa + xs, ya + ys) for xa, ya in aPix for xs, ys in sPix})
+            candidates = {(xa - xs, ya - ys) for xa, ya in aPix for xs, ys in sPix}
+            self.assertEqual(pixels(a.eroded(structure)),
+                             {(x, y) for x, y in candidates
+                              if all((x + xs, y + ys) in aPix for xs, ys in sPix)})
+
     def testFlatten(self):
         # Give an initial value to an input array
         inputArray = np.ones((6, 6)) * 9
@@ -440,6 +474,25 @@ class SpanSetTestCase(lsst.utils.tests.TestCase):
         self.assertEqual(len(span), len(points))
         self.assertEqual(points, [lsst.geom.Point2I(x, 4) for x in range(3, 9)])
 
+    def testPersistence(self):
+        # Exercise the delta-encoded persistence format with negative
+        # coordinates, large jumps between rows, and a wide span
+        spans = [afwGeom.Span(-5, -10, -3),
+                 afwGeom.Span(-5, 2, 300),
+                 afwGeom.Span(30, -1000, -999),
+                 afwGeom.Span(1000000, 7, 7)]
+        spanSet = afwGeom.SpanSet(spans)
+        with lsst.utils.tests.getTempFilePath(".fits") as tmpFile:
+            spanSet.writeFits(tmpFile)
+            spanSetRead = afwGeom.SpanSet.readFits(tmpFile)
+        self.assertEqual(spanSet, spanSetRead)
+        self.assertEqual(list(spanSetRead), spans)
+        # An empty SpanSet must round-trip as well
+        with lsst.utils.tests.getTempFilePath(".fits") as tmpFile:
+            afwGeom.SpanSet().writeFits(tmpFile)
+            emptyRead = afwGeom.SpanSet.readFits(tmpFile)
+        self.assertEqual(len(emptyRead), 0)
+
 
 class TestMemory(lsst.utils.tests.MemoryTestCase):
     pass
@@ -214,6 +214,40 @@ class SpatialCellSetTestCase(unittest.TestCase):
 
         self.assertFalse(self.cellSet.getCellList()[5].empty())
 
+    def testFindCandidatesIn(self):
+        """Test bulk queries for candidates in a bounding box"""
+
+        self.makeTestCandidateCellSet()
+
+        # the whole region returns everything
+        candidates = self.cellSet.findCandidatesIn(self.cellSet.getBBox())
+        self.assertEqual(len(candidates), self.NTestCandidates)
+
+        # a box covering only the candidates in cell0
+        box = lsst.geom.Box2I(lsst.geom.Point2I(0, 0), lsst.geom.Extent2I(10, 10))
+        self.assertEqual(len(self.cellSet.findCandidatesIn(box)), 6)
+
+        # a box spanning cells 0 and 1 horizontally
+        box = lsst.geom.Box2I(lsst.geom.Point2I(0, 0), lsst.geom.Extent2I(501, 200))
+        self.assertEqual(len(self.cellSet.findCandidatesIn(box)), 7)
+
+        # a tight box around a single candidate
+        box = lsst.geom.Box2I(lsst.geom.Point2I(300, 0), lsst.geom.Extent2I(10, 5))
+        candidates = self.cellSet.findCandidatesIn(box)
+        self.assertEqual(len(candidates), 1)
+        self.assertEqual(candidates[0].getXCenter(), 305.0)
+
+        # a box that doesn't overlap the region at all
+        box = lsst.geom.Box2I(lsst.geom.Point2I(600, 600), lsst.geom.Extent2I(10, 10))
+        self.assertEqual(len(self.cellSet.findCandidatesIn(box)), 0)
+
+        # BAD candidates are skipped unless asked for
+        candidates[0].setStatus(afwMath.SpatialCellCandidate.BAD)
+        self.assertEqual(len(self.cellSet.findCandidatesIn(self.cellSet.getBBox())),
+                         self.NTestCandidates - 1)
+        self.assertEqual(len(self.cellSet.findCandidatesIn(self.cellSet.getBBox(), ignoreBad=False)),
+                         self.NTestCandidates)
+
     def testVisitor(self):
         """Test the candidate visitors"""
 
@@ -403,6 +403,128 @@ class StackTestCase(lsst.utils.tests.TestCase):
         self.assertEqual(stack.mask[1, 1, afwImage.LOCAL], clipped)
         self.assertEqual(stack.mask[1, 2, afwImage.LOCAL], rejected)
 
+    def testTransposedMean(self):
+        """The transposed MEAN reduction for plain images must match numpy
+
+        MEAN on a stack of plain Images takes a transposed (pixel, epoch)
+        scratch path; check it against a direct weighted average, with and
+        without NaNs, serial and threaded.
+        """
+        np.random.seed(11)
+        nImg = 7
+        cube = np.random.normal(3.0, 1.0, (nImg, 25, 33)).astype(np.float32)
+        imgList = []
+        for i in range(nImg):
+            img = afwImage.ImageF(lsst.geom.Extent2I(33, 25))
+            img.array[:] = cube[i]
+            imgList.append(img)
+        weights = [float(i + 1) for i in range(nImg)]
+
+        imgStack = afwMath.statisticsStack(imgList, afwMath.MEAN)
+        self.assertFloatsAlmostEqual(imgStack.array, np.mean(cube, axis=0, dtype=np.float64),
+                                     rtol=1e-6)
+
+        imgStack = afwMath.statisticsStack(imgList, afwMath.MEAN, afwMath.StatisticsControl(), weights)
+        expect = np.average(cube.astype(np.float64), axis=0, weights=weights)
+        self.assertFloatsAlmostEqual(imgStack.array, expect, rtol=1e-6)
+
+        # a NaN sample drops out of its pixel's mean (nanSafe is the default)
+        imgList[2].array[10, 20] = np.nan
+        cube[2, 10, 20] = np.nan
+        imgStack = afwMath.statisticsStack(imgList, afwMath.MEAN, afwMath.StatisticsControl(), weights)
+        masked = np.ma.masked_invalid(cube.astype(np.float64))
+        expect = np.ma.average(masked, axis=0, weights=weights)
+        self.assertFloatsAlmostEqual(imgStack.array, np.asarray(expect), rtol=1e-6)
+
+        # the banded threaded path reduces each pixel identically
+        sctrl = afwMath.StatisticsControl()
+        sctrl.setNumThreads(4)
+        threaded = afwMath.statisticsStack(imgList, afwMath.MEAN, sctrl, weights)
+        self.assertFloatsEqual(threaded.array, imgStack.array)
+
+    def testStripReader(self):
+        """Streaming strip-fed stacking must agree exactly with the resident stack
+
+        The reader callback is asked for one strip of each input at a time, so
+        only the active strip need be resident; the per-pixel statistics are
+        unchanged, hence the exact comparison.
+        """
+        np.random.seed(7)
+        mimgList = []
+        for i in range(6):
+            mimg = afwImage.MaskedImageF(lsst.geom.Extent2I(30, 50))
+            mimg.image.array[:] = np.random.normal(5.0, 2.0, mimg.image.array.shape)
+            mimg.variance.array[:] = 1.0
+            mimg.mask.array[:] = 0x0
+            mimgList.append(mimg)
+        mimgList[2].image.array[42, 17] = 1000.0  # will be clipped
+        mimgList[3].mask.array[8, 9] = 0x1
+
+        sctrl = afwMath.StatisticsControl()
+        sctrl.setAndMask(0x1)
+
+        requested = []
+
+        def reader(imageIndex, stripBox):
+            requested.append((imageIndex, stripBox.getMinY(), stripBox.getHeight()))
+            return mimgList[imageIndex].Factory(mimgList[imageIndex], stripBox, afwImage.PARENT)
+
+        for flags in (afwMath.MEANCLIP, afwMath.MEDIAN):
+            direct = afwMath.statisticsStack(mimgList, flags, sctrl, clipped=0x2)
+            streamed = afwImage.MaskedImageF(lsst.geom.Extent2I(30, 50))
+            requested[:] = []
+            afwMath.statisticsStack(streamed, reader, len(mimgList), flags, sctrl,
+                                    clipped=0x2, stripHeight=16)
+            self.assertFloatsEqual(streamed.image.array, direct.image.array)
+            self.assertFloatsEqual(streamed.variance.array, direct.variance.array)
+            self.assertTrue(np.all(streamed.mask.array == direct.mask.array))
+            # 50 rows in strips of 16 -> 4 strips per input
+            self.assertEqual(len(requested), 4*len(mimgList))
+
+        # a reader returning the wrong shape is an error
+        def badReader(imageIndex, stripBox):
+            return afwImage.MaskedImageF(lsst.geom.Extent2I(1, 1))
+
+        with self.assertRaises(pexEx.InvalidParameterError):
+            afwMath.statisticsStack(afwImage.MaskedImageF(lsst.geom.Extent2I(30, 50)), badReader,
+                                    len(mimgList), afwMath.MEAN, sctrl)
+
+    def testNumThreads(self):
+        """Multi-threaded stacking must give exactly the serial answer
+
+        The threads shard the output rows; every per-pixel statistic is
+        computed just as in the serial case, so the images must be identical.
+        """
+        np.random.seed(5)
+        mimgList = []
+        for i in range(8):
+            mimg = afwImage.MaskedImageF(lsst.geom.Extent2I(37, 41))
+            mimg.image.array[:] = np.random.normal(10.0, 1.0, mimg.image.array.shape)
+            mimg.variance.array[:] = 1.0
+            mimg.mask.array[:] = 0x0
+            mimgList.append(mimg)
+        mimgList[0].mask.array[3, 4] = 0x1
+        mimgList[1].image.array[20, 11] = 100.0  # will be clipped
+
+        sctrlSerial = afwMath.StatisticsControl()
+        sctrlSerial.setAndMask(0x1)
+        sctrl = afwMath.StatisticsControl()
+        sctrl.setAndMask(0x1)
+        sctrl.setNumThreads(4)
+
+        for flags in (afwMath.MEAN, afwMath.MEANCLIP):
+            serial = afwMath.statisticsStack(mimgList, flags, sctrlSerial, clipped=0x2)
+            parallel = afwMath.statisticsStack(mimgList, flags, sctrl, clipped=0x2)
+            self.assertFloatsEqual(parallel.image.array, serial.image.array)
+            self.assertFloatsEqual(parallel.variance.array, serial.variance.array)
+            self.assertTrue(np.all(parallel.mask.array == serial.mask.array))
+
+        # plain Images take the same banded path
+        imgList = [mimg.getImage() for mimg in mimgList]
+        serial = afwMath.statisticsStack(imgList, afwMath.MEANCLIP, sctrlSerial)
+        parallel = afwMath.statisticsStack(imgList, afwMath.MEANCLIP, sctrl)
+        self.assertFloatsEqual(parallel.array, serial.array)
+
 #################################################################
 # Test suite boiler plate
 #################################################################
@@ -37,6 +37,7 @@ import numpy as np
 import lsst.utils.tests
 import lsst.pex.exceptions
 import lsst.geom
+import lsst.afw.geom as afwGeom
 import lsst.afw.image as afwImage
 import lsst.afw.math as afwMath
 import lsst.afw.display as afwDisplay
@@ -267,6 +268,241 @@ class StatisticsTestCase(lsst.utils.tests.TestCase):
         """Test that we can handle infinities correctly"""
         self._testBadValue(np.inf)
 
+    def testFloatAgreesWithDouble(self):
+        """Float images take a vectorized accumulation; check it against the double path
+
+        The double instantiation uses the generic accumulation loop, so any
+        disagreement beyond float rounding points at the float fast path.
+        """
+        w, h = 200, 150
+        np.random.seed(42)
+        values = np.random.normal(10.5, 1.0, (h, w))
+
+        mimgF = afwImage.MaskedImageF(lsst.geom.Extent2I(w, h))
+        mimgF.image.array[:] = values
+        mimgF.image.array[15, 25] = np.nan
+        mimgF.mask.array[:] = 0x0
+        mimgF.mask.array[7, 3] = 0x2   # rejected by andMask below
+        mimgF.mask.array[9, 11] = 0x4  # kept; must appear in the or-mask
+        mimgF.variance.array[:] = 1.0
+
+        mimgD = afwImage.MaskedImageD(lsst.geom.Extent2I(w, h))
+        mimgD.image.array[:] = mimgF.image.array
+        mimgD.mask.array[:] = mimgF.mask.array
+        mimgD.variance.array[:] = 1.0
+
+        sctrl = afwMath.StatisticsControl()
+        sctrl.setAndMask(0x2)
+
+        flags = (afwMath.NPOINT | afwMath.MEAN | afwMath.STDEV | afwMath.MIN | afwMath.MAX |
+                 afwMath.SUM | afwMath.MEANCLIP | afwMath.STDEVCLIP | afwMath.ORMASK)
+        statsF = afwMath.makeStatistics(mimgF, flags, sctrl)
+        statsD = afwMath.makeStatistics(mimgD, flags, sctrl)
+
+        self.assertEqual(statsF.getValue(afwMath.NPOINT), w*h - 2)
+        self.assertEqual(statsF.getValue(afwMath.NPOINT), statsD.getValue(afwMath.NPOINT))
+        self.assertEqual(statsF.getOrMask(), 0x4)
+        for prop in (afwMath.MEAN, afwMath.STDEV, afwMath.MIN, afwMath.MAX,
+                     afwMath.MEANCLIP, afwMath.STDEVCLIP):
+            self.assertAlmostEqual(statsF.getValue(prop), statsD.getValue(prop), places=5)
+
+        # the plain-Image front end uses the same fast path (with a phony mask); spot-check it
+        imgStats = afwMath.makeStatistics(mimgF.image, afwMath.MEAN | afwMath.STDEV, sctrl)
+        self.assertAlmostEqual(imgStats.getValue(afwMath.MEAN),
+                               np.nanmean(mimgF.image.array, dtype=np.float64), places=5)
+
+    def testQuantileTolerance(self):
+        """Histogram-based quantiles must agree with the exact ones within the tolerance"""
+        tolerance = 0.01
+        sctrl = afwMath.StatisticsControl()
+        self.assertEqual(sctrl.getQuantileTolerance(), 0.0)
+        sctrl.setQuantileTolerance(tolerance)
+        self.assertEqual(sctrl.getQuantileTolerance(), tolerance)
+
+        for image, isInt, mean, median, std in self.images:
+            exact = afwMath.makeStatistics(image, afwMath.MEDIAN | afwMath.IQRANGE | afwMath.MEANCLIP)
+            approx = afwMath.makeStatistics(image, afwMath.MEDIAN | afwMath.IQRANGE | afwMath.MEANCLIP,
+                                            sctrl)
+
+            self.assertAlmostEqual(approx.getValue(afwMath.MEDIAN), exact.getValue(afwMath.MEDIAN),
+                                   delta=tolerance)
+            # the IQR subtracts two estimates, so allow twice the tolerance
+            self.assertAlmostEqual(approx.getValue(afwMath.IQRANGE), exact.getValue(afwMath.IQRANGE),
+                                   delta=2*tolerance)
+            # the clip limits move by at most a few tolerances, which barely changes the mean
+            self.assertAlmostEqual(approx.getValue(afwMath.MEANCLIP), exact.getValue(afwMath.MEANCLIP),
+                                   delta=0.001)
+
+        # masked pixels and NaNs must be excluded, as in the exact path
+        mimg = afwImage.MaskedImageF(lsst.geom.Extent2I(100, 80))
+        np.random.seed(99)
+        mimg.image.array[:] = np.random.normal(20.0, 2.0, mimg.image.array.shape)
+        mimg.image.array[3, 4] = np.nan
+        mimg.mask.array[:] = 0x0
+        mimg.mask.array[5, 6] = 0x1
+        mimg.image.array[5, 6] = 1e10  # would wreck the histogram range if not masked out
+        sctrl.setAndMask(0x1)
+        approx = afwMath.makeStatistics(mimg, afwMath.MEDIAN, sctrl)
+        sctrlExact = afwMath.StatisticsControl()
+        sctrlExact.setAndMask(0x1)
+        exact = afwMath.makeStatistics(mimg, afwMath.MEDIAN, sctrlExact)
+        self.assertAlmostEqual(approx.getValue(afwMath.MEDIAN), exact.getValue(afwMath.MEDIAN),
+                               delta=tolerance)
+
+    def testNumThreads(self):
+        """Multi-threaded accumulation must agree with the serial result
+
+        NPOINT, MIN, MAX and the or-mask are exact; the summed statistics can
+        differ by rounding because the per-band partial sums are merged.
+        """
+        sctrlSerial = afwMath.StatisticsControl()
+        self.assertEqual(sctrlSerial.getNumThreads(), 1)
+        sctrlSerial.setAndMask(0x1)
+
+        sctrl = afwMath.StatisticsControl()
+        sctrl.setNumThreads(4)
+        self.assertEqual(sctrl.getNumThreads(), 4)
+        sctrl.setAndMask(0x1)
+
+        flags = (afwMath.NPOINT | afwMath.MEAN | afwMath.STDEV | afwMath.MIN | afwMath.MAX |
+                 afwMath.MEANCLIP | afwMath.STDEVCLIP)
+
+        # exercise both the float fast path and the generic accumulation (double)
+        for cls in (afwImage.MaskedImageF, afwImage.MaskedImageD):
+            mimg = cls(lsst.geom.Extent2I(123, 101))
+            np.random.seed(1)
+            mimg.image.array[:] = np.random.normal(100.0, 5.0, mimg.image.array.shape)
+            mimg.image.array[10, 20] = np.nan
+            mimg.mask.array[:] = 0x0
+            mimg.mask.array[30, 40] = 0x1
+            mimg.variance.array[:] = 25.0
+
+            serial = afwMath.makeStatistics(mimg, flags, sctrlSerial)
+            parallel = afwMath.makeStatistics(mimg, flags, sctrl)
+
+            self.assertEqual(parallel.getValue(afwMath.NPOINT), serial.getValue(afwMath.NPOINT))
+            self.assertEqual(parallel.getValue(afwMath.NPOINT), 123*101 - 2)
+            self.assertEqual(parallel.getValue(afwMath.MIN), serial.getValue(afwMath.MIN))
+            self.assertEqual(parallel.getValue(afwMath.MAX), serial.getValue(afwMath.MAX))
+            for prop in (afwMath.MEAN, afwMath.STDEV, afwMath.MEANCLIP, afwMath.STDEVCLIP):
+                self.assertAlmostEqual(parallel.getValue(prop), serial.getValue(prop), places=8)
+
+    def testSpanSetStatistics(self):
+        """Statistics under a SpanSet must agree with masking out the rest of the image
+
+        The SpanSet overloads iterate the spans in place instead of flattening
+        the footprint into a temporary array.
+        """
+        mimg = afwImage.MaskedImageF(lsst.geom.Box2I(lsst.geom.Point2I(5, 10),
+                                                     lsst.geom.Extent2I(80, 60)))
+        np.random.seed(17)
+        mimg.image.array[:] = np.random.normal(100.0, 5.0, mimg.image.array.shape)
+        mimg.mask.array[:] = 0x0
+        mimg.mask.array[25, 30] = 0x1   # inside the footprint; rejected by andMask
+        mimg.image.array[28, 33] = np.nan
+        mimg.variance.array[:] = 25.0
+
+        spans = afwGeom.SpanSet.fromShape(15, offset=lsst.geom.Point2I(40, 40))
+        self.assertTrue(mimg.getBBox().contains(spans.getBBox()))
+
+        sctrl = afwMath.StatisticsControl()
+        sctrl.setAndMask(0x1)
+
+        # select the same pixels by masking everything outside the footprint
+        OUTSIDE = 0x2
+        reference = mimg.clone()
+        afwGeom.SpanSet(mimg.getBBox()).intersectNot(spans).setMask(reference.mask, OUTSIDE)
+        refCtrl = afwMath.StatisticsControl()
+        refCtrl.setAndMask(0x1 | OUTSIDE)
+
+        flags = (afwMath.NPOINT | afwMath.SUM | afwMath.MEAN | afwMath.STDEV | afwMath.MIN |
+                 afwMath.MAX | afwMath.MEDIAN | afwMath.MEANCLIP | afwMath.STDEVCLIP)
+        stats = afwMath.makeStatistics(mimg, spans, flags, sctrl)
+        ref = afwMath.makeStatistics(reference, flags, refCtrl)
+
+        self.assertEqual(stats.getValue(afwMath.NPOINT), ref.getValue(afwMath.NPOINT))
+        self.assertEqual(stats.getValue(afwMath.MIN), ref.getValue(afwMath.MIN))
+        self.assertEqual(stats.getValue(afwMath.MAX), ref.getValue(afwMath.MAX))
+        self.assertEqual(stats.getValue(afwMath.MEDIAN), ref.getValue(afwMath.MEDIAN))
+        for prop in (afwMath.SUM, afwMath.MEAN, afwMath.STDEV, afwMath.MEANCLIP, afwMath.STDEVCLIP):
+            self.assertFloatsAlmostEqual(stats.getValue(prop), ref.getValue(prop), rtol=1e-8)
+
+        # the plain-Image overload, against the flattened pixels
+        values = spans.flatten(mimg.image.array, mimg.image.getXY0())
+        imgStats = afwMath.makeStatistics(mimg.image, spans, afwMath.NPOINT | afwMath.MEAN)
+        self.assertEqual(imgStats.getValue(afwMath.NPOINT), np.sum(np.isfinite(values)))
+        self.assertFloatsAlmostEqual(imgStats.getValue(afwMath.MEAN),
+                                     float(np.nanmean(values, dtype=np.float64)), rtol=1e-6)
+
+        # spans that extend outside the image are an error
+        outside = afwGeom.SpanSet.fromShape(15, offset=lsst.geom.Point2I(0, 0))
+        with self.assertRaises(lsst.pex.exceptions.InvalidParameterError):
+            afwMath.makeStatistics(mimg, outside, afwMath.MEAN, sctrl)
+
+    def testStatisticsAccumulator(self):
+        """Incremental accumulation must agree with a one-shot makeStatistics"""
+        sctrl = afwMath.StatisticsControl()
+        sctrl.setAndMask(0x2)
+        sctrl.setNanSafe(True)
+
+        mimg = afwImage.MaskedImageF(lsst.geom.Extent2I(120, 80))
+        np.random.seed(99)
+        mimg.image.array[:] = np.random.normal(50.0, 3.0, mimg.image.array.shape)
+        mimg.image.array[5, 7] = np.nan
+        mimg.mask.array[:] = 0x0
+        mimg.mask.array[12, 34] = 0x2   # rejected by andMask
+        mimg.mask.array[40, 60] = 0x4   # kept; should appear in the or-mask
+
+        flags = (afwMath.NPOINT | afwMath.SUM | afwMath.MEAN | afwMath.VARIANCE |
+                 afwMath.STDEV | afwMath.MIN | afwMath.MAX)
+        direct = afwMath.makeStatistics(mimg, flags, sctrl)
+
+        # accumulate the same pixels as two disjoint horizontal strips
+        top = afwImage.MaskedImageF(mimg, lsst.geom.Box2I(lsst.geom.Point2I(0, 0),
+                                                          lsst.geom.Extent2I(120, 30)))
+        bottom = afwImage.MaskedImageF(mimg, lsst.geom.Box2I(lsst.geom.Point2I(0, 30),
+                                                             lsst.geom.Extent2I(120, 50)))
+        acc = afwMath.StatisticsAccumulator(sctrl)
+        acc += top
+        acc += bottom
+
+        self.assertEqual(acc.getN(), direct.getValue(afwMath.NPOINT))
+        self.assertEqual(acc.getN(), 120*80 - 2)
+        self.assertEqual(acc.getMin(), direct.getValue(afwMath.MIN))
+        self.assertEqual(acc.getMax(), direct.getValue(afwMath.MAX))
+        self.assertEqual(acc.getOrMask(), 0x4)
+        self.assertAlmostEqual(acc.getSum(), direct.getValue(afwMath.SUM), places=6)
+        self.assertAlmostEqual(acc.getMean(), direct.getValue(afwMath.MEAN), places=8)
+        self.assertAlmostEqual(acc.getVariance(), direct.getValue(afwMath.VARIANCE), places=8)
+        self.assertAlmostEqual(acc.getStdev(), direct.getValue(afwMath.STDEV), places=8)
+
+        # merging two partial accumulators matches accumulating everything into one
+        accTop = afwMath.StatisticsAccumulator(sctrl)
+        accTop += top
+        accBottom = afwMath.StatisticsAccumulator(sctrl)
+        accBottom += bottom
+        accTop.merge(accBottom)
+        self.assertEqual(accTop.getN(), acc.getN())
+        self.assertEqual(accTop.getMin(), acc.getMin())
+        self.assertEqual(accTop.getMax(), acc.getMax())
+        self.assertEqual(accTop.getOrMask(), acc.getOrMask())
+        self.assertAlmostEqual(accTop.getMean(), acc.getMean(), places=10)
+        self.assertAlmostEqual(accTop.getStdev(), acc.getStdev(), places=8)
+
+        # a plain-number span joins the running totals
+        values = [1.0, 2.0, 3.0, 4.0]
+        accVec = afwMath.StatisticsAccumulator()
+        accVec += values
+        self.assertEqual(accVec.getN(), len(values))
+        self.assertAlmostEqual(accVec.getMean(), np.mean(values), places=12)
+        self.assertAlmostEqual(accVec.getStdev(), np.std(values, ddof=1), places=12)
+
+        # an empty accumulator yields NaN statistics and zero counts
+        empty = afwMath.StatisticsAccumulator()
+        self.assertEqual(empty.getN(), 0)
+        self.assertTrue(np.isnan(empty.getMean()))
+        self.assertTrue(np.isnan(empty.getMin()))
+
     @unittest.skipIf(afwdataDir is None, "afwdata not setup")
     def testSampleImageStats(self):
         """ Compare our results to known values in test data """
@@ -68,6 +68,20 @@ class TableAliasTestCase(lsst.utils.tests.TestCase):
         self.assertEqual(self.schema.getAliasMap().apply("s12"), "ab12")
         self.assertEqual(self.schema.getAliasMap().apply("t"), "ab11")
 
+    def testApplyAfterModification(self):
+        """Test that resolutions cached by apply() are discarded when an alias
+        is set or erased.
+        """
+        aliases = self.schema.getAliasMap()
+        self.assertEqual(aliases.apply("q11"), "a11")
+        aliases.set("q", "ab")
+        self.assertEqual(aliases.apply("q11"), "ab11")
+        self.assertEqual(self.schema.find("q11").key, self.ab11)
+        aliases.erase("q")
+        self.assertEqual(aliases.apply("q11"), "q11")
+        with self.assertRaises(lsst.pex.exceptions.NotFoundError):
+            self.schema.find("q11")
+
     def testAccessors(self):
         aliases = self.schema.getAliasMap()
 
@@ -466,6 +466,51 @@ BOOST_AUTO_TEST_CASE(Nested) {
     }
 }
 
+BOOST_AUTO_TEST_CASE(ContentDeduplication) {
+    // objects with identical content held by different pointers should share rows when
+    // content deduplication is enabled
+    using namespace lsst::afw::table::io;
+
+    ndarray::Array<float, 1, 1> av1 = ndarray::allocate(2);
+    av1[0] = 1.1;
+    av1[1] = 1.2;
+    std::shared_ptr<Comparable> a1(new ExampleA(3, 2.5, av1));
+    std::shared_ptr<Comparable> a2(new ExampleA(3, 2.5, ndarray::copy(av1)));
+    std::shared_ptr<Comparable> a3(new ExampleA(4, 2.5, ndarray::copy(av1)));
+
+    // Without deduplication (the default), distinct pointers are always saved twice.
+    OutputArchive plain;
+    BOOST_CHECK(!plain.getContentDeduplication());
+    BOOST_CHECK(plain.put(a1) != plain.put(a2));
+    BOOST_CHECK_EQUAL(plain.getCatalog(1).size(), std::size_t(2));
+
+    OutputArchive archive;
+    archive.setContentDeduplication(true);
+    int const id1 = archive.put(a1);
+    BOOST_CHECK_EQUAL(archive.put(a2), id1);  // identical content, different pointer
+    BOOST_CHECK_EQUAL(archive.put(a1), id1);  // same pointer still short-circuits
+    int const id3 = archive.put(a3);
+    BOOST_CHECK(id3 != id1);  // different content gets its own ID
+    BOOST_CHECK_EQUAL(archive.getCatalog(1).size(), std::size_t(2));
+    BOOST_CHECK_EQUAL(archive.getIndexCatalog().size(), std::size_t(2));
+
+    // Nested objects referring to deduplicated components get identical component IDs.
+    std::shared_ptr<Comparable> c1(new ExampleC(1, a1, a2));
+    int const idc = archive.put(c1);
+
+    CatalogVector catalogs;
+    for (int n = 1; n < archive.countCatalogs(); ++n) {
+        catalogs.push_back(archive.getCatalog(n));
+    }
+    InputArchive inArchive(archive.getIndexCatalog(), catalogs);
+    BOOST_CHECK_EQUAL(*std::dynamic_pointer_cast<Comparable>(inArchive.get(id1)), *a1);
+    BOOST_CHECK_EQUAL(*std::dynamic_pointer_cast<Comparable>(inArchive.get(id3)), *a3);
+    std::shared_ptr<ExampleC> c2 = std::dynamic_pointer_cast<ExampleC>(inArchive.get(idc));
+    BOOST_REQUIRE(c2);
+    BOOST_CHECK_EQUAL(*c2, *c1);
+    BOOST_CHECK_EQUAL(c2->var2, c2->var3);
+}
+
 namespace {
 
 std::vector<double> makeRandomVector(int size) {
@@ -36,7 +36,9 @@ import numpy as np
 
 import lsst.utils.tests
 import lsst.geom
+import lsst.afw.detection as afwDetect
 import lsst.afw.geom as afwGeom
+import lsst.afw.image as afwImage
 import lsst.afw.table as afwTable
 
 
@@ -190,6 +192,60 @@ class UpdateTestCase(lsst.utils.tests.TestCase):
                 refObj.set(self.refCoordKey, coord)
 
 
+class FootprintMaskBitsTestCase(lsst.utils.tests.TestCase):
+    """A test case for lsst.afw.table.getFootprintMaskBits
+    """
+
+    def setUp(self):
+        self.xy0 = lsst.geom.Point2I(5, 7)
+        self.mask = afwImage.Mask(lsst.geom.Box2I(self.xy0, lsst.geom.Extent2I(20, 15)))
+        self.mask.array[:, :] = 0
+        self.mask.array[2, 3] = 0x1   # pixel (8, 9)
+        self.mask.array[10, 0] = 0x4  # pixel (5, 17)
+        schema = afwTable.SourceTable.makeMinimalSchema()
+        self.catalog = afwTable.SourceCatalog(schema)
+
+    def tearDown(self):
+        del self.mask
+        del self.catalog
+
+    def addSource(self, box=None):
+        src = self.catalog.addNew()
+        if box is not None:
+            src.setFootprint(afwDetect.Footprint(afwGeom.SpanSet(box)))
+        return src
+
+    def testFootprintMaskBits(self):
+        # a footprint over the first flagged pixel
+        self.addSource(lsst.geom.Box2I(lsst.geom.Point2I(7, 8),
+                                       lsst.geom.Extent2I(4, 4)))
+        # a footprint over the second flagged pixel
+        self.addSource(lsst.geom.Box2I(lsst.geom.Point2I(5, 16),
+                                       lsst.geom.Extent2I(2, 2)))
+        # a footprint over both
+        self.addSource(lsst.geom.Box2I(self.xy0, lsst.geom.Extent2I(20, 15)))
+        # a footprint over clean pixels only
+        self.addSource(lsst.geom.Box2I(lsst.geom.Point2I(15, 12),
+                                       lsst.geom.Extent2I(3, 3)))
+        # a source with no footprint at all
+        self.addSource()
+        # a footprint extending outside the mask is clipped to it
+        self.addSource(lsst.geom.Box2I(lsst.geom.Point2I(-10, -10),
+                                       lsst.geom.Extent2I(25, 25)))
+        expected = [0x1, 0x4, 0x5, 0x0, 0x0, 0x1]
+        bits = afwTable.getFootprintMaskBits(self.mask, self.catalog)
+        self.assertEqual(list(bits), expected)
+        # the list-of-records overload gives the same answer
+        bits = afwTable.getFootprintMaskBits(self.mask, list(self.catalog))
+        self.assertEqual(list(bits), expected)
+
+    def testFootprintEntirelyOffMask(self):
+        self.addSource(lsst.geom.Box2I(lsst.geom.Point2I(100, 100),
+                                       lsst.geom.Extent2I(5, 5)))
+        bits = afwTable.getFootprintMaskBits(self.mask, self.catalog)
+        self.assertEqual(list(bits), [0x0])
+
+
 class MemoryTester(lsst.utils.tests.MemoryTestCase):
     pass
 
@@ -0,0 +1,86 @@
+# This file is part of afw.
+#
+# Developed for the LSST Data Management System.
+# This product includes software developed by the LSST Project
+# (https://www.lsst.org).
+# See the COPYRIGHT file at the top-level directory of this distribution
+# for details of code ownership.
+#
+# This program is free software: you can redistribute it and/or modify
+# it under the terms of the GNU General Public License as published by
+# the Free Software Foundation, either version 3 of the License, or
+# (at your option) any later version.
+#
+# This program is distributed in the hope that it will be useful,
+# but WITHOUT ANY WARRANTY; without even the implied warranty of
+# MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+# GNU General Public License for more details.
+#
+# You should have received a copy of the GNU General Public License
+# along with this program.  If not, see <https://www.gnu.org/licenses/>.
+
+import unittest
+
+import numpy as np
+
+import lsst.utils.tests
+import lsst.geom
+import lsst.afw.image as afwImage
+import lsst.afw.math as afwMath
+import lsst.pex.exceptions as pexExcept
+
+
+class TaskPoolTestCase(lsst.utils.tests.TestCase):
+    """Tests for the shared afw::math thread pool.
+
+    The numerical behavior of the operations that run on the pool is covered
+    by their own tests (statistics, stacking, convolution, warping); here we
+    check the pool's configuration interface and that work actually flows
+    through it.
+    """
+
+    def testSingleton(self):
+        pool = afwMath.TaskPool.getInstance()
+        self.assertIs(pool, afwMath.TaskPool.getInstance())
+        self.assertGreaterEqual(pool.getNumThreads(), 1)
+        self.assertIsInstance(pool.getAffinity(), bool)
+
+    def testInvalidSize(self):
+        pool = afwMath.TaskPool.getInstance()
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            pool.setNumThreads(0)
+
+    def testSharedExecution(self):
+        """A banded statistics run on the pool must agree with a serial one."""
+        image = afwImage.ImageF(lsst.geom.Extent2I(257, 131))
+        np.random.seed(42)
+        image.array[:] = np.random.normal(50.0, 3.0, image.array.shape)
+
+        sctrl = afwMath.StatisticsControl()
+        sctrl.setNumThreads(4)
+        parallel = afwMath.makeStatistics(image, afwMath.NPOINT | afwMath.MEAN | afwMath.MAX, sctrl)
+        serial = afwMath.makeStatistics(image, afwMath.NPOINT | afwMath.MEAN | afwMath.MAX)
+
+        self.assertEqual(parallel.getValue(afwMath.NPOINT), serial.getValue(afwMath.NPOINT))
+        self.assertEqual(parallel.getValue(afwMath.MAX), serial.getValue(afwMath.MAX))
+        self.assertAlmostEqual(parallel.getValue(afwMath.MEAN), serial.getValue(afwMath.MEAN), places=10)
+
+        # once work has been submitted the pool size is fixed for the process
+        pool = afwMath.TaskPool.getInstance()
+        with self.assertRaises(pexExcept.LogicError):
+            pool.setNumThreads(pool.getNumThreads())
+        with self.assertRaises(pexExcept.LogicError):
+            pool.setAffinity(True)
+
+
+class TestMemory(lsst.utils.tests.MemoryTestCase):
+    pass
+
+
+def setup_module(module):
+    lsst.utils.tests.init()
+
+
+if __name__ == "__main__":
+    lsst.utils.tests.init()
+    unittest.main()
@@ -412,6 +412,79 @@ class TransformFactoryTestSuite(TransformTestBaseClass):
             self.assertPairsAlmostEqual(toPoint, predToPoint)
 
 
+class TiledAffineApproximationTestCase(lsst.utils.tests.TestCase):
+
+    def setUp(self):
+        self.transform = afwGeom.makeRadialTransform(
+            [0.0, 1.0, 0.0, 4.5e-8])
+        self.bbox = lsst.geom.Box2D(lsst.geom.Point2D(100.0, -200.0),
+                                    lsst.geom.Extent2D(500.0, 300.0))
+        self.tolerance = 1.0e-4
+
+    def testAccuracy(self):
+        """The approximation must agree with the original to within
+        the requested tolerance at points not on the tile sample grid.
+        """
+        approx = afwGeom.makeTiledAffineApproximation(
+            self.transform, self.bbox, self.tolerance)
+        self.assertEqual(approx.getBBox(), self.bbox)
+        self.assertEqual(approx.getTolerance(), self.tolerance)
+        nx, ny = approx.getShape()
+        self.assertGreaterEqual(nx, 1)
+        self.assertEqual(nx, ny)
+
+        rng = np.random.RandomState(42)
+        xs = rng.uniform(self.bbox.getMinX(), self.bbox.getMaxX(), 100)
+        ys = rng.uniform(self.bbox.getMinY(), self.bbox.getMaxY(), 100)
+        points = [lsst.geom.Point2D(x, y) for x, y in zip(xs, ys)]
+        approxPoints = approx.applyForward(points)
+        exactPoints = self.transform.applyForward(points)
+        for approxPoint, exactPoint in zip(approxPoints, exactPoints):
+            error = math.hypot(approxPoint[0] - exactPoint[0],
+                               approxPoint[1] - exactPoint[1])
+            self.assertLessEqual(error, 2 * self.tolerance)
+
+        # Scalar and vector evaluation must agree
+        self.assertPairsAlmostEqual(approx.applyForward(points[0]),
+                                    approxPoints[0])
+
+        # Corners are inside the (inclusive) bounding box
+        for corner in self.bbox.getCorners():
+            approx.applyForward(corner)
+
+    def testOutOfBounds(self):
+        approx = afwGeom.makeTiledAffineApproximation(
+            self.transform, self.bbox, self.tolerance)
+        for point in (
+            lsst.geom.Point2D(self.bbox.getMinX() - 1.0, 0.0),
+            lsst.geom.Point2D(self.bbox.getMaxX() + 1.0, 0.0),
+            lsst.geom.Point2D(200.0, self.bbox.getMinY() - 1.0),
+            lsst.geom.Point2D(200.0, self.bbox.getMaxY() + 1.0),
+        ):
+            with self.assertRaises(pexExcept.InvalidParameterError):
+                approx.applyForward(point)
+
+    def testBadArguments(self):
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            afwGeom.makeTiledAffineApproximation(
+                self.transform, lsst.geom.Box2D(), self.tolerance)
+        for badTolerance in (0.0, -1.0e-4):
+            with self.assertRaises(pexExcept.InvalidParameterError):
+                afwGeom.makeTiledAffineApproximation(
+                    self.transform, self.bbox, badTolerance)
+
+    def testAffineIsExact(self):
+        """An affine transform needs only a single tile."""
+        affine = lsst.geom.AffineTransform(
+            np.array([[1.5, 0.2], [-0.1, 0.9]]),
+            np.array([3.0, -4.0]))
+        approx = afwGeom.makeTiledAffineApproximation(
+            afwGeom.makeTransform(affine), self.bbox, 1.0e-10)
+        self.assertEqual(approx.getShape(), (1, 1))
+        point = lsst.geom.Point2D(234.5, -67.8)
+        self.assertPairsAlmostEqual(approx.applyForward(point), affine(point))
+
+
 class MemoryTester(lsst.utils.tests.MemoryTestCase):
     pass
 
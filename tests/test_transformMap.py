@@ -173,6 +173,24 @@ class CameraTransformMapTestCase(lsst.utils.tests.TestCase):
                     predToPoint = self.transformMap.transform(
                         fromPoint, fromSys, toSys)
                     self.assertPairsAlmostEqual(predToPoint, toPoint)
+    def testRepeatedTransform(self):
+        """Test that repeated transforms between the same pair of systems,
+        which reuse a cached composed mapping, agree with the first call
+        and do not disturb other pairs.
+        """
+        points = [lsst.geom.Point2D(x, y)
+                  for x in (-1.2, 0.0, 25.3) for y in (-23.4, 0.0, 2.3)]
+        first = self.transformMap.transform(points, self.nativeSys,
+                                            cameraGeom.FIELD_ANGLE)
+        for _ in range(3):
+            again = self.transformMap.transform(points, self.nativeSys,
+                                                cameraGeom.FIELD_ANGLE)
+            for point1, point2 in zip(first, again):
+                self.assertEqual(tuple(point1), tuple(point2))
+        back = self.transformMap.transform(first, cameraGeom.FIELD_ANGLE,
+                                           self.nativeSys)
+        for orig, roundTrip in zip(points, back):
+            self.assertPairsAlmostEqual(orig, roundTrip)
 
 
 class MemoryTester(lsst.utils.tests.MemoryTestCase):
@@ -358,6 +358,41 @@ class TransmissionCurveTestCase(lsst.utils.tests.TestCase):
         # Test persistence for transformed TransmissionCurves
         self.checkPersistence(tc3)
 
+    def testCompiledAt(self):
+        """Test tabulating a TransmissionCurve onto regular grids."""
+        tc, wavelengths, radii, curve2d = self.makeRadial()
+        bbox = lsst.geom.Box2D(lsst.geom.Point2D(0.0, 0.0), lsst.geom.Point2D(1.0, 1.0))
+        compiled = tc.compiledAt(wavelengths, bbox, lsst.geom.Extent2I(101, 101))
+
+        # At the tabulated wavelengths the only error is from the spatial grid.
+        for point in self.points:
+            self.assertFloatsAlmostEqual(
+                tc.sampleAt(point, wavelengths),
+                compiled.sampleAt(point, wavelengths),
+                rtol=1E-3, atol=1E-3
+            )
+
+        # At other wavelengths the table adds linear interpolation error.
+        wl2 = np.linspace(self.minWavelength, self.maxWavelength, 151)
+        for point in self.points:
+            self.assertFloatsAlmostEqual(
+                tc.sampleAt(point, wl2),
+                compiled.sampleAt(point, wl2),
+                rtol=1E-2, atol=1E-2
+            )
+
+        # Out-of-range wavelengths yield the original curve's bound values.
+        self.assertEqual(compiled.getThroughputAtBounds(), tc.getThroughputAtBounds())
+        below = np.array([2*wavelengths[0] - wavelengths[1]])
+        above = np.array([2*wavelengths[-1] - wavelengths[-2]])
+        self.assertFloatsEqual(compiled.sampleAt(self.points[0], below),
+                               tc.getThroughputAtBounds()[0])
+        self.assertFloatsEqual(compiled.sampleAt(self.points[0], above),
+                               tc.getThroughputAtBounds()[1])
+
+        # Test persistence for compiled TransmissionCurves.
+        self.checkPersistence(compiled)
+
     def testExposure(self):
         """Test that we can attach a TransmissionCurve to an Exposure and round-trip it through I/O."""
         wavelengths = np.linspace(6200, 6400, 100)
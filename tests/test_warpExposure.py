@@ -228,6 +228,246 @@ class WarpExposureTestCase(lsst.utils.tests.TestCase):
             for newCacheSize in (1, 50):
                 wc.setCacheSize(newCacheSize)
                 self.assertEqual(wc.getCacheSize(), newCacheSize)
+
+        wc = afwMath.WarpingControl("lanczos3")
+        self.assertEqual(wc.getNumThreads(), 1)
+        for numThreads in (1, 2, 8):
+            wc.setNumThreads(numThreads)
+            self.assertEqual(wc.getNumThreads(), numThreads)
+
+    def testClosedFormLanczos(self):
+        """Test that closed-form Lanczos evaluation matches the generic Function1 path
+
+        LanczosWarpingKernel takes a closed-form evaluation path in the warping inner loop;
+        a plain SeparableKernel built from the same LanczosFunction1D pair takes the generic
+        path, so warping with both should agree to numerical precision.
+        """
+        srcWcs = afwGeom.makeSkyWcs(
+            crpix=lsst.geom.Point2D(50, 45),
+            crval=lsst.geom.SpherePoint(10, 20, lsst.geom.degrees),
+            cdMatrix=afwGeom.makeCdMatrix(scale=1.0e-5*lsst.geom.degrees),
+        )
+        destWcs = afwGeom.makeSkyWcs(
+            crpix=lsst.geom.Point2D(48, 44),
+            crval=lsst.geom.SpherePoint(10, 20, lsst.geom.degrees),
+            cdMatrix=afwGeom.makeCdMatrix(scale=1.1e-5*lsst.geom.degrees,
+                                          orientation=3*lsst.geom.degrees),
+        )
+        srcImage = afwImage.MaskedImageF(lsst.geom.Extent2I(100, 90))
+        shape = srcImage.image.array.shape
+        rng = np.random.RandomState(4)
+        srcImage.image.array[:] = rng.normal(100, 10, size=shape)
+        srcImage.variance.array[:] = rng.normal(10, 1, size=shape)
+        srcImage.mask.array[40:50, 30:35] = 1
+
+        for order in (2, 3, 5):
+            fastControl = afwMath.WarpingControl(f"lanczos{order}")
+            genericControl = afwMath.WarpingControl(f"lanczos{order}")
+            genericControl.setWarpingKernel(afwMath.SeparableKernel(
+                2*order, 2*order,
+                afwMath.LanczosFunction1D(order), afwMath.LanczosFunction1D(order)))
+
+            fastImage = afwImage.MaskedImageF(srcImage.getDimensions())
+            fastNumGoodPix = afwMath.warpImage(fastImage, destWcs, srcImage, srcWcs, fastControl)
+            genericImage = afwImage.MaskedImageF(srcImage.getDimensions())
+            genericNumGoodPix = afwMath.warpImage(genericImage, destWcs, srcImage, srcWcs, genericControl)
+
+            self.assertEqual(fastNumGoodPix, genericNumGoodPix)
+            self.assertMasksEqual(fastImage.mask, genericImage.mask)
+            noDataMaskArr = np.isnan(fastImage.image.array)
+            self.assertImagesAlmostEqual(fastImage.image, genericImage.image,
+                                         skipMask=noDataMaskArr, rtol=1e-6)
+            self.assertImagesAlmostEqual(fastImage.variance, genericImage.variance,
+                                         skipMask=noDataMaskArr, rtol=1e-6)
+
+    def testWarpMappingCache(self):
+        """Test that replaying a WarpMappingCache reproduces a direct warp
+        """
+        srcWcs = afwGeom.makeSkyWcs(
+            crpix=lsst.geom.Point2D(50, 45),
+            crval=lsst.geom.SpherePoint(10, 20, lsst.geom.degrees),
+            cdMatrix=afwGeom.makeCdMatrix(scale=1.0e-5*lsst.geom.degrees),
+        )
+        destWcs = afwGeom.makeSkyWcs(
+            crpix=lsst.geom.Point2D(48, 44),
+            crval=lsst.geom.SpherePoint(10, 20, lsst.geom.degrees),
+            cdMatrix=afwGeom.makeCdMatrix(scale=1.1e-5*lsst.geom.degrees,
+                                          orientation=3*lsst.geom.degrees),
+        )
+        srcImages = []
+        for seed in (1, 2, 3):
+            srcImage = afwImage.MaskedImageF(lsst.geom.Extent2I(100, 90))
+            shape = srcImage.image.array.shape
+            rng = np.random.RandomState(seed)
+            srcImage.image.array[:] = rng.normal(100, 10, size=shape)
+            srcImage.variance.array[:] = rng.normal(10, 1, size=shape)
+            srcImage.mask.array[40 + seed:50 + seed, 30:35] = 1
+            srcImages.append(srcImage)
+
+        for interpLength in (0, 10):
+            warpingControl = afwMath.WarpingControl("lanczos3", "bilinear", 0, interpLength)
+            cache = afwMath.WarpMappingCache()
+            cachedControl = afwMath.WarpingControl("lanczos3", "bilinear", 0, interpLength)
+            cachedControl.setWarpMappingCache(cache)
+            self.assertIsNone(warpingControl.getWarpMappingCache())
+
+            # the first warp records the mapping; later warps of the same geometry replay it
+            for srcImage in srcImages:
+                refImage = afwImage.MaskedImageF(srcImage.getDimensions())
+                refNumGoodPix = afwMath.warpImage(refImage, destWcs, srcImage, srcWcs, warpingControl)
+                destImage = afwImage.MaskedImageF(srcImage.getDimensions())
+                numGoodPix = afwMath.warpImage(destImage, destWcs, srcImage, srcWcs, cachedControl)
+                self.assertEqual(numGoodPix, refNumGoodPix)
+                self.assertMaskedImagesEqual(destImage, refImage)
+
+            # a destination with a different bbox re-records rather than replaying stale data
+            smallRef = afwImage.MaskedImageF(lsst.geom.Extent2I(60, 50))
+            smallRefNumGoodPix = afwMath.warpImage(smallRef, destWcs, srcImages[0], srcWcs, warpingControl)
+            smallDest = afwImage.MaskedImageF(lsst.geom.Extent2I(60, 50))
+            smallNumGoodPix = afwMath.warpImage(smallDest, destWcs, srcImages[0], srcWcs, cachedControl)
+            self.assertEqual(smallNumGoodPix, smallRefNumGoodPix)
+            self.assertMaskedImagesEqual(smallDest, smallRef)
+
+    def testWarpExposureBatch(self):
+        """Test that warpExposureBatch matches per-stamp warpExposure calls
+        """
+        srcWcs = afwGeom.makeSkyWcs(
+            crpix=lsst.geom.Point2D(50, 45),
+            crval=lsst.geom.SpherePoint(10, 20, lsst.geom.degrees),
+            cdMatrix=afwGeom.makeCdMatrix(scale=1.0e-5*lsst.geom.degrees),
+        )
+        srcExposure = afwImage.ExposureF(lsst.geom.Extent2I(100, 90), srcWcs)
+        srcMi = srcExposure.getMaskedImage()
+        rng = np.random.RandomState(6)
+        srcMi.image.array[:] = rng.normal(100, 10, size=srcMi.image.array.shape)
+        srcMi.variance.array[:] = rng.normal(10, 1, size=srcMi.image.array.shape)
+        srcMi.mask.array[40:50, 30:35] = 1
+
+        requests = []
+        for ind in range(7):
+            stampWcs = afwGeom.makeSkyWcs(
+                crpix=lsst.geom.Point2D(10 + ind, 12 - ind),
+                crval=lsst.geom.SpherePoint(10, 20, lsst.geom.degrees),
+                cdMatrix=afwGeom.makeCdMatrix(scale=(1.0 + 0.02*ind)*1.0e-5*lsst.geom.degrees,
+                                              orientation=ind*lsst.geom.degrees),
+            )
+            bbox = lsst.geom.Box2I(lsst.geom.Point2I(5*ind, 3*ind), lsst.geom.Extent2I(20 + ind, 25 - ind))
+            requests.append(afwMath.StampWarpRequest(bbox, stampWcs))
+
+        for numThreads in (1, 3):
+            warpingControl = afwMath.WarpingControl("lanczos3", "bilinear")
+            warpingControl.setNumThreads(numThreads)
+            stamps = afwMath.warpExposureBatch(srcExposure, requests, warpingControl)
+            self.assertEqual(len(stamps), len(requests))
+            for request, stamp in zip(requests, stamps):
+                self.assertEqual(stamp.getBBox(), request.bbox)
+                refStamp = afwImage.ExposureF(request.bbox, request.wcs)
+                afwMath.warpExposure(refStamp, srcExposure, warpingControl)
+                self.assertMaskedImagesEqual(stamp.getMaskedImage(), refStamp.getMaskedImage())
+
+        exposureWithoutWcs = afwImage.ExposureF(lsst.geom.Extent2I(10, 10))
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            afwMath.warpExposureBatch(exposureWithoutWcs, requests, afwMath.WarpingControl("bilinear"))
+
+    def testCoaddAccumulator(self):
+        """Test that CoaddAccumulator matches an explicit warp-then-stack computation
+        """
+        destWcs = afwGeom.makeSkyWcs(
+            crpix=lsst.geom.Point2D(48, 44),
+            crval=lsst.geom.SpherePoint(10, 20, lsst.geom.degrees),
+            cdMatrix=afwGeom.makeCdMatrix(scale=1.1e-5*lsst.geom.degrees,
+                                          orientation=3*lsst.geom.degrees),
+        )
+        bbox = lsst.geom.Box2I(lsst.geom.Point2I(0, 0), lsst.geom.Extent2I(100, 90))
+        badMask = afwImage.Mask.getPlaneBitMask("BAD")
+        noDataMask = afwImage.Mask.getPlaneBitMask("NO_DATA")
+        warpingControl = afwMath.WarpingControl("lanczos3", "bilinear")
+
+        accumulator = afwMath.CoaddAccumulatorF(bbox, badPixelMask=badMask)
+        self.assertEqual(accumulator.getBBox(), bbox)
+        self.assertEqual(accumulator.getBadPixelMask(), badMask)
+
+        sumValue = np.zeros((90, 100), dtype=float)
+        sumVariance = np.zeros((90, 100), dtype=float)
+        sumWeight = np.zeros((90, 100), dtype=float)
+        orMask = np.zeros((90, 100), dtype=np.int32)
+
+        for seed, weight in ((1, 0.5), (2, 1.0), (3, 2.5)):
+            srcWcs = afwGeom.makeSkyWcs(
+                crpix=lsst.geom.Point2D(50 + seed, 45 - seed),
+                crval=lsst.geom.SpherePoint(10, 20, lsst.geom.degrees),
+                cdMatrix=afwGeom.makeCdMatrix(scale=1.0e-5*lsst.geom.degrees),
+            )
+            srcImage = afwImage.MaskedImageF(lsst.geom.Extent2I(110, 100))
+            shape = srcImage.image.array.shape
+            rng = np.random.RandomState(seed)
+            srcImage.image.array[:] = rng.normal(100, 10, size=shape)
+            srcImage.variance.array[:] = rng.normal(10, 1, size=shape)
+            srcImage.mask.array[40:50, 30:35] = badMask
+            srcImage.mask.array[60:65, 70:90] = afwImage.Mask.getPlaneBitMask("SAT")
+            srcToDest = afwGeom.makeWcsPairTransform(srcWcs, destWcs)
+
+            numAccumulated = accumulator.accumulate(srcImage, srcToDest, warpingControl, weight)
+
+            warp = afwImage.MaskedImageF(bbox)
+            afwMath.warpImage(warp, srcImage, srcToDest, warpingControl)
+            good = np.isfinite(warp.image.array) & ((warp.mask.array & badMask) == 0)
+            self.assertEqual(numAccumulated, good.sum())
+            sumValue[good] += weight*warp.image.array[good]
+            sumVariance[good] += weight*weight*warp.variance.array[good]
+            sumWeight[good] += weight
+            orMask[good] |= warp.mask.array[good]
+
+        with self.assertRaises(pexExcept.InvalidParameterError):
+            accumulator.accumulate(srcImage, srcToDest, warpingControl, 0.0)
+
+        coadd = accumulator.getCoadd()
+        hasData = sumWeight > 0
+        self.assertTrue(np.any(hasData))
+        self.assertTrue(np.any(~hasData))
+        self.assertFloatsAlmostEqual(coadd.image.array[hasData],
+                                     (sumValue[hasData]/sumWeight[hasData]).astype(np.float32),
+                                     rtol=1e-6)
+        self.assertFloatsAlmostEqual(coadd.variance.array[hasData],
+                                     (sumVariance[hasData]/sumWeight[hasData]**2).astype(np.float32),
+                                     rtol=1e-6)
+        self.assertTrue(np.all(coadd.mask.array[hasData] == orMask[hasData]))
+        self.assertTrue(np.all(np.isnan(coadd.image.array[~hasData])))
+        self.assertTrue(np.all(coadd.mask.array[~hasData] == noDataMask))
+
+    def testNumThreadsWarp(self):
+        """Test that multithreaded warping gives the same result as serial warping
+        """
+        srcWcs = afwGeom.makeSkyWcs(
+            crpix=lsst.geom.Point2D(50, 45),
+            crval=lsst.geom.SpherePoint(10, 20, lsst.geom.degrees),
+            cdMatrix=afwGeom.makeCdMatrix(scale=1.0e-5*lsst.geom.degrees),
+        )
+        destWcs = afwGeom.makeSkyWcs(
+            crpix=lsst.geom.Point2D(48, 44),
+            crval=lsst.geom.SpherePoint(10, 20, lsst.geom.degrees),
+            cdMatrix=afwGeom.makeCdMatrix(scale=1.1e-5*lsst.geom.degrees,
+                                          orientation=3*lsst.geom.degrees),
+        )
+        srcImage = afwImage.MaskedImageF(lsst.geom.Extent2I(100, 90))
+        shape = srcImage.image.array.shape
+        srcImage.image.array[:] = np.random.normal(100, 10, size=shape)
+        srcImage.variance.array[:] = np.random.normal(10, 1, size=shape)
+        srcImage.mask.array[40:50, 30:35] = 1
+
+        # interpLength = 1 runs the interpolation branch but interpolates nothing,
+        # so both code paths stay deterministic under banding
+        for interpLength in (0, 1):
+            warpingControl = afwMath.WarpingControl("lanczos3", "bilinear", 0, interpLength)
+            refImage = afwImage.MaskedImageF(srcImage.getDimensions())
+            refNumGoodPix = afwMath.warpImage(refImage, destWcs, srcImage, srcWcs, warpingControl)
+            self.assertGreater(refNumGoodPix, 0)
+            for numThreads in (2, 3, 7):
+                warpingControl.setNumThreads(numThreads)
+                destImage = afwImage.MaskedImageF(srcImage.getDimensions())
+                numGoodPix = afwMath.warpImage(destImage, destWcs, srcImage, srcWcs, warpingControl)
+                self.assertEqual(numGoodPix, refNumGoodPix)
+                self.assertMaskedImagesEqual(destImage, refImage)
                 self.assertEqual(
                     wc.getWarpingKernel().getCacheSize(), newCacheSize)
                 self.assertEqual(